@@ -0,0 +1,351 @@
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayBench.cpp
+//
+// Host benchmark of the main screen's drawing.  The sketch's Display, SCB and
+// MainScreen code draws to the emulated ST7735 in Shims/, which records every
+// address window and pixel sent to the panel.  For each scenario and each way
+// of drawing (directly, and through the frame buffer) it reports per frame:
+//
+//   Pixels     Pixels sent to the panel.
+//   Windows    Address windows set (11 bytes of commands each).
+//   Bytes      SPI bytes for the above.
+//   SPI        Estimated time to send those bytes at the SPI clock.
+//   CPU        Host microseconds for the frame, emulated panel included.
+//
+// The scenarios run the main screen as loop() does, every 100 ms (20 ms while
+// the rows slide), on the simulated clock:
+//    - Idle: nothing changes and nothing scrolls.
+//    - Weight: the weight (and so the length) changes every update.
+//    - Scroll: nothing changes but the rows scroll every 5 seconds.  No spool
+//      is selected, so that rows 1 and 2 both scroll (and slide when there
+//      is a frame buffer).
+//
+// It checks that idle updates send nothing, that weight updates send less
+// than the first (full) frame and, through the frame buffer, no more than the
+// largest direct one, and that after each run the panel is the same as when
+// the screen is redrawn from scratch.
+//
+// Usage:  DisplayBench [-m MHz] [-p dir]
+//   -m MHz       SPI clock for the estimates (default 16).
+//   -p dir       Write every frame to dir (which must exist) as a PNG file.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>                   // For timing.
+#include <cstdio>                   // For printf().
+#include <cstdlib>                  // For strtod().
+#include <cstring>                  // For memcmp().
+#include <vector>                   // For std::vector.
+#include <unistd.h>                 // For getopt().
+#include <Arduino.h>                // For Serial, HostSim.
+#include "JmcFilamentScale.h"       // For the sketch's globals.
+#include "MainScreen.h"             // For MainScreen class.
+#include "TraceTransport.h"         // For the load cell's samples.
+#include "PngWriter.h"              // For WritePng().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// The sketch's globals used by the display code, set up as the sketch does.
+/////////////////////////////////////////////////////////////////////////////////
+static TraceTransport gTrace;
+LoadCell gLoadCell(&gTrace, 128U);
+static LoadCell *const gLoadCells[] = {&gLoadCell};
+LoadCellArray gLoadCellArray(gLoadCells, 1U, NUMBER_SPOOLS);
+StabilityDetector  gStability;
+ConsumptionTracker gConsumption;
+EnvSensor gEnvSensor(27, DHT22);
+TempScale gTemperatureUnits = eTempScaleF;
+Filament gFilament;
+SpoolManager<NUMBER_SPOOLS> gSpoolMgr;
+LengthManager gLengthMgr;
+Network gNetwork(80);
+Display gTft(14, 32, 15, A0);
+float gCurrentWeight      = 0.0f;
+float gCurrentLength      = 0.0f;
+float gCurrentTemperature = 0.0f;
+float gCurrentHumidity    = 0.0f;
+const char *gNetworkServerName = "JmcScale";
+const char * &rNetworkServerName = gNetworkServerName;
+
+
+// Update periods, as in the sketch's HandleMainScreen().
+static const uint32_t UPDATE_MS   = 100U;
+static const uint32_t RUN_MS      = 12000U;     // Two timed scrolls.
+static const int32_t  TARE_RAW    = 100000;
+static const double   COUNTS_PER_GRAM = 420.0;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Scenarios.
+/////////////////////////////////////////////////////////////////////////////////
+enum Scenario
+{
+    eScIdle,
+    eScWeight,
+    eScScroll,
+    eScNumScenarios
+};
+
+static const char *ScenarioNames[eScNumScenarios] = {"Idle", "Weight", "Scroll"};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Per frame costs, summed or the largest.
+/////////////////////////////////////////////////////////////////////////////////
+struct FrameCost
+{
+    uint64_t m_Pixels;
+    uint64_t m_Windows;
+    uint64_t m_Bytes;
+    double   m_SpiUs;
+    double   m_CpuUs;
+};
+
+
+struct BenchOptions
+{
+    uint32_t    m_SpiHz;
+    const char *m_pPngDir;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetUpScale()
+//
+// Calibrates the load cell and selects a spool, so that the main screen shows
+// weights rather than prompts.
+/////////////////////////////////////////////////////////////////////////////////
+static bool SetUpScale()
+{
+    for (int i = 0; i < 100; i++)
+    {
+        gTrace.Append(TARE_RAW);
+    }
+    bool ok = gLoadCell.Init("Load Cell") &&
+              gLoadCell.Tare(20U) &&
+              gLoadCell.Calibrate(static_cast<uint32_t>(gLoadCell.GetTareValue() +
+                                                       1000.0 * COUNTS_PER_GRAM + 0.5),
+                                  1000.0);
+    ok = gSpoolMgr.Init("Spool Mgr") && ok;
+    gLengthMgr.Init("Length Mgr");
+    gEnvSensor.Init("Env Sensor");
+    gFilament.Init("Filament");
+    Spool *pSpool = gSpoolMgr.GetSpool(0U);
+    if (pSpool)
+    {
+        pSpool->SetName("Black PLA");
+        pSpool->SetSpoolWeight(235.0f);
+        pSpool->SetColor(ST7735_BLUE);
+        gSpoolMgr.SelectSpool(0U);
+    }
+    gCurrentTemperature = 72.5f;
+    gCurrentHumidity    = 41.0f;
+    return ok && (gSpoolMgr.GetSelectedSpool() != NULL) &&
+           gTft.Init("Display") && MainScreen::Init("MainScreen");
+} // End SetUpScale().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DrawFrame()
+//
+// Draws one frame of the main screen and returns what it cost.  When a PNG
+// directory is given the panel is written to it afterwards.
+/////////////////////////////////////////////////////////////////////////////////
+static FrameCost DrawFrame(bool refresh, const BenchOptions &rOpts,
+                           const char *pRunName, uint32_t frame)
+{
+    HostTft::ResetCounts();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    MainScreen::DisplayMainScreen(refresh, 0);
+    double cpuUs = std::chrono::duration<double, std::micro>(
+                       std::chrono::steady_clock::now() - start).count();
+
+    const HostTft::Counts &rCounts = HostTft::GetCounts();
+    FrameCost cost;
+    cost.m_Pixels  = rCounts.m_Pixels;
+    cost.m_Windows = rCounts.m_Windows;
+    cost.m_Bytes   = HostTft::GetBytes(rCounts);
+    cost.m_SpiUs   = HostTft::GetSpiUs(rCounts, rOpts.m_SpiHz);
+    cost.m_CpuUs   = cpuUs;
+
+    if (rOpts.m_pPngDir)
+    {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s-%04lu.png", rOpts.m_pPngDir, pRunName,
+                 static_cast<unsigned long>(frame));
+        if (!WritePng(path, HostTft::GetWidth(), HostTft::GetHeight(),
+                      HostTft::GetPixels()))
+        {
+            fprintf(stderr, "Unable to write '%s'.\n", path);
+        }
+    }
+    return cost;
+} // End DrawFrame().
+
+
+static void PrintCost(const char *pLabel, const FrameCost &rCost)
+{
+    printf("    %-12s %7llu px %4llu win %8llu B %8.2f ms SPI %8.1f us CPU\n",
+           pLabel, static_cast<unsigned long long>(rCost.m_Pixels),
+           static_cast<unsigned long long>(rCost.m_Windows),
+           static_cast<unsigned long long>(rCost.m_Bytes),
+           rCost.m_SpiUs / 1000.0, rCost.m_CpuUs);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MatchesRedraw()
+//
+// Returns 'true' if the panel is unchanged by redrawing the main screen from
+// scratch, i.e. the updates left it as a full redraw would.
+/////////////////////////////////////////////////////////////////////////////////
+static bool MatchesRedraw()
+{
+    size_t numPixels = static_cast<size_t>(HostTft::GetWidth()) * HostTft::GetHeight();
+    std::vector<uint16_t> before(HostTft::GetPixels(), HostTft::GetPixels() + numPixels);
+    MainScreen::DisplayMainScreen(true, 0);
+    return memcmp(&before[0], HostTft::GetPixels(), numPixels * sizeof(uint16_t)) == 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RunScenario()
+//
+// Runs one scenario, drawing directly or through the frame buffer, and
+// reports and checks its frames.  rMost is set to the largest update, and
+// pLimit, if not NULL, is the largest a weight update may be.  Returns 'true'
+// if the checks pass.
+/////////////////////////////////////////////////////////////////////////////////
+static bool RunScenario(Scenario scenario, bool frameBuffer, const BenchOptions &rOpts,
+                        const FrameCost *pLimit, FrameCost &rMost)
+{
+    char runName[32];
+    snprintf(runName, sizeof(runName), "%s-%s", ScenarioNames[scenario],
+             frameBuffer ? "fb" : "direct");
+    printf("  %s, %s:\n", ScenarioNames[scenario],
+           frameBuffer ? "frame buffer" : "direct drawing");
+
+    bool ok = gTft.EnableFrameBuffer(frameBuffer) &&
+              (gTft.IsFrameBuffered() == frameBuffer);
+    MainScreen::SetScrollDelayMs((scenario == eScScroll) ?
+                                 MainScreen::DEFAULT_SCROLL_DELAY_MS : 0U);
+    if (scenario == eScScroll)
+    {
+        gSpoolMgr.DeselectSpool();
+    }
+    else
+    {
+        gSpoolMgr.SelectSpool(0U);
+    }
+    gCurrentWeight = 1234.5f;
+    gCurrentLength = 413520.0f;
+
+    uint32_t  frame = 0U;
+    FrameCost first = DrawFrame(true, rOpts, runName, frame++);
+    FrameCost sum   = {0ULL, 0ULL, 0ULL, 0.0, 0.0};
+    FrameCost most  = sum;
+    uint32_t  elapsedMs = 0U;
+    while (elapsedMs < RUN_MS)
+    {
+        uint32_t stepMs = MainScreen::IsSliding() ? MainScreen::SLIDE_FRAME_MS : UPDATE_MS;
+        HostSim::AdvanceMillis(stepMs);
+        elapsedMs += stepMs;
+        if (scenario == eScWeight)
+        {
+            gCurrentWeight -= 0.7f;
+            gCurrentLength -= 234.4f;
+        }
+
+        FrameCost cost = DrawFrame(false, rOpts, runName, frame++);
+        sum.m_Pixels  += cost.m_Pixels;
+        sum.m_Windows += cost.m_Windows;
+        sum.m_Bytes   += cost.m_Bytes;
+        sum.m_SpiUs   += cost.m_SpiUs;
+        sum.m_CpuUs   += cost.m_CpuUs;
+        if (cost.m_Bytes > most.m_Bytes)
+        {
+            most.m_Pixels  = cost.m_Pixels;
+            most.m_Windows = cost.m_Windows;
+            most.m_Bytes   = cost.m_Bytes;
+            most.m_SpiUs   = cost.m_SpiUs;
+        }
+        most.m_CpuUs = (cost.m_CpuUs > most.m_CpuUs) ? cost.m_CpuUs : most.m_CpuUs;
+    }
+
+    uint32_t  updates = frame - 1U;
+    FrameCost mean;
+    mean.m_Pixels  = sum.m_Pixels  / updates;
+    mean.m_Windows = sum.m_Windows / updates;
+    mean.m_Bytes   = sum.m_Bytes   / updates;
+    mean.m_SpiUs   = sum.m_SpiUs   / updates;
+    mean.m_CpuUs   = sum.m_CpuUs   / updates;
+    PrintCost("First frame", first);
+    PrintCost("Update mean", mean);
+    PrintCost("Update max", most);
+    printf("    %lu updates, %.1f ms of SPI per second\n",
+           static_cast<unsigned long>(updates), sum.m_SpiUs / RUN_MS);
+
+    if (scenario == eScIdle)
+    {
+        ok = (sum.m_Pixels == 0ULL) && ok;
+    }
+    else if (scenario == eScWeight)
+    {
+        ok = (most.m_Pixels > 0ULL) && (most.m_Pixels < first.m_Pixels) && ok;
+        ok = ((pLimit == NULL) || (most.m_Bytes <= pLimit->m_Bytes)) && ok;
+    }
+    ok = MatchesRedraw() && ok;
+    rMost = most;
+    printf("  %s, %s: %s\n\n", ScenarioNames[scenario],
+           frameBuffer ? "frame buffer" : "direct drawing", ok ? "PASS" : "FAIL");
+    return ok;
+} // End RunScenario().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// main()
+/////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+    BenchOptions opts = {16000000U, NULL};
+    int opt;
+    while ((opt = getopt(argc, argv, "m:p:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'm': opts.m_SpiHz   = static_cast<uint32_t>(strtod(optarg, NULL) * 1.0e6); break;
+        case 'p': opts.m_pPngDir = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-m MHz] [-p dir]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (opts.m_SpiHz == 0U)
+    {
+        fprintf(stderr, "Bad option value.\n");
+        return 2;
+    }
+
+    Serial.SetEnabled(false);
+    bool ok = SetUpScale();
+    if (!ok)
+    {
+        fprintf(stderr, "Scale or display set up failed.\n");
+        return 1;
+    }
+    printf("Main screen frames at %.1f MHz SPI\n\n", opts.m_SpiHz / 1.0e6);
+
+    for (int s = 0; s < eScNumScenarios; s++)
+    {
+        FrameCost direct;
+        FrameCost buffered;
+        ok &= RunScenario(static_cast<Scenario>(s), false, opts, NULL, direct);
+        ok &= RunScenario(static_cast<Scenario>(s), true, opts, &direct, buffered);
+    }
+    printf("Main screen drawing: %s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,289 @@
+/////////////////////////////////////////////////////////////////////////////////
+// FixedWeightBench.cpp
+//
+// Host microbenchmark for the fixed point weight path.  The floating point
+// path the sketch used before (ReadWeight()'s scaling, then SetDecimalPlaces()
+// on the weight and on the filament length, reproduced below) is compared with
+// FixedScale, as used by LoadCell::ReadWeightFixed() and the sketch's
+// UpdateCurrentLength().  Both start from the corrected net reading in counts.
+//
+// Before timing, every sample of a synthetic trace is checked in each weight
+// and length unit: the fixed point weight and length must be within one
+// display LSB of the floating point ones.  The share that match exactly is
+// also shown.
+//
+// The host has a double precision FPU and the ESP32 does not, so the speedup
+// here understates the one on the scale.
+//
+// Usage:  FixedWeightBench [samples]
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>               // For timing.
+#include <cmath>                // For pow(), ceil(), ...
+#include <cstdint>              // For int32_t, ...
+#include <cstdio>               // For printf().
+#include <cstdlib>              // For strtoul().
+#include <vector>               // For std::vector.
+#include "FixedScale.h"         // For FixedScale class.
+#include "LengthManager.h"      // For LengthManager class.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// The weight units the sketch displays, with its decimal places for each.
+/////////////////////////////////////////////////////////////////////////////////
+struct UnitsCase
+{
+    const char *m_pName;
+    uint8_t     m_Decimals;
+    double      m_GramsPerUnit;
+};
+
+static const UnitsCase UNITS[] =
+{
+    {"g",  1U, 1.0},
+    {"kg", 4U, 1000.0},
+    {"oz", 2U, 28.349523125},
+    {"lb", 3U, 453.59237}
+};
+
+static const double GRAMS_PER_COUNT = 0.002341;     // Typical 5 kg load cell.
+static const double SPOOL_GRAMS     = 250.0;        // Offset (empty spool).
+static const float  DIAMETER_MM     = 1.75f;
+static const float  DENSITY         = 1.24f;        // PLA.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetDecimalPlaces()
+//
+// The sketch's rounding before the fixed point path.
+/////////////////////////////////////////////////////////////////////////////////
+static double SetDecimalPlaces(double value, int precision)
+{
+    double factor = pow(10, precision);
+    value *= factor;
+    value = ceil(value);
+    value /= factor;
+    return value;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Scales holds both paths' factors for one set of units.
+/////////////////////////////////////////////////////////////////////////////////
+struct Scales
+{
+    // Floating point.
+    double  m_UnitsPerCount;
+    double  m_Offset;
+    float   m_LengthFactor;
+    int     m_Decimals;
+    int     m_LengthDecimals;
+
+    // Fixed point.
+    FixedScale m_Weight;
+    FixedScale m_Length;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetUp()
+//
+// Works out the factors as LoadCell and the sketch do on a calibration or
+// units change.
+/////////////////////////////////////////////////////////////////////////////////
+static bool SetUp(Scales &rScales, const UnitsCase &units, double sign,
+                  LengthManager &rLengthMgr)
+{
+    rScales.m_UnitsPerCount  = sign * GRAMS_PER_COUNT / units.m_GramsPerUnit;
+    rScales.m_Offset         = SPOOL_GRAMS / units.m_GramsPerUnit;
+    rScales.m_LengthFactor   = rLengthMgr.CalculateLengthFactor(
+                                   DIAMETER_MM, units.m_GramsPerUnit, DENSITY);
+    rScales.m_Decimals       = units.m_Decimals;
+    rScales.m_LengthDecimals = rLengthMgr.GetPrecision();
+
+    return rScales.m_Weight.Configure(ldexp(rScales.m_UnitsPerCount, -8),
+                                      rScales.m_Offset, units.m_Decimals) &&
+           rScales.m_Length.Configure(rScales.m_LengthFactor *
+                                      FixedScale::ToFloat(1L, units.m_Decimals),
+                                      0.0, rLengthMgr.GetPrecision());
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MakeTrace()
+//
+// Builds a repeatable trace of net readings in counts: a spool plus filament
+// from empty to 5 kg, with noise, and the fractional counts left by the
+// temperature and creep corrections.
+/////////////////////////////////////////////////////////////////////////////////
+static std::vector<double> MakeTrace(size_t count)
+{
+    std::vector<double> trace(count);
+    uint32_t lcg = 12345U;
+    for (size_t i = 0U; i < count; i++)
+    {
+        lcg = lcg * 1664525U + 1013904223U;
+        double noise = static_cast<double>((lcg >> 8) % 40001U) / 100.0 - 200.0;
+        double load  = static_cast<double>((i * 7919U) % 2135000U);
+        trace[i] = load + noise;
+    }
+    return trace;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// The two paths, from a net reading to the weight and length in display LSBs.
+// A weight that rounds the other way gives a length many LSBs away, so the
+// floating point length is worked out from the given weight.
+/////////////////////////////////////////////////////////////////////////////////
+static inline int32_t DoubleWeight(const Scales &rScales, double net)
+{
+    double weight = (net * rScales.m_UnitsPerCount) - rScales.m_Offset;
+    float currentWeight = SetDecimalPlaces(weight, rScales.m_Decimals);
+    return static_cast<int32_t>(lround(currentWeight * pow(10, rScales.m_Decimals)));
+}
+
+static inline int32_t DoubleLength(const Scales &rScales, int32_t weight)
+{
+    float currentWeight = weight / pow(10, rScales.m_Decimals);
+    float currentLength = SetDecimalPlaces(rScales.m_LengthFactor * currentWeight,
+                                           rScales.m_LengthDecimals);
+    return static_cast<int32_t>(
+        lround(currentLength * pow(10, rScales.m_LengthDecimals)));
+}
+
+static inline int32_t FixedWeight(const Scales &rScales, double net)
+{
+    return rScales.m_Weight.Apply(llround(ldexp(net, 8)));
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Check()
+//
+// Runs the trace through both paths.  Returns 'false' if any weight or length
+// differs by more than one LSB.
+/////////////////////////////////////////////////////////////////////////////////
+static bool Check(const Scales &rScales, const std::vector<double> &trace,
+                  double &rWeightExact, double &rLengthExact)
+{
+    size_t weightExact = 0U;
+    size_t lengthExact = 0U;
+    size_t checked = 0U;
+    bool ok = true;
+    for (size_t i = 0U; ok && (i < trace.size()); i++)
+    {
+        int32_t doubleWeight = DoubleWeight(rScales, trace[i]);
+        int32_t fixedWeight  = FixedWeight(rScales, trace[i]);
+        int32_t doubleLength = DoubleLength(rScales, fixedWeight);
+        int32_t fixedLength  = rScales.m_Length.Apply(fixedWeight);
+        weightExact += (fixedWeight == doubleWeight) ? 1U : 0U;
+        lengthExact += (fixedLength == doubleLength) ? 1U : 0U;
+        checked++;
+        if ((labs(fixedWeight - doubleWeight) > 1L) ||
+            (labs(fixedLength - doubleLength) > 1L))
+        {
+            printf("MISMATCH sample %zu (%.2f counts): weight %d != %d, "
+                   "length %d != %d\n", i, trace[i], fixedWeight, doubleWeight,
+                   fixedLength, doubleLength);
+            ok = false;
+        }
+    }
+    rWeightExact = 100.0 * weightExact / checked;
+    rLengthExact = 100.0 * lengthExact / checked;
+    return ok;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// TimePath()
+//
+// Returns the average time, in nanoseconds, to take one reading through a
+// path.  The floating point path is timed only as far as the sketch went (the
+// display values), without the conversion to LSBs used for checking.
+/////////////////////////////////////////////////////////////////////////////////
+static double TimePath(const Scales &rScales, const std::vector<double> &trace,
+                       bool fixed, double &rSink)
+{
+    auto start = std::chrono::steady_clock::now();
+    double sink = 0.0;
+    if (fixed)
+    {
+        for (size_t i = 0U; i < trace.size(); i++)
+        {
+            int32_t weight = FixedWeight(rScales, trace[i]);
+            sink += FixedScale::ToFloat(weight, rScales.m_Decimals) +
+                    FixedScale::ToFloat(rScales.m_Length.Apply(weight),
+                                        rScales.m_LengthDecimals);
+        }
+    }
+    else
+    {
+        for (size_t i = 0U; i < trace.size(); i++)
+        {
+            double weight = (trace[i] * rScales.m_UnitsPerCount) - rScales.m_Offset;
+            float currentWeight = SetDecimalPlaces(weight, rScales.m_Decimals);
+            sink += currentWeight +
+                    static_cast<float>(SetDecimalPlaces(
+                        rScales.m_LengthFactor * currentWeight,
+                        rScales.m_LengthDecimals));
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+    rSink += sink;
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           static_cast<double>(trace.size());
+}
+
+
+int main(int argc, char *argv[])
+{
+    size_t samples = (argc > 1) ? strtoul(argv[1], NULL, 0) : 5000000U;
+    LengthManager lengthMgr;
+    lengthMgr.SetUnits(luMm);
+
+    // Correctness first, on a shorter trace, both ways round.
+    std::vector<double> checkTrace = MakeTrace(500000U);
+    bool ok = true;
+    printf("Equivalence with the floating point path (exact match %%):\n");
+    for (const UnitsCase &units : UNITS)
+    {
+        for (double sign = 1.0; sign >= -1.0; sign -= 2.0)
+        {
+            Scales scales;
+            double weightExact = 0.0;
+            double lengthExact = 0.0;
+            bool caseOk = SetUp(scales, units, sign, lengthMgr) &&
+                          Check(scales, checkTrace, weightExact, lengthExact);
+            printf("  %-2s %s  shift %2u  weight %7.3f  length %7.3f  %s\n",
+                   units.m_pName, (sign > 0.0) ? "+" : "-", scales.m_Weight.GetShift(),
+                   weightExact, lengthExact, caseOk ? "PASS" : "FAIL");
+            ok = ok && caseOk;
+        }
+    }
+    printf("Equivalence within 1 LSB: %s\n", ok ? "PASS" : "FAIL");
+
+    // Now the timing.
+    std::vector<double> trace = MakeTrace(samples);
+    double sink = 0.0;
+    printf("\n%zu samples per run, ns per sample\n", samples);
+    printf("%5s %10s %10s %8s\n", "units", "double", "fixed", "speedup");
+    for (const UnitsCase &units : UNITS)
+    {
+        Scales scales;
+        SetUp(scales, units, 1.0, lengthMgr);
+        double doubleNs = TimePath(scales, trace, false, sink);
+        double fixedNs  = TimePath(scales, trace, true, sink);
+        printf("%5s %10.2f %10.2f %7.1fx\n", units.m_pName, doubleNs, fixedNs,
+               doubleNs / fixedNs);
+    }
+    printf("(checksum %.1f)\n", sink);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,397 @@
+/////////////////////////////////////////////////////////////////////////////////
+// JournalBench.cpp
+//
+// Host benchmark for the spool usage journal (UsageJournal), on a
+// JournalRamStorage the size of the sketch's journal partition.
+//
+// The wear run simulates days of printing: checkpoints of the spool on the
+// scale, spool swaps, and a tare each week.  It reports the bytes written to
+// flash and the spread of erases over the sectors, against rewriting the whole
+// SpoolManager NVS blob for each change.  It also checks the filament used
+// from each spool against what was actually printed: a tare throws away what
+// each spool has used since its last checkpoint, so up to CHECKPOINT_GRAMS
+// (plus noise) per tare may be missing.
+//
+// The power loss run repeats a shorter workload many times, cutting the power
+// after a random number of written bytes (tearing a record, a sector header or
+// an erase) one or more times per trial.  After each cut, the journal is
+// remounted and its state must match a journal that saw only the calls that
+// completed (with or without the one cut short).
+//
+// Usage:  JournalBench [days] [trials]
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>                // For isnan(), fabs().
+#include <cstdint>              // For uint32_t, ...
+#include <cstdio>               // For printf().
+#include <cstdlib>              // For strtoul().
+#include <cstring>              // For memcmp().
+#include <vector>               // For std::vector.
+#include "JournalRamStorage.h"  // For JournalRamStorage class.
+#include "Spool.h"              // For Spool class.
+#include "UsageJournal.h"       // For UsageJournal class.
+
+
+
+// The journal partition, and the sketch's spool count.
+static const size_t SECTOR_SIZE  = 4096U;
+static const size_t NUM_SECTORS  = 16U;
+static const size_t NUM_SPOOLS   = 15U;
+
+// The size of the spool table blob that SpoolManager used to save, and of the
+// NVS entry header written with each blob chunk.
+static const size_t BLOB_BYTES   = 2U * sizeof(uint32_t) + NUM_SPOOLS * sizeof(Spool::Record);
+static const size_t ENTRY_BYTES  = 32U;
+
+// The workload: a stable reading offered every few seconds, and filament used
+// at a typical rate while printing.
+static const uint32_t OFFER_S      = 5UL;
+static const uint32_t PRINT_S      = 8UL * 3600UL;  // Per day.
+static const uint32_t TARE_S       = 7UL * 86400UL;
+static const double   GRAMS_PER_S  = 0.5 / 60.0;
+static const double   NOISE_GRAMS  = 0.3;
+static const double   FULL_GRAMS   = 1000.0;
+static const double   EMPTY_GRAMS  = 50.0;
+static const double   CYCLES       = 100000.0;      // Flash erase endurance.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Random()
+//
+// A repeatable generator, returning [0, 1).
+/////////////////////////////////////////////////////////////////////////////////
+static double Random(uint32_t &rState)
+{
+    rState = rState * 1664525UL + 1013904223UL;
+    return static_cast<double>(rState >> 8) / 16777216.0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Call is one call made on the journal by the workload.
+/////////////////////////////////////////////////////////////////////////////////
+struct Call
+{
+    bool       m_Checkpoint;            // Checkpoint(), or Log().
+    UsageEvent m_Event;
+    uint8_t    m_Spool;
+    uint32_t   m_TimeS;
+    float      m_Grams;
+};
+
+
+static bool Make(UsageJournal &rJournal, const Call &rCall)
+{
+    return rCall.m_Checkpoint ?
+           rJournal.Checkpoint(rCall.m_Spool, rCall.m_TimeS, rCall.m_Grams) :
+           rJournal.Log(rCall.m_Event, rCall.m_Spool, rCall.m_TimeS);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Workload is a printer's day to day use of the scale.  Next() returns the
+// calls for the next OFFER_S seconds.
+/////////////////////////////////////////////////////////////////////////////////
+class Workload
+{
+public:
+    Workload(uint32_t seed) : m_Rand(seed), m_TimeS(0UL), m_Spool(0U)
+    {
+        for (size_t spool = 0U; spool < NUM_SPOOLS; spool++)
+        {
+            m_Grams[spool] = FULL_GRAMS;
+            m_Used[spool]  = 0.0;
+        }
+    }
+
+    void Next(std::vector<Call> &rCalls)
+    {
+        rCalls.clear();
+        uint32_t dayS = m_TimeS % 86400UL;
+        if ((m_TimeS % TARE_S) == 0UL)
+        {
+            Add(rCalls, false, eUeTare, UsageJournal::NO_SPOOL, 0.0f);
+        }
+        if ((dayS == PRINT_S) || (m_Grams[m_Spool] < EMPTY_GRAMS) ||
+            (Random(m_Rand) < 0.0005))
+        {
+            // A swap.  An empty spool is replaced with a full one.
+            m_Spool = static_cast<uint8_t>(Random(m_Rand) * NUM_SPOOLS);
+            if (m_Grams[m_Spool] < EMPTY_GRAMS)
+            {
+                m_Grams[m_Spool] = FULL_GRAMS;
+            }
+            Add(rCalls, false, eUeSelect, m_Spool, 0.0f);
+        }
+        if (dayS < PRINT_S)
+        {
+            double used = GRAMS_PER_S * OFFER_S;
+            m_Grams[m_Spool] -= used;
+            m_Used[m_Spool]  += used;
+        }
+        float reading = static_cast<float>(m_Grams[m_Spool] +
+                                           NOISE_GRAMS * (2.0 * Random(m_Rand) - 1.0));
+        Add(rCalls, true, eUeCheckpoint, m_Spool, reading);
+        m_TimeS += OFFER_S;
+    }
+
+    uint32_t GetTime() const                { return m_TimeS; }
+    double   GetUsed(size_t spool) const    { return m_Used[spool]; }
+
+private:
+    void Add(std::vector<Call> &rCalls, bool checkpoint, UsageEvent event,
+             uint8_t spool, float grams)
+    {
+        Call call = {checkpoint, event, spool, m_TimeS, grams};
+        rCalls.push_back(call);
+    }
+
+    uint32_t m_Rand;
+    uint32_t m_TimeS;
+    uint8_t  m_Spool;
+    double   m_Grams[NUM_SPOOLS];
+    double   m_Used[NUM_SPOOLS];
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SameState()
+//
+// Returns 'true' if two journals know the same about every spool.
+/////////////////////////////////////////////////////////////////////////////////
+static bool SameState(const UsageJournal &rA, const UsageJournal &rB)
+{
+    for (uint8_t spool = 0U; spool < UsageJournal::MAX_SPOOLS; spool++)
+    {
+        const SpoolUsage &rUa = rA.GetUsage(spool);
+        const SpoolUsage &rUb = rB.GetUsage(spool);
+        bool lastSame = (std::isnan(rUa.m_LastGrams) && std::isnan(rUb.m_LastGrams)) ||
+                        (rUa.m_LastGrams == rUb.m_LastGrams);
+        if (!lastSame || (rUa.m_UsedGrams != rUb.m_UsedGrams) ||
+            (!std::isnan(rUa.m_LastGrams) && (rUa.m_LastS != rUb.m_LastS)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Replay()
+//
+// Makes a list of calls on a new journal, in RAM with no power loss.
+/////////////////////////////////////////////////////////////////////////////////
+static bool Replay(UsageJournal &rJournal, JournalRamStorage &rStorage,
+                   const std::vector<Call> &calls)
+{
+    if (!rJournal.Init(&rStorage))
+    {
+        return false;
+    }
+    for (const Call &call : calls)
+    {
+        Make(rJournal, call);
+    }
+    return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WearRun()
+//
+// Runs the workload for a number of days.  Returns 'false' if the filament
+// used is out by more than a checkpoint per tare, or the journal doesn't come
+// back the same after a remount.
+/////////////////////////////////////////////////////////////////////////////////
+static bool WearRun(uint32_t days)
+{
+    JournalRamStorage storage(SECTOR_SIZE, NUM_SECTORS);
+    UsageJournal journal;
+    if (!journal.Init(&storage))
+    {
+        printf("Journal init failed\n");
+        return false;
+    }
+
+    Workload workload(1U);
+    std::vector<Call> calls;
+    uint32_t records = 0UL;
+    uint32_t blobSaves = 0UL;
+    uint32_t lastSequence = journal.GetSequence();
+    size_t lastSlot = journal.GetNextSlot();
+    while (workload.GetTime() < days * 86400UL)
+    {
+        workload.Next(calls);
+        for (const Call &call : calls)
+        {
+            if (!Make(journal, call))
+            {
+                printf("Journal write failed\n");
+                return false;
+            }
+
+            // Each logged record would have been a blob save.
+            if ((journal.GetSequence() != lastSequence) ||
+                (journal.GetNextSlot() != lastSlot))
+            {
+                records++;
+                blobSaves++;
+                lastSequence = journal.GetSequence();
+                lastSlot     = journal.GetNextSlot();
+            }
+        }
+        journal.Process();
+    }
+
+    uint32_t minErases = 0xFFFFFFFFUL;
+    uint32_t maxErases = 0UL;
+    for (size_t sector = 0U; sector < NUM_SECTORS; sector++)
+    {
+        uint32_t erases = storage.GetErases(sector);
+        minErases = (erases < minErases) ? erases : minErases;
+        maxErases = (erases > maxErases) ? erases : maxErases;
+    }
+    double blobBytes = static_cast<double>(blobSaves) *
+                       (BLOB_BYTES + ENTRY_BYTES * ((BLOB_BYTES + 31U) / 32U));
+    double erasesPerDay = static_cast<double>(maxErases) / days;
+
+    printf("Wear over %u days (%zu x %zu byte sectors, %u records):\n", days,
+           NUM_SECTORS, SECTOR_SIZE, records);
+    printf("  journal     %10u bytes  %8.0f bytes/day  erases/sector %u..%u\n",
+           storage.GetBytesWritten(), storage.GetBytesWritten() / static_cast<double>(days),
+           minErases, maxErases);
+    printf("  NVS blob    %10.0f bytes  %8.0f bytes/day  (%zu byte blob per save)\n",
+           blobBytes, blobBytes / days, BLOB_BYTES);
+    printf("  sector life %.0f years at %.2f erases/day\n",
+           (erasesPerDay > 0.0) ? CYCLES / erasesPerDay / 365.0 : INFINITY,
+           erasesPerDay);
+
+    // Used filament against the truth.
+    bool ok = true;
+    double worst = 0.0;
+    double allowed = (days * 86400.0 / TARE_S + 1.0) *
+                     (UsageJournal::CHECKPOINT_GRAMS + 2.0 * NOISE_GRAMS);
+    for (uint8_t spool = 0U; spool < NUM_SPOOLS; spool++)
+    {
+        double error = journal.GetUsage(spool).m_UsedGrams - workload.GetUsed(spool);
+        worst = (fabs(error) > fabs(worst)) ? error : worst;
+        if (fabs(error) > allowed)
+        {
+            printf("  spool %u used %.1f g, journal %.1f g\n", spool,
+                   workload.GetUsed(spool), journal.GetUsage(spool).m_UsedGrams);
+            ok = false;
+        }
+    }
+    printf("  used filament worst error %.2f g (%.0f g allowed): %s\n", worst,
+           allowed, ok ? "PASS" : "FAIL");
+
+    UsageJournal remounted;
+    bool same = remounted.Init(&storage) && SameState(journal, remounted);
+    printf("  remount: %s\n", same ? "PASS" : "FAIL");
+    return ok && same;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// PowerLossRun()
+//
+// Runs the power loss trials.  Returns 'false' if any remount doesn't match.
+/////////////////////////////////////////////////////////////////////////////////
+static bool PowerLossRun(uint32_t trials)
+{
+    // Small sectors, so that the ring wraps many times in each trial.
+    static const size_t SMALL_SECTOR = 512U;
+    static const size_t SMALL_COUNT  = 4U;
+    static const uint32_t TRIAL_S    = 3UL * 86400UL;
+
+    uint32_t rand = 7U;
+    uint32_t cuts = 0UL;
+    uint32_t cutShort = 0UL;
+    uint32_t failures = 0UL;
+    for (uint32_t trial = 0UL; trial < trials; trial++)
+    {
+        JournalRamStorage storage(SMALL_SECTOR, SMALL_COUNT);
+        UsageJournal journal;
+        journal.Init(&storage);
+        Workload workload(trial + 1UL);
+        std::vector<Call> done;
+        std::vector<Call> calls;
+        storage.SetWriteBudget(static_cast<uint32_t>(Random(rand) * 8000.0));
+
+        while (workload.GetTime() < TRIAL_S)
+        {
+            workload.Next(calls);
+            for (const Call &call : calls)
+            {
+                if (Make(journal, call) && !storage.IsPoweredOff())
+                {
+                    done.push_back(call);
+                    continue;
+                }
+
+                // The power failed.  Remount, and compare with a journal that
+                // saw the completed calls, then one that also saw this call.
+                cuts++;
+                storage.PowerOn();
+                UsageJournal reference;
+                JournalRamStorage referenceStorage(SECTOR_SIZE, NUM_SECTORS);
+                bool ok = journal.Init(&storage) &&
+                          Replay(reference, referenceStorage, done);
+                if (ok && SameState(journal, reference))
+                {
+                    cutShort++;
+                }
+                else if (ok)
+                {
+                    done.push_back(call);
+                    UsageJournal withCall;
+                    JournalRamStorage withCallStorage(SECTOR_SIZE, NUM_SECTORS);
+                    ok = Replay(withCall, withCallStorage, done) &&
+                         SameState(journal, withCall);
+                }
+                if (!ok)
+                {
+                    printf("  trial %u: state lost after %zu calls\n", trial,
+                           done.size());
+                    failures++;
+                    break;
+                }
+                storage.SetWriteBudget(static_cast<uint32_t>(Random(rand) * 8000.0));
+            }
+            if (failures > 0UL)
+            {
+                break;
+            }
+            if (Random(rand) < 0.2)
+            {
+                journal.Process();
+            }
+        }
+        if (failures > 0UL)
+        {
+            break;
+        }
+    }
+
+    printf("Power loss: %u trials, %u cuts (%u lost the call cut short): %s\n",
+           trials, cuts, cutShort, (failures == 0UL) ? "PASS" : "FAIL");
+    return failures == 0UL;
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t days   = (argc > 1) ? strtoul(argv[1], NULL, 0) : 365UL;
+    uint32_t trials = (argc > 2) ? strtoul(argv[2], NULL, 0) : 200UL;
+
+    bool ok = WearRun(days);
+    printf("\n");
+    ok = PowerLossRun(trials) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,266 @@
+/////////////////////////////////////////////////////////////////////////////////
+// MovingAverageBench.cpp
+//
+// Host microbenchmark for the MovingAverage template.  The reworked template
+// is compared with the original implementation (reproduced below as
+// LegacyMovingAverage) over a synthetic HX711 trace.  Before timing, each
+// configuration is checked to produce exactly the same averages as the
+// original, and the STATS variant is checked against a brute force
+// calculation of the window variance, minimum and maximum.
+//
+// The cost per sample is also expressed as a share of one CPU at the 10 and
+// 80 samples per second that the HX711 can deliver.  These are host numbers,
+// so only the ratios carry over to the ESP32.
+//
+// Usage:  MovingAverageBench [samples]
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>               // For timing.
+#include <cmath>                // For fabs(), sqrt().
+#include <cstdint>              // For int32_t, ...
+#include <cstdio>               // For printf().
+#include <cstdlib>              // For strtoul().
+#include <vector>               // For std::vector.
+#include "MovingAverage.h"      // For MovingAverage class.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// LegacyMovingAverage template class
+//
+// The MovingAverage implementation before the rework: a fixed 100 entry array
+// and a '%' for every value once the window is full.
+/////////////////////////////////////////////////////////////////////////////////
+template<class V, class T>
+class LegacyMovingAverage
+{
+public:
+    LegacyMovingAverage(size_t size = MIN_SIZE) : m_NumValues(0), m_Size(0), m_Total(0)
+    {
+        SetSize(size);
+    }
+
+    T Add(V val)
+    {
+        m_Total += val;
+        if (m_NumValues < m_Size)
+        {
+            m_Values[m_NumValues++] = val;
+        }
+        else
+        {
+            V &oldest = m_Values[m_NumValues++ % m_Size];
+            m_Total -= oldest;
+            oldest = val;
+        }
+        return m_Total;
+    }
+
+    V Average() const
+    {
+        return m_Total / static_cast<T>(m_NumValues < m_Size ? m_NumValues : m_Size);
+    }
+
+    void Reset()
+    {
+        m_Total = 0;
+        m_NumValues = 0;
+    }
+
+    size_t SetSize(size_t newSize)
+    {
+        if (newSize < MIN_SIZE)
+        {
+            newSize = MIN_SIZE;
+        }
+        else if (newSize > MAX_SIZE)
+        {
+            newSize = MAX_SIZE;
+        }
+        if (newSize != m_Size)
+        {
+            m_Size = newSize;
+            Reset();
+        }
+        return m_Size;
+    }
+
+private:
+    static const size_t MAX_SIZE = 100;
+    static const size_t MIN_SIZE = 1;
+
+    V         m_Values[MAX_SIZE];
+    size_t    m_NumValues;
+    size_t    m_Size;
+    T         m_Total;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MakeTrace()
+//
+// Builds a repeatable HX711-like trace: a no-load offset with noise, and a
+// load placed and removed every few thousand samples.
+/////////////////////////////////////////////////////////////////////////////////
+static std::vector<int32_t> MakeTrace(size_t count)
+{
+    std::vector<int32_t> trace(count);
+    uint32_t lcg = 12345U;
+    for (size_t i = 0U; i < count; i++)
+    {
+        lcg = lcg * 1664525U + 1013904223U;
+        int32_t noise = static_cast<int32_t>((lcg >> 16) % 201U) - 100;
+        int32_t load  = ((i / 4096U) & 1U) ? 420000 : 0;
+        trace[i] = 85000 + load + noise;
+    }
+    return trace;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// CheckAverages()
+//
+// Verifies that the reworked template produces the same averages as the
+// original for the given window.
+/////////////////////////////////////////////////////////////////////////////////
+static bool CheckAverages(const std::vector<int32_t> &trace, size_t window)
+{
+    LegacyMovingAverage<int32_t, int64_t> legacy(window);
+    MovingAverage<int32_t, int64_t>       current(window);
+    for (size_t i = 0U; i < trace.size(); i++)
+    {
+        legacy.Add(trace[i]);
+        current.Add(trace[i]);
+        if (legacy.Average() != current.Average())
+        {
+            printf("MISMATCH window %zu sample %zu: %d != %d\n", window, i,
+                   legacy.Average(), current.Average());
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// CheckStats()
+//
+// Verifies the STATS variant against a brute force calculation over the
+// window.
+/////////////////////////////////////////////////////////////////////////////////
+static bool CheckStats(const std::vector<int32_t> &trace, size_t window)
+{
+    MovingAverage<int32_t, int64_t, 128U, true> stats(window);
+    for (size_t i = 0U; i < trace.size(); i++)
+    {
+        stats.Add(trace[i]);
+
+        size_t first = (i + 1U >= window) ? i + 1U - window : 0U;
+        size_t count = i + 1U - first;
+        double sum = 0.0;
+        int32_t lo = trace[first];
+        int32_t hi = trace[first];
+        for (size_t j = first; j <= i; j++)
+        {
+            sum += trace[j];
+            lo = (trace[j] < lo) ? trace[j] : lo;
+            hi = (trace[j] > hi) ? trace[j] : hi;
+        }
+        double mean = sum / count;
+        double sumSquares = 0.0;
+        for (size_t j = first; j <= i; j++)
+        {
+            sumSquares += (trace[j] - mean) * (trace[j] - mean);
+        }
+        double variance = sumSquares / count;
+
+        if ((stats.Min() != lo) || (stats.Max() != hi) ||
+            (fabs(stats.Mean() - mean) > 1e-6) ||
+            (fabs(stats.Variance() - variance) > 1e-3 * (variance + 1.0)))
+        {
+            printf("STATS MISMATCH window %zu sample %zu\n", window, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// TimeAdds()
+//
+// Returns the average time, in nanoseconds, to add one sample and fetch the
+// average.
+/////////////////////////////////////////////////////////////////////////////////
+template<class A>
+static double TimeAdds(A &avg, const std::vector<int32_t> &trace, int64_t &rSink)
+{
+    auto start = std::chrono::steady_clock::now();
+    int64_t sink = 0;
+    for (size_t i = 0U; i < trace.size(); i++)
+    {
+        avg.Add(trace[i]);
+        sink += avg.Average();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    rSink += sink;
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           static_cast<double>(trace.size());
+}
+
+
+int main(int argc, char *argv[])
+{
+    size_t samples = (argc > 1) ? strtoul(argv[1], NULL, 0) : 20000000U;
+    const size_t WINDOWS[] = {1U, 5U, 10U, 25U, 64U, 100U};
+
+    // Correctness first, on a shorter trace.
+    std::vector<int32_t> checkTrace = MakeTrace(20000U);
+    bool ok = true;
+    for (size_t window : WINDOWS)
+    {
+        ok = CheckAverages(checkTrace, window) && ok;
+        ok = CheckStats(checkTrace, window) && ok;
+    }
+    printf("Equivalence with original implementation: %s\n", ok ? "PASS" : "FAIL");
+
+    // Now the timing.
+    std::vector<int32_t> trace = MakeTrace(samples);
+    int64_t sink = 0;
+    printf("\n%zu samples per run, ns per sample (percent CPU at 10 / 80 SPS)\n",
+           samples);
+    printf("%7s %22s %22s %22s\n", "window", "original", "reworked", "reworked+stats");
+    for (size_t window : WINDOWS)
+    {
+        LegacyMovingAverage<int32_t, int64_t>       legacy(window);
+        MovingAverage<int32_t, int64_t>             current(window);
+        MovingAverage<int32_t, int64_t, 128U, true> stats(window);
+        double times[3];
+        times[0] = TimeAdds(legacy, trace, sink);
+        times[1] = TimeAdds(current, trace, sink);
+        times[2] = TimeAdds(stats, trace, sink);
+
+        printf("%7zu", window);
+        for (double ns : times)
+        {
+            // Percent of one CPU = ns per sample * samples per second / 1e7.
+            printf("  %6.2f (%.0e/%.0e%%)", ns, ns * 10.0 / 1e7, ns * 80.0 / 1e7);
+        }
+        printf("\n");
+    }
+
+    printf("\nMemory: original %zu bytes, reworked %zu bytes (64 entry: %zu), "
+           "reworked+stats %zu bytes\n",
+           sizeof(LegacyMovingAverage<int32_t, int64_t>),
+           sizeof(MovingAverage<int32_t, int64_t>),
+           sizeof(MovingAverage<int32_t, int64_t, 64U>),
+           sizeof(MovingAverage<int32_t, int64_t, 128U, true>));
+    printf("(checksum %lld)\n", static_cast<long long>(sink));
+
+    return ok ? 0 : 1;
+}
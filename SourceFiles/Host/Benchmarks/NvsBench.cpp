@@ -0,0 +1,396 @@
+/////////////////////////////////////////////////////////////////////////////////
+// NvsBench.cpp
+//
+// Host benchmark for the NVS persistence (NvsStore and SpoolManager), counting
+// the host NVS opens, reads and writes each save costs.  It is compared with
+// the way SpoolManager saved before (reproduced below): open NVS, read back
+// the blob of every spool, compare it with one built from RAM, and rewrite it
+// all if it differs.
+//
+// The cases are:
+//    - Editing one field of one spool, then saving.
+//    - Saving when nothing has changed, for the spools and for the objects that
+//      use NvsStore::PutIfChanged() (Filament and LengthManager here).
+//    - A burst of edits to one spool, each requesting a deferred save, with
+//      NvsStore::Process() called as loop() would.
+//
+// It also checks that state saved as a blob by earlier versions is restored,
+// moved to the per spool keys by the next Save(), and restored from them.
+//
+// Usage:  NvsBench
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>              // For uint32_t, ...
+#include <cstdio>               // For printf().
+#include <cstring>              // For memcmp().
+#include <Preferences.h>        // For HostNvs and the legacy save.
+#include "Filament.h"           // For Filament class.
+#include "LengthManager.h"      // For LengthManager class.
+#include "NvsStore.h"           // For NvsStore class.
+#include "SpoolManager.h"       // For SpoolManager class.
+
+
+// The sketch's spool count and NVS names.
+static const size_t NUM_SPOOLS       = 15U;
+static const char  *pSpoolNvsName    = "SpoolMgr";
+static const char  *pFilamentNvsName = "Filament";
+static const char  *pLengthNvsName   = "LengthMgr";
+static const char  *pLegacyLabel     = "Saved State";
+
+typedef SpoolManager<NUM_SPOOLS> Spools;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// The blob SpoolManager saved before.
+/////////////////////////////////////////////////////////////////////////////////
+struct LegacyBlob
+{
+    uint32_t      m_NumSpools;
+    Spool::Record m_Spools[NUM_SPOOLS];
+    uint32_t      m_SelectedSpoolIndex;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// NVS activity between two points.
+/////////////////////////////////////////////////////////////////////////////////
+struct NvsCounts
+{
+    uint32_t m_Opens;
+    uint32_t m_Reads;
+    uint32_t m_Writes;
+    uint32_t m_Bytes;
+};
+
+
+static NvsCounts Snapshot()
+{
+    NvsCounts counts;
+    counts.m_Opens  = HostNvs::GetOpenCount();
+    counts.m_Reads  = HostNvs::GetReadCount();
+    counts.m_Writes = HostNvs::GetWriteCount();
+    counts.m_Bytes  = HostNvs::GetBytesWritten();
+    return counts;
+}
+
+
+static NvsCounts Since(const NvsCounts &rStart)
+{
+    NvsCounts counts = Snapshot();
+    counts.m_Opens  -= rStart.m_Opens;
+    counts.m_Reads  -= rStart.m_Reads;
+    counts.m_Writes -= rStart.m_Writes;
+    counts.m_Bytes  -= rStart.m_Bytes;
+    return counts;
+}
+
+
+static void PrintCounts(const char *pLabel, const NvsCounts &rCounts)
+{
+    printf("  %-10s %3u opens %3u reads %3u writes %5u bytes\n", pLabel,
+           static_cast<unsigned>(rCounts.m_Opens), static_cast<unsigned>(rCounts.m_Reads),
+           static_cast<unsigned>(rCounts.m_Writes), static_cast<unsigned>(rCounts.m_Bytes));
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// BuildBlob()
+//
+// Builds the legacy blob from the spools.
+/////////////////////////////////////////////////////////////////////////////////
+static void BuildBlob(Spools &rSpools, LegacyBlob &rBlob)
+{
+    rBlob.m_NumSpools = NUM_SPOOLS;
+    for (size_t i = 0U; i < NUM_SPOOLS; i++)
+    {
+        rSpools.GetSpool(i)->GetRecord(rBlob.m_Spools[i]);
+    }
+    rBlob.m_SelectedSpoolIndex = rSpools.GetSelectedSpoolIndex();
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// LegacySave()
+//
+// SpoolManager::Save() as it was: read back, compare, rewrite everything.
+/////////////////////////////////////////////////////////////////////////////////
+static bool LegacySave(Spools &rSpools)
+{
+    LegacyBlob current;
+    BuildBlob(rSpools, current);
+
+    Preferences prefs;
+    prefs.begin(pSpoolNvsName);
+    LegacyBlob nvsState;
+    size_t nvsSize = prefs.getBytes(pLegacyLabel, &nvsState, sizeof(nvsState));
+    size_t saved = sizeof(current);
+    if ((nvsSize != sizeof(current)) || memcmp(&nvsState, &current, sizeof(current)))
+    {
+        saved = prefs.putBytes(pLegacyLabel, &current, sizeof(current));
+    }
+    prefs.end();
+    return saved == sizeof(current);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetupSpools()
+//
+// Gives each spool its own values, so that records differ.
+/////////////////////////////////////////////////////////////////////////////////
+static void SetupSpools(Spools &rSpools)
+{
+    for (size_t i = 0U; i < NUM_SPOOLS; i++)
+    {
+        char name[Spool::MAX_NAME_SIZE + 1];
+        snprintf(name, sizeof(name), "Bench %u", static_cast<unsigned>(i));
+        Spool *pSpool = rSpools.GetSpool(i);
+        pSpool->SetName(name);
+        pSpool->SetSpoolWeight(200.0f + static_cast<float>(i));
+        pSpool->SetColor(static_cast<uint16_t>(0x1000U + i));
+    }
+    rSpools.SelectSpool(3U);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SameSpools()
+//
+// Returns 'true' if two spool managers hold the same spools and selection.
+/////////////////////////////////////////////////////////////////////////////////
+static bool SameSpools(Spools &rA, Spools &rB)
+{
+    LegacyBlob a;
+    LegacyBlob b;
+    BuildBlob(rA, a);
+    BuildBlob(rB, b);
+    return !memcmp(&a, &b, sizeof(a));
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// EditOneSpool()
+//
+// Edits one field of one spool and saves, the old way and the new way.
+/////////////////////////////////////////////////////////////////////////////////
+static bool EditOneSpool()
+{
+    printf("Edit one spool field, then save:\n");
+    bool ok = true;
+
+    HostNvs::Erase();
+    Spools legacy;
+    legacy.Init(pSpoolNvsName);
+    SetupSpools(legacy);
+    LegacySave(legacy);
+    legacy.GetSpool(7U)->SetSpoolWeight(250.0f);
+    NvsCounts start = Snapshot();
+    ok &= LegacySave(legacy);
+    NvsCounts legacyCounts = Since(start);
+    PrintCounts("Before:", legacyCounts);
+
+    HostNvs::Erase();
+    Spools spools;
+    spools.Init(pSpoolNvsName);
+    SetupSpools(spools);
+    spools.Save();
+    NvsStore::Close();
+    spools.GetSpool(7U)->SetSpoolWeight(250.0f);
+    start = Snapshot();
+    ok &= spools.Save();
+    NvsStore::Close();
+    NvsCounts counts = Since(start);
+    PrintCounts("After:", counts);
+
+    // Only spool 7 is written, and it restores.
+    Spools restored;
+    restored.Init(pSpoolNvsName);
+    ok &= restored.Restore() && SameSpools(spools, restored);
+    ok &= (counts.m_Writes == 1U) && (counts.m_Bytes == sizeof(Spool::Record)) &&
+          (counts.m_Reads == 0U);
+    printf("  One record written, no read back, restores: %s\n\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveUnchanged()
+//
+// Saves with nothing changed since the last save or restore.
+/////////////////////////////////////////////////////////////////////////////////
+static bool SaveUnchanged()
+{
+    printf("Save with nothing changed (spools, filament, length units):\n");
+    bool ok = true;
+
+    HostNvs::Erase();
+    Spools legacy;
+    legacy.Init(pSpoolNvsName);
+    SetupSpools(legacy);
+    LegacySave(legacy);
+    NvsCounts start = Snapshot();
+    ok &= LegacySave(legacy);
+    PrintCounts("Before:", Since(start));
+    printf("             (plus an open and a read for each other object)\n");
+
+    HostNvs::Erase();
+    Spools spools;
+    Filament filament;
+    LengthManager lengthMgr;
+    spools.Init(pSpoolNvsName);
+    filament.Init(pFilamentNvsName);
+    lengthMgr.Init(pLengthNvsName);
+    SetupSpools(spools);
+    spools.Save();
+    filament.Save();
+    lengthMgr.Save();
+    NvsStore::Close();
+
+    // As at power up.
+    Spools restoredSpools;
+    Filament restoredFilament;
+    LengthManager restoredLengthMgr;
+    restoredSpools.Init(pSpoolNvsName);
+    restoredFilament.Init(pFilamentNvsName);
+    restoredLengthMgr.Init(pLengthNvsName);
+    ok &= restoredSpools.Restore() && restoredFilament.Restore() &&
+          restoredLengthMgr.Restore();
+    NvsStore::Close();
+
+    start = Snapshot();
+    ok &= restoredSpools.Save() && restoredFilament.Save() && restoredLengthMgr.Save();
+    NvsStore::Close();
+    NvsCounts counts = Since(start);
+    PrintCounts("After:", counts);
+    ok &= (counts.m_Opens == 0U) && (counts.m_Reads == 0U) && (counts.m_Writes == 0U);
+    printf("  No NVS access: %s\n\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// EditBurst()
+//
+// Edits every field of a spool a second apart, each followed by a deferred save
+// request, with NvsStore::Process() called every 10 ms.
+/////////////////////////////////////////////////////////////////////////////////
+static Spools *gpBurstSpools = NULL;
+
+static bool SaveBurstSpools()
+{
+    return gpBurstSpools->Save();
+}
+
+
+static bool EditBurst()
+{
+    printf("Burst of 5 edits to one spool, 1 s apart, deferred saves:\n");
+    bool ok = true;
+
+    HostNvs::Erase();
+    Spools spools;
+    spools.Init(pSpoolNvsName);
+    SetupSpools(spools);
+    spools.Save();
+    NvsStore::Close();
+
+    gpBurstSpools = &spools;
+    NvsStore::SetSaveHandler(SaveBurstSpools);
+    NvsCounts start = Snapshot();
+    Spool *pSpool = spools.GetSpool(2U);
+    uint32_t lastWriteMs = 0UL;
+    for (uint32_t nowMs = 0UL; nowMs < 20000UL; nowMs += 10UL)
+    {
+        switch (nowMs)
+        {
+            case 0UL:    pSpool->SetName("Burst");          break;
+            case 1000UL: pSpool->SetType(eFtPetg);          break;
+            case 2000UL: pSpool->SetDensity(1.27f);         break;
+            case 3000UL: pSpool->SetDiameter(2.85f);        break;
+            case 4000UL: pSpool->SetSpoolWeight(180.0f);    break;
+            default:                                        break;
+        }
+        if ((nowMs <= 4000UL) && (nowMs % 1000UL == 0UL))
+        {
+            NvsStore::RequestSave(nowMs);
+        }
+        uint32_t writes = HostNvs::GetWriteCount();
+        NvsStore::Process(nowMs);
+        if (HostNvs::GetWriteCount() != writes)
+        {
+            lastWriteMs = nowMs;
+        }
+    }
+    NvsStore::SetSaveHandler(NULL);
+    NvsCounts counts = Since(start);
+    PrintCounts("After:", counts);
+    printf("  Saved at %u ms\n", static_cast<unsigned>(lastWriteMs));
+
+    Spools restored;
+    restored.Init(pSpoolNvsName);
+    ok &= restored.Restore() && SameSpools(spools, restored);
+    ok &= (counts.m_Writes == 1U) && (lastWriteMs == 4000UL + NvsStore::SAVE_DELAY_MS);
+    printf("  One write, SAVE_DELAY_MS after the last edit, restores: %s\n\n",
+           ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Migrate()
+//
+// Restores a legacy blob, saves, and checks that the blob is replaced by the
+// per spool keys.
+/////////////////////////////////////////////////////////////////////////////////
+static bool Migrate()
+{
+    printf("Legacy blob migration:\n");
+    bool ok = true;
+
+    HostNvs::Erase();
+    Spools legacy;
+    legacy.Init(pSpoolNvsName);
+    SetupSpools(legacy);
+    LegacySave(legacy);
+
+    Spools spools;
+    spools.Init(pSpoolNvsName);
+    ok &= spools.Restore() && SameSpools(legacy, spools);
+    ok &= spools.Save();
+    NvsStore::Close();
+
+    Preferences prefs;
+    prefs.begin(pSpoolNvsName);
+    bool blobGone = !prefs.isKey(pLegacyLabel);
+    prefs.end();
+
+    Spools restored;
+    restored.Init(pSpoolNvsName);
+    ok &= blobGone && restored.Restore() && SameSpools(legacy, restored);
+    printf("  Restored, moved to per spool keys, restored again: %s\n\n",
+           ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// main()
+/////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    // The objects report each save.
+    Serial.SetEnabled(false);
+
+    bool ok = true;
+    ok &= EditOneSpool();
+    ok &= SaveUnchanged();
+    ok &= EditBurst();
+    ok &= Migrate();
+    printf("NVS persistence: %s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,491 @@
+/////////////////////////////////////////////////////////////////////////////////
+// TraceBench.cpp
+//
+// Host benchmark of the weighing filters.  HX711 traces are replayed through
+// LoadCell::ReadWeight() (and so through the whole filter pipeline) once for
+// each filter setting, and the readings are scored:
+//
+//   Settle     Seconds from the load change until the reading stays within
+//              the tolerance (default 1 g) of the reference.
+//   Overshoot  Largest excursion past the reference in the direction of the
+//              load change.
+//   Noise      Standard deviation of the readings about the reference over
+//              the last REF_SECONDS.
+//   Error      Mean of the readings less the reference over the last
+//              REF_SECONDS.  Shows filter lag while the load drifts.
+//   CPU        Host nanoseconds per ReadWeight() call, i.e. per sample.
+//
+// The reference for each reading is the median of the raw trace samples in a
+// REF_SECONDS window centred on it (not crossing the load change).  It is
+// independent of the filters being judged, ignores knocks, and follows drift.
+//
+// Without trace files the synthetic scenarios in Sim/TraceScenarios are used.
+// Recorded traces (see Sim/TraceTransport.h for the format) must start with
+// at least a couple of seconds of empty scale for the tare.  Their load change
+// is taken to be the first sample more than EVENT_GRAMS from the tare, unless
+// given with -e.
+//
+// Usage:  TraceBench [options] [trace-file ...]
+//   -r sps       Sample rate for traces without times (default 10).
+//   -k counts    Counts per gram (default 420).
+//   -g grams     Settle tolerance (default 1).
+//   -e seconds   Load change time for trace files.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>                   // For timing.
+#include <cmath>                    // For sqrt(), fabs().
+#include <cstdio>                   // For printf().
+#include <cstdlib>                  // For strtod().
+#include <algorithm>                // For std::nth_element().
+#include <vector>                   // For std::vector.
+#include <unistd.h>                 // For getopt().
+#include <Arduino.h>                // For Serial, HostSim.
+#include "LoadCell.h"               // For LoadCell class.
+#include "TraceTransport.h"         // For TraceTransport class.
+#include "TraceScenarios.h"         // For synthetic traces.
+
+
+// A filter setting to be benchmarked.
+struct BenchSetting
+{
+    const char  *m_pName;
+    FilterConfig m_Filters;
+    int32_t      m_AverageSize;
+};
+
+// Scores for one setting on one trace.  Negative settle means no load change,
+// and infinity means the reading never settled.
+struct BenchResult
+{
+    double m_SettleSeconds;
+    double m_OvershootGrams;
+    double m_NoiseGrams;
+    double m_ErrorGrams;
+    double m_NsPerSample;
+};
+
+// A single ReadWeight() result.
+struct BenchReading
+{
+    double m_Seconds;
+    double m_Grams;
+    size_t m_Sample;                // Index of the last trace sample read.
+};
+
+// Bench options.
+struct BenchOptions
+{
+    double m_Sps;
+    double m_CountsPerGram;
+    double m_ToleranceGrams;
+    double m_EventSeconds;          // Negative to detect.
+};
+
+static const double   REF_SECONDS    = 5.0;     // Reference/noise window.
+static const double   EVENT_GRAMS    = 20.0;    // Load change detection.
+static const uint16_t TARE_COUNT     = 20U;     // Samples used to tare.
+static const double   CAL_GRAMS      = 1000.0;  // Calibration weight.
+
+// The settings benchmarked: the raw reading, then the averaging sizes the
+// Scale menu offers (1..25 readings, default 13) with each low-pass stage.
+static const BenchSetting Settings[] =
+{
+    {"raw",                 {1U, eLpNone,   0U},  1},
+    {"med3 step avg1",      {3U, eLpNone,   1U},  1},
+    {"med3 step iir avg1",  {3U, eLpIir,    1U},  1},
+    {"med3 step kal avg1",  {3U, eLpKalman, 1U},  1},
+    {"med3 step avg5",      {3U, eLpNone,   1U},  5},
+    {"med3 step iir avg5",  {3U, eLpIir,    1U},  5},
+    {"med3 step kal avg5",  {3U, eLpKalman, 1U},  5},
+    {"med3 avg13",          {3U, eLpNone,   0U}, 13},
+    {"med3 step avg13",     {3U, eLpNone,   1U}, 13},
+    {"med3 step iir avg13", {3U, eLpIir,    1U}, 13},
+    {"med3 step kal avg13", {3U, eLpKalman, 1U}, 13},
+    {"med3 step avg25",     {3U, eLpNone,   1U}, 25},
+    {"med3 step iir avg25", {3U, eLpIir,    1U}, 25},
+    {"med3 step kal avg25", {3U, eLpKalman, 1U}, 25},
+};
+static const size_t NUM_SETTINGS = sizeof(Settings) / sizeof(Settings[0]);
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Replay()
+//
+// Replays the trace through a freshly tared and calibrated LoadCell using the
+// given setting.
+//
+// Arguments:
+//    - rTrace    - The trace.
+//    - rSetting  - The filter setting.
+//    - rOpts     - Bench options.
+//    - rReadings - Receives the readings taken after calibration.
+//    - rTareRaw  - Receives the raw tare value.
+//
+// Returns:
+//    Returns the host nanoseconds per reading, or a negative value if the
+//    load cell could not be tared or calibrated.
+/////////////////////////////////////////////////////////////////////////////////
+static double Replay(TraceTransport &rTrace, const BenchSetting &rSetting,
+                     const BenchOptions &rOpts,
+                     std::vector<BenchReading> &rReadings, int32_t &rTareRaw)
+{
+    HostSim::SetMicros(0ULL);
+    rTrace.Rewind();
+    rReadings.clear();
+
+    LoadCell loadCell(&rTrace);
+    Serial.SetEnabled(false);
+    bool ok = loadCell.Init("Trace Bench") &&
+              loadCell.Tare(TARE_COUNT) &&
+              loadCell.Calibrate(static_cast<uint32_t>(loadCell.GetTareValue() +
+                                     CAL_GRAMS * rOpts.m_CountsPerGram + 0.5),
+                                 CAL_GRAMS) &&
+              loadCell.SetFilterConfig(rSetting.m_Filters);
+    loadCell.SetAverageInterval(rSetting.m_AverageSize);
+    Serial.SetEnabled(true);
+    if (!ok)
+    {
+        return -1.0;
+    }
+    rTareRaw = loadCell.GetTareValue();
+
+    // Time the readings alone; bookkeeping is outside the timed region.
+    rReadings.reserve(rTrace.GetNumSamples());
+    double ns = 0.0;
+    while (!rTrace.AtEnd())
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        double grams = loadCell.ReadWeight();
+        ns += std::chrono::duration<double, std::nano>(
+                  std::chrono::steady_clock::now() - start).count();
+        BenchReading reading = {HostSim::GetMicros() / 1.0e6, grams,
+                                rTrace.GetPosition() - 1U};
+        rReadings.push_back(reading);
+    }
+    return rReadings.empty() ? 0.0 : ns / rReadings.size();
+} // End Replay().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// BuildReference()
+//
+// Calculates the reference weight for each trace sample: the median of the
+// raw samples, in grams, within REF_SECONDS / 2 either side of it.  The window
+// doesn't cross the load change.
+//
+// Arguments:
+//    - rTrace        - The trace.
+//    - tareRaw       - The raw tare value.
+//    - countsPerGram - Load cell sensitivity.
+//    - eventSeconds  - Time of the load change, or negative if none.
+//    - rReference    - Receives the reference for each sample.
+/////////////////////////////////////////////////////////////////////////////////
+static void BuildReference(const TraceTransport &rTrace, int32_t tareRaw,
+                           double countsPerGram, double eventSeconds,
+                           std::vector<double> &rReference)
+{
+    const size_t   numSamples = rTrace.GetNumSamples();
+    const uint64_t halfUs     = static_cast<uint64_t>(REF_SECONDS * 0.5e6);
+    const uint64_t eventUs    = (eventSeconds < 0.0) ? 0ULL :
+                                static_cast<uint64_t>(eventSeconds * 1.0e6 + 0.5);
+    std::vector<double> window;
+    rReference.resize(numSamples);
+
+    size_t first = 0;
+    size_t last  = 0;
+    for (size_t i = 0; i < numSamples; i++)
+    {
+        uint64_t timeUs = rTrace.GetTimeUs(i);
+        uint64_t lowUs  = (timeUs > halfUs) ? timeUs - halfUs : 0ULL;
+        uint64_t highUs = timeUs + halfUs;
+        if ((eventUs != 0ULL) && (timeUs >= eventUs))
+        {
+            lowUs = std::max(lowUs, eventUs);
+        }
+        else if (eventUs != 0ULL)
+        {
+            highUs = std::min(highUs, eventUs - 1U);
+        }
+
+        while ((first < i) && (rTrace.GetTimeUs(first) < lowUs))
+        {
+            first++;
+        }
+        while ((first > 0) && (rTrace.GetTimeUs(first - 1) >= lowUs))
+        {
+            first--;
+        }
+        last = std::max(last, i);
+        while ((last + 1 < numSamples) && (rTrace.GetTimeUs(last + 1) <= highUs))
+        {
+            last++;
+        }
+        while ((last > i) && (rTrace.GetTimeUs(last) > highUs))
+        {
+            last--;
+        }
+
+        window.clear();
+        for (size_t j = first; j <= last; j++)
+        {
+            window.push_back((rTrace.GetRaw(j) - tareRaw) / countsPerGram);
+        }
+        std::nth_element(window.begin(), window.begin() + window.size() / 2,
+                         window.end());
+        rReference[i] = window[window.size() / 2];
+    }
+} // End BuildReference().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Score()
+//
+// Scores the readings from one replay.
+//
+// Arguments:
+//    - rReadings    - The readings.
+//    - rReference   - The reference for each trace sample.
+//    - eventSeconds - Time of the load change, or negative if none.
+//    - tolerance    - Settle tolerance in grams.
+//    - rResult      - Receives the scores (all but m_NsPerSample).
+/////////////////////////////////////////////////////////////////////////////////
+static void Score(const std::vector<BenchReading> &rReadings,
+                  const std::vector<double> &rReference,
+                  double eventSeconds, double tolerance, BenchResult &rResult)
+{
+    const double endSeconds = rReadings.back().m_Seconds;
+
+    // Noise and error over the last REF_SECONDS.
+    double sum = 0.0;
+    double sumSq = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < rReadings.size(); i++)
+    {
+        if (rReadings[i].m_Seconds > endSeconds - REF_SECONDS)
+        {
+            double diff = rReadings[i].m_Grams - rReference[rReadings[i].m_Sample];
+            sum   += diff;
+            sumSq += diff * diff;
+            count++;
+        }
+    }
+    double mean = sum / count;
+    rResult.m_ErrorGrams = mean;
+    rResult.m_NoiseGrams = sqrt(fmax(sumSq / count - mean * mean, 0.0));
+
+    rResult.m_SettleSeconds  = -1.0;
+    rResult.m_OvershootGrams = 0.0;
+    if (eventSeconds < 0.0)
+    {
+        return;
+    }
+
+    // The reference either side of the load change gives its direction.
+    double before = 0.0;
+    double after  = rReference.back();
+    for (size_t i = 0; i < rReadings.size(); i++)
+    {
+        if (rReadings[i].m_Seconds < eventSeconds)
+        {
+            before = rReference[rReadings[i].m_Sample];
+        }
+        else
+        {
+            after = rReference[rReadings[i].m_Sample];
+            break;
+        }
+    }
+    double direction = (after >= before) ? 1.0 : -1.0;
+
+    // Settled at the reading after the last one outside the tolerance.
+    double settledAt = -1.0;
+    bool   outside   = true;
+    for (size_t i = 0; i < rReadings.size(); i++)
+    {
+        const BenchReading &rReading = rReadings[i];
+        if (rReading.m_Seconds < eventSeconds)
+        {
+            continue;
+        }
+        double diff = rReading.m_Grams - rReference[rReading.m_Sample];
+        rResult.m_OvershootGrams = fmax(rResult.m_OvershootGrams, diff * direction);
+        if (fabs(diff) > tolerance)
+        {
+            outside = true;
+        }
+        else if (outside)
+        {
+            outside   = false;
+            settledAt = rReading.m_Seconds;
+        }
+    }
+    rResult.m_SettleSeconds = outside ? INFINITY : settledAt - eventSeconds;
+} // End Score().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FindEvent()
+//
+// Returns the time of the first sample after the tare that is more than
+// EVENT_GRAMS from the tare, or a negative value if there is none.
+/////////////////////////////////////////////////////////////////////////////////
+static double FindEvent(const TraceTransport &rTrace, int32_t tareRaw,
+                        double countsPerGram)
+{
+    for (size_t i = TARE_COUNT; i < rTrace.GetNumSamples(); i++)
+    {
+        if (fabs((rTrace.GetRaw(i) - tareRaw) / countsPerGram) > EVENT_GRAMS)
+        {
+            return rTrace.GetTimeUs(i) / 1.0e6;
+        }
+    }
+    return -1.0;
+} // End FindEvent().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// BenchTrace()
+//
+// Runs every setting over one trace and prints a table of the scores.
+//
+// Arguments:
+//    - pName        - Name of the trace.
+//    - rTrace       - The trace.
+//    - eventSeconds - Time of the load change, or negative if none.
+//    - detect       - If 'true', find the load change rather than using
+//                     'eventSeconds'.
+//    - rOpts        - Bench options.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the trace was unusable.
+/////////////////////////////////////////////////////////////////////////////////
+static bool BenchTrace(const char *pName, TraceTransport &rTrace,
+                       double eventSeconds, bool detect, const BenchOptions &rOpts)
+{
+    std::vector<BenchReading> readings;
+    std::vector<double> reference;
+    BenchResult results[NUM_SETTINGS];
+    int32_t tareRaw = 0L;
+
+    for (size_t s = 0; s < NUM_SETTINGS; s++)
+    {
+        results[s].m_NsPerSample = Replay(rTrace, Settings[s], rOpts, readings, tareRaw);
+        if ((results[s].m_NsPerSample < 0.0) || readings.empty())
+        {
+            fprintf(stderr, "%s: unable to tare and calibrate.\n", pName);
+            return false;
+        }
+
+        // Every replay tares the same way, so the reference is only built once.
+        if (s == 0)
+        {
+            if (detect)
+            {
+                eventSeconds = FindEvent(rTrace, tareRaw, rOpts.m_CountsPerGram);
+            }
+            BuildReference(rTrace, tareRaw, rOpts.m_CountsPerGram, eventSeconds,
+                           reference);
+
+            printf("\n%s: %zu samples, ", pName, rTrace.GetNumSamples());
+            if (eventSeconds >= 0.0)
+            {
+                printf("load change at %.1f s, ", eventSeconds);
+            }
+            printf("final reference %.2f g\n", reference.back());
+            printf("  %-21s %9s %10s %9s %9s %10s\n", "Setting", "Settle s",
+                   "Overshoot", "Noise g", "Error g", "ns/sample");
+        }
+        Score(readings, reference, eventSeconds, rOpts.m_ToleranceGrams, results[s]);
+    }
+
+    for (size_t s = 0; s < NUM_SETTINGS; s++)
+    {
+        char settle[16];
+        if (results[s].m_SettleSeconds < 0.0)
+        {
+            snprintf(settle, sizeof(settle), "-");
+        }
+        else if (std::isinf(results[s].m_SettleSeconds))
+        {
+            snprintf(settle, sizeof(settle), "never");
+        }
+        else
+        {
+            snprintf(settle, sizeof(settle), "%.1f", results[s].m_SettleSeconds);
+        }
+        printf("  %-21s %9s %10.2f %9.3f %9.3f %10.1f\n", Settings[s].m_pName,
+               settle, results[s].m_OvershootGrams, results[s].m_NoiseGrams,
+               results[s].m_ErrorGrams, results[s].m_NsPerSample);
+    }
+    return true;
+} // End BenchTrace().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// main()
+/////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+    BenchOptions opts = {TraceTransport::DEFAULT_SPS, 420.0, 1.0, -1.0};
+    int opt;
+    while ((opt = getopt(argc, argv, "r:k:g:e:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'r': opts.m_Sps            = strtod(optarg, NULL); break;
+        case 'k': opts.m_CountsPerGram  = strtod(optarg, NULL); break;
+        case 'g': opts.m_ToleranceGrams = strtod(optarg, NULL); break;
+        case 'e': opts.m_EventSeconds   = strtod(optarg, NULL); break;
+        default:
+            fprintf(stderr, "Usage: %s [-r sps] [-k counts/g] [-g grams] "
+                            "[-e seconds] [trace ...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if ((opts.m_Sps <= 0.0) || (opts.m_CountsPerGram <= 0.0) ||
+        (opts.m_ToleranceGrams <= 0.0))
+    {
+        fprintf(stderr, "Bad option value.\n");
+        return 2;
+    }
+    printf("Settle tolerance %.2f g, %.0f counts/g, %.1f SPS\n",
+           opts.m_ToleranceGrams, opts.m_CountsPerGram, opts.m_Sps);
+
+    bool ok = true;
+    if (optind < argc)
+    {
+        // Recorded traces.
+        for (int i = optind; i < argc; i++)
+        {
+            TraceTransport trace(opts.m_Sps);
+            if (!trace.Load(argv[i]) || (trace.GetNumSamples() <= TARE_COUNT))
+            {
+                fprintf(stderr, "Unable to load trace '%s'.\n", argv[i]);
+                ok = false;
+                continue;
+            }
+            ok = BenchTrace(argv[i], trace, opts.m_EventSeconds,
+                            opts.m_EventSeconds < 0.0, opts) && ok;
+        }
+    }
+    else
+    {
+        // Synthetic scenarios.
+        for (int s = 0; s < eTsNumScenarios; s++)
+        {
+            TraceScenario scenario = static_cast<TraceScenario>(s);
+            TraceTransport trace(opts.m_Sps);
+            double eventSeconds = BuildScenario(scenario, trace, opts.m_CountsPerGram);
+            ok = BenchTrace(GetScenarioName(scenario), trace, eventSeconds,
+                            false, opts) && ok;
+        }
+    }
+
+    return ok ? 0 : 1;
+} // End main().
@@ -0,0 +1,613 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Adafruit_GFX.cpp
+//
+// Host (Linux) implementation of the Adafruit GFX library stand-in.  Each
+// method follows the library's own, so that it calls the display driver's
+// primitives just as it would on the device.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "Adafruit_GFX.h"
+
+
+// The built in font's glyphs for the printable ASCII characters, 5 columns of
+// 8 pixels each (bit 0 at the top).
+static const uint8_t gFont[][5] =
+{
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00},  //   !
+    {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14},  // " #
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},  // $ %
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00},  // & '
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00},  // ( )
+    {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},  // * +
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08},  // , -
+    {0x00, 0x00, 0x60, 0x60, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},  // . /
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},  // 0 1
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33},  // 2 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39},  // 4 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07},  // 6 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E},  // 8 9
+    {0x00, 0x00, 0x14, 0x00, 0x00}, {0x00, 0x40, 0x34, 0x00, 0x00},  // : ;
+    {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14},  // < =
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06},  // > ?
+    {0x3E, 0x41, 0x5D, 0x59, 0x4E}, {0x7C, 0x12, 0x11, 0x12, 0x7C},  // @ A
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},  // B C
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41},  // D E
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x41, 0x51, 0x73},  // F G
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},  // H I
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41},  // J K
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x1C, 0x02, 0x7F},  // L M
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},  // N O
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E},  // P Q
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x26, 0x49, 0x49, 0x49, 0x32},  // R S
+    {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},  // T U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F},  // V W
+    {0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03},  // X Y
+    {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41},  // Z [
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F},  // \ ]
+    {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},  // ^ _
+    {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40},  // ` a
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28},  // b c
+    {0x38, 0x44, 0x44, 0x28, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18},  // d e
+    {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78},  // f g
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00},  // h i
+    {0x20, 0x40, 0x40, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00},  // j k
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78},  // l m
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},  // n o
+    {0xFC, 0x18, 0x24, 0x24, 0x18}, {0x18, 0x24, 0x24, 0x18, 0xFC},  // p q
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24},  // r s
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C},  // t u
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C},  // v w
+    {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C},  // x y
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},  // z {
+    {0x00, 0x00, 0x77, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00},  // | }
+    {0x02, 0x01, 0x02, 0x04, 0x02}                                    // ~
+};
+
+// The other glyphs the scale uses, by their index in the library's font.
+static const uint8_t gMediumShade[5] = {0xAA, 0x55, 0xAA, 0x55, 0xAA};   // 0xB1
+static const uint8_t gFullBlock[5]   = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF};   // 0xDB
+static const uint8_t gDegree[5]      = {0x00, 0x06, 0x09, 0x09, 0x06};   // 0xF8
+static const uint8_t gBlank[5]       = {0x00, 0x00, 0x00, 0x00, 0x00};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Glyph()
+//
+// Returns the 5 columns of a character in the library's font.  Characters the
+// scale doesn't use are blank.
+/////////////////////////////////////////////////////////////////////////////////
+static const uint8_t *Glyph(unsigned char c)
+{
+    if ((c >= 0x20) && (c <= 0x7E))
+    {
+        return gFont[c - 0x20];
+    }
+    switch (c)
+    {
+    case 0xB1: return gMediumShade;
+    case 0xDB: return gFullBlock;
+    case 0xF8: return gDegree;
+    default:   return gBlank;
+    }
+} // End Glyph().
+
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) :
+    WIDTH(w), HEIGHT(h), _width(w), _height(h), cursor_x(0), cursor_y(0),
+    textcolor(0xFFFF), textbgcolor(0xFFFF), textsize_x(1), textsize_y(1),
+    rotation(0), wrap(true), _cp437(false), gfxFont(NULL)
+{
+}
+
+
+void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+    drawPixel(x, y, color);
+}
+
+
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t color)
+{
+    fillRect(x, y, w, h, color);
+}
+
+
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    drawFastVLine(x, y, h, color);
+}
+
+
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    drawFastHLine(x, y, w, color);
+}
+
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                             uint16_t color)
+{
+    int16_t t;
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+    }
+    if (x0 > x1)
+    {
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+
+    int16_t dx    = x1 - x0;
+    int16_t dy    = abs(y1 - y0);
+    int16_t err   = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+        {
+            writePixel(y0, x0, color);
+        }
+        else
+        {
+            writePixel(x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0)
+        {
+            y0  += ystep;
+            err += dx;
+        }
+    }
+}
+
+
+void Adafruit_GFX::setRotation(uint8_t r)
+{
+    rotation = (r & 3);
+    if ((rotation & 1) == 0)
+    {
+        _width  = WIDTH;
+        _height = HEIGHT;
+    }
+    else
+    {
+        _width  = HEIGHT;
+        _height = WIDTH;
+    }
+}
+
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    startWrite();
+    writeLine(x, y, x, y + h - 1, color);
+    endWrite();
+}
+
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    startWrite();
+    writeLine(x, y, x + w - 1, y, color);
+    endWrite();
+}
+
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                            uint16_t color)
+{
+    startWrite();
+    for (int16_t i = x; i < x + w; i++)
+    {
+        writeFastVLine(i, y, h, color);
+    }
+    endWrite();
+}
+
+
+void Adafruit_GFX::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, _width, _height, color);
+}
+
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                            uint16_t color)
+{
+    if (x0 == x1)
+    {
+        drawFastVLine(x0, (y0 < y1) ? y0 : y1, abs(y1 - y0) + 1, color);
+    }
+    else if (y0 == y1)
+    {
+        drawFastHLine((x0 < x1) ? x0 : x1, y0, abs(x1 - x0) + 1, color);
+    }
+    else
+    {
+        startWrite();
+        writeLine(x0, y0, x1, y1, color);
+        endWrite();
+    }
+}
+
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                            uint16_t color)
+{
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    writeFastHLine(x, y + h - 1, w, color);
+    writeFastVLine(x, y, h, color);
+    writeFastVLine(x + w - 1, y, h, color);
+    endWrite();
+}
+
+
+void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
+                                    uint8_t cornername, uint16_t color)
+{
+    int16_t f     = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x     = 0;
+    int16_t y     = r;
+
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f     += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f     += ddF_x;
+        if (cornername & 0x4)
+        {
+            writePixel(x0 + x, y0 + y, color);
+            writePixel(x0 + y, y0 + x, color);
+        }
+        if (cornername & 0x2)
+        {
+            writePixel(x0 + x, y0 - y, color);
+            writePixel(x0 + y, y0 - x, color);
+        }
+        if (cornername & 0x8)
+        {
+            writePixel(x0 - y, y0 + x, color);
+            writePixel(x0 - x, y0 + y, color);
+        }
+        if (cornername & 0x1)
+        {
+            writePixel(x0 - y, y0 - x, color);
+            writePixel(x0 - x, y0 - y, color);
+        }
+    }
+}
+
+
+void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
+                                    uint8_t corners, int16_t delta,
+                                    uint16_t color)
+{
+    int16_t f     = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x     = 0;
+    int16_t y     = r;
+    int16_t px    = x;
+    int16_t py    = y;
+
+    delta++;    // Avoid some +1's in the loop.
+
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f     += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f     += ddF_x;
+
+        // These checks avoid double-drawing certain lines, important for the
+        // SSD1306 library which has an INVERT drawing mode.
+        if (x < (y + 1))
+        {
+            if (corners & 1)
+            {
+                writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+            }
+            if (corners & 2)
+            {
+                writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+            }
+        }
+        if (y != py)
+        {
+            if (corners & 1)
+            {
+                writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+            }
+            if (corners & 2)
+            {
+                writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+            }
+            py = y;
+        }
+        px = x;
+    }
+}
+
+
+void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 int16_t r, uint16_t color)
+{
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+    if (r > max_radius)
+    {
+        r = max_radius;
+    }
+    startWrite();
+    writeFastHLine(x + r, y, w - 2 * r, color);             // Top
+    writeFastHLine(x + r, y + h - 1, w - 2 * r, color);     // Bottom
+    writeFastVLine(x, y + r, h - 2 * r, color);             // Left
+    writeFastVLine(x + w - 1, y + r, h - 2 * r, color);     // Right
+    drawCircleHelper(x + r, y + r, r, 1, color);
+    drawCircleHelper(x + w - r - 1, y + r, r, 2, color);
+    drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
+    drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
+    endWrite();
+}
+
+
+void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 int16_t r, uint16_t color)
+{
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+    if (r > max_radius)
+    {
+        r = max_radius;
+    }
+    startWrite();
+    writeFillRect(x + r, y, w - 2 * r, h, color);
+    fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+    fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+    endWrite();
+}
+
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color)
+{
+    int16_t byteWidth = (w + 7) / 8;
+    uint8_t b = 0;
+
+    startWrite();
+    for (int16_t j = 0; j < h; j++, y++)
+    {
+        for (int16_t i = 0; i < w; i++)
+        {
+            if (i & 7)
+            {
+                b <<= 1;
+            }
+            else
+            {
+                b = bitmap[j * byteWidth + i / 8];
+            }
+            if (b & 0x80)
+            {
+                writePixel(x + i, y, color);
+            }
+        }
+    }
+    endWrite();
+}
+
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+    int16_t byteWidth = (w + 7) / 8;
+    uint8_t b = 0;
+
+    startWrite();
+    for (int16_t j = 0; j < h; j++, y++)
+    {
+        for (int16_t i = 0; i < w; i++)
+        {
+            if (i & 7)
+            {
+                b <<= 1;
+            }
+            else
+            {
+                b = bitmap[j * byteWidth + i / 8];
+            }
+            writePixel(x + i, y, (b & 0x80) ? color : bg);
+        }
+    }
+    endWrite();
+}
+
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t size)
+{
+    drawChar(x, y, c, color, bg, size, size);
+}
+
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t size_x,
+                            uint8_t size_y)
+{
+    if ((x >= _width) ||                // Clip right
+        (y >= _height) ||               // Clip bottom
+        ((x + 6 * size_x - 1) < 0) ||   // Clip left
+        ((y + 8 * size_y - 1) < 0))     // Clip top
+    {
+        return;
+    }
+
+    if (!_cp437 && (c >= 176))
+    {
+        c++;    // Handle 'classic' charset behavior
+    }
+
+    const uint8_t *pGlyph = Glyph(c);
+    startWrite();
+    for (int8_t i = 0; i < 5; i++)      // Char bitmap = 5 columns
+    {
+        uint8_t line = pGlyph[i];
+        for (int8_t j = 0; j < 8; j++, line >>= 1)
+        {
+            if (line & 1)
+            {
+                if ((size_x == 1) && (size_y == 1))
+                {
+                    writePixel(x + i, y + j, color);
+                }
+                else
+                {
+                    writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
+                                  color);
+                }
+            }
+            else if (bg != color)
+            {
+                if ((size_x == 1) && (size_y == 1))
+                {
+                    writePixel(x + i, y + j, bg);
+                }
+                else
+                {
+                    writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+                }
+            }
+        }
+    }
+    if (bg != color)    // If opaque, draw vertical line for last column
+    {
+        if ((size_x == 1) && (size_y == 1))
+        {
+            writeFastVLine(x + 5, y, 8, bg);
+        }
+        else
+        {
+            writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+        }
+    }
+    endWrite();
+}
+
+
+size_t Adafruit_GFX::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        cursor_x  = 0;
+        cursor_y += textsize_y * 8;
+    }
+    else if (c != '\r')
+    {
+        if (wrap && ((cursor_x + textsize_x * 6) > _width))
+        {
+            cursor_x  = 0;
+            cursor_y += textsize_y * 8;
+        }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
+                 textsize_y);
+        cursor_x += textsize_x * 6;
+    }
+    return 1;
+}
+
+
+void Adafruit_GFX::setTextSize(uint8_t sx, uint8_t sy)
+{
+    textsize_x = (sx > 0) ? sx : 1;
+    textsize_y = (sy > 0) ? sy : 1;
+}
+
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
+                              int16_t *minx, int16_t *miny, int16_t *maxx,
+                              int16_t *maxy)
+{
+    if (c == '\n')
+    {
+        *x  = 0;
+        *y += textsize_y * 8;
+    }
+    else if (c != '\r')
+    {
+        if (wrap && ((*x + textsize_x * 6) > _width))
+        {
+            *x  = 0;
+            *y += textsize_y * 8;
+        }
+        int x2 = *x + textsize_x * 6 - 1;
+        int y2 = *y + textsize_y * 8 - 1;
+        if (x2 > *maxx)
+        {
+            *maxx = x2;
+        }
+        if (y2 > *maxy)
+        {
+            *maxy = y2;
+        }
+        if (*x < *minx)
+        {
+            *minx = *x;
+        }
+        if (*y < *miny)
+        {
+            *miny = *y;
+        }
+        *x += textsize_x * 6;
+    }
+}
+
+
+void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
+                                 int16_t *x1, int16_t *y1, uint16_t *w,
+                                 uint16_t *h)
+{
+    uint8_t c;
+    int16_t minx = _width;
+    int16_t miny = _height;
+    int16_t maxx = -1;
+    int16_t maxy = -1;
+
+    *x1 = x;
+    *y1 = y;
+    *w  = *h = 0;
+    while ((c = *str++))
+    {
+        charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+    }
+    if (maxx >= minx)
+    {
+        *x1 = minx;
+        *w  = maxx - minx + 1;
+    }
+    if (maxy >= miny)
+    {
+        *y1 = miny;
+        *h  = maxy - miny + 1;
+    }
+}
@@ -0,0 +1,128 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Adafruit_GFX.h
+//
+// Host (Linux) stand-in for the Adafruit GFX library.  The drawing methods
+// the scale uses are done as the library does them (the same primitives are
+// called in the same order), so that a display drawn through this class sends
+// the panel the same pixels as on the device.  Only the built in (classic)
+// font is supported.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+#include "Arduino.h"    // For Print.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GFXfont
+//
+// Only named here.  setFont() isn't provided, so gfxFont is always NULL.
+/////////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    uint8_t  *bitmap;
+    void     *glyph;
+    uint16_t  first;
+    uint16_t  last;
+    uint8_t   yAdvance;
+} GFXfont;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Adafruit_GFX class
+/////////////////////////////////////////////////////////////////////////////////
+class Adafruit_GFX : public Print
+{
+public:
+    Adafruit_GFX(int16_t w, int16_t h);
+    virtual ~Adafruit_GFX() { }
+
+    // Drawn by the display driver.
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    // May be replaced by the display driver.
+    virtual void startWrite()  { }
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color);
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                           uint16_t color);
+    virtual void endWrite()    { }
+    virtual void setRotation(uint8_t r);
+    virtual void invertDisplay(bool i) { (void)i; }
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color);
+    virtual void fillScreen(uint16_t color);
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                          uint16_t color);
+    virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color);
+
+    // Shapes, bitmaps and text.
+    void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
+                          uint16_t color);
+    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                          int16_t delta, uint16_t color);
+    void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+                       int16_t radius, uint16_t color);
+    void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+                       int16_t radius, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                    int16_t h, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                    int16_t h, uint16_t color, uint16_t bg);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                  uint16_t bg, uint8_t size);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                  uint16_t bg, uint8_t size_x, uint8_t size_y);
+    void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1,
+                       int16_t *y1, uint16_t *w, uint16_t *h);
+    void setTextSize(uint8_t s)                { setTextSize(s, s); }
+    void setTextSize(uint8_t sx, uint8_t sy);
+    void setCursor(int16_t x, int16_t y)       { cursor_x = x; cursor_y = y; }
+    void setTextColor(uint16_t c)              { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextWrap(bool w)                   { wrap = w; }
+    void cp437(bool x = true)                  { _cp437 = x; }
+
+    using Print::write;
+    virtual size_t write(uint8_t c);
+
+    int16_t width() const       { return _width; }
+    int16_t height() const      { return _height; }
+    uint8_t getRotation() const { return rotation; }
+    int16_t getCursorX() const  { return cursor_x; }
+    int16_t getCursorY() const  { return cursor_y; }
+
+protected:
+    void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
+                    int16_t *miny, int16_t *maxx, int16_t *maxy);
+
+    int16_t  WIDTH;             // Display width as modified by rotation 0.
+    int16_t  HEIGHT;            // Display height as modified by rotation 0.
+    int16_t  _width;            // Display width as modified by rotation.
+    int16_t  _height;           // Display height as modified by rotation.
+    int16_t  cursor_x;          // x location to start print()ing text.
+    int16_t  cursor_y;          // y location to start print()ing text.
+    uint16_t textcolor;         // 16-bit background color for print().
+    uint16_t textbgcolor;       // 16-bit text color for print().
+    uint8_t  textsize_x;        // Desired magnification in X-axis of text.
+    uint8_t  textsize_y;        // Desired magnification in Y-axis of text.
+    uint8_t  rotation;          // Display rotation (0 thru 3).
+    bool     wrap;              // If set, 'wrap' text at right edge.
+    bool     _cp437;            // If set, use correct CP437 charset.
+    GFXfont *gfxFont;           // Pointer to special font.
+};
+
+
+
+#endif // HOST_ADAFRUIT_GFX_H
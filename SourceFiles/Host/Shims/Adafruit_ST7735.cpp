@@ -0,0 +1,283 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Adafruit_ST7735.cpp
+//
+// Host (Linux) implementation of the Adafruit ST7735 and SPITFT library
+// stand-ins, and of the panel they drive.  The drawing methods clip and set
+// address windows as the library does.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "Adafruit_ST7735.h"
+
+
+// The panel.  Plain data, so that it is ready for a display constructed
+// statically.
+static uint16_t        gPanel[ST7735_TFTWIDTH_128 * ST7735_TFTHEIGHT_160];
+static int16_t         gPanelWidth  = ST7735_TFTWIDTH_128;
+static int16_t         gPanelHeight = ST7735_TFTHEIGHT_160;
+static HostTft::Counts gCounts;
+
+// The address window, and the next pixel in it.
+static int32_t         gWindowX      = 0;
+static int32_t         gWindowY      = 0;
+static int32_t         gWindowWidth  = 0;
+static int32_t         gWindowHeight = 0;
+static int32_t         gWindowIndex  = 0;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// PutPixel()
+//
+// The panel's handling of a pixel written to RAM: it goes to the next place in
+// the address window, wrapping back to the start after the last.
+/////////////////////////////////////////////////////////////////////////////////
+static void PutPixel(uint16_t color)
+{
+    gCounts.m_Pixels++;
+    if ((gWindowWidth <= 0) || (gWindowHeight <= 0))
+    {
+        return;
+    }
+    if (gWindowIndex >= gWindowWidth * gWindowHeight)
+    {
+        gWindowIndex = 0;
+    }
+    int32_t x = gWindowX + gWindowIndex % gWindowWidth;
+    int32_t y = gWindowY + gWindowIndex / gWindowWidth;
+    gWindowIndex++;
+    if ((x < gPanelWidth) && (y < gPanelHeight))
+    {
+        gPanel[y * gPanelWidth + x] = color;
+    }
+} // End PutPixel().
+
+
+const HostTft::Counts &HostTft::GetCounts()  { return gCounts; }
+int16_t                HostTft::GetWidth()   { return gPanelWidth; }
+int16_t                HostTft::GetHeight()  { return gPanelHeight; }
+const uint16_t        *HostTft::GetPixels()  { return gPanel; }
+
+
+void HostTft::ResetCounts()
+{
+    gCounts.m_Pixels       = 0ULL;
+    gCounts.m_Windows      = 0ULL;
+    gCounts.m_Transactions = 0ULL;
+}
+
+
+uint64_t HostTft::GetBytes(const Counts &rCounts)
+{
+    return WINDOW_BYTES * rCounts.m_Windows + PIXEL_BYTES * rCounts.m_Pixels;
+}
+
+
+double HostTft::GetSpiUs(const Counts &rCounts, uint32_t spiHz)
+{
+    return 8.0e6 * static_cast<double>(GetBytes(rCounts)) / spiHz;
+}
+
+
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc,
+                                 int8_t rst) :
+    Adafruit_GFX(w, h)
+{
+    (void)cs;
+    (void)dc;
+    (void)rst;
+}
+
+
+void Adafruit_SPITFT::startWrite()
+{
+    gCounts.m_Transactions++;
+}
+
+
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height))
+    {
+        startWrite();
+        setAddrWindow(x, y, 1, 1);
+        PutPixel(color);
+        endWrite();
+    }
+}
+
+
+void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+    if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height))
+    {
+        setAddrWindow(x, y, 1, 1);
+        PutPixel(color);
+    }
+}
+
+
+void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                    uint16_t color)
+{
+    if (ClipRect(x, y, w, h))
+    {
+        writeFillRectPreclipped(x, y, w, h, color);
+    }
+}
+
+
+void Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color)
+{
+    writeFillRect(x, y, w, 1, color);
+}
+
+
+void Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                     uint16_t color)
+{
+    writeFillRect(x, y, 1, h, color);
+}
+
+
+void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color)
+{
+    if (ClipRect(x, y, w, h))
+    {
+        startWrite();
+        writeFillRectPreclipped(x, y, w, h, color);
+        endWrite();
+    }
+}
+
+
+void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                    uint16_t color)
+{
+    fillRect(x, y, w, 1, color);
+}
+
+
+void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                    uint16_t color)
+{
+    fillRect(x, y, 1, h, color);
+}
+
+
+void Adafruit_SPITFT::setAddrWindow(uint16_t x, uint16_t y, uint16_t w,
+                                    uint16_t h)
+{
+    gCounts.m_Windows++;
+    gWindowX      = x;
+    gWindowY      = y;
+    gWindowWidth  = w;
+    gWindowHeight = h;
+    gWindowIndex  = 0;
+}
+
+
+void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
+                                  bool bigEndian)
+{
+    (void)block;
+    (void)bigEndian;
+    while (len-- > 0U)
+    {
+        PutPixel(*colors++);
+    }
+}
+
+
+void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len)
+{
+    while (len-- > 0U)
+    {
+        PutPixel(color);
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ClipRect()
+//
+// Clips a rectangle, which may have a negative width or height, to the
+// display.  Returns 'false' if nothing is left.
+/////////////////////////////////////////////////////////////////////////////////
+bool Adafruit_SPITFT::ClipRect(int16_t &x, int16_t &y, int16_t &w,
+                               int16_t &h) const
+{
+    if ((w == 0) || (h == 0))
+    {
+        return false;
+    }
+    if (w < 0)
+    {
+        x += w + 1;
+        w  = -w;
+    }
+    if (h < 0)
+    {
+        y += h + 1;
+        h  = -h;
+    }
+    int16_t x2 = x + w - 1;
+    int16_t y2 = y + h - 1;
+    if ((x >= _width) || (y >= _height) || (x2 < 0) || (y2 < 0))
+    {
+        return false;
+    }
+    if (x < 0)
+    {
+        x = 0;
+        w = x2 + 1;
+    }
+    if (y < 0)
+    {
+        y = 0;
+        h = y2 + 1;
+    }
+    if (x2 >= _width)
+    {
+        w = _width - x;
+    }
+    if (y2 >= _height)
+    {
+        h = _height - y;
+    }
+    return true;
+}
+
+
+void Adafruit_SPITFT::writeFillRectPreclipped(int16_t x, int16_t y, int16_t w,
+                                              int16_t h, uint16_t color)
+{
+    setAddrWindow(x, y, w, h);
+    writeColor(color, static_cast<uint32_t>(w) * h);
+}
+
+
+Adafruit_ST7735::Adafruit_ST7735(int8_t cs, int8_t dc, int8_t rst) :
+    Adafruit_SPITFT(ST7735_TFTWIDTH_128, ST7735_TFTHEIGHT_160, cs, dc, rst)
+{
+}
+
+
+void Adafruit_ST7735::initR(uint8_t options)
+{
+    (void)options;
+    setRotation(0);
+}
+
+
+void Adafruit_ST7735::setRotation(uint8_t m)
+{
+    Adafruit_GFX::setRotation(m);
+    gPanelWidth  = _width;
+    gPanelHeight = _height;
+}
@@ -0,0 +1,134 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Adafruit_ST7735.h
+//
+// Host (Linux) stand-in for the Adafruit ST7735 and SPITFT libraries.  Rather
+// than driving a panel over SPI, it emulates one: the pixels sent to each
+// address window are stored in an in-memory copy of the panel, and the
+// traffic is counted.  HostTft gives simulations access to both, so that the
+// cost of drawing can be measured and the result looked at.
+//
+// The traffic is what the library would send for the same calls: each
+// address window is 11 bytes (the CASET, RASET and RAMWR commands and their
+// arguments) and each pixel 2 bytes.  Panel initialization isn't counted.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_ADAFRUIT_ST7735_H
+#define HOST_ADAFRUIT_ST7735_H
+
+#include "Adafruit_GFX.h"       // Like the real library.
+
+#define INITR_GREENTAB      0x00
+#define INITR_REDTAB        0x01
+#define INITR_BLACKTAB      0x02
+#define INITR_18GREENTAB    INITR_GREENTAB
+#define INITR_18REDTAB      INITR_REDTAB
+#define INITR_18BLACKTAB    INITR_BLACKTAB
+
+#define ST7735_TFTWIDTH_128  128
+#define ST7735_TFTHEIGHT_160 160
+
+#define ST77XX_BLACK    0x0000
+#define ST77XX_WHITE    0xFFFF
+#define ST77XX_RED      0xF800
+#define ST77XX_GREEN    0x07E0
+#define ST77XX_BLUE     0x001F
+#define ST77XX_CYAN     0x07FF
+#define ST77XX_MAGENTA  0xF81F
+#define ST77XX_YELLOW   0xFFE0
+#define ST77XX_ORANGE   0xFC00
+
+#define ST7735_BLACK    ST77XX_BLACK
+#define ST7735_WHITE    ST77XX_WHITE
+#define ST7735_RED      ST77XX_RED
+#define ST7735_GREEN    ST77XX_GREEN
+#define ST7735_BLUE     ST77XX_BLUE
+#define ST7735_CYAN     ST77XX_CYAN
+#define ST7735_MAGENTA  ST77XX_MAGENTA
+#define ST7735_YELLOW   ST77XX_YELLOW
+#define ST7735_ORANGE   ST77XX_ORANGE
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Simulation access to the emulated panel.
+/////////////////////////////////////////////////////////////////////////////////
+namespace HostTft
+{
+    /////////////////////////////////////////////////////////////////////////////
+    // Counts is the traffic sent to the panel.
+    /////////////////////////////////////////////////////////////////////////////
+    struct Counts
+    {
+        uint64_t m_Pixels;          // Pixels written.
+        uint64_t m_Windows;         // Address windows set.
+        uint64_t m_Transactions;    // SPI transactions (startWrite() calls).
+    };
+
+    static const uint32_t WINDOW_BYTES = 11U;
+    static const uint32_t PIXEL_BYTES  = 2U;
+
+    const Counts   &GetCounts();
+    void            ResetCounts();
+    uint64_t        GetBytes(const Counts &rCounts);
+    double          GetSpiUs(const Counts &rCounts, uint32_t spiHz);
+
+    // The panel's contents as it is drawn (i.e. rotated), by rows.
+    int16_t         GetWidth();
+    int16_t         GetHeight();
+    const uint16_t *GetPixels();
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Adafruit_SPITFT class
+/////////////////////////////////////////////////////////////////////////////////
+class Adafruit_SPITFT : public Adafruit_GFX
+{
+public:
+    Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst);
+    virtual ~Adafruit_SPITFT() { }
+
+    virtual void startWrite();
+    virtual void endWrite()     { }
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color);
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color);
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+
+    virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void writePixels(uint16_t *colors, uint32_t len, bool block = true,
+                     bool bigEndian = false);
+    void writeColor(uint16_t color, uint32_t len);
+
+protected:
+    bool ClipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
+    void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t color);
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Adafruit_ST7735 class
+/////////////////////////////////////////////////////////////////////////////////
+class Adafruit_ST7735 : public Adafruit_SPITFT
+{
+public:
+    Adafruit_ST7735(int8_t cs, int8_t dc, int8_t rst);
+    virtual ~Adafruit_ST7735() { }
+
+    void initR(uint8_t options = INITR_GREENTAB);
+    virtual void setRotation(uint8_t m);
+};
+
+
+
+#endif // HOST_ADAFRUIT_ST7735_H
@@ -0,0 +1,60 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Arduino.cpp
+//
+// Host (Linux) implementation of the Arduino core stand-ins.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "Arduino.h"
+#include <cstdarg>      // For va_list.
+
+
+HostSerial Serial;
+EspClass   ESP;
+
+// The virtual clock, in microseconds.
+static uint64_t gHostMicros = 0ULL;
+
+
+uint32_t millis()                   { return static_cast<uint32_t>(gHostMicros / 1000ULL); }
+uint32_t micros()                   { return static_cast<uint32_t>(gHostMicros); }
+void     delay(uint32_t ms)         { gHostMicros += 1000ULL * ms; }
+void     delayMicroseconds(uint32_t us) { gHostMicros += us; }
+
+
+void     HostSim::SetMicros(uint64_t us)     { gHostMicros = us; }
+void     HostSim::AdvanceMicros(uint64_t us) { gHostMicros += us; }
+void     HostSim::AdvanceMillis(uint32_t ms) { gHostMicros += 1000ULL * ms; }
+uint64_t HostSim::GetMicros()                { return gHostMicros; }
+
+
+size_t HostSerial::printf(const char *pFormat, ...)
+{
+    if (!m_Enabled)
+    {
+        return 0;
+    }
+    va_list args;
+    va_start(args, pFormat);
+    int n = vprintf(pFormat, args);
+    va_end(args);
+    return (n > 0) ? static_cast<size_t>(n) : 0;
+}
+
+
+size_t HostSerial::Out(const char *pFormat, ...)
+{
+    if (!m_Enabled)
+    {
+        return 0;
+    }
+    va_list args;
+    va_start(args, pFormat);
+    int n = vprintf(pFormat, args);
+    va_end(args);
+    return (n > 0) ? static_cast<size_t>(n) : 0;
+}
@@ -0,0 +1,207 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Arduino.h
+//
+// Host (Linux) stand-in for the parts of the Arduino core used by the scale's
+// core and display classes.  Time is simulated: millis() and micros() return a virtual
+// clock that only moves when delay() is called or when the simulation
+// advances it with HostSim::AdvanceMillis().  This lets traces be replayed
+// much faster than real time.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <cstdint>      // For uint32_t, ...
+#include <cstddef>      // For size_t.
+#include <cstring>      // For strlen(), ...
+#include <cstdio>       // For printf(), ...
+#include <cstdlib>      // For abs(), ...
+#include <cmath>        // For fabs(), isnan(), ...
+#include <climits>      // For INT_MAX, ...
+#include "HostCompat.h" // For strlcpy().
+
+using std::isnan;
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Timing.  All times are simulated.
+/////////////////////////////////////////////////////////////////////////////////
+uint32_t millis();
+uint32_t micros();
+void     delay(uint32_t ms);
+void     delayMicroseconds(uint32_t us);
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Interrupts.  There are none on the host.
+/////////////////////////////////////////////////////////////////////////////////
+inline void noInterrupts() { }
+inline void interrupts()   { }
+#define IRAM_ATTR
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Digital I/O and LEDC (PWM).  There are no pins on the host; these do nothing
+// and digitalRead() always reads HIGH (an idle pulled up input).
+/////////////////////////////////////////////////////////////////////////////////
+#define LOW             0x0
+#define HIGH            0x1
+#define INPUT           0x01
+#define OUTPUT          0x03
+#define INPUT_PULLUP    0x05
+
+// The Adafruit HUZZAH32 (Feather ESP32) analog pin names.
+static const uint8_t A0 = 26;
+static const uint8_t A1 = 25;
+static const uint8_t A2 = 34;
+static const uint8_t A3 = 39;
+static const uint8_t A4 = 36;
+static const uint8_t A5 = 4;
+
+inline void   pinMode(uint8_t pin, uint8_t mode)         { (void)pin; (void)mode; }
+inline void   digitalWrite(uint8_t pin, uint8_t val)     { (void)pin; (void)val; }
+inline int    digitalRead(uint8_t pin)                   { (void)pin; return HIGH; }
+inline double ledcSetup(uint8_t chan, double freq, uint8_t bits)
+                                                         { (void)chan; (void)bits; return freq; }
+inline void   ledcAttachPin(uint8_t pin, uint8_t chan)   { (void)pin; (void)chan; }
+inline void   ledcWrite(uint8_t chan, uint32_t duty)     { (void)chan; (void)duty; }
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Print and Stream classes
+//
+// Only what the display and menu input classes derive from.  A class derived
+// from Print need only provide write(uint8_t).
+/////////////////////////////////////////////////////////////////////////////////
+class Print
+{
+public:
+    virtual ~Print() { }
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *pBuf, size_t size)
+    {
+        size_t n = 0;
+        while (size-- > 0)
+        {
+            n += write(*pBuf++);
+        }
+        return n;
+    }
+    virtual void flush() { }
+
+    size_t write(const char *pStr)
+    {
+        return (pStr == NULL) ? 0 :
+               write(reinterpret_cast<const uint8_t *>(pStr), strlen(pStr));
+    }
+    size_t print(const char *pStr)   { return write(pStr); }
+    size_t print(char c)             { return write(static_cast<uint8_t>(c)); }
+    size_t println(const char *pStr) { size_t n = print(pStr); return n + println(); }
+    size_t println()                 { return write("\r\n"); }
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// IPAddress class
+/////////////////////////////////////////////////////////////////////////////////
+class IPAddress
+{
+public:
+    IPAddress() { memset(m_Bytes, 0, sizeof(m_Bytes)); }
+    IPAddress(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3)
+    {
+        m_Bytes[0] = b0;
+        m_Bytes[1] = b1;
+        m_Bytes[2] = b2;
+        m_Bytes[3] = b3;
+    }
+
+    uint8_t  operator[](int index) const { return m_Bytes[index]; }
+    uint8_t &operator[](int index)       { return m_Bytes[index]; }
+
+private:
+    uint8_t m_Bytes[4];
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// EspClass
+//
+// ESP.restart() ends a host program, since there's nothing to restart.
+/////////////////////////////////////////////////////////////////////////////////
+class EspClass
+{
+public:
+    void restart() { fprintf(stderr, "ESP.restart()\n"); exit(1); }
+};
+
+extern EspClass ESP;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HostSerial class
+//
+// Writes to stdout.  May be muted so that chatty code (e.g. ReadRawAverage())
+// doesn't swamp a simulation run.
+/////////////////////////////////////////////////////////////////////////////////
+class HostSerial
+{
+public:
+    HostSerial() : m_Enabled(true) { }
+
+    void begin(unsigned long baud)  { (void)baud; }
+    operator bool() const           { return true; }
+    void SetEnabled(bool enabled)   { m_Enabled = enabled; }
+
+    size_t print(const char *pStr)  { return Out("%s", pStr); }
+    size_t print(char c)            { return Out("%c", c); }
+    size_t print(int v)             { return Out("%d", v); }
+    size_t print(unsigned v)        { return Out("%u", v); }
+    size_t print(long v)            { return Out("%ld", v); }
+    size_t print(unsigned long v)   { return Out("%lu", v); }
+    size_t print(double v, int prec = 2) { return Out("%.*f", prec, v); }
+
+    template<class V>
+    size_t println(V v)             { size_t n = print(v); return n + println(); }
+    size_t println(double v, int prec = 2) { size_t n = print(v, prec); return n + println(); }
+    size_t println()                { return Out("\n"); }
+
+    size_t printf(const char *pFormat, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    size_t Out(const char *pFormat, ...) __attribute__((format(printf, 2, 3)));
+
+    bool m_Enabled;                 // Output is discarded when 'false'.
+};
+
+extern HostSerial Serial;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Simulation control.
+/////////////////////////////////////////////////////////////////////////////////
+namespace HostSim
+{
+    void     SetMicros(uint64_t us);        // Sets the virtual clock.
+    void     AdvanceMicros(uint64_t us);    // Moves the virtual clock forward.
+    void     AdvanceMillis(uint32_t ms);    // Moves the virtual clock forward.
+    uint64_t GetMicros();                   // Reads the full virtual clock.
+}
+
+
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,33 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Bounce2.h
+//
+// Host (Linux) stand-in for the Bounce2 debounce library.  The button is
+// never pressed.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_BOUNCE2_H
+#define HOST_BOUNCE2_H
+
+#include "Arduino.h"    // Like the real library.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Bounce class
+/////////////////////////////////////////////////////////////////////////////////
+class Bounce
+{
+public:
+    void     attach(int pin)               { (void)pin; }
+    void     interval(uint16_t intervalMs) { (void)intervalMs; }
+    bool     update()                      { return false; }
+    bool     rose()                        { return false; }
+    uint32_t previousDuration()            { return 0UL; }
+};
+
+
+
+#endif // HOST_BOUNCE2_H
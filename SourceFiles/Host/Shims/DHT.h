@@ -0,0 +1,44 @@
+/////////////////////////////////////////////////////////////////////////////////
+// DHT.h
+//
+// Host (Linux) stand-in for the Adafruit DHT sensor library.  There is no
+// sensor on the host, so readings fail (NAN), as they do on the device when
+// the sensor isn't connected.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_DHT_H
+#define HOST_DHT_H
+
+#include "Arduino.h"    // Like the real library.
+
+#define DHT11 11
+#define DHT12 12
+#define DHT21 21
+#define DHT22 22
+#define AM2301 21
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DHT class
+/////////////////////////////////////////////////////////////////////////////////
+class DHT
+{
+public:
+    DHT(uint8_t pin, uint8_t type, uint8_t count = 6)
+        { (void)pin; (void)type; (void)count; }
+
+    void  begin(uint8_t usec = 55) { (void)usec; }
+    float readTemperature(bool fahrenheit = false, bool force = false)
+        { (void)fahrenheit; (void)force; return NAN; }
+    float readHumidity(bool force = false) { (void)force; return NAN; }
+    float convertCtoF(float c)             { return c * 1.8F + 32.0F; }
+    float convertFtoC(float f)             { return (f - 32.0F) * 0.55555F; }
+};
+
+
+
+#endif // HOST_DHT_H
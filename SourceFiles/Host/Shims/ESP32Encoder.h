@@ -0,0 +1,49 @@
+/////////////////////////////////////////////////////////////////////////////////
+// ESP32Encoder.h
+//
+// Host (Linux) stand-in for the ESP32Encoder library.  The count only changes
+// when set.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_ESP32ENCODER_H
+#define HOST_ESP32ENCODER_H
+
+#include <cstdint>      // For int64_t, ...
+
+enum puType
+{
+    UP,
+    DOWN,
+    NONE
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ESP32Encoder class
+/////////////////////////////////////////////////////////////////////////////////
+class ESP32Encoder
+{
+public:
+    ESP32Encoder() : useInternalWeakPullResistors(DOWN), m_Count(0) { }
+
+    void    attachFullQuad(int aPin, int bPin) { (void)aPin; (void)bPin; }
+    void    setFilter(uint16_t value)          { (void)value; }
+    int64_t getCount()                         { return m_Count; }
+    int64_t clearCount()                       { m_Count = 0; return 0; }
+    int64_t setCount(int64_t value)            { m_Count = value; return value; }
+    int64_t pauseCount()                       { return 0; }
+    int64_t resumeCount()                      { return 0; }
+
+    puType  useInternalWeakPullResistors;
+
+private:
+    int64_t m_Count;
+};
+
+
+
+#endif // HOST_ESP32ENCODER_H
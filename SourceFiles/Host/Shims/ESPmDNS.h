@@ -0,0 +1,28 @@
+/////////////////////////////////////////////////////////////////////////////////
+// ESPmDNS.h
+//
+// Host (Linux) stand-in for the ESP32 mDNS library.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_ESPMDNS_H
+#define HOST_ESPMDNS_H
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MDNSResponder class
+/////////////////////////////////////////////////////////////////////////////////
+class MDNSResponder
+{
+public:
+    bool begin(const char *pHostName) { (void)pHostName; return true; }
+};
+
+extern MDNSResponder MDNS;
+
+
+
+#endif // HOST_ESPMDNS_H
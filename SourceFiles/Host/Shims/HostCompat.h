@@ -0,0 +1,35 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HostCompat.h
+//
+// Fills the small gaps between newlib (used on the ESP32) and the host C
+// library.  This is force-included into every host build source file since
+// some sketch headers use these functions with only <string.h> included.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_COMPAT_H
+#define HOST_COMPAT_H
+
+#include <string.h>     // For strlen(), ...
+
+// glibc only gained strlcpy() in 2.38.
+#if defined __GLIBC__ && ((__GLIBC__ < 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ < 38)))
+inline size_t strlcpy(char *pDst, const char *pSrc, size_t size)
+{
+    size_t len = strlen(pSrc);
+    if (size != 0)
+    {
+        size_t n = (len < size - 1) ? len : size - 1;
+        memcpy(pDst, pSrc, n);
+        pDst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+
+
+#endif // HOST_COMPAT_H
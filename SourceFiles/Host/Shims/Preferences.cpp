@@ -0,0 +1,171 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Preferences.cpp
+//
+// Host (Linux) implementation of the Preferences stand-in.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "Preferences.h"
+#include <map>          // For std::map.
+#include <vector>       // For std::vector.
+
+
+typedef std::map<std::string, std::vector<uint8_t> > NvsMap;
+
+// Function local statics so that global objects may use NVS while being
+// constructed.
+static NvsMap &Store()
+{
+    static NvsMap store;
+    return store;
+}
+
+static uint32_t gWriteCount   = 0UL;
+static uint32_t gBytesWritten = 0UL;
+static uint32_t gReadCount    = 0UL;
+static uint32_t gOpenCount    = 0UL;
+
+
+std::string Preferences::Key(const char *pKey) const
+{
+    return m_Namespace + '\0' + pKey;
+}
+
+
+bool Preferences::begin(const char *pName, bool readOnly)
+{
+    // NVS namespace names are limited to 15 characters.
+    if ((pName == NULL) || (*pName == '\0') || (strlen(pName) > 15U))
+    {
+        return false;
+    }
+    m_Namespace = pName;
+    m_ReadOnly  = readOnly;
+    m_Open      = true;
+    gOpenCount++;
+    return true;
+}
+
+
+void Preferences::end()
+{
+    m_Open = false;
+}
+
+
+bool Preferences::clear()
+{
+    if (!m_Open || m_ReadOnly)
+    {
+        return false;
+    }
+    std::string prefix = m_Namespace + '\0';
+    NvsMap &store = Store();
+    for (NvsMap::iterator it = store.begin(); it != store.end(); )
+    {
+        if (it->first.compare(0, prefix.size(), prefix) == 0)
+        {
+            it = store.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return true;
+}
+
+
+bool Preferences::remove(const char *pKey)
+{
+    return m_Open && !m_ReadOnly && (Store().erase(Key(pKey)) != 0U);
+}
+
+
+bool Preferences::isKey(const char *pKey)
+{
+    return m_Open && (Store().count(Key(pKey)) != 0U);
+}
+
+
+size_t Preferences::getBytesLength(const char *pKey)
+{
+    if (!m_Open)
+    {
+        return 0U;
+    }
+    NvsMap::const_iterator it = Store().find(Key(pKey));
+    return (it == Store().end()) ? 0U : it->second.size();
+}
+
+
+size_t Preferences::getBytes(const char *pKey, void *pBuf, size_t maxLen)
+{
+    if (!m_Open || (pBuf == NULL))
+    {
+        return 0U;
+    }
+    gReadCount++;
+    NvsMap::const_iterator it = Store().find(Key(pKey));
+
+    // Like the real library, fail if the caller's buffer is too small.
+    if ((it == Store().end()) || (it->second.size() > maxLen))
+    {
+        return 0U;
+    }
+    memcpy(pBuf, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+
+size_t Preferences::putBytes(const char *pKey, const void *pValue, size_t len)
+{
+    if (!m_Open || m_ReadOnly || (pValue == NULL) || (len == 0U))
+    {
+        return 0U;
+    }
+    const uint8_t *pBytes = static_cast<const uint8_t *>(pValue);
+    std::vector<uint8_t> value(pBytes, pBytes + len);
+    std::vector<uint8_t> &stored = Store()[Key(pKey)];
+    if (stored != value)
+    {
+        stored = value;
+        gWriteCount++;
+        gBytesWritten += len;
+    }
+    return len;
+}
+
+
+void HostNvs::Erase()
+{
+    Store().clear();
+}
+
+
+uint32_t HostNvs::GetWriteCount()
+{
+    return gWriteCount;
+}
+
+
+uint32_t HostNvs::GetBytesWritten()
+{
+    return gBytesWritten;
+}
+
+
+uint32_t HostNvs::GetReadCount()
+{
+    return gReadCount;
+}
+
+
+uint32_t HostNvs::GetOpenCount()
+{
+    return gOpenCount;
+}
@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Preferences.h
+//
+// Host (Linux) stand-in for the ESP32 Preferences (NVS) library.  Values are
+// kept in memory for the life of the process, so Save()/Restore() round trips
+// behave as on the device.  Only the methods used by the scale are provided.
+// HostNvs gives simulations access to the store (e.g. to count writes).
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"    // Like the real library.
+#include <string>       // For std::string.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Preferences class
+/////////////////////////////////////////////////////////////////////////////////
+class Preferences
+{
+public:
+    Preferences() : m_Open(false), m_ReadOnly(false) { }
+    ~Preferences() { end(); }
+
+    bool   begin(const char *pName, bool readOnly = false);
+    void   end();
+    bool   clear();
+    bool   remove(const char *pKey);
+    bool   isKey(const char *pKey);
+    size_t getBytesLength(const char *pKey);
+    size_t getBytes(const char *pKey, void *pBuf, size_t maxLen);
+    size_t putBytes(const char *pKey, const void *pValue, size_t len);
+
+private:
+    std::string Key(const char *pKey) const;
+
+    std::string m_Namespace;            // Namespace given to begin().
+    bool        m_Open;                 // True between begin() and end().
+    bool        m_ReadOnly;             // Opened read only.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Simulation access to the in-memory NVS store.
+/////////////////////////////////////////////////////////////////////////////////
+namespace HostNvs
+{
+    void     Erase();                   // Removes every key.
+    uint32_t GetWriteCount();           // Number of putBytes() that changed NVS.
+    uint32_t GetBytesWritten();         // Bytes written by those calls.
+    uint32_t GetReadCount();            // Number of getBytes() calls.
+    uint32_t GetOpenCount();            // Number of begin() calls.
+}
+
+
+
+#endif // HOST_PREFERENCES_H
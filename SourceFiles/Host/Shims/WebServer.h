@@ -0,0 +1,32 @@
+/////////////////////////////////////////////////////////////////////////////////
+// WebServer.h
+//
+// Host (Linux) stand-in for the ESP32 WebServer library.  It serves nothing.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include "WiFi.h"       // Like the real library.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WebServer class
+/////////////////////////////////////////////////////////////////////////////////
+class WebServer
+{
+public:
+    WebServer(int port = 80) { (void)port; }
+    virtual ~WebServer() { }
+
+    void begin()        { }
+    void handleClient() { }
+};
+
+
+
+#endif // HOST_WEBSERVER_H
@@ -0,0 +1,17 @@
+/////////////////////////////////////////////////////////////////////////////////
+// WiFi.cpp
+//
+// Host (Linux) WiFi and mDNS library stand-in objects.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "WiFi.h"
+#include "ESPmDNS.h"
+
+
+WiFiClass     WiFi;
+MDNSResponder MDNS;
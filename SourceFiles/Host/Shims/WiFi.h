@@ -0,0 +1,32 @@
+/////////////////////////////////////////////////////////////////////////////////
+// WiFi.h
+//
+// Host (Linux) stand-in for the ESP32 WiFi library.  The host is never
+// connected; the WiFiManager stand-in never connects it.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"    // For IPAddress.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WiFiClass class
+/////////////////////////////////////////////////////////////////////////////////
+class WiFiClass
+{
+public:
+    IPAddress localIP() const { return IPAddress(); }
+    int8_t    RSSI() const    { return 0; }
+};
+
+extern WiFiClass WiFi;
+
+
+
+#endif // HOST_WIFI_H
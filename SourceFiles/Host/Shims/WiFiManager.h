@@ -0,0 +1,35 @@
+/////////////////////////////////////////////////////////////////////////////////
+// WiFiManager.h
+//
+// Host (Linux) stand-in for the WiFiManager library.  It never connects, so
+// the scale runs as if no network had been set up.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_WIFIMANAGER_H
+#define HOST_WIFIMANAGER_H
+
+#include "WiFi.h"       // Like the real library.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WiFiManager class
+/////////////////////////////////////////////////////////////////////////////////
+class WiFiManager
+{
+public:
+    void setCaptivePortalEnable(bool enable)    { (void)enable; }
+    void setCleanConnect(bool clean)            { (void)clean; }
+    void setShowInfoErase(bool show)            { (void)show; }
+    void setConfigPortalBlocking(bool blocking) { (void)blocking; }
+    bool autoConnect(const char *pApName)       { (void)pApName; return false; }
+    bool process()                              { return false; }
+    void resetSettings()                        { }
+};
+
+
+
+#endif // HOST_WIFIMANAGER_H
@@ -0,0 +1,31 @@
+/////////////////////////////////////////////////////////////////////////////////
+// esp_partition.h
+//
+// Host (Linux) stand-in for the ESP-IDF partition types named by the sketch's
+// headers.  Journal flash is simulated by JournalRamStorage on the host.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_ESP_PARTITION_H
+#define HOST_ESP_PARTITION_H
+
+#include <cstddef>      // For size_t.
+#include <cstdint>      // For uint32_t, ...
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// esp_partition_t
+/////////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+    char     label[17];
+} esp_partition_t;
+
+
+
+#endif // HOST_ESP_PARTITION_H
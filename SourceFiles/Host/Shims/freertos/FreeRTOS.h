@@ -0,0 +1,42 @@
+/////////////////////////////////////////////////////////////////////////////////
+// FreeRTOS.h
+//
+// Host (Linux) stand-in for the FreeRTOS types and critical sections used in
+// the scale's headers.  There is no scheduler on the host; code that creates
+// tasks is only built for the ESP32 (see LoadCell.cpp), so LoadCell reads its
+// transport directly.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <cstdint>      // For uint32_t, ...
+
+typedef int          BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t     TickType_t;
+
+#define pdFALSE     0
+#define pdTRUE      1
+#define pdPASS      pdTRUE
+#define pdFAIL      pdFALSE
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+
+// Critical sections.  Only one task runs on the host, so they exclude nothing.
+typedef struct
+{
+    uint32_t owner;
+    uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0U, 0U}
+#define portENTER_CRITICAL(pMux)     ((void)(pMux))
+#define portEXIT_CRITICAL(pMux)      ((void)(pMux))
+
+
+
+#endif // HOST_FREERTOS_H
@@ -0,0 +1,21 @@
+/////////////////////////////////////////////////////////////////////////////////
+// semphr.h
+//
+// Host (Linux) stand-in for the FreeRTOS semaphore types.  As with tasks,
+// code that uses semaphores is only built for the ESP32.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef void *SemaphoreHandle_t;
+
+
+
+#endif // HOST_FREERTOS_SEMPHR_H
@@ -0,0 +1,20 @@
+/////////////////////////////////////////////////////////////////////////////////
+// task.h
+//
+// Host (Linux) stand-in for the FreeRTOS task types.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+
+
+#endif // HOST_FREERTOS_TASK_H
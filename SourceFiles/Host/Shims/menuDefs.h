@@ -0,0 +1,50 @@
+/////////////////////////////////////////////////////////////////////////////////
+// menuDefs.h
+//
+// Host (Linux) stand-in for the ArduinoMenu definitions named by the sketch's
+// headers.  The menus themselves aren't built on the host.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HOST_MENUDEFS_H
+#define HOST_MENUDEFS_H
+
+#include "Arduino.h"    // For Stream.
+
+namespace Menu
+{
+    enum navCmds
+    {
+        noCmd = 0, escCmd, enterCmd, upCmd, downCmd, leftCmd, rightCmd,
+        idxCmd, selCmd, scrlUpCmd, scrlDwnCmd
+    };
+
+    struct navCode
+    {
+        navCmds cmd;
+        char    ch;
+    };
+
+    typedef navCode navCodesDef[scrlDwnCmd + 1];
+
+    struct config
+    {
+        const navCodesDef &navCodes;
+    };
+
+    extern config *options;
+
+    class menuIn : public Stream
+    {
+    };
+}
+
+// The sketch names menu types without the namespace.
+using namespace Menu;
+
+
+
+#endif // HOST_MENUDEFS_H
@@ -0,0 +1,167 @@
+/////////////////////////////////////////////////////////////////////////////////
+// PngWriter.cpp
+//
+// PNG file writer for RGB565 images.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>               // For fopen(), ...
+#include <vector>               // For std::vector.
+#include "PngWriter.h"          // For our own declarations.
+
+
+// Largest deflate stored block.
+static const size_t MAX_STORED_BLOCK = 65535U;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Crc32()
+//
+// Returns the PNG (ISO 3309) CRC of a chunk's type and data.
+/////////////////////////////////////////////////////////////////////////////////
+static uint32_t Crc32(const uint8_t *pData, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (size_t i = 0U; i < size; i++)
+    {
+        crc ^= pData[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1U) ? 0xEDB88320UL : 0UL);
+        }
+    }
+    return crc ^ 0xFFFFFFFFUL;
+} // End Crc32().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Adler32()
+//
+// Returns the zlib checksum of the uncompressed data.
+/////////////////////////////////////////////////////////////////////////////////
+static uint32_t Adler32(const uint8_t *pData, size_t size)
+{
+    uint32_t a = 1UL;
+    uint32_t b = 0UL;
+    for (size_t i = 0U; i < size; i++)
+    {
+        a = (a + pData[i]) % 65521UL;
+        b = (b + a) % 65521UL;
+    }
+    return (b << 16) | a;
+} // End Adler32().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// PutBe32()
+//
+// Appends a big endian 32 bit value.
+/////////////////////////////////////////////////////////////////////////////////
+static void PutBe32(std::vector<uint8_t> &rOut, uint32_t value)
+{
+    rOut.push_back(static_cast<uint8_t>(value >> 24));
+    rOut.push_back(static_cast<uint8_t>(value >> 16));
+    rOut.push_back(static_cast<uint8_t>(value >> 8));
+    rOut.push_back(static_cast<uint8_t>(value));
+} // End PutBe32().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WriteChunk()
+//
+// Writes a chunk: its length, type, data and CRC.
+/////////////////////////////////////////////////////////////////////////////////
+static bool WriteChunk(FILE *pFile, const char *pType,
+                       const std::vector<uint8_t> &rData)
+{
+    std::vector<uint8_t> chunk;
+    PutBe32(chunk, static_cast<uint32_t>(rData.size()));
+    chunk.insert(chunk.end(), pType, pType + 4);
+    chunk.insert(chunk.end(), rData.begin(), rData.end());
+    PutBe32(chunk, Crc32(&chunk[4], chunk.size() - 4U));
+    return fwrite(&chunk[0], 1, chunk.size(), pFile) == chunk.size();
+} // End WriteChunk().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WritePng()
+//
+// Writes an RGB565 image to a PNG file as 8 bit RGB.
+//
+// Arguments:
+//    - pPath   - Path of the file to write.
+//    - width   - Image width in pixels.
+//    - height  - Image height in pixels.
+//    - pPixels - width * height RGB565 pixels, by rows.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the file couldn't be written.
+/////////////////////////////////////////////////////////////////////////////////
+bool WritePng(const char *pPath, int width, int height, const uint16_t *pPixels)
+{
+    static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    // The image data: each row is its filter type (none) and RGB pixels.  The
+    // 5 and 6 bit components are widened by repeating their high bits.
+    std::vector<uint8_t> raw;
+    raw.reserve(static_cast<size_t>(height) * (1U + 3U * width));
+    for (int y = 0; y < height; y++)
+    {
+        raw.push_back(0U);
+        for (int x = 0; x < width; x++)
+        {
+            uint16_t c = pPixels[y * width + x];
+            uint8_t  r = static_cast<uint8_t>((c >> 11) & 0x1FU);
+            uint8_t  g = static_cast<uint8_t>((c >> 5) & 0x3FU);
+            uint8_t  b = static_cast<uint8_t>(c & 0x1FU);
+            raw.push_back(static_cast<uint8_t>((r << 3) | (r >> 2)));
+            raw.push_back(static_cast<uint8_t>((g << 2) | (g >> 4)));
+            raw.push_back(static_cast<uint8_t>((b << 3) | (b >> 2)));
+        }
+    }
+
+    // A zlib stream of stored deflate blocks.
+    std::vector<uint8_t> idat;
+    idat.push_back(0x78U);
+    idat.push_back(0x01U);
+    size_t pos = 0U;
+    do
+    {
+        size_t   size = raw.size() - pos;
+        size     = (size > MAX_STORED_BLOCK) ? MAX_STORED_BLOCK : size;
+        uint16_t len  = static_cast<uint16_t>(size);
+        idat.push_back((pos + size == raw.size()) ? 1U : 0U);
+        idat.push_back(static_cast<uint8_t>(len));
+        idat.push_back(static_cast<uint8_t>(len >> 8));
+        idat.push_back(static_cast<uint8_t>(~len));
+        idat.push_back(static_cast<uint8_t>(~len >> 8));
+        idat.insert(idat.end(), raw.begin() + pos, raw.begin() + pos + size);
+        pos += size;
+    } while (pos < raw.size());
+    PutBe32(idat, Adler32(&raw[0], raw.size()));
+
+    // Header: size, 8 bits per component, RGB, no interlace.
+    std::vector<uint8_t> ihdr;
+    PutBe32(ihdr, static_cast<uint32_t>(width));
+    PutBe32(ihdr, static_cast<uint32_t>(height));
+    ihdr.push_back(8U);
+    ihdr.push_back(2U);
+    ihdr.push_back(0U);
+    ihdr.push_back(0U);
+    ihdr.push_back(0U);
+
+    FILE *pFile = fopen(pPath, "wb");
+    if (pFile == NULL)
+    {
+        return false;
+    }
+    bool ok = (fwrite(SIGNATURE, 1, sizeof(SIGNATURE), pFile) == sizeof(SIGNATURE)) &&
+              WriteChunk(pFile, "IHDR", ihdr) &&
+              WriteChunk(pFile, "IDAT", idat) &&
+              WriteChunk(pFile, "IEND", std::vector<uint8_t>());
+    return (fclose(pFile) == 0) && ok;
+} // End WritePng().
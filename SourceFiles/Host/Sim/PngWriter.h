@@ -0,0 +1,39 @@
+/////////////////////////////////////////////////////////////////////////////////
+// PngWriter.h
+//
+// Writes RGB565 images, such as the emulated TFT panel, to PNG files so that
+// host simulations can show what was drawn.  The image data isn't compressed
+// (deflate "stored" blocks), so no zlib is needed; a 160x128 frame is about
+// 60 KB.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined PNGWRITER_H
+#define PNGWRITER_H
+
+#include <cstdint>              // For uint16_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WritePng()
+//
+// Writes an RGB565 image to a PNG file as 8 bit RGB.
+//
+// Arguments:
+//    - pPath   - Path of the file to write.
+//    - width   - Image width in pixels.
+//    - height  - Image height in pixels.
+//    - pPixels - width * height RGB565 pixels, by rows.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the file couldn't be written.
+/////////////////////////////////////////////////////////////////////////////////
+bool WritePng(const char *pPath, int width, int height, const uint16_t *pPixels);
+
+
+
+#endif // PNGWRITER_H
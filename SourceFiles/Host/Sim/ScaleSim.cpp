@@ -0,0 +1,275 @@
+/////////////////////////////////////////////////////////////////////////////////
+// ScaleSim.cpp
+//
+// Host simulation of the scale's weighing and length pipeline.  A trace of raw
+// HX711 conversions is replayed through the same code the sketch runs:
+// LoadCell (tare, calibration, ReadWeight() and its filter pipeline), the
+// StabilityDetector, and the LengthManager length conversion for a spool.
+// The simulated clock advances with the trace, so a run takes only as long as
+// the host needs to do the arithmetic.
+//
+// The first samples of the trace must be taken with the scale empty; they are
+// used to tare.  The calibration is given as counts per gram since a recorded
+// trace doesn't include the calibration weight.  Without a trace file, a
+// synthetic one is generated: the scale sits empty, a spool is placed on it
+// (with some bounce), filament is consumed at a steady rate while printing,
+// and the spool is removed.
+//
+// Usage:  ScaleSim [options] [trace-file]
+//   -r sps       Sample rate for traces without times (default 10).
+//   -k counts    Counts per gram (default 420).
+//   -t samples   Number of samples used to tare (default 20).
+//   -s grams     Empty spool weight (default 250).
+//   -d mm        Filament diameter (default 1.75).
+//   -n g/cm3     Filament density (default 1.24).
+//   -o file      Write each reading (CSV) to the file.
+//   -v           Don't mute the LoadCell's serial output.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>                   // For timing.
+#include <cstdio>                   // For printf().
+#include <cstdlib>                  // For strtod().
+#include <unistd.h>                 // For getopt().
+#include <Arduino.h>                // For Serial, millis().
+#include "LoadCell.h"               // For LoadCell class.
+#include "StabilityDetector.h"      // For StabilityDetector class.
+#include "LengthManager.h"          // For LengthManager class.
+#include "Spool.h"                  // For Spool class.
+#include "TraceTransport.h"         // For TraceTransport class.
+#include "TraceScenarios.h"         // For TraceNoise().
+
+
+// Simulation settings.
+struct SimConfig
+{
+    double      m_Sps;              // Samples per second.
+    double      m_CountsPerGram;    // Calibration.
+    uint16_t    m_TareCount;        // Samples used to tare.
+    double      m_SpoolGrams;       // Empty spool weight.
+    double      m_DiameterMm;       // Filament diameter.
+    double      m_Density;          // Filament density.
+    const char *m_pOutPath;         // Per reading CSV, or NULL.
+    bool        m_Verbose;          // Show LoadCell serial output.
+};
+
+// Stability event counters.
+struct SimEvents
+{
+    uint32_t m_Stable;
+    uint32_t m_Settling;
+    uint32_t m_LoadChanged;
+};
+
+static const double  SYNTH_FILAMENT_G   = 1000.0;   // Filament on the spool.
+static const double  SYNTH_USE_G_PER_S  = 0.05;     // Consumption rate.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Synthesize()
+//
+// Fills the trace with a synthetic session.
+/////////////////////////////////////////////////////////////////////////////////
+static void Synthesize(TraceTransport &rTrace, const SimConfig &rCfg)
+{
+    const uint32_t sps = static_cast<uint32_t>(rCfg.m_Sps + 0.5);
+    double grams = 0.0;
+
+    // 10 s empty.
+    for (uint32_t i = 0; i < 10U * sps; i++)
+    {
+        rTrace.Append(TRACE_TARE_RAW + static_cast<int32_t>(TRACE_NOISE_COUNTS * TraceNoise()));
+    }
+
+    // Place the spool: a decaying bounce for about 1 s, then 30 s at rest,
+    // 5 minutes of printing, 30 s at rest, and removal.
+    const double full = rCfg.m_SpoolGrams + SYNTH_FILAMENT_G;
+    const uint32_t phases[] = {sps, 30U * sps, 300U * sps, 30U * sps, 10U * sps};
+    for (size_t phase = 0; phase < sizeof(phases) / sizeof(phases[0]); phase++)
+    {
+        for (uint32_t i = 0; i < phases[phase]; i++)
+        {
+            switch (phase)
+            {
+            case 0:
+                grams = full * (1.0 + 0.3 * ((i & 1U) ? -1.0 : 1.0) *
+                                (1.0 - static_cast<double>(i) / phases[phase]));
+                break;
+            case 1:
+            case 3:
+                break;
+            case 2:
+                grams -= SYNTH_USE_G_PER_S / rCfg.m_Sps;
+                break;
+            default:
+                grams = 0.0;
+                break;
+            }
+            rTrace.Append(TRACE_TARE_RAW +
+                          static_cast<int32_t>(grams * rCfg.m_CountsPerGram +
+                                               TRACE_NOISE_COUNTS * TraceNoise()));
+            if (phase == 0)
+            {
+                grams = full;
+            }
+        }
+    }
+} // End Synthesize().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleStabilityEvent()
+//
+// Counts stability events and logs stable weights.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleStabilityEvent(StabilityEvent event, double weightGrams, void *pArg)
+{
+    SimEvents *pEvents = static_cast<SimEvents *>(pArg);
+    switch (event)
+    {
+    case eSeStable:
+        pEvents->m_Stable++;
+        printf("%9.1f s  stable at %.2f g\n", millis() / 1000.0, weightGrams);
+        break;
+    case eSeSettling:
+        pEvents->m_Settling++;
+        break;
+    case eSeLoadChanged:
+        pEvents->m_LoadChanged++;
+        printf("%9.1f s  load changed to %.2f g\n", millis() / 1000.0, weightGrams);
+        break;
+    }
+} // End HandleStabilityEvent().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// main()
+/////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+    SimConfig cfg = {TraceTransport::DEFAULT_SPS, 420.0, 20U, 250.0, 1.75, 1.24, NULL, false};
+    int opt;
+    while ((opt = getopt(argc, argv, "r:k:t:s:d:n:o:v")) != -1)
+    {
+        switch (opt)
+        {
+        case 'r': cfg.m_Sps           = strtod(optarg, NULL); break;
+        case 'k': cfg.m_CountsPerGram = strtod(optarg, NULL); break;
+        case 't': cfg.m_TareCount     = static_cast<uint16_t>(strtoul(optarg, NULL, 0)); break;
+        case 's': cfg.m_SpoolGrams    = strtod(optarg, NULL); break;
+        case 'd': cfg.m_DiameterMm    = strtod(optarg, NULL); break;
+        case 'n': cfg.m_Density       = strtod(optarg, NULL); break;
+        case 'o': cfg.m_pOutPath      = optarg; break;
+        case 'v': cfg.m_Verbose       = true; break;
+        default:
+            fprintf(stderr, "Usage: %s [-r sps] [-k counts/g] [-t tare samples] "
+                            "[-s spool g] [-d mm] [-n g/cm3] [-o out.csv] [-v] [trace]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if ((cfg.m_Sps <= 0.0) || (cfg.m_CountsPerGram <= 0.0) || (cfg.m_TareCount == 0U))
+    {
+        fprintf(stderr, "Bad option value.\n");
+        return 2;
+    }
+
+    // Build the trace.
+    TraceTransport trace(cfg.m_Sps);
+    if (optind < argc)
+    {
+        if (!trace.Load(argv[optind]))
+        {
+            fprintf(stderr, "Unable to load trace '%s'.\n", argv[optind]);
+            return 1;
+        }
+    }
+    else
+    {
+        Synthesize(trace, cfg);
+    }
+    printf("Trace: %zu samples at %.1f SPS\n", trace.GetNumSamples(), cfg.m_Sps);
+
+    // Set up the load cell just as the sketch does, using the start of the
+    // trace to tare.
+    Serial.SetEnabled(cfg.m_Verbose);
+    LoadCell loadCell(&trace);
+    bool ok = loadCell.Init("Sim LoadCell") &&
+              loadCell.Tare(cfg.m_TareCount) &&
+              loadCell.Calibrate(static_cast<uint32_t>(loadCell.GetTareValue() +
+                                                       1000.0 * cfg.m_CountsPerGram + 0.5),
+                                 1000.0);
+    Serial.SetEnabled(true);
+    if (!ok)
+    {
+        fprintf(stderr, "Load cell init, tare or calibration failed.\n");
+        return 1;
+    }
+
+    // Spool and length conversion.
+    Spool spool;
+    LengthManager lengthMgr;
+    lengthMgr.Init("Length Mgr");
+    spool.SetSpoolWeight(static_cast<float>(cfg.m_SpoolGrams));
+    spool.SetDiameter(static_cast<float>(cfg.m_DiameterMm));
+    spool.SetDensity(static_cast<float>(cfg.m_Density));
+    float lengthFactor = lengthMgr.CalculateLengthFactor(
+        spool.GetDiameter(), LoadCell::GetBaseUnitsFactor(loadCell.GetUnits()),
+        spool.GetDensity());
+    loadCell.SetOffset(spool.GetSpoolWeight());
+
+    SimEvents events = {0UL, 0UL, 0UL};
+    StabilityDetector stability;
+    stability.SetCallback(HandleStabilityEvent, &events);
+
+    FILE *pOut = NULL;
+    if (cfg.m_pOutPath != NULL)
+    {
+        pOut = fopen(cfg.m_pOutPath, "w");
+        if (pOut == NULL)
+        {
+            fprintf(stderr, "Unable to create '%s'.\n", cfg.m_pOutPath);
+            return 1;
+        }
+        fprintf(pOut, "ms,net_g,stable,length_%s\n", lengthMgr.GetUnitsString());
+    }
+
+    // Replay the rest of the trace, one reading per conversion.
+    size_t   readings = 0;
+    double   weight   = 0.0;
+    double   length   = 0.0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (!trace.AtEnd())
+    {
+        weight = loadCell.ReadWeight();
+        stability.Update(weight * LoadCell::GetBaseUnitsFactor(loadCell.GetUnits()));
+        length = lengthFactor * weight;
+        readings++;
+        if (pOut != NULL)
+        {
+            fprintf(pOut, "%lu,%.2f,%d,%.1f\n", static_cast<unsigned long>(millis()),
+                    weight, stability.IsStable() ? 1 : 0, length);
+        }
+    }
+    double hostNs = std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - start).count();
+    if (pOut != NULL)
+    {
+        fclose(pOut);
+    }
+
+    printf("Readings:          %zu over %.1f s simulated\n", readings, millis() / 1000.0);
+    printf("Final net weight:  %.2f g (%.1f %s)\n", weight, length, lengthMgr.GetUnitsString());
+    printf("Stability events:  %lu stable, %lu settling, %lu load changed\n",
+           static_cast<unsigned long>(events.m_Stable),
+           static_cast<unsigned long>(events.m_Settling),
+           static_cast<unsigned long>(events.m_LoadChanged));
+    printf("Host time:         %.1f ns/reading\n", (readings != 0) ? hostNs / readings : 0.0);
+
+    return 0;
+} // End main().
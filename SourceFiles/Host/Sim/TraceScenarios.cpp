@@ -0,0 +1,183 @@
+/////////////////////////////////////////////////////////////////////////////////
+// TraceScenarios.cpp
+//
+// Synthetic HX711 trace generators.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "TraceScenarios.h"     // For scenario declarations.
+#include <cmath>                // For sin(), exp(), ...
+
+
+static const double PI = 3.14159265358979;
+
+// Platform bounce when a load changes: a damped oscillation.
+static const double BOUNCE_FRACTION = 0.3;  // First peak, fraction of the step.
+static const double BOUNCE_HZ       = 2.0;  // Oscillation frequency.
+static const double BOUNCE_TAU_S    = 0.4;  // Decay time constant.
+
+// Bench vibration and knocks.
+static const double VIBRATION_GRAMS = 3.0;  // Amplitude.
+static const double VIBRATION_HZ    = 1.3;  // Below Nyquist at 10 SPS.
+static const double KNOCK_GRAMS     = 60.0; // Single sample spike.
+static const double KNOCK_PERIOD_S  = 7.3;  // Time between knocks.
+
+// Temperature drift: a slow ramp of the zero.
+static const double DRIFT_GRAMS     = 4.0;  // Total drift.
+
+// Scenario names, indexed by TraceScenario.
+static const char *ScenarioNames[] =
+    {"place", "remove", "vibration", "drift", "static"};
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// TraceNoise()
+//
+// Returns a normally distributed value with zero mean and unit variance.  The
+// sum of 12 uniform values from a fixed seed LCG is close enough to normal for
+// this.
+/////////////////////////////////////////////////////////////////////////////////
+double TraceNoise()
+{
+    static uint32_t seed = 12345UL;
+    double sum = 0.0;
+    for (int i = 0; i < 12; i++)
+    {
+        seed = seed * 1664525UL + 1013904223UL;
+        sum += static_cast<double>(seed >> 8) / 16777216.0;
+    }
+    return sum - 6.0;
+} // End TraceNoise().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetScenarioName()
+/////////////////////////////////////////////////////////////////////////////////
+const char *GetScenarioName(TraceScenario scenario)
+{
+    return ((scenario >= 0) && (scenario < eTsNumScenarios)) ?
+           ScenarioNames[scenario] : "?";
+} // End GetScenarioName().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AppendGrams()
+//
+// Appends a noisy sample for the given load.
+/////////////////////////////////////////////////////////////////////////////////
+static void AppendGrams(TraceTransport &rTrace, double grams, double countsPerGram)
+{
+    rTrace.Append(TRACE_TARE_RAW +
+                  static_cast<int32_t>(lround(grams * countsPerGram +
+                                              TRACE_NOISE_COUNTS * TraceNoise())));
+} // End AppendGrams().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Bounce()
+//
+// Returns the load 't' seconds after a step from 'from' to 'to' grams.
+/////////////////////////////////////////////////////////////////////////////////
+static double Bounce(double from, double to, double t)
+{
+    if (t <= 0.0)
+    {
+        return from;
+    }
+    return to - (to - from) * BOUNCE_FRACTION * cos(2.0 * PI * BOUNCE_HZ * t) *
+                exp(-t / BOUNCE_TAU_S);
+} // End Bounce().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// BuildScenario()
+//
+// Appends a scenario's samples to a trace.
+//
+// Arguments:
+//    - scenario      - The scenario to build.
+//    - rTrace        - The trace to append to.
+//    - countsPerGram - Load cell sensitivity.
+//
+// Returns:
+//    Returns the time of the load change in seconds, or a negative value if
+//    there is none.
+/////////////////////////////////////////////////////////////////////////////////
+double BuildScenario(TraceScenario scenario, TraceTransport &rTrace,
+                     double countsPerGram)
+{
+    const double period = rTrace.GetPeriodUs() / 1.0e6;
+    const double spool  = TRACE_SPOOL_GRAMS;
+
+    // The empty scale for taring.
+    for (double dt = 0.0; dt < TRACE_TARE_SECONDS; dt += period)
+    {
+        AppendGrams(rTrace, 0.0, countsPerGram);
+    }
+
+    // Samples are appended one period apart, starting one period in.
+    double eventSeconds = (rTrace.GetNumSamples() + 1U) * period;
+    switch (scenario)
+    {
+    case eTsPlace:
+        // Spool placed, then left for 30 s.
+        for (double dt = 0.0; dt < 30.0; dt += period)
+        {
+            AppendGrams(rTrace, Bounce(0.0, spool, dt), countsPerGram);
+        }
+        break;
+
+    case eTsRemove:
+        // Spool placed for 20 s, removed, then 30 s empty.
+        for (double dt = 0.0; dt < 20.0; dt += period)
+        {
+            AppendGrams(rTrace, Bounce(0.0, spool, dt), countsPerGram);
+        }
+        eventSeconds = (rTrace.GetNumSamples() + 1U) * period;
+        for (double dt = 0.0; dt < 30.0; dt += period)
+        {
+            AppendGrams(rTrace, Bounce(spool, 0.0, dt), countsPerGram);
+        }
+        break;
+
+    case eTsVibration:
+        // Spool placed on a vibrating bench for 60 s, with periodic knocks.
+        for (double dt = 0.0; dt < 60.0; dt += period)
+        {
+            double grams = Bounce(0.0, spool, dt) +
+                           VIBRATION_GRAMS * sin(2.0 * PI * VIBRATION_HZ * dt);
+            if (fmod(dt + period / 2.0, KNOCK_PERIOD_S) < period)
+            {
+                grams += KNOCK_GRAMS;
+            }
+            AppendGrams(rTrace, grams, countsPerGram);
+        }
+        break;
+
+    case eTsDrift:
+        // Spool placed, then the zero drifts over 10 minutes.
+        for (double dt = 0.0; dt < 600.0; dt += period)
+        {
+            AppendGrams(rTrace, Bounce(0.0, spool, dt) + DRIFT_GRAMS * dt / 600.0,
+                        countsPerGram);
+        }
+        break;
+
+    case eTsStatic:
+    default:
+        // 60 s empty.
+        for (double dt = 0.0; dt < 60.0; dt += period)
+        {
+            AppendGrams(rTrace, 0.0, countsPerGram);
+        }
+        eventSeconds = -1.0;
+        break;
+    }
+
+    return eventSeconds;
+} // End BuildScenario().
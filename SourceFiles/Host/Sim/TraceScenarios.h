@@ -0,0 +1,85 @@
+/////////////////////////////////////////////////////////////////////////////////
+// TraceScenarios.h
+//
+// Synthetic HX711 traces for the host simulations and benchmarks.  Each
+// scenario models a situation seen on the real scale: a spool placed on it or
+// removed (with the platform bouncing), vibration and knocks from the printer,
+// slow temperature drift, and an empty scale at rest.  Noise is Gaussian with
+// a fixed seed, so every build produces the same traces.
+//
+// Every scenario starts with TRACE_TARE_SECONDS of empty scale so that it can
+// be tared, and is sampled at the trace's sample rate.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined TRACESCENARIOS_H
+#define TRACESCENARIOS_H
+
+#include "TraceTransport.h"     // For TraceTransport class.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Scenario selections.
+/////////////////////////////////////////////////////////////////////////////////
+enum TraceScenario
+{
+    eTsPlace        = 0,    // Full spool placed, with bounce.
+    eTsRemove       = 1,    // Full spool removed, with bounce.
+    eTsVibration    = 2,    // Spool on a vibrating bench, with knocks.
+    eTsDrift        = 3,    // Spool at rest while the temperature drifts.
+    eTsStatic       = 4,    // Empty scale at rest.
+    eTsNumScenarios = 5     // Number of scenarios.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetScenarioName()
+//
+// Returns a short name for the scenario, or "?" if it is not valid.
+/////////////////////////////////////////////////////////////////////////////////
+const char *GetScenarioName(TraceScenario scenario);
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// BuildScenario()
+//
+// Appends a scenario's samples to a trace.
+//
+// Arguments:
+//    - scenario      - The scenario to build.
+//    - rTrace        - The trace to append to.  Its sample rate is used.
+//    - countsPerGram - Load cell sensitivity.
+//
+// Returns:
+//    Returns the trace time in seconds of the first sample taken after the
+//    load changes (the spool touches or leaves the platform), or a negative
+//    value if the load doesn't change after the tare period.
+/////////////////////////////////////////////////////////////////////////////////
+double BuildScenario(TraceScenario scenario, TraceTransport &rTrace,
+                     double countsPerGram);
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// TraceNoise()
+//
+// Returns a normally distributed value with zero mean and unit variance from a
+// fixed seed generator.
+/////////////////////////////////////////////////////////////////////////////////
+double TraceNoise();
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Scenario constants.
+/////////////////////////////////////////////////////////////////////////////////
+const int32_t TRACE_TARE_RAW     = 100000L; // Empty scale reading.
+const double  TRACE_NOISE_COUNTS = 40.0;    // RMS noise, about 0.1 g at 420/g.
+const double  TRACE_TARE_SECONDS = 5.0;     // Empty scale at the start.
+const double  TRACE_SPOOL_GRAMS  = 1250.0;  // Full 1 kg spool.
+
+
+
+#endif // TRACESCENARIOS_H
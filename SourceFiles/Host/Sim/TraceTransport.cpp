@@ -0,0 +1,148 @@
+/////////////////////////////////////////////////////////////////////////////////
+// TraceTransport.cpp
+//
+// Contains methods defined by the TraceTransport class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "TraceTransport.h"     // For TraceTransport class.
+#include <Arduino.h>            // For HostSim clock control.
+
+
+const double TraceTransport::DEFAULT_SPS = 10.0;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Constructor.
+/////////////////////////////////////////////////////////////////////////////
+TraceTransport::TraceTransport(double samplesPerSecond) :
+    m_Samples(), m_Index(0), m_PeriodUs(100000UL), m_Gain(128U)
+{
+    if (samplesPerSecond > 0.0)
+    {
+        m_PeriodUs = static_cast<uint32_t>(1.0e6 / samplesPerSecond + 0.5);
+    }
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Load()
+//
+// Appends the samples in a trace file.
+//
+// Arguments:
+//    - pPath - Path of the trace file.
+//
+// Returns:
+//    Returns 'true' if the file was read, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool TraceTransport::Load(const char *pPath)
+{
+    FILE *pFile = fopen(pPath, "r");
+    if (pFile == NULL)
+    {
+        return false;
+    }
+
+    bool status = true;
+    char line[128];
+    unsigned lineNum = 0U;
+    while (status && (fgets(line, sizeof(line), pFile) != NULL))
+    {
+        lineNum++;
+
+        // Skip leading white space, blank lines and comments.
+        char *p = line;
+        while ((*p == ' ') || (*p == '\t'))
+        {
+            p++;
+        }
+        if ((*p == '#') || (*p == '\r') || (*p == '\n') || (*p == '\0'))
+        {
+            continue;
+        }
+
+        // Either "raw" or "milliseconds,raw".
+        double ms = 0.0;
+        long   raw = 0L;
+        if (sscanf(p, "%lf ,%ld", &ms, &raw) == 2)
+        {
+            Sample sample = {static_cast<uint64_t>(ms * 1000.0 + 0.5),
+                             static_cast<int32_t>(raw)};
+            m_Samples.push_back(sample);
+        }
+        else if (sscanf(p, "%ld", &raw) == 1)
+        {
+            Append(static_cast<int32_t>(raw));
+        }
+        else
+        {
+            fprintf(stderr, "%s:%u: bad trace line.\n", pPath, lineNum);
+            status = false;
+        }
+    }
+    fclose(pFile);
+    return status;
+} // End Load().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Append()
+//
+// Appends a sample one sample period after the previous one.
+//
+// Arguments:
+//    - raw - The conversion value.
+/////////////////////////////////////////////////////////////////////////////////
+void TraceTransport::Append(int32_t raw)
+{
+    uint64_t timeUs = m_Samples.empty() ? 0ULL : m_Samples.back().m_TimeUs;
+    Sample sample = {timeUs + m_PeriodUs, raw};
+    m_Samples.push_back(sample);
+} // End Append().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Read()
+//
+// Returns the next sample and moves the simulated clock to its time.  Like the
+// HX711, which only holds its latest conversion, samples that were overtaken
+// while the caller was busy (e.g. in delay()) are skipped.  A trace time that
+// is already in the past (e.g. the trace was rewound) does not move the clock
+// backwards.
+//
+// Returns:
+//    Returns the sample value.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t TraceTransport::Read()
+{
+    if (m_Samples.empty())
+    {
+        HostSim::AdvanceMicros(m_PeriodUs);
+        return 0L;
+    }
+
+    if (AtEnd())
+    {
+        HostSim::AdvanceMicros(m_PeriodUs);
+        return m_Samples.back().m_Raw;
+    }
+
+    uint64_t now = HostSim::GetMicros();
+    while ((m_Index + 1 < m_Samples.size()) &&
+           (m_Samples[m_Index + 1].m_TimeUs <= now))
+    {
+        m_Index++;
+    }
+
+    const Sample &sample = m_Samples[m_Index++];
+    if (sample.m_TimeUs > now)
+    {
+        HostSim::SetMicros(sample.m_TimeUs);
+    }
+    return sample.m_Raw;
+} // End Read().
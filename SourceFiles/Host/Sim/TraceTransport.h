@@ -0,0 +1,135 @@
+/////////////////////////////////////////////////////////////////////////////////
+// TraceTransport.h
+//
+// This class implements the TraceTransport class, a scripted HX711 sample
+// source for host simulations.  Conversions come from a recorded trace file
+// or from values appended by the caller, and each Read() advances the
+// simulated clock (see Shims/Arduino.h) to the time the conversion would have
+// been ready.  Code that uses millis() therefore sees the same timing as on
+// the device.
+//
+// Trace files are plain text with one conversion per line, either
+//     raw
+// or
+//     milliseconds,raw
+// Blank lines and lines starting with '#' are ignored.  Samples without a
+// time are spaced at the configured sample rate.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined TRACETRANSPORT_H
+#define TRACETRANSPORT_H
+
+#include <cstddef>              // For size_t.
+#include <vector>               // For std::vector.
+#include "HX711Transport.h"     // For HX711Transport interface.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// TraceTransport class
+/////////////////////////////////////////////////////////////////////////////////
+class TraceTransport : public HX711Transport
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - samplesPerSecond - Rate used to space samples that have no time.
+    //                         The HX711 runs at 10 or 80 SPS.
+    /////////////////////////////////////////////////////////////////////////////
+    TraceTransport(double samplesPerSecond = DEFAULT_SPS);
+
+
+    // Destructor.
+    virtual ~TraceTransport() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Load()
+    //
+    // Appends the samples in a trace file (see the format above).
+    //
+    // Arguments:
+    //    - pPath - Path of the trace file.
+    //
+    // Returns:
+    //    Returns 'true' if the file was read, or 'false' if it could not be
+    //    opened or contained a line that could not be parsed.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Load(const char *pPath);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Append()
+    //
+    // Appends a sample one sample period after the previous one.
+    //
+    // Arguments:
+    //    - raw - The conversion value.
+    /////////////////////////////////////////////////////////////////////////////
+    void Append(int32_t raw);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Rewind()
+    //
+    // Restarts the trace from its first sample.
+    /////////////////////////////////////////////////////////////////////////////
+    void Rewind() { m_Index = 0; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // HX711Transport methods.  See HX711Transport.h for descriptions.
+    //
+    // Read() returns the latest sample due and moves the simulated clock to its
+    // time; samples overtaken while the caller was busy are skipped.
+    // Once the trace is exhausted, the last sample is repeated at the sample
+    // rate so that code waiting on the HX711 never hangs.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Begin(uint8_t gain)        { SetGain(gain); return true; }
+    bool IsReady() const            { return true; }
+    void SetGain(uint8_t gain)      { m_Gain = gain; }
+    int  GetDataReadyPin() const    { return NO_PIN; }
+    int32_t Read();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    bool     AtEnd()         const { return m_Index >= m_Samples.size(); }
+    size_t   GetNumSamples() const { return m_Samples.size(); }
+    size_t   GetPosition()   const { return m_Index; }
+    uint8_t  GetGain()       const { return m_Gain; }
+    uint32_t GetPeriodUs()   const { return m_PeriodUs; }
+    int32_t  GetRaw(size_t index)    const { return m_Samples[index].m_Raw; }
+    uint64_t GetTimeUs(size_t index) const { return m_Samples[index].m_TimeUs; }
+
+    static const double DEFAULT_SPS;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    TraceTransport(TraceTransport &rT);
+    TraceTransport &operator=(TraceTransport &rT);
+
+    // A single conversion and the time it becomes ready.
+    struct Sample
+    {
+        uint64_t m_TimeUs;
+        int32_t  m_Raw;
+    };
+
+    std::vector<Sample> m_Samples;      // The trace.
+    size_t              m_Index;        // Index of the next sample to return.
+    uint32_t            m_PeriodUs;     // Sample period in microseconds.
+    uint8_t             m_Gain;         // Last gain set.
+
+}; // End class TraceTransport.
+
+
+
+#endif // TRACETRANSPORT_H
@@ -0,0 +1,376 @@
+/////////////////////////////////////////////////////////////////////////////////
+// CalibrationTable.cpp
+//
+// Contains methods defined by the CalibrationTable class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "CalibrationTable.h"   // For CalibrationTable class.
+#include <cmath>                // For fabs(), isfinite().
+#include <cstring>              // For memset().
+
+
+const double CalibrationTable::MERGE_FRACTION = 0.02d;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// The table starts out empty with a linear fit.
+/////////////////////////////////////////////////////////////////////////////////
+CalibrationTable::CalibrationTable() : m_Slope(0.0d), m_NumSegments(0U),
+    m_LastSegment(0U), m_Degree(0U), m_PolyScale(1.0d)
+{
+    memset(&m_Data, 0, sizeof(m_Data));
+    m_Data.m_Fit = eCfLinear;
+    Fit();
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Clear()
+//
+// Removes all of the points.  The fit is kept.
+/////////////////////////////////////////////////////////////////////////////////
+void CalibrationTable::Clear()
+{
+    uint8_t fit = m_Data.m_Fit;
+    memset(&m_Data, 0, sizeof(m_Data));
+    m_Data.m_Fit = fit;
+    Fit();
+} // End Clear().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddPoint()
+//
+// Adds a reference point and recalculates the fit.  A point whose reading is
+// within MERGE_FRACTION of an existing point's reading replaces it.
+//
+// Arguments:
+//    - netCounts - The raw reading less the tare reading.  Must not be 0.
+//    - grams     - The weight that the reading represents.  Must be positive.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the point is not valid or the
+//    table is full.  The table is unchanged on failure.
+/////////////////////////////////////////////////////////////////////////////////
+bool CalibrationTable::AddPoint(int32_t netCounts, double grams)
+{
+    if ((netCounts == 0L) || !(grams > 0.0d) || !std::isfinite(grams))
+    {
+        return false;
+    }
+
+    // Replace a point at (nearly) the same load.
+    uint8_t numPoints = m_Data.m_NumPoints;
+    for (uint8_t i = 0U; i < numPoints; i++)
+    {
+        double diff = static_cast<double>(m_Data.m_NetCounts[i]) - netCounts;
+        double limit = MERGE_FRACTION *
+                       fmax(fabs(static_cast<double>(m_Data.m_NetCounts[i])),
+                            fabs(static_cast<double>(netCounts)));
+        if (fabs(diff) <= limit)
+        {
+            // Remove it.  The new point is inserted below.
+            for (uint8_t j = i + 1U; j < numPoints; j++)
+            {
+                m_Data.m_NetCounts[j - 1U] = m_Data.m_NetCounts[j];
+                m_Data.m_Grams[j - 1U]     = m_Data.m_Grams[j];
+            }
+            numPoints--;
+            break;
+        }
+    }
+
+    if (numPoints >= MAX_POINTS)
+    {
+        return false;
+    }
+
+    // Insert the point, keeping the points sorted by reading.
+    uint8_t pos = numPoints;
+    while ((pos > 0U) && (m_Data.m_NetCounts[pos - 1U] > netCounts))
+    {
+        m_Data.m_NetCounts[pos] = m_Data.m_NetCounts[pos - 1U];
+        m_Data.m_Grams[pos]     = m_Data.m_Grams[pos - 1U];
+        pos--;
+    }
+    m_Data.m_NetCounts[pos] = netCounts;
+    m_Data.m_Grams[pos]     = static_cast<float>(grams);
+    m_Data.m_NumPoints      = numPoints + 1U;
+
+    Fit();
+    return true;
+} // End AddPoint().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetFit()
+//
+// Selects the fit and recalculates it.
+//
+// Arguments:
+//    - fit - The fit to use.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if 'fit' is not valid.
+/////////////////////////////////////////////////////////////////////////////////
+bool CalibrationTable::SetFit(CalibrationFit fit)
+{
+    if ((fit < eCfLinear) || (fit >= eCfNumFits))
+    {
+        return false;
+    }
+    m_Data.m_Fit = static_cast<uint8_t>(fit);
+    Fit();
+    return true;
+} // End SetFit().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetData()
+//
+// Replaces the points and fit (e.g. with data restored from NVS).
+//
+// Arguments:
+//    - rData - The new data.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the data is not valid, in which
+//    case the table is unchanged.
+/////////////////////////////////////////////////////////////////////////////////
+bool CalibrationTable::SetData(const CalibrationData &rData)
+{
+    if ((rData.m_Fit >= eCfNumFits) || (rData.m_NumPoints > MAX_POINTS))
+    {
+        return false;
+    }
+    for (uint8_t i = 0U; i < rData.m_NumPoints; i++)
+    {
+        if ((rData.m_NetCounts[i] == 0L) || !(rData.m_Grams[i] > 0.0f) ||
+            !std::isfinite(rData.m_Grams[i]) ||
+            ((i > 0U) && (rData.m_NetCounts[i] <= rData.m_NetCounts[i - 1U])))
+        {
+            return false;
+        }
+    }
+
+    m_Data = rData;
+    Fit();
+    return true;
+} // End SetData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ToGrams()
+//
+// Converts a net reading to grams using the selected fit.
+//
+// Arguments:
+//    - netCounts - The raw reading less the tare reading.
+//
+// Returns:
+//    Returns the weight in grams, or 0.0 if the table is empty.
+/////////////////////////////////////////////////////////////////////////////////
+double CalibrationTable::ToGrams(double netCounts)
+{
+    if (IsLinear())
+    {
+        return m_Slope * netCounts;
+    }
+
+    if (m_Data.m_Fit == eCfPiecewise)
+    {
+        // Start from the last segment used.  The first and last segments
+        // extend to cover readings beyond the end points.
+        uint8_t seg = m_LastSegment;
+        while ((seg > 0U) && (netCounts < m_SegStart[seg]))
+        {
+            seg--;
+        }
+        while ((seg + 1U < m_NumSegments) && (netCounts >= m_SegStart[seg + 1U]))
+        {
+            seg++;
+        }
+        m_LastSegment = seg;
+        return m_SegSlope[seg] * netCounts + m_SegIntercept[seg];
+    }
+
+    // Polynomial, by Horner's rule.
+    double x = netCounts / m_PolyScale;
+    double sum = 0.0d;
+    for (uint8_t k = m_Degree; k > 0U; k--)
+    {
+        sum = (sum + m_Coeffs[k - 1U]) * x;
+    }
+    return sum;
+} // End ToGrams().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Fit()
+//
+// Recalculates m_Slope and the coefficients of the selected fit from the
+// points.
+/////////////////////////////////////////////////////////////////////////////////
+void CalibrationTable::Fit()
+{
+    const uint8_t numPoints = m_Data.m_NumPoints;
+
+    // The linear fit is always needed, since it also gives the sensitivity
+    // used for thresholds.  Least squares through the origin.
+    double sumXy = 0.0d;
+    double sumXx = 0.0d;
+    for (uint8_t i = 0U; i < numPoints; i++)
+    {
+        double x = static_cast<double>(m_Data.m_NetCounts[i]);
+        sumXy += x * m_Data.m_Grams[i];
+        sumXx += x * x;
+    }
+    m_Slope = (sumXx > 0.0d) ? sumXy / sumXx : 0.0d;
+
+    m_NumSegments = 0U;
+    m_LastSegment = 0U;
+    m_Degree = 0U;
+    if (IsLinear())
+    {
+        return;
+    }
+
+    if (m_Data.m_Fit == eCfPiecewise)
+    {
+        // Build the nodes: the points with the origin inserted in order.
+        double  nodeX[MAX_POINTS + 1U];
+        double  nodeY[MAX_POINTS + 1U];
+        uint8_t numNodes = 0U;
+        bool    haveOrigin = false;
+        for (uint8_t i = 0U; i < numPoints; i++)
+        {
+            if (!haveOrigin && (m_Data.m_NetCounts[i] > 0L))
+            {
+                nodeX[numNodes] = 0.0d;
+                nodeY[numNodes++] = 0.0d;
+                haveOrigin = true;
+            }
+            nodeX[numNodes] = m_Data.m_NetCounts[i];
+            nodeY[numNodes++] = m_Data.m_Grams[i];
+        }
+        if (!haveOrigin)
+        {
+            nodeX[numNodes] = 0.0d;
+            nodeY[numNodes++] = 0.0d;
+        }
+
+        // One segment between each pair of nodes.
+        for (uint8_t i = 0U; i + 1U < numNodes; i++)
+        {
+            double slope = (nodeY[i + 1U] - nodeY[i]) / (nodeX[i + 1U] - nodeX[i]);
+            m_SegStart[i]     = static_cast<int32_t>(nodeX[i]);
+            m_SegSlope[i]     = slope;
+            m_SegIntercept[i] = nodeY[i] - slope * nodeX[i];
+        }
+        m_NumSegments = numNodes - 1U;
+    }
+    else
+    {
+        FitPolynomial();
+    }
+} // End Fit().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FitPolynomial()
+//
+// Calculates m_Coeffs by solving the least squares normal equations for a
+// polynomial with no constant term (the tare defines zero).  With as many
+// points as coefficients this is an exact fit.
+/////////////////////////////////////////////////////////////////////////////////
+void CalibrationTable::FitPolynomial()
+{
+    const uint8_t numPoints = m_Data.m_NumPoints;
+    const uint8_t degree = (numPoints < MAX_DEGREE) ? numPoints : MAX_DEGREE;
+
+    m_PolyScale = 1.0d;
+    for (uint8_t i = 0U; i < numPoints; i++)
+    {
+        m_PolyScale = fmax(m_PolyScale, fabs(static_cast<double>(m_Data.m_NetCounts[i])));
+    }
+
+    // Normal equations: a[j][k] = sum(x^(j+k+2)), b[j] = sum(y * x^(j+1)).
+    double a[MAX_DEGREE][MAX_DEGREE + 1U];
+    memset(a, 0, sizeof(a));
+    for (uint8_t i = 0U; i < numPoints; i++)
+    {
+        double x = m_Data.m_NetCounts[i] / m_PolyScale;
+        double y = m_Data.m_Grams[i];
+        double powers[2U * MAX_DEGREE + 1U];
+        powers[0] = 1.0d;
+        for (uint8_t p = 1U; p <= 2U * degree; p++)
+        {
+            powers[p] = powers[p - 1U] * x;
+        }
+        for (uint8_t j = 0U; j < degree; j++)
+        {
+            for (uint8_t k = 0U; k < degree; k++)
+            {
+                a[j][k] += powers[j + k + 2U];
+            }
+            a[j][degree] += y * powers[j + 1U];
+        }
+    }
+
+    // Gaussian elimination with partial pivoting.
+    for (uint8_t col = 0U; col < degree; col++)
+    {
+        uint8_t pivot = col;
+        for (uint8_t row = col + 1U; row < degree; row++)
+        {
+            if (fabs(a[row][col]) > fabs(a[pivot][col]))
+            {
+                pivot = row;
+            }
+        }
+        if (fabs(a[pivot][col]) < 1.0e-12d)
+        {
+            // Can't happen with distinct non-zero readings, but fall back
+            // to the linear fit rather than divide by zero.
+            m_Coeffs[0] = m_Slope * m_PolyScale;
+            m_Degree = 1U;
+            return;
+        }
+        if (pivot != col)
+        {
+            for (uint8_t k = col; k <= degree; k++)
+            {
+                double tmp = a[col][k];
+                a[col][k] = a[pivot][k];
+                a[pivot][k] = tmp;
+            }
+        }
+        for (uint8_t row = col + 1U; row < degree; row++)
+        {
+            double factor = a[row][col] / a[col][col];
+            for (uint8_t k = col; k <= degree; k++)
+            {
+                a[row][k] -= factor * a[col][k];
+            }
+        }
+    }
+
+    // Back substitution.
+    for (int j = degree - 1; j >= 0; j--)
+    {
+        double sum = a[j][degree];
+        for (uint8_t k = j + 1; k < degree; k++)
+        {
+            sum -= a[j][k] * m_Coeffs[k];
+        }
+        m_Coeffs[j] = sum / a[j][j];
+    }
+    m_Degree = degree;
+} // End FitPolynomial().
@@ -0,0 +1,221 @@
+/////////////////////////////////////////////////////////////////////////////////
+// CalibrationTable.h
+//
+// This class implements the CalibrationTable class.  It holds up to
+// MAX_POINTS reference loads, each a net (tared) raw reading and the weight
+// in grams that it represents, and converts net readings to grams using one
+// of the following fits:
+//    - eCfLinear     - A single scale factor.  The least squares line through
+//                      the origin and the points.
+//    - eCfPiecewise  - Straight segments joining the origin and the points.
+//                      Readings beyond the end points use the end segments.
+//    - eCfPolynomial - A least squares polynomial through the origin of degree
+//                      MAX_DEGREE (or the number of points, if fewer).
+//
+// The fit coefficients are calculated when the points or the fit change, so
+// that ToGrams() costs the same few multiplies for every reading.  The
+// piecewise fit remembers the segment used last; since the load rarely jumps
+// across several reference points between readings, the search almost always
+// ends there.
+//
+// The points and fit are kept in a CalibrationData structure that may be
+// saved to NVS as is.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined CALIBRATIONTABLE_H
+#define CALIBRATIONTABLE_H
+
+#include <cstddef>              // For size_t.
+#include <cstdint>              // For uint8_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Fit selections.
+/////////////////////////////////////////////////////////////////////////////////
+enum CalibrationFit
+{
+    eCfLinear     = 0,      // Single scale factor.
+    eCfPiecewise  = 1,      // Piecewise linear.
+    eCfPolynomial = 2,      // Least squares polynomial.
+    eCfNumFits    = 3       // Number of fits.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// CalibrationData structure
+//
+// The reference points, sorted by m_NetCounts, and the selected fit.
+/////////////////////////////////////////////////////////////////////////////////
+const uint8_t CAL_MAX_POINTS = 8U;
+
+struct CalibrationData
+{
+    uint8_t m_Fit;                          // A CalibrationFit value.
+    uint8_t m_NumPoints;                    // Valid entries below.
+    uint8_t m_Reserved[2];                  // Explicit padding, always 0.
+    int32_t m_NetCounts[CAL_MAX_POINTS];    // Reading less the tare reading.
+    float   m_Grams[CAL_MAX_POINTS];        // Weight at that reading.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// CalibrationTable class
+/////////////////////////////////////////////////////////////////////////////////
+class CalibrationTable
+{
+public:
+    // Constructor.  The table starts out empty with a linear fit.
+    CalibrationTable();
+
+
+    // Destructor.
+    virtual ~CalibrationTable() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Clear()
+    //
+    // Removes all of the points.  The fit is kept.
+    /////////////////////////////////////////////////////////////////////////////
+    void Clear();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // AddPoint()
+    //
+    // Adds a reference point and recalculates the fit.  A point whose reading
+    // is within MERGE_FRACTION of an existing point's reading replaces it, so
+    // calibrating again with the same weight doesn't use up the table.
+    //
+    // Arguments:
+    //    - netCounts - The raw reading less the tare reading.  Must not be 0.
+    //    - grams     - The weight that the reading represents.  Must be
+    //                  positive.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if the point is not valid or
+    //    the table is full.  The table is unchanged on failure.
+    /////////////////////////////////////////////////////////////////////////////
+    bool AddPoint(int32_t netCounts, double grams);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetFit()
+    //
+    // Selects the fit and recalculates it.
+    //
+    // Arguments:
+    //    - fit - The fit to use.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if 'fit' is not valid.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetFit(CalibrationFit fit);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetData()
+    //
+    // Replaces the points and fit (e.g. with data restored from NVS).
+    //
+    // Arguments:
+    //    - rData - The new data.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if the data is not valid, in
+    //    which case the table is unchanged.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetData(const CalibrationData &rData);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // ToGrams()
+    //
+    // Converts a net reading to grams using the selected fit.
+    //
+    // Arguments:
+    //    - netCounts - The raw reading less the tare reading.
+    //
+    // Returns:
+    //    Returns the weight in grams, or 0.0 if the table is empty.
+    /////////////////////////////////////////////////////////////////////////////
+    double ToGrams(double netCounts);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    //
+    // GetSlope() returns the linear fit's grams per count regardless of the
+    // selected fit.  IsLinear() is true if ToGrams() would simply multiply by
+    // GetSlope().
+    /////////////////////////////////////////////////////////////////////////////
+    const CalibrationData &GetData() const { return m_Data; }
+    CalibrationFit GetFit()          const { return static_cast<CalibrationFit>(m_Data.m_Fit); }
+    uint8_t  GetNumPoints()          const { return m_Data.m_NumPoints; }
+    double   GetSlope()              const { return m_Slope; }
+    bool     IsLinear()              const
+        { return (m_Data.m_Fit == eCfLinear) || (m_Data.m_NumPoints < 2U); }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint8_t MAX_POINTS = CAL_MAX_POINTS;
+    static const uint8_t MAX_DEGREE = 3U;
+    static const double  MERGE_FRACTION;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    CalibrationTable(CalibrationTable &rCt);
+    CalibrationTable &operator=(CalibrationTable &rCt);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Fit()
+    //
+    // Recalculates m_Slope and the coefficients of the selected fit from the
+    // points.
+    /////////////////////////////////////////////////////////////////////////////
+    void Fit();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // FitPolynomial()
+    //
+    // Calculates m_Coeffs by solving the least squares normal equations for a
+    // polynomial with no constant term.
+    /////////////////////////////////////////////////////////////////////////////
+    void FitPolynomial();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    CalibrationData m_Data;                 // Points and fit.
+    double  m_Slope;                        // Linear fit, grams per count.
+
+    // Piecewise fit.  Segment i runs from m_SegStart[i] counts and gives
+    // grams = m_SegSlope[i] * counts + m_SegIntercept[i].  The origin is an
+    // extra node, so there are up to MAX_POINTS segments.
+    int32_t m_SegStart[MAX_POINTS];         // First reading of each segment.
+    double  m_SegSlope[MAX_POINTS];         // Grams per count.
+    double  m_SegIntercept[MAX_POINTS];     // Grams at 0 counts.
+    uint8_t m_NumSegments;                  // Valid segments.
+    uint8_t m_LastSegment;                  // Segment used by the last ToGrams().
+
+    // Polynomial fit, grams = sum(m_Coeffs[k] * x^(k+1)) with x in units of
+    // m_PolyScale counts, which keeps the normal equations well conditioned.
+    double  m_Coeffs[MAX_DEGREE];           // Coefficients, lowest power first.
+    uint8_t m_Degree;                       // Valid coefficients.
+    double  m_PolyScale;                    // Largest |m_NetCounts|.
+
+}; // End class CalibrationTable.
+
+
+
+#endif // CALIBRATIONTABLE_H
@@ -0,0 +1,133 @@
+/////////////////////////////////////////////////////////////////////////////////
+// CicDecimator.cpp
+//
+// Contains methods defined by the CicDecimator class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "CicDecimator.h"       // For CicDecimator class.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - factor - The decimation factor, 1 (no decimation) to MAX_FACTOR.
+//               Invalid values are taken as 1.
+/////////////////////////////////////////////////////////////////////////////////
+CicDecimator::CicDecimator(uint8_t factor) : m_Factor(1U), m_Gain(1LL)
+{
+    if (!SetFactor(factor))
+    {
+        Reset();
+    }
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetFactor()
+//
+// Sets the decimation factor and discards the filter's history.
+//
+// Arguments:
+//    - factor - The decimation factor, 1 (no decimation) to MAX_FACTOR.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if 'factor' is out of range.
+/////////////////////////////////////////////////////////////////////////////////
+bool CicDecimator::SetFactor(uint8_t factor)
+{
+    if ((factor < 1U) || (factor > MAX_FACTOR))
+    {
+        return false;
+    }
+
+    m_Factor = factor;
+    m_Gain = 1LL;
+    for (uint8_t i = 0U; i < ORDER; i++)
+    {
+        m_Gain *= factor;
+    }
+    Reset();
+    return true;
+} // End SetFactor().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Discards the filter's history.
+/////////////////////////////////////////////////////////////////////////////////
+void CicDecimator::Reset()
+{
+    m_Phase = 0U;
+    m_Fill  = ORDER - 1U;
+    for (uint8_t i = 0U; i < ORDER; i++)
+    {
+        m_Integrators[i] = 0ULL;
+        m_Delays[i]      = 0ULL;
+    }
+} // End Reset().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Process()
+//
+// Runs one input through the integrators, and every m_Factor inputs, runs the
+// last integrator's sum through the combs to produce an output.  The output is
+// divided by the filter's DC gain (rounding to nearest) so that it is in the
+// same units as the input.
+//
+// Arguments:
+//    - value   - The input.
+//    - rOutput - Set to the output when one is produced.
+//
+// Returns:
+//    Returns 'true' if an output was produced, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool CicDecimator::Process(int32_t value, int32_t &rOutput)
+{
+    // Nothing to do without decimation.
+    if (m_Factor == 1U)
+    {
+        rOutput = value;
+        return true;
+    }
+
+    uint64_t sum = static_cast<uint64_t>(static_cast<int64_t>(value));
+    for (uint8_t i = 0U; i < ORDER; i++)
+    {
+        m_Integrators[i] += sum;
+        sum = m_Integrators[i];
+    }
+
+    if (++m_Phase < m_Factor)
+    {
+        return false;
+    }
+    m_Phase = 0U;
+
+    for (uint8_t i = 0U; i < ORDER; i++)
+    {
+        uint64_t input = sum;
+        sum -= m_Delays[i];
+        m_Delays[i] = input;
+    }
+
+    // The first outputs depend on the zeroed history.
+    if (m_Fill > 0U)
+    {
+        m_Fill--;
+        return false;
+    }
+
+    const int64_t total = static_cast<int64_t>(sum);
+    const int64_t half  = m_Gain / 2;
+    rOutput = static_cast<int32_t>((total >= 0) ? (total + half) / m_Gain :
+                                                  (total - half) / m_Gain);
+    return true;
+} // End Process().
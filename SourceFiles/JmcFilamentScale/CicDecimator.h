@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////
+// CicDecimator.h
+//
+// This class implements the CicDecimator class.  It is a cascaded integrator
+// comb (CIC) decimation filter of order ORDER: the average of the last m_Factor
+// inputs, taken ORDER times over, output once every m_Factor inputs.  Used with
+// the HX711 at 80 SPS, every conversion is used and the output stream has the
+// same rate as at 10 SPS but less noise.
+//
+// A CIC filter needs no multiplies and no history beyond its 2 * ORDER state
+// variables.  Its pass band droops, but the weight is a near DC signal, so no
+// compensation FIR is needed.
+//
+// The integrators are allowed to wrap around.  This is harmless since the
+// combs take differences, and the output is always small enough to represent.
+// Unsigned arithmetic is used so that the wrap is well defined.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined CICDECIMATOR_H
+#define CICDECIMATOR_H
+
+#include <cstdint>              // For uint8_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// CicDecimator class
+/////////////////////////////////////////////////////////////////////////////////
+class CicDecimator
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - factor - The decimation factor, 1 (no decimation) to MAX_FACTOR.
+    //               Invalid values are taken as 1.
+    /////////////////////////////////////////////////////////////////////////////
+    CicDecimator(uint8_t factor = 1U);
+
+
+    // Destructor.
+    virtual ~CicDecimator() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetFactor()
+    //
+    // Sets the decimation factor and discards the filter's history.
+    //
+    // Arguments:
+    //    - factor - The decimation factor, 1 (no decimation) to MAX_FACTOR.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if 'factor' is out of range.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetFactor(uint8_t factor);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // Discards the filter's history.  The next ORDER - 1 outputs are suppressed
+    // while it fills again.
+    /////////////////////////////////////////////////////////////////////////////
+    void Reset();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Process()
+    //
+    // Runs one input through the filter.
+    //
+    // Arguments:
+    //    - value   - The input.
+    //    - rOutput - Set to the output when one is produced.
+    //
+    // Returns:
+    //    Returns 'true' if an output was produced (every m_Factor inputs once
+    //    the filter has filled), or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Process(int32_t value, int32_t &rOutput);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t GetFactor() const { return m_Factor; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint8_t ORDER      = 3U;
+    static const uint8_t MAX_FACTOR = 16U;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    CicDecimator(CicDecimator &rCd);
+    CicDecimator &operator=(CicDecimator &rCd);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t  m_Factor;                  // Decimation factor.
+    uint8_t  m_Phase;                   // Inputs since the last output.
+    uint8_t  m_Fill;                    // Outputs still to suppress.
+    int64_t  m_Gain;                    // m_Factor ^ ORDER.
+    uint64_t m_Integrators[ORDER];      // Integrator sums (wrap around).
+    uint64_t m_Delays[ORDER];           // Previous comb inputs.
+
+}; // End class CicDecimator.
+
+
+
+#endif // CICDECIMATOR_H
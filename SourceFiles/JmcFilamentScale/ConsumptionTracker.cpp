@@ -0,0 +1,190 @@
+/////////////////////////////////////////////////////////////////////////////////
+// ConsumptionTracker.cpp
+//
+// Contains methods defined by the ConsumptionTracker class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "ConsumptionTracker.h" // For ConsumptionTracker class.
+#include <cmath>                // For fabs().
+
+
+// A step between samples larger than this is not filament being used.  Even a
+// fast printer uses well under a gram in SAMPLE_PERIOD_MS.
+const double ConsumptionTracker::JUMP_GRAMS        = 20.0d;
+
+// Slower than this counts as not being used (noise and drift).
+const double ConsumptionTracker::MIN_GRAMS_PER_MIN = 0.05d;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+/////////////////////////////////////////////////////////////////////////////////
+ConsumptionTracker::ConsumptionTracker() :
+    m_Spool(0UL), m_HaveSpool(false), m_LengthPerGram(0.0d)
+{
+    Reset();
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Update()
+//
+// Adds the reading to the current average, and once SAMPLE_PERIOD_MS has
+// passed, adds the average to the series and fits it again.
+//
+// Arguments:
+//    - spool    - Identifies the selected spool.
+//    - netGrams - The net filament weight in grams.
+//    - nowMs    - The current time (millis()).
+/////////////////////////////////////////////////////////////////////////////////
+void ConsumptionTracker::Update(uint32_t spool, double netGrams, uint32_t nowMs)
+{
+    if (!m_HaveSpool || (spool != m_Spool))
+    {
+        Reset();
+        m_Spool = spool;
+        m_HaveSpool = true;
+    }
+
+    if (m_BucketCount == 0UL)
+    {
+        m_BucketStartMs = nowMs;
+    }
+    m_BucketSum += netGrams;
+    m_BucketCount++;
+
+    uint32_t elapsedMs = nowMs - m_BucketStartMs;
+    if (elapsedMs >= SAMPLE_PERIOD_MS)
+    {
+        // Time the average at the middle of its period.
+        AddSample(static_cast<float>(m_BucketSum / m_BucketCount),
+                  m_BucketStartMs + elapsedMs / 2UL);
+        m_BucketSum   = 0.0d;
+        m_BucketCount = 0UL;
+    }
+} // End Update().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Discards the series.
+/////////////////////////////////////////////////////////////////////////////////
+void ConsumptionTracker::Reset()
+{
+    m_HaveSpool     = false;
+    m_BucketSum     = 0.0d;
+    m_BucketCount   = 0UL;
+    m_BucketStartMs = 0UL;
+    m_NumSamples    = 0U;
+    m_Next          = 0U;
+    m_HaveRate      = false;
+    m_GramsPerMin   = 0.0d;
+} // End Reset().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetSecondsToEmpty()
+//
+// Divides the latest average weight by the usage rate.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t ConsumptionTracker::GetSecondsToEmpty() const
+{
+    if (!IsConsuming())
+    {
+        return NO_ESTIMATE;
+    }
+
+    size_t latest = (m_Next + WINDOW_SIZE - 1U) % WINDOW_SIZE;
+    double grams = m_Grams[latest];
+    if (grams <= 0.0d)
+    {
+        return 0L;
+    }
+
+    // Anything past a year is as good as never.
+    double seconds = grams / m_GramsPerMin * 60.0d;
+    return (seconds < 365.0d * 24.0d * 3600.0d) ? static_cast<int32_t>(seconds) :
+                                                   NO_ESTIMATE;
+} // End GetSecondsToEmpty().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddSample()
+//
+// Adds an average to the series, first discarding the series if the weight
+// has jumped.
+//
+// Arguments:
+//    - grams  - The average net weight.
+//    - timeMs - Its time.
+/////////////////////////////////////////////////////////////////////////////////
+void ConsumptionTracker::AddSample(float grams, uint32_t timeMs)
+{
+    if (m_NumSamples > 0U)
+    {
+        size_t latest = (m_Next + WINDOW_SIZE - 1U) % WINDOW_SIZE;
+        if (fabs(grams - m_Grams[latest]) > JUMP_GRAMS)
+        {
+            m_NumSamples = 0U;
+            m_Next       = 0U;
+            m_HaveRate   = false;
+        }
+    }
+
+    m_Grams[m_Next]   = grams;
+    m_TimesMs[m_Next] = timeMs;
+    m_Next = (m_Next + 1U) % WINDOW_SIZE;
+    if (m_NumSamples < WINDOW_SIZE)
+    {
+        m_NumSamples++;
+    }
+    Fit();
+} // End AddSample().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Fit()
+//
+// Works out the usage rate as the median of the slopes between each sample in
+// the older half of the series and its partner half a series later.  There
+// are at most WINDOW_SIZE / 2 slopes, so an insertion sort will do.
+/////////////////////////////////////////////////////////////////////////////////
+void ConsumptionTracker::Fit()
+{
+    m_HaveRate = false;
+    if (m_NumSamples < MIN_SAMPLES)
+    {
+        return;
+    }
+
+    const size_t span   = m_NumSamples / 2U;
+    const size_t oldest = (m_Next + WINDOW_SIZE - m_NumSamples) % WINDOW_SIZE;
+    float slopes[WINDOW_SIZE / 2U];
+    for (size_t i = 0U; i < span; i++)
+    {
+        size_t first = (oldest + i) % WINDOW_SIZE;
+        size_t last  = (first + span) % WINDOW_SIZE;
+        uint32_t dtMs = m_TimesMs[last] - m_TimesMs[first];
+        float slope = (dtMs > 0UL) ? (m_Grams[first] - m_Grams[last]) / dtMs : 0.0f;
+
+        // Insert it in order.
+        size_t j = i;
+        while ((j > 0U) && (slopes[j - 1U] > slope))
+        {
+            slopes[j] = slopes[j - 1U];
+            j--;
+        }
+        slopes[j] = slope;
+    }
+
+    double median = (span & 1U) ? slopes[span / 2U] :
+                    (slopes[span / 2U - 1U] + slopes[span / 2U]) / 2.0d;
+    m_GramsPerMin = median * 60000.0d;
+    m_HaveRate    = true;
+} // End Fit().
@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////////////////////
+// ConsumptionTracker.h
+//
+// This class implements the ConsumptionTracker class.  It keeps a short time
+// series of the selected spool's net filament weight, fits the rate at which
+// it is being used, and predicts when the spool will run out.
+//
+// The weight readings are averaged over SAMPLE_PERIOD_MS, and the last
+// WINDOW_SIZE averages are kept.  The slope is a Theil-Sen style estimate: the
+// median of the slopes between each sample and the one half a window later.
+// The median ignores the odd disturbed sample (e.g. the spool being touched)
+// where a least squares fit would not.  A step larger than JUMP_GRAMS (a tare,
+// or a spool being lifted off or put back) starts a new series, as does
+// selecting another spool.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined CONSUMPTIONTRACKER_H
+#define CONSUMPTIONTRACKER_H
+
+#include <cstddef>              // For size_t.
+#include <cstdint>              // For uint32_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ConsumptionTracker class
+/////////////////////////////////////////////////////////////////////////////////
+class ConsumptionTracker
+{
+public:
+    // Constructor.
+    ConsumptionTracker();
+
+
+    // Destructor.
+    virtual ~ConsumptionTracker() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Update()
+    //
+    // Processes the latest weight reading.
+    //
+    // Arguments:
+    //    - spool    - Identifies the selected spool (e.g. its slot).  A change
+    //                 starts a new series.
+    //    - netGrams - The net filament weight in grams.
+    //    - nowMs    - The current time (millis()).
+    /////////////////////////////////////////////////////////////////////////////
+    void Update(uint32_t spool, double netGrams, uint32_t nowMs);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // Discards the series, e.g. when no spool is selected.
+    /////////////////////////////////////////////////////////////////////////////
+    void Reset();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetSecondsToEmpty()
+    //
+    // Returns the predicted time until the spool is empty, in seconds, or
+    // NO_ESTIMATE if filament isn't being used (or there isn't enough history
+    // to tell).
+    /////////////////////////////////////////////////////////////////////////////
+    int32_t GetSecondsToEmpty() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters and setters.
+    //
+    // The rates are positive while filament is being used.  The length rate is
+    // in whatever units SetLengthPerGram() was given.
+    /////////////////////////////////////////////////////////////////////////////
+    bool   IsConsuming()           const { return m_HaveRate && (m_GramsPerMin >= MIN_GRAMS_PER_MIN); }
+    bool   HasRate()               const { return m_HaveRate; }
+    double GetGramsPerMin()        const { return m_HaveRate ? m_GramsPerMin : 0.0d; }
+    double GetLengthPerMin()       const { return GetGramsPerMin() * m_LengthPerGram; }
+    double GetLengthPerGram()      const { return m_LengthPerGram; }
+    size_t GetNumSamples()         const { return m_NumSamples; }
+    void   SetLengthPerGram(double lengthPerGram) { m_LengthPerGram = lengthPerGram; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const size_t   WINDOW_SIZE      = 60U;       // Samples (10 minutes).
+    static const size_t   MIN_SAMPLES      = 6U;        // Before fitting.
+    static const uint32_t SAMPLE_PERIOD_MS = 10000UL;
+    static const int32_t  NO_ESTIMATE      = -1L;
+    static const double   JUMP_GRAMS;
+    static const double   MIN_GRAMS_PER_MIN;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    ConsumptionTracker(ConsumptionTracker &rCt);
+    ConsumptionTracker &operator=(ConsumptionTracker &rCt);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Helpers.  See ConsumptionTracker.cpp for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    void AddSample(float grams, uint32_t timeMs);
+    void Fit();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    uint32_t m_Spool;                   // Spool the series belongs to.
+    bool     m_HaveSpool;               // m_Spool is valid.
+
+    // The average being built.
+    double   m_BucketSum;               // Sum of the readings.
+    uint32_t m_BucketCount;             // Number of readings.
+    uint32_t m_BucketStartMs;           // Time of the first reading.
+
+    // The series (circular, m_Next is the oldest once full).
+    float    m_Grams[WINDOW_SIZE];      // Average net weights.
+    uint32_t m_TimesMs[WINDOW_SIZE];    // Their times.
+    size_t   m_NumSamples;              // Valid entries.
+    size_t   m_Next;                    // Next entry to replace.
+
+    // The fit.
+    bool     m_HaveRate;                // m_GramsPerMin is valid.
+    double   m_GramsPerMin;             // Usage rate.
+    double   m_LengthPerGram;           // Length units per gram.
+
+}; // End class ConsumptionTracker.
+
+
+
+#endif // CONSUMPTIONTRACKER_H
@@ -1,772 +1,1581 @@
-/////////////////////////////////////////////////////////////////////////////////
-// Display.cpp
-//
-// Contains miscellaneous methods used by the scale display.
-//
-// History:
-// - jmcorbett 26-DEC-2020 Original creation.
-//
-// Copyright (c) 2021, Joseph M. Corbett
-/////////////////////////////////////////////////////////////////////////////////
-
-#include <Preferences.h>        // For NVS save/restore.
-#include "Display.h"            // Our own class definition.
-#include "JmcFilamentScale.h"   // For BOX_RADIUS.
-#include "ScaleIcon.h"          // For ScaleIcon .
-
-
-// Some constants used by the class.
-const size_t Display::MAX_NVS_NAME_LEN     = 15U;
-const char  *Display::pPrefSavedStateLabel = "Saved State";
-const double Display::BACKLIGHT_FREQUENCY  = 5000.0d;
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Constructor
-//
-// Initialize our instance data and setup for use of the backlight and
-// initializes the TFT hardware and library with a blank screen.
-//
-// Arguments:
-//    - csPin        - Display's CS pin.
-//    - dcPin        - Display's DC pin.
-//    - rstPin       - Display's RST pin.
-//    - backlightPin - Display's backlight pin.
-//    - displayType  - Display type identified by colored tab on the display's
-//                     plastic overlay.  (INITR_GREENTAB, INITR_REDTAB, or
-//                     INITR_BLACKTAB).
-//    - rotation     - Display's rotation orientation  (0, 1, 2, or 3).
-/////////////////////////////////////////////////////////////////////////////////
-Display::Display(int csPin, int dcPin, int rstPin, int backlightPin,
-                 uint8_t displayType, uint8_t rotation) :
-        Adafruit_ST7735(csPin, dcPin, rstPin), m_pName(NULL),
-        m_BacklightPin(backlightPin), m_BacklightPercent(0)
-{
-    // Configure the lite functionality.
-    ledcSetup(BACKLIGHT_CHANNEL, BACKLIGHT_FREQUENCY, BACKLIGHT_RESOLUTION);
-
-    // Attach the analog channel to the GPIO pin to be controlled.
-    ledcAttachPin(m_BacklightPin, BACKLIGHT_CHANNEL);
-
-    // Set the gBacklight brightness.
-    ledcWrite(BACKLIGHT_CHANNEL, BACKLIGHT_MIN_BRIGHTNESS);
-
-    // The 1.8" TFT display from Adafruit seems to have a startup problem in
-    // which many times on initial power-up it doesn't get initialized
-    // properly and just shows a blank white screen.  The following code
-    // resets the display before initializing it in the hope of working around
-    // this problem.  Since this is a constructor, the delay() function will not
-    // work. We use delayMicroseconds() in its place, which should work in
-    // constructors.  The following section of code does the same thing as
-    // the reset that is done in Adafruit_SPITFT::initSPI(), but uses
-    // delayMicroseconds() instead of delay().
-    // Note that argument to delayMicroseconds() must be less than 16K, so the
-    // delays used here all use 1000 uS or 1ms as a basis, and loop the
-    // appropriate amount of times to affect the needed long delays.
-    pinMode(rstPin, OUTPUT);
-    digitalWrite(rstPin, HIGH);
-    // delay(100);  // Delay 100 ms.
-    int i = 0;
-    for (i = 0; i < 100; i++)
-    {
-        delayMicroseconds(1000);
-    }
-    digitalWrite(rstPin, LOW);
-    // delay(100);  // Delay 100 ms.
-    for (i = 0; i < 100; i++)
-    {
-        delayMicroseconds(1000);
-    }
-    digitalWrite(rstPin, HIGH);
-    // delay(200);  // Delay 200 ms.
-    for (i = 0; i < 200; i++)
-    {
-        delayMicroseconds(1000);
-    }
-
-    // Setup the display hardware and firmware library.
-    initR(displayType);
-    setRotation(rotation);
-    fillScreen(ST7735_BLACK);
-} // End constructor.
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Init()
-//
-// This method initializes the filament class.
-//
-// Arguments:
-//    - pName   - A string of no more than 15 characters to be used as a
-//                name for this instance.  This is mainly used to identify
-//                the instance to be used for NVS save and restore.
-//
-// Returns:
-//    Returns a bool indicating whether or not the initialization was
-//    successful.  A 'true' value indicates success, while a 'false' value
-//    indicates failure.
-//
-/////////////////////////////////////////////////////////////////////////////////
-bool Display::Init(const char *pName)
-{
-    // Assume we're gonna fail.
-    bool status = false;
-
-    // Make sure the name is valid.  If not then we fail.
-    if ((pName != NULL) && (*pName != '\0') && (strlen(pName) <= MAX_NVS_NAME_LEN))
-    {
-        // Name was OK.  Save it and remember that we succeeded.
-        m_pName            = pName;
-        status             = true;
-    }
-    return status;
-} // End Init().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SetBacklightPercent()
-//
-// Sets the backlight level to a percentage of its maximum brightness.
-//
-// Arguments:
-//    - percent - This is the percentage of maximum brightness which the
-//                backlight will be set to.  Valid values are 0 through
-//                100 inclusive.
-//
-// Returns:
-//    Returns 'true' if successful.  Returns 'false' if an invalid 'level' value
-//    was passed.
-/////////////////////////////////////////////////////////////////////////////////
-bool Display::SetBacklightPercent(uint32_t percent)
-{
-    bool status = false;
-
-    if (percent <= 100)
-    {
-        m_BacklightPercent = percent;
-        uint32_t backlightValue =
-          (percent * (BACKLIGHT_MAX_BRIGHTNESS - BACKLIGHT_MIN_BRIGHTNESS) / 100) +
-           BACKLIGHT_MIN_BRIGHTNESS;
-        ledcWrite(BACKLIGHT_CHANNEL, backlightValue);
-        status = true;
-    }
-    return status;
-} // End SetBacklightPercent().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// DisplayBox()
-//
-// Draws a box of the specified size on the screen at the specified location.
-//
-// Arguments:
-//    - line    - The line at which the box will be displayed.  Valid values
-//                are 0, 1, and 2.
-//    - side    - Specifies the horizontal location to start the box as well as
-//                the width of the box.  Valid values are:
-//                  o eAll   - to start the box at the left edge of the
-//                             display and extend it the entire width of the
-//                             display screen.
-//                  o eLeft  - to start the box at the left edge of the
-//                             display and extend it half the width of the
-//                             display screen.
-//                  o eRight - to start the box at the horizontal middle of
-//                             display and extend it to the right edge of
-//                             the display screen.
-//    - fgColor - The color of the outline that will be drawn around the box.
-//                Setting this to the same value as bgColor will cause no
-//                outline to be seen on the display (although one will be
-//                drawn).
-//    - bgColor - The color of the box that will be drawn.
-//    - radius  - The radius, in pixels, of the rounded corners of the box.
-//                A value of zero will cause the box to have square corners.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::DisplayBox(int line, BoxLocale side, uint16_t fgColor,
-                         uint16_t bgColor, int radius)
-{
-    int w = width();
-    int h = height();
-    int x0 = (side == eRight) ? w / 2 : 0;
-    int y0 = line * h / 3;
-    int xw = (side == eAll) ? w : w / 2;
-    int yh = h / 3 + 1;
-    fillRect(x0, y0 + 1, xw, yh, ST7735_BLACK);
-    fillRoundRect(x0, y0, xw, yh, radius, bgColor);
-    drawRoundRect(x0, y0, xw, yh, radius, fgColor);
-} // End DisplayBox().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// DisplayBoxHeader()
-//
-// Displays small (header) text in a specified box.
-//
-// Arguments:
-//    - pStr    - The text string to be displayed as a header in the
-//                specified box.
-//    - line    - The line of the box containing the header text to be
-//                displayed.  Valid values are 0, 1, and 2.
-//    - side    - Specifies the horizontal location of the box as well
-//                as its the width.  Valid values are:
-//                  o eAll   - the box starts at the left edge of the
-//                             display and extends to the  right edge of
-//                             the display screen.
-//                  o eLeft  - the box starts at the left edge of the
-//                             display and extends half the width of the
-//                             display screen.
-//                  o eRight - the box starts at the horizontal middle of
-//                             display and extend it to the right edge of
-//                             the display screen.
-//    - fgColor - The color of the text that will be displayed.
-//    - bgColor - The color of the box that will hold the text string.
-//    - margin  - The number of pixels to indent the text from the left edge
-//                of the box.  This is generally set to the save value as
-//                the 'radius' value that was used to create the box via
-//                DisplayBox().
-/////////////////////////////////////////////////////////////////////////////////
-void Display::DisplayBoxHeader(const char *pStr, int line, BoxLocale side,
-                               uint16_t fgColor, uint16_t bgColor, int margin)
-{
-    // Save entry state.
-    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
-
-    // Get the size of the string to be displayed.
-    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
-    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
-    uint16_t xl  = 0;   // X length of string in pixels.
-    uint16_t yl  = 0;   // Y height of string in pixels.
-    setTextSize(1, 1);
-    getTextBounds(pStr, 0, 0, &ulx, &uly, &xl, &yl);
-
-    // Determine the current screen size (can change in use).
-    int16_t screenWidth  = width();
-    int16_t screehHeight = height();
-
-    // Determine the coords to start printing the string.
-    int16_t  cursorX = margin;
-    int16_t  cursorY = line * screehHeight / 3 + 3;
-    if (side == eRight)
-    {
-        cursorX += screenWidth / 2;
-    }
-
-    // Clear the area of the box from the end of the new text to the end
-    // of the box.
-    uint16_t fieldWidth = (side == eAll) ? screenWidth : screenWidth / 2;
-    int16_t  clearWidth = fieldWidth - 2 * margin - xl;
-    fillRect(cursorX + xl, cursorY, clearWidth, yl, bgColor);
-
-    // Get ready to print the string.
-    setCursor(cursorX, cursorY);
-    setTextColor(fgColor, bgColor);
-
-    // Print the string.
-    print(pStr);
-
-    // Restore the entry state.
-    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
-} // End DisplayBoxHeader().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// DisplayBoxMain()
-//
-// Displays large (main) text in a specified box.
-//
-// Arguments:
-//    - pStr    - The text string to be displayed as a main text in the
-//                specified box.
-//    - line    - The line of the box containing the main text to be
-//                displayed.  Valid values are 0, 1, and 2.
-//    - side    - Specifies the horizontal location of the box as well
-//                as its the width.  Valid values are:
-//                  o eAll   - the box starts at the left edge of the
-//                             display and extends to the  right edge of
-//                             the display screen.
-//                  o eLeft  - the box starts at the left edge of the
-//                             display and extends half the width of the
-//                             display screen.
-//                  o eRight - the box starts at the horizontal middle of
-//                             display and extend it to the right edge of
-//                             the display screen.
-//    - fgColor - The color of the text that will be displayed.
-//    - bgColor - The color of the box that will hold the text string.
-//    - margin  - The number of pixels to indent the text from the left edge
-//                of the box.  This is generally set to the save value as
-//                the 'radius' value that was used to create the box via
-//                DisplayBox().
-/////////////////////////////////////////////////////////////////////////////////
-void Display::DisplayBoxMain(const char *pStr, int line, BoxLocale side,
-                             uint16_t fgColor, uint16_t bgColor, int margin)
-{
-    // Save entry state.
-    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
-
-    // Determine if the length of the string is too long to fit within the
-    // normal screen width.  If so, change the text width to double the number
-    // of characters that will fit in the box.
-    int length = strlen(pStr);
-    int limit  = side == eAll ? (SCREEN_CHAR_WIDTH - 1) : (SCREEN_CHAR_WIDTH /2);
-
-    // Get ready to print the string.
-    setTextSize(length > limit ? 1 : 2, 3);
-    setCursor(margin, line * height() / 3 + 15);
-
-    // Display the data based on the type of box used.
-    if (side == eAll)
-    {
-        DisplayHCenteredText(pStr, fgColor, bgColor, margin);
-    }
-    else
-    {
-        DisplayCenteredHalf(pStr, side, fgColor, bgColor, margin);
-    }
-
-    // Restore the entry state.
-    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
-} // End DisplayBoxMain().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// DisplayHVCenteredText()
-//
-// Displays a text string centered vertically and horizontally on the TFT
-// screen.
-//
-// Arguments:
-//    - pStr    - A pointer to the NULL terminated string to be displayed.
-//    - fgColor - Specifies the foreground color of the text being displayed.
-//    - bgColor - Specifies the background color of the text being displayed.
-//    - radius  - Radius in pixels for rounded containing box.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::DisplayHVCenteredText(
-        const char *pStr, uint16_t fgColor, uint16_t bgColor, int radius)
-{
-    // Save entry state.
-    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
-
-    // Get the size of the string to be displayed.
-    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
-    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
-    uint16_t xl  = 0;   // X length of string in pixels.
-    uint16_t yl  = 0;   // Y height of string in pixels.
-    setTextSize(2, 2);
-    getTextBounds(pStr, 0, 0, &ulx, &uly, &xl, &yl);
-
-    // Determine the current screen size (can change in use).
-    int16_t screenWidth  = width();
-    int16_t screenHeight = height();
-
-    // Determine the coords to start printing the string.
-    uint16_t cursorX = (screenWidth - xl) / 2;
-    uint16_t cursorY = (screenHeight - yl) / 2;
-
-    // Display the text, centered on the display.
-    FillScreen(fgColor, bgColor, radius);
-
-    setTextColor(fgColor, bgColor);
-    setCursor(cursorX, cursorY);
-    print(pStr);
-    
-    // Repair the left side of the enclosing box in case the string contains
-    // any new line characters.
-    drawFastVLine(0, cursorY, yl - uly, fgColor);
-
-    // Restore the entry state.
-    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
-} // End DisplayHVCenteredText().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// DisplayHCenteredText()
-//
-// Displays a text string centered vertically on the TFT screen at the current
-// display line.
-//
-// Arguments:
-//    - pStr    - A pointer to the NULL terminated string to be displayed.
-//    - fgColor - Specifies the foreground color of the text being displayed.
-//    - bgColor - Specifies the background color of the text being displayed.
-//    - margin  - Specifies the left and right margin for the box in which the
-//                string will be displayed.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::DisplayHCenteredText(
-        const char *pStr, uint16_t fgColor, uint16_t bgColor, int margin)
-{
-    // Save entry state.
-    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
-
-    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
-    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
-    uint16_t xl  = 0;   // X length of string in pixels.
-    uint16_t yl  = 0;   // Y height of string in pixels.
-
-    // Get the size of the string to be displayed.
-    getTextBounds(pStr, 0, 0, &ulx, &uly, &xl, &yl);
-
-    // Determine the current screen size (can change in use).
-    int16_t screenWidth = width();
-
-    // Determine the coords to start printing the string.
-    uint16_t cursorX = (screenWidth - xl) / 2;
-    uint16_t cursorY = getCursorY();
-
-    // Display the text, centered on the display.  Clear the line on both sides
-    // of the new string.
-    setTextColor(fgColor, bgColor);
-    setCursor(cursorX, cursorY);
-    fillRect(margin, cursorY, cursorX - margin, yl, bgColor);
-    fillRect(cursorX + xl, cursorY,
-             screenWidth - margin - (cursorX + xl), yl, bgColor);
-
-    print(pStr);
-
-    // Restore the entry state.
-    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
-} // End DisplayHCenteredText().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// DisplayCenteredHalf()
-//
-// Displays a text string centered vertically on the TFT screen at the current
-// display line.
-//
-// Arguments:
-//    - pStr    - A pointer to the NULL terminated string to be displayed.
-//    - side    - Side in which the string will be centered.  Legal values
-//                are LEFT_HALF or RIGHT_HALF.
-//    - fgColor - Specifies the foreground color of the text being displayed.
-//    - bgColor - Specifies the background color of the text being displayed.
-//    - margin  - Specifies the left and right margin for the box in which the
-//                string will be displayed.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::DisplayCenteredHalf(
-        const char *pStr, BoxLocale side, uint16_t fgColor, uint16_t bgColor, int margin)
-{
-    // Save entry state.
-    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
-
-    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
-    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
-    uint16_t xl  = 0;   // X length of string in pixels.
-    uint16_t yl  = 0;   // Y height of string in pixels.
-
-    // Get the size of the string to be displayed.
-    getTextBounds(pStr, 0, 0, &ulx, &uly, &xl, &yl);
-
-    // Determine the current screen size (can change in use).
-    int16_t screenWidth  = width();
-
-    // Determine the coords to start printing the string.
-    uint16_t cursorX = (screenWidth / 2 - xl) / 2;
-    uint16_t cursorY = getCursorY();
-    uint16_t fieldX  = 0;
-    if (side == eRight)
-    {
-        cursorX += screenWidth / 2;
-        fieldX  = screenWidth / 2;
-    }
-
-    // Display the text, centered on the display.  Clear the line on both sides
-    // of the new string.
-    setTextColor(fgColor, bgColor);
-    setCursor(cursorX, cursorY);
-    fillRect(fieldX + margin, cursorY, cursorX - fieldX - margin, yl, bgColor);
-    fillRect(cursorX + xl, cursorY,
-             screenWidth / 2 - (cursorX - fieldX) - xl - margin, yl, bgColor);
-
-    print(pStr);
-
-    // Restore the entry state.
-    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
-} // End DisplayCenteredHalf().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// FillScreen()
-//
-// Fills the screen with a (possibly) outlined box with a given radius.
-//
-// Arguments:
-//    - fgColor - Specifies the outline color of the box.
-//    - bgColor - Specifies the background color of the box.
-//    - radius  - Radius in pixels for rounded box.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::FillScreen(uint16_t fgColor, uint16_t bgColor, int radius)
-{
-    // Remove any colors that may be past the rounded box corners.
-    if (radius)
-    {
-        fillScreen(ST7735_BLACK);
-    }
-    fillRoundRect(0, 0, width(), height(), radius, bgColor);
-    drawRoundRect(0, 0, width(), height(), radius, fgColor);
-}
-
-/////////////////////////////////////////////////////////////////////////////////
-// BlinkCenteredDisplay()
-//
-// Blinks a text string centered vertically and horizontally on the TFT
-// screen.  Note that the string will blink at a rate of 500ms on and 500ms
-// off.
-//
-// Arguments:
-//    - pStr      - A pointer to the NULL terminated string to be displayed.
-//    - textColor - Specifies the foreground color of the text being displayed.
-//    - backColor - Specifies the background color of the text being displayed.
-//    - radius    - Radius in pixels for rounded containing box.
-//    - duration  - Duration in milliseconds to display the blinking string.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::BlinkCenteredDisplay(
-        const char *pStr, uint16_t textColor, uint16_t backColor, int radius,
-        uint32_t duration)
-{
-    const uint32_t BLINK_RATE = 500;
-
-    for (uint32_t i = 0; i < duration; i += 2 * BLINK_RATE)
-    {
-        DisplayHVCenteredText(pStr, textColor, backColor, radius);
-        delay(BLINK_RATE);
-
-        FillScreen(textColor, backColor, radius);
-        delay(BLINK_RATE);
-    }
-} // End BlinkCenteredDisplay().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// DisplayWorkingScreen()
-//
-// Displays the text "WORKING" centered horizontally and vertically on these
-// screen.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::DisplayWorkingScreen()
-{
-    // Show the user that we're doing something.
-    DisplayHVCenteredText("WORKING", ST77XX_BLUE, ST77XX_WHITE, BOX_RADIUS);
-} // End DisplayWorkingScreen().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// DisplayResult()
-//
-// Displays a standardized results screen based on the status that is passed
-// to it.
-//
-// Arguments:
-//    - success  - Specifies the status to be displayed.  A value of 'true'
-//                 causes the 'goodStr' string to be displayed as a solid
-//                 (non-blinking) string centered vertically and horizontally
-//                 on the display.  A value of 'false' causes the 'badStr'
-//                 string to be displayed as a blinking string centered
-//                 vertically and horizontally on the screen.
-//    - pGoodStr - Specifies the string to be displayed when 'success' is
-//                 'true'.
-//    - pBadStr  - Specifies the string to be displayed when 'success' is
-//                 'false'.
-//    - radius   - The radius, in pixels, of the rounded corners of the box.
-//                 A value of zero will cause the box to have square corners.
-//    - duration - Duration in milliseconds to display the selected string.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::DisplayResult(
-        bool success, const char *pGoodStr, const char *pBadStr,
-        int radius, uint32_t duration)
-{
-    uint16_t backColor = ST77XX_GREEN;
-    uint16_t textColor = ST77XX_WHITE;
-
-    // Let the user know if we succeeded or failed.
-    if (success)
-    {
-        DisplayHVCenteredText(pGoodStr, textColor, backColor, radius);
-        delay(duration);
-    }
-    else
-    {
-        backColor = ST77XX_RED;
-        BlinkCenteredDisplay(pBadStr, textColor, backColor, radius, duration);
-    }
-} // End DisplayResult().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// WelcomeScreen()
-//
-// Displays a welcome screen.
-//
-// Arguments:
-//    fgColor - Foreground color for the welcome screen.
-//    bgColor - Background color for the welcome screen.
-//    radius  - Radius for rounded box background.
-/////////////////////////////////////////////////////////////////////////////////
-void Display::WelcomeScreen(uint16_t fgColor, uint16_t bgColor, int radius)
-{
-    // Make sure the backlight is on.  The NVS restore is performed later, and
-    // will set the backlight as the user wants, but we always want the welcome
-    // screen to display with 100% brightness.
-    SetBacklightPercent(100);
-
-    const char *pName = "JMC 3DP SCALE";
-    const uint32_t SCROLL_DWELL_MS = 10;
-
-    // Get ready to display the welcome screen.
-    setTextSize(2, 3);
-    setTextWrap(false);
-    FillScreen(fgColor, bgColor, radius);
-
-    // Display the scale graphic background.
-    drawBitmap((width() - 120) / 2, (height() - 120) / 2,
-                     ScaleIcon, 120, 120, 0);
-    delay(1000);
-
-    // Get the size of the string to be displayed.
-    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
-    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
-    uint16_t xl  = 0;   // X length of string in pixels.
-    uint16_t yl  = 0;   // Y height of string in pixels.
-    getTextBounds(pName, 0, 0, &ulx, &uly, &xl, &yl);
-
-    // Calculate where to place the string.
-    uint16_t cursorY = (height() - yl) / 2;
-    uint16_t xStop   = (width() - xl) / 2;
-
-    // Slowly scroll the string from the right side.
-    setTextColor(fgColor, bgColor);
-    for (int i = width() - 1; i >= xStop; i--)
-    {
-        setCursor(i, cursorY);
-        print(pName);
-        drawFastVLine(width() - 1, radius, height() - 2 * radius, fgColor);
-        delay(SCROLL_DWELL_MS);
-    }
-
-    // Wait a second before scrolling the footer.
-    delay(1000);
-    setTextSize(1);
-    const char *pFooter = "(c) 2021, J. M. Corbett";
-    getTextBounds(pFooter, 0, 0, &ulx, &uly, &xl, &yl);
-
-    // Calculate where to place the string.
-    cursorY = height() - 2 * yl;
-    xStop   = (width() - xl) / 2;
-
-    // Slowly scroll the string from the right side.
-    for (int i = width() - 1; i >= xStop; i--)
-    {
-        setCursor(i, cursorY);
-        print(pFooter);
-        drawFastVLine(width() - 1, radius, height() - 2 * radius, fgColor);
-        delay(SCROLL_DWELL_MS);
-    }
-} // End WelcomeScreen().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Save()
-//
-// Saves our current state to NVS.
-//
-// Returns:
-//    Returns 'true' if successful, or 'false' otherwise.
-/////////////////////////////////////////////////////////////////////////////////
-bool Display::Save() const
-{
-    size_t saved = 0;
-    if (m_pName != NULL)
-    {
-        // Read our currently saved state.  If it hasn't changed, then don't
-        // bother to do the save in order to conserve writes to NVS.
-        uint32_t nvsState;
-
-        // Save our state data.
-        Preferences prefs;
-        prefs.begin(m_pName);
-
-        // Get the saved data.
-        size_t nvsSize =
-            prefs.getBytes(pPrefSavedStateLabel, &nvsState, sizeof(uint32_t));
-
-        // See if our working data has changed since our last save.
-        if ((nvsSize != sizeof(uint32_t)) ||
-            memcmp(&nvsState, &m_BacklightPercent, sizeof(uint32_t)))
-        {
-            // Data has changed so go ahead and save it.
-            Serial.println("\nDisplay - saving to NVS.");
-            saved =
-                prefs.putBytes(pPrefSavedStateLabel, &m_BacklightPercent, sizeof(uint32_t));
-        }
-        else
-        {
-            // Data has not changed.  Do nothing.
-            saved = sizeof(uint32_t);
-            Serial.println("\nDisplay - not saving to NVS.");
-        }
-        prefs.end();
-    }
-
-    // Let the caller know if we succeeded or failed.
-    return saved == sizeof(uint32_t);
- } // End Save().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Restore()
-//
-// Restores our state from NVS.
-//
-// Returns:
-//    Returns 'true' if successful, or 'false' otherwise.
-/////////////////////////////////////////////////////////////////////////////////
-bool Display::Restore()
-{
-    // Assume we're gonna fail.
-    bool succeeded = false;
-
-    // Make sure we have a valid name.
-    if (m_pName != NULL)
-    {
-        // Restore our state data to a temporary structure.
-        uint32_t cachedState;
-        Preferences prefs;
-        prefs.begin(m_pName);
-        size_t restored =
-            prefs.getBytes(pPrefSavedStateLabel, &cachedState, sizeof(uint32_t));
-
-        // Save the restored values only if the get was successful.
-        if (restored == sizeof(uint32_t))
-        {
-            SetBacklightPercent(cachedState);
-            succeeded = true;
-        }
-        prefs.end();
-    }
-
-    // Let the caller know if we succeeded or failed.
-    return succeeded;
- } // End Restore().
-
-
-/////////////////////////////////////////////////////////////////////////////
-// Reset()
-//
-// Reset our state info in NVS.
-//
-// Returns:
-//    Returns 'true' if successful, or 'false' otherwise.
-/////////////////////////////////////////////////////////////////////////////
-bool Display::Reset()
-{
-    bool status = false;
-    if (m_pName != NULL)
-    {
-        // Remove our state data rom NVS.
-        Preferences prefs;
-        prefs.begin(m_pName);
-        status = prefs.remove(pPrefSavedStateLabel);
-        prefs.end();
-    }
-    return status;
-} // End Reset().
-
-
+/////////////////////////////////////////////////////////////////////////////////
+// Display.cpp
+//
+// Contains miscellaneous methods used by the scale display.
+//
+// History:
+// - jmcorbett 26-DEC-2020 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>              // For INT32_MAX.
+#include <cstdlib>              // For malloc() and free().
+#include <cstring>              // For strlen(), memcpy(), memmove().
+#include "NvsStore.h"           // For NVS save/restore.
+#include "Display.h"            // Our own class definition.
+#include "JmcFilamentScale.h"   // For BOX_RADIUS.
+#include "ScaleIcon.h"          // For ScaleIcon .
+
+
+// Some constants used by the class.
+const size_t Display::MAX_NVS_NAME_LEN     = 15U;
+const char  *Display::pPrefSavedStateLabel = "Saved State";
+const double Display::BACKLIGHT_FREQUENCY  = 5000.0d;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor
+//
+// Initialize our instance data and setup for use of the backlight and
+// initializes the TFT hardware and library with a blank screen.
+//
+// Arguments:
+//    - csPin        - Display's CS pin.
+//    - dcPin        - Display's DC pin.
+//    - rstPin       - Display's RST pin.
+//    - backlightPin - Display's backlight pin.
+//    - displayType  - Display type identified by colored tab on the display's
+//                     plastic overlay.  (INITR_GREENTAB, INITR_REDTAB, or
+//                     INITR_BLACKTAB).
+//    - rotation     - Display's rotation orientation  (0, 1, 2, or 3).
+/////////////////////////////////////////////////////////////////////////////////
+Display::Display(int csPin, int dcPin, int rstPin, int backlightPin,
+                 uint8_t displayType, uint8_t rotation) :
+        Adafruit_ST7735(csPin, dcPin, rstPin), m_pName(NULL),
+        m_BacklightPin(backlightPin), m_BacklightPercent(0),
+        m_pFrameBuffer(NULL), m_FbWidth(0), m_FbHeight(0),
+        m_NumDirty(0U), m_NumSend(0U),
+        m_WriteDepth(0U), m_FrameDepth(0U), m_OffsetY(0), m_Sending(false),
+        m_FlushTask(NULL), m_FlushDone(NULL),
+        m_pCapture(NULL), m_CaptureWidth(0), m_CaptureHeight(0)
+{
+    // No box masks yet.
+    m_BoxMasks[0].m_Width = 0;
+    m_BoxMasks[1].m_Width = 0;
+
+    // Configure the lite functionality.
+    ledcSetup(BACKLIGHT_CHANNEL, BACKLIGHT_FREQUENCY, BACKLIGHT_RESOLUTION);
+
+    // Attach the analog channel to the GPIO pin to be controlled.
+    ledcAttachPin(m_BacklightPin, BACKLIGHT_CHANNEL);
+
+    // Set the gBacklight brightness.
+    ledcWrite(BACKLIGHT_CHANNEL, BACKLIGHT_MIN_BRIGHTNESS);
+
+    // The 1.8" TFT display from Adafruit seems to have a startup problem in
+    // which many times on initial power-up it doesn't get initialized
+    // properly and just shows a blank white screen.  The following code
+    // resets the display before initializing it in the hope of working around
+    // this problem.  Since this is a constructor, the delay() function will not
+    // work. We use delayMicroseconds() in its place, which should work in
+    // constructors.  The following section of code does the same thing as
+    // the reset that is done in Adafruit_SPITFT::initSPI(), but uses
+    // delayMicroseconds() instead of delay().
+    // Note that argument to delayMicroseconds() must be less than 16K, so the
+    // delays used here all use 1000 uS or 1ms as a basis, and loop the
+    // appropriate amount of times to affect the needed long delays.
+    pinMode(rstPin, OUTPUT);
+    digitalWrite(rstPin, HIGH);
+    // delay(100);  // Delay 100 ms.
+    int i = 0;
+    for (i = 0; i < 100; i++)
+    {
+        delayMicroseconds(1000);
+    }
+    digitalWrite(rstPin, LOW);
+    // delay(100);  // Delay 100 ms.
+    for (i = 0; i < 100; i++)
+    {
+        delayMicroseconds(1000);
+    }
+    digitalWrite(rstPin, HIGH);
+    // delay(200);  // Delay 200 ms.
+    for (i = 0; i < 200; i++)
+    {
+        delayMicroseconds(1000);
+    }
+
+    // Setup the display hardware and firmware library.
+    initR(displayType);
+    setRotation(rotation);
+    fillScreen(ST7735_BLACK);
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Init()
+//
+// This method initializes the filament class.
+//
+// Arguments:
+//    - pName   - A string of no more than 15 characters to be used as a
+//                name for this instance.  This is mainly used to identify
+//                the instance to be used for NVS save and restore.
+//
+// Returns:
+//    Returns a bool indicating whether or not the initialization was
+//    successful.  A 'true' value indicates success, while a 'false' value
+//    indicates failure.
+//
+/////////////////////////////////////////////////////////////////////////////////
+bool Display::Init(const char *pName)
+{
+    // Assume we're gonna fail.
+    bool status = false;
+
+    // Make sure the name is valid.  If not then we fail.
+    if ((pName != NULL) && (*pName != '\0') && (strlen(pName) <= MAX_NVS_NAME_LEN))
+    {
+        // Name was OK.  Save it and remember that we succeeded.
+        m_pName            = pName;
+        status             = true;
+    }
+    return status;
+} // End Init().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetBacklightPercent()
+//
+// Sets the backlight level to a percentage of its maximum brightness.
+//
+// Arguments:
+//    - percent - This is the percentage of maximum brightness which the
+//                backlight will be set to.  Valid values are 0 through
+//                100 inclusive.
+//
+// Returns:
+//    Returns 'true' if successful.  Returns 'false' if an invalid 'level' value
+//    was passed.
+/////////////////////////////////////////////////////////////////////////////////
+bool Display::SetBacklightPercent(uint32_t percent)
+{
+    bool status = false;
+
+    if (percent <= 100)
+    {
+        m_BacklightPercent = percent;
+        uint32_t backlightValue =
+          (percent * (BACKLIGHT_MAX_BRIGHTNESS - BACKLIGHT_MIN_BRIGHTNESS) / 100) +
+           BACKLIGHT_MIN_BRIGHTNESS;
+        ledcWrite(BACKLIGHT_CHANNEL, backlightValue);
+        status = true;
+    }
+    return status;
+} // End SetBacklightPercent().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayBox()
+//
+// Draws a box of the specified size on the screen at the specified location.
+//
+// Arguments:
+//    - line    - The line at which the box will be displayed.  Valid values
+//                are 0, 1, and 2.
+//    - side    - Specifies the horizontal location to start the box as well as
+//                the width of the box.  Valid values are:
+//                  o eAll   - to start the box at the left edge of the
+//                             display and extend it the entire width of the
+//                             display screen.
+//                  o eLeft  - to start the box at the left edge of the
+//                             display and extend it half the width of the
+//                             display screen.
+//                  o eRight - to start the box at the horizontal middle of
+//                             display and extend it to the right edge of
+//                             the display screen.
+//    - fgColor - The color of the outline that will be drawn around the box.
+//                Setting this to the same value as bgColor will cause no
+//                outline to be seen on the display (although one will be
+//                drawn).
+//    - bgColor - The color of the box that will be drawn.
+//    - radius  - The radius, in pixels, of the rounded corners of the box.
+//                A value of zero will cause the box to have square corners.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DisplayBox(int line, BoxLocale side, uint16_t fgColor,
+                         uint16_t bgColor, int radius)
+{
+    int w = width();
+    int h = height();
+    int x0 = (side == eRight) ? w / 2 : 0;
+    int y0 = line * h / 3;
+    int xw = (side == eAll) ? w : w / 2;
+    int yh = h / 3 + 1;
+
+    // Every box of a given width has the same shape, so its rounded corners
+    // are worked out once, when the width (rotation) or radius changes.
+    BoxMask &rMask = m_BoxMasks[(side == eAll) ? 1 : 0];
+    if ((rMask.m_Width != xw) || (rMask.m_Height != yh) || (rMask.m_Radius != radius))
+    {
+        BuildBoxMask(rMask, xw, yh, radius);
+    }
+
+    if (rMask.m_Valid)
+    {
+        BlitBoxMask(rMask, x0, y0, fgColor, bgColor);
+    }
+    else
+    {
+        DrawBoxShapes(x0, y0, xw, yh, fgColor, bgColor, ST7735_BLACK, radius);
+    }
+} // End DisplayBox().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DrawBoxShapes()
+//
+// Draws a box: clears behind it, then draws its background and outline.
+//
+// Arguments:
+//    - x0, y0     - Upper left corner.
+//    - xw, yh     - Width and height.
+//    - fgColor    - Outline color.
+//    - bgColor    - Background color.
+//    - clearColor - Color behind the box.
+//    - radius     - Corner radius.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DrawBoxShapes(int16_t x0, int16_t y0, int16_t xw, int16_t yh,
+                            uint16_t fgColor, uint16_t bgColor,
+                            uint16_t clearColor, int radius)
+{
+    fillRect(x0, y0 + 1, xw, yh, clearColor);
+    fillRoundRect(x0, y0, xw, yh, radius, bgColor);
+    drawRoundRect(x0, y0, xw, yh, radius, fgColor);
+} // End DrawBoxShapes().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// BuildBoxMask()
+//
+// Builds a box mask by drawing the box with DrawBoxShapes() into a scratch
+// array of MaskPixels, then recording each row as runs.
+//
+// Arguments:
+//    - rMask  - The mask to build.
+//    - xw, yh - Box width and height.
+//    - radius - Corner radius.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the box doesn't fit in a
+//    BoxMask or there is no memory for the scratch array.  The mask is then
+//    marked invalid, and the box is drawn by DrawBoxShapes().
+/////////////////////////////////////////////////////////////////////////////////
+bool Display::BuildBoxMask(BoxMask &rMask, int16_t xw, int16_t yh, int radius)
+{
+    rMask.m_Width  = xw;
+    rMask.m_Height = yh;
+    rMask.m_Radius = radius;
+    rMask.m_Valid  = false;
+
+    // Each run must fit in a uint8_t.
+    if ((xw <= 0) || (xw > UINT8_MAX) || (yh <= 0) || (yh > MAX_MASK_ROWS))
+    {
+        return false;
+    }
+    uint8_t *pGrid = static_cast<uint8_t *>(calloc(xw * (yh + 1), sizeof(uint8_t)));
+    if (pGrid == NULL)
+    {
+        return false;
+    }
+
+    // Draw the box into the grid.  The drawing primitives write MaskPixels to
+    // it while m_pCapture is set.
+    m_pCapture      = pGrid;
+    m_CaptureWidth  = xw;
+    m_CaptureHeight = yh + 1;
+    DrawBoxShapes(0, 0, xw, yh, eMpFg, eMpBg, eMpClear, radius);
+    m_pCapture      = NULL;
+
+    // Record the runs.
+    bool fits = true;
+    for (int16_t row = 0; fits && (row <= yh); row++)
+    {
+        const uint8_t *pRow = &pGrid[row * xw];
+        size_t runs = 0U;
+        rMask.m_Opaque[row] = true;
+        for (int16_t col = 0; fits && (col < xw); runs++)
+        {
+            int16_t end = col + 1;
+            while ((end < xw) && (pRow[end] == pRow[col]))
+            {
+                end++;
+            }
+            fits = runs < MAX_MASK_RUNS;
+            if (fits)
+            {
+                rMask.m_Runs[row][runs].m_Pixel  = pRow[col];
+                rMask.m_Runs[row][runs].m_Length = static_cast<uint8_t>(end - col);
+                rMask.m_Opaque[row] &= pRow[col] != eMpUntouched;
+            }
+            col = end;
+        }
+        rMask.m_RunCounts[row] = static_cast<uint8_t>(runs);
+    }
+    free(pGrid);
+
+    rMask.m_Valid = fits;
+    return fits;
+} // End BuildBoxMask().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// BlitBoxMask()
+//
+// Draws a box from its mask.  With a frame buffer, each run is a fill of the
+// frame buffer.  Without one, each series of rows that has no untouched
+// pixels is sent in one burst, in a single address window, and the few other
+// rows (the top of the box) run by run.
+//
+// Arguments:
+//    - rMask   - The box's mask.
+//    - x0, y0  - Upper left corner of the box.
+//    - fgColor - Outline color.
+//    - bgColor - Background color.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::BlitBoxMask(const BoxMask &rMask, int16_t x0, int16_t y0,
+                          uint16_t fgColor, uint16_t bgColor)
+{
+    // Indexed by MaskPixel.
+    const uint16_t colors[] = { ST7735_BLACK, ST7735_BLACK, bgColor, fgColor };
+
+    // The row below the bottom boxes is off the screen.
+    int16_t rows = rMask.m_Height + 1;
+    if (y0 + rows > height())
+    {
+        rows = height() - y0;
+    }
+
+    if (DrawsOffScreen())
+    {
+        for (int16_t row = 0; row < rows; row++)
+        {
+            int16_t x = x0;
+            for (size_t run = 0U; run < rMask.m_RunCounts[row]; run++)
+            {
+                uint8_t pixel  = rMask.m_Runs[row][run].m_Pixel;
+                uint8_t length = rMask.m_Runs[row][run].m_Length;
+                if (pixel != eMpUntouched)
+                {
+                    FbFill(x, y0 + row, length, 1, colors[pixel]);
+                }
+                x += length;
+            }
+        }
+        FbDrawn();
+        return;
+    }
+
+    Adafruit_ST7735::startWrite();
+    int16_t first = 0;      // First of the opaque rows not yet sent.
+    for (int16_t row = 0; row <= rows; row++)
+    {
+        if ((row < rows) && rMask.m_Opaque[row])
+        {
+            continue;
+        }
+
+        // Send the opaque rows before this one in one window.
+        if (first < row)
+        {
+            setAddrWindow(x0, y0 + first, rMask.m_Width, row - first);
+            for (int16_t r = first; r < row; r++)
+            {
+                for (size_t run = 0U; run < rMask.m_RunCounts[r]; run++)
+                {
+                    writeColor(colors[rMask.m_Runs[r][run].m_Pixel],
+                               rMask.m_Runs[r][run].m_Length);
+                }
+            }
+        }
+
+        // Send this row run by run, skipping the untouched pixels.
+        if (row < rows)
+        {
+            int16_t x = x0;
+            for (size_t run = 0U; run < rMask.m_RunCounts[row]; run++)
+            {
+                uint8_t pixel  = rMask.m_Runs[row][run].m_Pixel;
+                uint8_t length = rMask.m_Runs[row][run].m_Length;
+                if (pixel != eMpUntouched)
+                {
+                    setAddrWindow(x, y0 + row, length, 1);
+                    writeColor(colors[pixel], length);
+                }
+                x += length;
+            }
+        }
+        first = row + 1;
+    }
+    Adafruit_ST7735::endWrite();
+} // End BlitBoxMask().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayBoxHeader()
+//
+// Displays small (header) text in a specified box.
+//
+// Arguments:
+//    - pStr    - The text string to be displayed as a header in the
+//                specified box.
+//    - line    - The line of the box containing the header text to be
+//                displayed.  Valid values are 0, 1, and 2.
+//    - side    - Specifies the horizontal location of the box as well
+//                as its the width.  Valid values are:
+//                  o eAll   - the box starts at the left edge of the
+//                             display and extends to the  right edge of
+//                             the display screen.
+//                  o eLeft  - the box starts at the left edge of the
+//                             display and extends half the width of the
+//                             display screen.
+//                  o eRight - the box starts at the horizontal middle of
+//                             display and extend it to the right edge of
+//                             the display screen.
+//    - fgColor - The color of the text that will be displayed.
+//    - bgColor - The color of the box that will hold the text string.
+//    - margin  - The number of pixels to indent the text from the left edge
+//                of the box.  This is generally set to the save value as
+//                the 'radius' value that was used to create the box via
+//                DisplayBox().
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DisplayBoxHeader(const char *pStr, int line, BoxLocale side,
+                               uint16_t fgColor, uint16_t bgColor, int margin,
+                               RenderedText *pLast)
+{
+    // Save entry state.
+    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
+    setTextSize(1, 1);
+
+    // Determine the current screen size (can change in use).
+    int16_t screenWidth  = width();
+    int16_t screehHeight = height();
+
+    // Determine the coords to start printing the string.
+    int16_t  cursorX = margin;
+    int16_t  cursorY = line * screehHeight / 3 + 3;
+    if (side == eRight)
+    {
+        cursorX += screenWidth / 2;
+    }
+
+    // If the header was last drawn the same, only the characters that differ
+    // need to be drawn.
+    if (DrawTextChanges(pStr, cursorY, fgColor, bgColor, pLast))
+    {
+        state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
+        return;
+    }
+
+    // Get the size of the string to be displayed.
+    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
+    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
+    uint16_t xl  = 0;   // X length of string in pixels.
+    uint16_t yl  = 0;   // Y height of string in pixels.
+    getTextBounds(pStr, 0, 0, &ulx, &uly, &xl, &yl);
+
+    // Clear the area of the box from the end of the new text to the end
+    // of the box.
+    uint16_t fieldWidth = (side == eAll) ? screenWidth : screenWidth / 2;
+    int16_t  clearWidth = fieldWidth - 2 * margin - xl;
+    fillRect(cursorX + xl, cursorY, clearWidth, yl, bgColor);
+
+    // Get ready to print the string.
+    setCursor(cursorX, cursorY);
+    setTextColor(fgColor, bgColor);
+
+    // Print the string.
+    print(pStr);
+    RememberText(pStr, cursorY, fgColor, bgColor, pLast);
+
+    // Restore the entry state.
+    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
+} // End DisplayBoxHeader().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayBoxMain()
+//
+// Displays large (main) text in a specified box.
+//
+// Arguments:
+//    - pStr    - The text string to be displayed as a main text in the
+//                specified box.
+//    - line    - The line of the box containing the main text to be
+//                displayed.  Valid values are 0, 1, and 2.
+//    - side    - Specifies the horizontal location of the box as well
+//                as its the width.  Valid values are:
+//                  o eAll   - the box starts at the left edge of the
+//                             display and extends to the  right edge of
+//                             the display screen.
+//                  o eLeft  - the box starts at the left edge of the
+//                             display and extends half the width of the
+//                             display screen.
+//                  o eRight - the box starts at the horizontal middle of
+//                             display and extend it to the right edge of
+//                             the display screen.
+//    - fgColor - The color of the text that will be displayed.
+//    - bgColor - The color of the box that will hold the text string.
+//    - margin  - The number of pixels to indent the text from the left edge
+//                of the box.  This is generally set to the save value as
+//                the 'radius' value that was used to create the box via
+//                DisplayBox().
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DisplayBoxMain(const char *pStr, int line, BoxLocale side,
+                             uint16_t fgColor, uint16_t bgColor, int margin,
+                             RenderedText *pLast)
+{
+    // Save entry state.
+    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
+
+    // Determine if the length of the string is too long to fit within the
+    // normal screen width.  If so, change the text width to double the number
+    // of characters that will fit in the box.
+    int length = strlen(pStr);
+    int limit  = side == eAll ? (SCREEN_CHAR_WIDTH - 1) : (SCREEN_CHAR_WIDTH /2);
+
+    // Get ready to print the string.
+    int16_t cursorY = line * height() / 3 + 15;
+    setTextSize(length > limit ? 1 : 2, 3);
+    setCursor(margin, cursorY);
+
+    // If the text was last drawn the same length (so in the same place), only
+    // the characters that differ need to be drawn.  Otherwise display the data
+    // based on the type of box used.
+    if (DrawTextChanges(pStr, cursorY, fgColor, bgColor, pLast))
+    {
+        // Done.
+    }
+    else if (side == eAll)
+    {
+        DisplayHCenteredText(pStr, fgColor, bgColor, margin);
+        RememberText(pStr, cursorY, fgColor, bgColor, pLast);
+    }
+    else
+    {
+        DisplayCenteredHalf(pStr, side, fgColor, bgColor, margin);
+        RememberText(pStr, cursorY, fgColor, bgColor, pLast);
+    }
+
+    // Restore the entry state.
+    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
+} // End DisplayBoxMain().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayHVCenteredText()
+//
+// Displays a text string centered vertically and horizontally on the TFT
+// screen.
+//
+// Arguments:
+//    - pStr    - A pointer to the NULL terminated string to be displayed.
+//    - fgColor - Specifies the foreground color of the text being displayed.
+//    - bgColor - Specifies the background color of the text being displayed.
+//    - radius  - Radius in pixels for rounded containing box.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DisplayHVCenteredText(
+        const char *pStr, uint16_t fgColor, uint16_t bgColor, int radius)
+{
+    // Save entry state.
+    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
+
+    // Get the size of the string to be displayed.
+    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
+    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
+    uint16_t xl  = 0;   // X length of string in pixels.
+    uint16_t yl  = 0;   // Y height of string in pixels.
+    setTextSize(2, 2);
+    getTextBounds(pStr, 0, 0, &ulx, &uly, &xl, &yl);
+
+    // Determine the current screen size (can change in use).
+    int16_t screenWidth  = width();
+    int16_t screenHeight = height();
+
+    // Determine the coords to start printing the string.
+    uint16_t cursorX = (screenWidth - xl) / 2;
+    uint16_t cursorY = (screenHeight - yl) / 2;
+
+    // Display the text, centered on the display.
+    FillScreen(fgColor, bgColor, radius);
+
+    setTextColor(fgColor, bgColor);
+    setCursor(cursorX, cursorY);
+    print(pStr);
+    
+    // Repair the left side of the enclosing box in case the string contains
+    // any new line characters.
+    drawFastVLine(0, cursorY, yl - uly, fgColor);
+
+    // Restore the entry state.
+    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
+} // End DisplayHVCenteredText().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayHCenteredText()
+//
+// Displays a text string centered vertically on the TFT screen at the current
+// display line.
+//
+// Arguments:
+//    - pStr    - A pointer to the NULL terminated string to be displayed.
+//    - fgColor - Specifies the foreground color of the text being displayed.
+//    - bgColor - Specifies the background color of the text being displayed.
+//    - margin  - Specifies the left and right margin for the box in which the
+//                string will be displayed.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DisplayHCenteredText(
+        const char *pStr, uint16_t fgColor, uint16_t bgColor, int margin)
+{
+    // Save entry state.
+    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
+
+    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
+    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
+    uint16_t xl  = 0;   // X length of string in pixels.
+    uint16_t yl  = 0;   // Y height of string in pixels.
+
+    // Get the size of the string to be displayed.
+    getTextBounds(pStr, 0, 0, &ulx, &uly, &xl, &yl);
+
+    // Determine the current screen size (can change in use).
+    int16_t screenWidth = width();
+
+    // Determine the coords to start printing the string.
+    uint16_t cursorX = (screenWidth - xl) / 2;
+    uint16_t cursorY = getCursorY();
+
+    // Display the text, centered on the display.  Clear the line on both sides
+    // of the new string.
+    setTextColor(fgColor, bgColor);
+    setCursor(cursorX, cursorY);
+    fillRect(margin, cursorY, cursorX - margin, yl, bgColor);
+    fillRect(cursorX + xl, cursorY,
+             screenWidth - margin - (cursorX + xl), yl, bgColor);
+
+    print(pStr);
+
+    // Restore the entry state.
+    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
+} // End DisplayHCenteredText().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayCenteredHalf()
+//
+// Displays a text string centered vertically on the TFT screen at the current
+// display line.
+//
+// Arguments:
+//    - pStr    - A pointer to the NULL terminated string to be displayed.
+//    - side    - Side in which the string will be centered.  Legal values
+//                are LEFT_HALF or RIGHT_HALF.
+//    - fgColor - Specifies the foreground color of the text being displayed.
+//    - bgColor - Specifies the background color of the text being displayed.
+//    - margin  - Specifies the left and right margin for the box in which the
+//                string will be displayed.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DisplayCenteredHalf(
+        const char *pStr, BoxLocale side, uint16_t fgColor, uint16_t bgColor, int margin)
+{
+    // Save entry state.
+    DisplayState state(textsize_x, textsize_y, textcolor, textbgcolor);
+
+    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
+    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
+    uint16_t xl  = 0;   // X length of string in pixels.
+    uint16_t yl  = 0;   // Y height of string in pixels.
+
+    // Get the size of the string to be displayed.
+    getTextBounds(pStr, 0, 0, &ulx, &uly, &xl, &yl);
+
+    // Determine the current screen size (can change in use).
+    int16_t screenWidth  = width();
+
+    // Determine the coords to start printing the string.
+    uint16_t cursorX = (screenWidth / 2 - xl) / 2;
+    uint16_t cursorY = getCursorY();
+    uint16_t fieldX  = 0;
+    if (side == eRight)
+    {
+        cursorX += screenWidth / 2;
+        fieldX  = screenWidth / 2;
+    }
+
+    // Display the text, centered on the display.  Clear the line on both sides
+    // of the new string.
+    setTextColor(fgColor, bgColor);
+    setCursor(cursorX, cursorY);
+    fillRect(fieldX + margin, cursorY, cursorX - fieldX - margin, yl, bgColor);
+    fillRect(cursorX + xl, cursorY,
+             screenWidth / 2 - (cursorX - fieldX) - xl - margin, yl, bgColor);
+
+    print(pStr);
+
+    // Restore the entry state.
+    state.RestoreState(textsize_x, textsize_y, textcolor, textbgcolor);
+} // End DisplayCenteredHalf().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DrawTextChanges()
+//
+// Draws a string over the one last drawn in the same place, at the current
+// text size, by drawing only the characters that differ.  This is only
+// possible if the last string was drawn with the same size, line and colors,
+// and had the same length (so that centered text starts in the same place).
+// Characters are drawn with their background (fgColor != bgColor), so each
+// covers the one it replaces.
+//
+// Arguments:
+//    - pStr    - The string to be drawn.
+//    - y       - The Y coord it is to be drawn at.
+//    - fgColor - Its foreground color.
+//    - bgColor - Its background color.
+//    - pLast   - What was last drawn in its place, or NULL if not known.
+//
+// Returns:
+//    Returns 'true' if the string was drawn (pLast is updated), or 'false' if
+//    it must be drawn in full.
+/////////////////////////////////////////////////////////////////////////////////
+bool Display::DrawTextChanges(const char *pStr, int16_t y, uint16_t fgColor,
+                              uint16_t bgColor, RenderedText *pLast)
+{
+    if ((pLast == NULL) || (pLast->m_SizeX == 0U) || (gfxFont != NULL) ||
+        (pLast->m_SizeX != textsize_x) || (pLast->m_SizeY != textsize_y) ||
+        (pLast->m_Y != y) || (pLast->m_FgColor != fgColor) ||
+        (pLast->m_BgColor != bgColor) || (fgColor == bgColor) ||
+        (strlen(pStr) != strlen(pLast->m_Text)))
+    {
+        return false;
+    }
+
+    int16_t x = pLast->m_X;
+    for (size_t i = 0U; pStr[i] != '\0'; i++)
+    {
+        if (pStr[i] != pLast->m_Text[i])
+        {
+            drawChar(x, y, pStr[i], fgColor, bgColor, textsize_x, textsize_y);
+            pLast->m_Text[i] = pStr[i];
+        }
+        x += FONT_CHAR_WIDTH * textsize_x;
+    }
+    return true;
+} // End DrawTextChanges().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RememberText()
+//
+// Records a string that has just been printed in full, and so ends at the
+// cursor, for DrawTextChanges().
+//
+// Arguments:
+//    - pStr    - The string.
+//    - y       - The Y coord it was printed at.
+//    - fgColor - Its foreground color.
+//    - bgColor - Its background color.
+//    - pLast   - Where to record it, or NULL.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::RememberText(const char *pStr, int16_t y, uint16_t fgColor,
+                           uint16_t bgColor, RenderedText *pLast)
+{
+    if (pLast == NULL)
+    {
+        return;
+    }
+
+    // Strings that are too long, or that wrapped, are always drawn in full.
+    size_t length = strlen(pStr);
+    if ((length > RenderedText::MAX_LENGTH) || (getCursorY() != y))
+    {
+        pLast->Invalidate();
+        return;
+    }
+    memcpy(pLast->m_Text, pStr, length + 1);
+    pLast->m_X       = getCursorX() -
+                       static_cast<int16_t>(length) * FONT_CHAR_WIDTH * textsize_x;
+    pLast->m_Y       = y;
+    pLast->m_SizeX   = textsize_x;
+    pLast->m_SizeY   = textsize_y;
+    pLast->m_FgColor = fgColor;
+    pLast->m_BgColor = bgColor;
+} // End RememberText().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FillScreen()
+//
+// Fills the screen with a (possibly) outlined box with a given radius.
+//
+// Arguments:
+//    - fgColor - Specifies the outline color of the box.
+//    - bgColor - Specifies the background color of the box.
+//    - radius  - Radius in pixels for rounded box.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::FillScreen(uint16_t fgColor, uint16_t bgColor, int radius)
+{
+    // Remove any colors that may be past the rounded box corners.
+    if (radius)
+    {
+        fillScreen(ST7735_BLACK);
+    }
+    fillRoundRect(0, 0, width(), height(), radius, bgColor);
+    drawRoundRect(0, 0, width(), height(), radius, fgColor);
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+// BlinkCenteredDisplay()
+//
+// Blinks a text string centered vertically and horizontally on the TFT
+// screen.  Note that the string will blink at a rate of 500ms on and 500ms
+// off.
+//
+// Arguments:
+//    - pStr      - A pointer to the NULL terminated string to be displayed.
+//    - textColor - Specifies the foreground color of the text being displayed.
+//    - backColor - Specifies the background color of the text being displayed.
+//    - radius    - Radius in pixels for rounded containing box.
+//    - duration  - Duration in milliseconds to display the blinking string.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::BlinkCenteredDisplay(
+        const char *pStr, uint16_t textColor, uint16_t backColor, int radius,
+        uint32_t duration)
+{
+    const uint32_t BLINK_RATE = 500;
+
+    for (uint32_t i = 0; i < duration; i += 2 * BLINK_RATE)
+    {
+        DisplayHVCenteredText(pStr, textColor, backColor, radius);
+        delay(BLINK_RATE);
+
+        FillScreen(textColor, backColor, radius);
+        delay(BLINK_RATE);
+    }
+} // End BlinkCenteredDisplay().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayWorkingScreen()
+//
+// Displays the text "WORKING" centered horizontally and vertically on these
+// screen.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DisplayWorkingScreen()
+{
+    // Show the user that we're doing something.
+    DisplayHVCenteredText("WORKING", ST77XX_BLUE, ST77XX_WHITE, BOX_RADIUS);
+} // End DisplayWorkingScreen().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayResult()
+//
+// Displays a standardized results screen based on the status that is passed
+// to it.
+//
+// Arguments:
+//    - success  - Specifies the status to be displayed.  A value of 'true'
+//                 causes the 'goodStr' string to be displayed as a solid
+//                 (non-blinking) string centered vertically and horizontally
+//                 on the display.  A value of 'false' causes the 'badStr'
+//                 string to be displayed as a blinking string centered
+//                 vertically and horizontally on the screen.
+//    - pGoodStr - Specifies the string to be displayed when 'success' is
+//                 'true'.
+//    - pBadStr  - Specifies the string to be displayed when 'success' is
+//                 'false'.
+//    - radius   - The radius, in pixels, of the rounded corners of the box.
+//                 A value of zero will cause the box to have square corners.
+//    - duration - Duration in milliseconds to display the selected string.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::DisplayResult(
+        bool success, const char *pGoodStr, const char *pBadStr,
+        int radius, uint32_t duration)
+{
+    uint16_t backColor = ST77XX_GREEN;
+    uint16_t textColor = ST77XX_WHITE;
+
+    // Let the user know if we succeeded or failed.
+    if (success)
+    {
+        DisplayHVCenteredText(pGoodStr, textColor, backColor, radius);
+        delay(duration);
+    }
+    else
+    {
+        backColor = ST77XX_RED;
+        BlinkCenteredDisplay(pBadStr, textColor, backColor, radius, duration);
+    }
+} // End DisplayResult().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WelcomeScreen()
+//
+// Displays a welcome screen.
+//
+// Arguments:
+//    fgColor - Foreground color for the welcome screen.
+//    bgColor - Background color for the welcome screen.
+//    radius  - Radius for rounded box background.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::WelcomeScreen(uint16_t fgColor, uint16_t bgColor, int radius)
+{
+    // Make sure the backlight is on.  The NVS restore is performed later, and
+    // will set the backlight as the user wants, but we always want the welcome
+    // screen to display with 100% brightness.
+    SetBacklightPercent(100);
+
+    const char *pName = "JMC 3DP SCALE";
+    const uint32_t SCROLL_DWELL_MS = 10;
+
+    // Get ready to display the welcome screen.
+    setTextSize(2, 3);
+    setTextWrap(false);
+    FillScreen(fgColor, bgColor, radius);
+
+    // Display the scale graphic background.
+    drawBitmap((width() - 120) / 2, (height() - 120) / 2,
+                     ScaleIcon, 120, 120, 0);
+    delay(1000);
+
+    // Get the size of the string to be displayed.
+    int16_t  ulx = 0;   // Upper left X coord of string (pixels).
+    int16_t  uly = 0;   // Upper left Y coord of string (pixels).
+    uint16_t xl  = 0;   // X length of string in pixels.
+    uint16_t yl  = 0;   // Y height of string in pixels.
+    getTextBounds(pName, 0, 0, &ulx, &uly, &xl, &yl);
+
+    // Calculate where to place the string.
+    uint16_t cursorY = (height() - yl) / 2;
+    uint16_t xStop   = (width() - xl) / 2;
+
+    // Slowly scroll the string from the right side.
+    setTextColor(fgColor, bgColor);
+    for (int i = width() - 1; i >= xStop; i--)
+    {
+        setCursor(i, cursorY);
+        print(pName);
+        drawFastVLine(width() - 1, radius, height() - 2 * radius, fgColor);
+        delay(SCROLL_DWELL_MS);
+    }
+
+    // Wait a second before scrolling the footer.
+    delay(1000);
+    setTextSize(1);
+    const char *pFooter = "(c) 2021, J. M. Corbett";
+    getTextBounds(pFooter, 0, 0, &ulx, &uly, &xl, &yl);
+
+    // Calculate where to place the string.
+    cursorY = height() - 2 * yl;
+    xStop   = (width() - xl) / 2;
+
+    // Slowly scroll the string from the right side.
+    for (int i = width() - 1; i >= xStop; i--)
+    {
+        setCursor(i, cursorY);
+        print(pFooter);
+        drawFastVLine(width() - 1, radius, height() - 2 * radius, fgColor);
+        delay(SCROLL_DWELL_MS);
+    }
+} // End WelcomeScreen().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// EnableFrameBuffer()
+//
+// Starts or stops drawing into an off screen copy of the display.  The copy is
+// sized for the current rotation.  Enabling clears the display to black.
+//
+// Arguments:
+//    - enable - 'true' to use a frame buffer, 'false' to draw directly.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if there isn't enough memory
+//    (the display is then drawn directly).
+/////////////////////////////////////////////////////////////////////////////////
+bool Display::EnableFrameBuffer(bool enable)
+{
+    if (!enable)
+    {
+        // Let any send finish before the buffer goes away.
+        FbWait();
+        free(m_pFrameBuffer);
+        m_pFrameBuffer = NULL;
+        return true;
+    }
+    if (m_pFrameBuffer != NULL)
+    {
+        return true;
+    }
+
+    size_t pixels  = static_cast<size_t>(width()) * static_cast<size_t>(height());
+    m_pFrameBuffer = static_cast<uint16_t *>(malloc(pixels * sizeof(uint16_t)));
+    if (m_pFrameBuffer == NULL)
+    {
+        Serial.println("Display - no memory for a frame buffer.");
+        return false;
+    }
+    m_FbWidth    = width();
+    m_FbHeight   = height();
+    m_NumDirty   = 0U;
+    m_WriteDepth = 0U;
+    m_FrameDepth = 0U;
+
+#if defined ARDUINO_ARCH_ESP32
+    // The flush task sends frames while loop() carries on.  Without it frames
+    // are simply sent by EndFrame().
+    if (m_FlushDone == NULL)
+    {
+        m_FlushDone = xSemaphoreCreateBinary();
+    }
+    if ((m_FlushTask == NULL) && (m_FlushDone != NULL))
+    {
+        TaskHandle_t task = NULL;
+        if (xTaskCreatePinnedToCore(FlushTask, "Display", FLUSH_TASK_STACK_SIZE,
+                                    this, FLUSH_TASK_PRIORITY, &task,
+                                    FLUSH_TASK_CORE) == pdPASS)
+        {
+            m_FlushTask = task;
+        }
+        else
+        {
+            Serial.println("Display - flush task create failed.");
+        }
+    }
+#endif // ARDUINO_ARCH_ESP32
+
+    // Start with the copy and the panel the same.
+    fillScreen(ST7735_BLACK);
+    return true;
+} // End EnableFrameBuffer().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// BeginFrame(), EndFrame()
+//
+// Bracket a series of drawing operations that are to reach the panel
+// together.  The outermost EndFrame() sends the part of the frame buffer that
+// was drawn on.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::BeginFrame()
+{
+    if (m_pFrameBuffer != NULL)
+    {
+        m_FrameDepth++;
+    }
+} // End BeginFrame().
+
+
+void Display::EndFrame()
+{
+    if ((m_pFrameBuffer != NULL) && (m_FrameDepth > 0U) && (--m_FrameDepth == 0U))
+    {
+        FbSend();
+    }
+} // End EndFrame().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ScrollUp()
+//
+// Moves the full width band of the frame buffer between two rows up by a
+// number of pixels.  The rows that are uncovered at the bottom of the band are
+// left as they were.
+//
+// Arguments:
+//    - top    - First row of the band.
+//    - bottom - Row just past the band.
+//    - pixels - Distance to move it, less than its height.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if there is no frame buffer or
+//    the arguments are out of range.
+/////////////////////////////////////////////////////////////////////////////////
+bool Display::ScrollUp(int16_t top, int16_t bottom, int16_t pixels)
+{
+    if ((m_pFrameBuffer == NULL) || (top < 0) || (bottom > m_FbHeight) ||
+        (pixels <= 0) || (top + pixels >= bottom))
+    {
+        return false;
+    }
+
+    FbWait();
+    size_t rowBytes = static_cast<size_t>(m_FbWidth) * sizeof(uint16_t);
+    memmove(&m_pFrameBuffer[top * m_FbWidth],
+            &m_pFrameBuffer[(top + pixels) * m_FbWidth],
+            (bottom - top - pixels) * rowBytes);
+    FbDirty(0, top, m_FbWidth - 1, bottom - 1);
+    FbDrawn();
+    return true;
+} // End ScrollUp().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Drawing primitives.
+//
+// With a frame buffer these draw into it, and each outermost operation (or
+// the outermost endWrite()) sends what it drew unless a frame is in progress.
+// While a box mask is being built they draw into the mask.  Otherwise they
+// are passed to Adafruit_ST7735.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::startWrite()
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::startWrite();
+        return;
+    }
+    m_WriteDepth++;
+} // End startWrite().
+
+
+void Display::endWrite()
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::endWrite();
+        return;
+    }
+    if (m_WriteDepth > 0U)
+    {
+        m_WriteDepth--;
+    }
+    FbDrawn();
+} // End endWrite().
+
+
+void Display::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::drawPixel(x, y, color);
+        return;
+    }
+    FbFill(x, y, 1, 1, color);
+    FbDrawn();
+} // End drawPixel().
+
+
+void Display::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::writePixel(x, y, color);
+        return;
+    }
+    FbFill(x, y, 1, 1, color);
+    FbDrawn();
+} // End writePixel().
+
+
+void Display::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                            uint16_t color)
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::writeFillRect(x, y, w, h, color);
+        return;
+    }
+    FbFill(x, y, w, h, color);
+    FbDrawn();
+} // End writeFillRect().
+
+
+void Display::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::writeFastHLine(x, y, w, color);
+        return;
+    }
+    FbFill(x, y, w, 1, color);
+    FbDrawn();
+} // End writeFastHLine().
+
+
+void Display::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::writeFastVLine(x, y, h, color);
+        return;
+    }
+    FbFill(x, y, 1, h, color);
+    FbDrawn();
+} // End writeFastVLine().
+
+
+void Display::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                       uint16_t color)
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::fillRect(x, y, w, h, color);
+        return;
+    }
+    FbFill(x, y, w, h, color);
+    FbDrawn();
+} // End fillRect().
+
+
+void Display::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::drawFastHLine(x, y, w, color);
+        return;
+    }
+    FbFill(x, y, w, 1, color);
+    FbDrawn();
+} // End drawFastHLine().
+
+
+void Display::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    if (!DrawsOffScreen())
+    {
+        Adafruit_ST7735::drawFastVLine(x, y, h, color);
+        return;
+    }
+    FbFill(x, y, 1, h, color);
+    FbDrawn();
+} // End drawFastVLine().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FbFill()
+//
+// Fills a rectangle of the frame buffer, clipped to the screen, and adds it to
+// the part to be sent.  Waits for a send in progress first, since the flush
+// task reads the frame buffer.  While a box mask is being built, fills a
+// rectangle of the mask instead.
+//
+// Arguments:
+//    - x, y  - Upper left corner.
+//    - w, h  - Width and height.  Negative values extend up and left.
+//    - color - Fill color.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::FbFill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    int16_t width  = m_pCapture != NULL ? m_CaptureWidth  : m_FbWidth;
+    int16_t height = m_pCapture != NULL ? m_CaptureHeight : m_FbHeight;
+    int32_t x0 = x;
+    int32_t y0 = m_pCapture != NULL ? y : y + m_OffsetY;
+    int32_t x1 = x0 + w - 1;
+    int32_t y1 = y0 + h - 1;
+    if (w < 0)
+    {
+        x1 = x0;
+        x0 = x0 + w + 1;
+    }
+    if (h < 0)
+    {
+        y1 = y0;
+        y0 = y0 + h + 1;
+    }
+    x0 = x0 < 0 ? 0 : x0;
+    y0 = y0 < 0 ? 0 : y0;
+    x1 = x1 >= width  ? width  - 1 : x1;
+    y1 = y1 >= height ? height - 1 : y1;
+    if ((w == 0) || (h == 0) || (x0 > x1) || (y0 > y1))
+    {
+        return;
+    }
+
+    // Building a box mask?  The color is a MaskPixel.
+    if (m_pCapture != NULL)
+    {
+        for (int32_t row = y0; row <= y1; row++)
+        {
+            memset(&m_pCapture[row * width + x0], color, x1 - x0 + 1);
+        }
+        return;
+    }
+
+    FbWait();
+    for (int32_t row = y0; row <= y1; row++)
+    {
+        uint16_t *pPixel = &m_pFrameBuffer[row * m_FbWidth + x0];
+        for (int32_t col = x0; col <= x1; col++)
+        {
+            *pPixel++ = color;
+        }
+    }
+
+    FbDirty(x0, y0, x1, y1);
+} // End FbFill().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FbDirty()
+//
+// Adds a rectangle of the frame buffer to the part to be sent.  It is merged
+// with each dirty rectangle that is no cheaper to send apart from it.  If the
+// list is full it is merged with the one that grows least.
+//
+// Arguments:
+//    - x0, y0 - Upper left corner.
+//    - x1, y1 - Lower right corner (inclusive).
+/////////////////////////////////////////////////////////////////////////////////
+void Display::FbDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    FbRect rect = {x0, y0, x1, y1};
+
+    // Merging may make the rectangle worth merging with ones already passed,
+    // so start over after each merge.
+    size_t i = 0U;
+    while (i < m_NumDirty)
+    {
+        FbRect merged = RectUnion(rect, m_Dirty[i]);
+        if (RectArea(merged) <=
+            RectArea(rect) + RectArea(m_Dirty[i]) + WINDOW_COST_PIXELS)
+        {
+            rect = merged;
+            m_Dirty[i] = m_Dirty[--m_NumDirty];
+            i = 0U;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (m_NumDirty == MAX_DIRTY_RECTS)
+    {
+        size_t  best       = 0U;
+        int32_t bestGrowth = INT32_MAX;
+        for (i = 0U; i < m_NumDirty; i++)
+        {
+            int32_t growth = RectArea(RectUnion(rect, m_Dirty[i])) - RectArea(m_Dirty[i]);
+            if (growth < bestGrowth)
+            {
+                best       = i;
+                bestGrowth = growth;
+            }
+        }
+        rect = RectUnion(rect, m_Dirty[best]);
+        m_Dirty[best] = m_Dirty[--m_NumDirty];
+    }
+    m_Dirty[m_NumDirty++] = rect;
+} // End FbDirty().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RectUnion(), RectArea()
+//
+// The smallest rectangle holding two rectangles, and the pixels in one.
+/////////////////////////////////////////////////////////////////////////////////
+Display::FbRect Display::RectUnion(const FbRect &rA, const FbRect &rB)
+{
+    FbRect rect;
+    rect.m_X0 = (rA.m_X0 < rB.m_X0) ? rA.m_X0 : rB.m_X0;
+    rect.m_Y0 = (rA.m_Y0 < rB.m_Y0) ? rA.m_Y0 : rB.m_Y0;
+    rect.m_X1 = (rA.m_X1 > rB.m_X1) ? rA.m_X1 : rB.m_X1;
+    rect.m_Y1 = (rA.m_Y1 > rB.m_Y1) ? rA.m_Y1 : rB.m_Y1;
+    return rect;
+} // End RectUnion().
+
+
+int32_t Display::RectArea(const FbRect &rRect)
+{
+    return static_cast<int32_t>(rRect.m_X1 - rRect.m_X0 + 1) *
+           static_cast<int32_t>(rRect.m_Y1 - rRect.m_Y0 + 1);
+} // End RectArea().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FbDrawn()
+//
+// Called after each drawing operation.  Sends what has been drawn, now, unless
+// the operation is part of a larger one or of a frame.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::FbDrawn()
+{
+    if ((m_pCapture == NULL) && (m_WriteDepth == 0U) && (m_FrameDepth == 0U))
+    {
+        for (size_t i = 0U; i < m_NumDirty; i++)
+        {
+            FbPush(m_Dirty[i].m_X0, m_Dirty[i].m_Y0, m_Dirty[i].m_X1, m_Dirty[i].m_Y1);
+        }
+        m_NumDirty = 0U;
+    }
+} // End FbDrawn().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FbSend()
+//
+// Sends what has been drawn at the end of a frame: by the flush task if there
+// is one, otherwise now.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::FbSend()
+{
+    if (m_NumDirty == 0U)
+    {
+        return;
+    }
+
+    if (m_FlushTask == NULL)
+    {
+        for (size_t i = 0U; i < m_NumDirty; i++)
+        {
+            FbPush(m_Dirty[i].m_X0, m_Dirty[i].m_Y0, m_Dirty[i].m_X1, m_Dirty[i].m_Y1);
+        }
+    }
+    else
+    {
+        FbWait();
+        memcpy(m_Send, m_Dirty, m_NumDirty * sizeof(FbRect));
+        m_NumSend = m_NumDirty;
+        m_Sending = true;
+#if defined ARDUINO_ARCH_ESP32
+        xTaskNotifyGive(m_FlushTask);
+#endif // ARDUINO_ARCH_ESP32
+    }
+    m_NumDirty = 0U;
+} // End FbSend().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FbWait()
+//
+// Waits for the flush task to finish sending, if it is.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::FbWait()
+{
+    if (m_Sending)
+    {
+#if defined ARDUINO_ARCH_ESP32
+        xSemaphoreTake(m_FlushDone, portMAX_DELAY);
+#endif // ARDUINO_ARCH_ESP32
+        m_Sending = false;
+    }
+} // End FbWait().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FbPush()
+//
+// Sends a rectangle of the frame buffer to the panel.
+//
+// Arguments:
+//    - x0, y0 - Upper left corner.
+//    - x1, y1 - Lower right corner (inclusive).
+/////////////////////////////////////////////////////////////////////////////////
+void Display::FbPush(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    int16_t w = x1 - x0 + 1;
+    Adafruit_ST7735::startWrite();
+    setAddrWindow(x0, y0, w, y1 - y0 + 1);
+    for (int16_t row = y0; row <= y1; row++)
+    {
+        writePixels(&m_pFrameBuffer[row * m_FbWidth + x0], w);
+    }
+    Adafruit_ST7735::endWrite();
+} // End FbPush().
+
+
+#if defined ARDUINO_ARCH_ESP32
+/////////////////////////////////////////////////////////////////////////////////
+// FlushTask()
+//
+// Body of the background flush task.  Waits for FbSend() to hand it a list
+// of rectangles, sends them, then lets FbWait() know it's done.
+//
+// Arguments:
+//    - pArg - Pointer to the Display instance that owns the task.
+/////////////////////////////////////////////////////////////////////////////////
+void Display::FlushTask(void *pArg)
+{
+    Display *pThis = static_cast<Display *>(pArg);
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        for (size_t i = 0U; i < pThis->m_NumSend; i++)
+        {
+            const FbRect &rRect = pThis->m_Send[i];
+            pThis->FbPush(rRect.m_X0, rRect.m_Y0, rRect.m_X1, rRect.m_Y1);
+        }
+        xSemaphoreGive(pThis->m_FlushDone);
+    }
+} // End FlushTask().
+#endif // ARDUINO_ARCH_ESP32
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Save()
+//
+// Saves our current state to NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool Display::Save() const
+{
+    // NvsStore only writes our state if it has changed since it was restored
+    // or last saved, in order to conserve writes to NVS.
+    return (m_pName != NULL) &&
+           NvsStore::PutIfChanged(m_pName, pPrefSavedStateLabel,
+                                  &m_BacklightPercent, sizeof(uint32_t));
+ } // End Save().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Restore()
+//
+// Restores our state from NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool Display::Restore()
+{
+    // Assume we're gonna fail.
+    bool succeeded = false;
+
+    // Make sure we have a valid name.
+    if (m_pName != NULL)
+    {
+        // Restore our state data to a temporary structure.
+        uint32_t cachedState;
+        size_t restored =
+            NvsStore::GetTracked(m_pName, pPrefSavedStateLabel,
+                                 &cachedState, sizeof(uint32_t));
+
+        // Save the restored values only if the get was successful.
+        if (restored == sizeof(uint32_t))
+        {
+            SetBacklightPercent(cachedState);
+            succeeded = true;
+        }
+    }
+
+    // Let the caller know if we succeeded or failed.
+    return succeeded;
+ } // End Restore().
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Reset our state info in NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////
+bool Display::Reset()
+{
+    bool status = false;
+    if (m_pName != NULL)
+    {
+        // Remove our state data rom NVS.
+        status = NvsStore::Remove(m_pName, pPrefSavedStateLabel);
+    }
+    return status;
+} // End Reset().
+
+
@@ -0,0 +1,299 @@
+/////////////////////////////////////////////////////////////////////////////////
+// FilterPipeline.cpp
+//
+// Contains methods defined by the filter stage classes and the FilterPipeline
+// class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "FilterPipeline.h"     // For FilterPipeline class.
+#include <cmath>                // For lroundf().
+
+
+// Three point median and step detection, no low-pass.  The moving average
+// size is set separately.
+const FilterConfig FilterPipeline::DEFAULT_CONFIG = {3U, eLpNone, 1U};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MedianStage::SetSize()
+//
+// Sets the median window size.  The history is discarded if it changes.
+//
+// Arguments:
+//    - size - The new window size.  Limited to the range 1 to MAX_SIZE.
+//
+// Returns:
+//    Returns the (possibly limited) window size.
+/////////////////////////////////////////////////////////////////////////////////
+size_t MedianStage::SetSize(size_t size)
+{
+    if (size < 1U)
+    {
+        size = 1U;
+    }
+    else if (size > MAX_SIZE)
+    {
+        size = MAX_SIZE;
+    }
+
+    if (size != m_Size)
+    {
+        m_Size = size;
+        Reset();
+    }
+    return m_Size;
+} // End MedianStage::SetSize().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MedianStage::Process()
+//
+// Replaces the value with the median of the most recent values.  Until the
+// window fills, the median of the values received so far is used.
+/////////////////////////////////////////////////////////////////////////////////
+bool MedianStage::Process(int32_t &rValue)
+{
+    // Save the value, replacing the oldest once the window is full.
+    m_Values[m_Next] = rValue;
+    if (++m_Next >= m_Size)
+    {
+        m_Next = 0U;
+    }
+    if (m_NumValues < m_Size)
+    {
+        m_NumValues++;
+    }
+
+    // Insertion sort a copy.  The window is tiny, so this is cheaper than
+    // anything clever.
+    int32_t sorted[MAX_SIZE];
+    for (size_t i = 0U; i < m_NumValues; i++)
+    {
+        int32_t v = m_Values[i];
+        size_t  j = i;
+        while ((j > 0U) && (sorted[j - 1U] > v))
+        {
+            sorted[j] = sorted[j - 1U];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    rValue = sorted[m_NumValues / 2U];
+    return false;
+} // End MedianStage::Process().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// IirStage::Process()
+//
+// Low-pass filters the value.  The first value after a reset is passed
+// through unchanged and seeds the filter.
+/////////////////////////////////////////////////////////////////////////////////
+bool IirStage::Process(int32_t &rValue)
+{
+    int64_t x = static_cast<int64_t>(rValue) << FRACTION_BITS;
+    if (!m_Primed)
+    {
+        m_State  = x;
+        m_Primed = true;
+    }
+    else
+    {
+        m_State += (x - m_State) >> m_Shift;
+    }
+
+    // Round back to whole counts.
+    rValue = static_cast<int32_t>(
+                (m_State + (1LL << (FRACTION_BITS - 1U))) >> FRACTION_BITS);
+    return false;
+} // End IirStage::Process().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// KalmanStage::Process()
+//
+// Updates the weight estimate with the new measurement.  The first value
+// after a reset seeds the estimate.
+/////////////////////////////////////////////////////////////////////////////////
+bool KalmanStage::Process(int32_t &rValue)
+{
+    float z = static_cast<float>(rValue);
+    if (!m_Primed)
+    {
+        m_Estimate        = z;
+        m_ErrorCovariance = m_MeasurementNoise;
+        m_Primed          = true;
+    }
+    else
+    {
+        // Predict.  The weight is modelled as constant, so only the error
+        // grows.
+        m_ErrorCovariance += m_ProcessNoise;
+
+        // Correct.
+        float gain = m_ErrorCovariance / (m_ErrorCovariance + m_MeasurementNoise);
+        m_Estimate        += gain * (z - m_Estimate);
+        m_ErrorCovariance *= 1.0f - gain;
+    }
+
+    rValue = static_cast<int32_t>(lroundf(m_Estimate));
+    return false;
+} // End KalmanStage::Process().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// StepStage::Process()
+//
+// Checks the value for a step change in weight.  The value itself is passed
+// through unchanged.
+/////////////////////////////////////////////////////////////////////////////////
+bool StepStage::Process(int32_t &rValue)
+{
+    bool step = false;
+
+    if (!m_Primed)
+    {
+        m_Reference = rValue;
+        m_Count     = 0U;
+        m_Primed    = true;
+    }
+    else
+    {
+        int32_t delta = rValue - m_Reference;
+        if ((delta > m_Threshold) || (delta < -m_Threshold))
+        {
+            // Far from the reference.  Only believe it once it persists.
+            if (++m_Count >= CONFIRM_COUNT)
+            {
+                m_Reference = rValue;
+                m_Count     = 0U;
+                step        = true;
+            }
+        }
+        else
+        {
+            // Close to the reference.  Follow slow drift so that it is not
+            // mistaken for a step.
+            m_Count      = 0U;
+            m_Reference += delta >> TRACK_SHIFT;
+        }
+    }
+
+    return step;
+} // End StepStage::Process().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - averageSize - Initial size of the moving average.
+/////////////////////////////////////////////////////////////////////////////////
+FilterPipeline::FilterPipeline(size_t averageSize) :
+    m_Config(DEFAULT_CONFIG), m_Median(), m_Step(), m_Iir(), m_Kalman(),
+    m_Average(averageSize), m_NumStages(0U), m_Output(0L), m_HasOutput(false)
+{
+    Configure(DEFAULT_CONFIG);
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Configure()
+//
+// Selects the stages to run.  All history is discarded.
+//
+// Arguments:
+//    - config - The stages to be used.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if any field of 'config' was out
+//    of range.  The configuration is not changed on failure.
+/////////////////////////////////////////////////////////////////////////////////
+bool FilterPipeline::Configure(const FilterConfig &config)
+{
+    // Median windows must be odd so that there is a single middle value.
+    if ((config.m_MedianSize < 1U) ||
+        (config.m_MedianSize > MedianStage::MAX_SIZE) ||
+        ((config.m_MedianSize & 1U) == 0U) ||
+        (config.m_LowPass >= eLpNumTypes))
+    {
+        return false;
+    }
+    m_Config = config;
+
+    // Build the list of stages in processing order.
+    m_NumStages = 0U;
+    if (m_Config.m_MedianSize > 1U)
+    {
+        m_Median.SetSize(m_Config.m_MedianSize);
+        m_pStages[m_NumStages++] = &m_Median;
+    }
+    if (m_Config.m_StepDetect)
+    {
+        m_pStages[m_NumStages++] = &m_Step;
+    }
+    if (m_Config.m_LowPass == eLpIir)
+    {
+        m_pStages[m_NumStages++] = &m_Iir;
+    }
+    else if (m_Config.m_LowPass == eLpKalman)
+    {
+        m_pStages[m_NumStages++] = &m_Kalman;
+    }
+    m_pStages[m_NumStages++] = &m_Average;
+
+    Reset();
+    return true;
+} // End Configure().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Process()
+//
+// Runs a single raw value through the enabled stages.  If a stage reports a
+// step, every stage after it is reset before it sees the value.
+//
+// Arguments:
+//    - value - The raw value.
+//
+// Returns:
+//    Returns the filtered value.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t FilterPipeline::Process(int32_t value)
+{
+    bool restart = false;
+    for (size_t i = 0U; i < m_NumStages; i++)
+    {
+        if (restart)
+        {
+            m_pStages[i]->Reset();
+        }
+        restart = m_pStages[i]->Process(value) || restart;
+    }
+
+    m_Output    = value;
+    m_HasOutput = true;
+    return m_Output;
+} // End Process().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Discards the history of every stage.
+/////////////////////////////////////////////////////////////////////////////////
+void FilterPipeline::Reset()
+{
+    m_Median.Reset();
+    m_Step.Reset();
+    m_Iir.Reset();
+    m_Kalman.Reset();
+    m_Average.Reset();
+    m_HasOutput = false;
+} // End Reset().
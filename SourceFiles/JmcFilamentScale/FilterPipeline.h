@@ -0,0 +1,340 @@
+/////////////////////////////////////////////////////////////////////////////////
+// FilterPipeline.h
+//
+// This file defines the FilterStage interface, the filter stages that are
+// available to the LoadCell, and the FilterPipeline class that runs them.
+// Each raw HX711 conversion is passed through the enabled stages in order:
+//    1. MedianStage  - Median of the last N conversions.  Rejects the short
+//                      spikes caused by bumping the spool.
+//    2. StepStage    - Detects a real change in weight (e.g. a spool swap)
+//                      and restarts the stages that follow so that they
+//                      settle on the new weight right away.
+//    3. IirStage or  - Exponential (single pole IIR) low-pass, or a one
+//       KalmanStage    dimensional Kalman filter.
+//    4. AverageStage - The original moving average.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined FILTERPIPELINE_H
+#define FILTERPIPELINE_H
+
+#include <cstddef>              // For size_t.
+#include <cstdint>              // For int32_t, ...
+#include "MovingAverage.h"      // For MovingAverage class.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Low-pass filter selections.
+/////////////////////////////////////////////////////////////////////////////////
+enum LowPassType
+{
+    eLpNone     = 0,        // No low-pass stage.
+    eLpIir      = 1,        // Exponential (IIR) low-pass.
+    eLpKalman   = 2,        // Kalman filter.
+    eLpNumTypes = 3         // Number of low-pass types.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FilterConfig structure
+//
+// Selects the optional stages of a FilterPipeline.  Kept small and free of
+// pointers so that it may be saved to NVS as is.
+/////////////////////////////////////////////////////////////////////////////////
+struct FilterConfig
+{
+    uint8_t m_MedianSize;               // Median window, 1 disables the stage.
+    uint8_t m_LowPass;                  // A LowPassType value.
+    uint8_t m_StepDetect;               // Non-zero enables step detection.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FilterStage class
+//
+// Abstract interface implemented by each filter stage.
+/////////////////////////////////////////////////////////////////////////////////
+class FilterStage
+{
+public:
+    // Destructor.
+    virtual ~FilterStage() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Process()
+    //
+    // Filters a single value.
+    //
+    // Arguments:
+    //    - rValue - On entry, the value to be filtered.  On return, the value
+    //               to be passed on to the next stage.
+    //
+    // Returns:
+    //    Returns 'true' if the stages that follow this one should discard
+    //    their history (a step was detected), or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool Process(int32_t &rValue) = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // Discards all history.  The next value processed starts the stage over.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual void Reset() = 0;
+
+}; // End class FilterStage.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MedianStage class
+//
+// Outputs the median of the last 'size' values.  A spike lasting less than
+// half of the window never reaches the output.
+/////////////////////////////////////////////////////////////////////////////////
+class MedianStage : public FilterStage
+{
+public:
+    MedianStage(size_t size = MAX_SIZE) : m_Size(1), m_NumValues(0), m_Next(0)
+    {
+        SetSize(size);
+    }
+
+    bool   Process(int32_t &rValue);
+    void   Reset()          { m_NumValues = 0; m_Next = 0; }
+    size_t SetSize(size_t size);
+    size_t Size() const     { return m_Size; }
+
+    static const size_t MAX_SIZE = 7U;  // Largest median window.
+
+private:
+    int32_t m_Values[MAX_SIZE];         // Most recent values (circular).
+    size_t  m_Size;                     // Window size.
+    size_t  m_NumValues;                // Number of valid entries in m_Values.
+    size_t  m_Next;                     // Index of the next entry to replace.
+
+}; // End class MedianStage.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// IirStage class
+//
+// Single pole low-pass:  y += (x - y) / 2^shift.  The state is kept in fixed
+// point with FRACTION_BITS fractional bits so that small changes are not
+// lost to truncation.
+/////////////////////////////////////////////////////////////////////////////////
+class IirStage : public FilterStage
+{
+public:
+    IirStage(uint8_t shift = DEFAULT_SHIFT) :
+        m_Shift(shift), m_State(0), m_Primed(false) { }
+
+    bool Process(int32_t &rValue);
+    void Reset()                { m_Primed = false; }
+    void SetShift(uint8_t shift){ m_Shift = shift; }
+
+    static const uint8_t DEFAULT_SHIFT = 2U;    // Alpha = 1/4.
+
+private:
+    static const uint8_t FRACTION_BITS = 8U;
+
+    uint8_t m_Shift;                    // Alpha = 1 / 2^m_Shift.
+    int64_t m_State;                    // Filter output in fixed point.
+    bool    m_Primed;                   // False until the first value.
+
+}; // End class IirStage.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// KalmanStage class
+//
+// One dimensional Kalman filter for a (nearly) constant weight.  The gain
+// adapts to the ratio of the process and measurement noise.  Float is used
+// since the ESP32 has a single precision FPU, and its 24-bit mantissa holds
+// a full HX711 conversion.
+/////////////////////////////////////////////////////////////////////////////////
+class KalmanStage : public FilterStage
+{
+public:
+    KalmanStage(float processNoise = DEFAULT_PROCESS_NOISE,
+                float measurementNoise = DEFAULT_MEASUREMENT_NOISE) :
+        m_ProcessNoise(processNoise), m_MeasurementNoise(measurementNoise),
+        m_Estimate(0.0f), m_ErrorCovariance(0.0f), m_Primed(false) { }
+
+    bool Process(int32_t &rValue);
+    void Reset()                { m_Primed = false; }
+
+    // Variances, in raw counts squared.
+    static constexpr float DEFAULT_PROCESS_NOISE     = 4.0f;
+    static constexpr float DEFAULT_MEASUREMENT_NOISE = 900.0f;
+
+private:
+    float m_ProcessNoise;               // Q - How much the weight may wander.
+    float m_MeasurementNoise;           // R - HX711 noise.
+    float m_Estimate;                   // Current estimate.
+    float m_ErrorCovariance;            // P - Error of the current estimate.
+    bool  m_Primed;                     // False until the first value.
+
+}; // End class KalmanStage.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// StepStage class
+//
+// Passes values through unchanged while tracking a slow moving reference.
+// When CONFIRM_COUNT values in a row differ from the reference by more than
+// the threshold, the weight is assumed to have really changed.  The
+// reference jumps to the new value and the stages that follow are told to
+// start over, so they settle on the new weight without dragging the old one
+// along.
+/////////////////////////////////////////////////////////////////////////////////
+class StepStage : public FilterStage
+{
+public:
+    StepStage(int32_t threshold = DEFAULT_THRESHOLD) :
+        m_Threshold(threshold), m_Reference(0), m_Count(0), m_Primed(false) { }
+
+    bool Process(int32_t &rValue);
+    void Reset()                        { m_Count = 0; m_Primed = false; }
+    void SetThreshold(int32_t threshold){ m_Threshold = threshold; }
+    int32_t GetThreshold() const        { return m_Threshold; }
+
+    static const int32_t DEFAULT_THRESHOLD = 2000L; // Raw counts.
+
+private:
+    static const uint8_t CONFIRM_COUNT = 2U;    // Values needed to confirm.
+    static const uint8_t TRACK_SHIFT   = 3U;    // Reference tracking rate.
+
+    int32_t m_Threshold;                // Step size, in raw counts.
+    int32_t m_Reference;                // Slow moving reference value.
+    uint8_t m_Count;                    // Consecutive values past threshold.
+    bool    m_Primed;                   // False until the first value.
+
+}; // End class StepStage.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AverageStage class
+//
+// Moving average of the last 'size' values.
+/////////////////////////////////////////////////////////////////////////////////
+class AverageStage : public FilterStage
+{
+public:
+    AverageStage(size_t size) : m_Average(size) { }
+
+    bool Process(int32_t &rValue)
+    {
+        m_Average.Add(rValue);
+        rValue = m_Average.Average();
+        return false;
+    }
+    void   Reset()                  { m_Average.Reset(); }
+    size_t SetSize(size_t size)     { return m_Average.SetSize(size); }
+    size_t Size() const             { return m_Average.Size(); }
+
+    // Largest moving average window.  Must be a power of 2.
+    static const size_t CAPACITY = 64U;
+
+private:
+    MovingAverage<int32_t, int64_t, CAPACITY> m_Average;
+
+}; // End class AverageStage.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FilterPipeline class
+//
+// Owns one of each stage, and runs the ones selected by a FilterConfig.  The
+// moving average stage is always last.  No memory is allocated.
+/////////////////////////////////////////////////////////////////////////////////
+class FilterPipeline
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - averageSize - Initial size of the moving average.
+    /////////////////////////////////////////////////////////////////////////////
+    FilterPipeline(size_t averageSize);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Configure()
+    //
+    // Selects the stages to run.  All history is discarded.
+    //
+    // Arguments:
+    //    - config - The stages to be used.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if any field of 'config' was
+    //    out of range.  The configuration is not changed on failure.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Configure(const FilterConfig &config);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Process()
+    //
+    // Runs a single raw value through the enabled stages.
+    //
+    // Arguments:
+    //    - value - The raw value.
+    //
+    // Returns:
+    //    Returns the filtered value.  This is also available from Output().
+    /////////////////////////////////////////////////////////////////////////////
+    int32_t Process(int32_t value);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // Discards the history of every stage.
+    /////////////////////////////////////////////////////////////////////////////
+    void Reset();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters and setters.
+    /////////////////////////////////////////////////////////////////////////////
+    const FilterConfig &GetConfig() const   { return m_Config; }
+    bool    HasOutput() const               { return m_HasOutput; }
+    int32_t Output() const                  { return m_Output; }
+    size_t  SetAverageSize(size_t size)     { return m_Average.SetSize(size); }
+    size_t  GetAverageSize() const          { return m_Average.Size(); }
+    void    SetStepThreshold(int32_t counts){ m_Step.SetThreshold(counts); }
+
+    static const FilterConfig DEFAULT_CONFIG;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    FilterPipeline();
+    FilterPipeline(FilterPipeline &rFp);
+    FilterPipeline &operator=(FilterPipeline &rFp);
+
+    static const size_t MAX_STAGES = 4U;
+
+    FilterConfig  m_Config;             // Current configuration.
+    MedianStage   m_Median;             // Outlier rejection.
+    StepStage     m_Step;               // Step detection.
+    IirStage      m_Iir;                // Exponential low-pass.
+    KalmanStage   m_Kalman;             // Kalman low-pass.
+    AverageStage  m_Average;            // Moving average.
+    FilterStage  *m_pStages[MAX_STAGES];// Enabled stages, in order.
+    size_t        m_NumStages;          // Number of entries in m_pStages.
+    int32_t       m_Output;             // Most recent output.
+    bool          m_HasOutput;          // False until a value is processed.
+
+}; // End class FilterPipeline.
+
+
+
+#endif // FILTERPIPELINE_H
@@ -0,0 +1,91 @@
+/////////////////////////////////////////////////////////////////////////////////
+// FixedScale.cpp
+//
+// Contains methods defined by the FixedScale class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "FixedScale.h"         // For FixedScale class.
+#include <cmath>                // For ceil(), ldexp(), llround(), ...
+
+
+const int32_t FixedScale::POWERS_OF_10[MAX_DECIMALS + 1U] =
+    {1L, 10L, 100L, 1000L, 10000L, 100000L, 1000000L};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+/////////////////////////////////////////////////////////////////////////////////
+FixedScale::FixedScale() :
+    m_Multiplier(0LL), m_Offset(0LL), m_Rounding(0LL), m_Shift(0U),
+    m_Decimals(0U), m_IsConfigured(false)
+{
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Configure()
+//
+// Works out the Q-format multiplier and offset, using the most fraction bits
+// that keep both within their limits.
+//
+// Arguments:
+//    - factor   - Display units per input LSB.  Must not be 0.
+//    - offset   - Subtracted after scaling, in display units.
+//    - decimals - Decimal places to keep, 0 to MAX_DECIMALS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if an argument is out of range.
+/////////////////////////////////////////////////////////////////////////////////
+bool FixedScale::Configure(double factor, double offset, uint8_t decimals)
+{
+    m_IsConfigured = false;
+    if ((decimals > MAX_DECIMALS) || !std::isfinite(factor) ||
+        !std::isfinite(offset) || (factor == 0.0d))
+    {
+        return false;
+    }
+
+    // Scale to display LSBs, then find the shift.
+    const double lsbFactor = factor * POWERS_OF_10[decimals];
+    const double lsbOffset = offset * POWERS_OF_10[decimals];
+    int shift = MAX_SHIFT;
+    while ((shift >= 0) &&
+           ((fabs(ldexp(lsbFactor, shift)) >= MAX_MULTIPLIER) ||
+            (fabs(ldexp(lsbOffset, shift)) >= MAX_OFFSET)))
+    {
+        shift--;
+    }
+    if (shift < 0)
+    {
+        return false;
+    }
+
+    m_Multiplier   = llround(ldexp(lsbFactor, shift));
+    m_Offset       = llround(ldexp(lsbOffset, shift));
+    m_Shift        = static_cast<uint8_t>(shift);
+    m_Rounding     = (1LL << m_Shift) - 1LL;
+    m_Decimals     = decimals;
+    m_IsConfigured = m_Multiplier != 0LL;
+    return m_IsConfigured;
+} // End Configure().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Quantize()
+//
+// Converts a value in display units to display LSBs, rounding up as Apply()
+// does.
+//
+// Arguments:
+//    - value    - The value in display units.
+//    - decimals - Decimal places to keep, 0 to MAX_DECIMALS.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t FixedScale::Quantize(double value, uint8_t decimals)
+{
+    return static_cast<int32_t>(ceil(value * POWERS_OF_10[Limit(decimals)]));
+} // End Quantize().
@@ -0,0 +1,164 @@
+/////////////////////////////////////////////////////////////////////////////////
+// FixedScale.h
+//
+// This class implements the FixedScale class.  It converts an integer reading
+// to display units rounded to a number of decimal places, without any floating
+// point arithmetic.  The ESP32 has no double precision FPU, so the double
+// multiply, pow() and ceil() of the floating point path all run in software.
+//
+// The result is an integer count of display LSBs (10^-decimals units):
+//    result = ceil((value * factor - offset) * 10^decimals)
+// which is computed as
+//    result = ceil((value * m_Multiplier - m_Offset) / 2^m_Shift)
+// where m_Multiplier and m_Offset are Q-format (m_Shift fraction bits) values
+// worked out once by Configure(), i.e. when the calibration or units change.
+// The shift is chosen as large as possible, so the result matches the floating
+// point result to within one LSB (and almost always exactly).
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined FIXEDSCALE_H
+#define FIXEDSCALE_H
+
+#include <cstdint>              // For int32_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FixedScale class
+/////////////////////////////////////////////////////////////////////////////////
+class FixedScale
+{
+public:
+    // Constructor.  Not usable until Configure() succeeds.
+    FixedScale();
+
+
+    // Destructor.
+    virtual ~FixedScale() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Configure()
+    //
+    // Works out the Q-format multiplier and offset.
+    //
+    // Arguments:
+    //    - factor   - Display units per input LSB.  Must not be 0.
+    //    - offset   - Subtracted after scaling, in display units.
+    //    - decimals - Decimal places to keep, 0 to MAX_DECIMALS.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if an argument is out of
+    //    range (the scale is then left unconfigured).
+    /////////////////////////////////////////////////////////////////////////////
+    bool Configure(double factor, double offset, uint8_t decimals);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Apply()
+    //
+    // Scales a reading.  Must only be called once configured.
+    //
+    // Arguments:
+    //    - value - The reading, in input LSBs.  Must be within +/-INPUT_LIMIT.
+    //
+    // Returns:
+    //    Returns the scaled value in display LSBs, rounded up.
+    /////////////////////////////////////////////////////////////////////////////
+    int32_t Apply(int64_t value) const
+    {
+        // The shift is arithmetic for negative values, so this rounds up.
+        return static_cast<int32_t>(
+            (value * m_Multiplier - m_Offset + m_Rounding) >> m_Shift);
+    }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Quantize()
+    //
+    // The floating point equivalent of Apply(), for readings that can't take
+    // the fixed point path.
+    //
+    // Arguments:
+    //    - value    - The value in display units.
+    //    - decimals - Decimal places to keep, 0 to MAX_DECIMALS.
+    //
+    // Returns:
+    //    Returns the value in display LSBs, rounded up.
+    /////////////////////////////////////////////////////////////////////////////
+    static int32_t Quantize(double value, uint8_t decimals);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // ToFloat()
+    //
+    // Converts display LSBs back to display units for showing.  Uses single
+    // precision, which the ESP32 FPU does handle.
+    //
+    // Arguments:
+    //    - value    - The value in display LSBs.
+    //    - decimals - Its decimal places, 0 to MAX_DECIMALS.
+    /////////////////////////////////////////////////////////////////////////////
+    static float ToFloat(int32_t value, uint8_t decimals)
+    {
+        return static_cast<float>(value) /
+               static_cast<float>(POWERS_OF_10[Limit(decimals)]);
+    }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters and setters.
+    /////////////////////////////////////////////////////////////////////////////
+    void     Invalidate()               { m_IsConfigured = false; }
+    bool     IsConfigured()       const { return m_IsConfigured; }
+    uint8_t  GetDecimals()        const { return m_Decimals; }
+    uint8_t  GetShift()           const { return m_Shift; }
+    int64_t  GetMultiplier()      const { return m_Multiplier; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint8_t MAX_DECIMALS = 6U;
+    static const int64_t INPUT_LIMIT  = 1LL << 32;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    FixedScale(FixedScale &rFs);
+    FixedScale &operator=(FixedScale &rFs);
+
+
+    // Clamps a decimal places value.
+    static uint8_t Limit(uint8_t decimals)
+        { return (decimals > MAX_DECIMALS) ? MAX_DECIMALS : decimals; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Private constants.  The limits keep value * m_Multiplier - m_Offset
+    // within 2^62 for any value within INPUT_LIMIT.
+    /////////////////////////////////////////////////////////////////////////////
+    static const int32_t POWERS_OF_10[MAX_DECIMALS + 1U];
+    static const int64_t MAX_MULTIPLIER = 1LL << 29;
+    static const int64_t MAX_OFFSET     = 1LL << 61;
+    static const uint8_t MAX_SHIFT      = 61U;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    int64_t  m_Multiplier;              // factor * 10^decimals, Q m_Shift.
+    int64_t  m_Offset;                  // offset * 10^decimals, Q m_Shift.
+    int64_t  m_Rounding;                // 2^m_Shift - 1, to round up.
+    uint8_t  m_Shift;                   // Fraction bits.
+    uint8_t  m_Decimals;                // Decimal places kept.
+    bool     m_IsConfigured;            // Configure() succeeded.
+
+}; // End class FixedScale.
+
+
+
+#endif // FIXEDSCALE_H
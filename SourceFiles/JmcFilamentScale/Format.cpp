@@ -0,0 +1,163 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Format.cpp
+//
+// Contains the number formatting functions shared by the display, menu and web
+// code.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>                // For pow().
+#include <cstdio>               // For snprintf().
+#include <cstring>              // For strchr(), strlen(), strcpy().
+#include "Format.h"             // Our own declarations.
+#include "JmcFilamentScale.h"   // For gLoadCell.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetWeightDecimalPlaces()
+//
+// Returns the number of digits to display to the right of the decimal point
+// based on the currently selected weight units.
+/////////////////////////////////////////////////////////////////////////////////
+int GetWeightDecimalPlaces()
+{
+    int decimalPlaces = 1;
+    switch(gLoadCell.GetUnits())
+    {
+    case eWuGrams:     decimalPlaces = 1; break;
+    case eWuKiloGrams: decimalPlaces = 4; break;
+    case eWuOunces:    decimalPlaces = 2; break;
+    case eWuPounds:    decimalPlaces = 3; break;
+    default:           decimalPlaces = 1; break;
+    }
+    return decimalPlaces;
+} // End GetWeightDecimalPlaces().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddCommas()
+//
+// Takes a double value as input, and converts it to a string containing commas
+// separating the thousands places.  For example, if a vlaue of 123456.789 is
+// passed in with a precision of 2, the resultant converted string will be
+// "123,456.78".
+//
+// Arguments:
+//  - val     - This is the double value to be converted.
+//  - prec    - Specifies the precision of the converted string.  That is, it
+//              specifies the number of digits to the right of the decimal
+//              point in the returned string.
+//  - pBuf    - Specifies the buffer in which the result will be returned.
+//  - bufSize - Specifies the size of 'pBuf'.
+//
+//  Returns:
+//      Always returns 'pBuf'.  It is possible that the converted string will not
+//      fit within 'pBuf'.  In this case, the most significant digits of the
+//      converted string will be truncated, so beware and be sure to supply
+//      a buffer that is large enough to hold the converted string.
+/////////////////////////////////////////////////////////////////////////////////
+char *AddCommas(double val, int prec, char *pBuf, int bufSize)
+{
+    const char THOUSANDS_SEPARATOR = ',';
+    const char DECIMAL_POINT       = '.';
+    const size_t MAX_FORMATTED_NUMBER_SIZE = 30;
+    char temp[MAX_FORMATTED_NUMBER_SIZE];
+
+    // If the caller supplied a buffer, start with an empty string.
+    if (pBuf)
+    {
+        *pBuf = '\0';
+    }
+
+    // Validate our arguments.  Make sure:
+    // - the caller's buffer exists;
+    // - the caller's buffer is at least big enough for the smallest possible string;
+    // - our temporary buffer is at least big enough for the smallest possible string.
+    // If not, just return.
+    if ((pBuf == NULL) || (prec > static_cast<int>(MAX_FORMATTED_NUMBER_SIZE - 3)) || (bufSize < 3))
+    {
+        return pBuf;
+    }
+
+    // Round value to the given precision.
+    double roundVal = ((val > 0.0) ? 0.5 : -0.5);
+    val += (roundVal * pow(10.0, -prec));
+
+    // Convert the rounded value to a string.
+    snprintf(temp, MAX_FORMATTED_NUMBER_SIZE, "%f", val);
+
+    // Look for a decimal point.
+    char *pDot = strchr(temp, DECIMAL_POINT);
+    char *pSrc;
+    char *pDst;
+    if (pDot)   // A decimal point was found.
+    {
+        // Since the builtin version of printf() does not support variable
+        // precision, we need to handle it ourselves.  Here we check to see
+        // how many digits are past the decimal point, and clip to the specified
+        // precision if needed.
+        int dotLen = strlen(pDot);
+
+        // Special case when prec is 0.  Remove decimal point.  I.e. display as int.
+        if (prec == 0)
+        {
+            dotLen = 0;
+            *pDot = '\0';
+        }
+        else if (dotLen > prec)
+        {
+            pDot[prec + 1] = '\0';
+            dotLen = prec + 1;
+        }
+
+        pDst = pBuf + bufSize - dotLen - 1; // Set pDst to allow the fractional part to fit.
+        strcpy(pDst, pDot);                 // Copy the fractional part.
+        *pDot = '\0';                       // Cut the fractional part in temp.
+        pSrc = --pDot;                      // Point to the last non fractional char in temp.
+        pDst--;                             // Point to the previous char in pDst.
+    }
+    else    // No decimal point was found.
+    {
+        pSrc = temp + strlen(temp) - 1;     // pSrc is last char of our float string.
+        pDst = pBuf + bufSize - 1;          // pDst is last char of the caller's buffer.
+    }
+
+    int len = strlen(temp); // Initialize the mantissa size.
+    int digitCount = 0;     // Initialize the digit counter.
+
+    do
+    {
+        // Count digits (and digits only).
+        if ((*pSrc <= '9') && (*pSrc >= '0'))
+        {
+            // Add thousands separator if we added 3 digits already.
+            if (digitCount && !(digitCount % 3))
+            {
+                *pDst-- = THOUSANDS_SEPARATOR;
+            }
+            // Increment the mantissa digit count.
+            digitCount++;
+        }
+        // Copy this digit and point to the next.
+        *pDst-- = *pSrc--;
+
+      // Finish if we run out of mantissa characters, or if we fill the caller's buffer.
+    } while (--len && ((pDst - pBuf) >= 0));
+
+    // Move the converted value string to the start of the caller's buffer.
+    // Note that this move depends on strcpy() starting its copy at the lowest
+    // address and continuing toward the end of the buffer.  If this is not the
+    // case, then it is possible that the string data could get corrupted.
+    if ((pDst + 1) != pBuf)
+    {
+        // Move the string.
+        strcpy(pBuf, pDst + 1);
+    }
+
+    // Return a pointer to the user's buffer.
+    return pBuf;
+} // End AddCommas().
@@ -0,0 +1,21 @@
+/////////////////////////////////////////////////////////////////////////////////
+// Format.h
+//
+// Declares the number formatting functions shared by the display, menu and web
+// code.  They live in their own file, rather than in JmcFilamentScale.ino, so
+// that the host build uses the same code as the sketch.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined FORMAT_H
+#define FORMAT_H
+
+
+char *AddCommas(double val, int prec, char *pBuf, int bufSize);
+int GetWeightDecimalPlaces();
+
+
+#endif // FORMAT_H
@@ -0,0 +1,308 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HX711Bank.cpp
+//
+// Contains methods defined by the HX711Bank class.  These methods read several
+// HX711s that share a clock pin in a single burst.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "HX711Bank.h"          // For HX711Bank class.
+#include <soc/gpio_reg.h>       // For GPIO_IN_REG, GPIO_IN1_REG.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - sck         - This specifies the GPIO pin connected to the PD_SCK pin of
+//                    every HX711.
+//    - pDoutPins   - Array of the GPIO pins connected to the DOUT pin of each
+//                    HX711, in channel order.
+//    - numChannels - The number of entries in pDoutPins.  Limited to
+//                    MAX_CHANNELS.
+/////////////////////////////////////////////////////////////////////////////////
+HX711Bank::HX711Bank(int sck, const int *pDoutPins, uint8_t numChannels) :
+    m_SckPin(sck), m_NumChannels(0U), m_SckReady(false),
+    m_GainPulses(HX711Transport::GainPulses(128U)), m_BegunMask(0U), m_ActiveMask(0U),
+    m_FreshMask(0U)
+{
+    m_Mux = portMUX_INITIALIZER_UNLOCKED;
+    if ((pDoutPins != NULL) && (numChannels <= MAX_CHANNELS))
+    {
+        m_NumChannels = numChannels;
+    }
+    for (uint8_t ch = 0U; ch < MAX_CHANNELS; ch++)
+    {
+        m_DoutPins[ch] = (ch < m_NumChannels) ? pDoutPins[ch] : HX711Transport::NO_PIN;
+        m_DoutBits[ch] = (ch < m_NumChannels) ? (1ULL << m_DoutPins[ch]) : 0ULL;
+        m_Values[ch]   = 0L;
+        m_Channels[ch].Attach(this, ch);
+    }
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Begin()
+//
+// Sets up a channel's DOUT pin (and the shared PD_SCK pin the first time) and
+// adds the channel to the burst.
+//
+// Arguments:
+//    - channel - The channel to set up.
+//    - gain    - The gain to be used for conversions.  Shared by all channels.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the channel isn't wired.
+/////////////////////////////////////////////////////////////////////////////////
+bool HX711Bank::Begin(uint8_t channel, uint8_t gain)
+{
+    if (channel >= m_NumChannels)
+    {
+        return false;
+    }
+
+    SetGain(gain);
+
+    // Hold PD_SCK low so that the HX711s don't power down.
+    if (!m_SckReady)
+    {
+        pinMode(m_SckPin, OUTPUT);
+        digitalWrite(m_SckPin, LOW);
+        m_SckReady = true;
+    }
+
+    // DOUT is read directly to sense data ready, so make sure it doesn't float
+    // when no HX711 is connected.
+    pinMode(m_DoutPins[channel], INPUT_PULLUP);
+
+    portENTER_CRITICAL(&m_Mux);
+    m_BegunMask  |= (1U << channel);
+    m_ActiveMask |= (1U << channel);
+    m_FreshMask  &= ~(1U << channel);
+    portEXIT_CRITICAL(&m_Mux);
+    return true;
+} // End Begin().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// IsReady()
+//
+// Returns 'true' if a channel has a value waiting from an earlier burst, or if
+// its HX711 has a conversion ready (DOUT is low).
+/////////////////////////////////////////////////////////////////////////////////
+bool HX711Bank::IsReady(uint8_t channel) const
+{
+    return (channel < m_NumChannels) &&
+           ((m_FreshMask & (1U << channel)) ||
+            (digitalRead(m_DoutPins[channel]) == LOW));
+} // End IsReady().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetGain()
+//
+// Sets the gain (and HX711 channel) of every HX711 in the bank.  Takes effect
+// with the next burst.
+//
+// Arguments:
+//    - gain - Valid values are 128 and 64 (channel A) and 32 (channel B).
+//             Invalid values are ignored.
+/////////////////////////////////////////////////////////////////////////////////
+void HX711Bank::SetGain(uint8_t gain)
+{
+    uint8_t pulses = HX711Transport::GainPulses(gain);
+    if (pulses != 0U)
+    {
+        m_GainPulses = pulses;
+    }
+} // End SetGain().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Read()
+//
+// Returns a channel's value from the last burst if it hasn't been read yet.
+// Otherwise waits for every active channel to be ready and does a new burst.
+// Just like the other transports, this blocks until a value is available.
+//
+// Arguments:
+//    - channel - The channel to read.
+//
+// Returns:
+//    Returns the sign extended 24-bit conversion value, or 0 if the channel's
+//    HX711 doesn't become ready within READY_TIMEOUT_MS.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t HX711Bank::Read(uint8_t channel)
+{
+    if ((channel >= m_NumChannels) || !m_SckReady)
+    {
+        return 0L;
+    }
+
+    const uint8_t bit = 1U << channel;
+    uint32_t startMs = millis();
+    for (;;)
+    {
+        // The ready check and the burst are done together so that the
+        // channel tasks can't both start a burst.  Dropped channels that have
+        // a conversion ready again rejoin first.
+        bool    haveValue = false;
+        int32_t value = 0L;
+        portENTER_CRITICAL(&m_Mux);
+        uint8_t rejoined = RejoinMask();
+        m_ActiveMask |= rejoined;
+        if (!(m_FreshMask & bit) && (NotReadyMask() == 0U))
+        {
+            ReadAll();
+        }
+        if (m_FreshMask & bit)
+        {
+            value = m_Values[channel];
+            m_FreshMask &= ~bit;
+            haveValue = true;
+        }
+        portEXIT_CRITICAL(&m_Mux);
+
+        if (rejoined != 0U)
+        {
+            Serial.printf("HX711Bank - channel mask 0x%02x responding again.\n", rejoined);
+        }
+        if (haveValue)
+        {
+            return value;
+        }
+
+        // Drop channels that never become ready so that they don't hold up
+        // the rest.  If it is our own channel (or it was dropped earlier and
+        // is still not ready), there's nothing to read.
+        if (millis() - startMs >= READY_TIMEOUT_MS)
+        {
+            uint8_t stuck = NotReadyMask();
+            if ((stuck & bit) || !(m_ActiveMask & bit))
+            {
+                return 0L;
+            }
+            portENTER_CRITICAL(&m_Mux);
+            m_ActiveMask &= ~stuck;
+            portEXIT_CRITICAL(&m_Mux);
+            Serial.printf("HX711Bank - channel mask 0x%02x not responding.\n", stuck);
+            startMs = millis();
+        }
+        delay(1);
+    }
+} // End Read().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// NotReadyMask()
+//
+// Returns a mask of the active channels whose HX711 has no conversion ready.
+/////////////////////////////////////////////////////////////////////////////////
+uint8_t HX711Bank::NotReadyMask() const
+{
+    uint64_t inputs = ReadInputs();
+    uint8_t  mask = 0U;
+    for (uint8_t ch = 0U; ch < m_NumChannels; ch++)
+    {
+        if ((m_ActiveMask & (1U << ch)) && (inputs & m_DoutBits[ch]))
+        {
+            mask |= (1U << ch);
+        }
+    }
+    return mask;
+} // End NotReadyMask().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RejoinMask()
+//
+// Returns a mask of the channels that were dropped from the burst but whose
+// HX711 has a conversion ready again.
+/////////////////////////////////////////////////////////////////////////////////
+uint8_t HX711Bank::RejoinMask() const
+{
+    uint8_t dropped = m_BegunMask & ~m_ActiveMask;
+    if (dropped == 0U)
+    {
+        return 0U;
+    }
+
+    uint64_t inputs = ReadInputs();
+    uint8_t  mask = 0U;
+    for (uint8_t ch = 0U; ch < m_NumChannels; ch++)
+    {
+        if ((dropped & (1U << ch)) && !(inputs & m_DoutBits[ch]))
+        {
+            mask |= (1U << ch);
+        }
+    }
+    return mask;
+} // End RejoinMask().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadAll()
+//
+// Clocks the 24 data bits plus the gain selection pulses out of every HX711 at
+// once.  The inputs are sampled once per clock while PD_SCK is high.  Must be
+// called inside the critical section, which also keeps PD_SCK from being held
+// high long enough (60 us) to power the HX711s down.
+/////////////////////////////////////////////////////////////////////////////////
+void IRAM_ATTR HX711Bank::ReadAll()
+{
+    uint32_t values[MAX_CHANNELS] = {0UL};
+
+    for (uint8_t i = 0U; i < HX711Transport::DATA_BITS; i++)
+    {
+        digitalWrite(m_SckPin, HIGH);
+        delayMicroseconds(1);
+        uint64_t inputs = ReadInputs();
+        digitalWrite(m_SckPin, LOW);
+        for (uint8_t ch = 0U; ch < m_NumChannels; ch++)
+        {
+            values[ch] = (values[ch] << 1) | ((inputs & m_DoutBits[ch]) ? 1UL : 0UL);
+        }
+        delayMicroseconds(1);
+    }
+
+    // Select the gain of the next conversion.
+    for (uint8_t i = 0U; i < m_GainPulses; i++)
+    {
+        digitalWrite(m_SckPin, HIGH);
+        delayMicroseconds(1);
+        digitalWrite(m_SckPin, LOW);
+        delayMicroseconds(1);
+    }
+
+    // Construct 32-bit signed integers, replicating the most significant bit.
+    for (uint8_t ch = 0U; ch < m_NumChannels; ch++)
+    {
+        if (m_ActiveMask & (1U << ch))
+        {
+            if (values[ch] & 0x800000UL)
+            {
+                values[ch] |= 0xFF000000UL;
+            }
+            m_Values[ch] = static_cast<int32_t>(values[ch]);
+        }
+    }
+    m_FreshMask = m_ActiveMask;
+} // End ReadAll().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadInputs()
+//
+// Returns the level of every GPIO input pin (bit n is GPIO n).  Both input
+// registers are read since the input only pins (34 to 39) are often used for
+// DOUT.
+/////////////////////////////////////////////////////////////////////////////////
+uint64_t IRAM_ATTR HX711Bank::ReadInputs() const
+{
+    return static_cast<uint64_t>(REG_READ(GPIO_IN_REG)) |
+           (static_cast<uint64_t>(REG_READ(GPIO_IN1_REG)) << 32);
+} // End ReadInputs().
@@ -0,0 +1,168 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HX711Bank.h
+//
+// This class implements the HX711Bank class.  It drives up to MAX_CHANNELS
+// HX711s that share a single PD_SCK pin, each with its own DOUT pin, so that one
+// ESP32 can serve a whole rack of spools with only one extra pin per spool.
+//
+// All of the HX711s are read in a single burst of clock pulses.  On each clock
+// the GPIO input register is read once and one bit is taken from it for every
+// channel, so a burst takes the same time whatever the number of channels.  The
+// burst is only started once every active channel has a conversion ready, and
+// the values of the other channels are kept until their LoadCells ask for them.
+//
+// Each channel is presented as an HX711Transport (see GetChannel()), so the
+// LoadCell class is used unchanged.  Since the clock is shared, so is the gain:
+// setting the gain of any channel sets it for all of them.
+//
+// A channel becomes active when its transport's Begin() is called.  A channel
+// whose DOUT doesn't go low within READY_TIMEOUT_MS (e.g. no HX711 fitted, or a
+// loose connection) is dropped from the burst so that it can't hold up the
+// others, and reports that it isn't responding.  It rejoins the burst as soon
+// as its DOUT goes low again.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HX711BANK_H
+#define HX711BANK_H
+
+#include <Arduino.h>            // For digitalWrite(), portMUX_TYPE, ...
+#include "HX711Transport.h"     // For HX711Transport interface.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HX711Bank class
+/////////////////////////////////////////////////////////////////////////////////
+class HX711Bank
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - sck         - This specifies the GPIO pin connected to the PD_SCK pin
+    //                    of every HX711.
+    //    - pDoutPins   - Array of the GPIO pins connected to the DOUT pin of
+    //                    each HX711, in channel order.
+    //    - numChannels - The number of entries in pDoutPins.  Limited to
+    //                    MAX_CHANNELS.
+    /////////////////////////////////////////////////////////////////////////////
+    HX711Bank(int sck, const int *pDoutPins, uint8_t numChannels);
+
+
+    // Destructor.
+    virtual ~HX711Bank() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetChannel()
+    //
+    // Returns the transport for one channel.  It remains valid for the life of
+    // the bank.  A channel beyond GetNumChannels() is returned as a transport
+    // whose Begin() fails, so a LoadCell constructed with it is never used.
+    //
+    // Arguments:
+    //    - channel - The channel number, 0 to MAX_CHANNELS - 1.
+    /////////////////////////////////////////////////////////////////////////////
+    HX711Transport *GetChannel(uint8_t channel)
+        { return &m_Channels[channel < MAX_CHANNELS ? channel : 0U]; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t GetNumChannels() const { return m_NumChannels; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint8_t  MAX_CHANNELS     = 4U;
+    static const uint32_t READY_TIMEOUT_MS = 250UL; // 2.5 conversions at 10 SPS.
+
+private:
+    /////////////////////////////////////////////////////////////////////////////
+    // Channel class
+    //
+    // The HX711Transport for one channel.  Everything is passed on to the bank.
+    /////////////////////////////////////////////////////////////////////////////
+    class Channel : public HX711Transport
+    {
+    public:
+        Channel() : m_pBank(NULL), m_Channel(0U) { }
+        virtual ~Channel() { }
+        void Attach(HX711Bank *pBank, uint8_t channel)
+            { m_pBank = pBank; m_Channel = channel; }
+
+        // HX711Transport methods.  See HX711Transport.h for descriptions.
+        bool    Begin(uint8_t gain)     { return m_pBank->Begin(m_Channel, gain); }
+        bool    IsReady() const         { return m_pBank->IsReady(m_Channel); }
+        void    SetGain(uint8_t gain)   { m_pBank->SetGain(gain); }
+        int32_t Read()                  { return m_pBank->Read(m_Channel); }
+        int     GetDataReadyPin() const { return m_pBank->GetDoutPin(m_Channel); }
+        bool    IsResponding() const    { return m_pBank->IsResponding(m_Channel); }
+
+    private:
+        // Unimplemented methods.  We don't want users to try to use these.
+        Channel(Channel &rC);
+        Channel &operator=(Channel &rC);
+
+        HX711Bank *m_pBank;             // The bank we belong to.
+        uint8_t    m_Channel;           // Our channel number.
+
+    }; // End class Channel.
+
+
+    // Unimplemented methods.  We don't want users to try to use these.
+    HX711Bank();
+    HX711Bank(HX711Bank &rB);
+    HX711Bank &operator=(HX711Bank &rB);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Channel operations.  See HX711Bank.cpp for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    bool    Begin(uint8_t channel, uint8_t gain);
+    bool    IsReady(uint8_t channel) const;
+    void    SetGain(uint8_t gain);
+    int32_t Read(uint8_t channel);
+    int     GetDoutPin(uint8_t channel) const
+        { return channel < m_NumChannels ? m_DoutPins[channel] : HX711Transport::NO_PIN; }
+    bool    IsResponding(uint8_t channel) const
+        { return (m_ActiveMask & (1U << channel)) != 0U; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Helpers.  See HX711Bank.cpp for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t  NotReadyMask() const;
+    uint8_t  RejoinMask() const;
+    void     ReadAll();
+    uint64_t ReadInputs() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    int      m_SckPin;                  // Shared PD_SCK pin.
+    uint8_t  m_NumChannels;             // Number of channels wired.
+    int      m_DoutPins[MAX_CHANNELS];  // DOUT pin of each channel.
+    uint64_t m_DoutBits[MAX_CHANNELS];  // Each DOUT pin's bit in ReadInputs().
+    bool     m_SckReady;                // PD_SCK has been set up.
+    uint8_t  m_GainPulses;              // Pulses after the data bits.
+    volatile uint8_t m_BegunMask;       // Channels set up by Begin().
+    volatile uint8_t m_ActiveMask;      // Channels included in the burst.
+    volatile uint8_t m_FreshMask;       // Channels with an unread value.
+    int32_t  m_Values[MAX_CHANNELS];    // Values from the last burst.
+    Channel  m_Channels[MAX_CHANNELS];  // Per channel transports.
+    portMUX_TYPE m_Mux;                 // Guards the burst and the masks.
+
+}; // End class HX711Bank.
+
+
+
+#endif // HX711BANK_H
@@ -0,0 +1,70 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HX711GpioTransport.h
+//
+// This class implements the HX711GpioTransport class.  It is the original
+// method of reading the HX711, and uses the (patched) HX711 library to
+// bit-bang PD_SCK with digitalWrite().  Each read is done inside a critical
+// section, so interrupts are held off for the entire read.  Prefer
+// HX711SpiTransport on the ESP32.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HX711GPIOTRANSPORT_H
+#define HX711GPIOTRANSPORT_H
+
+#include <HX711.h>              // For HX711 hardware specific data.
+#include "HX711Transport.h"     // For HX711Transport interface.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HX711GpioTransport class
+//
+// Derived from HX711 class.
+/////////////////////////////////////////////////////////////////////////////////
+class HX711GpioTransport : public HX711Transport, private HX711
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - dout   - This specifies the GPIO pin used to connect to the HX711 DOUT
+    //               (Serial Data Out) pin.
+    //    - sck    - This specifies the GPIO pin used to connect to the HX711
+    //               PD_SCK (Power Down and Serial Clock Input) pin.
+    /////////////////////////////////////////////////////////////////////////////
+    HX711GpioTransport(int dout, int sck) :
+        HX711(), m_DoutPin(dout), m_SckPin(sck) { }
+
+
+    // Destructor.
+    virtual ~HX711GpioTransport() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // HX711Transport methods.  See HX711Transport.h for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    bool    Begin(uint8_t gain)     { begin(m_DoutPin, m_SckPin, gain); return true; }
+    bool    IsReady() const         { return is_ready(); }
+    void    SetGain(uint8_t gain)   { set_gain(gain); }
+    int32_t Read()                  { return read(); }
+    int     GetDataReadyPin() const { return m_DoutPin; }
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    HX711GpioTransport();
+    HX711GpioTransport(HX711GpioTransport &rT);
+    HX711GpioTransport &operator=(HX711GpioTransport &rT);
+
+    int m_DoutPin;                      // HX711 DOUT pin.
+    int m_SckPin;                       // HX711 PD_SCK pin.
+
+}; // End class HX711GpioTransport.
+
+
+
+#endif // HX711GPIOTRANSPORT_H
@@ -0,0 +1,133 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HX711SimTransport.h
+//
+// This class implements the HX711SimTransport class.  It does not talk to any
+// hardware.  Instead, it returns values from a caller supplied table (or a
+// single constant value), which allows the LoadCell code to be exercised off
+// target or without a load cell connected.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HX711SIMTRANSPORT_H
+#define HX711SIMTRANSPORT_H
+
+#include <cstddef>              // For size_t.
+#include "HX711Transport.h"     // For HX711Transport interface.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HX711SimTransport class
+/////////////////////////////////////////////////////////////////////////////////
+class HX711SimTransport : public HX711Transport
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // The transport starts out returning a constant value of 'value'.
+    //
+    // Arguments:
+    //    - value - The value to be returned by Read() until SetSamples() is
+    //              called.  Note that LoadCell treats a value of 0 as "no
+    //              HX711 present", so the default is a typical no-load reading.
+    /////////////////////////////////////////////////////////////////////////////
+    HX711SimTransport(int32_t value = DEFAULT_VALUE) :
+        m_pSamples(NULL), m_NumSamples(0), m_Index(0), m_Repeat(false),
+        m_Constant(value), m_Gain(128U), m_ReadCount(0) { }
+
+
+    // Destructor.
+    virtual ~HX711SimTransport() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetSamples()
+    //
+    // Specifies a table of values to be returned by successive calls to Read().
+    // The table is not copied, so it must remain valid while in use.
+    //
+    // Arguments:
+    //    - pSamples - Pointer to the table of values.
+    //    - count    - Number of entries in the table.
+    //    - repeat   - If 'true', wrap back to the start of the table after the
+    //                 last value.  Otherwise the last value is returned forever.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetSamples(const int32_t *pSamples, size_t count, bool repeat = false)
+    {
+        m_pSamples   = pSamples;
+        m_NumSamples = (pSamples != NULL) ? count : 0;
+        m_Index      = 0;
+        m_Repeat     = repeat;
+    } // End SetSamples().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetConstant()
+    //
+    // Causes Read() to return 'value' from now on.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetConstant(int32_t value)
+    {
+        SetSamples(NULL, 0);
+        m_Constant = value;
+    } // End SetConstant().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // HX711Transport methods.  See HX711Transport.h for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Begin(uint8_t gain)        { SetGain(gain); return true; }
+    bool IsReady() const            { return true; }
+    void SetGain(uint8_t gain)      { m_Gain = gain; }
+    int  GetDataReadyPin() const    { return NO_PIN; }
+
+    int32_t Read()
+    {
+        m_ReadCount++;
+
+        // Return the constant value if no table is in use.
+        if (m_NumSamples == 0)
+        {
+            return m_Constant;
+        }
+
+        // Return the next table entry, wrapping or sticking at the end.
+        int32_t value = m_pSamples[m_Index];
+        if (++m_Index >= m_NumSamples)
+        {
+            m_Index = m_Repeat ? 0 : m_NumSamples - 1;
+        }
+        return value;
+    } // End Read().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t  GetGain()      const { return m_Gain; }
+    uint32_t GetReadCount() const { return m_ReadCount; }
+
+    static const int32_t DEFAULT_VALUE = 100000L;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    HX711SimTransport(HX711SimTransport &rT);
+    HX711SimTransport &operator=(HX711SimTransport &rT);
+
+    const int32_t *m_pSamples;          // Table of values to return.
+    size_t         m_NumSamples;        // Number of entries in m_pSamples.
+    size_t         m_Index;             // Index of the next value to return.
+    bool           m_Repeat;            // Wrap to the start of the table.
+    int32_t        m_Constant;          // Value returned when no table.
+    uint8_t        m_Gain;              // Last gain set.
+    uint32_t       m_ReadCount;         // Number of calls to Read().
+
+}; // End class HX711SimTransport.
+
+
+
+#endif // HX711SIMTRANSPORT_H
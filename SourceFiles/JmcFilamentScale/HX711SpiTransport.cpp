@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HX711SpiTransport.cpp
+//
+// Contains methods defined by the HX711SpiTransport class.  These methods read
+// the HX711 using the ESP32 SPI peripheral.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "HX711SpiTransport.h"  // For HX711SpiTransport class.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - dout   - This specifies the GPIO pin used to connect to the HX711 DOUT
+//               (Serial Data Out) pin.
+//    - sck    - This specifies the GPIO pin used to connect to the HX711
+//               PD_SCK (Power Down and Serial Clock Input) pin.
+//    - host   - The SPI host to use.
+/////////////////////////////////////////////////////////////////////////////////
+HX711SpiTransport::HX711SpiTransport(int dout, int sck, spi_host_device_t host) :
+    m_DoutPin(dout), m_SckPin(sck), m_Host(host), m_Device(NULL),
+    m_GainPulses(GainPulses(128U))
+{
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Begin()
+//
+// Sets up the SPI bus and device used to talk to the HX711.
+//
+// Arguments:
+//    - gain - The gain to be used for conversions.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool HX711SpiTransport::Begin(uint8_t gain)
+{
+    SetGain(gain);
+
+    // Nothing more to do if we've already been set up.
+    if (m_Device != NULL)
+    {
+        return true;
+    }
+
+    // DOUT is read directly to sense data ready, so make sure it doesn't float
+    // when no HX711 is connected.  Drive PD_SCK low until the bus takes over so
+    // that the HX711 doesn't power down.
+    pinMode(m_DoutPin, INPUT_PULLUP);
+    pinMode(m_SckPin, OUTPUT);
+    digitalWrite(m_SckPin, LOW);
+
+    // The bus only needs SCLK and MISO.
+    spi_bus_config_t busConfig = {};
+    busConfig.mosi_io_num     = -1;
+    busConfig.miso_io_num     = m_DoutPin;
+    busConfig.sclk_io_num     = m_SckPin;
+    busConfig.quadwp_io_num   = -1;
+    busConfig.quadhd_io_num   = -1;
+    busConfig.max_transfer_sz = 4;
+    if (spi_bus_initialize(m_Host, &busConfig, 0) != ESP_OK)
+    {
+        Serial.println("HX711SpiTransport - SPI bus init failed.");
+        return false;
+    }
+
+    // No CS pin.  The HX711 is the only device on this bus.
+    spi_device_interface_config_t devConfig = {};
+    devConfig.mode           = SPI_MODE;
+    devConfig.clock_speed_hz = CLOCK_HZ;
+    devConfig.spics_io_num   = -1;
+    devConfig.queue_size     = 1;
+    if (spi_bus_add_device(m_Host, &devConfig, &m_Device) != ESP_OK)
+    {
+        Serial.println("HX711SpiTransport - SPI device add failed.");
+        spi_bus_free(m_Host);
+        m_Device = NULL;
+        return false;
+    }
+
+    return true;
+} // End Begin().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetGain()
+//
+// Sets the gain (and channel) to be used.  Takes effect with the next Read().
+//
+// Arguments:
+//    - gain - Valid values are 128 and 64 (channel A) and 32 (channel B).
+//             Invalid values are ignored.
+/////////////////////////////////////////////////////////////////////////////////
+void HX711SpiTransport::SetGain(uint8_t gain)
+{
+    uint8_t pulses = GainPulses(gain);
+    if (pulses != 0U)
+    {
+        m_GainPulses = pulses;
+    }
+} // End SetGain().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Read()
+//
+// Waits for a conversion to be ready, then clocks out the 24 data bits plus the
+// gain selection pulses in a single SPI transaction.  The transaction is
+// interrupt driven, so the calling task sleeps while the bits are shifted.
+//
+// Returns:
+//    Returns the sign extended 24-bit conversion value, or 0 if the device
+//    has not been set up.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t HX711SpiTransport::Read()
+{
+    if (m_Device == NULL)
+    {
+        return 0L;
+    }
+
+    // Wait for the chip to become ready.  Just like the HX711 library, this
+    // blocks until a conversion is available.
+    while (!IsReady())
+    {
+        delay(0);
+    }
+
+    // Full duplex with zeros on the (unconnected) MOSI line.  The data bits
+    // arrive MSB first in rx_data[0..2].  Any gain pulse bits land in
+    // rx_data[3] and are ignored.
+    spi_transaction_t trans = {};
+    trans.flags    = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA;
+    trans.length   = DATA_BITS + m_GainPulses;
+    trans.rxlength = trans.length;
+    if (spi_device_transmit(m_Device, &trans) != ESP_OK)
+    {
+        return 0L;
+    }
+
+    // Construct a 32-bit signed integer, replicating the most significant bit.
+    uint32_t value = (static_cast<uint32_t>(trans.rx_data[0]) << 16) |
+                     (static_cast<uint32_t>(trans.rx_data[1]) << 8)  |
+                      static_cast<uint32_t>(trans.rx_data[2]);
+    if (value & 0x800000UL)
+    {
+        value |= 0xFF000000UL;
+    }
+
+    return static_cast<int32_t>(value);
+} // End Read().
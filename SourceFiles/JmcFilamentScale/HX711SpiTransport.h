@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HX711SpiTransport.h
+//
+// This class implements the HX711SpiTransport class.  It uses the ESP32 SPI
+// peripheral to generate the PD_SCK pulses and to sample DOUT.  Since the
+// pulses are generated by hardware, interrupts can no longer stretch a clock
+// pulse past the 60 uSec power down limit, so no critical section is needed
+// and the CPU only pays for setting up the transaction.
+//
+// The HX711 is wired as follows:
+//    - PD_SCK - SPI SCLK.
+//    - DOUT   - SPI MISO.  This is also used to sense data ready.
+// MOSI and CS are not used.  Any GPIO pins may be used since the SPI signals
+// are routed through the GPIO matrix.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HX711SPITRANSPORT_H
+#define HX711SPITRANSPORT_H
+
+#include <Arduino.h>            // For pin handling.
+#include <driver/spi_master.h>  // For ESP32 SPI master driver.
+#include "HX711Transport.h"     // For HX711Transport interface.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HX711SpiTransport class
+/////////////////////////////////////////////////////////////////////////////////
+class HX711SpiTransport : public HX711Transport
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - dout   - This specifies the GPIO pin used to connect to the HX711 DOUT
+    //               (Serial Data Out) pin.
+    //    - sck    - This specifies the GPIO pin used to connect to the HX711
+    //               PD_SCK (Power Down and Serial Clock Input) pin.
+    //    - host   - The SPI host to use.  Must not be shared with another
+    //               device (the TFT uses VSPI by default).
+    /////////////////////////////////////////////////////////////////////////////
+    HX711SpiTransport(int dout, int sck, spi_host_device_t host = HSPI_HOST);
+
+
+    // Destructor.
+    virtual ~HX711SpiTransport() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // HX711Transport methods.  See HX711Transport.h for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    bool    Begin(uint8_t gain);
+    bool    IsReady() const         { return digitalRead(m_DoutPin) == LOW; }
+    void    SetGain(uint8_t gain);
+    int32_t Read();
+    int     GetDataReadyPin() const { return m_DoutPin; }
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    HX711SpiTransport();
+    HX711SpiTransport(HX711SpiTransport &rT);
+    HX711SpiTransport &operator=(HX711SpiTransport &rT);
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Private constants.
+    /////////////////////////////////////////////////////////////////////////////
+    // PD_SCK high time must be between 0.2 and 50 uSec, so 1 MHz leaves plenty
+    // of margin at both ends.  A 25 to 27 bit read then takes about 27 uSec.
+    static const int CLOCK_HZ = 1000000;
+
+    // SPI mode 1 (CPOL = 0, CPHA = 1).  PD_SCK idles low (which keeps the
+    // HX711 powered up), DOUT changes after each rising edge and is sampled on
+    // the falling edge.
+    static const uint8_t SPI_MODE = 1U;
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Private instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    int                 m_DoutPin;      // HX711 DOUT pin (SPI MISO).
+    int                 m_SckPin;       // HX711 PD_SCK pin (SPI SCLK).
+    spi_host_device_t   m_Host;         // SPI host in use.
+    spi_device_handle_t m_Device;       // SPI device handle, NULL until Begin().
+    volatile uint8_t    m_GainPulses;   // Pulses after the data bits.
+
+}; // End class HX711SpiTransport.
+
+
+
+#endif // HX711SPITRANSPORT_H
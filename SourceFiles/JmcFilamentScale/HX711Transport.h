@@ -0,0 +1,135 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HX711Transport.h
+//
+// This file defines the HX711Transport interface.  A transport is responsible
+// for clocking conversions out of an HX711 and for selecting the gain/channel
+// of the next conversion.  The LoadCell class talks to the HX711 only through
+// this interface, so the method used to move the bits may be selected when the
+// LoadCell is constructed.  The following transports are available:
+//    - HX711GpioTransport - Bit-bangs PD_SCK using the HX711 library.
+//    - HX711SpiTransport  - Clocks the bits with the ESP32 SPI peripheral.
+//    - HX711SimTransport  - Returns scripted values (no hardware required).
+//    - HX711Bank          - Provides one transport per HX711 for several HX711s
+//                           sharing a clock pin.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HX711TRANSPORT_H
+#define HX711TRANSPORT_H
+
+#include <cstdint>      // For int32_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HX711Transport class
+//
+// Abstract interface implemented by each of the HX711 transports.
+/////////////////////////////////////////////////////////////////////////////////
+class HX711Transport
+{
+public:
+    // Destructor.
+    virtual ~HX711Transport() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Begin()
+    //
+    // Initializes the hardware (if any) used by the transport.
+    //
+    // Arguments:
+    //    - gain - The gain to be used for conversions.  Valid values are 128
+    //             and 64 (channel A) and 32 (channel B).
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool Begin(uint8_t gain) = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // IsReady()
+    //
+    // Returns 'true' if a conversion is ready to be read (DOUT is low).
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool IsReady() const = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetGain()
+    //
+    // Sets the gain (and channel) to be used.  As with the HX711 itself, the new
+    // gain is applied by the clock pulses that follow the next Read(), so the
+    // conversion after that is the first one at the new gain.
+    //
+    // Arguments:
+    //    - gain - Valid values are 128 and 64 (channel A) and 32 (channel B).
+    /////////////////////////////////////////////////////////////////////////////
+    virtual void SetGain(uint8_t gain) = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Read()
+    //
+    // Waits for a conversion to be ready, then clocks it out of the device.
+    //
+    // Returns:
+    //    Returns the sign extended 24-bit conversion value.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual int32_t Read() = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetDataReadyPin()
+    //
+    // Returns the GPIO pin connected to DOUT so that a data ready interrupt may
+    // be attached to it, or NO_PIN if the transport has no such pin.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual int GetDataReadyPin() const = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // IsResponding()
+    //
+    // Returns 'false' if the HX711 has stopped producing conversions.  A
+    // transport that can't tell always returns 'true'.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool IsResponding() const { return true; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GainPulses()
+    //
+    // Returns the number of extra PD_SCK pulses (beyond the 24 data bits) that
+    // select the given gain and channel for the next conversion, or 0 if the
+    // gain is not valid.
+    /////////////////////////////////////////////////////////////////////////////
+    static uint8_t GainPulses(uint8_t gain)
+    {
+        uint8_t pulses = 0U;
+        switch (gain)
+        {
+        case 128U: pulses = 1U; break;     // Channel A, gain 128.
+        case 64U:  pulses = 3U; break;     // Channel A, gain 64.
+        case 32U:  pulses = 2U; break;     // Channel B, gain 32.
+        default:   break;
+        }
+        return pulses;
+    } // End GainPulses().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const int     NO_PIN    = -1;    // No data ready pin available.
+    static const uint8_t DATA_BITS = 24U;   // Bits in each conversion.
+
+}; // End class HX711Transport.
+
+
+
+#endif // HX711TRANSPORT_H
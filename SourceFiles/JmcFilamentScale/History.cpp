@@ -0,0 +1,390 @@
+/////////////////////////////////////////////////////////////////////////////////
+// History.cpp
+//
+// Contains methods defined by the History class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Arduino.h>            // For Serial.
+#include "History.h"            // For History class.
+#include "NvsStore.h"           // For Save and Restore to/from NVS.
+#include <cmath>                // For NAN.
+#include <cstdio>               // For snprintf().
+#include <cstring>              // For strlen().
+
+
+// Some constants used by the class.
+const uint32_t History::TIER_PERIODS_S[NUM_TIERS] = {1UL, 60UL, 3600UL};
+const uint32_t History::TIER_SPANS_S[NUM_TIERS]   = {3600UL, 86400UL, 30UL * 86400UL};
+const char    *History::pPrefStateLabel           = "State";
+const char    *History::pPrefBlockFormat          = "Block %u";
+
+
+// Blocks in each tier.  The span needs span / period / BLOCK_SAMPLES blocks;
+// the extra allow for the part blocks left by gaps (e.g. a restart).
+static const size_t SECONDS_BLOCKS = 120U;
+static const size_t MINUTES_BLOCKS = 48U;
+static const size_t HOURS_BLOCKS   = 24U;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SavedState is the time and hourly ring position.  It is saved with the
+// hourly blocks, and on its own each time the minutes tier grows.
+/////////////////////////////////////////////////////////////////////////////////
+struct SavedState
+{
+    uint32_t m_NowS;                    // History time.
+    uint16_t m_First;                   // Oldest block.
+    uint16_t m_Used;                    // Blocks in use.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+/////////////////////////////////////////////////////////////////////////////////
+History::History() :
+    m_pName(NULL),
+    m_Seconds(TIER_PERIODS_S[0], SECONDS_BLOCKS),
+    m_Minutes(TIER_PERIODS_S[1], MINUTES_BLOCKS),
+    m_Hours(TIER_PERIODS_S[2], HOURS_BLOCKS),
+    m_NowS(0UL), m_LastMs(0UL), m_RemainderMs(0UL), m_Started(false)
+{
+    m_pTiers[0] = &m_Seconds;
+    m_pTiers[1] = &m_Minutes;
+    m_pTiers[2] = &m_Hours;
+    for (size_t tier = 0U; tier < NUM_TIERS; tier++)
+    {
+        ClearBucket(m_Buckets[tier]);
+    }
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Init()
+//
+// Allocates the tiers and restores the saved history, if any.
+//
+// Arguments:
+//    - pName - A string of no more than MAX_NVS_NAME_LEN characters used to
+//              identify the instance in NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.  Having no saved
+//    history is not a failure.
+/////////////////////////////////////////////////////////////////////////////////
+bool History::Init(const char *pName)
+{
+    if ((pName == NULL) || (*pName == '\0') || (strlen(pName) > MAX_NVS_NAME_LEN))
+    {
+        return false;
+    }
+    m_pName = pName;
+
+    bool status = true;
+    for (size_t tier = 0U; tier < NUM_TIERS; tier++)
+    {
+        status &= m_pTiers[tier]->Init();
+    }
+    if (status && !Restore())
+    {
+        Serial.println("History - nothing restored.");
+    }
+    return status;
+} // End Init().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Update()
+//
+// Advances the history time and adds the readings to the first tier's
+// average.
+//
+// Arguments:
+//    - rReading - The readings.  Any may be NaN.
+//    - nowMs    - The current time (millis()).
+/////////////////////////////////////////////////////////////////////////////////
+void History::Update(const HistorySample &rReading, uint32_t nowMs)
+{
+    if (!m_Started)
+    {
+        m_LastMs  = nowMs;
+        m_Started = true;
+    }
+    m_RemainderMs += nowMs - m_LastMs;
+    m_LastMs       = nowMs;
+    m_NowS        += m_RemainderMs / 1000UL;
+    m_RemainderMs %= 1000UL;
+
+    AddToTier(0U, m_NowS, rReading);
+} // End Update().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddToTier()
+//
+// Adds a sample to a tier's average.  When the sample belongs to the tier's
+// next period, the finished average is first added to the tier and passed on
+// to the next one.  The last tier is saved each time it grows, and the time
+// each time the clock tier (minutes) does, so that a restart loses at most a
+// minute of history time.
+//
+// Arguments:
+//    - tier    - The tier number.
+//    - timeS   - The sample's time.
+//    - rSample - The sample.
+//
+// Returns:
+//    Returns 'true' if the last tier (and with it the time) was saved.
+/////////////////////////////////////////////////////////////////////////////////
+bool History::AddToTier(size_t tier, uint32_t timeS, const HistorySample &rSample)
+{
+    bool saved = false;
+    Bucket &rBucket = m_Buckets[tier];
+    uint32_t startS = timeS - timeS % TIER_PERIODS_S[tier];
+    if ((rBucket.m_Count > 0UL) && (startS != rBucket.m_StartS))
+    {
+        HistorySample average = Average(rBucket);
+        m_pTiers[tier]->Add(rBucket.m_StartS, average);
+        if (tier + 1U < NUM_TIERS)
+        {
+            saved = AddToTier(tier + 1U, rBucket.m_StartS, average);
+        }
+        else
+        {
+            Save();
+            saved = true;
+        }
+        if ((tier == CLOCK_TIER) && !saved)
+        {
+            SaveState();
+        }
+        ClearBucket(rBucket);
+    }
+
+    if (rBucket.m_Count == 0UL)
+    {
+        rBucket.m_StartS = startS;
+    }
+    AddToBucket(rBucket, rSample);
+    return saved;
+} // End AddToTier().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// PickTier()
+//
+// Chooses the finest tier whose span reaches back to the start of a range, or
+// the coarsest tier if none does.
+//
+// Arguments:
+//    - fromS - Start of the range, in history seconds.
+//
+// Returns:
+//    Returns the tier number.
+/////////////////////////////////////////////////////////////////////////////////
+size_t History::PickTier(uint32_t fromS) const
+{
+    uint32_t ageS = (fromS < m_NowS) ? m_NowS - fromS : 0UL;
+    for (size_t tier = 0U; tier < NUM_TIERS; tier++)
+    {
+        if (ageS <= TIER_SPANS_S[tier])
+        {
+            return tier;
+        }
+    }
+    return NUM_TIERS - 1U;
+} // End PickTier().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ClearBucket()
+//
+// Empties an average.
+/////////////////////////////////////////////////////////////////////////////////
+void History::ClearBucket(Bucket &rBucket)
+{
+    rBucket.m_StartS = 0UL;
+    rBucket.m_Count  = 0UL;
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        rBucket.m_Sums[i]  = 0.0f;
+        rBucket.m_Valid[i] = 0U;
+    }
+} // End ClearBucket().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddToBucket()
+//
+// Adds a sample's valid values to an average.
+/////////////////////////////////////////////////////////////////////////////////
+void History::AddToBucket(Bucket &rBucket, const HistorySample &rSample)
+{
+    const float values[3] = {rSample.m_Grams, rSample.m_DegreesC, rSample.m_Humidity};
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        if (!std::isnan(values[i]))
+        {
+            rBucket.m_Sums[i] += values[i];
+            rBucket.m_Valid[i]++;
+        }
+    }
+    rBucket.m_Count++;
+} // End AddToBucket().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Average()
+//
+// Returns an average, with NaN for any value that had no valid samples.
+/////////////////////////////////////////////////////////////////////////////////
+HistorySample History::Average(const Bucket &rBucket)
+{
+    float values[3];
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        values[i] = (rBucket.m_Valid[i] > 0U) ? rBucket.m_Sums[i] / rBucket.m_Valid[i] :
+                                                NAN;
+    }
+    HistorySample average;
+    average.m_Grams    = values[0];
+    average.m_DegreesC = values[1];
+    average.m_Humidity = values[2];
+    return average;
+} // End Average().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Save()
+//
+// Saves the time, and the hourly blocks that have changed, to NVS.  Each block
+// has its own key, so an hourly save writes one block and the state rather
+// than the whole tier.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool History::Save()
+{
+    HistoryTier &rTier = *m_pTiers[SAVED_TIER];
+    if ((m_pName == NULL) || !rTier.IsInitialized())
+    {
+        return false;
+    }
+
+    bool status = true;
+    for (size_t b = 0U; b < rTier.GetUsed(); b++)
+    {
+        size_t index = (rTier.GetFirst() + b) % rTier.GetNumBlocks();
+        HistoryBlock *pBlock = rTier.GetBlock(index);
+        if (pBlock->m_Dirty)
+        {
+            // Saved clean, so that a restored block isn't written again.
+            char key[16];
+            snprintf(key, sizeof(key), pPrefBlockFormat, static_cast<unsigned>(index));
+            pBlock->m_Dirty = 0U;
+            if (!NvsStore::Put(m_pName, key, pBlock, sizeof(HistoryBlock)))
+            {
+                pBlock->m_Dirty = 1U;
+                status = false;
+            }
+        }
+    }
+
+    status &= SaveState();
+    return status;
+} // End Save().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveState()
+//
+// Saves the time and the hourly ring position to NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool History::SaveState()
+{
+    HistoryTier &rTier = *m_pTiers[SAVED_TIER];
+    if ((m_pName == NULL) || !rTier.IsInitialized())
+    {
+        return false;
+    }
+
+    SavedState state;
+    state.m_NowS  = m_NowS;
+    state.m_First = static_cast<uint16_t>(rTier.GetFirst());
+    state.m_Used  = static_cast<uint16_t>(rTier.GetUsed());
+    return NvsStore::Put(m_pName, pPrefStateLabel, &state, sizeof(state));
+} // End SaveState().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Restore()
+//
+// Restores the time and the hourly blocks from NVS.  The time is never put
+// before the end of the newest hourly sample, in case the blocks were saved
+// after the state was.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool History::Restore()
+{
+    HistoryTier &rTier = *m_pTiers[SAVED_TIER];
+    if ((m_pName == NULL) || !rTier.IsInitialized())
+    {
+        return false;
+    }
+
+    bool succeeded = false;
+    SavedState state;
+    if ((NvsStore::Get(m_pName, pPrefStateLabel, &state, sizeof(state)) == sizeof(state)) &&
+        (state.m_First < rTier.GetNumBlocks()) && (state.m_Used <= rTier.GetNumBlocks()))
+    {
+        succeeded = true;
+        for (size_t b = 0U; succeeded && (b < state.m_Used); b++)
+        {
+            size_t index = (state.m_First + b) % rTier.GetNumBlocks();
+            char key[16];
+            snprintf(key, sizeof(key), pPrefBlockFormat, static_cast<unsigned>(index));
+            succeeded = NvsStore::Get(m_pName, key, rTier.GetBlock(index),
+                                      sizeof(HistoryBlock)) == sizeof(HistoryBlock);
+        }
+        succeeded = succeeded && rTier.SetRing(state.m_First, state.m_Used);
+        if (succeeded)
+        {
+            m_NowS = state.m_NowS;
+            if (!rTier.IsEmpty() &&
+                (m_NowS < rTier.GetNewestTime() + rTier.GetPeriod()))
+            {
+                m_NowS = rTier.GetNewestTime() + rTier.GetPeriod();
+            }
+        }
+    }
+    return succeeded;
+} // End Restore().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Removes the saved history from NVS.  The namespace is ours alone.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool History::Reset()
+{
+    bool status = false;
+    if (m_pName != NULL)
+    {
+        status = NvsStore::Clear(m_pName);
+    }
+    return status;
+} // End Reset().
@@ -0,0 +1,173 @@
+/////////////////////////////////////////////////////////////////////////////////
+// History.h
+//
+// This class implements the History class.  It keeps the weight, temperature
+// and humidity history for graphing, in three HistoryTier objects:
+//    - 1 second samples for the last hour.
+//    - 1 minute samples for the last day.
+//    - 1 hour samples for the last 30 days.
+// Each tier's samples are the averages of the finer tier's (or, for the first
+// tier, of the readings), so a NaN reading only makes a sample NaN if every
+// reading averaged into it was NaN.
+//
+// The scale has no real time clock, so times are "history seconds": seconds
+// of uptime, carried on from the saved time at the next power up.  The time
+// the scale spends switched off is therefore left out of the history.
+//
+// The hourly tier is saved to NVS whenever an hourly sample is added (only the
+// blocks that changed are written), and the time whenever a minute sample is
+// added.  The finer tiers are kept in RAM only.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HISTORY_H
+#define HISTORY_H
+
+#include "HistoryTier.h"        // For HistoryTier class.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// History class
+/////////////////////////////////////////////////////////////////////////////////
+class History
+{
+public:
+    // Constructor.
+    History();
+
+
+    // Destructor.
+    virtual ~History() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Init()
+    //
+    // Allocates the tiers and restores the saved history, if any.
+    //
+    // Arguments:
+    //    - pName - A string of no more than MAX_NVS_NAME_LEN characters used
+    //              to identify the instance in NVS.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Init(const char *pName);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Update()
+    //
+    // Processes the latest readings.  Should be called several times a
+    // second.
+    //
+    // Arguments:
+    //    - rReading - The readings.  Any may be NaN.
+    //    - nowMs    - The current time (millis()).
+    /////////////////////////////////////////////////////////////////////////////
+    void Update(const HistorySample &rReading, uint32_t nowMs);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // PickTier()
+    //
+    // Chooses the finest tier that goes back far enough for a range.
+    //
+    // Arguments:
+    //    - fromS - Start of the range, in history seconds.
+    //
+    // Returns:
+    //    Returns the tier number.
+    /////////////////////////////////////////////////////////////////////////////
+    size_t PickTier(uint32_t fromS) const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Save(), Restore(), Reset()
+    //
+    // NVS handling for the hourly tier and the time.  Save() is also called by
+    // Update() each hour, and the time alone is saved each minute.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Save();
+    bool Restore();
+    bool Reset();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    uint32_t           GetNow()                 const { return m_NowS; }
+    const HistoryTier &GetTier(size_t tier)     const { return *m_pTiers[tier]; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const size_t   NUM_TIERS        = 3U;
+    static const size_t   SAVED_TIER       = NUM_TIERS - 1U;
+    static const size_t   CLOCK_TIER       = 1U;
+    static const size_t   MAX_NVS_NAME_LEN = 15U;
+    static const uint32_t TIER_PERIODS_S[NUM_TIERS];
+    static const uint32_t TIER_SPANS_S[NUM_TIERS];
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    History(History &rH);
+    History &operator=(History &rH);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Bucket averages the samples going into a tier.
+    /////////////////////////////////////////////////////////////////////////////
+    struct Bucket
+    {
+        uint32_t m_StartS;              // Start of the tier period.
+        uint32_t m_Count;               // Samples added (valid or not).
+        float    m_Sums[3];             // Sums of the valid values.
+        uint16_t m_Valid[3];            // Number of valid values.
+    };
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Helpers.  See History.cpp for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    bool AddToTier(size_t tier, uint32_t timeS, const HistorySample &rSample);
+    bool SaveState();
+    static void ClearBucket(Bucket &rBucket);
+    static void AddToBucket(Bucket &rBucket, const HistorySample &rSample);
+    static HistorySample Average(const Bucket &rBucket);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Private constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const char *pPrefStateLabel;
+    static const char *pPrefBlockFormat;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    const char  *m_pName;               // NVS name.
+    HistoryTier  m_Seconds;             // The tiers.
+    HistoryTier  m_Minutes;
+    HistoryTier  m_Hours;
+    HistoryTier *m_pTiers[NUM_TIERS];   // The tiers, finest first.
+    Bucket       m_Buckets[NUM_TIERS];  // Their averages being built.
+    uint32_t     m_NowS;                // The history time.
+    uint32_t     m_LastMs;              // millis() at the last update.
+    uint32_t     m_RemainderMs;         // Part second not yet counted.
+    bool         m_Started;             // m_LastMs is valid.
+
+}; // End class History.
+
+
+
+#endif // HISTORY_H
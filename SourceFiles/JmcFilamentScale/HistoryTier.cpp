@@ -0,0 +1,524 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryTier.cpp
+//
+// Contains methods defined by the HistoryTier class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Arduino.h>            // For ps_malloc() and psramFound().
+#include "HistoryTier.h"        // For HistoryTier class.
+#include <cmath>                // For lroundf(), NAN, ...
+#include <cstddef>              // For offsetof().
+#include <cstdlib>              // For malloc() and free().
+#include <cstring>              // For memset().
+
+
+// Exports send the key frame and the used deltas only.
+static_assert(offsetof(HistoryBlock, m_Deltas) == HistoryBlock::KEY_SIZE,
+              "HistoryBlock key frame size changed.");
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Quantize()
+//
+// Converts a value to tenths, or to the invalid value if it is NaN or out of
+// range.
+//
+// Arguments:
+//    - value   - The value.
+//    - limit   - The largest magnitude allowed, in tenths.
+//    - invalid - The invalid value.
+/////////////////////////////////////////////////////////////////////////////////
+static int32_t Quantize(float value, int32_t limit, int32_t invalid)
+{
+    if (std::isnan(value) || (fabsf(value) * 10.0f >= static_cast<float>(limit)))
+    {
+        return invalid;
+    }
+    return static_cast<int32_t>(lroundf(value * 10.0f));
+} // End Quantize().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ToFloat()
+//
+// Converts tenths back, with the invalid value as NaN.
+/////////////////////////////////////////////////////////////////////////////////
+static float ToFloat(int32_t tenths, int32_t invalid)
+{
+    return (tenths == invalid) ? NAN : static_cast<float>(tenths) / 10.0f;
+} // End ToFloat().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MakeDelta()
+//
+// Works out one channel's delta.  A missing value is stored as the invalid
+// delta and leaves the channel's last value as it was.
+//
+// Arguments:
+//    - value        - The new value, in tenths.
+//    - invalid      - The channel's invalid value.
+//    - rLast        - The channel's last valid value.  Updated.
+//    - limit        - The largest delta magnitude that fits.
+//    - invalidDelta - The invalid delta.
+//    - rDelta       - Set to the delta.
+//
+// Returns:
+//    Returns 'true' if the delta fits, or 'false' if a new block is needed.
+/////////////////////////////////////////////////////////////////////////////////
+static bool MakeDelta(int32_t value, int32_t invalid, int32_t &rLast,
+                      int32_t limit, int32_t invalidDelta, int32_t &rDelta)
+{
+    if (value == invalid)
+    {
+        rDelta = invalidDelta;
+        return true;
+    }
+    if (rLast == invalid)
+    {
+        return false;
+    }
+    int64_t delta = static_cast<int64_t>(value) - rLast;
+    if ((delta > limit) || (delta < -limit))
+    {
+        return false;
+    }
+    rDelta = static_cast<int32_t>(delta);
+    rLast  = value;
+    return true;
+} // End MakeDelta().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ApplyDelta()
+//
+// Decodes one channel's delta.
+//
+// Arguments:
+//    - delta        - The delta.
+//    - invalidDelta - The invalid delta.
+//    - rLast        - The channel's last valid value.  Updated.
+//    - invalid      - The channel's invalid value.
+//
+// Returns:
+//    Returns the value, in tenths, or the invalid value.
+/////////////////////////////////////////////////////////////////////////////////
+static int32_t ApplyDelta(int32_t delta, int32_t invalidDelta, int32_t &rLast,
+                          int32_t invalid)
+{
+    if ((delta == invalidDelta) || (rLast == invalid))
+    {
+        return invalid;
+    }
+    rLast += delta;
+    return rLast;
+} // End ApplyDelta().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - periodS   - Seconds between samples.
+//    - numBlocks - Blocks in the ring (BLOCK_SAMPLES samples each).
+/////////////////////////////////////////////////////////////////////////////////
+HistoryTier::HistoryTier(uint32_t periodS, size_t numBlocks) :
+    m_PeriodS(periodS), m_NumBlocks(numBlocks), m_pBlocks(NULL)
+{
+    Clear();
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Destructor.
+/////////////////////////////////////////////////////////////////////////////////
+HistoryTier::~HistoryTier()
+{
+    free(m_pBlocks);
+} // End destructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Init()
+//
+// Allocates the blocks.  The history is only ever read by the web server, so
+// the slower PSRAM is used if the board has it, leaving internal RAM for
+// everything else.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if out of memory.
+/////////////////////////////////////////////////////////////////////////////////
+bool HistoryTier::Init()
+{
+    if (m_pBlocks == NULL)
+    {
+        size_t size = m_NumBlocks * sizeof(HistoryBlock);
+        void *pMemory = NULL;
+#if defined ARDUINO_ARCH_ESP32
+        if (psramFound())
+        {
+            pMemory = ps_malloc(size);
+        }
+#endif // ARDUINO_ARCH_ESP32
+        if (pMemory == NULL)
+        {
+            pMemory = malloc(size);
+        }
+        m_pBlocks = static_cast<HistoryBlock *>(pMemory);
+        if (m_pBlocks != NULL)
+        {
+            memset(m_pBlocks, 0, size);
+        }
+        Clear();
+    }
+    return m_pBlocks != NULL;
+} // End Init().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Clear()
+//
+// Discards all of the samples.  Blocks given back to NVS by a later save are
+// simply left unused.
+/////////////////////////////////////////////////////////////////////////////////
+void HistoryTier::Clear()
+{
+    m_First        = 0U;
+    m_Used         = 0U;
+    m_Open         = false;
+    m_LastWeight   = INVALID_WEIGHT;
+    m_LastTemp     = INVALID_16;
+    m_LastHumidity = INVALID_16;
+} // End Clear().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Add()
+//
+// Quantizes a sample and appends it to the newest block if it follows on from
+// the last sample and its deltas fit, or starts a new block otherwise.
+//
+// Arguments:
+//    - timeS   - The sample's time, in seconds.
+//    - rSample - The sample.
+/////////////////////////////////////////////////////////////////////////////////
+void HistoryTier::Add(uint32_t timeS, const HistorySample &rSample)
+{
+    if (m_pBlocks == NULL)
+    {
+        return;
+    }
+
+    int32_t weight   = Quantize(rSample.m_Grams, INT32_MAX, INVALID_WEIGHT);
+    int16_t temp     = static_cast<int16_t>(
+                           Quantize(rSample.m_DegreesC, INT16_MAX, INVALID_16));
+    int16_t humidity = static_cast<int16_t>(
+                           Quantize(rSample.m_Humidity, INT16_MAX, INVALID_16));
+
+    if (!m_Open ||
+        !AppendDelta(m_pBlocks[(m_First + m_Used - 1U) % m_NumBlocks],
+                     timeS, weight, temp, humidity))
+    {
+        StartBlock(timeS, weight, temp, humidity);
+    }
+} // End Add().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AppendDelta()
+//
+// Adds a sample to a block as a delta.
+//
+// Arguments:
+//    - rBlock   - The newest block.
+//    - timeS    - The sample's time.
+//    - weight   - The quantized values.
+//    - temp
+//    - humidity
+//
+// Returns:
+//    Returns 'true' if the sample was added, or 'false' if it needs a new
+//    block (leaving this one as it was).
+/////////////////////////////////////////////////////////////////////////////////
+bool HistoryTier::AppendDelta(HistoryBlock &rBlock, uint32_t timeS,
+                              int32_t weight, int16_t temp, int16_t humidity)
+{
+    if ((rBlock.m_Count >= HistoryBlock::BLOCK_SAMPLES) ||
+        (timeS != rBlock.m_StartS + rBlock.m_Count * m_PeriodS))
+    {
+        return false;
+    }
+
+    // Work on copies so that a delta that doesn't fit changes nothing.
+    int32_t lastWeight   = m_LastWeight;
+    int32_t lastTemp     = m_LastTemp;
+    int32_t lastHumidity = m_LastHumidity;
+    int32_t dWeight      = 0L;
+    int32_t dTemp        = 0L;
+    int32_t dHumidity    = 0L;
+    if (!MakeDelta(weight, INVALID_WEIGHT, lastWeight, INT16_MAX, INVALID_16,
+                   dWeight) ||
+        !MakeDelta(temp, INVALID_16, lastTemp, INT8_MAX, INVALID_8, dTemp) ||
+        !MakeDelta(humidity, INVALID_16, lastHumidity, INT8_MAX, INVALID_8,
+                   dHumidity))
+    {
+        return false;
+    }
+
+    HistoryDelta &rDelta = rBlock.m_Deltas[rBlock.m_Count - 1U];
+    rDelta.m_Weight   = static_cast<int16_t>(dWeight);
+    rDelta.m_Temp     = static_cast<int8_t>(dTemp);
+    rDelta.m_Humidity = static_cast<int8_t>(dHumidity);
+    rBlock.m_Count++;
+    rBlock.m_Dirty    = 1U;
+    m_LastWeight      = lastWeight;
+    m_LastTemp        = static_cast<int16_t>(lastTemp);
+    m_LastHumidity    = static_cast<int16_t>(lastHumidity);
+    return true;
+} // End AppendDelta().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// StartBlock()
+//
+// Starts a new block with a key frame, discarding the oldest block if the
+// ring is full.
+//
+// Arguments:
+//    - timeS    - The sample's time.
+//    - weight   - The quantized values.
+//    - temp
+//    - humidity
+/////////////////////////////////////////////////////////////////////////////////
+void HistoryTier::StartBlock(uint32_t timeS, int32_t weight, int16_t temp,
+                             int16_t humidity)
+{
+    if (m_Used == m_NumBlocks)
+    {
+        m_First = (m_First + 1U) % m_NumBlocks;
+        m_Used--;
+    }
+    HistoryBlock &rBlock = m_pBlocks[(m_First + m_Used) % m_NumBlocks];
+    m_Used++;
+
+    rBlock.m_StartS   = timeS;
+    rBlock.m_Weight   = weight;
+    rBlock.m_Temp     = temp;
+    rBlock.m_Humidity = humidity;
+    rBlock.m_Count    = 1U;
+    rBlock.m_Dirty    = 1U;
+    rBlock.m_Reserved = 0U;
+
+    m_Open         = true;
+    m_LastWeight   = weight;
+    m_LastTemp     = temp;
+    m_LastHumidity = humidity;
+} // End StartBlock().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Visit()
+//
+// Decodes the blocks that overlap the range and calls the visitor for each of
+// their samples within it.  Blocks are in time order, so those wholly before
+// the range are skipped without decoding, and the visit ends at the first
+// block after it.
+//
+// Arguments:
+//    - fromS    - Start of the range, in seconds (inclusive).
+//    - toS      - End of the range, in seconds (exclusive).
+//    - pVisitor - The function to call.
+//    - pArg     - Passed to the visitor.
+//
+// Returns:
+//    Returns the number of samples visited.
+/////////////////////////////////////////////////////////////////////////////////
+size_t HistoryTier::Visit(uint32_t fromS, uint32_t toS, HistoryVisitor pVisitor,
+                          void *pArg) const
+{
+    size_t visited = 0U;
+    for (size_t b = 0U; b < m_Used; b++)
+    {
+        const HistoryBlock &rBlock = m_pBlocks[(m_First + b) % m_NumBlocks];
+        uint32_t lastS = rBlock.m_StartS + (rBlock.m_Count - 1U) * m_PeriodS;
+        if (lastS < fromS)
+        {
+            continue;
+        }
+        if (rBlock.m_StartS >= toS)
+        {
+            break;
+        }
+
+        int32_t weight   = rBlock.m_Weight;
+        int32_t temp     = rBlock.m_Temp;
+        int32_t humidity = rBlock.m_Humidity;
+        int32_t lastWeight   = weight;
+        int32_t lastTemp     = temp;
+        int32_t lastHumidity = humidity;
+        for (uint32_t i = 0U; i < rBlock.m_Count; i++)
+        {
+            if (i > 0U)
+            {
+                const HistoryDelta &rDelta = rBlock.m_Deltas[i - 1U];
+                weight   = ApplyDelta(rDelta.m_Weight, INVALID_16, lastWeight,
+                                      INVALID_WEIGHT);
+                temp     = ApplyDelta(rDelta.m_Temp, INVALID_8, lastTemp,
+                                      INVALID_16);
+                humidity = ApplyDelta(rDelta.m_Humidity, INVALID_8, lastHumidity,
+                                      INVALID_16);
+            }
+
+            uint32_t timeS = rBlock.m_StartS + i * m_PeriodS;
+            if (timeS >= toS)
+            {
+                return visited;
+            }
+            if (timeS >= fromS)
+            {
+                HistorySample sample;
+                sample.m_Grams    = ToFloat(weight, INVALID_WEIGHT);
+                sample.m_DegreesC = ToFloat(temp, INVALID_16);
+                sample.m_Humidity = ToFloat(humidity, INVALID_16);
+                visited++;
+                if (!pVisitor(timeS, sample, pArg))
+                {
+                    return visited;
+                }
+            }
+        }
+    }
+    return visited;
+} // End Visit().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// VisitBlocks()
+//
+// Calls the visitor for each block that overlaps the range, without decoding
+// them.
+//
+// Arguments:
+//    - fromS    - Start of the range, in seconds (inclusive).
+//    - toS      - End of the range, in seconds (exclusive).
+//    - pVisitor - The function to call.
+//    - pArg     - Passed to the visitor.
+//
+// Returns:
+//    Returns the number of blocks visited.
+/////////////////////////////////////////////////////////////////////////////////
+size_t HistoryTier::VisitBlocks(uint32_t fromS, uint32_t toS,
+                                HistoryBlockVisitor pVisitor, void *pArg) const
+{
+    size_t visited = 0U;
+    for (size_t b = 0U; b < m_Used; b++)
+    {
+        const HistoryBlock &rBlock = m_pBlocks[(m_First + b) % m_NumBlocks];
+        if (rBlock.m_StartS >= toS)
+        {
+            break;
+        }
+        if (rBlock.m_StartS + (rBlock.m_Count - 1U) * m_PeriodS >= fromS)
+        {
+            visited++;
+            if (!pVisitor(rBlock, pArg))
+            {
+                break;
+            }
+        }
+    }
+    return visited;
+} // End VisitBlocks().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetRing()
+//
+// Sets the ring position after the blocks have been restored.  The blocks in
+// use must all hold samples and be in time order.
+//
+// Arguments:
+//    - first - The oldest block.
+//    - used  - The number of blocks in use.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' (leaving the tier empty) if the
+//    blocks don't make sense.
+/////////////////////////////////////////////////////////////////////////////////
+bool HistoryTier::SetRing(size_t first, size_t used)
+{
+    Clear();
+    if ((m_pBlocks == NULL) || (first >= m_NumBlocks) || (used > m_NumBlocks))
+    {
+        return false;
+    }
+
+    uint32_t nextS = 0UL;
+    for (size_t b = 0U; b < used; b++)
+    {
+        const HistoryBlock &rBlock = m_pBlocks[(first + b) % m_NumBlocks];
+        if ((rBlock.m_Count == 0U) ||
+            (rBlock.m_Count > HistoryBlock::BLOCK_SAMPLES) ||
+            (rBlock.m_StartS < nextS))
+        {
+            return false;
+        }
+        nextS = rBlock.m_StartS + rBlock.m_Count * m_PeriodS;
+    }
+
+    // The restored values of the newest block are not known without decoding
+    // it, so the next sample starts a block of its own.
+    m_First = first;
+    m_Used  = used;
+    return true;
+} // End SetRing().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetOldestTime()
+//
+// Returns the time of the oldest sample, or 0 if there are none.
+/////////////////////////////////////////////////////////////////////////////////
+uint32_t HistoryTier::GetOldestTime() const
+{
+    return (m_Used > 0U) ? m_pBlocks[m_First].m_StartS : 0UL;
+} // End GetOldestTime().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetNewestTime()
+//
+// Returns the time of the newest sample, or 0 if there are none.  A block's
+// samples are one period apart, so this is found from the newest block's
+// start and count.
+/////////////////////////////////////////////////////////////////////////////////
+uint32_t HistoryTier::GetNewestTime() const
+{
+    if (m_Used == 0U)
+    {
+        return 0UL;
+    }
+    const HistoryBlock &rBlock = m_pBlocks[(m_First + m_Used - 1U) % m_NumBlocks];
+    return rBlock.m_StartS + (rBlock.m_Count - 1UL) * m_PeriodS;
+} // End GetNewestTime().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetNumSamples()
+//
+// Returns the number of samples held.
+/////////////////////////////////////////////////////////////////////////////////
+size_t HistoryTier::GetNumSamples() const
+{
+    size_t samples = 0U;
+    for (size_t b = 0U; b < m_Used; b++)
+    {
+        samples += m_pBlocks[(m_First + b) % m_NumBlocks].m_Count;
+    }
+    return samples;
+} // End GetNumSamples().
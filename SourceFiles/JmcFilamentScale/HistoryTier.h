@@ -0,0 +1,238 @@
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryTier.h
+//
+// This class implements the HistoryTier class.  It keeps a time series of
+// weight, temperature and humidity samples taken every m_PeriodS seconds, in a
+// fixed ring of delta encoded blocks.
+//
+// Each block starts with a key frame (the time and the absolute values of its
+// first sample) followed by up to BLOCK_SAMPLES - 1 deltas, one per period.
+// The values are quantized to 0.1 g, 0.1 C and 0.1 %, so a delta takes four
+// bytes against the twelve of the floats.  A new block is started when the
+// current one is full, when a period is missed (a gap in the series), or when
+// a delta won't fit.  The oldest block is discarded when the ring is full.
+//
+// A missing value (e.g. a NaN from the sensor) is stored as INVALID, and is
+// returned as NaN.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined HISTORYTIER_H
+#define HISTORYTIER_H
+
+#include <cstddef>              // For size_t.
+#include <cstdint>              // For uint32_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistorySample holds one sample.  Any value may be NaN if unknown.
+/////////////////////////////////////////////////////////////////////////////////
+struct HistorySample
+{
+    float m_Grams;                      // Net weight.
+    float m_DegreesC;                   // Temperature.
+    float m_Humidity;                   // Relative humidity, percent.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryVisitor is called by HistoryTier::Visit() for each sample.  Returns
+// 'false' to stop the visit.
+/////////////////////////////////////////////////////////////////////////////////
+typedef bool (*HistoryVisitor)(uint32_t timeS, const HistorySample &rSample,
+                               void *pArg);
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryBlockVisitor is called by HistoryTier::VisitBlocks() for each block.
+// Returns 'false' to stop the visit.
+/////////////////////////////////////////////////////////////////////////////////
+struct HistoryBlock;
+typedef bool (*HistoryBlockVisitor)(const HistoryBlock &rBlock, void *pArg);
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryDelta is the change from the previous sample of a block.
+/////////////////////////////////////////////////////////////////////////////////
+struct HistoryDelta
+{
+    int16_t m_Weight;                   // 0.1 g.
+    int8_t  m_Temp;                     // 0.1 C.
+    int8_t  m_Humidity;                 // 0.1 %.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryBlock is a key frame and the deltas that follow it.  Blocks are saved
+// to NVS, and exported, as they are.  Only the first m_Count - 1 deltas are
+// used; a missing value's delta is INVALID_16 or INVALID_8, and the next delta
+// of that value is from the last one that was present.
+/////////////////////////////////////////////////////////////////////////////////
+struct HistoryBlock
+{
+    static const size_t BLOCK_SAMPLES = 32U;
+    static const size_t KEY_SIZE      = 16U;  // Bytes before m_Deltas.
+
+    uint32_t     m_StartS;              // Time of the first sample.
+    int32_t      m_Weight;              // First sample, 0.1 g.
+    int16_t      m_Temp;                // First sample, 0.1 C.
+    int16_t      m_Humidity;            // First sample, 0.1 %.
+    uint8_t      m_Count;               // Samples in the block.
+    uint8_t      m_Dirty;               // Changed since last saved.
+    uint16_t     m_Reserved;
+    HistoryDelta m_Deltas[BLOCK_SAMPLES - 1U];
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryTier class
+/////////////////////////////////////////////////////////////////////////////////
+class HistoryTier
+{
+public:
+    // Constructor.  Nothing is kept until Init() succeeds.
+    HistoryTier(uint32_t periodS, size_t numBlocks);
+
+
+    // Destructor.
+    virtual ~HistoryTier();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Init()
+    //
+    // Allocates the blocks, from PSRAM if the board has it.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if out of memory.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Init();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Add()
+    //
+    // Appends a sample.
+    //
+    // Arguments:
+    //    - timeS   - The sample's time, in seconds.  Must be later than the
+    //                last sample's.
+    //    - rSample - The sample.
+    /////////////////////////////////////////////////////////////////////////////
+    void Add(uint32_t timeS, const HistorySample &rSample);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Visit()
+    //
+    // Calls a visitor for each sample in a time range, oldest first.
+    //
+    // Arguments:
+    //    - fromS    - Start of the range, in seconds (inclusive).
+    //    - toS      - End of the range, in seconds (exclusive).
+    //    - pVisitor - The function to call.
+    //    - pArg     - Passed to the visitor.
+    //
+    // Returns:
+    //    Returns the number of samples visited.
+    /////////////////////////////////////////////////////////////////////////////
+    size_t Visit(uint32_t fromS, uint32_t toS, HistoryVisitor pVisitor,
+                 void *pArg) const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // VisitBlocks()
+    //
+    // Calls a visitor for each block holding samples in a time range, oldest
+    // first.  The first and last blocks may also hold samples outside it.
+    //
+    // Arguments:
+    //    - fromS    - Start of the range, in seconds (inclusive).
+    //    - toS      - End of the range, in seconds (exclusive).
+    //    - pVisitor - The function to call.
+    //    - pArg     - Passed to the visitor.
+    //
+    // Returns:
+    //    Returns the number of blocks visited.
+    /////////////////////////////////////////////////////////////////////////////
+    size_t VisitBlocks(uint32_t fromS, uint32_t toS, HistoryBlockVisitor pVisitor,
+                       void *pArg) const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Clear()
+    //
+    // Discards all of the samples.
+    /////////////////////////////////////////////////////////////////////////////
+    void Clear();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Block access, for saving to and restoring from NVS.  Blocks are numbered
+    // by their position in the ring.  SetRing() checks the restored blocks and
+    // always starts a new block for the next sample.
+    /////////////////////////////////////////////////////////////////////////////
+    HistoryBlock *GetBlock(size_t index)    { return &m_pBlocks[index]; }
+    size_t        GetFirst()          const { return m_First; }
+    size_t        GetUsed()           const { return m_Used; }
+    bool          SetRing(size_t first, size_t used);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    bool     IsInitialized()          const { return m_pBlocks != NULL; }
+    uint32_t GetPeriod()              const { return m_PeriodS; }
+    size_t   GetNumBlocks()           const { return m_NumBlocks; }
+    bool     IsEmpty()                const { return m_Used == 0U; }
+    uint32_t GetOldestTime()          const;
+    uint32_t GetNewestTime()          const;
+    size_t   GetNumSamples()          const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const int32_t INVALID_WEIGHT = INT32_MIN;
+    static const int16_t INVALID_16     = INT16_MIN;
+    static const int8_t  INVALID_8      = INT8_MIN;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    HistoryTier(HistoryTier &rHt);
+    HistoryTier &operator=(HistoryTier &rHt);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Helpers.  See HistoryTier.cpp for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    bool AppendDelta(HistoryBlock &rBlock, uint32_t timeS, int32_t weight,
+                     int16_t temp, int16_t humidity);
+    void StartBlock(uint32_t timeS, int32_t weight, int16_t temp,
+                    int16_t humidity);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    const uint32_t m_PeriodS;           // Seconds between samples.
+    const size_t   m_NumBlocks;         // Blocks in the ring.
+    HistoryBlock  *m_pBlocks;           // The ring.
+    size_t         m_First;             // Oldest block.
+    size_t         m_Used;              // Blocks in use.
+
+    // The values of the latest sample, which the next delta is from.
+    bool           m_Open;              // The newest block takes deltas.
+    int32_t        m_LastWeight;
+    int16_t        m_LastTemp;
+    int16_t        m_LastHumidity;
+
+}; // End class HistoryTier.
+
+
+
+#endif // HISTORYTIER_H
@@ -1,1137 +1,1339 @@
-/////////////////////////////////////////////////////////////////////////////////
-// JmcFilamentScale.ino
-//
-// Implements a filament scale with the following features:
-//   - Menu driven settings.
-//   - Selectable weight units display (g, kg, oz, lb).
-//   - Weigh items up to 5kg (11 lb).
-//   - Addjustable display brightness.
-//   - Built-in temperature display.
-//   - Built-in humidity display.
-//   - Selectable temperature units (degrees C or F).
-//   - Storage for data for up to 15 filament spools.
-//   - Adjustable spool parameters include:
-//      - Spool name (up to 8 characters).
-//      - Filament type (15 selectable filament types).
-//      - Empty spool weight.
-//      - Filament diameter.
-//   - Adjustable filament density for eoach of the 15 filament types.
-//   - Calculation and display of remaining length of filament per spool.
-//   - Selectable filament length units (mm, cm, m, in, ft, yd).
-//   - Ability to save settings to NVS for restoration on powerup.
-//   - Web interface with ability to monitor all data and modify all options
-//     remotely.
-//
-//  This implementation relies heavily on the ArdiunoMenu library:
-//      https://github.com/neu-rah/ArduinoMenu
-//
-// This code is menat to run on an ESP32 microprocessor with the following or
-// similar peripherals:
-//      - Adafruit HUZZAH32 - ESP32 Feather Board.
-//        https://www.adafruit.com/product/3405
-//      - Adafruit 1.8" 128x160  TFT display.
-//        https://www.adafruit.com/product/358
-//      - 5kg Load Cell and HX711.
-//        https://www.amazon.com/gp/product/B075317R45/ref=ppx_yo_dt_b_asin_title_o02_s00?ie=UTF8&psc=1
-//      - DHT22 Digital Temperature and Himidity Sensor.
-//        https://www.amazon.com/gp/product/B07T63JRT8/ref=ppx_yo_dt_b_asin_title_o00_s00?ie=UTF8&psc=1
-//      - Rotaty Encoder with Pushbutton Module.
-//        https://www.amazon.com/gp/product/B081YCR3JC/ref=ppx_yo_dt_b_asin_title_o04_s00?ie=UTF8&psc=1
-//
-// This project was inspired by an article in "Nuts and Volts" magazine
-// 2019 Issue-4.  The article is entitled "Build a 3D Printer Filament Scale" by
-// Edward Andrews.  I used a few small code fragments from the article, and the
-// filament density table from the article.  Additional inspiration was gathered
-// from "Filament Health Monitor" at https://replicantfx.com/filament-health-monitor/
-//
-// History:
-// - jmcorbett 04-JAN-2021 Original creation.
-//
-// Copyright (c) 2021, Joseph M. Corbett
-/////////////////////////////////////////////////////////////////////////////////
-
-#include "JmcFilamentScale.h"   // For global variables and extern definitioins.
-#include <menu.h>               // For ArduinoMenu.
-#include <menuIO/adafruitGfxOut.h>// For Adafruit graphics library.
-#include <menuIO/chainStream.h> // For menu input/output streams.
-#include <menuIO/serialOut.h>   // For menu serial output.
-#include <menuIO/serialIn.h>    // For menu serial input.
-#include <plugin/userMenu.h>    // For OBJ menu macro.
-#include "ESP32EncoderStream.h" // For encoder w/pushbutton.
-#include "MainScreen.h"         // For MainScreen related stuff.
-#include "WebData.h"            // For web page handling code.
-#include "ScaleMenu.h"          // For menu  related stuff.
-#include "AuxPb.h"              // For AuxPb class.
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// ST7735 1.8TFT 128x160 Pin assignments and related variables.
-/////////////////////////////////////////////////////////////////////////////////
-static const int TFT_CS   = 14;     // TFT display CS pin.
-static const int TFT_DC   = 32;     // TFT display DC pin.
-static const int TFT_RST  = 15;     // TFT display RST pin.
-static const int TFT_LITE = A0;     // TFT display backlight pin.
-
-// Construct our TFT  object.
-// Adafruit_ST7735 gTft(TFT_CS, TFT_DC, TFT_RST);
-Display gTft(TFT_CS, TFT_DC, TFT_RST, TFT_LITE);
-
-// TFT related globals and constants.
-uint32_t           gBacklightPercent = 100;
-static const char *gTftNvsName       = "Dispaly";
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Rotary encoder pins.
-/////////////////////////////////////////////////////////////////////////////////
-static const int ENC_PIN_A      = A3;   // Encoder A pin.
-static const int ENC_PIN_B      = A4;   // Encoder B pin.
-static const int ENC_BUTTON_PIN = 13;   // Encoder pushbutton pin.
-static const int ENC_SENSITIVITY = 4;   // Encoder sensitivity.
-
-// Construct the pushbutton encoder stream object.  Note that some encoders will
-// require the sensitivity to be set to a different value.
-ESP32EncoderStream gEncStream(ENC_PIN_A, ENC_PIN_B, ENC_BUTTON_PIN, ENC_SENSITIVITY);
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Auxiliary pushbutton pins.
-/////////////////////////////////////////////////////////////////////////////////
-static const int AUX_BUTTON_PIN = A1;   // Auxiliary pushbutton pin.
-
-// Construct the auxiliary pushbutton object.
-AuxPb gAuxPb(AUX_BUTTON_PIN);
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Define the LoadCell sensor related I/O pins and global data and constants.
-/////////////////////////////////////////////////////////////////////////////////
-static const int LOADCELL_DOUT_PIN  = A2;   // LoadCell DOUT signal pin.
-static const int LOADCELL_SCK_PIN   = A5;   // LoadCell CLOCK pin.
-
-// Construct and init the LoadCell object.
-LoadCell gLoadCell(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN, 128U);
-
-// Load cell related globals and constants.
-       WeightUnits gScaleUnits        = eWuGrams;
-       uint32_t    gScaleAveragingSamples =
-                   (AVG_SAMPLES_DEFAULT_MS + WEIGHT_UPDATE_PERIOD_MS / 2) /
-                   WEIGHT_UPDATE_PERIOD_MS;
-       uint8_t     gScaleGain         = 128;
-static const char *gLoadCellNvsName   = "Load Cell";
-       float       gCurrentWeight     = 0.0f;
-       float       gCurrentLength     = 0.0f;
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Define the environmental sensor (temperature and humidity) pins and global
-// data and constants.
-/////////////////////////////////////////////////////////////////////////////////
-static const uint8_t ENV_DAT_PIN    = 27;   // Sensor data pin.
-static const uint8_t ENV_TYPE       = DHT22;// Sensor type.
-
-// Construct and init the EnvSensor object.
-EnvSensor gEnvSensor(ENV_DAT_PIN, ENV_TYPE);
-
-// Environmental sensor related globals and constants.
-TempScale gTemperatureUnits     = eTempScaleF;
-static const char *gEnvSensorNvsName   = "Env Sensor";
-       float       gCurrentTemperature = 0.0f;
-       float       gCurrentHumidity    = 0.0f;
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Filament class related data and constants.
-/////////////////////////////////////////////////////////////////////////////////
-Filament gFilament;
-
-// Filament related global data and constants.
-       float  gWorkingFilamentDensity = 0.01;
-       char   gWorkingFilamentType[Filament::TYPE_STRING_MAX_SIZE] = { 0 };
-static const char *gFilamentNvsName  = "Filament";
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Spool Manager related data and constants.
-/////////////////////////////////////////////////////////////////////////////////
-SpoolManager<NUMBER_SPOOLS> gSpoolMgr;
-
-// Set up spool related global data.  Used for dynamic menu implementation.
-       SpoolData gWorkingSpoolData; // Spool data currently being worked om.
-static const char *gSpoolMgrNvsName  = "Spool Mgr";
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// LengthManager related data and constants.
-/////////////////////////////////////////////////////////////////////////////////
-LengthManager gLengthMgr;
-
-// Length manager related globals and constants.
-static const       LengthUnits DEFAULT_LENGTH_UNITS = luMm;
-                   LengthUnits  gLengthUnits        = DEFAULT_LENGTH_UNITS;
-static float       gLengthFactor                    = 0.0;
-static const char *gLengthMgrNvsName                = "Length Mgr";
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Network related data and constants.
-/////////////////////////////////////////////////////////////////////////////////
-static const int   SERVER_PORT = 80;
-       Network     gNetwork(SERVER_PORT);
-
-// NVS name.
-static const char *gNetworkNvsName    = "Network";
-
-// Access the scale via this name (i.e. http://JmcScale.local).
-const char *gNetworkServerName = "JmcScale";
-const char * &rNetworkServerName = gNetworkServerName;
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Main Screen related data and constants.
-/////////////////////////////////////////////////////////////////////////////////
-static const char *gMainScreenNvsName = "Main Screen";
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Weight related data.
-/////////////////////////////////////////////////////////////////////////////////
-static const  double MAX_CAL_WEIGHT = 5000.0;
-static const  double MIN_CAL_WEIGHT = 0.0;
-       double gCalibrateWeight      = MIN_CAL_WEIGHT;
-       double gMinWeight            = MIN_CAL_WEIGHT;
-       double gMaxWeight            = MAX_CAL_WEIGHT;
-       double gBigWeightStep        = 10.0;
-       double gSmallWeightStep      = .1;
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Miscellaneous globals.
-/////////////////////////////////////////////////////////////////////////////////
-       bool   gRunningMenu          = false;
-       bool   gDataUpdated          = false;
-
-/////////////////////////////////////////////////////////////////////////////////
-// SetDecimalPlaces()
-//
-// Rounds a double value to a specified precision (number of digits to the right
-// of the decimal point).
-//
-// Arguments:
-//  value     - this is the value that will be rounded.
-//  precision - this is the number of digits to the right of the decimal point
-//              to keep.
-//
-// Returns:
-//   Returns the rounded value.
-/////////////////////////////////////////////////////////////////////////////////
-double SetDecimalPlaces(double value, int precision)
-{
-    double factor = pow(10, precision);
-    value *= factor;
-    value = ceil(value);
-    value /= factor;
-    return value;
-}
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// GetMinScaleWeight()
-//
-// Returns the minimum allowable scale weight given the current weight units.
-// Currently always returns 0.0.  May change in the future.
-/////////////////////////////////////////////////////////////////////////////////
-static double GetMinScaleWeight()
-{
-    double minWeight = 0.0;
-    switch(gLoadCell.GetUnits())
-    {
-    case eWuGrams:     minWeight = 0.0; break;
-    case eWuKiloGrams: minWeight = 0.0; break;
-    case eWuOunces:    minWeight = 0.0; break;
-    case eWuPounds:    minWeight = 0.0; break;
-    default:           minWeight = 0.0; break;
-    }
-    return minWeight;
-} // End GetMinScaleWeight().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// GetMaxScaleWeight()
-//
-// Returns the maximum allowable scale weight given the current weight units.
-/////////////////////////////////////////////////////////////////////////////////
-double GetMaxScaleWeight()
-{
-    double maxWeight = 10.0;
-    switch(gLoadCell.GetUnits())
-    {
-    case eWuGrams:     maxWeight = 5000.0; break;
-    case eWuKiloGrams: maxWeight = 5.0;    break;
-    case eWuOunces:    maxWeight = 176.37; break;
-    case eWuPounds:    maxWeight = 11.02;  break;
-    default:           maxWeight = 5000.0; break;
-    }
-    return maxWeight;
-} // End GetMaxScaleWeight().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// GetWeightBigStep()
-//
-// Returns the size of a large step for when editing weight values based on
-// the currently selected weight units.
-/////////////////////////////////////////////////////////////////////////////////
-static double GetWeightBigStep()
-{
-    double step = 10.0;
-    switch(gLoadCell.GetUnits())
-    {
-    case eWuGrams:     step = 10.0; break;
-    case eWuKiloGrams: step = 0.01; break;
-    case eWuOunces:    step = 1.0;  break;
-    case eWuPounds:    step = 0.1;  break;
-    default:           step = 10.0; break;
-    }
-    return step;
-} // End GetWeightBigStep().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// GetWeightSmallStep()
-//
-// Returns the size of a small step for when editing weight values based on
-// the currently selected weight units.
-/////////////////////////////////////////////////////////////////////////////////
-static double GetWeightSmallStep()
-{
-    double step = 0.1;
-    switch(gLoadCell.GetUnits())
-    {
-    case eWuGrams:     step = 0.1;    break;
-    case eWuKiloGrams: step = 0.0001; break;
-    case eWuOunces:    step = 0.01;   break;
-    case eWuPounds:    step = 0.001;  break;
-    default:           step = 0.1;    break;
-    }
-    return step;
-} // End GetWeightSmallStep().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// GetWeightDecimalPlaces()
-//
-// Returns the number of digits to display to the right of the decimal point
-// based on the currently selected weight units.
-/////////////////////////////////////////////////////////////////////////////////
-int GetWeightDecimalPlaces()
-{
-        int decimalPlaces = 1;
-        switch(gLoadCell.GetUnits())
-        {
-        case eWuGrams:     decimalPlaces = 1; break;
-        case eWuKiloGrams: decimalPlaces = 4; break;
-        case eWuOunces:    decimalPlaces = 2; break;
-        case eWuPounds:    decimalPlaces = 3; break;
-        default:           decimalPlaces = 1; break;
-        }
-        return decimalPlaces;
-} // End GetWeightDecimalPlaces().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SaveSpoolOffset()
-//
-// If a spool is selected, then save its offset value as the current load cell
-// offset.  Otherwise, save a value of 0.0.
-/////////////////////////////////////////////////////////////////////////////////
-void SaveSpoolOffset()
-{
-    double currentSpoolOffset = 0.0;
-
-    Spool *pSelectedSpool = gSpoolMgr.GetSelectedSpool();
-    if (pSelectedSpool != NULL)
-    {
-        currentSpoolOffset = pSelectedSpool->GetSpoolWeight();
-    }
-    gLoadCell.SetOffset(currentSpoolOffset);
-} // End SaveSpoolOffset().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// UpdateLengthFactor()
-//
-// If a spool is selected, then update our length factor.  Otherwise, save a
-// value of 0.0.
-/////////////////////////////////////////////////////////////////////////////////
-void UpdateLengthFactor()
-{
-    // Initially reset the length factor.
-    gLengthFactor = 0.0;
-
-    // Only update the length factor if a spool is selected.
-    Spool *pSelectedSpool = gSpoolMgr.GetSelectedSpool();
-    if ((gLoadCell.IsCalibrated()) && (pSelectedSpool != NULL))
-    {
-        gLengthFactor = gLengthMgr.CalculateLengthFactor(
-                        pSelectedSpool->GetDiameter(),
-                        gLoadCell.GetBaseUnitsFactor(gScaleUnits),
-                        pSelectedSpool->GetDensity());
-    }
-} // End UpdateLengthFactor().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SetLoadCellUnits()
-//
-// Updates our load cell (weight) units, then scales all spool table weights
-// based on the new units.
-/////////////////////////////////////////////////////////////////////////////////
-void SetLoadCellUnits(WeightUnits units)
-{
-    // Update our weight units and edit limits.
-    gLoadCell.SetUnits(units);
-    gMinWeight = GetMinScaleWeight();
-    gMaxWeight = GetMaxScaleWeight();
-    gBigWeightStep   = GetWeightBigStep();
-    gSmallWeightStep = GetWeightSmallStep();
-
-    // Determine our multiplier based on the new weight units.
-    double multiplier = gLoadCell.GetConversionFactor();
-
-    // Scale the spool weights for the entire spool table based on the new units.
-    for (uint16_t i = 0; i < NUMBER_SPOOLS; i++)
-    {
-        Spool *pSpool = gSpoolMgr.GetSpool(i);
-        float weight = pSpool->GetSpoolWeight() * multiplier;
-        pSpool->SetSpoolWeight(weight);
-    }
-} // End SetLoadCellUnits().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// AddCommas()
-//
-// Takes a double value as input, and converts it to a string containing commas
-// separating the thousands places.  For example, if a vlaue of 123456.789 is
-// passed in with a precision of 2, the resultant converted string will be
-// "123,456.78".
-//
-// Arguments:
-//  - val     - This is the double value to be converted.
-//  - prec    - Specifies the precision of the converted string.  That is, it
-//              specifies the number of digits to the right of the decimal
-//              point in the returned string.
-//  - pBuf    - Specifies the buffer in which the result will be returned.
-//  - bufSize - Specifies the size of 'pBuf'.
-//
-//  Returns:
-//      Always returns 'pBuf'.  It is possible that the converted string will not
-//      fit within 'pBuf'.  In this case, the most significant digits of the
-//      converted string will be truncated, so beware and be sure to supply
-//      a buffer that is large enough to hold the converted string.
-/////////////////////////////////////////////////////////////////////////////////
-char *AddCommas(double val, int prec, char *pBuf, int bufSize)
-{
-    const char THOUSANDS_SEPARATOR = ',';
-    const char DECIMAL_POINT       = '.';
-    const size_t MAX_FORMATTED_NUMBER_SIZE = 30;
-    char temp[MAX_FORMATTED_NUMBER_SIZE];
-
-    // If the caller supplied a buffer, start with an empty string.
-    if (pBuf)
-    {
-        *pBuf = '\0';
-    }
-
-    // Validate our arguments.  Make sure:
-    // - the caller's buffer exists;
-    // - the caller's buffer is at least big enough for the smallest possible string;
-    // - our temporary buffer is at least big enough for the smallest possible string.
-    // If not, just return.
-    if ((pBuf == NULL) || (prec > (MAX_FORMATTED_NUMBER_SIZE - 3)) || (bufSize < 3))
-    {
-        return pBuf;
-    }
-
-    // Round value to the given precision.
-    double roundVal = ((val > 0.0) ? 0.5 : -0.5);
-    val += (roundVal * pow(10.0, -prec));
-
-    // Convert the rounded value to a string.
-    snprintf(temp, MAX_FORMATTED_NUMBER_SIZE, "%f", val);
-
-    // Look for a decimal point.
-    char *pDot = strchr(temp, DECIMAL_POINT);
-    char *pSrc;
-    char *pDst;
-    if (pDot)   // A decimal point was found.
-    {
-        // Since the builtin version of printf() does not support variable
-        // precision, we need to handle it ourselves.  Here we check to see
-        // how many digits are past the decimal point, and clip to the specified
-        // precision if needed.
-        int dotLen = strlen(pDot);
-
-        // Special case when prec is 0.  Remove decimal point.  I.e. display as int.
-        if (prec == 0)
-        {
-            dotLen = 0;
-            *pDot = '\0';
-        }
-        else if (dotLen > prec)
-        {
-            pDot[prec + 1] = '\0';
-            dotLen = prec + 1;
-        }
-
-        pDst = pBuf + bufSize - dotLen - 1; // Set pDst to allow the fractional part to fit.
-        strcpy(pDst, pDot);                 // Copy the fractional part.
-        *pDot = '\0';                       // Cut the fractional part in temp.
-        pSrc = --pDot;                      // Point to the last non fractional char in temp.
-        pDst--;                             // Point to the previous char in pDst.
-    }
-    else    // No decimal point was found.
-    {
-        pSrc = temp + strlen(temp) - 1;     // pSrc is last char of our float string.
-        pDst = pBuf + bufSize - 1;          // pDst is last char of the caller's buffer.
-    }
-
-    int len = strlen(temp); // Initialize the mantissa size.
-    int digitCount = 0;     // Initialize the digit counter.
-
-    do
-    {
-        // Count digits (and digits only).
-        if ((*pSrc <= '9') && (*pSrc >= '0'))
-        {
-            // Add thousands separator if we added 3 digits already.
-            if (digitCount && !(digitCount % 3))
-            {
-                *pDst-- = THOUSANDS_SEPARATOR;
-            }
-            // Increment the mantissa digit count.
-            digitCount++;
-        }
-        // Copy this digit and point to the next.
-        *pDst-- = *pSrc--;
-
-      // Finish if we run out of mantissa characters, or if we fill the caller's buffer.
-    } while (--len && ((pDst - pBuf) >= 0));
-
-    // Move the converted value string to the start of the caller's buffer.
-    // Note that this move depends on strcpy() starting its copy at the lowest
-    // address and continuing toward the end of the buffer.  If this is not the
-    // case, then it is possible that the string data could get corrupted.
-    if ((pDst + 1) != pBuf)
-    {
-        // Move the string.
-        strcpy(pBuf, pDst + 1);
-    }
-
-    // Return a pointer to the user's buffer.
-    return pBuf;
-} // End AddCommas().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// RestartSystem()
-//
-// Restarts the system, but clears the screen first to remove any leftover junk
-// when the system comes back up.
-/////////////////////////////////////////////////////////////////////////////////
-void RestartSystem()
-{
-    // Clear the screen to eliminate junk display on restart.
-    gTft.fillScreen(ST7735_BLACK);
-    ESP.restart();
-} // End RestartSystem().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// ResetNvs()
-//
-// Resets (clears) NVS by making each subsystem clear its own data, then restarts
-// the system.  When the system comes back up, it will use all default values.
-/////////////////////////////////////////////////////////////////////////////////
-void ResetNvs()
-{
-    gLoadCell.Reset();
-    gEnvSensor.Reset();
-    gFilament.Reset();
-    gSpoolMgr.Reset();
-    gLengthMgr.Reset();
-    gTft.Reset();
-    MainScreen::Reset();
-
-    // Reset the system.  This function never returns.
-    RestartSystem();
-} // End ResetNvs().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SaveToNvs()
-//
-// Saves all system settings to NVS.  The current settings will all be saved to
-// NVS and will be restored the next time the system comes up.
-/////////////////////////////////////////////////////////////////////////////////
-bool SaveToNvs()
-{
-    bool status = true;
-    status &= gLoadCell.Save();
-    status &= gEnvSensor.Save();
-    status &= gFilament.Save();
-    status &= gSpoolMgr.Save();
-    status &= gLengthMgr.Save();
-    status &= gTft.Save();
-    status &= MainScreen::Save();
-    return status;
-} // End SaveToNvs().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// RestoreFromNvs()
-//
-// Restores all system settings from NVS.  Each subsystem is called to restore
-// its non-volatile values.  If a system's volatile values were not previously
-// saved, then default values are used.  This is called on each power-up.
-/////////////////////////////////////////////////////////////////////////////////
-bool RestoreFromNvs()
-{
-    // Assume that we will succeed.
-    bool status = true;
-
-    // Restore the LoadCell subsystem.
-    if (gLoadCell.Restore())
-    {
-        // Restored successfully, update our globals accordingly.
-        gScaleUnits = gLoadCell.GetUnits();
-        gScaleAveragingSamples = gLoadCell.GetAverageInterval();
-        gScaleGain = gLoadCell.GetGain();
-    }
-    else
-    {
-        // Restore failed.  Use our default values.
-        gLoadCell.SetUnits(gScaleUnits);
-        gLoadCell.SetAverageInterval(gScaleAveragingSamples);
-        gLoadCell.SetGain(gScaleGain);
-        SetLoadCellUnits(gScaleUnits);
-        status = false;
-        Serial.println("LoadCell.Restore() failed.");
-    }
-
-    // Restore the EnvSensor subsystem.
-    if (gEnvSensor.Restore())
-    {
-        // Restored successfully, update our globals accordingly.
-        gTemperatureUnits = gEnvSensor.GetTempScale();
-    }
-    else
-    {
-        // Restore failed.  Use our default values.
-        gEnvSensor.SetTempScale(gTemperatureUnits);
-        status = false;
-        Serial.println("EnvSensor.Restore() failed.");
-    }
-
-    // Restore the Filament subsystem.
-    if (gFilament.Restore())
-    {
-        // Restored successfully, update our globals accordingly.
-        // No globals to update, so do nothing.
-    }
-    else
-    {
-        // Restore failed.  Use our default values.
-        status = false;
-        Serial.println("Filament.Restore() failed.");
-    }
-
-    // Restore the SpoolMgr subsystem.
-    if (gSpoolMgr.Restore())
-    {
-        // Restored successfully, update our globals accordingly.
-        // No globals to update, so do nothing.
-    }
-    else
-    {
-        // Restore failed.  Use our default values.
-        status = false;
-        Serial.println("SpoolManager.Restore() failed.");
-    }
-    // Either way, we need to update our spool offset value.
-    SaveSpoolOffset();
-
-    // Restore the LengthMgr subsystem.
-    if (gLengthMgr.Restore())
-    {
-        // Restored successfully, update our globals accordingly.
-        gLengthUnits = gLengthMgr.GetSelected();
-    }
-    else
-    {
-        // Restore failed.  Use our default values.
-        gLengthMgr.SetUnits(gLengthUnits);
-        status = false;
-        Serial.println("LengthManager.Restore() failed.");
-    }
-    // Either way we need to update our global length factor.
-    UpdateLengthFactor();
-
-    // Restore the Display subsystem.
-    if (gTft.Restore())
-    {
-        // Restored successfully, update our globals accordingly.
-        gBacklightPercent = gTft.GetBacklightPercent();
-    }
-    else
-    {
-        // Restore failed.  Use our default values.
-        gTft.SetBacklightPercent(gBacklightPercent);
-        status = false;
-        Serial.println("TFT.Restore() failed.");
-    }
-
-    // Restore the Main Screen subsystem.
-    if (!MainScreen::Restore())
-    {
-        status = false;
-        Serial.println("MainScreen::Restore() failed.");
-    }
-
-    return status;
-} // End RestoreFromNvs().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// InitUnusedPins()
-//
-// Initialize all unused GPIO pins to pulled down inputs.
-/////////////////////////////////////////////////////////////////////////////////
-static void InitUnusedPins()
-{
-    // List of pins that are unused for this project.
-    // !!! This list will need to be updated if the hardware setup changes.
-    int unusedPins[] = {16, 17, 22, 23, 33};
-
-    // Set each unused pin to a pulled down input.
-    for (int i = 0; i < sizeof(unusedPins) / sizeof(unusedPins[0]); i++)
-    {
-        pinMode(unusedPins[i], INPUT_PULLDOWN);
-    }
-} // End InitUnusedPins().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// InitObjects()
-//
-// Initialize all sensors and other objects used by the scale.
-//
-// Returns:
-//   Returns 'true' if all objects were successfully initialized.  Returns false
-//   otherwise.
-/////////////////////////////////////////////////////////////////////////////////
-static bool InitObjects()
-{
-    // Assume that we will succeed.
-    bool status = true;
-
-    // Initialize the unused HW pins.
-    InitUnusedPins();
-
-    // Initialize the Display class.
-    if (!gTft.Init(gTftNvsName) || !MainScreen::Init(gMainScreenNvsName))
-    {
-        Serial.println("No Display found.");
-        status = false;
-    }
-    else
-    {
-        Serial.println("Display found.");
-    }
-
-    // Display a welcome screen.
-    const uint32_t WELCOME_DWELL_MS = 2000;
-    gTft.WelcomeScreen(MAIN_PAGE_FG_COLOR, MAIN_PAGE_BG_COLOR, BOX_RADIUS);
-    delay(WELCOME_DWELL_MS);
-
-    // Initialize the menu subsystem.
-    InitScaleMenus();
-
-    // Initialize the load cell.
-    if (!gLoadCell.Init(gLoadCellNvsName))
-    {
-        Serial.println("No Load Cell found.");
-        status = false;
-    }
-    else
-    {
-        Serial.println("Load Cell found.");
-    }
-
-    // Initialize the environmental sensot.
-    if (!gEnvSensor.Init(gEnvSensorNvsName))
-    {
-        Serial.println("No Environmental Sensor found.");
-        status = false;
-    }
-    else
-    {
-        Serial.println("Environmental Sensor found.");
-    }
-
-    // Initialize the filament class.
-    if (!gFilament.Init(gFilamentNvsName))
-    {
-        Serial.println("No Filament found.");
-        status = false;
-    }
-    else
-    {
-        Serial.println("Filament found.");
-    }
-
-    // Initialize the spool manager class.
-    if (!gSpoolMgr.Init(gSpoolMgrNvsName))
-    {
-        Serial.println("No SpoolMgr found.");
-        status = false;
-    }
-    else
-    {
-        Serial.println("SpoolMgr found.");
-    }
-
-    // Initialize the length manager class.
-    if (!gLengthMgr.Init(gLengthMgrNvsName))
-    {
-        Serial.println("No LengthMgr found.");
-        status = false;
-    }
-    else
-    {
-        Serial.println("LengthMgr found.");
-    }
-
-    // Initialize the Network class.
-    if (!gNetwork.Init(gNetworkNvsName, gNetworkApName, gNetworkServerName))
-    {
-        Serial.println("Network init failed.");
-        status = false;
-    }
-    else
-    {
-        // Setup our network handlers.
-        Serial.println("Network init succeeded.");
-        WebData::InitNetworkHandlers();
-    }
-
-    // Restore previously saved state data for all subsystems if any.
-    status &= RestoreFromNvs();
-
-    // Return our status.
-    return status;
-} // End InitObjects().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// UpdateCurrentLength()
-//
-// Updates the current filament length if a spool is currently selected.
-//
-// Updates gCurrentLength.
-/////////////////////////////////////////////////////////////////////////////////
-static void UpdateCurrentLength()
-{
-    // Only calculate length if a spool is currently selected.
-    if (gSpoolMgr.GetSelectedSpool() != NULL)
-    {
-        gCurrentLength = SetDecimalPlaces(
-            gLengthFactor * gCurrentWeight, gLengthMgr.GetPrecision());
-    }
-    else
-    {
-        gCurrentLength = 0.0;
-    }
-} // End UpdateCurrentLength().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// UpdateCurrentWeight()
-//
-// Updates the current scale weight values.  Will not fetch new values from
-// the load cell sensor any more frequently than every WEIGHT_UPDATE_PERIOD_MS
-// milliseconds.
-//
-// Updates gCurrentWeight only if the load cell has been calibrated.
-// Also updates the current length - gCurrentLength by calling
-// UpdateCurrentLength().
-/////////////////////////////////////////////////////////////////////////////////
-static void UpdateCurrentWeight()
-{
-    // Don't update the weight too frequently.
-    uint32_t currentMillis = millis();
-    static uint32_t lastWeightTime = currentMillis - WEIGHT_UPDATE_PERIOD_MS;
-    if (currentMillis - lastWeightTime >= WEIGHT_UPDATE_PERIOD_MS)
-    {
-        // It's time to update the weight value.  If we're calibrated, then
-        // read the current weight from the sensor.  Otherwise, weight is 0.0.
-        gCurrentWeight = 0.0f;
-        if (gLoadCell.IsCalibrated())
-        {
-            gCurrentWeight =
-                SetDecimalPlaces(gLoadCell.ReadWeight(), GetWeightDecimalPlaces());
-            UpdateCurrentLength();
-        }
-        lastWeightTime = currentMillis;
-    }
-} // End UpdateCurrentWeight().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// UpdateCurrentEnv()
-//
-// Updates the temperature and humidity values.  Will not fetch new values from
-// the environmental sensor any more frequently than every ENV_UPDATE_PERIOD
-// milliseconds.  Also keeps count of any invalid data returned from the sensor.
-//
-// Updates gCurrentTemperature and gCurrentHumidity when sensor reading are OK.
-/////////////////////////////////////////////////////////////////////////////////
-static void UpdateCurrentEnv()
-{
-    // Don't update the environmental data too frequently.
-    static const uint32_t ENV_UPDATE_PERIOD = 5000UL;
-    uint32_t currentMillis = millis();
-    static uint32_t lastEnvTime = currentMillis - ENV_UPDATE_PERIOD;
-    if (currentMillis - lastEnvTime >= ENV_UPDATE_PERIOD)
-    {
-        // Handle temperature.
-        float  envSensorReading = 0.0;
-        static uint32_t tempreatureNanCount = 0UL;
-        envSensorReading = gEnvSensor.GetTemperature();
-        if (isnan(envSensorReading))
-        {
-            Serial.printf("\nTemp NAN: %d\n", ++tempreatureNanCount);
-        }
-        gCurrentTemperature = envSensorReading;
-
-        // Handle humidity.
-        static uint32_t humidityNanCount = 0UL;
-        envSensorReading = gEnvSensor.GetHumidity();
-        if (isnan(envSensorReading))
-        {
-            Serial.printf("\nHum NAN: %d\n", ++humidityNanCount);
-        }
-        gCurrentHumidity = envSensorReading;
-        lastEnvTime = currentMillis;
-    }
-} // UpdateCurrentEnv().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleMainScreen()
-//
-// Handles entry to, exit from, and running the main screen.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleMainScreen()
-{
-    const uint32_t SCREEN_UPDATE_TIME = 100;
-    static bool firstTime = true;
-    uint32_t currentUpdateTime = millis();
-    static uint32_t lastUpdateTime = currentUpdateTime - SCREEN_UPDATE_TIME;
-
-    // See if it's time to leave.
-    int pbState = gEncStream.read();
-    if ((pbState == options->navCodes[enterCmd].ch) ||
-        (pbState == options->navCodes[escCmd].ch))
-    {
-        // Make sure we're allowed to enter the menu system.
-        if (WebData::LockLocal())
-        {
-            // It is time to leave.  Reset and get ready to run the menu system.
-            gNavRoot.reset();
-            gNavRoot.idleOff();
-            gRunningMenu = true;
-            gTft.setTextSize(TEXT_SCALE, TEXT_SCALE);
-            gTft.fillScreen(GetBgColor());
-        }
-        else
-        {
-            gTft.DisplayHVCenteredText("WEB IN USE\n  TRY LATER",
-                                        ST7735_RED, ST7735_BLACK, BOX_RADIUS);
-            delay(2000);
-        }
-        firstTime = true;
-    }
-    // Not time to leave.  If we just returned from displaying the menu system,
-    // or if a setting has been changed, or if it's time to update the display,
-    // or if the rotary encoder has been incremented, we need to update the display.
-    else if (firstTime || gDataUpdated ||
-            (currentUpdateTime - lastUpdateTime >= SCREEN_UPDATE_TIME) ||
-            (pbState == options->navCodes[upCmd].ch) ||
-            (pbState == options->navCodes[downCmd].ch))
-    {
-        // Do we need to scroll the scrollable data fields?
-        int32_t scrollDir = 0;
-        if (pbState == options->navCodes[upCmd].ch)
-        {
-            scrollDir = 1;
-            firstTime = true;
-        }
-        else if (pbState == options->navCodes[downCmd].ch)
-        {
-            scrollDir = -1;
-            firstTime = true;
-        }
-        if (gDataUpdated)
-        {
-            // Yes, set firstTime.
-            firstTime = true;
-        }
-
-        // Time to update the main screen.
-        MainScreen::DisplayMainScreen(firstTime, scrollDir);
-        lastUpdateTime = currentUpdateTime;
-        firstTime = false;
-        gDataUpdated = false;
-    }
-} // End HandleMainScreen().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleAuxPb()
-//
-// Monitor the aux pushbutton and perform actions based on the current system
-// state.  If the system is currently displaying the menus, then exit to the
-// main screen on any aux pushbutton press.
-//
-// If the system is currently displaying the main screen, then a short press of
-// the aux pushbutton will cause the weight units to change.  A long press
-// press will cause a tare operation to be completed.
-/////////////////////////////////////////////////////////////////////////////////
-void HandleAuxPb()
-{
-    // See if the aux pushbutton has been pushed (and released).
-    int auxPbState = gAuxPb.Read();
-    if (auxPbState != gAuxPb.BUTTON_CLEAR)
-    {
-        // Yes - pushbutton was activated.  Were we showing the main screen?
-        if (!gRunningMenu)
-        {
-            // Yes - we were showing the main screen.  A short push commands
-            // us to use the next weight units.  A long push indicates a tare
-            // operation is required.
-            if (auxPbState == gAuxPb.BUTTON_SHORT)
-            {
-                uint32_t tempScaleUnits = static_cast<uint32_t>(gScaleUnits);
-                gScaleUnits = static_cast<WeightUnits>(++tempScaleUnits);
-                // Short push - change scale units.
-                if (gScaleUnits >= eWuNumUnits)
-                {
-                    gScaleUnits = eWuGrams;
-                }
-                SetLoadCellUnits(gScaleUnits);
-                UpdateLengthFactorEntry();
-
-                // Note that the units change is immediate so there is no need
-                // to display a results screen.
-            }
-            else
-            {
-                // Let the user know we're working.
-                gTft.DisplayWorkingScreen();
-
-                // Short push, so do a tare.
-                bool status = gLoadCell.Tare();
-
-                // Let the user know if we succeeded or not.
-                gTft.DisplayResult(status, "TARE COMPLETE", "TARE FAILED",
-                                   BOX_RADIUS, 3000UL);
-            }
-            gDataUpdated = true;
-        }
-        // The local menu was running.  Any aux pb action causes us to exit
-        // to the main screen, so we need to unlock the web as well.
-        else
-        {
-            gTft.FillScreen(MAIN_PAGE_FG_COLOR, MAIN_PAGE_BG_COLOR, BOX_RADIUS);
-            WebData::Unlock();
-            gRunningMenu = false;
-        }
-    }
-} // End HandleAuxPb().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// setup()
-//
-// Standard Arduino setup function.  Here we initialize the system for execution.
-/////////////////////////////////////////////////////////////////////////////////
-void setup()
-{
-    // Setup the serial port, and wait for it to be ready.
-    Serial.begin(115200);
-    while(!Serial);
-    delay(100);
-    Serial.println("--JMC SCALE--");
-
-    // Delay to allow devices to settle.
-    delay(250);
-
-    // Initialize all of our system objects.
-    if (InitObjects())
-    {
-        Serial.println("InitObjects() succeeded.");
-    }
-    else
-    {
-        Serial.println("InitObjects() failed.");
-    }
-
-    // Clear any aux pushbutton data.
-    gAuxPb.Read();
-
-    // Shouldn't be necessary, but just to be safe unlock the web mutex.
-    WebData::Unlock();
-} // End setup().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// loop()
-//
-// Standard Arduino main loop.  Here we mainly select whether to run the menu
-// subsystem or the main display screen.
-/////////////////////////////////////////////////////////////////////////////////
-void loop()
-{
-    // Number of milliseconds to delay at the end of each loop() execution.
-    const uint32_t LOOP_DELAY = 2;
-
-    // Always update the scale weight and environmental data.
-    UpdateCurrentWeight();
-    UpdateCurrentEnv();
-
-    // Always handle the network.
-    gNetwork.Process();
-
-    // If web had the lock and timed out, then clear the lock.
-    WebData::HandleWebTimeout();
-
-    // Handle the Aux Pushbutton.  Must be done before net/menu polling.
-    HandleAuxPb();
-
-    // Are we running the menu now?
-    if (gRunningMenu)
-    {
-        // Yes, run the menu subsystem.
-        gNavRoot.poll();
-    }
-    else
-    {
-        // No, display the main screen.
-        HandleMainScreen();
-    }
-
-    // Delay to allow background to run.
-    delay(LOOP_DELAY);
-} // End loop().
+/////////////////////////////////////////////////////////////////////////////////
+// JmcFilamentScale.ino
+//
+// Implements a filament scale with the following features:
+//   - Menu driven settings.
+//   - Selectable weight units display (g, kg, oz, lb).
+//   - Weigh items up to 5kg (11 lb).
+//   - Addjustable display brightness.
+//   - Built-in temperature display.
+//   - Built-in humidity display.
+//   - Selectable temperature units (degrees C or F).
+//   - Storage for data for up to 15 filament spools.
+//   - Adjustable spool parameters include:
+//      - Spool name (up to 8 characters).
+//      - Filament type (15 selectable filament types).
+//      - Empty spool weight.
+//      - Filament diameter.
+//   - Adjustable filament density for eoach of the 15 filament types.
+//   - Calculation and display of remaining length of filament per spool.
+//   - Selectable filament length units (mm, cm, m, in, ft, yd).
+//   - Ability to save settings to NVS for restoration on powerup.
+//   - Web interface with ability to monitor all data and modify all options
+//     remotely.
+//
+//  This implementation relies heavily on the ArdiunoMenu library:
+//      https://github.com/neu-rah/ArduinoMenu
+//
+// This code is menat to run on an ESP32 microprocessor with the following or
+// similar peripherals:
+//      - Adafruit HUZZAH32 - ESP32 Feather Board.
+//        https://www.adafruit.com/product/3405
+//      - Adafruit 1.8" 128x160  TFT display.
+//        https://www.adafruit.com/product/358
+//      - 5kg Load Cell and HX711.
+//        https://www.amazon.com/gp/product/B075317R45/ref=ppx_yo_dt_b_asin_title_o02_s00?ie=UTF8&psc=1
+//      - DHT22 Digital Temperature and Himidity Sensor.
+//        https://www.amazon.com/gp/product/B07T63JRT8/ref=ppx_yo_dt_b_asin_title_o00_s00?ie=UTF8&psc=1
+//      - Rotaty Encoder with Pushbutton Module.
+//        https://www.amazon.com/gp/product/B081YCR3JC/ref=ppx_yo_dt_b_asin_title_o04_s00?ie=UTF8&psc=1
+//
+// This project was inspired by an article in "Nuts and Volts" magazine
+// 2019 Issue-4.  The article is entitled "Build a 3D Printer Filament Scale" by
+// Edward Andrews.  I used a few small code fragments from the article, and the
+// filament density table from the article.  Additional inspiration was gathered
+// from "Filament Health Monitor" at https://replicantfx.com/filament-health-monitor/
+//
+// History:
+// - jmcorbett 04-JAN-2021 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "JmcFilamentScale.h"   // For global variables and extern definitioins.
+#include <menu.h>               // For ArduinoMenu.
+#include <menuIO/adafruitGfxOut.h>// For Adafruit graphics library.
+#include <menuIO/chainStream.h> // For menu input/output streams.
+#include <menuIO/serialOut.h>   // For menu serial output.
+#include <menuIO/serialIn.h>    // For menu serial input.
+#include <plugin/userMenu.h>    // For OBJ menu macro.
+#include "ESP32EncoderStream.h" // For encoder w/pushbutton.
+#include "MainScreen.h"         // For MainScreen related stuff.
+#include "WebData.h"            // For web page handling code.
+#include "ScaleMenu.h"          // For menu  related stuff.
+#include "AuxPb.h"              // For AuxPb class.
+#include "HX711SpiTransport.h"  // For HX711 SPI transport.
+#include "HX711Bank.h"          // For HX711s sharing a clock pin.
+#include "NvsStore.h"           // For deferred NVS saves.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ST7735 1.8TFT 128x160 Pin assignments and related variables.
+/////////////////////////////////////////////////////////////////////////////////
+static const int TFT_CS   = 14;     // TFT display CS pin.
+static const int TFT_DC   = 32;     // TFT display DC pin.
+static const int TFT_RST  = 15;     // TFT display RST pin.
+static const int TFT_LITE = A0;     // TFT display backlight pin.
+
+// Construct our TFT  object.
+// Adafruit_ST7735 gTft(TFT_CS, TFT_DC, TFT_RST);
+Display gTft(TFT_CS, TFT_DC, TFT_RST, TFT_LITE);
+
+// TFT related globals and constants.
+uint32_t           gBacklightPercent = 100;
+static const char *gTftNvsName       = "Dispaly";
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Rotary encoder pins.
+/////////////////////////////////////////////////////////////////////////////////
+static const int ENC_PIN_A      = A3;   // Encoder A pin.
+static const int ENC_PIN_B      = A4;   // Encoder B pin.
+static const int ENC_BUTTON_PIN = 13;   // Encoder pushbutton pin.
+static const int ENC_SENSITIVITY = 4;   // Encoder sensitivity.
+
+// Construct the pushbutton encoder stream object.  Note that some encoders will
+// require the sensitivity to be set to a different value.
+ESP32EncoderStream gEncStream(ENC_PIN_A, ENC_PIN_B, ENC_BUTTON_PIN, ENC_SENSITIVITY);
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Auxiliary pushbutton pins.
+/////////////////////////////////////////////////////////////////////////////////
+static const int AUX_BUTTON_PIN = A1;   // Auxiliary pushbutton pin.
+
+// Construct the auxiliary pushbutton object.
+AuxPb gAuxPb(AUX_BUTTON_PIN);
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Define the LoadCell sensor related I/O pins and global data and constants.
+/////////////////////////////////////////////////////////////////////////////////
+static const int LOADCELL_DOUT_PIN  = A2;   // LoadCell DOUT signal pin.
+static const int LOADCELL_SCK_PIN   = A5;   // LoadCell CLOCK pin.
+
+// Set LOADCELL_CHANNELS to the number of load cells (up to
+// HX711Bank::MAX_CHANNELS) to serve a rack of spools with a single scale.  With
+// more than one, the HX711s share LOADCELL_SCK_PIN and are read together by an
+// HX711Bank, channel N being read from LOADCELL_DOUT_PINS[N].  Channel 0 is
+// gLoadCell, and the weights of the others are shown on the main screen and
+// the web page.
+#define LOADCELL_CHANNELS   1
+
+// Set LOADCELL_RATE_SPS to 80 if the HX711 RATE pin is tied high.  Every
+// conversion is still used: they are decimated to 10 readings per second with
+// less noise than at 10 SPS.
+#define LOADCELL_RATE_SPS   10
+
+#if LOADCELL_CHANNELS > 1
+// Construct the bank and a LoadCell object for each of its channels.  The DOUT
+// pins of channels 1-3 are taken from the unused pins (InitUnusedPins() leaves
+// them alone).  They must not clash with ENV_DAT_PIN or the other pins above,
+// and must not be ESP32 strapping pins (0, 2, 5, 12, 15): an HX711 holds DOUT
+// high until it is ready, which at reset could stop the board booting.
+static const int LOADCELL_DOUT_PINS[HX711Bank::MAX_CHANNELS] =
+    {LOADCELL_DOUT_PIN, 16, 17, 22};
+static HX711Bank gLoadCellBank(LOADCELL_SCK_PIN, LOADCELL_DOUT_PINS, LOADCELL_CHANNELS);
+LoadCell gLoadCell(gLoadCellBank.GetChannel(0), 128U);
+static LoadCell gLoadCell1(gLoadCellBank.GetChannel(1), 128U);
+static LoadCell gLoadCell2(gLoadCellBank.GetChannel(2), 128U);
+static LoadCell gLoadCell3(gLoadCellBank.GetChannel(3), 128U);
+static LoadCell *const gLoadCells[] = {&gLoadCell, &gLoadCell1, &gLoadCell2, &gLoadCell3};
+#else
+// Construct the HX711 transport and the LoadCell object.  The SPI transport
+// clocks the HX711 with the SPI peripheral.  HX711GpioTransport may be used
+// instead to bit-bang the pins with the HX711 library.
+static HX711SpiTransport gLoadCellTransport(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN);
+LoadCell gLoadCell(&gLoadCellTransport, 128U);
+static LoadCell *const gLoadCells[] = {&gLoadCell};
+#endif
+LoadCellArray gLoadCellArray(gLoadCells, LOADCELL_CHANNELS, NUMBER_SPOOLS);
+
+// Load cell related globals and constants.
+       WeightUnits gScaleUnits        = eWuGrams;
+       uint32_t    gScaleAveragingMs  = AVG_TIME_DEFAULT_MS;
+       uint8_t     gScaleGain         = 128;
+       uint8_t     gScaleChannelB     = 0U;
+       uint8_t     gScaleMedianSize   = FilterPipeline::DEFAULT_CONFIG.m_MedianSize;
+       uint8_t     gScaleLowPass      = FilterPipeline::DEFAULT_CONFIG.m_LowPass;
+       uint8_t     gScaleStepDetect   = FilterPipeline::DEFAULT_CONFIG.m_StepDetect;
+       uint8_t     gScaleCalFit       = eCfLinear;
+       uint8_t     gScaleTempComp     = 1U;
+       uint8_t     gScaleZeroTrack    = ZeroTracker::DEFAULT_CONFIG.m_ZeroTrack;
+static const char *gLoadCellNvsName   = "Load Cell";
+static const char *gLoadCellArrayNvsName = "Scale Bank";
+StabilityDetector  gStability;          // Watches for converged weights.
+ConsumptionTracker gConsumption;        // Filament usage rate and time to empty.
+History            gHistory;            // Weight and environment history.
+static const char *gHistoryNvsName    = "History";
+static JournalPartitionStorage gJournalStorage("journal");
+UsageJournal       gJournal;            // Per-spool usage journal in flash.
+static bool        gLoadMoved         = false;  // Settled since last env update.
+       float       gCurrentWeight     = 0.0f;
+       float       gCurrentLength     = 0.0f;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Define the environmental sensor (temperature and humidity) pins and global
+// data and constants.
+/////////////////////////////////////////////////////////////////////////////////
+static const uint8_t ENV_DAT_PIN    = 27;   // Sensor data pin.
+static const uint8_t ENV_TYPE       = DHT22;// Sensor type.
+
+// Construct and init the EnvSensor object.
+EnvSensor gEnvSensor(ENV_DAT_PIN, ENV_TYPE);
+
+// Environmental sensor related globals and constants.
+TempScale gTemperatureUnits     = eTempScaleF;
+static const char *gEnvSensorNvsName   = "Env Sensor";
+       float       gCurrentTemperature = 0.0f;
+       float       gCurrentHumidity    = 0.0f;
+static float       gCurrentDegreesC    = NAN;   // For the history.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Filament class related data and constants.
+/////////////////////////////////////////////////////////////////////////////////
+Filament gFilament;
+
+// Filament related global data and constants.
+       float  gWorkingFilamentDensity = 0.01;
+       char   gWorkingFilamentType[Filament::TYPE_STRING_MAX_SIZE] = { 0 };
+static const char *gFilamentNvsName  = "Filament";
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Spool Manager related data and constants.
+/////////////////////////////////////////////////////////////////////////////////
+SpoolManager<NUMBER_SPOOLS> gSpoolMgr;
+
+// Set up spool related global data.  Used for dynamic menu implementation.
+       SpoolData gWorkingSpoolData; // Spool data currently being worked om.
+static const char *gSpoolMgrNvsName  = "Spool Mgr";
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// LengthManager related data and constants.
+/////////////////////////////////////////////////////////////////////////////////
+LengthManager gLengthMgr;
+
+// Length manager related globals and constants.
+static const       LengthUnits DEFAULT_LENGTH_UNITS = luMm;
+                   LengthUnits  gLengthUnits        = DEFAULT_LENGTH_UNITS;
+static float       gLengthFactor                    = 0.0;
+static FixedScale  gLengthScale;     // Weight LSBs to length LSBs.
+static const char *gLengthMgrNvsName                = "Length Mgr";
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Network related data and constants.
+/////////////////////////////////////////////////////////////////////////////////
+static const int   SERVER_PORT = 80;
+       Network     gNetwork(SERVER_PORT);
+
+// NVS name.
+static const char *gNetworkNvsName    = "Network";
+
+// Access the scale via this name (i.e. http://JmcScale.local).
+const char *gNetworkServerName = "JmcScale";
+const char * &rNetworkServerName = gNetworkServerName;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Main Screen related data and constants.
+/////////////////////////////////////////////////////////////////////////////////
+static const char *gMainScreenNvsName = "Main Screen";
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Weight related data.
+/////////////////////////////////////////////////////////////////////////////////
+static const  double MAX_CAL_WEIGHT = 5000.0;
+static const  double MIN_CAL_WEIGHT = 0.0;
+       double gCalibrateWeight      = MIN_CAL_WEIGHT;
+       double gMinWeight            = MIN_CAL_WEIGHT;
+       double gMaxWeight            = MAX_CAL_WEIGHT;
+       double gBigWeightStep        = 10.0;
+       double gSmallWeightStep      = .1;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Miscellaneous globals.
+/////////////////////////////////////////////////////////////////////////////////
+       bool   gRunningMenu          = false;
+       bool   gDataUpdated          = false;
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetMinScaleWeight()
+//
+// Returns the minimum allowable scale weight given the current weight units.
+// Currently always returns 0.0.  May change in the future.
+/////////////////////////////////////////////////////////////////////////////////
+static double GetMinScaleWeight()
+{
+    double minWeight = 0.0;
+    switch(gLoadCell.GetUnits())
+    {
+    case eWuGrams:     minWeight = 0.0; break;
+    case eWuKiloGrams: minWeight = 0.0; break;
+    case eWuOunces:    minWeight = 0.0; break;
+    case eWuPounds:    minWeight = 0.0; break;
+    default:           minWeight = 0.0; break;
+    }
+    return minWeight;
+} // End GetMinScaleWeight().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetMaxScaleWeight()
+//
+// Returns the maximum allowable scale weight given the current weight units.
+/////////////////////////////////////////////////////////////////////////////////
+double GetMaxScaleWeight()
+{
+    double maxWeight = 10.0;
+    switch(gLoadCell.GetUnits())
+    {
+    case eWuGrams:     maxWeight = 5000.0; break;
+    case eWuKiloGrams: maxWeight = 5.0;    break;
+    case eWuOunces:    maxWeight = 176.37; break;
+    case eWuPounds:    maxWeight = 11.02;  break;
+    default:           maxWeight = 5000.0; break;
+    }
+    return maxWeight;
+} // End GetMaxScaleWeight().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetWeightBigStep()
+//
+// Returns the size of a large step for when editing weight values based on
+// the currently selected weight units.
+/////////////////////////////////////////////////////////////////////////////////
+static double GetWeightBigStep()
+{
+    double step = 10.0;
+    switch(gLoadCell.GetUnits())
+    {
+    case eWuGrams:     step = 10.0; break;
+    case eWuKiloGrams: step = 0.01; break;
+    case eWuOunces:    step = 1.0;  break;
+    case eWuPounds:    step = 0.1;  break;
+    default:           step = 10.0; break;
+    }
+    return step;
+} // End GetWeightBigStep().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetWeightSmallStep()
+//
+// Returns the size of a small step for when editing weight values based on
+// the currently selected weight units.
+/////////////////////////////////////////////////////////////////////////////////
+static double GetWeightSmallStep()
+{
+    double step = 0.1;
+    switch(gLoadCell.GetUnits())
+    {
+    case eWuGrams:     step = 0.1;    break;
+    case eWuKiloGrams: step = 0.0001; break;
+    case eWuOunces:    step = 0.01;   break;
+    case eWuPounds:    step = 0.001;  break;
+    default:           step = 0.1;    break;
+    }
+    return step;
+} // End GetWeightSmallStep().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveSpoolOffset()
+//
+// If a spool is selected, then save its offset value as the current load cell
+// offset.  Otherwise, save a value of 0.0.
+/////////////////////////////////////////////////////////////////////////////////
+void SaveSpoolOffset()
+{
+    double currentSpoolOffset = 0.0;
+
+    Spool *pSelectedSpool = gSpoolMgr.GetSelectedSpool();
+    if (pSelectedSpool != NULL)
+    {
+        currentSpoolOffset = pSelectedSpool->GetSpoolWeight();
+    }
+    gLoadCell.SetOffset(currentSpoolOffset);
+
+    // Channel 0 of a scale bank weighs the selected spool.
+    gLoadCellArray.SetSlot(0U, pSelectedSpool != NULL ?
+                               gSpoolMgr.GetSelectedSpoolIndex() :
+                               LoadCellArray::NO_SLOT);
+} // End SaveSpoolOffset().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UpdateLengthFactor()
+//
+// If a spool is selected, then update our length factor.  Otherwise, save a
+// value of 0.0.
+/////////////////////////////////////////////////////////////////////////////////
+void UpdateLengthFactor()
+{
+    // Initially reset the length factor.
+    gLengthFactor = 0.0;
+    gLengthScale.Invalidate();
+
+    // Only update the length factor if a spool is selected.
+    Spool *pSelectedSpool = gSpoolMgr.GetSelectedSpool();
+    if ((gLoadCell.IsCalibrated()) && (pSelectedSpool != NULL))
+    {
+        gLengthFactor = gLengthMgr.CalculateLengthFactor(
+                        pSelectedSpool->GetDiameter(),
+                        gLoadCell.GetBaseUnitsFactor(gScaleUnits),
+                        pSelectedSpool->GetDensity());
+    }
+
+    // The usage rate is tracked in grams.
+    gConsumption.SetLengthPerGram(
+        gLengthFactor / gLoadCell.GetBaseUnitsFactor(gScaleUnits));
+} // End UpdateLengthFactor().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetLoadCellUnits()
+//
+// Updates our load cell (weight) units, then scales all spool table weights
+// based on the new units.
+/////////////////////////////////////////////////////////////////////////////////
+void SetLoadCellUnits(WeightUnits units)
+{
+    // Update our weight units and edit limits.
+    gLoadCell.SetUnits(units);
+    gLoadCellArray.SetUnits(units);
+    gMinWeight = GetMinScaleWeight();
+    gMaxWeight = GetMaxScaleWeight();
+    gBigWeightStep   = GetWeightBigStep();
+    gSmallWeightStep = GetWeightSmallStep();
+
+    // Determine our multiplier based on the new weight units.
+    double multiplier = gLoadCell.GetConversionFactor();
+
+    // Scale the spool weights for the entire spool table based on the new units.
+    for (uint16_t i = 0; i < NUMBER_SPOOLS; i++)
+    {
+        Spool *pSpool = gSpoolMgr.GetSpool(i);
+        float weight = pSpool->GetSpoolWeight() * multiplier;
+        pSpool->SetSpoolWeight(weight);
+    }
+    NvsStore::RequestSave(millis());
+} // End SetLoadCellUnits().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetLoadCellFilters()
+//
+// Updates the load cell filter stages from our filter globals.  If the
+// globals are not valid, they are set back to the load cell's current values.
+/////////////////////////////////////////////////////////////////////////////////
+void SetLoadCellFilters()
+{
+    FilterConfig config;
+    config.m_MedianSize = gScaleMedianSize;
+    config.m_LowPass    = gScaleLowPass;
+    config.m_StepDetect = gScaleStepDetect;
+    if (!gLoadCell.SetFilterConfig(config))
+    {
+        const FilterConfig &current = gLoadCell.GetFilterConfig();
+        gScaleMedianSize = current.m_MedianSize;
+        gScaleLowPass    = current.m_LowPass;
+        gScaleStepDetect = current.m_StepDetect;
+    }
+} // End SetLoadCellFilters().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetLoadCellGain()
+//
+// Sets the load cell gain and channel B interval per gScaleGain and
+// gScaleChannelB.  The HX711s of a scale bank share a clock, and so a gain, so
+// a bank can neither auto range nor read channel B.  The globals are set back
+// to the values actually used.
+/////////////////////////////////////////////////////////////////////////////////
+void SetLoadCellGain()
+{
+    if (gLoadCellArray.GetNumChannels() > 1U)
+    {
+        gScaleGain = SampleScheduler::ReferenceGain(gScaleGain);
+        gScaleChannelB = 0U;
+    }
+    gLoadCell.SetGain(gScaleGain);
+    gLoadCell.SetChannelBInterval(gScaleChannelB);
+    gLoadCellArray.SetGain(gScaleGain);
+    gScaleGain = gLoadCell.GetGain();
+    gScaleChannelB = gLoadCell.GetChannelBInterval();
+} // End SetLoadCellGain().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetLoadCellZeroTrack()
+//
+// Turns the load cell's zero tracking on or off per gScaleZeroTrack.  The other
+// zero tracking settings are kept.
+/////////////////////////////////////////////////////////////////////////////////
+void SetLoadCellZeroTrack()
+{
+    ZeroTrackConfig config = gLoadCell.GetZeroTrackConfig();
+    config.m_ZeroTrack = gScaleZeroTrack ? 1U : 0U;
+    gLoadCell.SetZeroTrackConfig(config);
+    gScaleZeroTrack = gLoadCell.GetZeroTrackConfig().m_ZeroTrack;
+} // End SetLoadCellZeroTrack().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DisplayTareResult()
+//
+// Displays the result of a tare.  When successful, the 95% confidence interval
+// of the tare (in grams) is shown if the scale is calibrated.
+//
+// Arguments:
+//  - success - The value returned by LoadCell::Tare().
+//  - pName   - A short name for the operation ("TARE" or "ZERO").
+//  - pBadStr - Specifies the string to be displayed on failure.
+/////////////////////////////////////////////////////////////////////////////////
+void DisplayTareResult(bool success, const char *pName, const char *pBadStr)
+{
+    char goodStr[SCREEN_CHAR_WIDTH + 1];
+    const SampleQuality &rQuality = gLoadCell.GetSampleQuality();
+    if (rQuality.m_CiGrams > 0.0f)
+    {
+        snprintf(goodStr, sizeof(goodStr), "%s +-%.2fg", pName, rQuality.m_CiGrams);
+    }
+    else
+    {
+        snprintf(goodStr, sizeof(goodStr), "%s COMPLETE", pName);
+    }
+    gTft.DisplayResult(success, goodStr, pBadStr, BOX_RADIUS, 3000UL);
+} // End DisplayTareResult().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// LogUsageEvent()
+//
+// Logs a scale event to the usage journal, against the selected spool (if
+// any), at the current history time.
+//
+// Arguments:
+//  - event - The event (eUeTare, eUeCalibrate or eUeSelect).
+/////////////////////////////////////////////////////////////////////////////////
+void LogUsageEvent(UsageEvent event)
+{
+    uint8_t spool = (gSpoolMgr.GetSelectedSpool() != NULL) ?
+                    static_cast<uint8_t>(gSpoolMgr.GetSelectedSpoolIndex()) :
+                    UsageJournal::NO_SPOOL;
+    gJournal.Log(event, spool, gHistory.GetNow());
+} // End LogUsageEvent().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RestartSystem()
+//
+// Restarts the system, but clears the screen first to remove any leftover junk
+// when the system comes back up.
+/////////////////////////////////////////////////////////////////////////////////
+void RestartSystem()
+{
+    // Clear the screen to eliminate junk display on restart.
+    gTft.fillScreen(ST7735_BLACK);
+    ESP.restart();
+} // End RestartSystem().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ResetNvs()
+//
+// Resets (clears) NVS by making each subsystem clear its own data, then restarts
+// the system.  When the system comes back up, it will use all default values.
+/////////////////////////////////////////////////////////////////////////////////
+void ResetNvs()
+{
+    gLoadCell.Reset();
+    gLoadCellArray.Reset();
+    gHistory.Reset();
+    gJournal.Clear();
+    gEnvSensor.Reset();
+    gFilament.Reset();
+    gSpoolMgr.Reset();
+    gLengthMgr.Reset();
+    gTft.Reset();
+    MainScreen::Reset();
+
+    // Reset the system.  This function never returns.
+    RestartSystem();
+} // End ResetNvs().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveToNvs()
+//
+// Saves all system settings to NVS.  The current settings will all be saved to
+// NVS and will be restored the next time the system comes up.
+/////////////////////////////////////////////////////////////////////////////////
+bool SaveToNvs()
+{
+    bool status = true;
+    status &= gLoadCell.Save();
+    status &= gLoadCellArray.Save();
+    status &= gEnvSensor.Save();
+    status &= gFilament.Save();
+    status &= gSpoolMgr.Save();
+    status &= gLengthMgr.Save();
+    status &= gTft.Save();
+    status &= MainScreen::Save();
+    NvsStore::Close();
+    return status;
+} // End SaveToNvs().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RestoreFromNvs()
+//
+// Restores all system settings from NVS.  Each subsystem is called to restore
+// its non-volatile values.  If a system's volatile values were not previously
+// saved, then default values are used.  This is called on each power-up.
+/////////////////////////////////////////////////////////////////////////////////
+bool RestoreFromNvs()
+{
+    // Assume that we will succeed.
+    bool status = true;
+
+    // Restore the LoadCell subsystem.
+    if (gLoadCell.Restore())
+    {
+        // Restored successfully, update our globals accordingly.
+        gScaleUnits = gLoadCell.GetUnits();
+        gScaleAveragingMs = gLoadCell.GetAverageTimeMs();
+        gScaleGain = gLoadCell.GetGain();
+        gScaleChannelB = gLoadCell.GetChannelBInterval();
+        const FilterConfig &filters = gLoadCell.GetFilterConfig();
+        gScaleMedianSize = filters.m_MedianSize;
+        gScaleLowPass    = filters.m_LowPass;
+        gScaleStepDetect = filters.m_StepDetect;
+        gScaleCalFit     = gLoadCell.GetCalibrationFit();
+        gScaleTempComp   = gLoadCell.GetTempCompensation();
+        gScaleZeroTrack  = gLoadCell.GetZeroTrackConfig().m_ZeroTrack;
+    }
+    else
+    {
+        // Restore failed.  Use our default values.
+        gLoadCell.SetUnits(gScaleUnits);
+        gLoadCell.SetAverageTime(gScaleAveragingMs);
+        SetLoadCellFilters();
+        SetLoadCellUnits(gScaleUnits);
+        gLoadCell.SetTempCompensation(gScaleTempComp);
+        SetLoadCellZeroTrack();
+        status = false;
+        Serial.println("LoadCell.Restore() failed.");
+    }
+
+    // Restore the other channels of a scale bank.  They share the units and
+    // gain of channel 0.
+    if (!gLoadCellArray.Restore())
+    {
+        status = false;
+        Serial.println("LoadCellArray.Restore() failed.");
+    }
+    gLoadCellArray.SetUnits(gScaleUnits);
+    SetLoadCellGain();
+
+    // Restore the EnvSensor subsystem.
+    if (gEnvSensor.Restore())
+    {
+        // Restored successfully, update our globals accordingly.
+        gTemperatureUnits = gEnvSensor.GetTempScale();
+    }
+    else
+    {
+        // Restore failed.  Use our default values.
+        gEnvSensor.SetTempScale(gTemperatureUnits);
+        status = false;
+        Serial.println("EnvSensor.Restore() failed.");
+    }
+
+    // Restore the Filament subsystem.
+    if (gFilament.Restore())
+    {
+        // Restored successfully, update our globals accordingly.
+        // No globals to update, so do nothing.
+    }
+    else
+    {
+        // Restore failed.  Use our default values.
+        status = false;
+        Serial.println("Filament.Restore() failed.");
+    }
+
+    // Restore the SpoolMgr subsystem.
+    if (gSpoolMgr.Restore())
+    {
+        // Restored successfully, update our globals accordingly.
+        // No globals to update, so do nothing.
+    }
+    else
+    {
+        // Restore failed.  Use our default values.
+        status = false;
+        Serial.println("SpoolManager.Restore() failed.");
+    }
+    // Either way, we need to update our spool offset value.
+    SaveSpoolOffset();
+
+    // Restore the LengthMgr subsystem.
+    if (gLengthMgr.Restore())
+    {
+        // Restored successfully, update our globals accordingly.
+        gLengthUnits = gLengthMgr.GetSelected();
+    }
+    else
+    {
+        // Restore failed.  Use our default values.
+        gLengthMgr.SetUnits(gLengthUnits);
+        status = false;
+        Serial.println("LengthManager.Restore() failed.");
+    }
+    // Either way we need to update our global length factor.
+    UpdateLengthFactor();
+
+    // Restore the Display subsystem.
+    if (gTft.Restore())
+    {
+        // Restored successfully, update our globals accordingly.
+        gBacklightPercent = gTft.GetBacklightPercent();
+    }
+    else
+    {
+        // Restore failed.  Use our default values.
+        gTft.SetBacklightPercent(gBacklightPercent);
+        status = false;
+        Serial.println("TFT.Restore() failed.");
+    }
+
+    // Restore the Main Screen subsystem.
+    if (!MainScreen::Restore())
+    {
+        status = false;
+        Serial.println("MainScreen::Restore() failed.");
+    }
+
+    NvsStore::Close();
+    return status;
+} // End RestoreFromNvs().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveSpools()
+//
+// Saves the spools that have been edited (and the selected spool) to NVS.  This
+// is the deferred save done by NvsStore::Process() once spool edits stop.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+static bool SaveSpools()
+{
+    return gSpoolMgr.Save();
+} // End SaveSpools().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// InitUnusedPins()
+//
+// Initialize all unused GPIO pins to pulled down inputs.
+/////////////////////////////////////////////////////////////////////////////////
+static void InitUnusedPins()
+{
+    // List of pins that are unused for this project.
+    // !!! This list will need to be updated if the hardware setup changes.
+    int unusedPins[] = {16, 17, 22, 23, 33};
+
+    // Set each unused pin to a pulled down input, except those read by the
+    // load cell bank.
+    for (int i = 0; i < sizeof(unusedPins) / sizeof(unusedPins[0]); i++)
+    {
+        bool used = false;
+#if LOADCELL_CHANNELS > 1
+        for (size_t channel = 1U; channel < LOADCELL_CHANNELS; channel++)
+        {
+            used = used || (LOADCELL_DOUT_PINS[channel] == unusedPins[i]);
+        }
+#endif
+        if (!used)
+        {
+            pinMode(unusedPins[i], INPUT_PULLDOWN);
+        }
+    }
+} // End InitUnusedPins().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleStabilityEvent()
+//
+// Called by gStability whenever the weight starts settling, becomes stable, or
+// becomes stable at a new load.  Settling is remembered for the load cell's
+// temperature compensation, which only learns while the load is undisturbed.
+//
+// Arguments:
+//   - event       - The stability event.
+//   - weightGrams - Unused.
+//   - pArg        - Unused.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleStabilityEvent(StabilityEvent event, double weightGrams, void *pArg)
+{
+    if (event == eSeSettling)
+    {
+        gLoadMoved = true;
+    }
+} // End HandleStabilityEvent().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// InitObjects()
+//
+// Initialize all sensors and other objects used by the scale.
+//
+// Returns:
+//   Returns 'true' if all objects were successfully initialized.  Returns false
+//   otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+static bool InitObjects()
+{
+    // Assume that we will succeed.
+    bool status = true;
+
+    // Initialize the unused HW pins.
+    InitUnusedPins();
+
+    // Initialize the Display class.
+    if (!gTft.Init(gTftNvsName) || !MainScreen::Init(gMainScreenNvsName))
+    {
+        Serial.println("No Display found.");
+        status = false;
+    }
+    else
+    {
+        Serial.println("Display found.");
+
+        // Draw off screen so that screen updates reach the panel whole, and
+        // in the background.  Without the memory, draw directly.
+        gTft.EnableFrameBuffer(true);
+    }
+
+    // Display a welcome screen.
+    const uint32_t WELCOME_DWELL_MS = 2000;
+    gTft.WelcomeScreen(MAIN_PAGE_FG_COLOR, MAIN_PAGE_BG_COLOR, BOX_RADIUS);
+    delay(WELCOME_DWELL_MS);
+
+    // Initialize the menu subsystem.
+    InitScaleMenus();
+
+    // Initialize the load cell and its stability detector.
+    gStability.SetCallback(HandleStabilityEvent);
+    for (uint8_t ch = 0U; ch < LOADCELL_CHANNELS; ch++)
+    {
+        gLoadCells[ch]->SetConversionRate(LOADCELL_RATE_SPS);
+    }
+    if (!gLoadCell.Init(gLoadCellNvsName))
+    {
+        Serial.println("No Load Cell found.");
+        status = false;
+    }
+    else
+    {
+        Serial.println("Load Cell found.");
+    }
+    if (!gLoadCellArray.Init(gLoadCellArrayNvsName))
+    {
+        Serial.println("Not all Load Cell channels found.");
+    }
+
+    // Initialize the history.  It restores itself from NVS, since restoring
+    // it again later (e.g. from the web page) would wind its clock back.
+    if (!gHistory.Init(gHistoryNvsName))
+    {
+        Serial.println("History init failed.");
+        status = false;
+    }
+
+    // Recover the usage journal.  It lives in its own flash partition, not
+    // NVS, so a scale without one still works, just without the journal.
+    if (!gJournal.Init(&gJournalStorage))
+    {
+        Serial.println("Usage journal init failed.");
+    }
+
+    // Initialize the environmental sensot.
+    if (!gEnvSensor.Init(gEnvSensorNvsName))
+    {
+        Serial.println("No Environmental Sensor found.");
+        status = false;
+    }
+    else
+    {
+        Serial.println("Environmental Sensor found.");
+    }
+
+    // Initialize the filament class.
+    if (!gFilament.Init(gFilamentNvsName))
+    {
+        Serial.println("No Filament found.");
+        status = false;
+    }
+    else
+    {
+        Serial.println("Filament found.");
+    }
+
+    // Initialize the spool manager class.
+    if (!gSpoolMgr.Init(gSpoolMgrNvsName))
+    {
+        Serial.println("No SpoolMgr found.");
+        status = false;
+    }
+    else
+    {
+        Serial.println("SpoolMgr found.");
+    }
+
+    // Initialize the length manager class.
+    if (!gLengthMgr.Init(gLengthMgrNvsName))
+    {
+        Serial.println("No LengthMgr found.");
+        status = false;
+    }
+    else
+    {
+        Serial.println("LengthMgr found.");
+    }
+
+    // Initialize the Network class.
+    if (!gNetwork.Init(gNetworkNvsName, gNetworkApName, gNetworkServerName))
+    {
+        Serial.println("Network init failed.");
+        status = false;
+    }
+    else
+    {
+        // Setup our network handlers.
+        Serial.println("Network init succeeded.");
+        WebData::InitNetworkHandlers();
+    }
+
+    // Restore previously saved state data for all subsystems if any.
+    status &= RestoreFromNvs();
+
+    // Spool edits are saved once they stop, rather than one field at a time.
+    NvsStore::SetSaveHandler(SaveSpools);
+
+    // Return our status.
+    return status;
+} // End InitObjects().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UpdateCurrentLength()
+//
+// Updates the current filament length if a spool is currently selected.  The
+// length is worked out in fixed point by gLengthScale, which is set up again
+// after the length factor or either precision changes.
+//
+// Arguments:
+//   - weight         - The current weight, in 10^-weightDecimals units.
+//   - weightDecimals - The decimal places of 'weight'.
+//
+// Updates gCurrentLength.
+/////////////////////////////////////////////////////////////////////////////////
+static void UpdateCurrentLength(int32_t weight, uint8_t weightDecimals)
+{
+    // Only calculate length if a spool is currently selected.
+    gCurrentLength = 0.0;
+    if (gSpoolMgr.GetSelectedSpool() != NULL)
+    {
+        uint8_t decimals = static_cast<uint8_t>(gLengthMgr.GetPrecision());
+        if ((gLengthScale.IsConfigured() && (gLengthScale.GetDecimals() == decimals)) ||
+            gLengthScale.Configure(gLengthFactor *
+                                   FixedScale::ToFloat(1L, weightDecimals),
+                                   0.0, decimals))
+        {
+            gCurrentLength =
+                FixedScale::ToFloat(gLengthScale.Apply(weight), decimals);
+        }
+    }
+} // End UpdateCurrentLength().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UpdateChannelWeights()
+//
+// Reads the other channels of a scale bank.  Each channel's offset is kept equal
+// to the weight of the spool in its slot, so that its weight is the net
+// filament weight just like channel 0's.
+/////////////////////////////////////////////////////////////////////////////////
+static void UpdateChannelWeights()
+{
+    for (uint8_t ch = 1U; ch < gLoadCellArray.GetNumChannels(); ch++)
+    {
+        Spool *pSpool = gSpoolMgr.GetSpool(gLoadCellArray.GetSlot(ch));
+        double offset = (pSpool != NULL) ? pSpool->GetSpoolWeight() : 0.0;
+        LoadCell *pCell = gLoadCellArray.GetCell(ch);
+        if (pCell->GetOffset() != offset)
+        {
+            // Only when it changes, since this resets the average.
+            pCell->SetOffset(offset);
+        }
+    }
+    gLoadCellArray.Update(gCurrentWeight);
+} // End UpdateChannelWeights().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UpdateCurrentWeight()
+//
+// Updates the current scale weight values.  Will not fetch new values from
+// the load cell sensor any more frequently than every WEIGHT_UPDATE_PERIOD_MS
+// milliseconds.  The load cell's acquisition task captures every conversion
+// in the background, so this only consumes the samples queued since the last
+// update and does not wait on the HX711.
+//
+// Updates gCurrentWeight only if the load cell has been calibrated, and feeds
+// each new reading to the stability detector (gStability) and, if a spool is
+// selected, the usage rate tracker (gConsumption) and, once stable, the usage
+// journal (gJournal).  The weight is read in
+// fixed point, rounded to the display's decimal places.  Each reading is also
+// added to the history (gHistory), with the latest temperature and humidity.
+// Also updates the current length - gCurrentLength by calling
+// UpdateCurrentLength(), and the weights of the other channels of a scale bank
+// by calling UpdateChannelWeights().
+/////////////////////////////////////////////////////////////////////////////////
+static void UpdateCurrentWeight()
+{
+    // Don't update the weight too frequently.
+    uint32_t currentMillis = millis();
+    static uint32_t lastWeightTime = currentMillis - WEIGHT_UPDATE_PERIOD_MS;
+    if (currentMillis - lastWeightTime >= WEIGHT_UPDATE_PERIOD_MS)
+    {
+        // It's time to update the weight value.  If we're calibrated, then
+        // read the current weight from the sensor.  Otherwise, weight is 0.0.
+        gCurrentWeight = 0.0f;
+        HistorySample reading;
+        reading.m_Grams    = NAN;
+        reading.m_DegreesC = gCurrentDegreesC;
+        reading.m_Humidity = gCurrentHumidity;
+        if (gLoadCell.IsCalibrated())
+        {
+            uint8_t decimals = static_cast<uint8_t>(GetWeightDecimalPlaces());
+            int32_t weight = 0L;
+            gLoadCell.ReadWeightFixed(decimals, weight);
+            gCurrentWeight = FixedScale::ToFloat(weight, decimals);
+            double grams = gCurrentWeight * gLoadCell.GetBaseUnitsFactor(gLoadCell.GetUnits());
+            reading.m_Grams = static_cast<float>(grams);
+            gStability.Update(grams);
+            UpdateCurrentLength(weight, decimals);
+            if (gSpoolMgr.GetSelectedSpool() != NULL)
+            {
+                gConsumption.Update(gSpoolMgr.GetSelectedSpoolIndex(), grams,
+                                    currentMillis);
+                if (gStability.IsStable())
+                {
+                    gJournal.Checkpoint(static_cast<uint8_t>(gSpoolMgr.GetSelectedSpoolIndex()),
+                                        gHistory.GetNow(), static_cast<float>(grams));
+                }
+            }
+            else
+            {
+                gConsumption.Reset();
+            }
+        }
+        else
+        {
+            gStability.Reset();
+            gConsumption.Reset();
+        }
+        gHistory.Update(reading, currentMillis);
+        UpdateChannelWeights();
+        lastWeightTime = currentMillis;
+    }
+} // End UpdateCurrentWeight().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UpdateCurrentEnv()
+//
+// Updates the temperature and humidity values.  Will not fetch new values from
+// the environmental sensor any more frequently than every ENV_UPDATE_PERIOD
+// milliseconds.  Also keeps count of any invalid data returned from the sensor.
+//
+// Updates gCurrentTemperature and gCurrentHumidity when sensor reading are OK.
+// The temperature is also passed to the load cell for temperature
+// compensation, along with whether the load has stayed stable.
+/////////////////////////////////////////////////////////////////////////////////
+static void UpdateCurrentEnv()
+{
+    // Don't update the environmental data too frequently.
+    static const uint32_t ENV_UPDATE_PERIOD = 5000UL;
+    uint32_t currentMillis = millis();
+    static uint32_t lastEnvTime = currentMillis - ENV_UPDATE_PERIOD;
+    if (currentMillis - lastEnvTime >= ENV_UPDATE_PERIOD)
+    {
+        // Handle temperature.
+        float  envSensorReading = 0.0;
+        static uint32_t tempreatureNanCount = 0UL;
+        envSensorReading = gEnvSensor.GetTemperature();
+        if (isnan(envSensorReading))
+        {
+            Serial.printf("\nTemp NAN: %d\n", ++tempreatureNanCount);
+        }
+        gCurrentTemperature = envSensorReading;
+
+        // Let the load cell correct for (and learn) temperature drift.
+        float degreesC = envSensorReading;
+        if (gEnvSensor.GetTempScale() == eTempScaleF)
+        {
+            degreesC = gEnvSensor.ConvertFtoC(envSensorReading);
+        }
+        gCurrentDegreesC = degreesC;
+        if (gLoadCell.UpdateTemperature(degreesC, gStability.IsStable() && !gLoadMoved))
+        {
+            gLoadCell.SaveTempCompensation();
+        }
+        gLoadMoved = false;
+
+        // Handle humidity.
+        static uint32_t humidityNanCount = 0UL;
+        envSensorReading = gEnvSensor.GetHumidity();
+        if (isnan(envSensorReading))
+        {
+            Serial.printf("\nHum NAN: %d\n", ++humidityNanCount);
+        }
+        gCurrentHumidity = envSensorReading;
+        lastEnvTime = currentMillis;
+    }
+} // UpdateCurrentEnv().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleMainScreen()
+//
+// Handles entry to, exit from, and running the main screen.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleMainScreen()
+{
+    const uint32_t SCREEN_UPDATE_TIME = 100;
+    static bool firstTime = true;
+    uint32_t currentUpdateTime = millis();
+    static uint32_t lastUpdateTime = currentUpdateTime - SCREEN_UPDATE_TIME;
+
+    // See if it's time to leave.
+    int pbState = gEncStream.read();
+    if ((pbState == options->navCodes[enterCmd].ch) ||
+        (pbState == options->navCodes[escCmd].ch))
+    {
+        // Make sure we're allowed to enter the menu system.
+        if (WebData::LockLocal())
+        {
+            // It is time to leave.  Reset and get ready to run the menu system.
+            gNavRoot.reset();
+            gNavRoot.idleOff();
+            gRunningMenu = true;
+            gTft.setTextSize(TEXT_SCALE, TEXT_SCALE);
+            gTft.fillScreen(GetBgColor());
+        }
+        else
+        {
+            gTft.DisplayHVCenteredText("WEB IN USE\n  TRY LATER",
+                                        ST7735_RED, ST7735_BLACK, BOX_RADIUS);
+            delay(2000);
+        }
+        firstTime = true;
+    }
+    // Not time to leave.  If we just returned from displaying the menu system,
+    // or if a setting has been changed, or if it's time to update the display,
+    // or if the rotary encoder has been incremented, or if the main screen is
+    // sliding, we need to update the display.
+    else if (firstTime || gDataUpdated ||
+            (currentUpdateTime - lastUpdateTime >= SCREEN_UPDATE_TIME) ||
+            (MainScreen::IsSliding() &&
+             (currentUpdateTime - lastUpdateTime >= MainScreen::SLIDE_FRAME_MS)) ||
+            (pbState == options->navCodes[upCmd].ch) ||
+            (pbState == options->navCodes[downCmd].ch))
+    {
+        // Do we need to scroll the scrollable data fields?
+        int32_t scrollDir = 0;
+        if (pbState == options->navCodes[upCmd].ch)
+        {
+            scrollDir = 1;
+            firstTime = true;
+        }
+        else if (pbState == options->navCodes[downCmd].ch)
+        {
+            scrollDir = -1;
+            firstTime = true;
+        }
+        if (gDataUpdated)
+        {
+            // Yes, set firstTime.
+            firstTime = true;
+        }
+
+        // Time to update the main screen.
+        MainScreen::DisplayMainScreen(firstTime, scrollDir);
+        lastUpdateTime = currentUpdateTime;
+        firstTime = false;
+        gDataUpdated = false;
+    }
+} // End HandleMainScreen().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleAuxPb()
+//
+// Monitor the aux pushbutton and perform actions based on the current system
+// state.  If the system is currently displaying the menus, then exit to the
+// main screen on any aux pushbutton press.
+//
+// If the system is currently displaying the main screen, then a short press of
+// the aux pushbutton will cause the weight units to change.  A long press
+// press will cause a tare operation to be completed.
+/////////////////////////////////////////////////////////////////////////////////
+void HandleAuxPb()
+{
+    // See if the aux pushbutton has been pushed (and released).
+    int auxPbState = gAuxPb.Read();
+    if (auxPbState != gAuxPb.BUTTON_CLEAR)
+    {
+        // Yes - pushbutton was activated.  Were we showing the main screen?
+        if (!gRunningMenu)
+        {
+            // Yes - we were showing the main screen.  A short push commands
+            // us to use the next weight units.  A long push indicates a tare
+            // operation is required.
+            if (auxPbState == gAuxPb.BUTTON_SHORT)
+            {
+                uint32_t tempScaleUnits = static_cast<uint32_t>(gScaleUnits);
+                gScaleUnits = static_cast<WeightUnits>(++tempScaleUnits);
+                // Short push - change scale units.
+                if (gScaleUnits >= eWuNumUnits)
+                {
+                    gScaleUnits = eWuGrams;
+                }
+                SetLoadCellUnits(gScaleUnits);
+                UpdateLengthFactorEntry();
+
+                // Note that the units change is immediate so there is no need
+                // to display a results screen.
+            }
+            else
+            {
+                // Let the user know we're working.
+                gTft.DisplayWorkingScreen();
+
+                // Short push, so do a tare.
+                bool status = gLoadCell.Tare();
+                if (status)
+                {
+                    LogUsageEvent(eUeTare);
+                }
+
+                // Let the user know if we succeeded or not.
+                DisplayTareResult(status, "TARE", "TARE FAILED");
+            }
+            gDataUpdated = true;
+        }
+        // The local menu was running.  Any aux pb action causes us to exit
+        // to the main screen, so we need to unlock the web as well.
+        else
+        {
+            gTft.FillScreen(MAIN_PAGE_FG_COLOR, MAIN_PAGE_BG_COLOR, BOX_RADIUS);
+            WebData::Unlock();
+            gRunningMenu = false;
+        }
+    }
+} // End HandleAuxPb().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// setup()
+//
+// Standard Arduino setup function.  Here we initialize the system for execution.
+/////////////////////////////////////////////////////////////////////////////////
+void setup()
+{
+    // Setup the serial port, and wait for it to be ready.
+    Serial.begin(115200);
+    while(!Serial);
+    delay(100);
+    Serial.println("--JMC SCALE--");
+
+    // Delay to allow devices to settle.
+    delay(250);
+
+    // Initialize all of our system objects.
+    if (InitObjects())
+    {
+        Serial.println("InitObjects() succeeded.");
+    }
+    else
+    {
+        Serial.println("InitObjects() failed.");
+    }
+
+    // Clear any aux pushbutton data.
+    gAuxPb.Read();
+
+    // Shouldn't be necessary, but just to be safe unlock the web mutex.
+    WebData::Unlock();
+} // End setup().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// loop()
+//
+// Standard Arduino main loop.  Here we mainly select whether to run the menu
+// subsystem or the main display screen.
+/////////////////////////////////////////////////////////////////////////////////
+void loop()
+{
+    // Number of milliseconds to delay at the end of each loop() execution.
+    const uint32_t LOOP_DELAY = 2;
+
+    // Always update the scale weight and environmental data.
+    UpdateCurrentWeight();
+    UpdateCurrentEnv();
+
+    // Always handle the network.
+    gNetwork.Process();
+
+    // Let the usage journal erase ahead of need.
+    gJournal.Process();
+
+    // Do any deferred NVS save.
+    NvsStore::Process(millis());
+
+    // If web had the lock and timed out, then clear the lock.
+    WebData::HandleWebTimeout();
+
+    // Handle the Aux Pushbutton.  Must be done before net/menu polling.
+    HandleAuxPb();
+
+    // Are we running the menu now?
+    if (gRunningMenu)
+    {
+        // Yes, run the menu subsystem.
+        gNavRoot.poll();
+    }
+    else
+    {
+        // No, display the main screen.
+        HandleMainScreen();
+    }
+
+    // Delay to allow background to run.
+    delay(LOOP_DELAY);
+} // End loop().
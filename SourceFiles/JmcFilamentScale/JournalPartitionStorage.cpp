@@ -0,0 +1,101 @@
+/////////////////////////////////////////////////////////////////////////////////
+// JournalPartitionStorage.cpp
+//
+// Contains methods defined by the JournalPartitionStorage class.  These
+// methods access a raw flash partition with the ESP-IDF partition API.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Arduino.h>                    // For Serial.
+#include "JournalPartitionStorage.h"    // For JournalPartitionStorage class.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - pLabel - Label of the partition to use in preference to "spiffs".
+/////////////////////////////////////////////////////////////////////////////////
+JournalPartitionStorage::JournalPartitionStorage(const char *pLabel) :
+    m_pLabel(pLabel), m_pPartition(NULL), m_NumSectors(0U)
+{
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Begin()
+//
+// Finds the partition.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if there is no usable
+//    partition.
+/////////////////////////////////////////////////////////////////////////////////
+bool JournalPartitionStorage::Begin()
+{
+    m_pPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                            ESP_PARTITION_SUBTYPE_ANY, m_pLabel);
+    if (m_pPartition == NULL)
+    {
+        m_pPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                ESP_PARTITION_SUBTYPE_DATA_SPIFFS,
+                                                NULL);
+        if (m_pPartition != NULL)
+        {
+            Serial.println("Journal - using the spiffs partition.");
+        }
+    }
+    if (m_pPartition == NULL)
+    {
+        Serial.println("Journal - no partition found.");
+        return false;
+    }
+
+    m_NumSectors = m_pPartition->size / SECTOR_SIZE;
+    if (m_NumSectors > MAX_SECTORS)
+    {
+        m_NumSectors = MAX_SECTORS;
+    }
+    return m_NumSectors >= 2U;
+} // End Begin().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Read()
+//
+// Reads bytes from the partition.
+/////////////////////////////////////////////////////////////////////////////////
+bool JournalPartitionStorage::Read(size_t offset, void *pBuf, size_t size)
+{
+    return (m_pPartition != NULL) &&
+           (esp_partition_read(m_pPartition, offset, pBuf, size) == ESP_OK);
+} // End Read().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Write()
+//
+// Writes bytes to the partition.
+/////////////////////////////////////////////////////////////////////////////////
+bool JournalPartitionStorage::Write(size_t offset, const void *pData, size_t size)
+{
+    return (m_pPartition != NULL) &&
+           (esp_partition_write(m_pPartition, offset, pData, size) == ESP_OK);
+} // End Write().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// EraseSector()
+//
+// Erases one sector of the partition.
+/////////////////////////////////////////////////////////////////////////////////
+bool JournalPartitionStorage::EraseSector(size_t sector)
+{
+    return (m_pPartition != NULL) && (sector < m_NumSectors) &&
+           (esp_partition_erase_range(m_pPartition, sector * SECTOR_SIZE,
+                                      SECTOR_SIZE) == ESP_OK);
+} // End EraseSector().
@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////////
+// JournalPartitionStorage.h
+//
+// This class implements the JournalPartitionStorage class.  It keeps the
+// usage journal in a raw ESP32 flash partition, bypassing any file system.
+//
+// The partition is the data partition labelled "journal" if the partition
+// table has one.  Otherwise the "spiffs" data partition of the standard
+// Arduino partition tables is borrowed (the sketch doesn't use SPIFFS).  At
+// most MAX_SECTORS sectors are used, which bounds the time taken to recover
+// the journal at power up.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined JOURNALPARTITIONSTORAGE_H
+#define JOURNALPARTITIONSTORAGE_H
+
+#include <esp_partition.h>      // For esp_partition_t, ...
+#include "JournalStorage.h"     // For JournalStorage interface.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// JournalPartitionStorage class
+/////////////////////////////////////////////////////////////////////////////////
+class JournalPartitionStorage : public JournalStorage
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - pLabel - Label of the partition to use in preference to "spiffs".
+    /////////////////////////////////////////////////////////////////////////////
+    JournalPartitionStorage(const char *pLabel);
+
+
+    // Destructor.
+    virtual ~JournalPartitionStorage() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // JournalStorage methods.  See JournalStorage.h for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool   Begin();
+    virtual size_t GetSectorSize() const    { return SECTOR_SIZE; }
+    virtual size_t GetNumSectors() const    { return m_NumSectors; }
+    virtual bool   Read(size_t offset, void *pBuf, size_t size);
+    virtual bool   Write(size_t offset, const void *pData, size_t size);
+    virtual bool   EraseSector(size_t sector);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const size_t SECTOR_SIZE = 4096U;
+    static const size_t MAX_SECTORS = 64U;     // 256 KB.
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    JournalPartitionStorage(JournalPartitionStorage &rJps);
+    JournalPartitionStorage &operator=(JournalPartitionStorage &rJps);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    const char            *m_pLabel;    // Preferred partition label.
+    const esp_partition_t *m_pPartition;// The partition, once found.
+    size_t                 m_NumSectors;// Sectors used.
+
+}; // End class JournalPartitionStorage.
+
+
+
+#endif // JOURNALPARTITIONSTORAGE_H
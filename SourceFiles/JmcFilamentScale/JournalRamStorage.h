@@ -0,0 +1,158 @@
+/////////////////////////////////////////////////////////////////////////////////
+// JournalRamStorage.h
+//
+// This class implements the JournalRamStorage class.  It keeps the journal in
+// RAM that behaves like NOR flash (erase sets bytes to 0xFF, writes can only
+// clear bits), so that the UsageJournal code can be exercised off target.
+//
+// It also counts the erases of each sector, and can simulate a power loss: once
+// a set number of bytes has been written, the write in progress is torn (only
+// its first bytes reach the storage), an erase in progress is left half done,
+// and everything after that fails until PowerOn() is called.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined JOURNALRAMSTORAGE_H
+#define JOURNALRAMSTORAGE_H
+
+#include <cstdlib>              // For malloc() and free().
+#include <cstring>              // For memset().
+#include "JournalStorage.h"     // For JournalStorage interface.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// JournalRamStorage class
+/////////////////////////////////////////////////////////////////////////////////
+class JournalRamStorage : public JournalStorage
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.  The storage starts out erased.
+    //
+    // Arguments:
+    //    - sectorSize - Bytes per sector.
+    //    - numSectors - Number of sectors.
+    /////////////////////////////////////////////////////////////////////////////
+    JournalRamStorage(size_t sectorSize, size_t numSectors) :
+        m_SectorSize(sectorSize), m_NumSectors(numSectors),
+        m_pData(static_cast<uint8_t *>(malloc(sectorSize * numSectors))),
+        m_pErases(static_cast<uint32_t *>(calloc(numSectors, sizeof(uint32_t)))),
+        m_BytesWritten(0UL), m_Budget(NO_LIMIT), m_PoweredOff(false)
+    {
+        if (m_pData != NULL)
+        {
+            memset(m_pData, 0xFF, sectorSize * numSectors);
+        }
+    }
+
+
+    // Destructor.
+    virtual ~JournalRamStorage()
+    {
+        free(m_pData);
+        free(m_pErases);
+    }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // JournalStorage methods.  See JournalStorage.h for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool   Begin()                  { return (m_pData != NULL) && (m_pErases != NULL); }
+    virtual size_t GetSectorSize() const    { return m_SectorSize; }
+    virtual size_t GetNumSectors() const    { return m_NumSectors; }
+
+    virtual bool Read(size_t offset, void *pBuf, size_t size)
+    {
+        if (m_PoweredOff || (offset + size > m_SectorSize * m_NumSectors))
+        {
+            return false;
+        }
+        memcpy(pBuf, &m_pData[offset], size);
+        return true;
+    }
+
+    virtual bool Write(size_t offset, const void *pData, size_t size)
+    {
+        if (m_PoweredOff || (offset + size > m_SectorSize * m_NumSectors))
+        {
+            return false;
+        }
+        const uint8_t *pBytes = static_cast<const uint8_t *>(pData);
+        for (size_t i = 0U; i < size; i++)
+        {
+            if (m_BytesWritten >= m_Budget)
+            {
+                m_PoweredOff = true;
+                return false;
+            }
+            m_pData[offset + i] &= pBytes[i];
+            m_BytesWritten++;
+        }
+        return true;
+    }
+
+    virtual bool EraseSector(size_t sector)
+    {
+        if (m_PoweredOff || (sector >= m_NumSectors))
+        {
+            return false;
+        }
+        if (m_BytesWritten >= m_Budget)
+        {
+            memset(&m_pData[sector * m_SectorSize], 0xFF, m_SectorSize / 2U);
+            m_PoweredOff = true;
+            return false;
+        }
+        memset(&m_pData[sector * m_SectorSize], 0xFF, m_SectorSize);
+        m_pErases[sector]++;
+        return true;
+    }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Power loss simulation.  SetWriteBudget() sets the number of bytes that
+    // may still be written before the power fails.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetWriteBudget(uint32_t bytes)     { m_Budget = m_BytesWritten + bytes; }
+    void PowerOn()                          { m_PoweredOff = false; m_Budget = NO_LIMIT; }
+    bool IsPoweredOff() const               { return m_PoweredOff; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Statistics.
+    /////////////////////////////////////////////////////////////////////////////
+    uint32_t GetBytesWritten() const        { return m_BytesWritten; }
+    uint32_t GetErases(size_t sector) const { return m_pErases[sector]; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint32_t NO_LIMIT = 0xFFFFFFFFUL;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    JournalRamStorage(JournalRamStorage &rJrs);
+    JournalRamStorage &operator=(JournalRamStorage &rJrs);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    const size_t m_SectorSize;          // Bytes per sector.
+    const size_t m_NumSectors;          // Number of sectors.
+    uint8_t     *m_pData;               // The "flash".
+    uint32_t    *m_pErases;             // Erases of each sector.
+    uint32_t     m_BytesWritten;        // Total bytes written.
+    uint32_t     m_Budget;              // m_BytesWritten at the power failure.
+    bool         m_PoweredOff;          // The power has failed.
+
+}; // End class JournalRamStorage.
+
+
+
+#endif // JOURNALRAMSTORAGE_H
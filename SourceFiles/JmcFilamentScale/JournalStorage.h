@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////////
+// JournalStorage.h
+//
+// This file defines the JournalStorage interface.  It gives the UsageJournal
+// class access to an area of NOR flash made up of equal sized sectors, with
+// flash semantics: an erase sets every byte of a sector to 0xFF, and a write
+// can only clear bits.  The following storages are available:
+//    - JournalPartitionStorage - A raw ESP32 flash partition.
+//    - JournalRamStorage       - RAM that behaves like flash (no hardware
+//                                required), with simulated power loss.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined JOURNALSTORAGE_H
+#define JOURNALSTORAGE_H
+
+#include <cstddef>      // For size_t.
+#include <cstdint>      // For uint8_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// JournalStorage class
+//
+// Abstract interface implemented by each of the journal storages.
+/////////////////////////////////////////////////////////////////////////////////
+class JournalStorage
+{
+public:
+    // Destructor.
+    virtual ~JournalStorage() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Begin()
+    //
+    // Finds (or allocates) the storage area.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool Begin() = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetSectorSize(), GetNumSectors()
+    //
+    // Return the erase unit, in bytes, and the number of them.  Only valid once
+    // Begin() has succeeded.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual size_t GetSectorSize() const = 0;
+    virtual size_t GetNumSectors() const = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Read()
+    //
+    // Reads bytes from the storage.
+    //
+    // Arguments:
+    //    - offset - Byte offset from the start of the storage.
+    //    - pBuf   - Where to put the bytes.
+    //    - size   - Number of bytes.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool Read(size_t offset, void *pBuf, size_t size) = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Write()
+    //
+    // Writes bytes to erased storage.  The bytes must not cross a sector
+    // boundary.
+    //
+    // Arguments:
+    //    - offset - Byte offset from the start of the storage.
+    //    - pData  - The bytes.
+    //    - size   - Number of bytes.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool Write(size_t offset, const void *pData, size_t size) = 0;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // EraseSector()
+    //
+    // Sets every byte of a sector to 0xFF.  This is slow (tens of milliseconds
+    // on the ESP32) and wears the flash.
+    //
+    // Arguments:
+    //    - sector - The sector number.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    virtual bool EraseSector(size_t sector) = 0;
+
+}; // End class JournalStorage.
+
+
+
+#endif // JOURNALSTORAGE_H
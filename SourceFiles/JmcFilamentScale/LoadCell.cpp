@@ -1,667 +1,1478 @@
-/////////////////////////////////////////////////////////////////////////////////
-// LoadCell.cpp
-//
-// Contains methods defined by the LoadCell class.  These methods
-// manage the  HX711 Weigh LoadCell sensor.
-//
-// History:
-// - jmcorbett 29-AUG-2020 Original creation.
-//
-// Copyright (c) 2021, Joseph M. Corbett
-/////////////////////////////////////////////////////////////////////////////////
-
-#include "LoadCell.h"       // For LoadCell class.
-#include <Preferences.h>    // For Save and Restore to/from NVS.
-
-
-// Setup some conversion constants.
-const double LoadCell::GRAMS_PER_KILOGRAM       = 1000.0d;
-const double LoadCell::GRAMS_PER_POUND          = 453.592d;
-const double LoadCell::OUNCES_PER_POUND         = 16.0d;
-const double LoadCell::GRAMS_PER_OUNCE          = GRAMS_PER_POUND / OUNCES_PER_POUND;
-const double LoadCell::UNCALIBRATED_READ_VALUE  = -999999999.9d;
-const double LoadCell::DEFAULT_AVERAGE_INTERVAL = 10.0d;
-
-const char *LoadCell::pPrefSavedStateLabel  = "Saved State";
-const char *LoadCell::UnitsStrings[]        = {" g", " kg", " oz", " lb"};
-
-static const size_t MAX_NVS_NAME_LEN = 15U;
-
-
-/////////////////////////////////////////////////////////////////////////////
-// Construct and initialize the library and the pins used for the load cell.
-// The device is initialized with the specified gain and interface pins.
-//
-// Arguments:
-//    - dout   - This specifies the GPIO pin used to connect to the HX711 DOUT
-//               (Serial Data Out) pin.
-//    - scl    - This specifies the GPIO pin used to connect to the HX711
-//               PD_SCK (Power Down and Serial Clock Input) pin.
-//    - gain   - valid values are 64 and 128.  This assumes that the load cell
-//               is connected to channel A of the HX711.
-/////////////////////////////////////////////////////////////////////////////
-LoadCell::LoadCell(int dout, int sck, uint8_t gain) : HX711(), m_Gain(gain),
-        m_RawTareWeight(0L), m_IsCalibrated(false), m_Offset(0.0d),
-        m_Units(eWuGrams), m_AverageInterval(DEFAULT_AVERAGE_INTERVAL),
-        m_UnitsScaleFactor(1.0d), m_ConversionFactor(1.0),
-        m_MovingAverage(DEFAULT_AVERAGE_INTERVAL), m_pName(NULL)
-{
-    begin(dout, sck, gain);
-} // End constructor.
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Init()
-//
-// This method initializes the load cell.
-//
-// Arguments:
-//    - pName   - A string of no more than 15 characters to be used as a
-//                name for this instance.  This is mainly used to identify
-//                the instance to be used for NVS save and restore.
-//
-// Returns:
-//    Returns a bool indicating whether or not the initialization was successful.
-//    A 'true' value indicates success, while a 'false' value indicates failure.
-//
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::Init(const char *pName)
-{
-    bool status = false;
-
-    if (IsPresent() && (pName != NULL) && (*pName != '\0') &&
-        (strlen(pName) <= MAX_NVS_NAME_LEN))
-    {
-        m_pName = pName;
-        status = true;
-    }
-    return status;
-} // End Init().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SetGain()
-//
-// Sets the gain that will be used by the load cell.
-//
-// Arguments:
-//    - gain - valid values are 64 and 128.  This assumes that the load cell
-//             is connected to channel A of the HX711.
-//
-// Returns:
-//    Returns a bool indicating whether or not the operation was successful.
-//    A value of 'true' indicates success.  A value of 'false' indicates
-//    failure.
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::SetGain(uint8_t gain)
-{
-    // Assume we're going to fail.
-    bool status = false;
-
-    // If the gain value has changed and is OK then set the new gain.
-    if (((gain == 128U) || (gain == 64U)) && (gain != m_Gain))
-    {
-        // Need to recalibrate since the gain has changed.
-        m_IsCalibrated = false;
-
-        // Set the new gain.
-        m_Gain = gain;
-        set_gain(m_Gain);
-        status = true;
-
-        // Take a throwaway reading to clear out the value from the previous
-        // gain setting.
-        ReadARawValue();
-
-        // Seed our average value with a new raw reading.
-        ResetAverage();
-    }
-    // Return the success/failre status.
-    return status;
-} // End SetGain().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// IsPresent()
-//
-// Determines whether or not a load cell sensor is present.
-//
-// Returns:
-//   Returns true if a load cell was detected, or false otherwise.
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::IsPresent() const
-{
-    // Assume success.
-    bool status = true;
-
-    // We can't simply wait for the card to be ready since when no card is
-    // present, the DOUT pin can be read as low, which is how the library
-    // determines whether or not the HX711 is ready.  However, when no HX711
-    // is present, a read() of the device will return a value of 0.  So we use
-    // this as an indicator as to whether or not the sensor is present.
-    if (!wait_ready_retry(10U, 10U) || (ReadARawValue() == 0L))
-    {
-        // Looks like we didn't detect a card.
-        status = false;
-    }
-
-    // Let the caller know our status.
-    return status;
-} // End IsPresent().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// ReadRawAverage()
-//
-// This method takes the average of a number of readings and verifies that ALL
-// read values are within a limit, thus insuring that the returned value is valid.
-//
-// Arguments:
-//   - count - This specifies the number of readings that will be used to
-//             calculate an average that will be used as the returned weight
-//             value.
-//
-// Returns:
-//   If successful, returns the average value read from the 'count' readings
-//   that were taken.  If any values fall outside of an acceptable range,
-//   then a value of 0 is returned indicating failure.
-/////////////////////////////////////////////////////////////////////////////////
-uint32_t LoadCell::ReadRawAverage(uint16_t count)
-{
-    // We need to keep track of the sum of the readings to calculate the
-    // average value.  We also need to determine the minimum and maximum
-    // values that are read in order to insure that the readings are
-    // acceptable (within an acceptable spread).
-    int32_t sum = 0L;
-    int32_t min = INT_MAX;
-    int32_t max = INT_MIN;
-
-    // *** For some reason, the first read always seems higher than it should
-    // *** be.  Haven't been able to find the reason for this.
-    // *** Take a throwaway reading to get rid of the (probably) high first one.
-    ReadARawValue();
-
-    // Gather the readings, and update our sum, min and max values.
-    for (uint16_t i = 0U; i < count; i++)
-    {
-        int32_t weight = ReadARawValue();
-        Serial.println(weight);
-        sum += weight;
-        if (weight < min)
-        {
-            min = weight;
-        }
-        if (weight > max)
-        {
-            max = weight;
-        }
-    }
-
-    // Calculate the average and the limit values.
-    // We want all readings to be within 0.125% of the average, 
-    // (1.25/1000 = .00125).  This is a precaution to try to reject readings
-    // that are taken while the scale is being disturbed.  If any individual
-    // value falls outside the range of  average +/- .125% the readings will be
-    //rejected, and a value of 0 will be returned, indicating an error.
-    
-    const int32_t LIMIT_DIVISOR = 800;
-    int32_t avg = sum / count;
-    int32_t upperLimit = avg + avg / LIMIT_DIVISOR;
-    int32_t lowerLimit = avg - avg / LIMIT_DIVISOR;
-    Serial.print("Read average = ");
-    Serial.println(avg);
-    Serial.print("Read min = ");
-    Serial.println(min);
-    Serial.print("Read max = ");
-    Serial.println(max);
-    Serial.print("Read span = ");
-    Serial.println(max - min);
-    Serial.print("Read positive limit = ");
-    Serial.println(upperLimit);
-    Serial.print("Read negative limit = ");
-    Serial.println(lowerLimit);
-    Serial.print("Read min, max head room: ");
-    Serial.print(min - lowerLimit);
-    Serial.print(", ");
-    Serial.println(upperLimit - max);
-
-    // See if the average value falls within our acceptable limit.
-    if ((max < upperLimit) && (min > lowerLimit))
-    {
-        // Average is acceptable.
-        Serial.println("Good value read.");
-    }
-    else
-    {
-        // Average is not acceptable.  Return a value of 0.
-        avg = 0;
-        Serial.println("Bad value read.");
-    }
-
-    // Let the caller know our read average, or 0 if unsuccessful.
-    return avg;
-} // End ReadRawAverage().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Tare()
-//
-// This method calculates the tare offset for the scale.  This is the value that
-// is reported when the scale is empty.  The calculated offset is used in future
-// calculations to report object weights.
-//
-// The HX711 library contains a tare() method, but it simply calculates the
-// average of a number of readings.  This method is different in that it takes
-// the average of a number of readings and verifies that ALL received values are
-// within a limit, thus insuring that the saved tare value is valid.
-//
-// Arguments:
-//   - count - This specifies the number of readings that will be used to
-//             calculate an average that will be used as the tare weight
-//             value.
-//
-// Returns:
-//   Returns 'true' if the tare value was successfully calculated.  Returns
-//   'false' otherwise.
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::Tare(uint16_t count)
-{
-    // Allow load cell time for first reading.
-    delay(500);
-
-    uint32_t tareValue = ReadRawAverage(count);
-    if (tareValue)
-    {
-        m_RawTareWeight  = tareValue;
-        m_MovingAverage.Reset();
-        Serial.print("Tare using weight = ");
-        Serial.println(tareValue);
-    }
-    return tareValue != 0;
-} // End Tare().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Calibrate()
-//
-// This method calculates and sets the base and display scale factors given
-// a raw reading and the cooked value that it represents.
-//
-// Note: We maintain a scale factor, 'm_UnitsScaleFactor', which is used
-//       to return scaled values based on the selected units to the user.
-//
-// Arguments:
-//   - rawWeight       - This specifies the raw reading from  the HX711.  If 0,
-//                       then read an averaged value from the sensor.
-//   - cookedCalWeight - This specifies the value that should be displayed when
-//                       the  HX711 returns a value equal to the value of
-//                       'rawCalWeight'.
-//
-// Returns:
-// Returns 'true' if successful, false otherwise.  Will only succeed if a
-// successful tare was previously completed and a raw calibration weight is
-// successfully read.
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::Calibrate(uint32_t rawCalWeight, double cookedCalWeight)
-{
-    // Allow load cell time for first reading.
-    delay(500);
-
-    // We can only calibrate if a successful tare has been done.
-    if (m_RawTareWeight == 0L)
-    {
-        return false;
-    }
-
-    // Special case when the value of 'raw' is 0, we read a raw value from
-    // the HX711.
-    if (rawCalWeight == 0UL)
-    {
-        rawCalWeight = ReadRawAverage();
-        if (rawCalWeight == 0UL)
-        {
-            return false;
-        }
-    }
-
-    // Seed our averaging code.
-    m_MovingAverage.Reset();
-
-    // The display scale factor is simply the ratio of the cooked and raw values.
-    m_UnitsScaleFactor =
-        cookedCalWeight / static_cast<double>(rawCalWeight - m_RawTareWeight);
-
-    // Remember that we've been calibrated.
-    m_IsCalibrated = true;
-
-    return true;
-} // End Calibrate().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// GetBaseUnitsFactor()
-//
-// Returns the scale factor used to convert the given weight units to the
-// base units (grams).
-//
-// Arguments:
-//   - units - This specifies the units to convert from.
-//
-// Returns:
-// Returns the double scale factor that may be used to convert the given
-// units to base units.  A value of 0.0 indicates that an invalid value
-// was passed in the 'units' argument.
-/////////////////////////////////////////////////////////////////////////////////
-double LoadCell::GetBaseUnitsFactor(WeightUnits units)
-{
-    double baseFactor = 0.0;
-    switch (units)
-    {
-    case eWuGrams:
-        // We use grams as our base units.
-        baseFactor = 1.0d;;
-        break;
-    case eWuKiloGrams:
-        baseFactor = GRAMS_PER_KILOGRAM;
-        break;
-    case eWuOunces:
-        baseFactor = GRAMS_PER_OUNCE;
-        break;
-    case eWuPounds:
-        baseFactor = GRAMS_PER_POUND;
-        break;
-    default:
-        // We will return 0.0 if the specified units are no good.
-        break;
-    }
-
-    return baseFactor;
-} // End GetBaseUnitsFactor().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// ReadWeight()
-//
-// This method reads a value from the HX711 and returns the scaled value
-// representing the read weight scaled and offset by the value of m_Offset.
-//
-// Returns:
-//    Returns the scaled and offset value if successful.  Otherwise it returns
-//    a value of UNCALIBRATED_READ_VALUE.
-/////////////////////////////////////////////////////////////////////////////////
-double LoadCell::ReadWeight()
-{
-    // Assume that we fail.
-    double scaledValue = UNCALIBRATED_READ_VALUE;
-
-    // If we haven't been calibrated yet, then we fail.
-    if (m_IsCalibrated)
-    {
-        // Let's convert the averaged weight to a double.
-        double doubleWeight = static_cast<double>(ReadAndAverageRawWeight());
-
-        // Scale the value.
-        scaledValue =
-            ((doubleWeight - static_cast<double>(m_RawTareWeight)) *
-                    m_UnitsScaleFactor
-            ) - m_Offset;
-    }
-
-    return scaledValue;
-} // End ReadWeight().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// ResetAverage()
-//
-// Reset the moving average total to 0.
-/////////////////////////////////////////////////////////////////////////////////
-void LoadCell::ResetAverage()
-{
-    m_MovingAverage.Reset();
-} // End ResetAverage().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// ReadAndAverageRawWeight()
-//
-// Take a reading from the HX711 and average it over the rolling average
-// interval.  Return the result.
-//
-// Returns:
-// Always returns the newly calculated value for m_RollingAverage.
-/////////////////////////////////////////////////////////////////////////////////
-int64_t LoadCell::ReadAndAverageRawWeight()
-{
-    // Update our moving average total.
-    m_MovingAverage.Add(ReadARawValue());
-
-    // Return the new average.
-    return m_MovingAverage.Average();
-} // End ReadAndAverageRawWeight().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SetAverageInterval()
-//
-// Sets the number of intervals that will be used for raw weight averaging.
-//
-// Arguments:
-//   - interval - This is the number of intvals to use for the raw weight
-//                averaging calculation.  Must be an integer greater than 0.
-//
-// Returns:
-// Returns 'true' if successful, or 'false' if the value was limited.
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::SetAverageInterval(int32_t interval)
-{
-    // Set the new size.
-    m_MovingAverage.SetSize(interval);
-
-    // Get the size (may have been limited) and remember it.
-    int32_t size = m_MovingAverage.Size();
-    m_AverageInterval = static_cast<double>(size);
-
-    // Let the user know if the requested size was accepted or limited.
-    return size == interval;
-} // End SetAverageInterval().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SetUnits()
-//
-// This method is used to change the units that will be displayed.  It calculates
-// a new m_UnitsScaleFactor value and saves it and the newly selected units
-// value.  It also updates the m_Offset value.
-//
-// Arguments:
-//   - newUnits - This specifies the new display units type.
-//
-// Returns:
-// Returns 'true' if successful, false otherwise.  Can only fail if the new
-// units is specified as an invalid value.  In this case, m_Units is not changed.
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::SetUnits(WeightUnits newUnits)
-{
-    bool status = true;
-
-    // Calculate the new m_UnitsScaleFactor and m_Offset values.
-    if (newUnits != m_Units)
-    {
-        // We calculate a multiplier to be used to determine the new values for
-        // our current offset and scale factors.  To do this, we calculate a
-        // factor by essentially converting the current units to base units,
-        // then converting the resulting base units to the newly specified units.
-        WeightUnits oldUnits  = m_Units;
-        double toBaseFactor   = GetBaseUnitsFactor(oldUnits);
-        double fromBaseFactor = GetBaseUnitsFactor(newUnits);
-        if ((toBaseFactor == 0.0d) || (fromBaseFactor == 0.0d))
-        {
-            // If either of the returned factors is 0.0, this implies that the
-            // corresponding call to GetBaseUnitsFactor() failed.
-            status = false;
-        }
-        else
-        {
-            // The returned factors were good, so determine our multiplier.
-            m_ConversionFactor = toBaseFactor / fromBaseFactor;
-
-            // Adjust the existing offset and scale factor values and save the
-            // new units value.  Protect these settings so they will be seen
-            // as an atomic change.
-            noInterrupts();
-            m_Offset            *= m_ConversionFactor;
-            m_UnitsScaleFactor  *= m_ConversionFactor;
-            m_Units              = newUnits;
-            interrupts();
-        }
-    }
-
-    return status;
-} // End SetUnits().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Save()
-//
-// Saves our current state to NVS.
-//
-// Returns:
-//    Returns 'true' if successful, or 'false' otherwise.
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::Save() const
-{
-    size_t saved = 0;
-    if (m_pName != NULL)
-    {
-        // Cache our state information for transfer to NVS as a single unit.
-        SaveRestoreCache currentState;
-        currentState.m_Gain             = m_Gain;
-        currentState.m_RawTareWeight    = m_RawTareWeight;
-        currentState.m_IsCalibrated     = m_IsCalibrated;
-        currentState.m_Offset           = m_Offset;
-        currentState.m_Units            = m_Units;
-        currentState.m_AverageInterval  = m_AverageInterval;
-        currentState.m_UnitsScaleFactor = m_UnitsScaleFactor;
-        currentState.m_ConversionFactor = m_ConversionFactor;
-
-        // Prepare for NVS use.
-        Preferences prefs;
-        prefs.begin(m_pName);
-
-        // Fetch our currently saved NVS data for comparison.
-        SaveRestoreCache nvsState;
-        size_t nvsSize =
-            prefs.getBytes(pPrefSavedStateLabel, &nvsState,
-                           sizeof(SaveRestoreCache));
-
-        // Compare the saved and current data.  If it hasn't changed, then
-        // we don't need to save anything (saving NVS writes).
-        if ((nvsSize != sizeof(SaveRestoreCache)) ||
-            memcmp(&nvsState, &currentState, sizeof(SaveRestoreCache)))
-        {
-            // NVS and working didn't match, so save the working.
-            saved =
-                prefs.putBytes(pPrefSavedStateLabel, &currentState,
-                               sizeof(SaveRestoreCache));
-            Serial.println("\nLoadCell - saving to NVS.");
-        }
-        else
-        {
-            // NVS matched working.  Simply setup to return success.
-            saved = sizeof(SaveRestoreCache);
-            Serial.println("\nLoadCell - not saving to NVS");
-        }
-        prefs.end();
-    }
-
-    // Let the caller know if we succeeded or failed.
-    return saved == sizeof(SaveRestoreCache);
- } // End Save().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Restore()
-//
-// Restores our state from NVS.
-//
-// Returns:
-//    Returns 'true' if successful, or 'false' otherwise.
-/////////////////////////////////////////////////////////////////////////////////
-bool LoadCell::Restore()
-{
-    // Assume we're gonna fail.
-    bool succeeded = false;
-
-    // Make sure we have a valid name.
-    if (m_pName != NULL)
-    {
-        // Restore our state data to a temporary structure.
-        SaveRestoreCache cachedState;
-        Preferences prefs;
-        prefs.begin(m_pName);
-        size_t restored =
-            prefs.getBytes(pPrefSavedStateLabel, &cachedState, sizeof(SaveRestoreCache));
-
-        // Save the restored values only if the get was successful.
-        if (restored == sizeof(cachedState))
-        {
-            // Set our calibrated variable.
-            m_IsCalibrated = cachedState.m_IsCalibrated;
-
-            // Set the gain.
-            SetGain(cachedState.m_Gain);
-
-            // Set the tare weight.
-            m_RawTareWeight  = cachedState.m_RawTareWeight;
-
-            // Set our scale factor.
-            m_UnitsScaleFactor = cachedState.m_UnitsScaleFactor;
-
-            // Set our averaging interval.
-            m_AverageInterval = cachedState.m_AverageInterval;
-            m_MovingAverage.SetSize(static_cast<int32_t>(m_AverageInterval));
-
-            // Set our offset (if any).
-            m_Offset = cachedState.m_Offset;
-
-            // Set our units.
-            m_Units = cachedState.m_Units;
-
-            // Set our conversion factor.
-            m_ConversionFactor = cachedState.m_ConversionFactor;
-
-            succeeded = true;
-        }
-        prefs.end();
-    }
-
-    // Let the caller know if we succeeded or failed.
-    return succeeded;
- } // End Restore().
-
-
-/////////////////////////////////////////////////////////////////////////////
-// Reset()
-//
-// Reset our state info in NVS.
-//
-// Returns:
-//    Returns 'true' if successful, or 'false' otherwise.
-/////////////////////////////////////////////////////////////////////////////
-bool LoadCell::Reset()
-{
-    bool status = false;
-    if (m_pName != NULL)
-    {
-        // Remove our state data rom NVS.
-        Preferences prefs;
-        prefs.begin(m_pName);
-        status = prefs.remove(pPrefSavedStateLabel);
-        prefs.end();
-    }
-    return status;
-} // End Reset().
-
-
-
+/////////////////////////////////////////////////////////////////////////////////
+// LoadCell.cpp
+//
+// Contains methods defined by the LoadCell class.  These methods
+// manage the  HX711 Weigh LoadCell sensor.
+//
+// History:
+// - jmcorbett 29-AUG-2020 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "LoadCell.h"       // For LoadCell class.
+#include "NvsStore.h"       // For Save and Restore to/from NVS.
+
+
+// Setup some conversion constants.
+const double LoadCell::GRAMS_PER_KILOGRAM       = 1000.0d;
+const double LoadCell::GRAMS_PER_POUND          = 453.592d;
+const double LoadCell::OUNCES_PER_POUND         = 16.0d;
+const double LoadCell::GRAMS_PER_OUNCE          = GRAMS_PER_POUND / OUNCES_PER_POUND;
+const double LoadCell::UNCALIBRATED_READ_VALUE  = -999999999.9d;
+const double LoadCell::DEFAULT_AVERAGE_INTERVAL = 10.0d;
+const double LoadCell::STEP_THRESHOLD_GRAMS     = 5.0d;
+const double LoadCell::TARE_CI_GRAMS            = 0.1d;
+const double LoadCell::TARE_CI_COUNTS           = 40.0d;    // Until calibrated.
+const double LoadCell::TARE_CI_FAIL_FACTOR      = 3.0d;
+const double LoadCell::OUTLIER_MADS             = 3.5d;
+
+const char *LoadCell::pPrefSavedStateLabel  = "Saved State";
+const char *LoadCell::pPrefFilterLabel      = "Filters";
+const char *LoadCell::pPrefCalTableLabel    = "Cal Table";
+const char *LoadCell::pPrefTempCompLabel    = "Temp Comp";
+const char *LoadCell::pPrefZeroTrackLabel   = "Zero Track";
+const char *LoadCell::pPrefRangeLabel       = "Gain Range";
+const char *LoadCell::UnitsStrings[]        = {" g", " kg", " oz", " lb"};
+
+static const size_t MAX_NVS_NAME_LEN = 15U;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Construct and initialize the load cell.  The transport selects how the HX711
+// is read (bit-banged GPIO, SPI peripheral, or simulated).  The device itself
+// is set up with the specified gain by Init().
+//
+// Arguments:
+//    - pTransport - This specifies the transport used to talk to the HX711.
+//                   It must remain valid for the life of the LoadCell.
+//    - gain       - valid values are 64, 128 and AUTO_GAIN.  This assumes that
+//                   the load cell is connected to channel A of the HX711.
+/////////////////////////////////////////////////////////////////////////////
+LoadCell::LoadCell(HX711Transport *pTransport, uint8_t gain) : m_Gain(gain),
+        m_RawTareWeight(0L), m_IsCalibrated(false), m_Offset(0.0d),
+        m_Units(eWuGrams), m_AverageInterval(DEFAULT_AVERAGE_INTERVAL),
+        m_AverageTimeMs(0UL), m_UnitsScaleFactor(1.0d), m_ConversionFactor(1.0),
+        m_Filters(DEFAULT_AVERAGE_INTERVAL), m_pName(NULL),
+        m_pTransport(pTransport), m_AcqTask(NULL), m_SampleQueue(),
+        m_SampleQuality(), m_CalTable(), m_TempComp(),
+        m_ZeroTracker(), m_Scheduler(gain), m_ChannelBRaw(0L), m_ChannelBCount(0UL),
+        m_ConversionRate(OUTPUT_RATE_SPS), m_Decimator(1U), m_DecimatorReset(false),
+        m_FixedScale()
+{
+    m_AverageTimeMs = IntervalToMs(m_AverageInterval);
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Init()
+//
+// This method initializes the load cell.  The transport is set up, the HX711 is
+// checked for presence, and background acquisition is started.
+//
+// Arguments:
+//    - pName   - A string of no more than 15 characters to be used as a
+//                name for this instance.  This is mainly used to identify
+//                the instance to be used for NVS save and restore.
+//
+// Returns:
+//    Returns a bool indicating whether or not the initialization was successful.
+//    A 'true' value indicates success, while a 'false' value indicates failure.
+//
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::Init(const char *pName)
+{
+    bool status = false;
+
+    if ((m_pTransport != NULL) && m_pTransport->Begin(m_Scheduler.GetProgramGain()) &&
+        IsPresent() && (pName != NULL) && (*pName != '\0') &&
+        (strlen(pName) <= MAX_NVS_NAME_LEN))
+    {
+        m_pName = pName;
+        status = StartAcquisition();
+    }
+    return status;
+} // End Init().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// StartAcquisition()
+//
+// Starts the background acquisition of HX711 conversions.  A task pinned to
+// ACQ_TASK_CORE is woken by a falling edge interrupt on the DOUT pin each time
+// a conversion is ready.  The task reads the conversion and places it into
+// m_SampleQueue where it is later consumed by ReadWeight() and the other
+// methods that need raw readings.
+//
+// Host (simulation) builds have no scheduler, so no task is created there and
+// ReadARawValue() reads the transport directly.
+//
+// Returns:
+//    Returns 'true' if acquisition is running, or 'false' if the task could
+//    not be created.  Calling this method when acquisition is already running
+//    has no effect and returns 'true'.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::StartAcquisition()
+{
+    // Nothing to do if we're already running.
+    if (m_AcqTask != NULL)
+    {
+        return true;
+    }
+
+    // Start with an empty queue so that only conversions taken by the task
+    // are seen by the consumer.
+    m_SampleQueue.Flush();
+
+#if defined ARDUINO_ARCH_ESP32
+    // Create the task before enabling the interrupt since the interrupt
+    // handler notifies the task.
+    TaskHandle_t task = NULL;
+    if (xTaskCreatePinnedToCore(AcquisitionTask, "LoadCell", ACQ_TASK_STACK_SIZE,
+                                this, ACQ_TASK_PRIORITY, &task,
+                                ACQ_TASK_CORE) != pdPASS)
+    {
+        Serial.println("LoadCell - acquisition task create failed.");
+        return false;
+    }
+    m_AcqTask = task;
+
+    // Wake the task on each falling edge of DOUT (data ready).  Transports
+    // without a data ready pin are simply polled at the task timeout.
+    int drdyPin = m_pTransport->GetDataReadyPin();
+    if (drdyPin != HX711Transport::NO_PIN)
+    {
+        attachInterruptArg(digitalPinToInterrupt(drdyPin), DataReadyIsr, this, FALLING);
+    }
+#endif // ARDUINO_ARCH_ESP32
+
+    return true;
+} // End StartAcquisition().
+
+
+#if defined ARDUINO_ARCH_ESP32
+/////////////////////////////////////////////////////////////////////////////////
+// AcquisitionTask()
+//
+// Body of the background acquisition task.  Waits for a data ready notification
+// from DataReadyIsr(), then reads the conversion and queues it if it is a
+// channel A sample.  A timeout is
+// used so that a missed edge only delays a reading rather than stopping
+// acquisition altogether.
+//
+// Arguments:
+//    - pArg - Pointer to the LoadCell instance that owns the task.
+/////////////////////////////////////////////////////////////////////////////////
+void LoadCell::AcquisitionTask(void *pArg)
+{
+    LoadCell *pThis = static_cast<LoadCell *>(pArg);
+
+    for (;;)
+    {
+        // Wait for the data ready interrupt (or the timeout).
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ACQ_TIMEOUT_MS));
+
+        // DOUT also toggles while the data bits are clocked out, which will
+        // cause extra notifications.  Only read when a conversion is ready.
+        int32_t value = 0L;
+        if (pThis->m_pTransport->IsReady() &&
+            pThis->HandleConversion(pThis->m_pTransport->Read(), value))
+        {
+            pThis->m_SampleQueue.Push(value);
+        }
+    }
+} // End AcquisitionTask().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DataReadyIsr()
+//
+// DOUT falling edge interrupt handler.  Simply wakes the acquisition task.
+//
+// Arguments:
+//    - pArg - Pointer to the LoadCell instance that owns the interrupt.
+/////////////////////////////////////////////////////////////////////////////////
+void IRAM_ATTR LoadCell::DataReadyIsr(void *pArg)
+{
+    LoadCell *pThis = static_cast<LoadCell *>(pArg);
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(pThis->m_AcqTask, &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken)
+    {
+        portYIELD_FROM_ISR();
+    }
+} // End DataReadyIsr().
+#endif // ARDUINO_ARCH_ESP32
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadARawValue()
+//
+// Reads a single raw weight value from the HX711.  If background acquisition is
+// running, the value is taken from the sample queue (waiting for one if
+// necessary).  Otherwise the HX711 is read directly.
+//
+// Returns:
+//    Returns an int32_t value read from the HX711.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t LoadCell::ReadARawValue()
+{
+    // Without the acquisition task, read the device directly until a channel
+    // A sample turns up.
+    if (m_AcqTask == NULL)
+    {
+        int32_t value = 0L;
+        while (!HandleConversion(m_pTransport->Read(), value))
+        {
+        }
+        return value;
+    }
+
+    // Wait for the acquisition task to deliver a conversion.  Just like
+    // HX711Transport::Read(), this blocks until the device produces a value.
+    int32_t raw = 0L;
+    while (!m_SampleQueue.Pop(raw))
+    {
+        delay(1);
+    }
+    return raw;
+} // End ReadARawValue().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleConversion()
+//
+// Passes a conversion to m_Scheduler and selects the gain of the following
+// conversion.  Channel B samples are kept for GetChannelB().  Channel A samples
+// are decimated by m_Decimator.
+//
+// Arguments:
+//    - raw    - The conversion just read from the transport.
+//    - rValue - Set to the decimated channel A sample, if any.
+//
+// Returns:
+//    Returns 'true' if the conversion produced a decimated channel A sample.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::HandleConversion(int32_t raw, int32_t &rValue)
+{
+    int32_t value = 0L;
+    SampleKind kind = m_Scheduler.Process(raw, value);
+    m_pTransport->SetGain(m_Scheduler.GetProgramGain());
+    if (kind == eSkChannelB)
+    {
+        m_ChannelBRaw = value;
+        m_ChannelBCount = m_ChannelBCount + 1UL;
+    }
+    else if (kind == eSkChannelA)
+    {
+        if (m_DecimatorReset)
+        {
+            m_DecimatorReset = false;
+            m_Decimator.Reset();
+        }
+        return m_Decimator.Process(value, rValue);
+    }
+    return false;
+} // End HandleConversion().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetChannelBInterval()
+//
+// Selects how often the HX711's channel B is read.
+//
+// Arguments:
+//    - interval - The number of channel A samples per channel B sample, or 0
+//                 to not read channel B.
+/////////////////////////////////////////////////////////////////////////////////
+void LoadCell::SetChannelBInterval(uint8_t interval)
+{
+    if (interval != GetChannelBInterval())
+    {
+        m_Scheduler.SetChannelBInterval(interval);
+        m_ChannelBCount = 0UL;
+
+        // Channel B takes conversions from channel A, so keep the averaging
+        // time the same.
+        SetAverageTime(m_AverageTimeMs);
+    }
+} // End SetChannelBInterval().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetChannelB()
+//
+// Gets the latest channel B sample.
+//
+// Arguments:
+//    - rRaw - Set to the raw channel B value.
+//
+// Returns:
+//    Returns 'true' if a channel B sample has been read, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::GetChannelB(int32_t &rRaw) const
+{
+    rRaw = m_ChannelBRaw;
+    return (GetChannelBInterval() != 0U) && (m_ChannelBCount != 0UL);
+} // End GetChannelB().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetGain()
+//
+// Sets the gain that will be used by the load cell.  The change is made by
+// m_Scheduler, which also discards the conversions taken before it.  Auto
+// ranging readings are in gain 128 counts, so switching between 128 and
+// AUTO_GAIN keeps the calibration.
+//
+// Arguments:
+//    - gain - valid values are 64, 128 and AUTO_GAIN.  This assumes that the
+//             load cell is connected to channel A of the HX711.
+//
+// Returns:
+//    Returns a bool indicating whether or not the operation was successful.
+//    A value of 'true' indicates success.  A value of 'false' indicates
+//    failure.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SetGain(uint8_t gain)
+{
+    // Assume we're going to fail.
+    bool status = false;
+
+    // If the gain value has changed and is OK then set the new gain.
+    if ((gain != m_Gain) && m_Scheduler.SetGain(gain))
+    {
+        // Need to recalibrate if the reference gain has changed.
+        if (SampleScheduler::ReferenceGain(gain) !=
+            SampleScheduler::ReferenceGain(m_Gain))
+        {
+            m_IsCalibrated = false;
+            m_CalTable.Clear();
+            m_TempComp.Forget();
+        }
+        m_ZeroTracker.Reset();
+
+        // Set the new gain.
+        m_Gain = gain;
+        m_DecimatorReset = true;
+        status = true;
+
+        // Take throwaway readings to clear out the values from the previous
+        // gain setting.  When the acquisition task is running, samples may
+        // already be queued with the old gain, so also discard anything that
+        // was queued before the change.
+        m_SampleQueue.Flush();
+        for (uint16_t i = 0U; i < GAIN_SETTLE_COUNT; i++)
+        {
+            ReadARawValue();
+        }
+
+        // Seed our average value with a new raw reading.
+        ResetAverage();
+    }
+    // Return the success/failre status.
+    return status;
+} // End SetGain().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// IsPresent()
+//
+// Determines whether or not a load cell sensor is present.
+//
+// Returns:
+//   Returns true if a load cell was detected, or false otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::IsPresent() const
+{
+    // Once the acquisition task is running it owns the HX711, and it is only
+    // started after the device was detected.
+    if (m_AcqTask != NULL)
+    {
+        return true;
+    }
+
+    // Assume success.
+    bool status = true;
+
+    // We can't simply wait for the card to be ready since when no card is
+    // present, the DOUT pin can be read as low, which is how the library
+    // determines whether or not the HX711 is ready.  However, when no HX711
+    // is present, a read() of the device will return a value of 0.  So we use
+    // this as an indicator as to whether or not the sensor is present.
+    const uint16_t READY_RETRIES  = 10U;
+    const uint32_t READY_DELAY_MS = 10UL;
+    uint16_t retry = 0U;
+    while (!m_pTransport->IsReady() && (++retry < READY_RETRIES))
+    {
+        delay(READY_DELAY_MS);
+    }
+    if ((retry >= READY_RETRIES) || (m_pTransport->Read() == 0L))
+    {
+        // Looks like we didn't detect a card.
+        status = false;
+    }
+
+    // Let the caller know our status.
+    return status;
+} // End IsPresent().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SortReadings()
+//
+// Sorts a small array of readings into ascending order (insertion sort).
+/////////////////////////////////////////////////////////////////////////////////
+static void SortReadings(int32_t *pReadings, uint16_t count)
+{
+    for (uint16_t i = 1U; i < count; i++)
+    {
+        int32_t value = pReadings[i];
+        uint16_t j = i;
+        for ( ; (j > 0U) && (pReadings[j - 1U] > value); j--)
+        {
+            pReadings[j] = pReadings[j - 1U];
+        }
+        pReadings[j] = value;
+    }
+} // End SortReadings().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MedianOfSorted()
+//
+// Returns the median of a sorted, non-empty array of readings.
+/////////////////////////////////////////////////////////////////////////////////
+static int32_t MedianOfSorted(const int32_t *pSorted, uint16_t count)
+{
+    uint16_t mid = count / 2U;
+    return (count & 1U) ? pSorted[mid] :
+           static_cast<int32_t>((static_cast<int64_t>(pSorted[mid - 1U]) +
+                                 pSorted[mid]) / 2);
+} // End MedianOfSorted().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadRawAverage()
+//
+// This method returns a robust average of a number of readings.  Readings more
+// than OUTLIER_MADS median absolute deviations (scaled to estimate the
+// standard deviation) from the median are rejected, and the rest are
+// averaged.  Once MIN_TARE_COUNT readings have been taken, reading stops as
+// soon as the 95% confidence interval of the average is within TARE_CI_GRAMS
+// (or TARE_CI_COUNTS until we are calibrated).
+//
+// The average is rejected if, after all 'count' readings, the confidence
+// interval is still more than TARE_CI_FAIL_FACTOR times the target, or more
+// than a third of the readings were outliers.  Either means that the scale
+// was being disturbed.
+//
+// Arguments:
+//   - count - This specifies the maximum number of readings to take.  It is
+//             limited to MIN_TARE_COUNT..MAX_TARE_COUNT.
+//
+// Returns:
+//   If successful, returns the average value.  Otherwise a value of 0 is
+//   returned indicating failure.  Either way, GetSampleQuality() describes
+//   the readings.
+/////////////////////////////////////////////////////////////////////////////////
+uint32_t LoadCell::ReadRawAverage(uint16_t count)
+{
+    // Limit the number of readings to what we have room for.
+    if (count < MIN_TARE_COUNT)
+    {
+        count = MIN_TARE_COUNT;
+    }
+    else if (count > MAX_TARE_COUNT)
+    {
+        count = MAX_TARE_COUNT;
+    }
+
+    // The confidence interval half width we're aiming for, in counts.
+    const double gramsPerCount = GetGramsPerCount();
+    const double targetCi =
+        (gramsPerCount > 0.0d) ? TARE_CI_GRAMS / gramsPerCount : TARE_CI_COUNTS;
+
+    const uint32_t startMs = millis();
+    memset(&m_SampleQuality, 0, sizeof(m_SampleQuality));
+
+    // Discard any conversions that were queued before we were called so that
+    // all of the readings are taken from this point on.
+    m_SampleQueue.Flush();
+
+    // *** For some reason, the first read always seems higher than it should
+    // *** be.  Haven't been able to find the reason for this.
+    // *** Take a throwaway reading to get rid of the (probably) high first one.
+    ReadARawValue();
+
+    // Gather readings until the average is good enough or we run out.
+    int32_t  readings[MAX_TARE_COUNT];
+    int32_t  avg   = 0L;
+    uint16_t taken = 0U;
+    bool     ok    = false;
+    while (!ok && (taken < count))
+    {
+        readings[taken++] = ReadARawValue();
+        if (taken >= MIN_TARE_COUNT)
+        {
+            avg = EvaluateReadings(readings, taken);
+            ok  = (m_SampleQuality.m_CiCounts <= targetCi) &&
+                  (3U * m_SampleQuality.m_Used >= 2U * taken);
+        }
+    }
+
+    // Out of readings.  Accept a somewhat wider interval rather than fail on
+    // a slightly noisy bench.
+    if (!ok)
+    {
+        ok = (m_SampleQuality.m_CiCounts <= targetCi * TARE_CI_FAIL_FACTOR) &&
+             (3U * m_SampleQuality.m_Used >= 2U * taken);
+    }
+
+    m_SampleQuality.m_Ok         = ok;
+    m_SampleQuality.m_CiGrams    =
+        static_cast<float>(m_SampleQuality.m_CiCounts * gramsPerCount);
+    m_SampleQuality.m_DurationMs = millis() - startMs;
+
+    Serial.printf("LoadCell - average %ld from %u of %u readings, "
+                  "CI +/-%.1f counts, %lu ms: %s\n",
+                  static_cast<long>(avg), m_SampleQuality.m_Used, taken,
+                  m_SampleQuality.m_CiCounts,
+                  static_cast<unsigned long>(m_SampleQuality.m_DurationMs),
+                  ok ? "good" : "bad");
+
+    // Let the caller know our read average, or 0 if unsuccessful.
+    return ok ? avg : 0;
+} // End ReadRawAverage().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// EvaluateReadings()
+//
+// Rejects outliers from a set of raw readings and averages the rest.  The
+// median absolute deviation (MAD) is a robust measure of the noise; scaled by
+// 1.4826 it estimates the standard deviation of normally distributed noise.
+// Updates m_SampleQuality (except m_Ok and m_DurationMs).
+//
+// Arguments:
+//   - pReadings - The readings.
+//   - count     - The number of readings.  Must be at least 1.
+//
+// Returns:
+//   Returns the average of the readings that were kept.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t LoadCell::EvaluateReadings(const int32_t *pReadings, uint16_t count)
+{
+    const double MAD_TO_SIGMA = 1.4826d;
+    const double Z_95         = 1.96d;
+
+    // Find the median.
+    int32_t work[MAX_TARE_COUNT];
+    memcpy(work, pReadings, count * sizeof(work[0]));
+    SortReadings(work, count);
+    const int32_t median = MedianOfSorted(work, count);
+
+    // Find the median absolute deviation.
+    for (uint16_t i = 0U; i < count; i++)
+    {
+        work[i] = (pReadings[i] >= median) ? pReadings[i] - median :
+                                             median - pReadings[i];
+    }
+    SortReadings(work, count);
+    const int32_t mad = MedianOfSorted(work, count);
+
+    // Average the readings within the limit.  Don't let a MAD of 0 (e.g. the
+    // same value every time) reject everything else.
+    const double limit = OUTLIER_MADS * MAD_TO_SIGMA * ((mad > 0L) ? mad : 1L);
+    double   sum   = 0.0d;
+    double   sumSq = 0.0d;
+    uint16_t used  = 0U;
+    for (uint16_t i = 0U; i < count; i++)
+    {
+        // Work with differences from the median to keep the squares small.
+        double diff = static_cast<double>(pReadings[i] - median);
+        if (fabs(diff) <= limit)
+        {
+            sum   += diff;
+            sumSq += diff * diff;
+            used++;
+        }
+    }
+
+    m_SampleQuality.m_Taken     = count;
+    m_SampleQuality.m_Used      = used;
+    m_SampleQuality.m_MadCounts = static_cast<float>(mad);
+    if (used < 2U)
+    {
+        // Can't say anything about the spread.
+        m_SampleQuality.m_CiCounts = static_cast<float>(INT_MAX);
+        return median;
+    }
+
+    double mean     = sum / used;
+    double variance = (sumSq - sum * mean) / (used - 1U);
+    m_SampleQuality.m_CiCounts =
+        static_cast<float>(Z_95 * sqrt(fmax(variance, 0.0d) / used));
+    return median + static_cast<int32_t>(lround(mean));
+} // End EvaluateReadings().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Tare()
+//
+// This method calculates the tare offset for the scale.  This is the value that
+// is reported when the scale is empty.  The calculated offset is used in future
+// calculations to report object weights.
+//
+// The HX711 library contains a tare() method, but it simply calculates the
+// average of a number of readings.  This method uses ReadRawAverage(), which
+// rejects outliers and fails if the readings are too noisy, thus insuring that
+// the saved tare value is valid.  GetSampleQuality() describes the readings.
+//
+// Arguments:
+//   - count - This specifies the maximum number of readings that will be used
+//             to calculate the tare weight value.
+//
+// Returns:
+//   Returns 'true' if the tare value was successfully calculated.  Returns
+//   'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::Tare(uint16_t count)
+{
+    uint32_t tareValue = ReadRawAverage(count);
+    if (tareValue)
+    {
+        m_RawTareWeight  = tareValue;
+        m_TempComp.SetReference();
+        m_ZeroTracker.Reset();
+        ResetAverage();
+    }
+    return tareValue != 0;
+} // End Tare().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Calibrate()
+//
+// This method calculates and sets the base and display scale factors given
+// a raw reading and the cooked value that it represents.
+//
+// Note: We maintain a scale factor, 'm_UnitsScaleFactor', which is used
+//       to return scaled values based on the selected units to the user.
+//       The point also starts a new calibration table, to which further
+//       points may be added by AddCalibrationPoint().
+//
+// Arguments:
+//   - rawWeight       - This specifies the raw reading from  the HX711.  If 0,
+//                       then read an averaged value from the sensor.
+//   - cookedCalWeight - This specifies the value that should be displayed when
+//                       the  HX711 returns a value equal to the value of
+//                       'rawCalWeight'.
+//
+// Returns:
+// Returns 'true' if successful, false otherwise.  Will only succeed if a
+// successful tare was previously completed and a raw calibration weight is
+// successfully read.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::Calibrate(uint32_t rawCalWeight, double cookedCalWeight)
+{
+    // Get the raw reading (this also checks that we've been tared).
+    rawCalWeight = ReadCalibrationRaw(rawCalWeight);
+    if (rawCalWeight == 0UL)
+    {
+        return false;
+    }
+    int32_t netCounts = static_cast<int32_t>(rawCalWeight) - m_RawTareWeight;
+
+    // Seed our averaging code.
+    ResetAverage();
+
+    // The display scale factor is simply the ratio of the cooked and raw values.
+    m_UnitsScaleFactor = cookedCalWeight / static_cast<double>(netCounts);
+    m_FixedScale.Invalidate();
+    UpdateStepThreshold();
+
+    // Start a new calibration table with just this point.
+    m_CalTable.Clear();
+    m_CalTable.AddPoint(netCounts, cookedCalWeight * GetBaseUnitsFactor(m_Units));
+
+    // Remember that we've been calibrated.
+    m_IsCalibrated = true;
+
+    return true;
+} // End Calibrate().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddCalibrationPoint()
+//
+// Adds a reference point to the calibration table and refits it.  The display
+// scale factor becomes the least squares factor of all of the points, which is
+// what a linear fit uses, and what the step threshold is based on for the
+// other fits.
+//
+// Arguments:
+//   - rawCalWeight    - This specifies the raw reading from the HX711.  If 0,
+//                       then read an averaged value from the sensor.
+//   - cookedCalWeight - This specifies the value (in the current units) that
+//                       should be displayed for 'rawCalWeight'.
+//
+// Returns:
+// Returns 'true' if successful, false otherwise.  If we haven't been calibrated
+// or the table is empty, this is the same as Calibrate().
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::AddCalibrationPoint(uint32_t rawCalWeight, double cookedCalWeight)
+{
+    // Without a table there is nothing to add to, so start one.
+    if (!m_IsCalibrated || (m_CalTable.GetNumPoints() == 0U))
+    {
+        return Calibrate(rawCalWeight, cookedCalWeight);
+    }
+
+    rawCalWeight = ReadCalibrationRaw(rawCalWeight);
+    if ((rawCalWeight == 0UL) ||
+        !m_CalTable.AddPoint(static_cast<int32_t>(rawCalWeight) - m_RawTareWeight,
+                             cookedCalWeight * GetBaseUnitsFactor(m_Units)))
+    {
+        return false;
+    }
+
+    // Seed our averaging code and use the refitted scale factor.
+    ResetAverage();
+    m_UnitsScaleFactor = m_CalTable.GetSlope() / GetBaseUnitsFactor(m_Units);
+    m_FixedScale.Invalidate();
+    UpdateStepThreshold();
+
+    return true;
+} // End AddCalibrationPoint().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetCalibrationFit()
+//
+// Selects how the calibration table points are fitted.
+//
+// Arguments:
+//   - fit - This specifies the fit.
+//
+// Returns:
+// Returns 'true' if successful, or 'false' if 'fit' is not valid.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SetCalibrationFit(CalibrationFit fit)
+{
+    bool status = m_CalTable.SetFit(fit);
+    if (status)
+    {
+        ResetAverage();
+    }
+    return status;
+} // End SetCalibrationFit().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadCalibrationRaw()
+//
+// Returns 'rawWeight', or an averaged reading if it is 0.  Returns 0 if we
+// haven't been tared or the reading failed.
+/////////////////////////////////////////////////////////////////////////////////
+uint32_t LoadCell::ReadCalibrationRaw(uint32_t rawWeight)
+{
+    // We can only calibrate if a successful tare has been done.
+    if (m_RawTareWeight == 0L)
+    {
+        return 0UL;
+    }
+
+    // Special case when the value of 'raw' is 0, we read a raw value from
+    // the HX711.
+    if (rawWeight == 0UL)
+    {
+        rawWeight = ReadRawAverage();
+    }
+    return rawWeight;
+} // End ReadCalibrationRaw().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UpdateTemperature()
+//
+// Gives the temperature compensation stage the latest ambient temperature, and
+// lets it learn from the current (uncorrected) filtered reading.
+//
+// Arguments:
+//   - degreesC   - The temperature in degrees C, or NAN if unknown.
+//   - loadStable - True if the weight has been stable since the previous call.
+//
+// Returns:
+// Returns 'true' if the coefficients were updated.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::UpdateTemperature(float degreesC, bool loadStable)
+{
+    m_TempComp.SetTemperature(degreesC);
+
+    bool learned = false;
+    if (m_IsCalibrated && m_Filters.HasOutput())
+    {
+        // Learn against the explicit tare, not the zero tracked one, so that
+        // zero tracking doesn't hide the drift.
+        int32_t tare = m_RawTareWeight - m_ZeroTracker.GetTrackedCounts();
+        learned = m_TempComp.Observe(
+            static_cast<double>(m_Filters.Output() - tare), loadStable);
+        if (learned)
+        {
+            Serial.printf("LoadCell - temperature coefficients: zero %.1f counts/C, "
+                          "span %.1f ppm/C (%u periods)\n",
+                          m_TempComp.GetZeroPerC(), m_TempComp.GetSpanPerC() * 1.0e6,
+                          m_TempComp.GetNumPeriods());
+        }
+    }
+    return learned;
+} // End UpdateTemperature().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetTempCompensation()
+//
+// Turns temperature compensation on or off.
+//
+// Arguments:
+//   - enable - True to correct readings for temperature.
+/////////////////////////////////////////////////////////////////////////////////
+void LoadCell::SetTempCompensation(bool enable)
+{
+    m_TempComp.SetEnabled(enable);
+} // End SetTempCompensation().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetZeroTrackConfig()
+//
+// Sets up automatic zero tracking and creep compensation.
+//
+// Arguments:
+//   - config - This specifies the settings.
+//
+// Returns:
+// Returns 'true' if successful, or 'false' if the settings were not valid.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SetZeroTrackConfig(const ZeroTrackConfig &config)
+{
+    return m_ZeroTracker.Configure(config);
+} // End SetZeroTrackConfig().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetBaseUnitsFactor()
+//
+// Returns the scale factor used to convert the given weight units to the
+// base units (grams).
+//
+// Arguments:
+//   - units - This specifies the units to convert from.
+//
+// Returns:
+// Returns the double scale factor that may be used to convert the given
+// units to base units.  A value of 0.0 indicates that an invalid value
+// was passed in the 'units' argument.
+/////////////////////////////////////////////////////////////////////////////////
+double LoadCell::GetBaseUnitsFactor(WeightUnits units)
+{
+    double baseFactor = 0.0;
+    switch (units)
+    {
+    case eWuGrams:
+        // We use grams as our base units.
+        baseFactor = 1.0d;;
+        break;
+    case eWuKiloGrams:
+        baseFactor = GRAMS_PER_KILOGRAM;
+        break;
+    case eWuOunces:
+        baseFactor = GRAMS_PER_OUNCE;
+        break;
+    case eWuPounds:
+        baseFactor = GRAMS_PER_POUND;
+        break;
+    default:
+        // We will return 0.0 if the specified units are no good.
+        break;
+    }
+
+    return baseFactor;
+} // End GetBaseUnitsFactor().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadWeight()
+//
+// This method reads a value from the HX711 and returns the scaled value
+// representing the read weight scaled and offset by the value of m_Offset.
+// Unless the calibration table uses a linear fit (or has a single point), the
+// table converts the reading to grams.
+//
+// Returns:
+//    Returns the scaled and offset value if successful.  Otherwise it returns
+//    a value of UNCALIBRATED_READ_VALUE.
+/////////////////////////////////////////////////////////////////////////////////
+double LoadCell::ReadWeight()
+{
+    // Assume that we fail.
+    double scaledValue = UNCALIBRATED_READ_VALUE;
+
+    // If we haven't been calibrated yet, then we fail.
+    if (m_IsCalibrated)
+    {
+        double netWeight = ReadNetWeight();
+
+        // Scale the value.
+        if (m_CalTable.IsLinear())
+        {
+            scaledValue = (netWeight * m_UnitsScaleFactor) - m_Offset;
+        }
+        else
+        {
+            scaledValue = (m_CalTable.ToGrams(netWeight) /
+                           GetBaseUnitsFactor(m_Units)) - m_Offset;
+        }
+    }
+
+    return scaledValue;
+} // End ReadWeight().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadWeightFixed()
+//
+// The same as ReadWeight(), but returns the weight as an integer count of
+// 10^-decimals display units, rounded up.  With a linear calibration, the net
+// reading is taken to fixed point (NET_FRACTION_BITS fraction bits) and scaled
+// by m_FixedScale, which is set up again whenever the scale factor, offset or
+// decimal places change.  A non-linear calibration table takes the floating
+// point path.
+//
+// Arguments:
+//   - decimals - The decimal places to keep, 0 to FixedScale::MAX_DECIMALS.
+//   - rWeight  - Set to the weight if successful.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if we aren't calibrated.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::ReadWeightFixed(uint8_t decimals, int32_t &rWeight)
+{
+    if (!m_IsCalibrated)
+    {
+        return false;
+    }
+
+    if (m_CalTable.IsLinear() &&
+        ((m_FixedScale.IsConfigured() && (m_FixedScale.GetDecimals() == decimals)) ||
+         m_FixedScale.Configure(ldexp(m_UnitsScaleFactor, -NET_FRACTION_BITS),
+                                m_Offset, decimals)))
+    {
+        int64_t netWeight = llround(ldexp(ReadNetWeight(), NET_FRACTION_BITS));
+        rWeight = m_FixedScale.Apply(netWeight);
+    }
+    else
+    {
+        rWeight = FixedScale::Quantize(ReadWeight(), decimals);
+    }
+    return true;
+} // End ReadWeightFixed().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadNetWeight()
+//
+// Reads the averaged weight and returns it less the tare, in raw counts.  The
+// reading is first corrected for the temperature change since the tare, then
+// for creep, and zero tracking is given the chance to move the tare.
+/////////////////////////////////////////////////////////////////////////////////
+double LoadCell::ReadNetWeight()
+{
+    // Let's convert the averaged weight to a double.
+    double doubleWeight = static_cast<double>(ReadAndAverageRawWeight());
+    double netWeight = m_TempComp.Correct(
+                           doubleWeight - static_cast<double>(m_RawTareWeight));
+
+    // Track the zero and correct for creep.
+    int32_t tareMove =
+        m_ZeroTracker.Update(netWeight, GetGramsPerCount(), millis());
+    if (tareMove != 0L)
+    {
+        m_RawTareWeight += tareMove;
+        netWeight -= tareMove;
+    }
+    return m_ZeroTracker.Compensate(netWeight);
+} // End ReadNetWeight().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ResetAverage()
+//
+// Discard the history of the filter pipeline (including the moving average).
+/////////////////////////////////////////////////////////////////////////////////
+void LoadCell::ResetAverage()
+{
+    m_Filters.Reset();
+} // End ResetAverage().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetFilterConfig()
+//
+// Selects the filter stages that each raw reading is run through before the
+// moving average.
+//
+// Arguments:
+//   - config - This specifies the stages to be used.
+//
+// Returns:
+// Returns 'true' if successful, or 'false' if the configuration was not valid.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SetFilterConfig(const FilterConfig &config)
+{
+    return m_Filters.Configure(config);
+} // End SetFilterConfig().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UpdateStepThreshold()
+//
+// Converts STEP_THRESHOLD_GRAMS to raw counts for the step detection filter
+// stage.  Until we are calibrated, the stage's default threshold is used.
+/////////////////////////////////////////////////////////////////////////////////
+void LoadCell::UpdateStepThreshold()
+{
+    double gramsPerCount = GetGramsPerCount();
+    if (gramsPerCount > 0.0d)
+    {
+        m_Filters.SetStepThreshold(
+            static_cast<int32_t>(STEP_THRESHOLD_GRAMS / gramsPerCount + 0.5d));
+    }
+} // End UpdateStepThreshold().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetGramsPerCount()
+//
+// Returns the weight in grams of one raw count, or 0.0 if we haven't been
+// calibrated.
+/////////////////////////////////////////////////////////////////////////////////
+double LoadCell::GetGramsPerCount() const
+{
+    // m_UnitsScaleFactor is display units per count, so this is grams per
+    // count regardless of the selected units.
+    return m_IsCalibrated ?
+           fabs(m_UnitsScaleFactor) * GetBaseUnitsFactor(m_Units) : 0.0d;
+} // End GetGramsPerCount().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadAndAverageRawWeight()
+//
+// Take a reading from the HX711 and run it through the filter pipeline, which
+// ends with the rolling average.  Return the result.  When the acquisition task
+// is running, every conversion queued since the last call is filtered.  We only
+// wait for a conversion if the pipeline has no output at all (i.e. just after
+// it was reset).
+//
+// Returns:
+// Always returns the latest output of the filter pipeline.
+/////////////////////////////////////////////////////////////////////////////////
+int64_t LoadCell::ReadAndAverageRawWeight()
+{
+    if (m_AcqTask != NULL)
+    {
+        // Drain the queue into our filters.
+        int32_t raw = 0L;
+        while (m_SampleQueue.Pop(raw))
+        {
+            m_Filters.Process(raw);
+        }
+        if (!m_Filters.HasOutput())
+        {
+            m_Filters.Process(ReadARawValue());
+        }
+    }
+    else
+    {
+        // Update our filters.
+        m_Filters.Process(ReadARawValue());
+    }
+
+    // Return the new filtered value.
+    return m_Filters.Output();
+} // End ReadAndAverageRawWeight().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetAverageInterval()
+//
+// Sets the number of intervals that will be used for raw weight averaging.
+//
+// Arguments:
+//   - interval - This is the number of intvals to use for the raw weight
+//                averaging calculation.  Must be an integer greater than 0.
+//
+// Returns:
+// Returns 'true' if successful, or 'false' if the value was limited.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SetAverageInterval(int32_t interval)
+{
+    // Set the new size.
+    m_Filters.SetAverageSize(interval);
+
+    // Get the size (may have been limited) and remember it.
+    int32_t size = m_Filters.GetAverageSize();
+    m_AverageInterval = static_cast<double>(size);
+    m_AverageTimeMs = IntervalToMs(m_AverageInterval);
+
+    // Let the user know if the requested size was accepted or limited.
+    return size == interval;
+} // End SetAverageInterval().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetAverageTime()
+//
+// Sets the raw weight averaging as a time.  The number of readings averaged is
+// the number that arrive in that time at GetOutputRate().
+//
+// Arguments:
+//   - ms - This is the averaging time in milliseconds.
+//
+// Returns:
+// Returns 'true' if successful, or 'false' if the time was limited.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SetAverageTime(uint32_t ms)
+{
+    int32_t interval = static_cast<int32_t>(ms * GetOutputRate() / 1000.0d + 0.5d);
+    bool status = SetAverageInterval((interval > 0L) ? interval : 1L);
+
+    // Remember the time asked for unless it couldn't be met, so that it is kept
+    // exactly as the output rate changes.
+    if (status)
+    {
+        m_AverageTimeMs = ms;
+    }
+    return status;
+} // End SetAverageTime().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetConversionRate()
+//
+// Tells the load cell the HX711's conversion rate.  Conversions are decimated
+// to OUTPUT_RATE_SPS.
+//
+// Arguments:
+//   - sps - The conversion rate in samples per second: 10 or 80.
+//
+// Returns:
+// Returns 'true' if successful, or 'false' if 'sps' is not supported.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SetConversionRate(uint16_t sps)
+{
+    if (((sps != 10U) && (sps != 80U)) || (m_AcqTask != NULL) ||
+        !m_Decimator.SetFactor(static_cast<uint8_t>(sps / OUTPUT_RATE_SPS)))
+    {
+        return false;
+    }
+    m_ConversionRate = sps;
+    SetAverageTime(m_AverageTimeMs);
+    return true;
+} // End SetConversionRate().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetOutputRate()
+//
+// Returns the rate, in readings per second, at which readings reach the
+// filters.
+/////////////////////////////////////////////////////////////////////////////////
+double LoadCell::GetOutputRate() const
+{
+    return m_ConversionRate * m_Scheduler.GetChannelAShare() /
+           m_Decimator.GetFactor();
+} // End GetOutputRate().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// IntervalToMs()
+//
+// Returns the time covered by a number of readings at GetOutputRate().
+/////////////////////////////////////////////////////////////////////////////////
+uint32_t LoadCell::IntervalToMs(double interval) const
+{
+    return static_cast<uint32_t>(interval * 1000.0d / GetOutputRate() + 0.5d);
+} // End IntervalToMs().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetUnits()
+//
+// This method is used to change the units that will be displayed.  It calculates
+// a new m_UnitsScaleFactor value and saves it and the newly selected units
+// value.  It also updates the m_Offset value.
+//
+// Arguments:
+//   - newUnits - This specifies the new display units type.
+//
+// Returns:
+// Returns 'true' if successful, false otherwise.  Can only fail if the new
+// units is specified as an invalid value.  In this case, m_Units is not changed.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SetUnits(WeightUnits newUnits)
+{
+    bool status = true;
+
+    // Calculate the new m_UnitsScaleFactor and m_Offset values.
+    if (newUnits != m_Units)
+    {
+        // We calculate a multiplier to be used to determine the new values for
+        // our current offset and scale factors.  To do this, we calculate a
+        // factor by essentially converting the current units to base units,
+        // then converting the resulting base units to the newly specified units.
+        WeightUnits oldUnits  = m_Units;
+        double toBaseFactor   = GetBaseUnitsFactor(oldUnits);
+        double fromBaseFactor = GetBaseUnitsFactor(newUnits);
+        if ((toBaseFactor == 0.0d) || (fromBaseFactor == 0.0d))
+        {
+            // If either of the returned factors is 0.0, this implies that the
+            // corresponding call to GetBaseUnitsFactor() failed.
+            status = false;
+        }
+        else
+        {
+            // The returned factors were good, so determine our multiplier.
+            m_ConversionFactor = toBaseFactor / fromBaseFactor;
+
+            // Adjust the existing offset and scale factor values and save the
+            // new units value.  Protect these settings so they will be seen
+            // as an atomic change.
+            noInterrupts();
+            m_Offset            *= m_ConversionFactor;
+            m_UnitsScaleFactor  *= m_ConversionFactor;
+            m_Units              = newUnits;
+            interrupts();
+            m_FixedScale.Invalidate();
+        }
+    }
+
+    return status;
+} // End SetUnits().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Save()
+//
+// Saves our current state to NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::Save() const
+{
+    bool status = false;
+    if (m_pName != NULL)
+    {
+        // Cache our state information for transfer to NVS as a single unit.
+        SaveRestoreCache currentState;
+        currentState.m_Gain             = m_Gain;
+        currentState.m_RawTareWeight    = m_RawTareWeight;
+        currentState.m_IsCalibrated     = m_IsCalibrated;
+        currentState.m_Offset           = m_Offset;
+        currentState.m_Units            = m_Units;
+        currentState.m_AverageInterval  = m_AverageInterval;
+        currentState.m_UnitsScaleFactor = m_UnitsScaleFactor;
+        currentState.m_ConversionFactor = m_ConversionFactor;
+
+        // NvsStore only writes what has changed since it was restored or last
+        // saved, in order to conserve writes to NVS.
+        status = NvsStore::PutIfChanged(m_pName, pPrefSavedStateLabel,
+                                        &currentState, sizeof(SaveRestoreCache));
+
+        // The filter configuration, calibration table, temperature
+        // compensation, zero tracking, and gain ranging are kept separately so
+        // that adding them did not invalidate previously saved calibration
+        // data.
+        status &= NvsStore::PutIfChanged(m_pName, pPrefFilterLabel,
+                                         &m_Filters.GetConfig(),
+                                         sizeof(FilterConfig));
+        status &= NvsStore::PutIfChanged(m_pName, pPrefCalTableLabel,
+                                         &m_CalTable.GetData(),
+                                         sizeof(CalibrationData));
+        status &= NvsStore::PutIfChanged(m_pName, pPrefTempCompLabel,
+                                         &m_TempComp.GetData(),
+                                         sizeof(TempCompData));
+        status &= NvsStore::PutIfChanged(m_pName, pPrefZeroTrackLabel,
+                                         &m_ZeroTracker.GetConfig(),
+                                         sizeof(ZeroTrackConfig));
+        RangeData range = m_Scheduler.GetData();
+        status &= NvsStore::PutIfChanged(m_pName, pPrefRangeLabel, &range,
+                                         sizeof(RangeData));
+    }
+
+    // Let the caller know if we succeeded or failed.
+    return status;
+ } // End Save().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveTempCompensation()
+//
+// Saves only the temperature compensation state to NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::SaveTempCompensation() const
+{
+    bool status = false;
+    if (m_pName != NULL)
+    {
+        status = NvsStore::PutIfChanged(m_pName, pPrefTempCompLabel,
+                                        &m_TempComp.GetData(),
+                                        sizeof(TempCompData));
+    }
+    return status;
+} // End SaveTempCompensation().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Restore()
+//
+// Restores our state from NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCell::Restore()
+{
+    // Assume we're gonna fail.
+    bool succeeded = false;
+
+    // Make sure we have a valid name.
+    if (m_pName != NULL)
+    {
+        // Restore our state data to a temporary structure.
+        SaveRestoreCache cachedState;
+        size_t restored =
+            NvsStore::GetTracked(m_pName, pPrefSavedStateLabel, &cachedState,
+                                 sizeof(SaveRestoreCache));
+
+        // Save the restored values only if the get was successful.
+        if (restored == sizeof(cachedState))
+        {
+            // Set the gain.  This is done first since changing the gain
+            // clears the calibration.
+            SetGain(cachedState.m_Gain);
+
+            // Set our calibrated variable.
+            m_IsCalibrated = cachedState.m_IsCalibrated;
+
+            // Set the tare weight.
+            m_RawTareWeight  = cachedState.m_RawTareWeight;
+
+            // Set our scale factor.
+            m_UnitsScaleFactor = cachedState.m_UnitsScaleFactor;
+
+            // Set our averaging interval.
+            m_AverageInterval = cachedState.m_AverageInterval;
+            m_Filters.SetAverageSize(static_cast<int32_t>(m_AverageInterval));
+
+            // Set our offset (if any).
+            m_Offset = cachedState.m_Offset;
+
+            // Set our units.
+            m_Units = cachedState.m_Units;
+
+            // Set our conversion factor.
+            m_ConversionFactor = cachedState.m_ConversionFactor;
+            m_FixedScale.Invalidate();
+
+            // Set our filter stages.  These may not have been saved yet, in
+            // which case the current stages are kept.
+            FilterConfig cachedFilters;
+            if (NvsStore::GetTracked(m_pName, pPrefFilterLabel, &cachedFilters,
+                                     sizeof(FilterConfig)) == sizeof(FilterConfig))
+            {
+                m_Filters.Configure(cachedFilters);
+            }
+            UpdateStepThreshold();
+
+            // Set our calibration table.  Without one (older saves), the
+            // single scale factor is used.
+            CalibrationData cachedCal;
+            if ((NvsStore::GetTracked(m_pName, pPrefCalTableLabel, &cachedCal,
+                                      sizeof(CalibrationData)) != sizeof(CalibrationData)) ||
+                !m_CalTable.SetData(cachedCal))
+            {
+                m_CalTable.Clear();
+            }
+
+            // Set our temperature compensation.  Without it, learning starts
+            // over.
+            TempCompData cachedTempComp;
+            if ((NvsStore::GetTracked(m_pName, pPrefTempCompLabel, &cachedTempComp,
+                                      sizeof(TempCompData)) != sizeof(TempCompData)) ||
+                !m_TempComp.SetData(cachedTempComp))
+            {
+                m_TempComp.Forget();
+            }
+
+            // Set our zero tracking.  Not saved yet means the defaults.
+            ZeroTrackConfig cachedZeroTrack;
+            if (NvsStore::GetTracked(m_pName, pPrefZeroTrackLabel, &cachedZeroTrack,
+                                     sizeof(ZeroTrackConfig)) == sizeof(ZeroTrackConfig))
+            {
+                m_ZeroTracker.Configure(cachedZeroTrack);
+            }
+            m_ZeroTracker.Reset();
+
+            // Set our gain ranging and channel B.  Without it, the range
+            // offset is learned again.
+            RangeData cachedRange;
+            if (NvsStore::GetTracked(m_pName, pPrefRangeLabel, &cachedRange,
+                                     sizeof(RangeData)) == sizeof(RangeData))
+            {
+                m_Scheduler.SetData(cachedRange);
+            }
+            m_AverageTimeMs = IntervalToMs(m_AverageInterval);
+
+            succeeded = true;
+        }
+    }
+
+    // Let the caller know if we succeeded or failed.
+    return succeeded;
+ } // End Restore().
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Reset our state info in NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////
+bool LoadCell::Reset()
+{
+    bool status = false;
+    if (m_pName != NULL)
+    {
+        // Remove our state data rom NVS.
+        status = NvsStore::Remove(m_pName, pPrefSavedStateLabel);
+        NvsStore::Remove(m_pName, pPrefFilterLabel);
+        NvsStore::Remove(m_pName, pPrefCalTableLabel);
+        NvsStore::Remove(m_pName, pPrefTempCompLabel);
+        NvsStore::Remove(m_pName, pPrefZeroTrackLabel);
+        NvsStore::Remove(m_pName, pPrefRangeLabel);
+    }
+    return status;
+} // End Reset().
+
+
+
@@ -1,399 +1,818 @@
-/////////////////////////////////////////////////////////////////////////////////
-// LoadCell.h
-//
-// This class implements the LoadCell class.  It interfaces with the
-// HX711 Weight LoadCell sensor to provide a normalized interface.
-//
-// History:
-// - jmcorbett 29-AUG-2020 Original creation.
-//
-// Copyright (c) 2021, Joseph M. Corbett
-/////////////////////////////////////////////////////////////////////////////////
-
-#if !defined LOADCELL_H
-#define LOADCELL_H
-
-
-#include <HX711.h>              // For HX711 hardware specific data.
-#include "MovingAverage.h"      // For MovingAverage class.
-
-
-
-enum WeightUnits
-{
-    eWuGrams     = 0,       // Grams.
-    eWuKiloGrams = 1,       // Kilograms.
-    eWuOunces    = 2,       // Ounces.
-    eWuPounds    = 3,       // Pounds.
-    eWuNumUnits  = 4,       // Number of weight units.
-    eWuBadVal    = 99       // A bad value (used for initialization).
-};
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// LoadCell class
-//
-// Derived from HX711 class.
-/////////////////////////////////////////////////////////////////////////////////
-class LoadCell : private HX711
-{
-public:
-    /////////////////////////////////////////////////////////////////////////////
-    // Construct and initialize the library and the pins used for the load cell.
-    // The device is initialized with the specified gain and interface pins.
-    //
-    // Arguments:
-    //    - dout   - This specifies the GPIO pin used to connect to the HX711 DOUT
-    //               (Serial Data Out) pin.
-    //    - scl    - This specifies the GPIO pin used to connect to the HX711
-    //               PD_SCK (Power Down and Serial Clock Input) pin.
-    //    - ledPin - This specifies the GPIO pin used to control the sensor's LED.
-    //               This argument is required.  If the LED is permanently wired
-    //               to VCC and will not be controlled by the processor, then pass
-    //               a value of 0.
-    /////////////////////////////////////////////////////////////////////////////
-    LoadCell(int dout, int sck, uint8_t gain = DEFAULT_GAIN);
-
-
-    // Destructor.
-    virtual ~LoadCell() { }
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Init()
-    //
-    // This method initializes the load cell.
-    //
-    // Arguments:
-    //    - pName   - A string of no more than 14 characters to be used as a
-    //                name for this instance.  This is mainly used to identify
-    //                the instance to be used for NVS save and restore.
-    //
-    // Returns:
-    //    Returns a bool indicating whether or not the initialization was
-    //    successful.  A 'true' value indicates success, while a 'false' value
-    //    indicates failure.
-    //
-    /////////////////////////////////////////////////////////////////////////////
-    bool Init(const char *pName);
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // SetGain()
-    //
-    // Sets the gain that will be used by the load cell.
-    //
-    // Arguments:
-    //    - gain - valid values are 64 and 128.  This assumes that the load cell
-    //             is connected to channel A of the HX711.
-    //
-    // Returns:
-    //    Returns a bool indicating whether or not the operation was successful.
-    //    A value of 'true' indicates success.  A value of 'false' indicates
-    //    failure.
-    /////////////////////////////////////////////////////////////////////////////
-    bool SetGain(uint8_t gain);
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // IsPresent()
-    //
-    // Determines whether or not a load cell sensor is present.
-    //
-    // Returns:
-    //   Returns true if a load cell was detected, or false otherwise.
-    /////////////////////////////////////////////////////////////////////////////
-    bool IsPresent() const;
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // ReadRawAverage()
-    //
-    // Thius method returns the average of a number of of weight value readings.
-    // It verifies that ALL received values are within a limit, thus insuring
-    // that the returned value is valid.
-    //
-    // Arguments:
-    //   - count - This specifies the number of readings that will be used to
-    //             calculate an average that will be used as the returned weight
-    //             value.
-    //
-    // Returns:
-    //   If successful, returns the average value read from the 'count' readings
-    //   that were taken.  If any values fall outside of an acceptable range,
-    //   then a value of 0 is returned indicating failure.
-    /////////////////////////////////////////////////////////////////////////////
-    uint32_t ReadRawAverage(uint16_t count = DEFAULT_TARE_COUNT);
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Tare()
-    //
-    // This method calculates the tare offset for the scale.  This is the value
-    // that is reported when the scale is empty.  The calculated offset is used
-    // in future calculations to report object weights.
-    //
-    // The HX711 library contains a tare() method, but it simply calculates the
-    // average of a number of readings.  This method is different in that it
-    // takes the average of a number of readings and verifies that ALL received
-    // values are within a limit, thus insuring that the saved tare value is
-    // valid.
-    //
-    // Arguments:
-    //   - count - This specifies the number of readings that will be used to
-    //             calculate an average that will be used as the tare weight
-    //             value.
-    //
-    // Returns:
-    //   Returns 'true' if the tare value was successfully calculated.  Returns
-    //   'false' otherwise.
-    /////////////////////////////////////////////////////////////////////////////
-    bool Tare(uint16_t count = DEFAULT_TARE_COUNT);
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Calibrate()
-    //
-    // This method calculates and sets the base and display scale factors given
-    // a raw reading and the cooked value that it represents.
-    //
-    // Note: We maintain a scale factor, 'm_UnitsScaleFactor', which is used
-    //       to return scaled values based on the selected units to the user.
-    //
-    // Arguments:
-    //   - rawWeight    - This specifies the raw reading from  the HX711.  If 0,
-    //                    then read an averaged value from the sensor.
-    //   - cookedWeight - This specifies the value that should be displayed when
-    //                    the  HX711 returns a value equal to the value of
-    //                    'rawWeight'.
-    //
-    // Returns:
-    // Returns 'true' if successful, false otherwise.  Will only succeed if a
-    // successful tare was previously completed and a raw calibration weight is
-    // successfully read.
-    /////////////////////////////////////////////////////////////////////////////
-    bool Calibrate(uint32_t rawWeight, double cookedWeight);
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // SetUnits()
-    //
-    // This method is used to change the units that will be displayed.  It
-    // calculates a new m_UnitsScaleFactor value and saves it and the newly
-    // selected units value.  It also updates the m_Offset value.
-    //
-    // Arguments:
-    //   - newUnits - This specifies the new display units type.
-    //
-    // Returns:
-    // Returns 'true' if successful, false otherwise.  Can only fail if the new
-    // units is specified as an invalid value.  In this case, m_Units is not
-    // changed.
-    /////////////////////////////////////////////////////////////////////////////
-    bool SetUnits(WeightUnits newUnits);
-
-
-    /////////////////////////////////////////////////////////////////////////////////
-    // ReadWeight()
-    //
-    // This method reads a value from the HX711 and returns the scaled value
-    // representing the read weight scaled and offset by the value of m_Offset.
-    //
-    // Returns:
-    //    Returns the scaled and offset value if successful.  Otherwise it returns
-    //    a value of UNCALIBRATED_READ_VALUE.
-    /////////////////////////////////////////////////////////////////////////////////
-    double ReadWeight();
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // SetAverageInterval()
-    //
-    // Sets the number of intervals that will be used for raw weight averaging.
-    //
-    // Arguments:
-    //   - interval - This is the number of intvals to use for the raw weight
-    //                averaging calculation.  Must be an integer greater than 0.
-    //
-    // Returns:
-    // Returns 'true' if successful, or 'false' otherwise.
-    /////////////////////////////////////////////////////////////////////////////
-    bool SetAverageInterval(int32_t interval);
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // ResetAverage()
-    //
-    // Reset the moving average total to 0.
-    /////////////////////////////////////////////////////////////////////////////
-    void ResetAverage();
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // GetBaseUnitsFactor()
-    //
-    // Returns the scale factor used to convert the given weight units to the
-    // base units (grams).
-    //
-    // Arguments:
-    //   - units - This specifies the units to convert from.
-    //
-    // Returns:
-    // Returns the double scale factor that may be used to convert the given
-    // units to base units.  A value of 0.0 indicates that an invalid value
-    // was passed in the 'units' argument.
-    /////////////////////////////////////////////////////////////////////////////
-    static double GetBaseUnitsFactor(WeightUnits units);
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Save()
-    //
-    // Saves our current state to NVS.
-    //
-    // Returns:
-    //    Returns 'true' if successful, or 'false' otherwise.
-    /////////////////////////////////////////////////////////////////////////////
-    bool Save() const;
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Restore()
-    //
-    // Restores our state from NVS.
-    //
-    // Returns:
-    //    Returns 'true' if successful, or 'false' otherwise.
-    /////////////////////////////////////////////////////////////////////////////
-    bool Restore();
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Reset()
-    //
-    // Reset our state info in NVS.
-    //
-    // Returns:
-    //    Returns 'true' if successful, or 'false' otherwise.
-    /////////////////////////////////////////////////////////////////////////////
-    bool Reset();
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Simple Getter and setter methods.
-    /////////////////////////////////////////////////////////////////////////////
-    uint8_t     GetGain()            const { return m_Gain; }
-    double      GetOffset()          const { return m_Offset; }
-    WeightUnits GetUnits()           const { return m_Units; }
-    double      GetAverageInterval() const { return m_AverageInterval; }
-    void SetOffset(double newOffset)       { m_Offset = newOffset; ResetAverage(); }
-    bool IsCalibrated()              const { return m_IsCalibrated; }
-    const char *GetUnitsString()     const { return UnitsStrings[static_cast<int>(m_Units)]; }
-    double GetConversionFactor()     const { return m_ConversionFactor; }
-
-protected:
-
-
-private:
-    // Unimplemented methods.    We don't want users to try to use these.
-    LoadCell();
-    LoadCell(LoadCell &rLc);
-    LoadCell &operator=(LoadCell &rLc);
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Private getter methods.
-    /////////////////////////////////////////////////////////////////////////////
-    double  GetUnitsScaleFactor() const { return m_UnitsScaleFactor; }
-    int32_t GetTareValue()        const { return m_RawTareWeight; }
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // ReadAveragedValue()
-    //
-    // Take a reading from the HX711 and average it over the rolling average
-    // interval.  Return the result.
-    //
-    // Returns:
-    // Always returns the newly calculated value for m_RollingAverage.
-    /////////////////////////////////////////////////////////////////////////////
-    int64_t ReadAndAverageRawWeight();
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // ReadARawValue(), ReadARawValueD()
-    //
-    // Reads a single raw weight value from the HX711.  Returns the value as an
-    // int or as a double.
-    //
-    // Note: The value read from the HX711 is not included in the running
-    //       average.
-    //
-    // Returns:
-    // ReadARawValue() returns an int32_t value read from the HX711.
-    // ReadARawValueD() returns a value read from the HX711 cast to a double.
-    /////////////////////////////////////////////////////////////////////////////
-    int32_t ReadARawValue()  const { return read(); }
-    double  ReadARawValueD() const { return static_cast<double>(read()); }
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    //  Static constants.
-    /////////////////////////////////////////////////////////////////////////////
-    static const uint16_t DEFAULT_TARE_COUNT   = 20U;
-    static const uint8_t  DEFAULT_GAIN         = 128U;
-    static const double   GRAMS_PER_KILOGRAM;
-    static const double   GRAMS_PER_POUND;
-    static const double   OUNCES_PER_POUND;
-    static const double   GRAMS_PER_OUNCE;
-    static const double   UNCALIBRATED_READ_VALUE;
-    static const double   DEFAULT_AVERAGE_INTERVAL;
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    //  Save/Restore preferences labels.
-    /////////////////////////////////////////////////////////////////////////////
-    static const char *pPrefSavedStateLabel;
-    static const char *UnitsStrings[];
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Instance data.
-    /////////////////////////////////////////////////////////////////////////////
-    uint8_t     m_Gain;                 // HX711 gain.
-    int32_t     m_RawTareWeight;        // Raw tare weight.
-    bool        m_IsCalibrated;         // True if successfully calibrated.
-    double      m_Offset;               // Optional offset for reporting weight.
-    WeightUnits m_Units;                // Selected weight units.
-    double      m_AverageInterval;      // Number of rolling values to average.
-    double      m_UnitsScaleFactor;     // Factor for scaling the displayed weight.
-    double      m_ConversionFactor;     // Factor for converting previous units to new.
-    MovingAverage<int32_t, int64_t> m_MovingAverage;
-                                        // Moving average handling class.
-    const char *m_pName;                // NVS instance name.
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Structure containing all of our state information that may be
-    // saved/restored to/from NVS.
-    /////////////////////////////////////////////////////////////////////////////
-    struct SaveRestoreCache
-    {
-        uint8_t     m_Gain;             // HX711 gain.
-        int32_t     m_RawTareWeight;    // Raw tare weight.
-        bool        m_IsCalibrated;     // True if successfully calibrated.
-        double      m_Offset;           // Optional offset for reporting weight.
-        WeightUnits m_Units;            // Selected weight units.
-        double      m_AverageInterval;  // Number of rolling values to average.
-        double      m_UnitsScaleFactor; // Factor for scaling the displayed weight.
-        double      m_ConversionFactor; // Factor for converting previous units to new.
-    };
-
-    // Allow unit tests to see all of our data and methods.
-    friend class LoadCellTests;
-
-}; // End class LoadCell.
-
-
-
-#endif // LOADCELL_H
+/////////////////////////////////////////////////////////////////////////////////
+// LoadCell.h
+//
+// This class implements the LoadCell class.  It interfaces with the
+// HX711 Weight LoadCell sensor to provide a normalized interface.
+//
+// History:
+// - jmcorbett 29-AUG-2020 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#if !defined LOADCELL_H
+#define LOADCELL_H
+
+
+#include <Arduino.h>            // For Serial, delay(), ...
+#include <freertos/FreeRTOS.h>  // For FreeRTOS types.
+#include <freertos/task.h>      // For acquisition task handling.
+#include "FilterPipeline.h"     // For FilterPipeline class.
+#include "SampleQueue.h"        // For SampleQueue class.
+#include "HX711Transport.h"     // For HX711Transport interface.
+#include "CalibrationTable.h"   // For CalibrationTable class.
+#include "TempCompensator.h"    // For TempCompensator class.
+#include "ZeroTracker.h"        // For ZeroTracker class.
+#include "SampleScheduler.h"    // For SampleScheduler class.
+#include "CicDecimator.h"       // For CicDecimator class.
+#include "FixedScale.h"         // For FixedScale class.
+
+
+
+enum WeightUnits
+{
+    eWuGrams     = 0,       // Grams.
+    eWuKiloGrams = 1,       // Kilograms.
+    eWuOunces    = 2,       // Ounces.
+    eWuPounds    = 3,       // Pounds.
+    eWuNumUnits  = 4,       // Number of weight units.
+    eWuBadVal    = 99       // A bad value (used for initialization).
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SampleQuality structure
+//
+// Describes the readings behind the most recent ReadRawAverage(), and so the
+// most recent Tare() or Calibrate().
+/////////////////////////////////////////////////////////////////////////////////
+struct SampleQuality
+{
+    bool     m_Ok;                  // The average was accepted.
+    uint16_t m_Taken;               // Readings taken (not counting the first).
+    uint16_t m_Used;                // Readings left after outlier rejection.
+    float    m_MadCounts;           // Median absolute deviation of readings.
+    float    m_CiCounts;            // 95% confidence half width of the mean.
+    float    m_CiGrams;             // The same in grams, 0 if not calibrated.
+    uint32_t m_DurationMs;          // Time taken to read.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// LoadCell class
+//
+// Talks to the HX711 through an HX711Transport.
+/////////////////////////////////////////////////////////////////////////////////
+class LoadCell
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Construct and initialize the load cell.  The transport selects how the
+    // HX711 is read (bit-banged GPIO, SPI peripheral, or simulated).  The
+    // device itself is set up with the specified gain by Init().
+    //
+    // Arguments:
+    //    - pTransport - This specifies the transport used to talk to the HX711.
+    //                   It must remain valid for the life of the LoadCell.
+    //    - gain       - valid values are 64, 128 and AUTO_GAIN.  This assumes
+    //                   that the load cell is connected to channel A of the
+    //                   HX711.
+    /////////////////////////////////////////////////////////////////////////////
+    LoadCell(HX711Transport *pTransport, uint8_t gain = DEFAULT_GAIN);
+
+
+    // Destructor.
+    virtual ~LoadCell() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Init()
+    //
+    // This method initializes the load cell.  The transport is set up, the
+    // HX711 is checked for presence, and background acquisition is started.
+    //
+    // Arguments:
+    //    - pName   - A string of no more than 14 characters to be used as a
+    //                name for this instance.  This is mainly used to identify
+    //                the instance to be used for NVS save and restore.
+    //
+    // Returns:
+    //    Returns a bool indicating whether or not the initialization was
+    //    successful.  A 'true' value indicates success, while a 'false' value
+    //    indicates failure.
+    //
+    /////////////////////////////////////////////////////////////////////////////
+    bool Init(const char *pName);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // StartAcquisition()
+    //
+    // Starts the background acquisition of HX711 conversions.  A task pinned
+    // to ACQ_TASK_CORE is woken by a falling edge interrupt on the DOUT pin
+    // each time a conversion is ready.  The task reads the conversion and
+    // places it into m_SampleQueue where it is later consumed by ReadWeight()
+    // and the other methods that need raw readings.  Once started, the main
+    // loop never waits on the HX711 unless it explicitly needs a fresh value
+    // (for example during Tare()).
+    //
+    // Returns:
+    //    Returns 'true' if acquisition is running, or 'false' if the task could
+    //    not be created.  Calling this method when acquisition is already
+    //    running has no effect and returns 'true'.
+    /////////////////////////////////////////////////////////////////////////////
+    bool StartAcquisition();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetGain()
+    //
+    // Sets the gain that will be used by the load cell.  With AUTO_GAIN, the
+    // gain is switched between 128 and 64 as the load requires, and readings
+    // are reported in gain 128 counts.  Calibration is only lost if that
+    // reference gain changes.
+    //
+    // Arguments:
+    //    - gain - valid values are 64, 128 and AUTO_GAIN.  This assumes that
+    //             the load cell is connected to channel A of the HX711.
+    //
+    // Returns:
+    //    Returns a bool indicating whether or not the operation was successful.
+    //    A value of 'true' indicates success.  A value of 'false' indicates
+    //    failure.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetGain(uint8_t gain);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetChannelBInterval()
+    //
+    // Selects how often the HX711's channel B (gain 32) is read, e.g. for a
+    // second load cell.  Each channel B sample costs three channel A samples.
+    //
+    // Arguments:
+    //    - interval - The number of channel A samples per channel B sample, or
+    //                 0 to not read channel B.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetChannelBInterval(uint8_t interval);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetChannelB()
+    //
+    // Gets the latest channel B sample.
+    //
+    // Arguments:
+    //    - rRaw - Set to the raw channel B value.
+    //
+    // Returns:
+    //    Returns 'true' if a channel B sample has been read, or 'false'
+    //    otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool GetChannelB(int32_t &rRaw) const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // IsPresent()
+    //
+    // Determines whether or not a load cell sensor is present.
+    //
+    // Returns:
+    //   Returns true if a load cell was detected, or false otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool IsPresent() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // ReadRawAverage()
+    //
+    // This method returns a robust average of a number of weight readings.
+    // Readings more than OUTLIER_MADS median absolute deviations from the
+    // median are rejected and the rest are averaged.  Reading stops as soon as
+    // the 95% confidence interval of the average is tight enough (see
+    // TARE_CI_GRAMS), so a quiet scale needs only MIN_TARE_COUNT readings.
+    // The details are available from GetSampleQuality().
+    //
+    // Arguments:
+    //   - count - This specifies the maximum number of readings to take.  It is
+    //             limited to MIN_TARE_COUNT..MAX_TARE_COUNT.
+    //
+    // Returns:
+    //   If successful, returns the average value.  If the readings were too
+    //   noisy, or too many were rejected, then a value of 0 is returned
+    //   indicating failure.
+    /////////////////////////////////////////////////////////////////////////////
+    uint32_t ReadRawAverage(uint16_t count = DEFAULT_TARE_COUNT);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Tare()
+    //
+    // This method calculates the tare offset for the scale.  This is the value
+    // that is reported when the scale is empty.  The calculated offset is used
+    // in future calculations to report object weights.
+    //
+    // The HX711 library contains a tare() method, but it simply calculates the
+    // average of a number of readings.  This method uses ReadRawAverage(),
+    // which rejects outliers and fails if the readings are too noisy, thus
+    // insuring that the saved tare value is valid.
+    //
+    // Arguments:
+    //   - count - This specifies the maximum number of readings that will be
+    //             used to calculate the tare weight value.
+    //
+    // Returns:
+    //   Returns 'true' if the tare value was successfully calculated.  Returns
+    //   'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Tare(uint16_t count = DEFAULT_TARE_COUNT);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Calibrate()
+    //
+    // This method calculates and sets the base and display scale factors given
+    // a raw reading and the cooked value that it represents.
+    //
+    // Note: We maintain a scale factor, 'm_UnitsScaleFactor', which is used
+    //       to return scaled values based on the selected units to the user.
+    //
+    // Arguments:
+    //   - rawWeight    - This specifies the raw reading from  the HX711.  If 0,
+    //                    then read an averaged value from the sensor.
+    //   - cookedWeight - This specifies the value that should be displayed when
+    //                    the  HX711 returns a value equal to the value of
+    //                    'rawWeight'.
+    //
+    // Returns:
+    // Returns 'true' if successful, false otherwise.  Will only succeed if a
+    // successful tare was previously completed and a raw calibration weight is
+    // successfully read.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Calibrate(uint32_t rawWeight, double cookedWeight);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // AddCalibrationPoint()
+    //
+    // Adds a reference point to the calibration table, for load cells that are
+    // not linear enough for a single scale factor.  Calibrate() starts a new
+    // table with its point; each further reference weight is added here.  The
+    // table is then fitted as selected by SetCalibrationFit().  With a linear
+    // fit, the points are combined into a single least squares scale factor.
+    //
+    // Arguments:
+    //   - rawWeight    - This specifies the raw reading from the HX711.  If 0,
+    //                    then read an averaged value from the sensor.
+    //   - cookedWeight - This specifies the value (in the current units) that
+    //                    should be displayed for 'rawWeight'.
+    //
+    // Returns:
+    // Returns 'true' if successful, false otherwise.  If we haven't been
+    // calibrated (or the table is empty, as after restoring calibration saved
+    // by an older version), this is the same as Calibrate().
+    /////////////////////////////////////////////////////////////////////////////
+    bool AddCalibrationPoint(uint32_t rawWeight, double cookedWeight);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetCalibrationFit()
+    //
+    // Selects how the calibration table points are fitted.  See
+    // CalibrationTable.h.
+    //
+    // Arguments:
+    //   - fit - This specifies the fit.
+    //
+    // Returns:
+    // Returns 'true' if successful, or 'false' if 'fit' is not valid.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetCalibrationFit(CalibrationFit fit);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetUnits()
+    //
+    // This method is used to change the units that will be displayed.  It
+    // calculates a new m_UnitsScaleFactor value and saves it and the newly
+    // selected units value.  It also updates the m_Offset value.
+    //
+    // Arguments:
+    //   - newUnits - This specifies the new display units type.
+    //
+    // Returns:
+    // Returns 'true' if successful, false otherwise.  Can only fail if the new
+    // units is specified as an invalid value.  In this case, m_Units is not
+    // changed.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetUnits(WeightUnits newUnits);
+
+
+    /////////////////////////////////////////////////////////////////////////////////
+    // ReadWeight()
+    //
+    // This method reads a value from the HX711 and returns the scaled value
+    // representing the read weight scaled and offset by the value of m_Offset.
+    // When background acquisition is running, all conversions that have been
+    // queued since the previous call are run through the filter pipeline.
+    //
+    // Returns:
+    //    Returns the scaled and offset value if successful.  Otherwise it returns
+    //    a value of UNCALIBRATED_READ_VALUE.
+    /////////////////////////////////////////////////////////////////////////////////
+    double ReadWeight();
+
+
+    /////////////////////////////////////////////////////////////////////////////////
+    // ReadWeightFixed()
+    //
+    // The same as ReadWeight(), but returns the weight as an integer count of
+    // 10^-decimals display units, rounded up.  With a linear calibration, the
+    // scaling and rounding are done in fixed point, using factors worked out
+    // when the calibration, units, offset or decimal places change.
+    //
+    // Arguments:
+    //   - decimals - The decimal places to keep, 0 to FixedScale::MAX_DECIMALS.
+    //   - rWeight  - Set to the weight if successful.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if we aren't calibrated.
+    /////////////////////////////////////////////////////////////////////////////////
+    bool ReadWeightFixed(uint8_t decimals, int32_t &rWeight);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetAverageInterval()
+    //
+    // Sets the number of intervals that will be used for raw weight averaging.
+    //
+    // Arguments:
+    //   - interval - This is the number of intvals to use for the raw weight
+    //                averaging calculation.  Must be an integer greater than 0.
+    //
+    // Returns:
+    // Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetAverageInterval(int32_t interval);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetAverageTime()
+    //
+    // Sets the raw weight averaging as a time rather than a number of
+    // readings, so that it doesn't depend on the conversion rate, decimation,
+    // or channel B sampling.
+    //
+    // Arguments:
+    //   - ms - This is the averaging time in milliseconds.
+    //
+    // Returns:
+    // Returns 'true' if successful, or 'false' if the time was limited.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetAverageTime(uint32_t ms);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetConversionRate()
+    //
+    // Tells the load cell the HX711's conversion rate, as selected by its RATE
+    // pin.  Conversions faster than OUTPUT_RATE_SPS are decimated to that rate
+    // so that every conversion contributes to the readings.  Must be called
+    // before Init().
+    //
+    // Arguments:
+    //   - sps - The conversion rate in samples per second: 10 or 80.
+    //
+    // Returns:
+    // Returns 'true' if successful, or 'false' if 'sps' is not supported.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetConversionRate(uint16_t sps);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetOutputRate()
+    //
+    // Returns the rate, in readings per second, at which readings reach the
+    // filters: the conversion rate less the channel B conversions, divided by
+    // the decimation factor.
+    /////////////////////////////////////////////////////////////////////////////
+    double GetOutputRate() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // ResetAverage()
+    //
+    // Discard the history of the filter pipeline (including the moving
+    // average).
+    /////////////////////////////////////////////////////////////////////////////
+    void ResetAverage();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetFilterConfig()
+    //
+    // Selects the filter stages that each raw reading is run through before
+    // the moving average.  See FilterPipeline.h for a description of the
+    // stages.
+    //
+    // Arguments:
+    //   - config - This specifies the stages to be used.
+    //
+    // Returns:
+    // Returns 'true' if successful, or 'false' if the configuration was not
+    // valid.  The current configuration is kept on failure.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetFilterConfig(const FilterConfig &config);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // UpdateTemperature()
+    //
+    // Gives the temperature compensation stage the latest ambient temperature,
+    // which is used to correct readings from then on.  The current reading is
+    // also used to learn the load cell's temperature coefficients.  See
+    // TempCompensator.h.
+    //
+    // Arguments:
+    //   - degreesC   - The temperature in degrees C, or NAN if unknown.
+    //   - loadStable - True if the weight has been stable since the previous
+    //                  call.
+    //
+    // Returns:
+    // Returns 'true' if the coefficients were updated, in which case they
+    // should be saved with SaveTempCompensation().
+    /////////////////////////////////////////////////////////////////////////////
+    bool UpdateTemperature(float degreesC, bool loadStable);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetTempCompensation()
+    //
+    // Turns temperature compensation on or off.  Learning continues either
+    // way.
+    //
+    // Arguments:
+    //   - enable - True to correct readings for temperature.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetTempCompensation(bool enable);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetZeroTrackConfig()
+    //
+    // Sets up automatic zero tracking and creep compensation.  See
+    // ZeroTracker.h.
+    //
+    // Arguments:
+    //   - config - This specifies the settings.
+    //
+    // Returns:
+    // Returns 'true' if successful, or 'false' if the settings were not
+    // valid.  The current settings are kept on failure.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetZeroTrackConfig(const ZeroTrackConfig &config);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetBaseUnitsFactor()
+    //
+    // Returns the scale factor used to convert the given weight units to the
+    // base units (grams).
+    //
+    // Arguments:
+    //   - units - This specifies the units to convert from.
+    //
+    // Returns:
+    // Returns the double scale factor that may be used to convert the given
+    // units to base units.  A value of 0.0 indicates that an invalid value
+    // was passed in the 'units' argument.
+    /////////////////////////////////////////////////////////////////////////////
+    static double GetBaseUnitsFactor(WeightUnits units);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Save()
+    //
+    // Saves our current state to NVS.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Save() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SaveTempCompensation()
+    //
+    // Saves only the temperature compensation state to NVS.  This lets the
+    // learned coefficients be kept without also saving other settings that the
+    // user may not have saved yet.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SaveTempCompensation() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Restore()
+    //
+    // Restores our state from NVS.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Restore();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // Reset our state info in NVS.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Reset();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple Getter and setter methods.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t     GetGain()            const { return m_Gain; }
+    double      GetOffset()          const { return m_Offset; }
+    WeightUnits GetUnits()           const { return m_Units; }
+    double      GetAverageInterval() const { return m_AverageInterval; }
+    uint32_t    GetAverageTimeMs()   const { return m_AverageTimeMs; }
+    uint16_t    GetConversionRate()  const { return m_ConversionRate; }
+    int32_t     GetTareValue()       const { return m_RawTareWeight; }
+    void SetOffset(double newOffset)
+        { m_Offset = newOffset; m_FixedScale.Invalidate(); ResetAverage(); }
+    bool IsCalibrated()              const { return m_IsCalibrated; }
+    const char *GetUnitsString()     const { return UnitsStrings[static_cast<int>(m_Units)]; }
+    double GetConversionFactor()     const { return m_ConversionFactor; }
+    bool IsAcquiring()               const { return m_AcqTask != NULL; }
+    bool IsInitialized()             const { return m_pName != NULL; }
+    bool IsResponding()              const { return m_pTransport->IsResponding(); }
+    uint32_t GetSampleOverruns()     const { return m_SampleQueue.GetOverruns(); }
+    const FilterConfig &GetFilterConfig() const { return m_Filters.GetConfig(); }
+    const SampleQuality &GetSampleQuality() const { return m_SampleQuality; }
+    CalibrationFit GetCalibrationFit() const { return m_CalTable.GetFit(); }
+    uint8_t GetCalibrationPoints()   const { return m_CalTable.GetNumPoints(); }
+    bool GetTempCompensation()       const { return m_TempComp.IsEnabled(); }
+    const TempCompensator &GetTempCompensator() const { return m_TempComp; }
+    const ZeroTrackConfig &GetZeroTrackConfig() const { return m_ZeroTracker.GetConfig(); }
+    int32_t GetTrackedZero()         const { return m_ZeroTracker.GetTrackedCounts(); }
+    uint8_t GetRangeGain()           const { return m_Scheduler.GetRangeGain(); }
+    uint8_t GetChannelBInterval()    const { return m_Scheduler.GetData().m_ChannelBInterval; }
+    double GetChannelAShare()        const { return m_Scheduler.GetChannelAShare(); }
+    uint32_t GetDiscardedSamples()   const { return m_Scheduler.GetDiscards(); }
+
+    static const uint8_t AUTO_GAIN = SampleScheduler::AUTO_GAIN;
+
+protected:
+
+
+private:
+    // Unimplemented methods.    We don't want users to try to use these.
+    LoadCell();
+    LoadCell(LoadCell &rLc);
+    LoadCell &operator=(LoadCell &rLc);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Private getter methods.
+    /////////////////////////////////////////////////////////////////////////////
+    double  GetUnitsScaleFactor() const { return m_UnitsScaleFactor; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // ReadAndAverageRawWeight()
+    //
+    // Take a reading from the HX711 and run it through the filter pipeline.
+    // Return the result.
+    //
+    // Returns:
+    // Always returns the latest output of the filter pipeline.
+    /////////////////////////////////////////////////////////////////////////////
+    int64_t ReadAndAverageRawWeight();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // ReadNetWeight()
+    //
+    // Reads the averaged weight and returns it less the tare, in raw counts,
+    // corrected for temperature and creep.  Gives zero tracking the chance to
+    // move the tare.  Must only be called when calibrated.
+    /////////////////////////////////////////////////////////////////////////////
+    double ReadNetWeight();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // UpdateStepThreshold()
+    //
+    // Converts STEP_THRESHOLD_GRAMS to raw counts for the step detection
+    // filter stage.  Must be called whenever the calibration changes.
+    /////////////////////////////////////////////////////////////////////////////
+    void UpdateStepThreshold();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // ReadCalibrationRaw()
+    //
+    // Returns 'rawWeight', or an averaged reading if it is 0.  Returns 0 if
+    // we haven't been tared or the reading failed.
+    /////////////////////////////////////////////////////////////////////////////
+    uint32_t ReadCalibrationRaw(uint32_t rawWeight);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetGramsPerCount()
+    //
+    // Returns the weight in grams of one raw count, or 0.0 if we haven't been
+    // calibrated.
+    /////////////////////////////////////////////////////////////////////////////
+    double GetGramsPerCount() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // EvaluateReadings()
+    //
+    // Rejects outliers from a set of raw readings and averages the rest.
+    // Updates m_SampleQuality (except m_Ok and m_DurationMs).
+    //
+    // Arguments:
+    //   - pReadings - The readings.
+    //   - count     - The number of readings.  Must be at least 1.
+    //
+    // Returns:
+    //   Returns the average of the readings that were kept.
+    /////////////////////////////////////////////////////////////////////////////
+    int32_t EvaluateReadings(const int32_t *pReadings, uint16_t count);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // ReadARawValue(), ReadARawValueD()
+    //
+    // Reads a single raw weight value from the HX711.  Returns the value as an
+    // int or as a double.  If background acquisition is running, the value is
+    // taken from the sample queue (waiting for one if necessary).  Otherwise
+    // the HX711 is read directly.
+    //
+    // Note: The value read from the HX711 is not included in the running
+    //       average.
+    //
+    // Returns:
+    // ReadARawValue() returns an int32_t value read from the HX711.
+    // ReadARawValueD() returns a value read from the HX711 cast to a double.
+    /////////////////////////////////////////////////////////////////////////////
+    int32_t ReadARawValue();
+    double  ReadARawValueD() { return static_cast<double>(ReadARawValue()); }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // HandleConversion()
+    //
+    // Passes a conversion to m_Scheduler and selects the gain of the following
+    // conversion.  Channel B samples are kept for GetChannelB().
+    //
+    // Arguments:
+    //    - raw    - The conversion just read from the transport.
+    //    - rValue - Set to the channel A sample, if any.
+    //
+    // Returns:
+    //    Returns 'true' if the conversion produced a channel A sample.
+    /////////////////////////////////////////////////////////////////////////////
+    bool HandleConversion(int32_t raw, int32_t &rValue);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // IntervalToMs()
+    //
+    // Returns the time covered by a number of readings at GetOutputRate().
+    /////////////////////////////////////////////////////////////////////////////
+    uint32_t IntervalToMs(double interval) const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // AcquisitionTask()
+    //
+    // Body of the background acquisition task.  Waits for a data ready
+    // notification from DataReadyIsr(), then reads the conversion and queues
+    // it.  A timeout is used so that a missed edge only delays a reading
+    // rather than stopping acquisition altogether.
+    //
+    // Arguments:
+    //    - pArg - Pointer to the LoadCell instance that owns the task.
+    /////////////////////////////////////////////////////////////////////////////
+    static void AcquisitionTask(void *pArg);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // DataReadyIsr()
+    //
+    // DOUT falling edge interrupt handler.  Simply wakes the acquisition task.
+    // Note that DOUT also toggles while the data bits are being clocked out, so
+    // the task must check IsReady() before reading.
+    //
+    // Arguments:
+    //    - pArg - Pointer to the LoadCell instance that owns the interrupt.
+    /////////////////////////////////////////////////////////////////////////////
+    static void DataReadyIsr(void *pArg);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    //  Static constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint16_t DEFAULT_TARE_COUNT   = 30U;
+    static const uint16_t MIN_TARE_COUNT       = 5U;
+    static const uint16_t MAX_TARE_COUNT       = 40U;
+    static const uint8_t  DEFAULT_GAIN         = 128U;
+    static const double   GRAMS_PER_KILOGRAM;
+    static const double   GRAMS_PER_POUND;
+    static const double   OUNCES_PER_POUND;
+    static const double   GRAMS_PER_OUNCE;
+    static const double   UNCALIBRATED_READ_VALUE;
+    static const double   DEFAULT_AVERAGE_INTERVAL;
+    static const double   STEP_THRESHOLD_GRAMS;
+    static const double   TARE_CI_GRAMS;
+    static const double   TARE_CI_COUNTS;
+    static const double   TARE_CI_FAIL_FACTOR;
+    static const double   OUTLIER_MADS;
+    static const size_t   SAMPLE_QUEUE_SIZE    = 32U;   // Must be a power of 2.
+    static const uint32_t ACQ_TASK_STACK_SIZE  = 2048U;
+    static const UBaseType_t ACQ_TASK_PRIORITY = 2U;    // Above loop().
+    static const BaseType_t  ACQ_TASK_CORE     = 1;     // Same core as loop().
+    static const uint32_t ACQ_TIMEOUT_MS       = 150UL; // > 1 period at 10 SPS.
+    static const uint16_t GAIN_SETTLE_COUNT    = 2U;    // Samples to discard.
+    static const uint16_t OUTPUT_RATE_SPS      = 10U;   // After decimation.
+    static const uint8_t  NET_FRACTION_BITS    = 8U;    // Net counts fixed point.
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    //  Save/Restore preferences labels.
+    /////////////////////////////////////////////////////////////////////////////
+    static const char *pPrefSavedStateLabel;
+    static const char *pPrefFilterLabel;
+    static const char *pPrefCalTableLabel;
+    static const char *pPrefTempCompLabel;
+    static const char *pPrefZeroTrackLabel;
+    static const char *pPrefRangeLabel;
+    static const char *UnitsStrings[];
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t     m_Gain;                 // HX711 gain, or AUTO_GAIN.
+    int32_t     m_RawTareWeight;        // Raw tare weight.
+    bool        m_IsCalibrated;         // True if successfully calibrated.
+    double      m_Offset;               // Optional offset for reporting weight.
+    WeightUnits m_Units;                // Selected weight units.
+    double      m_AverageInterval;      // Number of rolling values to average.
+    uint32_t    m_AverageTimeMs;        // The same as a time.
+    double      m_UnitsScaleFactor;     // Factor for scaling the displayed weight.
+    double      m_ConversionFactor;     // Factor for converting previous units to new.
+    FilterPipeline m_Filters;           // Raw reading filters.
+    const char *m_pName;                // NVS instance name.
+    HX711Transport *m_pTransport;       // Transport used to read the HX711.
+    TaskHandle_t m_AcqTask;             // Acquisition task, NULL if not running.
+    SampleQueue<int32_t, SAMPLE_QUEUE_SIZE> m_SampleQueue;
+                                        // Conversions from the acquisition task.
+    SampleQuality m_SampleQuality;      // Quality of the last ReadRawAverage().
+    CalibrationTable m_CalTable;        // Calibration reference points.
+    TempCompensator m_TempComp;         // Temperature drift correction.
+    ZeroTracker m_ZeroTracker;          // Zero tracking and creep correction.
+    SampleScheduler m_Scheduler;        // Gain and channel of each conversion.
+    volatile int32_t  m_ChannelBRaw;    // Latest channel B sample.
+    volatile uint32_t m_ChannelBCount;  // Channel B samples read.
+    uint16_t    m_ConversionRate;       // HX711 conversions per second.
+    CicDecimator m_Decimator;           // Reduces conversions to OUTPUT_RATE_SPS.
+    volatile bool m_DecimatorReset;     // m_Decimator must discard its history.
+    FixedScale  m_FixedScale;           // Net counts to display units.
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Structure containing all of our state information that may be
+    // saved/restored to/from NVS.
+    /////////////////////////////////////////////////////////////////////////////
+    struct SaveRestoreCache
+    {
+        uint8_t     m_Gain;             // HX711 gain, or AUTO_GAIN.
+        int32_t     m_RawTareWeight;    // Raw tare weight.
+        bool        m_IsCalibrated;     // True if successfully calibrated.
+        double      m_Offset;           // Optional offset for reporting weight.
+        WeightUnits m_Units;            // Selected weight units.
+        double      m_AverageInterval;  // Number of rolling values to average.
+        double      m_UnitsScaleFactor; // Factor for scaling the displayed weight.
+        double      m_ConversionFactor; // Factor for converting previous units to new.
+    };
+
+    // Allow unit tests to see all of our data and methods.
+    friend class LoadCellTests;
+
+}; // End class LoadCell.
+
+
+
+#endif // LOADCELL_H
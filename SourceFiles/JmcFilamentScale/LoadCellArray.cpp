@@ -0,0 +1,268 @@
+/////////////////////////////////////////////////////////////////////////////////
+// LoadCellArray.cpp
+//
+// Contains methods defined by the LoadCellArray class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "LoadCellArray.h"      // For LoadCellArray class.
+#include <cstring>              // For strlen().
+#include "NvsStore.h"           // For Save and Restore to/from NVS.
+
+
+const char *LoadCellArray::pPrefSlotsLabel = "Slots";
+
+// NVS names of the LoadCells.  Channel 0 is named by the sketch.
+const char *LoadCellArray::pCellNvsNames[MAX_CHANNELS] =
+    {NULL, "Load Cell 1", "Load Cell 2", "Load Cell 3"};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - ppCells     - Array of the LoadCells, in channel order.  Entry 0 is the
+//                    primary load cell.
+//    - numChannels - The number of entries in ppCells.  Limited to
+//                    MAX_CHANNELS.
+//    - numSlots    - The number of SpoolManager slots.
+//
+// Each channel starts out mapped to the slot with the same number.
+/////////////////////////////////////////////////////////////////////////////////
+LoadCellArray::LoadCellArray(LoadCell *const *ppCells, uint8_t numChannels,
+                             uint32_t numSlots) :
+    m_pName(NULL), m_NumChannels(0U), m_PresentMask(0U), m_NumSlots(numSlots)
+{
+    if ((ppCells != NULL) && (numChannels <= MAX_CHANNELS))
+    {
+        m_NumChannels = numChannels;
+    }
+    for (uint8_t ch = 0U; ch < MAX_CHANNELS; ch++)
+    {
+        m_pCells[ch]  = (ch < m_NumChannels) ? ppCells[ch] : NULL;
+        m_Slots[ch]   = (ch < numSlots) ? ch : NO_SLOT;
+        m_Weights[ch] = 0.0d;
+    }
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Init()
+//
+// Initializes the channels other than channel 0, and restores the slot map.
+//
+// Arguments:
+//    - pName   - A string of no more than 15 characters to be used as a
+//                name for this instance.  This is mainly used to identify
+//                the instance to be used for NVS save and restore.
+//
+// Returns:
+//    Returns 'true' if every channel was found, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCellArray::Init(const char *pName)
+{
+    if ((pName == NULL) || (*pName == '\0') || (strlen(pName) > MAX_NVS_NAME_LEN) ||
+        (m_NumChannels == 0U))
+    {
+        return false;
+    }
+    m_pName = pName;
+
+    bool status = true;
+    m_PresentMask = m_pCells[0]->IsInitialized() ? 1U : 0U;
+    for (uint8_t ch = 1U; ch < m_NumChannels; ch++)
+    {
+        if (m_pCells[ch]->Init(pCellNvsNames[ch]))
+        {
+            m_PresentMask |= (1U << ch);
+            Serial.printf("Load Cell channel %u found.\n", ch);
+        }
+        else
+        {
+            Serial.printf("Load Cell channel %u not found.\n", ch);
+            status = false;
+        }
+    }
+    return status;
+} // End Init().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Update()
+//
+// Reads the weight of each channel other than channel 0.  A channel that isn't
+// present or isn't calibrated reads 0.
+//
+// Arguments:
+//    - primaryWeight - The weight most recently read from channel 0.
+/////////////////////////////////////////////////////////////////////////////////
+void LoadCellArray::Update(double primaryWeight)
+{
+    if (m_NumChannels == 0U)
+    {
+        return;
+    }
+
+    m_Weights[0] = primaryWeight;
+    for (uint8_t ch = 1U; ch < m_NumChannels; ch++)
+    {
+        m_Weights[ch] = 0.0d;
+        if (IsResponding(ch) && m_pCells[ch]->IsCalibrated())
+        {
+            m_Weights[ch] = m_pCells[ch]->ReadWeight();
+        }
+    }
+} // End Update().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetSlot()
+//
+// Maps a channel to a SpoolManager slot.
+//
+// Arguments:
+//    - channel - The channel.
+//    - slot    - The slot, or NO_SLOT for none.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if either value is out of range.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCellArray::SetSlot(uint8_t channel, uint32_t slot)
+{
+    if ((channel >= m_NumChannels) || ((slot >= m_NumSlots) && (slot != NO_SLOT)))
+    {
+        return false;
+    }
+    m_Slots[channel] = static_cast<uint8_t>(slot);
+    return true;
+} // End SetSlot().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetUnits()
+//
+// Sets the weight units of the channels other than channel 0.
+/////////////////////////////////////////////////////////////////////////////////
+void LoadCellArray::SetUnits(WeightUnits units)
+{
+    for (uint8_t ch = 1U; ch < m_NumChannels; ch++)
+    {
+        m_pCells[ch]->SetUnits(units);
+    }
+} // End SetUnits().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetGain()
+//
+// Sets the gain of the channels other than channel 0.  Channels whose gain
+// changes must be recalibrated.
+/////////////////////////////////////////////////////////////////////////////////
+void LoadCellArray::SetGain(uint8_t gain)
+{
+    for (uint8_t ch = 1U; ch < m_NumChannels; ch++)
+    {
+        if (IsPresent(ch))
+        {
+            m_pCells[ch]->SetGain(gain);
+        }
+    }
+} // End SetGain().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Save()
+//
+// Saves the slot map, and the state of each channel other than channel 0, to
+// NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCellArray::Save() const
+{
+    bool status = false;
+    if (m_pName != NULL)
+    {
+        // Only write the slot map if it has changed.
+        status = NvsStore::PutIfChanged(m_pName, pPrefSlotsLabel, m_Slots,
+                                        sizeof(m_Slots));
+
+        for (uint8_t ch = 1U; ch < m_NumChannels; ch++)
+        {
+            if (IsPresent(ch))
+            {
+                status &= m_pCells[ch]->Save();
+            }
+        }
+    }
+    return status;
+} // End Save().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Restore()
+//
+// Restores the slot map, and the state of each channel other than channel 0,
+// from NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCellArray::Restore()
+{
+    bool status = false;
+    if (m_pName != NULL)
+    {
+        uint8_t slots[MAX_CHANNELS];
+        if (NvsStore::GetTracked(m_pName, pPrefSlotsLabel, slots, sizeof(slots)) ==
+            sizeof(slots))
+        {
+            status = true;
+            for (uint8_t ch = 0U; ch < m_NumChannels; ch++)
+            {
+                status &= SetSlot(ch, slots[ch]);
+            }
+        }
+
+        for (uint8_t ch = 1U; ch < m_NumChannels; ch++)
+        {
+            if (IsPresent(ch))
+            {
+                status &= m_pCells[ch]->Restore();
+            }
+        }
+    }
+    return status;
+} // End Restore().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Reset our state info, and that of each channel other than channel 0, in NVS.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool LoadCellArray::Reset()
+{
+    bool status = false;
+    if (m_pName != NULL)
+    {
+        status = NvsStore::Remove(m_pName, pPrefSlotsLabel);
+
+        for (uint8_t ch = 1U; ch < m_NumChannels; ch++)
+        {
+            if (IsPresent(ch))
+            {
+                m_pCells[ch]->Reset();
+            }
+        }
+    }
+    return status;
+} // End Reset().
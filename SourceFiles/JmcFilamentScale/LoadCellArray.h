@@ -0,0 +1,199 @@
+/////////////////////////////////////////////////////////////////////////////////
+// LoadCellArray.h
+//
+// This class implements the LoadCellArray class.  It groups the LoadCells of a
+// scale bank (a rack of spools, one load cell each) and maps each channel to a
+// SpoolManager slot.
+//
+// Channel 0 is the scale's primary load cell (gLoadCell).  It is initialized,
+// read, saved and restored by the sketch just as for a single load cell, and its
+// weight is handed to Update().  The remaining channels are initialized, read,
+// saved and restored here, each under its own NVS name.  The weight reported for
+// each channel is its net filament weight, since its LoadCell offset is set to
+// the weight of the spool in its slot.
+//
+// The array works with any transport.  HX711Bank provides transports for
+// HX711s that share a clock pin.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined LOADCELLARRAY_H
+#define LOADCELLARRAY_H
+
+#include <cstdint>              // For uint8_t, ...
+#include "LoadCell.h"           // For LoadCell class.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// LoadCellArray class
+/////////////////////////////////////////////////////////////////////////////////
+class LoadCellArray
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - ppCells     - Array of the LoadCells, in channel order.  Entry 0 is
+    //                    the primary load cell.  The LoadCells must remain
+    //                    valid for the life of the array.
+    //    - numChannels - The number of entries in ppCells.  Limited to
+    //                    MAX_CHANNELS.
+    //    - numSlots    - The number of SpoolManager slots.
+    /////////////////////////////////////////////////////////////////////////////
+    LoadCellArray(LoadCell *const *ppCells, uint8_t numChannels, uint32_t numSlots);
+
+
+    // Destructor.
+    virtual ~LoadCellArray() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Init()
+    //
+    // Initializes the channels other than channel 0, and restores the slot
+    // map.  A channel whose LoadCell fails to initialize (e.g. no HX711 is
+    // fitted) is reported as not present and otherwise ignored.
+    //
+    // Arguments:
+    //    - pName   - A string of no more than 15 characters to be used as a
+    //                name for this instance.  This is mainly used to identify
+    //                the instance to be used for NVS save and restore.
+    //
+    // Returns:
+    //    Returns a bool indicating whether or not the initialization was
+    //    successful (every channel was found).
+    /////////////////////////////////////////////////////////////////////////////
+    bool Init(const char *pName);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Update()
+    //
+    // Reads the weight of each channel other than channel 0.  A channel that
+    // has stopped responding (see IsResponding()) reads as 0.
+    //
+    // Arguments:
+    //    - primaryWeight - The weight most recently read from channel 0.
+    /////////////////////////////////////////////////////////////////////////////
+    void Update(double primaryWeight);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetSlot()
+    //
+    // Maps a channel to a SpoolManager slot.
+    //
+    // Arguments:
+    //    - channel - The channel.
+    //    - slot    - The slot, or NO_SLOT for none.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if either value is out of
+    //    range.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetSlot(uint8_t channel, uint32_t slot);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetUnits() / SetGain()
+    //
+    // Pass the scale's units and gain on to the channels other than channel 0.
+    // The gain is shared by all of the HX711s of an HX711Bank, so changing it
+    // invalidates the calibration of every channel.  For the same reason a
+    // bank can't auto range (each channel would choose its own gain) or read
+    // channel B.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetUnits(WeightUnits units);
+    void SetGain(uint8_t gain);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t   GetNumChannels()                const { return m_NumChannels; }
+    LoadCell *GetCell(uint8_t channel)        const
+        { return channel < m_NumChannels ? m_pCells[channel] : NULL; }
+    bool      IsPresent(uint8_t channel)      const
+        { return (channel < m_NumChannels) && (m_PresentMask & (1U << channel)); }
+    bool      IsResponding(uint8_t channel)   const
+        { return IsPresent(channel) && m_pCells[channel]->IsResponding(); }
+    double    GetWeight(uint8_t channel)      const
+        { return channel < m_NumChannels ? m_Weights[channel] : 0.0d; }
+    uint32_t  GetSlot(uint8_t channel)        const
+        { return channel < m_NumChannels ? m_Slots[channel] : NO_SLOT; }
+    bool      IsInitialized()                 const { return m_pName != NULL; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Save()
+    //
+    // Saves the slot map, and the state of each channel other than channel 0,
+    // to NVS.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Save() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Restore()
+    //
+    // Restores the slot map, and the state of each channel other than channel
+    // 0, from NVS.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Restore();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // Reset our state info, and that of each channel other than channel 0, in
+    // NVS.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Reset();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint8_t  MAX_CHANNELS     = 4U;
+    static const uint32_t NO_SLOT          = 0xffU;
+    static const size_t   MAX_NVS_NAME_LEN = 15U;
+    static const char    *pPrefSlotsLabel;
+    static const char    *pCellNvsNames[MAX_CHANNELS];
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    LoadCellArray();
+    LoadCellArray(LoadCellArray &rLca);
+    LoadCellArray &operator=(LoadCellArray &rLca);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    const char *m_pName;                // NVS storage name for this instance.
+    LoadCell   *m_pCells[MAX_CHANNELS]; // The LoadCell of each channel.
+    uint8_t     m_NumChannels;          // Number of channels.
+    uint8_t     m_PresentMask;          // Channels that were found.
+    uint32_t    m_NumSlots;             // Number of SpoolManager slots.
+    uint8_t     m_Slots[MAX_CHANNELS];  // Slot of each channel.
+    double      m_Weights[MAX_CHANNELS];// Latest weight of each channel.
+
+}; // End class LoadCellArray.
+
+
+
+#endif // LOADCELLARRAY_H
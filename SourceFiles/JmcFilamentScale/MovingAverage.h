@@ -1,185 +1,353 @@
-/////////////////////////////////////////////////////////////////////////////////
-// MovingAverage.h
-//
-// This class implements the MovingAverage template class which calculates a
-// moving average of up to MAX_SIZE values.  This template is very loosly based
-// on code by Tony Delroy on stackoverflow.com:
-//    https://stackoverflow.com/questions/10990618/calculate-rolling-moving-average-in-c
-// For this version, it was required that the number of the averaged samples be
-// modifiable.
-//
-// History:
-// - jmcorbett 18-OCT-2021 Original creation.
-//
-// Copyright (c) 2021, Joseph M. Corbett
-/////////////////////////////////////////////////////////////////////////////////
-#if !defined MOVINGAVERAGE_H
-#define MOVINGAVERAGE_H
-
-#include <cstddef>      // For size_t.
-#include <algorithm>    // For std::min().
-
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// MovingAverage template class
-//
-// Arguments:
-// - V  - The class used to store values.
-// - T  - The class used to maintain the running total value.
-/////////////////////////////////////////////////////////////////////////////////
-template<class V, class T>
-class MovingAverage
-{
-public:
-    /////////////////////////////////////////////////////////////////////////////
-    // Construct and initialize the class.
-    //
-    // Arguments:
-    //    - size - This specifies the number of samples to average for the moving
-    //             average.  Valid range is from MIN_SIZE to MAX_SIZE.
-    /////////////////////////////////////////////////////////////////////////////
-    MovingAverage(size_t size = MIN_SIZE) : m_NumValues(0), m_Size(0), m_Total(0)
-    {
-        SetSize(size);
-    } // End constructor.
-
-
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Add()
-    //
-    // This method adds a value to the running total, and handles removing
-    // older values.
-    //
-    // Arguments:
-    //    - val   - The value to be added to the running total.
-    //
-    // Returns:
-    //    Returns the moving running total of the values entered so far.
-    //
-    /////////////////////////////////////////////////////////////////////////////
-    T Add(V val)
-    {
-        // Add the value to the running total.
-        m_Total += val;
-
-        // Do we need to wrap yet?
-        if (m_NumValues < m_Size)
-        {
-            // No, so just add the value to our value array.
-            m_Values[m_NumValues++] = val;
-        }
-        else
-        {
-            // Yes, remove the oldest value from our array and add the new value.
-            V &oldest = m_Values[m_NumValues++ % m_Size];
-            m_Total -= oldest;
-            oldest = val;
-        }
-
-        // Return our running total.
-        return m_Total;
-    } // End Add().
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Average()
-    //
-    // This method returns the moving average of the values added so far.
-    //
-    // Returns:
-    //    Returns the moving average of the values added so far.
-    /////////////////////////////////////////////////////////////////////////////
-    V Average() const
-    {
-        return m_Total / std::min(m_NumValues, m_Size);
-    } // End Average().
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Total()
-    //
-    // This method returns the moving total of the values entered so far..
-    //
-    // Returns:
-    //    Returns the moving total of the values added so far.
-    /////////////////////////////////////////////////////////////////////////////
-    T Total() const { return m_Total; }
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Reset()
-    //
-    // This method resets the total and index to re-start the moving average.
-    /////////////////////////////////////////////////////////////////////////////
-    void Reset()
-    {
-        m_Total = 0;
-        m_NumValues = 0;
-    } // End Reset().
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // SetSize()
-    //
-    // This method (possibly) changes the number of values to average.
-    //
-    // Arguments:
-    //  - newSize - This is the desired size of the averaging interval.  Legal
-    //              values range from MIN_SIZE to MAX_SIZE inclusive.
-    //
-    // Returns:
-    //   Returns the (possibly) new size of the averaging interval, which may
-    //   have been limited to a range between MIN_SIZE and MAX_SIZE includive.
-    /////////////////////////////////////////////////////////////////////////////
-    size_t SetSize(size_t newSize)
-    {
-        // Clip the new size to fit within the valid range.
-        if (newSize < MIN_SIZE)
-        {
-            newSize = MIN_SIZE;
-        }
-        else if (newSize > MAX_SIZE)
-        {
-            newSize = MAX_SIZE;
-        }
-
-        // If the new size has changed, then remember it, and reset the
-        // averaging mechanism.
-        if (newSize != m_Size)
-        {
-            m_Size = newSize;
-            Reset();
-        }
-
-        // Return the (possibly) new size value.
-        return m_Size;
-    } // End SetSize().
-
-
-    /////////////////////////////////////////////////////////////////////////////
-    // Size()
-    //
-    // This method returns the number of items for the interval of the moving
-    // average.
-    //
-    // Returns:
-    //   Returns the number of items for the interval of the moving average.
-    /////////////////////////////////////////////////////////////////////////////
-    size_t Size() const { return m_Size; }
-
-private:
-    static const size_t MAX_SIZE = 100; // Maximum interval for moving average.
-    static const size_t MIN_SIZE = 1;   // Minimum interval for moving average.
-
-    V         m_Values[MAX_SIZE];       // Array of values.
-    size_t    m_NumValues;              // Number of values entered so far.
-    size_t    m_Size;                   // Size of the averaging interval.
-    T         m_Total;                  // Total of the values entered so far.
-
-}; // End class MovingAverage.
-
-
-#endif // MOVINGAVERAGE_H
\ No newline at end of file
+/////////////////////////////////////////////////////////////////////////////////
+// MovingAverage.h
+//
+// This class implements the MovingAverage template class which calculates a
+// moving average of up to CAPACITY values.  This template is very loosly based
+// on code by Tony Delroy on stackoverflow.com:
+//    https://stackoverflow.com/questions/10990618/calculate-rolling-moving-average-in-c
+// For this version, it was required that the number of the averaged samples be
+// modifiable.
+//
+// The values are kept in a ring of CAPACITY entries, which must be a power of
+// 2 so that the ring index is a simple mask rather than a divide.  The size of
+// the averaging interval may be changed at run time, but never beyond
+// CAPACITY, so the memory used is fixed at compile time.
+//
+// When STATS is 'true', the sum of the squares and the window minimum and
+// maximum are maintained in the same pass as the total, so Variance(),
+// StdDev(), Min() and Max() are all O(1).  Min and max use monotonic queues
+// (amortized O(1) per value).  When STATS is 'false' these cost nothing.
+//
+// History:
+// - jmcorbett 18-OCT-2021 Original creation.
+// - jmcorbett 15-OCT-2026 Compile time capacity, power of 2 ring, and
+//                         optional streaming statistics.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined MOVINGAVERAGE_H
+#define MOVINGAVERAGE_H
+
+#include <cstddef>      // For size_t.
+#include <cstdint>      // For uint32_t.
+#include <cmath>        // For sqrt().
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// MovingAverage template class
+//
+// Arguments:
+// - V        - The class used to store values.
+// - T        - The class used to maintain the running total value (and the
+//              sum of the squares when STATS is 'true').
+// - CAPACITY - The largest averaging interval.  Must be a power of 2.
+// - STATS    - If 'true', also track the variance, minimum and maximum.
+/////////////////////////////////////////////////////////////////////////////////
+template<class V, class T, size_t CAPACITY = 128U, bool STATS = false>
+class MovingAverage
+{
+    static_assert((CAPACITY != 0U) && ((CAPACITY & (CAPACITY - 1U)) == 0U),
+                  "MovingAverage CAPACITY must be a power of 2.");
+
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Construct and initialize the class.
+    //
+    // Arguments:
+    //    - size - This specifies the number of samples to average for the moving
+    //             average.  Valid range is from MIN_SIZE to MAX_SIZE.
+    /////////////////////////////////////////////////////////////////////////////
+    MovingAverage(size_t size = MIN_SIZE) :
+        m_NumValues(0), m_Head(0), m_Size(0), m_Total(0), m_SumSquares(0),
+        m_MinHead(0), m_MinTail(0), m_MaxHead(0), m_MaxTail(0)
+    {
+        SetSize(size);
+    } // End constructor.
+
+
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Add()
+    //
+    // This method adds a value to the running total, and handles removing
+    // older values.
+    //
+    // Arguments:
+    //    - val   - The value to be added to the running total.
+    //
+    // Returns:
+    //    Returns the moving running total of the values entered so far.
+    //
+    /////////////////////////////////////////////////////////////////////////////
+    T Add(V val)
+    {
+        // Once the window is full, the value leaving it is 'm_Size' entries
+        // behind the new one.  Fetch it before it can be overwritten (when
+        // m_Size == CAPACITY they share a slot).
+        if (m_NumValues < m_Size)
+        {
+            m_NumValues++;
+        }
+        else
+        {
+            V oldest = m_Values[(m_Head - m_Size) & MASK];
+            m_Total -= oldest;
+            if (STATS)
+            {
+                m_SumSquares -= static_cast<T>(oldest) * static_cast<T>(oldest);
+            }
+        }
+
+        // Add the value to the running total(s).
+        m_Total += val;
+        m_Values[m_Head & MASK] = val;
+        if (STATS)
+        {
+            m_SumSquares += static_cast<T>(val) * static_cast<T>(val);
+            UpdateMinMax(val);
+        }
+        m_Head++;
+
+        // Return our running total.
+        return m_Total;
+    } // End Add().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Average()
+    //
+    // This method returns the moving average of the values added so far.
+    //
+    // Returns:
+    //    Returns the moving average of the values added so far, or 0 if no
+    //    values have been added.
+    /////////////////////////////////////////////////////////////////////////////
+    V Average() const
+    {
+        size_t count = Count();
+        return (count == 0U) ? V(0) : static_cast<V>(m_Total / static_cast<T>(count));
+    } // End Average().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Mean()
+    //
+    // Returns the moving average as a double, without the truncation done by
+    // Average() for integer types.  Returns 0.0 if no values have been added.
+    /////////////////////////////////////////////////////////////////////////////
+    double Mean() const
+    {
+        size_t count = Count();
+        return (count == 0U) ? 0.0 :
+                static_cast<double>(m_Total) / static_cast<double>(count);
+    } // End Mean().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Variance(), StdDev()
+    //
+    // Return the (population) variance and standard deviation of the values in
+    // the window.  Only available when STATS is 'true'.  Return 0.0 if no
+    // values have been added.
+    /////////////////////////////////////////////////////////////////////////////
+    double Variance() const
+    {
+        static_assert(STATS, "MovingAverage::Variance() requires STATS.");
+        size_t count = Count();
+        if (count == 0U)
+        {
+            return 0.0;
+        }
+        double mean = Mean();
+        double variance =
+            static_cast<double>(m_SumSquares) / static_cast<double>(count) -
+            mean * mean;
+
+        // Rounding can leave a tiny negative value when all values are equal.
+        return (variance > 0.0) ? variance : 0.0;
+    } // End Variance().
+
+    double StdDev() const { return sqrt(Variance()); }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Min(), Max()
+    //
+    // Return the smallest and largest values in the window.  Only available
+    // when STATS is 'true'.  Return 0 if no values have been added.
+    /////////////////////////////////////////////////////////////////////////////
+    V Min() const
+    {
+        static_assert(STATS, "MovingAverage::Min() requires STATS.");
+        return (m_MinHead == m_MinTail) ? V(0) :
+                m_Values[m_MinQueue[m_MinHead & QUEUE_MASK] & MASK];
+    } // End Min().
+
+    V Max() const
+    {
+        static_assert(STATS, "MovingAverage::Max() requires STATS.");
+        return (m_MaxHead == m_MaxTail) ? V(0) :
+                m_Values[m_MaxQueue[m_MaxHead & QUEUE_MASK] & MASK];
+    } // End Max().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Total()
+    //
+    // This method returns the moving total of the values entered so far..
+    //
+    // Returns:
+    //    Returns the moving total of the values added so far.
+    /////////////////////////////////////////////////////////////////////////////
+    T Total() const { return m_Total; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Count()
+    //
+    // This method returns the number of values currently contributing to the
+    // moving average.
+    //
+    // Returns:
+    //    Returns the number of values in the average (never more than Size()).
+    /////////////////////////////////////////////////////////////////////////////
+    size_t Count() const { return m_NumValues; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // This method resets the total and index to re-start the moving average.
+    /////////////////////////////////////////////////////////////////////////////
+    void Reset()
+    {
+        m_Total      = 0;
+        m_SumSquares = 0;
+        m_NumValues  = 0;
+        m_Head       = 0;
+        m_MinHead    = m_MinTail = 0;
+        m_MaxHead    = m_MaxTail = 0;
+    } // End Reset().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetSize()
+    //
+    // This method (possibly) changes the number of values to average.
+    //
+    // Arguments:
+    //  - newSize - This is the desired size of the averaging interval.  Legal
+    //              values range from MIN_SIZE to MAX_SIZE inclusive.
+    //
+    // Returns:
+    //   Returns the (possibly) new size of the averaging interval, which may
+    //   have been limited to a range between MIN_SIZE and MAX_SIZE includive.
+    /////////////////////////////////////////////////////////////////////////////
+    size_t SetSize(size_t newSize)
+    {
+        // Clip the new size to fit within the valid range.
+        if (newSize < MIN_SIZE)
+        {
+            newSize = MIN_SIZE;
+        }
+        else if (newSize > MAX_SIZE)
+        {
+            newSize = MAX_SIZE;
+        }
+
+        // If the new size has changed, then remember it, and reset the
+        // averaging mechanism.
+        if (newSize != m_Size)
+        {
+            m_Size = newSize;
+            Reset();
+        }
+
+        // Return the (possibly) new size value.
+        return m_Size;
+    } // End SetSize().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Size()
+    //
+    // This method returns the number of items for the interval of the moving
+    // average.
+    //
+    // Returns:
+    //   Returns the number of items for the interval of the moving average.
+    /////////////////////////////////////////////////////////////////////////////
+    size_t Size() const { return m_Size; }
+
+
+    static const size_t MAX_SIZE = CAPACITY;// Maximum interval for moving average.
+    static const size_t MIN_SIZE = 1;   // Minimum interval for moving average.
+
+private:
+    static const uint32_t MASK = static_cast<uint32_t>(CAPACITY - 1U);
+
+
+    // Storage for the min/max queues is only needed when STATS is 'true'.
+    static const size_t   QUEUE_SIZE = STATS ? CAPACITY : 1U;
+    static const uint32_t QUEUE_MASK = static_cast<uint32_t>(QUEUE_SIZE - 1U);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // UpdateMinMax()
+    //
+    // Adds the value (whose sequence number is m_Head) to the monotonic min and
+    // max queues.  Each queue holds sequence numbers of values in the window,
+    // oldest first, whose values are increasing (min) or decreasing (max), so
+    // the front of each queue is the answer.  Sequence numbers are compared by
+    // difference so that wrapping is harmless.
+    /////////////////////////////////////////////////////////////////////////////
+    void UpdateMinMax(V val)
+    {
+        uint32_t seq = m_Head;
+
+        // Drop entries that have left the window.
+        while ((m_MinHead != m_MinTail) &&
+               ((seq - m_MinQueue[m_MinHead & QUEUE_MASK]) >= m_Size))
+        {
+            m_MinHead++;
+        }
+        while ((m_MaxHead != m_MaxTail) &&
+               ((seq - m_MaxQueue[m_MaxHead & QUEUE_MASK]) >= m_Size))
+        {
+            m_MaxHead++;
+        }
+
+        // Drop entries that can never be the answer again.
+        while ((m_MinHead != m_MinTail) &&
+               (m_Values[m_MinQueue[(m_MinTail - 1U) & QUEUE_MASK] & MASK] >= val))
+        {
+            m_MinTail--;
+        }
+        while ((m_MaxHead != m_MaxTail) &&
+               (m_Values[m_MaxQueue[(m_MaxTail - 1U) & QUEUE_MASK] & MASK] <= val))
+        {
+            m_MaxTail--;
+        }
+
+        m_MinQueue[m_MinTail++ & QUEUE_MASK] = seq;
+        m_MaxQueue[m_MaxTail++ & QUEUE_MASK] = seq;
+    } // End UpdateMinMax().
+
+
+    V         m_Values[CAPACITY];       // Ring of values.
+    size_t    m_NumValues;              // Values in the window (<= m_Size).
+    uint32_t  m_Head;                   // Sequence number of the next value.
+    size_t    m_Size;                   // Size of the averaging interval.
+    T         m_Total;                  // Total of the values in the window.
+    T         m_SumSquares;             // Sum of squares (STATS only).
+    uint32_t  m_MinQueue[QUEUE_SIZE];   // Min queue sequence numbers.
+    uint32_t  m_MaxQueue[QUEUE_SIZE];   // Max queue sequence numbers.
+    uint32_t  m_MinHead, m_MinTail;     // Min queue indices.
+    uint32_t  m_MaxHead, m_MaxTail;     // Max queue indices.
+
+}; // End class MovingAverage.
+
+
+#endif // MOVINGAVERAGE_H
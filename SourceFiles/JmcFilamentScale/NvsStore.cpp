@@ -0,0 +1,380 @@
+/////////////////////////////////////////////////////////////////////////////////
+// NvsStore.cpp
+//
+// Contains methods defined by the NvsStore class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Preferences.h>        // For NVS access.
+#include <cstdlib>              // For malloc() and free().
+#include <cstring>              // For memcmp(), strcmp(), ...
+#include "NvsStore.h"           // For NvsStore class.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// NvsStore class data.
+/////////////////////////////////////////////////////////////////////////////////
+char                     NvsStore::m_OpenName[16]           = "";
+NvsStore::Shadow         NvsStore::m_Shadows[MAX_SHADOWS];
+NvsSaveHandler           NvsStore::m_pSaveHandler           = NULL;
+bool                     NvsStore::m_SavePending            = false;
+uint32_t                 NvsStore::m_RequestMs              = 0UL;
+uint32_t                 NvsStore::m_Puts                   = 0UL;
+uint32_t                 NvsStore::m_Skips                  = 0UL;
+
+// The shared handle.
+static Preferences gPrefs;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Get(), GetTracked()
+//
+// Read a value.  GetTracked() also keeps a copy for PutIfChanged().
+//
+// Arguments:
+//    - pName - The namespace (at most 15 characters).
+//    - pKey  - The key.
+//    - pBuf  - Where to put the value.
+//    - size  - Size of pBuf.
+//
+// Returns:
+//    Returns the size of the value, or 0 if there is no such key or it doesn't
+//    fit in pBuf.
+/////////////////////////////////////////////////////////////////////////////////
+size_t NvsStore::Get(const char *pName, const char *pKey, void *pBuf, size_t size)
+{
+    return Read(pName, pKey, pBuf, size, false);
+} // End Get().
+
+
+size_t NvsStore::GetTracked(const char *pName, const char *pKey, void *pBuf,
+                            size_t size)
+{
+    return Read(pName, pKey, pBuf, size, true);
+} // End GetTracked().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Put()
+//
+// Writes a value.  A copy is kept only if the key already has one.
+//
+// Arguments:
+//    - pName - The namespace.
+//    - pKey  - The key.
+//    - pData - The value.
+//    - size  - Its size.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool NvsStore::Put(const char *pName, const char *pKey, const void *pData,
+                   size_t size)
+{
+    return Write(pName, pKey, pData, size, false);
+} // End Put().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// PutIfChanged()
+//
+// Writes a value unless it matches what NVS is known to hold.  A value whose
+// key has no RAM copy (never read, or the table is full) is always written.
+//
+// Arguments:
+//    - pName - The namespace.
+//    - pKey  - The key.
+//    - pData - The value.
+//    - size  - Its size.
+//
+// Returns:
+//    Returns 'true' if NVS now holds the value, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool NvsStore::PutIfChanged(const char *pName, const char *pKey,
+                            const void *pData, size_t size)
+{
+    const Shadow *pShadow = FindShadow(pName, pKey);
+    if ((pShadow != NULL) && (pShadow->m_Size == size) &&
+        !memcmp(pShadow->m_pData, pData, size))
+    {
+        m_Skips++;
+        return true;
+    }
+    Serial.printf("\n%s - saving %s to NVS.\n", pName, pKey);
+    return Write(pName, pKey, pData, size, true);
+} // End PutIfChanged().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Remove()
+//
+// Removes a key.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool NvsStore::Remove(const char *pName, const char *pKey)
+{
+    DropShadow(FindShadow(pName, pKey));
+    return Open(pName) && gPrefs.remove(pKey);
+} // End Remove().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Clear()
+//
+// Removes every key of a namespace.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool NvsStore::Clear(const char *pName)
+{
+    for (size_t i = 0U; i < MAX_SHADOWS; i++)
+    {
+        if (!strcmp(m_Shadows[i].m_Name, pName))
+        {
+            DropShadow(&m_Shadows[i]);
+        }
+    }
+    return Open(pName) && gPrefs.clear();
+} // End Clear().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Close()
+//
+// Closes the shared handle.
+/////////////////////////////////////////////////////////////////////////////////
+void NvsStore::Close()
+{
+    if (m_OpenName[0] != '\0')
+    {
+        gPrefs.end();
+        m_OpenName[0] = '\0';
+    }
+} // End Close().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RequestSave()
+//
+// Asks for a deferred save.  Each request pushes the save back, so a burst of
+// requests results in one save.
+//
+// Arguments:
+//    - nowMs - The current time (millis()).
+/////////////////////////////////////////////////////////////////////////////////
+void NvsStore::RequestSave(uint32_t nowMs)
+{
+    m_SavePending = true;
+    m_RequestMs   = nowMs;
+} // End RequestSave().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Process()
+//
+// Does a requested save once SAVE_DELAY_MS has passed since the last request.
+//
+// Arguments:
+//    - nowMs - The current time (millis()).
+/////////////////////////////////////////////////////////////////////////////////
+void NvsStore::Process(uint32_t nowMs)
+{
+    if (m_SavePending && (nowMs - m_RequestMs >= SAVE_DELAY_MS))
+    {
+        Flush();
+    }
+} // End Process().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Flush()
+//
+// Does a requested save now.
+//
+// Returns:
+//    Returns 'true' if there was nothing to save or the save succeeded, or
+//    'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool NvsStore::Flush()
+{
+    bool status = true;
+    if (m_SavePending)
+    {
+        m_SavePending = false;
+        if (m_pSaveHandler != NULL)
+        {
+            status = m_pSaveHandler();
+        }
+        Close();
+    }
+    return status;
+} // End Flush().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Open()
+//
+// Opens the shared handle on a namespace, unless it already is.
+//
+// Arguments:
+//    - pName - The namespace.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool NvsStore::Open(const char *pName)
+{
+    if ((pName == NULL) || (strlen(pName) >= sizeof(m_OpenName)))
+    {
+        return false;
+    }
+    if (!strcmp(m_OpenName, pName))
+    {
+        return true;
+    }
+    Close();
+    if (!gPrefs.begin(pName))
+    {
+        return false;
+    }
+    strlcpy(m_OpenName, pName, sizeof(m_OpenName));
+    return true;
+} // End Open().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Read()
+//
+// Reads a value, keeping a copy if asked to.  See Get().
+/////////////////////////////////////////////////////////////////////////////////
+size_t NvsStore::Read(const char *pName, const char *pKey, void *pBuf,
+                      size_t size, bool track)
+{
+    size_t got = 0U;
+    if (Open(pName))
+    {
+        got = gPrefs.getBytes(pKey, pBuf, size);
+        if ((got > 0U) && track)
+        {
+            SetShadow(pName, pKey, pBuf, got);
+        }
+    }
+    return got;
+} // End Read().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Write()
+//
+// Writes a value.  A copy is kept if asked to, or if the key already has one.
+// See Put().
+/////////////////////////////////////////////////////////////////////////////////
+bool NvsStore::Write(const char *pName, const char *pKey, const void *pData,
+                     size_t size, bool track)
+{
+    if (!Open(pName))
+    {
+        return false;
+    }
+    m_Puts++;
+    bool status = gPrefs.putBytes(pKey, pData, size) == size;
+    Shadow *pShadow = FindShadow(pName, pKey);
+    if (!status)
+    {
+        // NVS may hold either value now.
+        DropShadow(pShadow);
+    }
+    else if (track || (pShadow != NULL))
+    {
+        SetShadow(pName, pKey, pData, size);
+    }
+    return status;
+} // End Write().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FindShadow()
+//
+// Returns the RAM copy of a key's value, or NULL if there is none.
+/////////////////////////////////////////////////////////////////////////////////
+NvsStore::Shadow *NvsStore::FindShadow(const char *pName, const char *pKey)
+{
+    for (size_t i = 0U; i < MAX_SHADOWS; i++)
+    {
+        if ((m_Shadows[i].m_Name[0] != '\0') &&
+            !strcmp(m_Shadows[i].m_Name, pName) && !strcmp(m_Shadows[i].m_Key, pKey))
+        {
+            return &m_Shadows[i];
+        }
+    }
+    return NULL;
+} // End FindShadow().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetShadow()
+//
+// Records the value NVS holds for a key.  Does nothing if the table is full
+// or out of memory, so the key will simply always be written.
+/////////////////////////////////////////////////////////////////////////////////
+void NvsStore::SetShadow(const char *pName, const char *pKey, const void *pData,
+                         size_t size)
+{
+    if ((strlen(pName) >= sizeof(m_Shadows[0].m_Name)) ||
+        (strlen(pKey) >= sizeof(m_Shadows[0].m_Key)))
+    {
+        return;
+    }
+
+    Shadow *pShadow = FindShadow(pName, pKey);
+    for (size_t i = 0U; (pShadow == NULL) && (i < MAX_SHADOWS); i++)
+    {
+        if (m_Shadows[i].m_Name[0] == '\0')
+        {
+            pShadow = &m_Shadows[i];
+        }
+    }
+    if (pShadow == NULL)
+    {
+        return;
+    }
+
+    if ((pShadow->m_pData == NULL) || (pShadow->m_Size != size))
+    {
+        free(pShadow->m_pData);
+        pShadow->m_pData = static_cast<uint8_t *>(malloc(size));
+        if (pShadow->m_pData == NULL)
+        {
+            pShadow->m_Name[0] = '\0';
+            return;
+        }
+    }
+    strlcpy(pShadow->m_Name, pName, sizeof(pShadow->m_Name));
+    strlcpy(pShadow->m_Key, pKey, sizeof(pShadow->m_Key));
+    pShadow->m_Size = size;
+    memcpy(pShadow->m_pData, pData, size);
+} // End SetShadow().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// DropShadow()
+//
+// Forgets a RAM copy.  pShadow may be NULL.
+/////////////////////////////////////////////////////////////////////////////////
+void NvsStore::DropShadow(Shadow *pShadow)
+{
+    if (pShadow != NULL)
+    {
+        free(pShadow->m_pData);
+        pShadow->m_pData   = NULL;
+        pShadow->m_Size    = 0U;
+        pShadow->m_Name[0] = '\0';
+    }
+} // End DropShadow().
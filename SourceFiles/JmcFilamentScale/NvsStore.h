@@ -0,0 +1,202 @@
+/////////////////////////////////////////////////////////////////////////////////
+// NvsStore.h
+//
+// This file defines the NvsStore class.  Every object that saves its state to
+// NVS goes through it, rather than opening its own Preferences.  It provides:
+//    - A single shared NVS handle.  It stays open from one call to the next,
+//      and is only reopened when a different namespace is used, so a Save()
+//      that writes several keys opens NVS once.
+//    - Writes without read back.  PutIfChanged() compares a value with a RAM
+//      copy of what NVS holds (kept by GetTracked() and PutIfChanged()), so
+//      that saving an unchanged value costs a memcmp() and no NVS access.
+//      Objects that track their own changes (dirty bits) use Get() and Put(),
+//      which keep no copy.
+//    - Deferred saves.  RequestSave() asks for the state to be saved once
+//      things have been quiet for SAVE_DELAY_MS, so that a burst of edits
+//      (e.g. each field of a spool) is written once, by Process().
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined NVSSTORE_H
+#define NVSSTORE_H
+
+#include <cstddef>              // For size_t.
+#include <cstdint>              // For uint32_t, ...
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// NvsSaveHandler is called by NvsStore::Process() to do a deferred save.
+// Returns 'true' if successful.
+/////////////////////////////////////////////////////////////////////////////////
+typedef bool (*NvsSaveHandler)();
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// NvsStore class
+/////////////////////////////////////////////////////////////////////////////////
+class NvsStore
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Get(), GetTracked()
+    //
+    // Read a value.  GetTracked() also keeps a copy for PutIfChanged().
+    //
+    // Arguments:
+    //    - pName - The namespace (at most 15 characters).
+    //    - pKey  - The key.
+    //    - pBuf  - Where to put the value.
+    //    - size  - Size of pBuf.
+    //
+    // Returns:
+    //    Returns the size of the value, or 0 if there is no such key or it
+    //    doesn't fit in pBuf.
+    /////////////////////////////////////////////////////////////////////////////
+    static size_t Get(const char *pName, const char *pKey, void *pBuf, size_t size);
+    static size_t GetTracked(const char *pName, const char *pKey, void *pBuf,
+                             size_t size);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Put()
+    //
+    // Writes a value.  A copy is kept only if the key already has one.
+    //
+    // Arguments:
+    //    - pName - The namespace.
+    //    - pKey  - The key.
+    //    - pData - The value.
+    //    - size  - Its size.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    static bool Put(const char *pName, const char *pKey, const void *pData,
+                    size_t size);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // PutIfChanged()
+    //
+    // Writes a value unless it matches what NVS is known to hold.  NVS is never
+    // read.
+    //
+    // Arguments:
+    //    - pName - The namespace.
+    //    - pKey  - The key.
+    //    - pData - The value.
+    //    - size  - Its size.
+    //
+    // Returns:
+    //    Returns 'true' if NVS now holds the value, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    static bool PutIfChanged(const char *pName, const char *pKey,
+                             const void *pData, size_t size);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Remove(), Clear()
+    //
+    // Remove a key, or every key of a namespace.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    static bool Remove(const char *pName, const char *pKey);
+    static bool Clear(const char *pName);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Close()
+    //
+    // Closes the shared handle.  It is reopened by the next call.
+    /////////////////////////////////////////////////////////////////////////////
+    static void Close();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Deferred saves.
+    //
+    // SetSaveHandler() sets the function that saves the state.  RequestSave()
+    // asks for it to be called, and Process() (called from loop()) calls it
+    // once SAVE_DELAY_MS has passed since the last request.  Flush() calls it
+    // now if a save has been requested.
+    /////////////////////////////////////////////////////////////////////////////
+    static void SetSaveHandler(NvsSaveHandler pHandler) { m_pSaveHandler = pHandler; }
+    static void RequestSave(uint32_t nowMs);
+    static void Process(uint32_t nowMs);
+    static bool Flush();
+    static bool IsSavePending()          { return m_SavePending; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Statistics: values written, and those that PutIfChanged() found
+    // unchanged.
+    /////////////////////////////////////////////////////////////////////////////
+    static uint32_t GetPuts()            { return m_Puts; }
+    static uint32_t GetSkips()           { return m_Skips; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint32_t SAVE_DELAY_MS = 5000UL;
+
+private:
+    // Unimplemented methods.  This class has only static members.
+    NvsStore();
+    NvsStore(NvsStore &rNs);
+    NvsStore &operator=(NvsStore &rNs);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Shadow is the RAM copy of a value that NVS holds.
+    /////////////////////////////////////////////////////////////////////////////
+    struct Shadow
+    {
+        char     m_Name[16];            // Namespace, empty if the entry is free.
+        char     m_Key[16];             // Key.
+        size_t   m_Size;                // Value size.
+        uint8_t *m_pData;               // Value.
+    };
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Helpers.  See NvsStore.cpp for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    static bool    Open(const char *pName);
+    static Shadow *FindShadow(const char *pName, const char *pKey);
+    static size_t  Read(const char *pName, const char *pKey, void *pBuf,
+                        size_t size, bool track);
+    static bool    Write(const char *pName, const char *pKey, const void *pData,
+                         size_t size, bool track);
+    static void    SetShadow(const char *pName, const char *pKey,
+                             const void *pData, size_t size);
+    static void    DropShadow(Shadow *pShadow);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Private constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const size_t MAX_SHADOWS = 40U;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Class data.
+    /////////////////////////////////////////////////////////////////////////////
+    static char           m_OpenName[16];           // Namespace open, or empty.
+    static Shadow         m_Shadows[MAX_SHADOWS];   // Values NVS holds.
+    static NvsSaveHandler m_pSaveHandler;           // Does a deferred save.
+    static bool           m_SavePending;            // A save was requested.
+    static uint32_t       m_RequestMs;              // Time of the last request.
+    static uint32_t       m_Puts;                   // Values written.
+    static uint32_t       m_Skips;                  // Writes found unneeded.
+
+}; // End class NvsStore.
+
+
+
+#endif // NVSSTORE_H
@@ -0,0 +1,142 @@
+/////////////////////////////////////////////////////////////////////////////////
+// SampleQueue.h
+//
+// This class implements the SampleQueue template class which is a lock-free
+// single-producer/single-consumer ring buffer.  It is used to pass samples from
+// an acquisition task (the producer) to the main loop (the consumer) without
+// the need for a mutex or for disabling interrupts.
+//
+// Only one task may call Push() and only one (other) task may call Pop().  The
+// producer only ever writes m_Head, and the consumer only ever writes m_Tail,
+// so no further locking is required.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined SAMPLEQUEUE_H
+#define SAMPLEQUEUE_H
+
+#include <cstddef>      // For size_t.
+#include <cstdint>      // For uint32_t.
+#include <atomic>       // For std::atomic.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SampleQueue template class
+//
+// Arguments:
+// - V  - The class used to store values.
+// - N  - The number of entries in the queue.  Must be a power of 2.  Note that
+//        one entry is always left unused in order to distinguish a full queue
+//        from an empty one, so at most N - 1 values may be queued.
+/////////////////////////////////////////////////////////////////////////////////
+template<class V, size_t N>
+class SampleQueue
+{
+    static_assert((N >= 2) && ((N & (N - 1)) == 0), "N must be a power of 2.");
+
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Construct and initialize the class.  The queue starts out empty.
+    /////////////////////////////////////////////////////////////////////////////
+    SampleQueue() : m_Head(0), m_Tail(0), m_Overruns(0) { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Push()
+    //
+    // Adds a value to the queue.  May only be called by the producer.
+    //
+    // Arguments:
+    //    - val   - The value to be added to the queue.
+    //
+    // Returns:
+    //    Returns 'true' if the value was queued, or 'false' if the queue was
+    //    full.  When the queue is full, the value is dropped and the overrun
+    //    count is incremented.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Push(V val)
+    {
+        size_t head = m_Head.load(std::memory_order_relaxed);
+        size_t next = (head + 1) & MASK;
+
+        // If the queue is full, drop the new value.
+        if (next == m_Tail.load(std::memory_order_acquire))
+        {
+            m_Overruns++;
+            return false;
+        }
+
+        // Store the value before publishing the new head to the consumer.
+        m_Values[head] = val;
+        m_Head.store(next, std::memory_order_release);
+        return true;
+    } // End Push().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Pop()
+    //
+    // Removes the oldest value from the queue.  May only be called by the
+    // consumer.
+    //
+    // Arguments:
+    //    - rVal  - Reference to the variable that receives the removed value.
+    //              Unchanged if the queue is empty.
+    //
+    // Returns:
+    //    Returns 'true' if a value was removed, or 'false' if the queue was
+    //    empty.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Pop(V &rVal)
+    {
+        size_t tail = m_Tail.load(std::memory_order_relaxed);
+
+        // Nothing to do if the queue is empty.
+        if (tail == m_Head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        // Fetch the value before releasing its slot to the producer.
+        rVal = m_Values[tail];
+        m_Tail.store((tail + 1) & MASK, std::memory_order_release);
+        return true;
+    } // End Pop().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Flush()
+    //
+    // Discards all queued values.  May only be called by the consumer.
+    /////////////////////////////////////////////////////////////////////////////
+    void Flush()
+    {
+        m_Tail.store(m_Head.load(std::memory_order_acquire),
+                     std::memory_order_release);
+    } // End Flush().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    bool     IsEmpty()     const { return m_Head.load() == m_Tail.load(); }
+    size_t   Count()       const { return (m_Head.load() - m_Tail.load()) & MASK; }
+    uint32_t GetOverruns() const { return m_Overruns; }
+    static constexpr size_t Capacity() { return N - 1; }
+
+private:
+    static const size_t MASK = N - 1;   // Mask used to wrap the indices.
+
+    V                   m_Values[N];    // Array of values.
+    std::atomic<size_t> m_Head;         // Next slot to write (producer owned).
+    std::atomic<size_t> m_Tail;         // Next slot to read (consumer owned).
+    volatile uint32_t   m_Overruns;     // Number of values dropped when full.
+
+}; // End class SampleQueue.
+
+
+#endif // SAMPLEQUEUE_H
@@ -0,0 +1,400 @@
+/////////////////////////////////////////////////////////////////////////////////
+// SampleScheduler.cpp
+//
+// Contains methods defined by the SampleScheduler class.  These methods choose
+// the gain of each HX711 conversion and classify the conversions read.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "SampleScheduler.h"    // For SampleScheduler class.
+#include <cmath>                // For lround().
+
+
+// Gain 128 counts per gain 64 count (nominal), and how quickly later offset
+// estimates are taken up.
+const double SampleScheduler::GAIN_RATIO          = 2.0d;
+const double SampleScheduler::OFFSET_LEARN_WEIGHT = 0.5d;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - gain - The channel A gain: 128, 64 or AUTO_GAIN.  Invalid values are
+//             taken as 128.
+/////////////////////////////////////////////////////////////////////////////////
+SampleScheduler::SampleScheduler(uint8_t gain) :
+    m_Gain(128U), m_RangeGain(128U), m_RequestFlags(0U), m_RequestGain(128U),
+    m_RequestInterval(0U),
+    m_ConvGain(128U), m_NextGain(128U), m_LastGain(128U), m_Unknown(0U),
+    m_BRemaining(0U), m_ASinceB(0U), m_Discards(0UL), m_HavePrevA(false),
+    m_PrevAGain(128U), m_PrevARaw(0L), m_PrevAChange(MAX_COUNTS),
+    m_OffsetPending(false), m_PendingOffset(0.0f)
+{
+    m_Mux = portMUX_INITIALIZER_UNLOCKED;
+    if ((gain == 64U) || (gain == AUTO_GAIN))
+    {
+        m_Gain = gain;
+        m_RangeGain = ReferenceGain(gain);
+        m_ConvGain = m_NextGain = m_LastGain = m_PrevAGain = m_RangeGain;
+    }
+    m_RequestGain = m_Gain;
+    m_Data.m_ChannelBInterval = 0U;
+    m_Data.m_OffsetValid      = 0U;
+    m_Data.m_Reserved[0]      = 0U;
+    m_Data.m_Reserved[1]      = 0U;
+    m_Data.m_RangeOffset      = 0.0f;
+    m_RequestData = m_Data;
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetGain()
+//
+// Selects the channel A gain.  Takes effect with the next Process().
+//
+// Arguments:
+//    - gain - 128, 64 or AUTO_GAIN.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if 'gain' is not valid.
+/////////////////////////////////////////////////////////////////////////////////
+bool SampleScheduler::SetGain(uint8_t gain)
+{
+    if ((gain != 128U) && (gain != 64U) && (gain != AUTO_GAIN))
+    {
+        return false;
+    }
+    portENTER_CRITICAL(&m_Mux);
+    m_RequestGain   = gain;
+    m_RequestFlags |= REQUEST_GAIN;
+    portEXIT_CRITICAL(&m_Mux);
+    return true;
+} // End SetGain().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetChannelBInterval()
+//
+// Selects how often channel B is read.  Takes effect with the next Process().
+//
+// Arguments:
+//    - interval - The number of channel A samples per channel B sample, or 0
+//                 to not read channel B.
+/////////////////////////////////////////////////////////////////////////////////
+void SampleScheduler::SetChannelBInterval(uint8_t interval)
+{
+    // After SetData(), the interval replaces the one in the requested data.
+    portENTER_CRITICAL(&m_Mux);
+    if (m_RequestFlags & REQUEST_DATA)
+    {
+        m_RequestData.m_ChannelBInterval = interval;
+    }
+    else
+    {
+        m_RequestInterval = interval;
+        m_RequestFlags   |= REQUEST_INTERVAL;
+    }
+    portEXIT_CRITICAL(&m_Mux);
+} // End SetChannelBInterval().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetData()
+//
+// Replaces the settings and learned state.  Takes effect with the next
+// Process().
+//
+// Arguments:
+//    - rData - The new data.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the offset is not a number
+//    (e.g. erased NVS).
+/////////////////////////////////////////////////////////////////////////////////
+bool SampleScheduler::SetData(const RangeData &rData)
+{
+    if (!std::isfinite(rData.m_RangeOffset))
+    {
+        return false;
+    }
+    RangeData data = rData;
+    data.m_OffsetValid = rData.m_OffsetValid ? 1U : 0U;
+    data.m_Reserved[0] = 0U;
+    data.m_Reserved[1] = 0U;
+
+    // The data replaces any interval requested before it.
+    portENTER_CRITICAL(&m_Mux);
+    m_RequestData   = data;
+    m_RequestFlags  = (m_RequestFlags & ~REQUEST_INTERVAL) | REQUEST_DATA;
+    portEXIT_CRITICAL(&m_Mux);
+    return true;
+} // End SetData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Process()
+//
+// Handles one conversion.  The conversion is discarded if it is the first at
+// its gain, if it was started before the last change of settings, or if it is
+// saturated at gain 128 in auto mode (a gain 64 conversion will follow).  Then
+// the gain of the conversion after next is chosen.
+//
+// Arguments:
+//    - raw    - The conversion just read.
+//    - rValue - Set to the sample for eSkChannelA and eSkChannelB.
+//
+// Returns:
+//    Returns what the conversion is.
+/////////////////////////////////////////////////////////////////////////////////
+SampleKind SampleScheduler::Process(int32_t raw, int32_t &rValue)
+{
+    if (m_RequestFlags != 0U)
+    {
+        ApplyRequest();
+    }
+
+    // Has this conversion settled?
+    const uint8_t gain    = m_ConvGain;
+    const bool    settled = (m_Unknown == 0U) && (gain == m_LastGain);
+    if (m_Unknown > 0U)
+    {
+        m_Unknown--;
+    }
+    m_LastGain = gain;
+
+    SampleKind kind = eSkDiscard;
+    if (settled && (gain == CHANNEL_B_GAIN))
+    {
+        rValue = raw;
+        kind = eSkChannelB;
+    }
+    else if (settled && (m_Gain == AUTO_GAIN))
+    {
+        // Change range when near the top of the gain 128 range, or well
+        // inside it at gain 64.
+        const int32_t magnitude = (raw < 0L) ? -raw : raw;
+        if ((gain == 128U) && (magnitude >= HIGH_RANGE_COUNTS))
+        {
+            m_RangeGain = 64U;
+        }
+        else if ((gain == 64U) && (magnitude <= LOW_RANGE_COUNTS))
+        {
+            m_RangeGain = 128U;
+        }
+
+        // A saturated gain 128 conversion is useless, but at gain 64 it is
+        // the best we can do.
+        if ((gain == 64U) || ((raw < MAX_COUNTS) && (raw > MIN_COUNTS)))
+        {
+            LearnOffset(raw, gain);
+            rValue = ToReference(raw, gain);
+            kind = eSkChannelA;
+        }
+    }
+    else if (settled)
+    {
+        rValue = raw;
+        kind = eSkChannelA;
+    }
+
+    if (kind == eSkChannelA)
+    {
+        if (m_ASinceB < 0xFFU)
+        {
+            m_ASinceB++;
+        }
+    }
+    else if (kind == eSkDiscard)
+    {
+        m_Discards++;
+    }
+
+    // Choose the gain of the conversion after next.  A channel B sample needs
+    // B_CONVERSIONS back to back conversions at gain 32.
+    uint8_t program = m_RangeGain;
+    if (m_BRemaining > 0U)
+    {
+        m_BRemaining--;
+        program = CHANNEL_B_GAIN;
+    }
+    else if ((m_Data.m_ChannelBInterval > 0U) &&
+             (m_ASinceB >= m_Data.m_ChannelBInterval))
+    {
+        m_BRemaining = B_CONVERSIONS - 1U;
+        m_ASinceB = 0U;
+        program = CHANNEL_B_GAIN;
+    }
+    m_ConvGain = m_NextGain;
+    m_NextGain = program;
+
+    return kind;
+} // End Process().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetChannelAShare()
+//
+// Returns the fraction of conversions that produce channel A samples.  Each
+// channel B sample costs a settling conversion at gain 32, the sample itself,
+// and a settling conversion back at channel A.  Range switches are rare enough
+// to be ignored.
+/////////////////////////////////////////////////////////////////////////////////
+double SampleScheduler::GetChannelAShare() const
+{
+    const uint8_t interval = GetData().m_ChannelBInterval;
+    if (interval == 0U)
+    {
+        return 1.0d;
+    }
+    return static_cast<double>(interval) / (interval + B_CONVERSIONS + 1U);
+} // End GetChannelAShare().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetData(), GetGain()
+//
+// Return the settings and learned state, and the channel A gain, with any
+// pending request applied.  Taken in the critical section, so a copy made
+// while Process() runs in another task is consistent.
+/////////////////////////////////////////////////////////////////////////////////
+RangeData SampleScheduler::GetData() const
+{
+    portENTER_CRITICAL(&m_Mux);
+    RangeData data = (m_RequestFlags & REQUEST_DATA) ? m_RequestData : m_Data;
+    if (m_RequestFlags & REQUEST_INTERVAL)
+    {
+        data.m_ChannelBInterval = m_RequestInterval;
+    }
+    portEXIT_CRITICAL(&m_Mux);
+    return data;
+} // End GetData().
+
+
+uint8_t SampleScheduler::GetGain() const
+{
+    portENTER_CRITICAL(&m_Mux);
+    uint8_t gain = (m_RequestFlags & REQUEST_GAIN) ? m_RequestGain : m_Gain;
+    portEXIT_CRITICAL(&m_Mux);
+    return gain;
+} // End GetGain().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ApplyRequest()
+//
+// Takes up the settings requested by the setters.  Only the requested fields
+// change, so an offset learned since the request was made is kept unless the
+// request replaces the data.  The conversion being read and the next one were
+// set up under the old settings, so they're discarded.
+/////////////////////////////////////////////////////////////////////////////////
+void SampleScheduler::ApplyRequest()
+{
+    portENTER_CRITICAL(&m_Mux);
+    if (m_RequestFlags & REQUEST_GAIN)
+    {
+        m_Gain = m_RequestGain;
+    }
+    if (m_RequestFlags & REQUEST_DATA)
+    {
+        m_Data = m_RequestData;
+    }
+    if (m_RequestFlags & REQUEST_INTERVAL)
+    {
+        m_Data.m_ChannelBInterval = m_RequestInterval;
+    }
+    m_RequestFlags = 0U;
+    portEXIT_CRITICAL(&m_Mux);
+
+    m_RangeGain    = ReferenceGain(m_Gain);
+    m_Unknown      = 2U;
+    m_BRemaining   = 0U;
+    m_ASinceB      = 0U;
+    m_HavePrevA    = false;
+    m_OffsetPending = false;
+} // End ApplyRequest().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ToReference()
+//
+// Converts an auto mode channel A conversion to gain 128 counts.
+//
+// Arguments:
+//    - raw  - The conversion.
+//    - gain - Its gain.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t SampleScheduler::ToReference(int32_t raw, uint8_t gain) const
+{
+    if (gain != 64U)
+    {
+        return raw;
+    }
+    return static_cast<int32_t>(lround(GAIN_RATIO * raw + m_Data.m_RangeOffset));
+} // End ToReference().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// LearnOffset()
+//
+// Updates the gain 64 to gain 128 offset from the channel A conversions on
+// either side of an auto mode range switch.  The estimate is only used if the
+// two conversions before the switch, and the two after it, agree to within
+// STEADY_COUNTS.  Otherwise the load was moving and the difference isn't just
+// the offset.  The first estimate is taken as is, later ones are blended in.
+//
+// Arguments:
+//    - raw  - The conversion.
+//    - gain - Its gain.
+/////////////////////////////////////////////////////////////////////////////////
+void SampleScheduler::LearnOffset(int32_t raw, uint8_t gain)
+{
+    // How much the load moved since the last sample, in gain 128 counts.
+    int32_t change = MAX_COUNTS;
+    if (m_HavePrevA && (gain == m_PrevAGain))
+    {
+        change = (raw >= m_PrevARaw) ? raw - m_PrevARaw : m_PrevARaw - raw;
+        if (gain == 64U)
+        {
+            change = static_cast<int32_t>(GAIN_RATIO * change);
+        }
+    }
+
+    // Take up the estimate from the last sample's switch if the load has
+    // stayed put since.
+    // GetData() may be copying m_Data in another task.
+    if (m_OffsetPending && (change <= STEADY_COUNTS))
+    {
+        portENTER_CRITICAL(&m_Mux);
+        if (m_Data.m_OffsetValid)
+        {
+            m_Data.m_RangeOffset += static_cast<float>(
+                OFFSET_LEARN_WEIGHT * (m_PendingOffset - m_Data.m_RangeOffset));
+        }
+        else
+        {
+            m_Data.m_RangeOffset = m_PendingOffset;
+            m_Data.m_OffsetValid = 1U;
+        }
+        portEXIT_CRITICAL(&m_Mux);
+    }
+    m_OffsetPending = false;
+
+    // Estimate the offset at a switch made under a steady load.
+    if (m_HavePrevA && (gain != m_PrevAGain) && (m_PrevAChange <= STEADY_COUNTS))
+    {
+        m_PendingOffset = static_cast<float>((gain == 64U) ?
+                                             m_PrevARaw - GAIN_RATIO * raw :
+                                             raw - GAIN_RATIO * m_PrevARaw);
+        m_OffsetPending = true;
+    }
+
+    m_PrevAChange = change;
+    m_PrevARaw    = raw;
+    m_PrevAGain   = gain;
+    m_HavePrevA   = true;
+} // End LearnOffset().
@@ -0,0 +1,250 @@
+/////////////////////////////////////////////////////////////////////////////////
+// SampleScheduler.h
+//
+// This class implements the SampleScheduler class.  It decides the gain (and so
+// the HX711 channel) of each conversion, and what to do with each conversion
+// read:
+//    - Auto-ranging.  With AUTO_GAIN, channel A is read at gain 128 until a
+//      reading nears saturation (HIGH_RANGE_COUNTS), then at gain 64 until the
+//      reading falls back below LOW_RANGE_COUNTS (the hysteresis keeps it from
+//      hunting).  Gain 64 readings are mapped to gain 128 counts, so tare and
+//      calibration are unaffected by the switches:
+//          counts128 = GAIN_RATIO * counts64 + m_RangeOffset
+//      The offset (the two gains have different zero errors) is learned at
+//      each switch made while the load is steady on both sides of it.
+//    - Channel B.  With a non-zero channel B interval, one channel B (gain 32)
+//      conversion is taken after each m_ChannelBInterval channel A samples, so
+//      that a second load cell can be read by the same HX711.
+//
+// The gain pulses sent after reading a conversion select the gain of the
+// following conversion, so a decision made when conversion N is read takes
+// effect with conversion N + 2.  The scheduler tracks the gain of each
+// conversion in flight, so the conversion after the switch is still used.  The
+// first conversion at a new gain has not settled, so it is discarded.  Reading
+// one channel B sample therefore costs three channel A samples, which
+// GetChannelAShare() accounts for.
+//
+// Process() is called by the acquisition task for each conversion.  The other
+// setters may be called from another task: the change is picked up by the next
+// Process(), and the conversions already in flight are then discarded.  The
+// requests, and the state they and GetData() share with Process(), are guarded
+// by a critical section, and a request only carries the fields it changes, so
+// an offset learned meanwhile isn't lost.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined SAMPLESCHEDULER_H
+#define SAMPLESCHEDULER_H
+
+#include <cstdint>              // For uint8_t, ...
+#include <freertos/FreeRTOS.h>  // For portMUX_TYPE.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SampleKind
+//
+// What Process() made of a conversion.
+/////////////////////////////////////////////////////////////////////////////////
+enum SampleKind
+{
+    eSkDiscard  = 0,            // Not settled (or saturated), ignore it.
+    eSkChannelA = 1,            // A channel A sample, in reference gain counts.
+    eSkChannelB = 2             // A raw channel B sample.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RangeData structure
+//
+// The settings and learned state that may be saved to NVS as is.
+/////////////////////////////////////////////////////////////////////////////////
+struct RangeData
+{
+    uint8_t m_ChannelBInterval;         // A samples per B sample, 0 for no B.
+    uint8_t m_OffsetValid;              // m_RangeOffset has been learned.
+    uint8_t m_Reserved[2];              // Explicit padding, always 0.
+    float   m_RangeOffset;              // Gain 64 to gain 128 zero offset.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SampleScheduler class
+/////////////////////////////////////////////////////////////////////////////////
+class SampleScheduler
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - gain - The channel A gain: 128, 64 or AUTO_GAIN.
+    /////////////////////////////////////////////////////////////////////////////
+    SampleScheduler(uint8_t gain);
+
+
+    // Destructor.
+    virtual ~SampleScheduler() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetGain()
+    //
+    // Selects the channel A gain.
+    //
+    // Arguments:
+    //    - gain - 128, 64 or AUTO_GAIN.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if 'gain' is not valid.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetGain(uint8_t gain);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetChannelBInterval()
+    //
+    // Selects how often channel B is read.
+    //
+    // Arguments:
+    //    - interval - The number of channel A samples per channel B sample, or
+    //                 0 to not read channel B.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetChannelBInterval(uint8_t interval);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetData()
+    //
+    // Replaces the settings and learned state (e.g. with data restored from
+    // NVS).
+    //
+    // Arguments:
+    //    - rData - The new data.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if the data is not valid.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetData(const RangeData &rData);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Process()
+    //
+    // Handles one conversion.  Afterwards, GetProgramGain() must be passed to
+    // the transport before the next conversion is read.
+    //
+    // Arguments:
+    //    - raw    - The conversion just read.
+    //    - rValue - Set to the sample for eSkChannelA and eSkChannelB.
+    //
+    // Returns:
+    //    Returns what the conversion is.
+    /////////////////////////////////////////////////////////////////////////////
+    SampleKind Process(int32_t raw, int32_t &rValue);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetChannelAShare()
+    //
+    // Returns the fraction of conversions that produce channel A samples,
+    // allowing for the conversions lost to channel B.
+    /////////////////////////////////////////////////////////////////////////////
+    double GetChannelAShare() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // GetData(), GetGain()
+    //
+    // Return the settings and learned state, and the channel A gain, including
+    // any changes requested but not yet taken up.
+    /////////////////////////////////////////////////////////////////////////////
+    RangeData GetData() const;
+    uint8_t   GetGain() const;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    uint8_t  GetProgramGain()       const { return m_NextGain; }
+    uint8_t  GetRangeGain()         const { return m_RangeGain; }
+    uint8_t  GetReferenceGain()     const { return ReferenceGain(GetGain()); }
+    uint32_t GetDiscards()          const { return m_Discards; }
+    static uint8_t ReferenceGain(uint8_t gain)
+        { return gain == AUTO_GAIN ? 128U : gain; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint8_t  AUTO_GAIN         = 0U;
+    static const uint8_t  CHANNEL_B_GAIN    = 32U;
+    static const int32_t  MAX_COUNTS        = 0x7FFFFFL;
+    static const int32_t  MIN_COUNTS        = -0x800000L;
+    static const int32_t  HIGH_RANGE_COUNTS = 7549747L;    // 90% of full scale.
+    static const int32_t  LOW_RANGE_COUNTS  = 3355443L;    // 40% (80% at 128).
+    static const int32_t  STEADY_COUNTS     = 1024L;       // For offset learning.
+    static const uint8_t  B_CONVERSIONS     = 2U;          // Settle + sample.
+    static const double   GAIN_RATIO;
+    static const double   OFFSET_LEARN_WEIGHT;
+
+private:
+    // m_RequestFlags bits: the fields a request changes.
+    static const uint8_t  REQUEST_GAIN      = 0x01U;
+    static const uint8_t  REQUEST_INTERVAL  = 0x02U;
+    static const uint8_t  REQUEST_DATA      = 0x04U;
+
+    // Unimplemented methods.  We don't want users to try to use these.
+    SampleScheduler();
+    SampleScheduler(SampleScheduler &rSs);
+    SampleScheduler &operator=(SampleScheduler &rSs);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Helpers.  See SampleScheduler.cpp for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    void    ApplyRequest();
+    int32_t ToReference(int32_t raw, uint8_t gain) const;
+    void    LearnOffset(int32_t raw, uint8_t gain);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    RangeData m_Data;                   // Saved settings and state.
+    uint8_t  m_Gain;                    // Channel A gain or AUTO_GAIN.
+    uint8_t  m_RangeGain;               // Gain currently used for channel A.
+
+    // Requests from other tasks, applied by Process().
+    mutable portMUX_TYPE m_Mux;         // Guards the requests and m_Data.
+    volatile uint8_t m_RequestFlags;    // REQUEST_... fields waiting, or 0.
+    uint8_t  m_RequestGain;             // Requested m_Gain.
+    uint8_t  m_RequestInterval;         // Requested channel B interval.
+    RangeData m_RequestData;            // Requested m_Data.
+
+    // Conversion pipeline.
+    uint8_t  m_ConvGain;                // Gain of the conversion being read.
+    uint8_t  m_NextGain;                // Gain of the one after it.
+    uint8_t  m_LastGain;                // Gain of the previous conversion.
+    uint8_t  m_Unknown;                 // Conversions of unknown gain.
+    uint8_t  m_BRemaining;              // Channel B conversions to schedule.
+    uint8_t  m_ASinceB;                 // Channel A samples since channel B.
+    uint32_t m_Discards;                // Conversions discarded.
+
+    // The last two channel A samples, for offset learning.
+    bool     m_HavePrevA;               // m_PrevA... are valid.
+    uint8_t  m_PrevAGain;               // Gain of the last sample.
+    int32_t  m_PrevARaw;                // Raw value of the last sample.
+    int32_t  m_PrevAChange;             // Change from the one before, or
+                                        //   MAX_COUNTS if unknown.
+    bool     m_OffsetPending;           // m_PendingOffset awaits a steady load.
+    float    m_PendingOffset;           // Estimate from the last range switch.
+
+}; // End class SampleScheduler.
+
+
+
+#endif // SAMPLESCHEDULER_H
@@ -1,129 +1,129 @@
-/////////////////////////////////////////////////////////////////////////////////
-// ScaleIcon.cpp
-//
-// Contains the array that has  the bit pattern for the welcome screen scale
-// icon.
-//
-// History:
-// - jmcorbett 14-JUN-2021 Original creation.
-//
-// Copyright (c) 2021, Joseph M. Corbett
-/////////////////////////////////////////////////////////////////////////////////
-#include "ScaleIcon.h"
-
-const unsigned char ScaleIcon[] = {
-	// 'Scale3, 120x120px
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x7e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0, 0x00, 0x00, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0xff, 0xc0, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0xc0, 0x00, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x03, 0xfe,
-	0x00, 0x00, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x03, 0xfe, 0x00,
-	0x00, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00,
-	0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x00,
-	0x00, 0xff, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x07, 0xff, 0x00, 0x00, 0x00, 0x00,
-	0xff, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x07, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff,
-	0xf0, 0x00, 0x00, 0x07, 0xff, 0xe0, 0x00, 0x00, 0x0f, 0xff, 0x00, 0x00, 0x00, 0x01, 0xff, 0xf0,
-	0x00, 0x00, 0x07, 0xff, 0xe0, 0x00, 0x00, 0x0f, 0xff, 0x80, 0x00, 0x00, 0x01, 0xff, 0xf0, 0x00,
-	0x00, 0x07, 0xff, 0xe0, 0x00, 0x00, 0x0f, 0xff, 0x80, 0x00, 0x00, 0x01, 0xff, 0xf8, 0x00, 0x00,
-	0x07, 0xff, 0xe0, 0x00, 0x00, 0x1f, 0xff, 0x80, 0x00, 0x00, 0x03, 0xff, 0xf8, 0x00, 0x00, 0x07,
-	0xff, 0xe0, 0x00, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x00, 0x03, 0xff, 0xf8, 0x00, 0x00, 0x07, 0xff,
-	0xe0, 0x00, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x00, 0x03, 0xff, 0xfc, 0x00, 0x00, 0x03, 0xff, 0xc0,
-	0x00, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x00, 0x07, 0xff, 0x7c, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00,
-	0x00, 0x3e, 0xfb, 0xe0, 0x00, 0x00, 0x07, 0xdf, 0x7c, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00,
-	0x3e, 0xfb, 0xe0, 0x00, 0x00, 0x07, 0xdf, 0x7e, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x7e,
-	0xfb, 0xe0, 0x00, 0x00, 0x0f, 0x9f, 0x3e, 0x00, 0x00, 0x00, 0xff, 0x80, 0x00, 0x00, 0x7c, 0xf9,
-	0xf0, 0x00, 0x00, 0x0f, 0x9f, 0x3e, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0x7c, 0xf9, 0xf0,
-	0x00, 0x00, 0x0f, 0x9f, 0x3f, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0xfc, 0xf9, 0xf0, 0x00,
-	0x00, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0xf8, 0xf8, 0xf8, 0x00, 0x00,
-	0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0xf8, 0xf8, 0xf8, 0x00, 0x00, 0x1f,
-	0x1f, 0x0f, 0x80, 0x00, 0x01, 0xff, 0x80, 0x00, 0x01, 0xf8, 0xf8, 0xf8, 0x00, 0x00, 0x3e, 0x1f,
-	0x0f, 0x80, 0x00, 0x01, 0xff, 0x80, 0x00, 0x01, 0xf0, 0xf8, 0x7c, 0x00, 0x00, 0x3e, 0x1f, 0x0f,
-	0x80, 0x00, 0x01, 0xff, 0x80, 0x00, 0x01, 0xf0, 0xf8, 0x7c, 0x00, 0x00, 0x3e, 0x1f, 0x07, 0xc0,
-	0x00, 0x01, 0xff, 0x80, 0x00, 0x03, 0xf0, 0xf8, 0x7c, 0x00, 0x00, 0x7c, 0x1f, 0x07, 0xc0, 0x00,
-	0x01, 0xff, 0x80, 0x00, 0x03, 0xe0, 0xf8, 0x3e, 0x00, 0x00, 0x7c, 0x1f, 0x07, 0xc0, 0x00, 0x01,
-	0xff, 0x80, 0x00, 0x03, 0xe0, 0xf8, 0x3e, 0x00, 0x00, 0xfc, 0x1f, 0x07, 0xe0, 0x00, 0x01, 0xff,
-	0x80, 0x00, 0x07, 0xe0, 0xf8, 0x3f, 0x00, 0x00, 0xf8, 0x1f, 0x03, 0xe0, 0x00, 0x01, 0xff, 0x80,
-	0x00, 0x07, 0xc0, 0xf8, 0x1f, 0x00, 0x00, 0xf8, 0x1f, 0x03, 0xe0, 0x00, 0x01, 0xff, 0x80, 0x00,
-	0x07, 0xc0, 0xf8, 0x1f, 0x00, 0x01, 0xf8, 0x1f, 0x01, 0xf0, 0x00, 0x01, 0xff, 0x80, 0x00, 0x0f,
-	0x80, 0xf8, 0x1f, 0x80, 0x01, 0xf0, 0x1f, 0x01, 0xf0, 0x00, 0x01, 0xff, 0x80, 0x00, 0x0f, 0x80,
-	0xf8, 0x0f, 0x80, 0x01, 0xf0, 0x1f, 0x01, 0xf8, 0x00, 0x01, 0xff, 0x80, 0x00, 0x0f, 0x80, 0xf8,
-	0x0f, 0x80, 0x03, 0xf0, 0x1f, 0x00, 0xf8, 0x00, 0x01, 0xff, 0x80, 0x00, 0x1f, 0x00, 0xf8, 0x0f,
-	0xc0, 0x03, 0xe0, 0x1f, 0x00, 0xf8, 0x00, 0x01, 0xff, 0x80, 0x00, 0x1f, 0x00, 0xf8, 0x07, 0xc0,
-	0x03, 0xe0, 0x1f, 0x00, 0xfc, 0x00, 0x01, 0xff, 0x80, 0x00, 0x1f, 0x00, 0xf8, 0x07, 0xc0, 0x07,
-	0xe0, 0x1f, 0x00, 0x7c, 0x00, 0x01, 0xff, 0x80, 0x00, 0x3e, 0x00, 0xf8, 0x07, 0xe0, 0x07, 0xc0,
-	0x1f, 0x00, 0x7c, 0x00, 0x01, 0xff, 0x80, 0x00, 0x3e, 0x00, 0xf8, 0x03, 0xe0, 0x07, 0xc0, 0x1f,
-	0x00, 0x7e, 0x00, 0x01, 0xff, 0x80, 0x00, 0x3e, 0x00, 0xf8, 0x03, 0xe0, 0x0f, 0xc0, 0x1f, 0x00,
-	0x3e, 0x00, 0x01, 0xff, 0x80, 0x00, 0x7c, 0x00, 0xf8, 0x03, 0xf0, 0x0f, 0x80, 0x1f, 0x00, 0x3e,
-	0x00, 0x01, 0xff, 0x80, 0x00, 0x7c, 0x00, 0xf8, 0x01, 0xf0, 0x0f, 0x80, 0x1f, 0x00, 0x3f, 0x00,
-	0x01, 0xff, 0x80, 0x00, 0xfc, 0x00, 0xf8, 0x01, 0xf0, 0x1f, 0x80, 0x1f, 0x00, 0x1f, 0x00, 0x01,
-	0xff, 0x80, 0x00, 0xf8, 0x00, 0xf8, 0x01, 0xf8, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x01, 0xff,
-	0x80, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x80, 0x01, 0xff, 0x80,
-	0x01, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x3f, 0x00, 0x1f, 0x00, 0x0f, 0x80, 0x01, 0xff, 0x80, 0x01,
-	0xf0, 0x00, 0xf8, 0x00, 0xfc, 0x3e, 0x00, 0x1f, 0x00, 0x0f, 0x80, 0x01, 0xff, 0x80, 0x01, 0xf0,
-	0x00, 0xf8, 0x00, 0x7c, 0x3e, 0x00, 0x1f, 0x00, 0x0f, 0xc0, 0x01, 0xff, 0x80, 0x03, 0xf0, 0x00,
-	0xf8, 0x00, 0x7c, 0x7e, 0x00, 0x1f, 0x00, 0x07, 0xc0, 0x01, 0xff, 0x80, 0x03, 0xe0, 0x00, 0xf8,
-	0x00, 0x7e, 0x7c, 0x00, 0x1f, 0x00, 0x07, 0xc0, 0x01, 0xff, 0x80, 0x03, 0xe0, 0x00, 0xf8, 0x00,
-	0x3e, 0x7c, 0x00, 0x1f, 0x00, 0x07, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xe0, 0x00, 0xf8, 0x00, 0x3e,
-	0xf8, 0x00, 0x1f, 0x00, 0x03, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xc0, 0x00, 0xf8, 0x00, 0x1f, 0xff,
-	0xff, 0xff, 0xff, 0xff, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0xff, 0xff, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 0xff,
-	0xff, 0xff, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x7f, 0xff, 0xff, 0xff,
-	0xff, 0xc0, 0x01, 0xff, 0x80, 0x03, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x3f, 0xff, 0xff, 0xff, 0xff,
-	0xc0, 0x01, 0xff, 0x80, 0x03, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x3f, 0xff, 0xff, 0xff, 0xff, 0x80,
-	0x01, 0xff, 0xc0, 0x01, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x1f, 0xff, 0xff, 0xff, 0xff, 0x00, 0x03,
-	0xff, 0xc0, 0x00, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xff, 0xfe, 0x00, 0x03, 0xff,
-	0xc0, 0x00, 0x7f, 0xff, 0xff, 0xff, 0xf0, 0x03, 0xff, 0xff, 0xff, 0xf8, 0x00, 0x03, 0xff, 0xc0,
-	0x00, 0x1f, 0xff, 0xff, 0xff, 0xc0, 0x00, 0xff, 0xff, 0xff, 0xf0, 0x00, 0x03, 0xff, 0xc0, 0x00,
-	0x0f, 0xff, 0xff, 0xff, 0x80, 0x00, 0x3f, 0xff, 0xff, 0x80, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x01,
-	0xff, 0xff, 0xfc, 0x00, 0x00, 0x01, 0xff, 0xf0, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x0f,
-	0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
-	0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff,
-	0xff, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
-	0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff,
-	0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+/////////////////////////////////////////////////////////////////////////////////
+// ScaleIcon.cpp
+//
+// Contains the array that has  the bit pattern for the welcome screen scale
+// icon.
+//
+// History:
+// - jmcorbett 14-JUN-2021 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#include "ScaleIcon.h"
+
+const unsigned char ScaleIcon[] = {
+	// 'Scale3, 120x120px
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x7e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0, 0x00, 0x00, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xc0, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xc0, 0x00, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x03, 0xfe,
+	0x00, 0x00, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x03, 0xfe, 0x00,
+	0x00, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00,
+	0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x00,
+	0x00, 0xff, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x07, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x07, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff,
+	0xf0, 0x00, 0x00, 0x07, 0xff, 0xe0, 0x00, 0x00, 0x0f, 0xff, 0x00, 0x00, 0x00, 0x01, 0xff, 0xf0,
+	0x00, 0x00, 0x07, 0xff, 0xe0, 0x00, 0x00, 0x0f, 0xff, 0x80, 0x00, 0x00, 0x01, 0xff, 0xf0, 0x00,
+	0x00, 0x07, 0xff, 0xe0, 0x00, 0x00, 0x0f, 0xff, 0x80, 0x00, 0x00, 0x01, 0xff, 0xf8, 0x00, 0x00,
+	0x07, 0xff, 0xe0, 0x00, 0x00, 0x1f, 0xff, 0x80, 0x00, 0x00, 0x03, 0xff, 0xf8, 0x00, 0x00, 0x07,
+	0xff, 0xe0, 0x00, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x00, 0x03, 0xff, 0xf8, 0x00, 0x00, 0x07, 0xff,
+	0xe0, 0x00, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x00, 0x03, 0xff, 0xfc, 0x00, 0x00, 0x03, 0xff, 0xc0,
+	0x00, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x00, 0x07, 0xff, 0x7c, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00,
+	0x00, 0x3e, 0xfb, 0xe0, 0x00, 0x00, 0x07, 0xdf, 0x7c, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00,
+	0x3e, 0xfb, 0xe0, 0x00, 0x00, 0x07, 0xdf, 0x7e, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x7e,
+	0xfb, 0xe0, 0x00, 0x00, 0x0f, 0x9f, 0x3e, 0x00, 0x00, 0x00, 0xff, 0x80, 0x00, 0x00, 0x7c, 0xf9,
+	0xf0, 0x00, 0x00, 0x0f, 0x9f, 0x3e, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0x7c, 0xf9, 0xf0,
+	0x00, 0x00, 0x0f, 0x9f, 0x3f, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0xfc, 0xf9, 0xf0, 0x00,
+	0x00, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0xf8, 0xf8, 0xf8, 0x00, 0x00,
+	0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x01, 0xff, 0x80, 0x00, 0x00, 0xf8, 0xf8, 0xf8, 0x00, 0x00, 0x1f,
+	0x1f, 0x0f, 0x80, 0x00, 0x01, 0xff, 0x80, 0x00, 0x01, 0xf8, 0xf8, 0xf8, 0x00, 0x00, 0x3e, 0x1f,
+	0x0f, 0x80, 0x00, 0x01, 0xff, 0x80, 0x00, 0x01, 0xf0, 0xf8, 0x7c, 0x00, 0x00, 0x3e, 0x1f, 0x0f,
+	0x80, 0x00, 0x01, 0xff, 0x80, 0x00, 0x01, 0xf0, 0xf8, 0x7c, 0x00, 0x00, 0x3e, 0x1f, 0x07, 0xc0,
+	0x00, 0x01, 0xff, 0x80, 0x00, 0x03, 0xf0, 0xf8, 0x7c, 0x00, 0x00, 0x7c, 0x1f, 0x07, 0xc0, 0x00,
+	0x01, 0xff, 0x80, 0x00, 0x03, 0xe0, 0xf8, 0x3e, 0x00, 0x00, 0x7c, 0x1f, 0x07, 0xc0, 0x00, 0x01,
+	0xff, 0x80, 0x00, 0x03, 0xe0, 0xf8, 0x3e, 0x00, 0x00, 0xfc, 0x1f, 0x07, 0xe0, 0x00, 0x01, 0xff,
+	0x80, 0x00, 0x07, 0xe0, 0xf8, 0x3f, 0x00, 0x00, 0xf8, 0x1f, 0x03, 0xe0, 0x00, 0x01, 0xff, 0x80,
+	0x00, 0x07, 0xc0, 0xf8, 0x1f, 0x00, 0x00, 0xf8, 0x1f, 0x03, 0xe0, 0x00, 0x01, 0xff, 0x80, 0x00,
+	0x07, 0xc0, 0xf8, 0x1f, 0x00, 0x01, 0xf8, 0x1f, 0x01, 0xf0, 0x00, 0x01, 0xff, 0x80, 0x00, 0x0f,
+	0x80, 0xf8, 0x1f, 0x80, 0x01, 0xf0, 0x1f, 0x01, 0xf0, 0x00, 0x01, 0xff, 0x80, 0x00, 0x0f, 0x80,
+	0xf8, 0x0f, 0x80, 0x01, 0xf0, 0x1f, 0x01, 0xf8, 0x00, 0x01, 0xff, 0x80, 0x00, 0x0f, 0x80, 0xf8,
+	0x0f, 0x80, 0x03, 0xf0, 0x1f, 0x00, 0xf8, 0x00, 0x01, 0xff, 0x80, 0x00, 0x1f, 0x00, 0xf8, 0x0f,
+	0xc0, 0x03, 0xe0, 0x1f, 0x00, 0xf8, 0x00, 0x01, 0xff, 0x80, 0x00, 0x1f, 0x00, 0xf8, 0x07, 0xc0,
+	0x03, 0xe0, 0x1f, 0x00, 0xfc, 0x00, 0x01, 0xff, 0x80, 0x00, 0x1f, 0x00, 0xf8, 0x07, 0xc0, 0x07,
+	0xe0, 0x1f, 0x00, 0x7c, 0x00, 0x01, 0xff, 0x80, 0x00, 0x3e, 0x00, 0xf8, 0x07, 0xe0, 0x07, 0xc0,
+	0x1f, 0x00, 0x7c, 0x00, 0x01, 0xff, 0x80, 0x00, 0x3e, 0x00, 0xf8, 0x03, 0xe0, 0x07, 0xc0, 0x1f,
+	0x00, 0x7e, 0x00, 0x01, 0xff, 0x80, 0x00, 0x3e, 0x00, 0xf8, 0x03, 0xe0, 0x0f, 0xc0, 0x1f, 0x00,
+	0x3e, 0x00, 0x01, 0xff, 0x80, 0x00, 0x7c, 0x00, 0xf8, 0x03, 0xf0, 0x0f, 0x80, 0x1f, 0x00, 0x3e,
+	0x00, 0x01, 0xff, 0x80, 0x00, 0x7c, 0x00, 0xf8, 0x01, 0xf0, 0x0f, 0x80, 0x1f, 0x00, 0x3f, 0x00,
+	0x01, 0xff, 0x80, 0x00, 0xfc, 0x00, 0xf8, 0x01, 0xf0, 0x1f, 0x80, 0x1f, 0x00, 0x1f, 0x00, 0x01,
+	0xff, 0x80, 0x00, 0xf8, 0x00, 0xf8, 0x01, 0xf8, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x01, 0xff,
+	0x80, 0x00, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x80, 0x01, 0xff, 0x80,
+	0x01, 0xf8, 0x00, 0xf8, 0x00, 0xf8, 0x3f, 0x00, 0x1f, 0x00, 0x0f, 0x80, 0x01, 0xff, 0x80, 0x01,
+	0xf0, 0x00, 0xf8, 0x00, 0xfc, 0x3e, 0x00, 0x1f, 0x00, 0x0f, 0x80, 0x01, 0xff, 0x80, 0x01, 0xf0,
+	0x00, 0xf8, 0x00, 0x7c, 0x3e, 0x00, 0x1f, 0x00, 0x0f, 0xc0, 0x01, 0xff, 0x80, 0x03, 0xf0, 0x00,
+	0xf8, 0x00, 0x7c, 0x7e, 0x00, 0x1f, 0x00, 0x07, 0xc0, 0x01, 0xff, 0x80, 0x03, 0xe0, 0x00, 0xf8,
+	0x00, 0x7e, 0x7c, 0x00, 0x1f, 0x00, 0x07, 0xc0, 0x01, 0xff, 0x80, 0x03, 0xe0, 0x00, 0xf8, 0x00,
+	0x3e, 0x7c, 0x00, 0x1f, 0x00, 0x07, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xe0, 0x00, 0xf8, 0x00, 0x3e,
+	0xf8, 0x00, 0x1f, 0x00, 0x03, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xc0, 0x00, 0xf8, 0x00, 0x1f, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 0xff,
+	0xff, 0xff, 0xe0, 0x01, 0xff, 0x80, 0x07, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x7f, 0xff, 0xff, 0xff,
+	0xff, 0xc0, 0x01, 0xff, 0x80, 0x03, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x3f, 0xff, 0xff, 0xff, 0xff,
+	0xc0, 0x01, 0xff, 0x80, 0x03, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x3f, 0xff, 0xff, 0xff, 0xff, 0x80,
+	0x01, 0xff, 0xc0, 0x01, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x1f, 0xff, 0xff, 0xff, 0xff, 0x00, 0x03,
+	0xff, 0xc0, 0x00, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xff, 0xfe, 0x00, 0x03, 0xff,
+	0xc0, 0x00, 0x7f, 0xff, 0xff, 0xff, 0xf0, 0x03, 0xff, 0xff, 0xff, 0xf8, 0x00, 0x03, 0xff, 0xc0,
+	0x00, 0x1f, 0xff, 0xff, 0xff, 0xc0, 0x00, 0xff, 0xff, 0xff, 0xf0, 0x00, 0x03, 0xff, 0xc0, 0x00,
+	0x0f, 0xff, 0xff, 0xff, 0x80, 0x00, 0x3f, 0xff, 0xff, 0x80, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x01,
+	0xff, 0xff, 0xfc, 0x00, 0x00, 0x01, 0xff, 0xf0, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x0f,
+	0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+	0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff,
+	0xff, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
\ No newline at end of file
@@ -1,20 +1,20 @@
-/////////////////////////////////////////////////////////////////////////////////
-// ScaleIcon.h
-//
-// This file contains a declaration for the array that contains the bit pattern
-// for the welcome screen scale icon.
-//
-// History:
-// - jmcorbett 14-JUN-2021 Original creation.
-//
-// Copyright (c) 2021, Joseph M. Corbett
-/////////////////////////////////////////////////////////////////////////////////
-
-#if !defined SCALEICON_H
-#define SCALEICON_H
-
-
-extern const unsigned char ScaleIcon[];
-
-
-#endif // SCALEICON_H
+/////////////////////////////////////////////////////////////////////////////////
+// ScaleIcon.h
+//
+// This file contains a declaration for the array that contains the bit pattern
+// for the welcome screen scale icon.
+//
+// History:
+// - jmcorbett 14-JUN-2021 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#if !defined SCALEICON_H
+#define SCALEICON_H
+
+
+extern const unsigned char ScaleIcon[];
+
+
+#endif // SCALEICON_H
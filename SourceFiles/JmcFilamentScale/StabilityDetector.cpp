@@ -0,0 +1,135 @@
+/////////////////////////////////////////////////////////////////////////////////
+// StabilityDetector.cpp
+//
+// Contains methods defined by the StabilityDetector class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "StabilityDetector.h"  // For StabilityDetector class.
+#include <cmath>                // For sqrt(), fabs().
+
+
+const double StabilityDetector::DEFAULT_STABLE_GRAMS = 0.5d;
+const double StabilityDetector::DEFAULT_CHANGE_GRAMS = 2.0d;
+const double StabilityDetector::UNSTABLE_FACTOR      = 3.0d;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Arguments:
+//    - stableGrams - The reading is stable once the standard deviation of the
+//                    window falls to this value or below.
+//    - changeGrams - A reading farther than this from the stable weight starts
+//                    settling.
+/////////////////////////////////////////////////////////////////////////////////
+StabilityDetector::StabilityDetector(double stableGrams, double changeGrams) :
+    m_StableGrams(stableGrams), m_ChangeGrams(changeGrams), m_NumValues(0U),
+    m_Next(0U), m_State(eSsSettling), m_StdDev(0.0d), m_StableWeight(0.0d),
+    m_HaveStableWeight(false), m_LoadChangeCount(0UL), m_pCallback(NULL),
+    m_pCallbackArg(NULL)
+{
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Update()
+//
+// Adds a reading to the window, updates the state, and raises any events.
+//
+// Arguments:
+//    - weightGrams - The latest weight reading, in grams.
+//
+// Returns:
+//    Returns the (possibly) new state.
+/////////////////////////////////////////////////////////////////////////////////
+StabilityState StabilityDetector::Update(double weightGrams)
+{
+    // Add the reading to the window.
+    m_Values[m_Next] = weightGrams;
+    if (++m_Next >= WINDOW_SIZE)
+    {
+        m_Next = 0U;
+    }
+    if (m_NumValues < WINDOW_SIZE)
+    {
+        m_NumValues++;
+    }
+
+    // The window is tiny, so simply recalculate the mean and deviation.
+    double sum = 0.0d;
+    for (size_t i = 0U; i < m_NumValues; i++)
+    {
+        sum += m_Values[i];
+    }
+    double mean = sum / m_NumValues;
+    double sumSquares = 0.0d;
+    for (size_t i = 0U; i < m_NumValues; i++)
+    {
+        double diff = m_Values[i] - mean;
+        sumSquares += diff * diff;
+    }
+    m_StdDev = sqrt(sumSquares / m_NumValues);
+
+    if (m_State == eSsStable)
+    {
+        // Any real change in weight, or too much noise, and we're settling.
+        if ((fabs(weightGrams - m_StableWeight) > m_ChangeGrams) ||
+            (m_StdDev > m_StableGrams * UNSTABLE_FACTOR))
+        {
+            m_State = eSsSettling;
+            RaiseEvent(eSeSettling, weightGrams);
+        }
+    }
+    else if ((m_NumValues == WINDOW_SIZE) && (m_StdDev <= m_StableGrams))
+    {
+        // The whole window agrees.  See if this is a new load.
+        bool changed = !m_HaveStableWeight ||
+                       (fabs(mean - m_StableWeight) > m_ChangeGrams);
+        m_State            = eSsStable;
+        m_StableWeight     = mean;
+        m_HaveStableWeight = true;
+        RaiseEvent(eSeStable, mean);
+        if (changed)
+        {
+            m_LoadChangeCount++;
+            RaiseEvent(eSeLoadChanged, mean);
+        }
+    }
+
+    return m_State;
+} // End Update().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Empties the window and returns to the settling state without raising an
+// event.  The last stable weight is forgotten.
+/////////////////////////////////////////////////////////////////////////////////
+void StabilityDetector::Reset()
+{
+    m_NumValues        = 0U;
+    m_Next             = 0U;
+    m_State            = eSsSettling;
+    m_StdDev           = 0.0d;
+    m_HaveStableWeight = false;
+} // End Reset().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// RaiseEvent()
+//
+// Calls the callback (if any) for the given event.
+/////////////////////////////////////////////////////////////////////////////////
+void StabilityDetector::RaiseEvent(StabilityEvent event, double weightGrams)
+{
+    if (m_pCallback != NULL)
+    {
+        m_pCallback(event, weightGrams, m_pCallbackArg);
+    }
+} // End RaiseEvent().
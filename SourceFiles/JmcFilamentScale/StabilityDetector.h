@@ -0,0 +1,171 @@
+/////////////////////////////////////////////////////////////////////////////////
+// StabilityDetector.h
+//
+// This class implements the StabilityDetector class.  It watches the stream of
+// weight readings produced by the LoadCell and decides whether or not the
+// reading has converged.  The standard deviation of the last WINDOW_SIZE
+// readings is tracked, and the following events are raised through an
+// optional callback:
+//    - eSeSettling    - The weight has started to change.
+//    - eSeStable      - The weight has converged.
+//    - eSeLoadChanged - The weight converged at a value different from the
+//                       previous stable weight.  Raised right after eSeStable.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined STABILITYDETECTOR_H
+#define STABILITYDETECTOR_H
+
+#include <cstddef>              // For size_t.
+#include <cstdint>              // For uint32_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Stability states and events.
+/////////////////////////////////////////////////////////////////////////////////
+enum StabilityState
+{
+    eSsSettling = 0,        // Weight has not converged.
+    eSsStable   = 1         // Weight has converged.
+};
+
+enum StabilityEvent
+{
+    eSeSettling    = 0,     // Stable -> settling.
+    eSeStable      = 1,     // Settling -> stable.
+    eSeLoadChanged = 2      // Stable at a new weight.
+};
+
+// Event callback.  'weightGrams' is the stable weight for eSeStable and
+// eSeLoadChanged, or the latest reading for eSeSettling.
+typedef void (*StabilityCallback)(StabilityEvent event, double weightGrams,
+                                  void *pArg);
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// StabilityDetector class
+/////////////////////////////////////////////////////////////////////////////////
+class StabilityDetector
+{
+public:
+    /////////////////////////////////////////////////////////////////////////////
+    // Constructor.
+    //
+    // Arguments:
+    //    - stableGrams - The reading is stable once the standard deviation of
+    //                    the window falls to this value or below.
+    //    - changeGrams - A reading farther than this from the stable weight
+    //                    starts settling.  Also the minimum difference between
+    //                    stable weights that raises eSeLoadChanged.
+    /////////////////////////////////////////////////////////////////////////////
+    StabilityDetector(double stableGrams = DEFAULT_STABLE_GRAMS,
+                      double changeGrams = DEFAULT_CHANGE_GRAMS);
+
+
+    // Destructor.
+    virtual ~StabilityDetector() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetCallback()
+    //
+    // Sets the function to be called for each event.
+    //
+    // Arguments:
+    //    - pCallback - The function to call, or NULL for none.
+    //    - pArg      - Passed unchanged to the callback.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetCallback(StabilityCallback pCallback, void *pArg = NULL)
+    {
+        m_pCallback = pCallback;
+        m_pCallbackArg = pArg;
+    } // End SetCallback().
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Update()
+    //
+    // Adds a reading to the window, updates the state, and raises any events.
+    //
+    // Arguments:
+    //    - weightGrams - The latest weight reading, in grams.
+    //
+    // Returns:
+    //    Returns the (possibly) new state.
+    /////////////////////////////////////////////////////////////////////////////
+    StabilityState Update(double weightGrams);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // Empties the window and returns to the settling state without raising an
+    // event.  The last stable weight is forgotten.
+    /////////////////////////////////////////////////////////////////////////////
+    void Reset();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    StabilityState GetState()        const { return m_State; }
+    bool     IsStable()              const { return m_State == eSsStable; }
+    double   GetStableWeight()       const { return m_StableWeight; }
+    double   GetStdDev()             const { return m_StdDev; }
+    uint32_t GetLoadChangeCount()    const { return m_LoadChangeCount; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const size_t WINDOW_SIZE = 5U;   // Readings (1 sec at 200 mSec).
+    static const double DEFAULT_STABLE_GRAMS;
+    static const double DEFAULT_CHANGE_GRAMS;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    StabilityDetector(StabilityDetector &rSd);
+    StabilityDetector &operator=(StabilityDetector &rSd);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // RaiseEvent()
+    //
+    // Calls the callback (if any) for the given event.
+    /////////////////////////////////////////////////////////////////////////////
+    void RaiseEvent(StabilityEvent event, double weightGrams);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Private constants.
+    /////////////////////////////////////////////////////////////////////////////
+    // Leave the stable state only when the noise grows well past the level
+    // that got us there, so that a reading near the limit doesn't flicker.
+    static const double UNSTABLE_FACTOR;
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    double            m_StableGrams;        // Stable standard deviation limit.
+    double            m_ChangeGrams;        // Load change limit.
+    double            m_Values[WINDOW_SIZE];// Most recent readings (circular).
+    size_t            m_NumValues;          // Valid entries in m_Values.
+    size_t            m_Next;               // Next entry to replace.
+    StabilityState    m_State;              // Current state.
+    double            m_StdDev;             // Standard deviation of the window.
+    double            m_StableWeight;       // Weight when last stable.
+    bool              m_HaveStableWeight;   // m_StableWeight is valid.
+    uint32_t          m_LoadChangeCount;    // Number of eSeLoadChanged events.
+    StabilityCallback m_pCallback;          // Event callback.
+    void             *m_pCallbackArg;       // Argument for m_pCallback.
+
+}; // End class StabilityDetector.
+
+
+
+#endif // STABILITYDETECTOR_H
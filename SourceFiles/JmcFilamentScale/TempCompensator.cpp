@@ -0,0 +1,232 @@
+/////////////////////////////////////////////////////////////////////////////////
+// TempCompensator.cpp
+//
+// Contains methods defined by the TempCompensator class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "TempCompensator.h"    // For TempCompensator class.
+#include <cmath>                // For fabs(), isnan(), NAN.
+#include <cstring>              // For memset().
+
+
+const double TempCompensator::MIN_LEARN_DEGREES  = 0.5d;
+const double TempCompensator::FORGET_FACTOR      = 0.9d;
+const double TempCompensator::MIN_SPAN_CONDITION = 0.1d;
+const double TempCompensator::MAX_SPAN_PER_C     = 0.002d;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Starts out enabled with nothing learned.
+/////////////////////////////////////////////////////////////////////////////////
+TempCompensator::TempCompensator() : m_TempC(NAN), m_ZeroPerC(0.0d),
+    m_SpanPerC(0.0d), m_ZeroShift(0.0d), m_SpanScale(1.0d), m_InPeriod(false),
+    m_StartTempC(NAN), m_StartCounts(0.0d), m_LastTempC(NAN), m_LastCounts(0.0d)
+{
+    memset(&m_Data, 0, sizeof(m_Data));
+    m_Data.m_Enabled  = 1U;
+    m_Data.m_RefTempC = NAN;
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetTemperature()
+//
+// Sets the current temperature and precalculates the correction for it.
+//
+// Arguments:
+//    - degreesC - The temperature in degrees C, or NAN if the sensor couldn't
+//                 be read (the last good value is kept).
+/////////////////////////////////////////////////////////////////////////////////
+void TempCompensator::SetTemperature(float degreesC)
+{
+    if (!std::isnan(degreesC))
+    {
+        m_TempC = degreesC;
+        UpdateCorrection();
+    }
+} // End SetTemperature().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetReference()
+//
+// Makes the current temperature the reference temperature.  The tare changes
+// the net readings, so any stable period being tracked is dropped.
+/////////////////////////////////////////////////////////////////////////////////
+void TempCompensator::SetReference()
+{
+    m_Data.m_RefTempC = m_TempC;
+    m_InPeriod = false;
+    UpdateCorrection();
+} // End SetReference().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Observe()
+//
+// Learns from an uncorrected net reading taken at the current temperature.
+//
+// Arguments:
+//    - netCounts - The uncorrected raw reading less the tare reading.
+//    - stable    - True if the load has been stable since the previous call.
+//                  False ends the current stable period.
+//
+// Returns:
+//    Returns 'true' if a period was learned from.
+/////////////////////////////////////////////////////////////////////////////////
+bool TempCompensator::Observe(double netCounts, bool stable)
+{
+    bool learned = false;
+
+    if (!stable || std::isnan(m_TempC))
+    {
+        // The period is over.  Learn from it if the temperature changed
+        // enough for the drift to stand out from the noise.
+        double dT = m_LastTempC - m_StartTempC;
+        if (m_InPeriod && (fabs(dT) >= MIN_LEARN_DEGREES))
+        {
+            double a = dT;
+            double b = dT * m_StartCounts;
+            double y = m_LastCounts - m_StartCounts;
+            m_Data.m_Saa = m_Data.m_Saa * FORGET_FACTOR + a * a;
+            m_Data.m_Sab = m_Data.m_Sab * FORGET_FACTOR + a * b;
+            m_Data.m_Sbb = m_Data.m_Sbb * FORGET_FACTOR + b * b;
+            m_Data.m_Say = m_Data.m_Say * FORGET_FACTOR + a * y;
+            m_Data.m_Sby = m_Data.m_Sby * FORGET_FACTOR + b * y;
+            if (m_Data.m_NumPeriods < UINT16_MAX)
+            {
+                m_Data.m_NumPeriods++;
+            }
+            Fit();
+            learned = true;
+        }
+        m_InPeriod = false;
+    }
+    else if (!m_InPeriod)
+    {
+        // A new stable period.
+        m_InPeriod    = true;
+        m_StartTempC  = m_LastTempC  = m_TempC;
+        m_StartCounts = m_LastCounts = netCounts;
+    }
+    else
+    {
+        m_LastTempC  = m_TempC;
+        m_LastCounts = netCounts;
+    }
+
+    return learned;
+} // End Observe().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Forget()
+//
+// Discards everything learned.  The enable and reference are kept.
+/////////////////////////////////////////////////////////////////////////////////
+void TempCompensator::Forget()
+{
+    m_Data.m_NumPeriods = 0U;
+    m_Data.m_Saa = m_Data.m_Sab = m_Data.m_Sbb = 0.0d;
+    m_Data.m_Say = m_Data.m_Sby = 0.0d;
+    m_InPeriod = false;
+    Fit();
+} // End Forget().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetEnabled()
+//
+// Turns the correction on or off.  Learning continues either way.
+/////////////////////////////////////////////////////////////////////////////////
+void TempCompensator::SetEnabled(bool enable)
+{
+    m_Data.m_Enabled = enable ? 1U : 0U;
+    UpdateCorrection();
+} // End SetEnabled().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SetData()
+//
+// Replaces the learned state (e.g. with data restored from NVS).
+//
+// Arguments:
+//    - rData - The new state.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if the data is not valid.
+/////////////////////////////////////////////////////////////////////////////////
+bool TempCompensator::SetData(const TempCompData &rData)
+{
+    if ((rData.m_Enabled > 1U) || (rData.m_Saa < 0.0d) || (rData.m_Sbb < 0.0d) ||
+        std::isnan(rData.m_Saa) || std::isnan(rData.m_Sab) ||
+        std::isnan(rData.m_Sbb) || std::isnan(rData.m_Say) ||
+        std::isnan(rData.m_Sby))
+    {
+        return false;
+    }
+    m_Data = rData;
+    m_InPeriod = false;
+    Fit();
+    return true;
+} // End SetData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Fit()
+//
+// Recalculates the coefficients from the sums by solving the 2x2 normal
+// equations.  If the loads seen so far don't separate the span from the zero
+// drift (or give an implausible span), all of the drift is put down to zero
+// drift, which is usually by far the larger.
+/////////////////////////////////////////////////////////////////////////////////
+void TempCompensator::Fit()
+{
+    m_ZeroPerC = 0.0d;
+    m_SpanPerC = 0.0d;
+    if (m_Data.m_Saa > 0.0d)
+    {
+        m_ZeroPerC = m_Data.m_Say / m_Data.m_Saa;
+
+        double det = m_Data.m_Saa * m_Data.m_Sbb - m_Data.m_Sab * m_Data.m_Sab;
+        if (det > MIN_SPAN_CONDITION * m_Data.m_Saa * m_Data.m_Sbb)
+        {
+            double zero = (m_Data.m_Say * m_Data.m_Sbb - m_Data.m_Sby * m_Data.m_Sab) / det;
+            double span = (m_Data.m_Saa * m_Data.m_Sby - m_Data.m_Sab * m_Data.m_Say) / det;
+            if (fabs(span) <= MAX_SPAN_PER_C)
+            {
+                m_ZeroPerC = zero;
+                m_SpanPerC = span;
+            }
+        }
+    }
+    UpdateCorrection();
+} // End Fit().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UpdateCorrection()
+//
+// Recalculates m_ZeroShift and m_SpanScale for the current temperature, so
+// that Correct() is just a subtract and a multiply.
+/////////////////////////////////////////////////////////////////////////////////
+void TempCompensator::UpdateCorrection()
+{
+    m_ZeroShift = 0.0d;
+    m_SpanScale = 1.0d;
+    if (IsEnabled() && IsLearned() && !std::isnan(m_TempC) &&
+        !std::isnan(m_Data.m_RefTempC))
+    {
+        double dT = m_TempC - m_Data.m_RefTempC;
+        m_ZeroShift = m_ZeroPerC * dT;
+        m_SpanScale = 1.0d / (1.0d + m_SpanPerC * dT);
+    }
+} // End UpdateCorrection().
@@ -0,0 +1,222 @@
+/////////////////////////////////////////////////////////////////////////////////
+// TempCompensator.h
+//
+// This class implements the TempCompensator class.  It corrects net (tared)
+// load cell readings for the drift caused by changes in ambient temperature
+// since the scale was tared.  Two first order coefficients are used:
+//    - Zero - The reading drifts by m_ZeroPerC counts per degree, whatever the
+//             load.
+//    - Span - The sensitivity changes by a fraction m_SpanPerC per degree.
+// so a reading taken dT degrees from the tare temperature is corrected as:
+//    corrected = (net - m_ZeroPerC * dT) / (1 + m_SpanPerC * dT)
+//
+// The coefficients are learned rather than entered.  Observe() is given the
+// uncorrected reading each time the temperature is read.  While the load is
+// stable it tracks how far the reading has moved since the load became stable,
+// and when the stable period ends a period that saw at least MIN_LEARN_DEGREES
+// of temperature change is added to a least squares fit of
+//    drift = m_ZeroPerC * dT + m_SpanPerC * load * dT
+// Periods at a single load can't tell zero from span drift, so only the zero
+// coefficient is fitted until periods at clearly different loads have been
+// seen.  Older periods are gradually forgotten.
+//
+// The learned state is kept in a TempCompData structure that may be saved to
+// NVS as is.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined TEMPCOMPENSATOR_H
+#define TEMPCOMPENSATOR_H
+
+#include <cstdint>              // For uint8_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// TempCompData structure
+//
+// The saved state: the enable, the tare temperature, and the least squares
+// sums.  The coefficients are recalculated from the sums.
+/////////////////////////////////////////////////////////////////////////////////
+struct TempCompData
+{
+    uint8_t  m_Enabled;                 // Correct readings.
+    uint8_t  m_Reserved;                // Explicit padding, always 0.
+    uint16_t m_NumPeriods;              // Stable periods learned from.
+    float    m_RefTempC;                // Temperature at the last tare.
+    double   m_Saa;                     // Sum of dT * dT.
+    double   m_Sab;                     // Sum of dT * load * dT.
+    double   m_Sbb;                     // Sum of (load * dT)^2.
+    double   m_Say;                     // Sum of dT * drift.
+    double   m_Sby;                     // Sum of load * dT * drift.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// TempCompensator class
+/////////////////////////////////////////////////////////////////////////////////
+class TempCompensator
+{
+public:
+    // Constructor.  Starts out enabled with nothing learned.
+    TempCompensator();
+
+
+    // Destructor.
+    virtual ~TempCompensator() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetTemperature()
+    //
+    // Sets the current temperature and precalculates the correction for it.
+    //
+    // Arguments:
+    //    - degreesC - The temperature in degrees C, or NAN if the sensor
+    //                 couldn't be read (the last good value is kept).
+    /////////////////////////////////////////////////////////////////////////////
+    void SetTemperature(float degreesC);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetReference()
+    //
+    // Makes the current temperature the reference temperature.  Called when
+    // the scale is tared, since the tare removes any drift so far.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetReference();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Correct()
+    //
+    // Corrects a net reading for the temperature change since the tare.
+    //
+    // Arguments:
+    //    - netCounts - The raw reading less the tare reading.
+    //
+    // Returns:
+    //    Returns the corrected reading.  This is 'netCounts' unchanged until
+    //    MIN_PERIODS have been learned, or if we're disabled or either
+    //    temperature is unknown.
+    /////////////////////////////////////////////////////////////////////////////
+    double Correct(double netCounts) const
+        { return (netCounts - m_ZeroShift) * m_SpanScale; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Observe()
+    //
+    // Learns from an uncorrected net reading taken at the current temperature.
+    //
+    // Arguments:
+    //    - netCounts - The uncorrected raw reading less the tare reading.
+    //    - stable    - True if the load has been stable since the previous
+    //                  call.  False ends the current stable period.
+    //
+    // Returns:
+    //    Returns 'true' if a period was learned from (the learned state has
+    //    changed and should be saved).
+    /////////////////////////////////////////////////////////////////////////////
+    bool Observe(double netCounts, bool stable);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Forget()
+    //
+    // Discards everything learned, e.g. because the gain has changed.
+    /////////////////////////////////////////////////////////////////////////////
+    void Forget();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetEnabled()
+    //
+    // Turns the correction on or off.  Learning continues either way.
+    /////////////////////////////////////////////////////////////////////////////
+    void SetEnabled(bool enable);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SetData()
+    //
+    // Replaces the learned state (e.g. with data restored from NVS).
+    //
+    // Arguments:
+    //    - rData - The new state.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if the data is not valid, in
+    //    which case the state is unchanged.
+    /////////////////////////////////////////////////////////////////////////////
+    bool SetData(const TempCompData &rData);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    const TempCompData &GetData() const { return m_Data; }
+    bool     IsEnabled()             const { return m_Data.m_Enabled != 0U; }
+    bool     IsLearned()             const { return m_Data.m_NumPeriods >= MIN_PERIODS; }
+    uint16_t GetNumPeriods()         const { return m_Data.m_NumPeriods; }
+    double   GetZeroPerC()           const { return m_ZeroPerC; }
+    double   GetSpanPerC()           const { return m_SpanPerC; }
+    float    GetTemperature()        const { return m_TempC; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint16_t MIN_PERIODS = 3U;
+    static const double   MIN_LEARN_DEGREES;
+    static const double   FORGET_FACTOR;
+    static const double   MIN_SPAN_CONDITION;
+    static const double   MAX_SPAN_PER_C;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    TempCompensator(TempCompensator &rTc);
+    TempCompensator &operator=(TempCompensator &rTc);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Fit()
+    //
+    // Recalculates the coefficients from the sums, then the correction.
+    /////////////////////////////////////////////////////////////////////////////
+    void Fit();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // UpdateCorrection()
+    //
+    // Recalculates m_ZeroShift and m_SpanScale for the current temperature.
+    /////////////////////////////////////////////////////////////////////////////
+    void UpdateCorrection();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    TempCompData m_Data;                // Saved state.
+    float   m_TempC;                    // Current temperature, NAN if unknown.
+    double  m_ZeroPerC;                 // Zero drift, counts per degree.
+    double  m_SpanPerC;                 // Span drift, fraction per degree.
+    double  m_ZeroShift;                // Correction for m_TempC: subtract,
+    double  m_SpanScale;                //   then scale.
+
+    // The current stable period.
+    bool    m_InPeriod;                 // A stable period is being tracked.
+    float   m_StartTempC;               // Temperature when it started.
+    double  m_StartCounts;              // Reading when it started.
+    float   m_LastTempC;                // Most recent temperature in it.
+    double  m_LastCounts;               // Most recent reading in it.
+
+}; // End class TempCompensator.
+
+
+
+#endif // TEMPCOMPENSATOR_H
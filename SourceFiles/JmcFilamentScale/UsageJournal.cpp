@@ -0,0 +1,526 @@
+/////////////////////////////////////////////////////////////////////////////////
+// UsageJournal.cpp
+//
+// Contains methods defined by the UsageJournal class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "UsageJournal.h"       // For UsageJournal class.
+#include <cmath>                // For NAN, fabsf(), ...
+#include <cstring>              // For memcpy().
+
+
+// A checkpoint is only worth logging once the weight has moved this far.
+const float UsageJournal::CHECKPOINT_GRAMS  = 2.0f;
+
+// The most that a drop between checkpoints can be and still count as filament
+// used: MAX_STEP_GRAMS plus MAX_GRAMS_PER_MIN for each minute between them.
+// Even a fast printer uses well under a gram a minute.
+const float UsageJournal::MAX_STEP_GRAMS    = 20.0f;
+const float UsageJournal::MAX_GRAMS_PER_MIN = 5.0f;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+/////////////////////////////////////////////////////////////////////////////////
+UsageJournal::UsageJournal() :
+    m_pStorage(NULL), m_SectorSize(0U), m_NumSectors(0U), m_SlotsPerSector(0U),
+    m_Head(0U), m_NextSlot(0U), m_Sequence(0UL), m_SpareErased(false)
+{
+    ClearUsage();
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Init()
+//
+// Finds the head sector (the one with the highest sequence number), and
+// replays the sectors oldest first to rebuild each spool's state.  The next
+// record goes after the last one in the head sector.
+//
+// Arguments:
+//    - pStorage - The storage to use.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::Init(JournalStorage *pStorage)
+{
+    m_pStorage = NULL;
+    ClearUsage();
+    if ((pStorage == NULL) || !pStorage->Begin())
+    {
+        return false;
+    }
+    m_SectorSize     = pStorage->GetSectorSize();
+    m_NumSectors     = pStorage->GetNumSectors();
+    m_SlotsPerSector = (m_SectorSize - sizeof(Header)) / sizeof(Record);
+    if ((m_NumSectors < 2U) || (m_SectorSize < sizeof(Header)) ||
+        (m_SlotsPerSector <= MAX_SPOOLS))
+    {
+        return false;
+    }
+    m_pStorage = pStorage;
+
+    // Find the head.
+    bool found = false;
+    uint32_t sequence = 0UL;
+    for (size_t sector = 0U; sector < m_NumSectors; sector++)
+    {
+        if (ReadHeader(sector, sequence) && (!found || (sequence > m_Sequence)))
+        {
+            found      = true;
+            m_Head     = sector;
+            m_Sequence = sequence;
+        }
+    }
+
+    if (found)
+    {
+        // The sectors were written in ring order, so the oldest follows the
+        // head.  Any out of sequence (e.g. left from before the ring wrapped
+        // with a power loss mid erase) are skipped.
+        bool replayed = false;
+        uint32_t lastSequence = 0UL;
+        for (size_t i = 1U; i <= m_NumSectors; i++)
+        {
+            size_t sector = (m_Head + i) % m_NumSectors;
+            if (ReadHeader(sector, sequence) && (sequence <= m_Sequence) &&
+                (!replayed || (sequence > lastSequence)))
+            {
+                m_NextSlot   = Replay(sector);
+                replayed     = true;
+                lastSequence = sequence;
+            }
+        }
+    }
+    else
+    {
+        // A new journal.  The first record starts sector 0.
+        m_Head     = m_NumSectors - 1U;
+        m_NextSlot = m_SlotsPerSector;
+        m_Sequence = 0UL;
+    }
+
+    m_SpareErased = IsBlank((m_Head + 1U) % m_NumSectors);
+    return true;
+} // End Init().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Log()
+//
+// Appends an event.
+//
+// Arguments:
+//    - event - The event.
+//    - spool - The spool it applies to, or NO_SPOOL.
+//    - timeS - The time, in history seconds.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::Log(UsageEvent event, uint8_t spool, uint32_t timeS)
+{
+    return Append(static_cast<uint8_t>(event), spool, timeS, NAN, NAN);
+} // End Log().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Checkpoint()
+//
+// Logs a spool's net weight if it has moved far enough, for long enough.
+//
+// Arguments:
+//    - spool - The spool on the scale.
+//    - timeS - The time, in history seconds.
+//    - grams - Its net weight.
+//
+// Returns:
+//    Returns 'false' if a checkpoint was due but couldn't be logged, or 'true'
+//    otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::Checkpoint(uint8_t spool, uint32_t timeS, float grams)
+{
+    if ((spool >= MAX_SPOOLS) || std::isnan(grams) || (grams < 0.0f))
+    {
+        return true;
+    }
+
+    const SpoolUsage &rUsage = m_Usage[spool];
+    if (!std::isnan(rUsage.m_LastGrams) &&
+        ((fabsf(grams - rUsage.m_LastGrams) < CHECKPOINT_GRAMS) ||
+         (timeS - rUsage.m_LastS < CHECKPOINT_PERIOD_S)))
+    {
+        return true;
+    }
+    return Append(eUeCheckpoint, spool, timeS, grams, NAN);
+} // End Checkpoint().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Process()
+//
+// Erases the sector after the head, if it isn't already, so that moving on to
+// it doesn't stall a caller for the erase.  That sector is the oldest, and the
+// head starts with a snapshot, so nothing of the state is lost.
+/////////////////////////////////////////////////////////////////////////////////
+void UsageJournal::Process()
+{
+    if ((m_pStorage != NULL) && !m_SpareErased)
+    {
+        m_SpareErased = m_pStorage->EraseSector((m_Head + 1U) % m_NumSectors);
+    }
+} // End Process().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Clear()
+//
+// Erases every sector and forgets every spool.  The next record starts a new
+// journal at sector 0.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::Clear()
+{
+    if (m_pStorage == NULL)
+    {
+        return false;
+    }
+
+    bool status = true;
+    for (size_t sector = 0U; sector < m_NumSectors; sector++)
+    {
+        status &= m_pStorage->EraseSector(sector);
+    }
+    ClearUsage();
+    m_Head        = m_NumSectors - 1U;
+    m_NextSlot    = m_SlotsPerSector;
+    m_Sequence    = 0UL;
+    m_SpareErased = status;
+    return status;
+} // End Clear().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Append()
+//
+// Writes a record to the head sector, moving on to a new sector first if it
+// is full, then applies the record to the spools' state.
+//
+// Arguments:
+//    - type  - The record type (UsageEvent).
+//    - spool - The spool, or NO_SPOOL.
+//    - timeS - The time.
+//    - value - The record's values.
+//    - extra
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::Append(uint8_t type, uint8_t spool, uint32_t timeS,
+                          float value, float extra)
+{
+    if ((m_pStorage == NULL) ||
+        ((m_NextSlot >= m_SlotsPerSector) && !StartSector()))
+    {
+        return false;
+    }
+
+    Record record;
+    record.m_Type  = type;
+    record.m_Spool = spool;
+    record.m_TimeS = timeS;
+    record.m_Value = value;
+    record.m_Extra = extra;
+    if (!WriteRecord(record))
+    {
+        return false;
+    }
+    Apply(record);
+    return true;
+} // End Append().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WriteRecord()
+//
+// Writes a record to the next slot of the head sector.  The slot is used up
+// even if the write fails, since it may have been partly written.
+//
+// Arguments:
+//    - rRecord - The record.  Its checksum is filled in.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::WriteRecord(Record &rRecord)
+{
+    rRecord.m_Check = Checksum(rRecord);
+    size_t offset = m_Head * m_SectorSize + sizeof(Header) + m_NextSlot * sizeof(Record);
+    m_NextSlot++;
+    return m_pStorage->Write(offset, &rRecord, sizeof(Record));
+} // End WriteRecord().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// StartSector()
+//
+// Moves the head on to the next sector: erases it (unless Process() already
+// has), writes its header, then a snapshot of each spool that has a state.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::StartSector()
+{
+    size_t next = (m_Head + 1U) % m_NumSectors;
+    if (!m_SpareErased && !m_pStorage->EraseSector(next))
+    {
+        return false;
+    }
+    m_SpareErased = false;
+
+    Header header;
+    header.m_Magic    = MAGIC;
+    header.m_Sequence = m_Sequence + 1UL;
+    header.m_Version  = VERSION;
+    header.m_Check    = ~(header.m_Magic ^ header.m_Sequence ^ header.m_Version);
+    if (!m_pStorage->Write(next * m_SectorSize, &header, sizeof(Header)))
+    {
+        return false;
+    }
+    m_Head     = next;
+    m_Sequence = header.m_Sequence;
+    m_NextSlot = 0U;
+
+    for (uint8_t spool = 0U; spool < MAX_SPOOLS; spool++)
+    {
+        const SpoolUsage &rUsage = m_Usage[spool];
+        if ((rUsage.m_UsedGrams != 0.0f) || !std::isnan(rUsage.m_LastGrams))
+        {
+            Record record;
+            record.m_Type  = eUeSnapshot;
+            record.m_Spool = spool;
+            record.m_TimeS = rUsage.m_LastS;
+            record.m_Value = rUsage.m_LastGrams;
+            record.m_Extra = rUsage.m_UsedGrams;
+            if (!WriteRecord(record))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+} // End StartSector().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ReadHeader()
+//
+// Reads a sector's header.
+//
+// Arguments:
+//    - sector    - The sector.
+//    - rSequence - Set to its sequence number.
+//
+// Returns:
+//    Returns 'true' if the sector has a valid header, or 'false' otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::ReadHeader(size_t sector, uint32_t &rSequence)
+{
+    Header header;
+    if (!m_pStorage->Read(sector * m_SectorSize, &header, sizeof(Header)) ||
+        (header.m_Magic != MAGIC) || (header.m_Version != VERSION) ||
+        (header.m_Check != ~(header.m_Magic ^ header.m_Sequence ^ header.m_Version)))
+    {
+        return false;
+    }
+    rSequence = header.m_Sequence;
+    return true;
+} // End ReadHeader().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Replay()
+//
+// Applies a sector's records, READ_RECORDS at a time, up to its first erased
+// slot.  Records that fail their checksum (torn by a power loss) are skipped.
+//
+// Arguments:
+//    - sector - The sector.
+//
+// Returns:
+//    Returns the sector's first erased slot, or m_SlotsPerSector if it is full
+//    (or can't be read).
+/////////////////////////////////////////////////////////////////////////////////
+size_t UsageJournal::Replay(size_t sector)
+{
+    Record records[READ_RECORDS];
+    size_t base = sector * m_SectorSize + sizeof(Header);
+    for (size_t slot = 0U; slot < m_SlotsPerSector; slot += READ_RECORDS)
+    {
+        size_t count = m_SlotsPerSector - slot;
+        if (count > READ_RECORDS)
+        {
+            count = READ_RECORDS;
+        }
+        if (!m_pStorage->Read(base + slot * sizeof(Record), records,
+                              count * sizeof(Record)))
+        {
+            return m_SlotsPerSector;
+        }
+        for (size_t i = 0U; i < count; i++)
+        {
+            static const uint8_t ERASED[sizeof(Record)] =
+                {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+            if (!memcmp(&records[i], ERASED, sizeof(Record)))
+            {
+                return slot + i;
+            }
+            if (records[i].m_Check == Checksum(records[i]))
+            {
+                Apply(records[i]);
+            }
+        }
+    }
+    return m_SlotsPerSector;
+} // End Replay().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// IsBlank()
+//
+// Returns 'true' if every byte of a sector is erased.
+/////////////////////////////////////////////////////////////////////////////////
+bool UsageJournal::IsBlank(size_t sector)
+{
+    uint32_t words[64];
+    for (size_t offset = 0U; offset < m_SectorSize; offset += sizeof(words))
+    {
+        size_t size = m_SectorSize - offset;
+        if (size > sizeof(words))
+        {
+            size = sizeof(words);
+        }
+        if (!m_pStorage->Read(sector * m_SectorSize + offset, words, size))
+        {
+            return false;
+        }
+        const uint8_t *pBytes = reinterpret_cast<const uint8_t *>(words);
+        for (size_t i = 0U; i < size; i++)
+        {
+            if (pBytes[i] != 0xFFU)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+} // End IsBlank().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Apply()
+//
+// Updates the spools' state with a record, whether just written or replayed.
+//
+// Arguments:
+//    - rRecord - The record.
+/////////////////////////////////////////////////////////////////////////////////
+void UsageJournal::Apply(const Record &rRecord)
+{
+    switch (rRecord.m_Type)
+    {
+    case eUeCheckpoint:
+        if (rRecord.m_Spool < MAX_SPOOLS)
+        {
+            SpoolUsage &rUsage = m_Usage[rRecord.m_Spool];
+            if (!std::isnan(rUsage.m_LastGrams))
+            {
+                float drop    = rUsage.m_LastGrams - rRecord.m_Value;
+                float minutes = (rRecord.m_TimeS - rUsage.m_LastS) / 60.0f;
+                if ((drop > 0.0f) && (drop <= MAX_STEP_GRAMS + MAX_GRAMS_PER_MIN * minutes))
+                {
+                    rUsage.m_UsedGrams += drop;
+                }
+            }
+            rUsage.m_LastGrams = rRecord.m_Value;
+            rUsage.m_LastS     = rRecord.m_TimeS;
+        }
+        break;
+
+    case eUeTare:
+    case eUeCalibrate:
+        // Every spool's net weight moves, so start each one afresh.
+        for (uint8_t spool = 0U; spool < MAX_SPOOLS; spool++)
+        {
+            m_Usage[spool].m_LastGrams = NAN;
+        }
+        break;
+
+    case eUeSnapshot:
+        if (rRecord.m_Spool < MAX_SPOOLS)
+        {
+            SpoolUsage &rUsage = m_Usage[rRecord.m_Spool];
+            rUsage.m_LastGrams = rRecord.m_Value;
+            rUsage.m_LastS     = rRecord.m_TimeS;
+            rUsage.m_UsedGrams = rRecord.m_Extra;
+        }
+        break;
+
+    default:
+        // Nothing to track (e.g. eUeSelect).
+        break;
+    }
+} // End Apply().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ClearUsage()
+//
+// Forgets every spool's state.
+/////////////////////////////////////////////////////////////////////////////////
+void UsageJournal::ClearUsage()
+{
+    for (uint8_t spool = 0U; spool < MAX_SPOOLS; spool++)
+    {
+        m_Usage[spool].m_LastGrams = NAN;
+        m_Usage[spool].m_LastS     = 0UL;
+        m_Usage[spool].m_UsedGrams = 0.0f;
+    }
+} // End ClearUsage().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Checksum()
+//
+// Returns the CRC-16 (CCITT) of a record, less its m_Check field.  Unlike a
+// Fletcher sum, it tells 0x00 from 0xFF bytes, so a record torn before its
+// zero bytes were written doesn't pass.
+/////////////////////////////////////////////////////////////////////////////////
+uint16_t UsageJournal::Checksum(const Record &rRecord)
+{
+    Record copy;
+    memcpy(&copy, &rRecord, sizeof(Record));
+    copy.m_Check = 0U;
+    const uint8_t *pBytes = reinterpret_cast<const uint8_t *>(&copy);
+    uint16_t crc = 0xFFFFU;
+    for (size_t i = 0U; i < sizeof(Record); i++)
+    {
+        crc ^= static_cast<uint16_t>(pBytes[i]) << 8;
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (crc & 0x8000U) ? static_cast<uint16_t>((crc << 1) ^ 0x1021U) :
+                                    static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+} // End Checksum().
@@ -0,0 +1,240 @@
+/////////////////////////////////////////////////////////////////////////////////
+// UsageJournal.h
+//
+// This class implements the UsageJournal class.  It keeps a log of spool
+// weight checkpoints and scale events (tare, calibrate, spool selected) in
+// flash, and from it the filament used from each spool.  Unlike an NVS blob,
+// which is rewritten whole on each change, the journal only ever appends.
+//
+// The storage is used as a ring of sectors.  Each sector starts with a header
+// holding a sequence number, followed by fixed size records.  Records are
+// written in order, so the sector with the highest sequence number is the
+// head, and its first erased slot is where the next record goes.  Each record
+// carries a checksum, so one torn by a power loss is skipped.
+//
+// When the head sector is full, the next sector is taken, and the state of
+// every spool is written to it first as snapshot records.  Older sectors are
+// then only history, and the oldest is erased in the background by Process()
+// ahead of being needed.  Erases therefore go round the whole storage evenly.
+// At power up, the sectors are replayed oldest first to rebuild the state, and
+// appending carries on after the last record of the head sector.  A snapshot
+// cut short by a power loss is never the only copy of the state, since the
+// sector before it is only erased once the ring has come round again.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined USAGEJOURNAL_H
+#define USAGEJOURNAL_H
+
+#include <cstddef>              // For size_t.
+#include <cstdint>              // For uint32_t, ...
+#include "JournalStorage.h"     // For JournalStorage interface.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// The journal record types.
+/////////////////////////////////////////////////////////////////////////////////
+enum UsageEvent
+{
+    eUeCheckpoint = 0,      // A spool's net weight (grams).
+    eUeTare       = 1,      // The scale was tared.
+    eUeCalibrate  = 2,      // The scale was calibrated.
+    eUeSelect     = 3,      // A spool was selected.
+    eUeSnapshot   = 4       // A spool's state, at the start of each sector.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SpoolUsage is what the journal knows about a spool.
+/////////////////////////////////////////////////////////////////////////////////
+struct SpoolUsage
+{
+    float    m_LastGrams;               // Last checkpoint, NaN if none since
+                                        // the scale was last tared/calibrated.
+    uint32_t m_LastS;                   // Its time.
+    float    m_UsedGrams;               // Filament used in total.
+};
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// UsageJournal class
+/////////////////////////////////////////////////////////////////////////////////
+class UsageJournal
+{
+public:
+    // Constructor.
+    UsageJournal();
+
+
+    // Destructor.
+    virtual ~UsageJournal() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Init()
+    //
+    // Recovers the journal from the storage (starting a new one if there is
+    // none).
+    //
+    // Arguments:
+    //    - pStorage - The storage to use.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Init(JournalStorage *pStorage);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Log()
+    //
+    // Appends an event.
+    //
+    // Arguments:
+    //    - event - The event.  Tare and calibrate invalidate every spool's
+    //              last checkpoint, since net weights change with them.
+    //    - spool - The spool it applies to, or NO_SPOOL.
+    //    - timeS - The time, in history seconds.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Log(UsageEvent event, uint8_t spool, uint32_t timeS);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Checkpoint()
+    //
+    // Offers a spool's stable net weight.  It is logged if it has moved by at
+    // least CHECKPOINT_GRAMS and CHECKPOINT_PERIOD_S has passed since the last
+    // checkpoint.  A drop of up to MAX_STEP_GRAMS, plus MAX_GRAMS_PER_MIN for
+    // the time since the last checkpoint, counts as filament used; a larger
+    // change is the spool being lifted off or swapped.  Negative weights (no
+    // spool on the scale) are ignored.
+    //
+    // Arguments:
+    //    - spool - The spool on the scale.
+    //    - timeS - The time, in history seconds.
+    //    - grams - Its net weight.
+    //
+    // Returns:
+    //    Returns 'false' if a checkpoint was due but couldn't be logged, or
+    //    'true' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Checkpoint(uint8_t spool, uint32_t timeS, float grams);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Process()
+    //
+    // Does the background work: erasing the sector that will be needed next.
+    // Should be called from loop().
+    /////////////////////////////////////////////////////////////////////////////
+    void Process();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Clear()
+    //
+    // Erases the whole journal.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' otherwise.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Clear();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    bool              IsReady()              const { return m_pStorage != NULL; }
+    const SpoolUsage &GetUsage(uint8_t spool) const { return m_Usage[spool % MAX_SPOOLS]; }
+    uint32_t          GetSequence()          const { return m_Sequence; }
+    size_t            GetHeadSector()        const { return m_Head; }
+    size_t            GetNextSlot()          const { return m_NextSlot; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint8_t  MAX_SPOOLS          = 16U;
+    static const uint8_t  NO_SPOOL            = 0xFFU;
+    static const uint32_t CHECKPOINT_PERIOD_S = 60UL;
+    static const float    CHECKPOINT_GRAMS;
+    static const float    MAX_STEP_GRAMS;
+    static const float    MAX_GRAMS_PER_MIN;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    UsageJournal(UsageJournal &rUj);
+    UsageJournal &operator=(UsageJournal &rUj);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // The layout in the storage.  Both are 16 bytes, so records never cross a
+    // sector boundary.
+    /////////////////////////////////////////////////////////////////////////////
+    struct Header
+    {
+        uint32_t m_Magic;               // MAGIC.
+        uint32_t m_Sequence;            // Increases by one per sector.
+        uint32_t m_Version;             // VERSION.
+        uint32_t m_Check;               // ~(m_Magic ^ m_Sequence ^ m_Version).
+    };
+
+    struct Record
+    {
+        uint8_t  m_Type;                // UsageEvent (0xFF if erased).
+        uint8_t  m_Spool;               // Spool, or NO_SPOOL.
+        uint16_t m_Check;               // Checksum() of the record.
+        uint32_t m_TimeS;               // History seconds.
+        float    m_Value;               // Checkpoint or last grams.
+        float    m_Extra;               // Snapshot used grams.
+    };
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Helpers.  See UsageJournal.cpp for descriptions.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Append(uint8_t type, uint8_t spool, uint32_t timeS, float value,
+                float extra);
+    bool WriteRecord(Record &rRecord);
+    bool StartSector();
+    bool ReadHeader(size_t sector, uint32_t &rSequence);
+    size_t Replay(size_t sector);
+    bool IsBlank(size_t sector);
+    void Apply(const Record &rRecord);
+    void ClearUsage();
+    static uint16_t Checksum(const Record &rRecord);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Private constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const uint32_t MAGIC         = 0x4C4E524AUL;    // "JRNL".
+    static const uint32_t VERSION       = 1UL;
+    static const size_t   READ_RECORDS  = 16U;             // Per storage read.
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    JournalStorage *m_pStorage;         // Set once Init() succeeds.
+    size_t          m_SectorSize;       // Bytes per sector.
+    size_t          m_NumSectors;       // Sectors in the ring.
+    size_t          m_SlotsPerSector;   // Records per sector.
+    size_t          m_Head;             // Sector being written.
+    size_t          m_NextSlot;         // Next record slot in it.
+    uint32_t        m_Sequence;         // Its sequence number.
+    bool            m_SpareErased;      // The sector after the head is erased.
+    SpoolUsage      m_Usage[MAX_SPOOLS];// Each spool's state.
+
+}; // End class UsageJournal.
+
+
+
+#endif // USAGEJOURNAL_H
@@ -1,879 +1,1485 @@
-/////////////////////////////////////////////////////////////////////////////////
-// WebData.cpp
-//
-// Contains functions to handle web requests from the web client.
-//
-// History:
-// - jmcorbett 01-JUN-2021 Original creation.
-//
-// Copyright (c) 2021, Joseph M. Corbett
-/////////////////////////////////////////////////////////////////////////////////
-#include "JmcFilamentScale.h"   // For application related data.
-#include "SimpleLock.h"         // For options locking SimpleLock class.
-#include <ArduinoJson.h>        // For JSON handling.
-#include "WebPages.h"           // For the data of the main web page display.
-#include "WebData.h"            // Our own declarations.
-#include "MainScreen.h"         // For MainScreen class.
-#include "Spool.h"              // For MAX_NAME_SIZE.
-
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Web options locking related globals.
-/////////////////////////////////////////////////////////////////////////////////
-SimpleLock gWebLock;            // Lock to only allow setup changes one source at
-                                // a time (web or local).
-static uint32_t gWebWdTime = 0; // Last web message receipt time (ms).
-static const uint32_t WEB_WD_TIMEOUT_MS = 10000;
-                                // Timeout if this amount of milliseconds pass
-                                // between web messages. (10 seconds)
-// Constants defining web lock ownership values.
-static const uint32_t LOCAL_OWNER = 1UL;
-static const uint32_t WEB_OWNER   = 2UL;
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// WebData::LockLocal()
-//
-// Attempt to acquire the local/network options lock for the local device.
-//
-// Returns:
-//      Returns 'true' if the lock was acquired successfully.  Returns 'false'
-//      otherwise.
-/////////////////////////////////////////////////////////////////////////////////
-bool WebData::LockLocal()
-{
-    return gWebLock.Lock(LOCAL_OWNER);
-} // End LockLocal().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// WebData::IsLocalOwner()
-//
-// Returns true if owner of the lock is LOCAL_OWNER.
-//
-// Returns:
-//      Returns 'true' if the lock is currently owned by LOCAL_OWNER.
-/////////////////////////////////////////////////////////////////////////////////
-bool WebData::IsLocalOwner()
-{
-    return gWebLock.Owner() == LOCAL_OWNER;
-}
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// WebData::Unlock()
-//
-// Releases the local/network options lock.
-/////////////////////////////////////////////////////////////////////////////////
-void WebData::Unlock()
-{
-    gWebLock.Unlock();
-} // End Unlock().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleWebTimeout()
-//
-// The web lock is used to insure that a web client and the local user cannot
-// attempt to modify any options at the same time.  When the web client has an
-// options page displayed, it takes ownership of the web lock.  This prevents the
-// local user from entering the options menu.  If the web client goes away while
-// owning the web lock, this could prevent the local user from ever being able
-// to enter the options menu.  To prevent this, each time an update messsage is
-// received from a web client, we remember the time at which it arrives.  The
-// main loop calls this function every iteration to verify that the client
-// connection is still alive.  If too much time has passed, then it is assumed
-// that the connection is lost, so if the web client was the owner of the lock,
-// it is unlocked.
-/////////////////////////////////////////////////////////////////////////////////
-void WebData::HandleWebTimeout()
-{
-    // If the web owned our options mutex and we haven't seen a message from
-    // it for a while, then unlock the mutex.
-    if ((gWebLock.Owner() == WEB_OWNER) &&
-        ((millis() - gWebWdTime) > WEB_WD_TIMEOUT_MS))
-    {
-        gWebLock.Unlock();
-    }
-} // End HandleWebTimeout().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// Rgb565ToHexString()
-//
-// Converts an RGB565 color value to a hex string suitable for javascript use.
-//
-// Arguments:
-//   color - this is the RGB565 color value to be converted.
-//
-// Returns:
-//   Returns a pointer to the static buffer that contains the converted color
-//   hexadecimal string.
-//
-// Note: This function returns a pointer to a static buffer, and so is not
-// reentrant.
-/////////////////////////////////////////////////////////////////////////////////
-static char *Rgb565ToHexString(uint16_t color)
-{
-    static char buf[8];
-    uint8_t r, g, b;
-    r = ((color >> 11) << 3) | 7;
-    g = ((color >> 5)  << 2) | 3;
-    b = (color << 3) | 7;
-    sprintf(buf, "#%02x%02x%02x", r, g, b);
-    return buf;
-} // End Rgb565ToHexString().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HexStringToRgb565()
-//
-// Arguments:
-//   pColor - This is a pointer to the hex color string to be converted.  Note
-//            that it is assumed that this string is of the form of a javascript
-//            color (i.e. #hhhhhh).
-//
-// Returns:
-//   Returns the RGB565 value corresponding to the referenced color string.
-/////////////////////////////////////////////////////////////////////////////////
-static uint16_t HexStringToRgb565(const char *pColor)
-{
-    uint32_t val = strtol(pColor + 1, NULL, 16);
-    return static_cast<uint16_t>(MYRGB565((val >> 16) & 0xff, (val >> 8) & 0xff, val & 0xff));
-} // End HexStringToRgb565().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleNotFound()
-//
-// Handles receipt of unknown network messages by displaying an error message
-// on the network client.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleNotFound()
-{
-    // Setup the "not found" message along with the unknown URI and method.
-    String message = "File Not Found\n\n";
-    message += "URI: ";
-    message += gNetwork.uri();
-    message += "\nMethod: ";
-    message += (gNetwork.method() == HTTP_GET) ? "GET" : "POST";
-
-    // Collect any arguments to the request.
-    message += "\nArguments: ";
-    message += gNetwork.args();
-    message += "\n";
-    for (uint8_t i = 0; i < gNetwork.args(); i++)
-    {
-        message += " " + gNetwork.argName(i) + ": " + gNetwork.arg(i) + "\n";
-    }
-
-    // Send diagnostic to the monitor.
-    Serial.println("WEB PAGE NOT FOUND");
-    Serial.println(message);
-
-    // Send the data to the client.
-    gNetwork.send(404, "text/plain", message);
-} // End HandleNotFound().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleLockOptions()
-//
-// Called when the client requests that the options be locked.  Checks if option
-// settings are currently locked.  Replies to the request with a "LOCKED" status
-// of true if options were not previously locked, and gives the client exclusive
-// use of the setting/changing of the options.  Replies with a "LOCKED" status
-// of false if options were already locked, and denies the client use of
-// setting/changing of the options.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleLockOptions()
-{
-    String webPage;
-    DynamicJsonDocument doc(100);
-    bool locked = gWebLock.Lock(WEB_OWNER);
-    doc["LOCKED"] = locked;
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-} // End HandleLockOptions().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleUnlockOptions()
-//
-// Unlocks the setting/changing of options so that others may change them.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleUnlockOptions()
-{
-    gWebLock.Unlock();
-    gNetwork.send(200, "text/html");
-} // End HandleUnlockOptions().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleRoot()
-//
-// Called when the client connects to the server.  Sends the root page to the
-// client.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleRoot()
-{
-    Serial.println("--------------------------- GOT A HIT! ---------------------");
-    gNetwork.send(200, "text/html", gRootPage);
-} // End HandleRoot().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleMainPageData()
-//
-// Called when the client requests a refresh of the main page data.  Updates all
-// of the relevant fields of the main page based on current values.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleMainPageData()
-{
-    // Remember the current time for handling the web watchdog.
-    gWebWdTime = millis();
-
-    String webPage;
-    DynamicJsonDocument doc(1024);
-
-    // NET WEIGHT
-    doc["WEIGHT"]           = gCurrentWeight;
-    doc["WEIGHT_UNITS"]     = gLoadCell.GetUnitsString();
-    doc["WEIGHT_PRECISION"] = GetWeightDecimalPlaces();
-
-    // TEMPERATURE
-    if (isnan(gCurrentTemperature))
-    {
-        doc["TEMPERATURE"]  = "-";
-    }
-    else
-    {
-        doc["TEMPERATURE"]  = gCurrentTemperature;
-    }
-    doc["TEMPERATURE_UNITS"]     = &gEnvSensor.GetTempScaleString()[1];
-    doc["TEMPERATURE_PRECISION"] = gTemperatureUnits == eTempScaleF ? 0 : 1;
-
-    // HUMIDITY
-    if (isnan(gCurrentHumidity))
-    {
-        doc["HUMIDITY"] = "-";
-    }
-    else
-    {
-        doc["HUMIDITY"] = gCurrentHumidity;
-    }
-
-    // UP TIME
-    doc["UPTIME"] = millis();
-
-    // IP ADDRESS
-    IPAddress ip = WiFi.localIP();
-    String ipString = String(ip[0]) + String(".") +
-                      String(ip[1]) + String(".") +
-                      String(ip[2]) + String(".") +
-                      String(ip[3]);
-    doc["IP_ADDRESS"] = ipString;
-
-    // WEB ID
-    doc["WEB_ID"] = String(rNetworkServerName) + ".local";
-
-    // SIGNAL STRENGTH
-    doc["SIGNAL_STRENGTH"] = WiFi.RSSI();
-
-    // If a spool is currently selected then send the corresponding fields.
-    Spool *pSelectedSpool = gSpoolMgr.GetSelectedSpool();
-    doc["SPOOL_SELECTED"] = (pSelectedSpool != NULL);
-    if (pSelectedSpool != NULL)
-    {
-        // SPOOL RELATED VALUES
-        char buf[Filament::TYPE_LSTRING_MAX_SIZE];
-        FilamentType type = pSelectedSpool->GetType();
-        doc["SPOOL_WEIGHT"]      = pSelectedSpool->GetSpoolWeight();
-        doc["FILEMANT_TYPE"]     = gFilament.GetTypeLString(type, buf);
-        doc["FILAMENT_DIAMETER"] = pSelectedSpool->GetDiameter();
-        doc["SPOOL_NAME"]        = pSelectedSpool->GetName();
-        doc["FILAMENT_DENSITY"]  = pSelectedSpool->GetDensity();
-
-        // LENGTH
-        doc["LENGTH"]           = gCurrentLength;
-        doc["LENGTH_UNITS"]     = gLengthMgr.GetUnitsString();
-        doc["LENGTH_PRECISION"] = gLengthMgr.GetPrecision();
-
-        // FILAMENT COLOR
-        doc["FILAMENT_COLOR"]   = Rgb565ToHexString(pSelectedSpool->GetColor());
-    }
-
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-} // End HandleMainPageData().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SendDisplayFormData()
-//
-// Called when the client opens the Display Options form.  Sends current values
-// of all form data to the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void SendDisplayFormData()
-{
-    DynamicJsonDocument doc(256);
-    bool locked = gWebLock.Lock(WEB_OWNER);
-    doc["LOCKED"] = locked;
-    doc["WEIGHT_UNITS"]        = gLoadCell.GetUnits();
-    doc["LENGTH_UNITS"]        = gLengthMgr.GetSelected();
-    doc["TEMPERATURE_UNITS"]   = gEnvSensor.GetTempScale();
-    doc["BRIGHTNESS"]          = gTft.GetBacklightPercent();
-    doc["SCROLL_DELAY_S"]      = MainScreen::GetScrollDelayMs() / 1000;
-    doc["MAX_SCROLL_DELAY_S"]  = MainScreen::MAX_SCROLL_DELAY_SEC;
-    doc["SCROLL_DELAY_STEP_S"] = MainScreen::SCROLL_DELAY_STEP_SEC;
-
-    String webPage;
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-} // End SendDisplayFormData().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SaveDisplayFormData()
-//
-// Called when the client wants to save any changes made to the display options.
-// Updates the display options as requested by the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void SaveDisplayFormData()
-{
-    uint16_t response = 200;    // Assume OK response.
-
-    StaticJsonDocument<300> JsonDoc;
-    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
-    if (error)
-    {
-        Serial.print("deserializeJson() failed with code ");
-        Serial.println(error.c_str());
-        response = 400; // BAD REQUEST response.
-    }
-    else
-    {
-        // Update our display parameters.
-        gScaleUnits = static_cast<WeightUnits>(JsonDoc["weightUnitsData"]);
-        SetLoadCellUnits(gScaleUnits);
-
-        gLengthUnits = static_cast<LengthUnits>(JsonDoc["lengthUnitsData"]);
-        UpdateLengthFactorEntry();
-
-        gTemperatureUnits = static_cast<TempScale>(JsonDoc["tempUnitsData"]);
-        gEnvSensor.SetTempScale(gTemperatureUnits);
-
-        gBacklightPercent = static_cast<uint32_t>(JsonDoc["brightnessData"]);
-        gTft.SetBacklightPercent(gBacklightPercent);
-
-        MainScreen::SetScrollDelayMs(static_cast<uint32_t>(JsonDoc["scrollDelayData"]) * 1000);
-    }
-
-    // Send a response to the client.
-    gNetwork.send(response, "text/html");
-
-    // Let the system know that data has changed.
-    gDataUpdated = true;
-
-    // Unlock our mutex.
-    gWebLock.Unlock();
-} // End SaveDisplayFormData().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SendScaleFormData()
-//
-// Called when the client opens the Scale Options form.  Sends current values
-// of all form data to the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void SendScaleFormData()
-{
-    String webPage;
-    DynamicJsonDocument doc(256);
-
-    bool locked = gWebLock.Lock(WEB_OWNER);
-    doc["LOCKED"] = locked;
-
-    doc["WEIGHT_PRECISION"] = GetWeightDecimalPlaces();
-    doc["MAX_WEIGHT"]       = GetMaxScaleWeight();
-    doc["WEIGHT_UNITS"]     = gLoadCell.GetUnitsString();
-    doc["CALIBRATE_WEIGHT"] = gCalibrateWeight;
-    doc["AVG_SAMPLES"]      = gScaleAveragingSamples;
-    doc["AVG_SAMPLES_MAX"]  = AVG_SAMPLES_MAX;
-    doc["LOAD_CELL_GAIN"]   = gScaleGain;
-
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-} // End SendScaleFormData().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SaveScaleFormData()
-//
-// Called when the client wants to save any changes made to the scale options.
-// Updates the display options as requested by the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void SaveScaleFormData()
-{
-    uint16_t response = 200;    // Assume OK response.
-
-    StaticJsonDocument<300> JsonDoc;
-    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
-    if (error)
-    {
-        Serial.print("deserializeJson() failed with code ");
-        Serial.println(error.c_str());
-        response = 400; // BAD REQUEST response.
-    }
-    else
-    {
-        // Set the selected spool's data per the request.
-        gCalibrateWeight = static_cast<double>(JsonDoc["calWeightData"]);
-        gScaleAveragingSamples = static_cast<uint32_t>(JsonDoc["avgSamples"]);
-        gLoadCell.SetAverageInterval(gScaleAveragingSamples);
-        uint8_t gain = static_cast<uint8_t>(JsonDoc["scaleGain"]);
-        if (gain != gLoadCell.GetGain())
-        {
-            gScaleGain = gain;
-            gLoadCell.SetGain(gain);
-        }
-    }
-
-    // Send a response to the client.
-    gNetwork.send(response, "text/html");
-
-    // Let the system know that data has changed.
-    gDataUpdated = true;
-
-    // Unlock our mutex.
-    gWebLock.Unlock();
-} // End SaveScaleFormData().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleDoTare()
-//
-// Called when the client requests a Tare operation.  Performs the Tare operation
-// and returns the success/failre results to the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleDoTare()
-{
-    bool result = gLoadCell.Tare();
-    String webPage;
-    DynamicJsonDocument doc(100);
-    doc["TARE_RESULT"] = result;
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-} // End HandleDoTare().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleDoScaleCalibrate()
-//
-// Called when the client requests a scale calibration operation.  Performs the
-// calibration and returns the success/failre results to the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleDoScaleCalibrate()
-{
-    uint16_t response = 200;    // Assume OK response.
-
-    StaticJsonDocument<300> JsonDoc;
-    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
-    if (error)
-    {
-        Serial.print("deserializeJson() failed with code ");
-        Serial.println(error.c_str());
-        response = 400; // BAD REQUEST response.
-        // Send a response to the client.
-        gNetwork.send(response, "text/html");
-
-    }
-    else
-    {
-        // Set the selected spool's data per the request.
-        gCalibrateWeight = static_cast<double>(JsonDoc["calWeightData"]);
-
-        // Perform the calibration operation.
-        bool success = gLoadCell.Calibrate(0, gCalibrateWeight);
-        if (!success)
-        {
-            Serial.print("Calibration failed");
-        }
-        String webPage;
-        DynamicJsonDocument doc(100);
-        doc["CAL_RESULT"] = success;
-        serializeJson(doc, webPage);
-        gNetwork.send(response, "text/html", webPage);
-    }
-} // End HandleDoScaleCalibrate().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SendSpoolFormData()
-//
-// Called when the client opens the Spool Options form.  Sends current values
-// of all form data to the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void SendSpoolFormData()
-{
-    String webPage;
-    DynamicJsonDocument doc(1800);
-    bool locked = gWebLock.Lock(WEB_OWNER);
-    doc["LOCKED"] = locked;
-
-    Spool *pSpool = gSpoolMgr.GetSelectedSpool();
-    uint32_t startSpoolIndex = gSpoolMgr.GetSelectedSpoolIndex();
-    bool spoolIsSelected = true;
-    if (pSpool == NULL)
-    {
-        startSpoolIndex = 0;
-        spoolIsSelected = false;
-    }
-
-    doc["WEIGHT_PRECISION"] = GetWeightDecimalPlaces();
-    doc["MAX_WEIGHT"]       = GetMaxScaleWeight();
-    doc["WEIGHT_UNITS"]     = gLoadCell.GetUnitsString();
-    doc["START_SPOOL"]      = startSpoolIndex;
-    doc["SPOOL_SELECTED"]   = spoolIsSelected;
-    doc["MAX_NAME_LEN"]     = Spool::MAX_NAME_SIZE;
-    doc["MAX_DENSITY"]      = Filament::MAX_DENSITY;
-    doc["MIN_DENSITY"]      = Filament::MIN_DENSITY;
-
-    doc.createNestedArray("FILAMENT_TYPES");
-    doc.createNestedArray("SPOOL_NAMES");
-    doc.createNestedArray("SPOOL_WEIGHTS");
-    doc.createNestedArray("FILAMENT_DIAMETERS");
-    doc.createNestedArray("DENSITY");
-    doc.createNestedArray("COLORS");
-
-    for (size_t i = 0; i < NUMBER_SPOOLS; i++)
-    {
-        Spool *pS = gSpoolMgr.GetSpool(i);
-        doc["FILAMENT_TYPES"][i]     = pS->GetType();
-        doc["SPOOL_DENSITY"][i]      = pS->GetDensity();
-        doc["SPOOL_NAMES"][i]        = pS->GetName();
-        doc["SPOOL_WEIGHTS"][i]      = pS->GetSpoolWeight();
-        doc["FILAMENT_DIAMETERS"][i] = pS->GetDiameter();
-        doc["COLORS"][i]             = Rgb565ToHexString(pS->GetColor());
-    }
-
-    // Send our density table data.
-    for (size_t i = 0; i < static_cast<int>(eFtCount); i++)
-    {
-        doc["DENSITY"][i] =
-            gFilament.GetDensity(static_cast<FilamentType>(i));
-    }
-
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-} // End SendSpoolFormData().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SaveSpoolFormData()
-//
-// Called when the client wants to save any changes made to the spool options.
-// Updates the display options as requested by the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void SaveSpoolFormData()
-{
-    uint16_t response = 200;    // Assume OK response.
-
-    StaticJsonDocument<300> JsonDoc;
-    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
-    if (error)
-    {
-        Serial.print("deserializeJson() failed with code ");
-        Serial.println(error.c_str());
-        response = 400; // BAD REQUEST response.
-    }
-    else
-    {
-        // Point to the selected spool.
-        uint32_t thisSpoolIndex = JsonDoc["spoolIndex"];
-        Spool *pSpool = gSpoolMgr.GetSpool(thisSpoolIndex);
-
-        uint32_t selectedSpoolIndex = gSpoolMgr.GetSelectedSpoolIndex();
-        bool thisSpoolSelected = JsonDoc["spoolSelected"];
-        if (thisSpoolSelected)
-        {
-            gSpoolMgr.SelectSpool(thisSpoolIndex);
-        }
-        else if (thisSpoolIndex == selectedSpoolIndex)
-        {
-            gSpoolMgr.DeselectSpool();
-        }
-
-        // Set the selected spool's data per the request.
-
-        // Before we save the (possibly) new spool name, we need to remove any
-        // trailing spaces from it.
-        strlcpy(gWorkingSpoolData.m_Name, (const char *)JsonDoc["spoolIdData"],
-                Spool::MAX_NAME_SIZE + 1);
-        size_t nameLength = strlen(gWorkingSpoolData.m_Name);
-        if (nameLength)
-        {
-            while (gWorkingSpoolData.m_Name[--nameLength] == ' ')
-            {}
-            gWorkingSpoolData.m_Name[++nameLength] = '\0';
-        }
-        pSpool->SetName(gWorkingSpoolData.m_Name);
-
-        float spoolWeight = JsonDoc["spoolWeightData"];
-        pSpool->SetSpoolWeight(spoolWeight);
-        gLoadCell.SetOffset(spoolWeight);
-        gWorkingSpoolData.m_SpoolWeight = spoolWeight;
-
-        FilamentType filamentType =
-            static_cast<FilamentType>(JsonDoc["filamentTypeData"]);
-        pSpool->SetType(filamentType);
-        gWorkingSpoolData.m_Type = filamentType;
-
-        float density = JsonDoc["spoolDensity"];
-        pSpool->SetDensity(density);
-        gWorkingSpoolData.m_Density = density;
-
-        float filamentDiameter = JsonDoc["filamentDiaData"];
-        pSpool->SetDiameter(filamentDiameter);
-        gWorkingSpoolData.m_Diameter = filamentDiameter;
-
-        char buf[8];
-        strlcpy(buf, (const char *)JsonDoc["colorData"], sizeof(buf));
-        pSpool->SetColor(HexStringToRgb565(buf));
-        gWorkingSpoolData.m_Color = pSpool->GetColor();
-
-        // Update the spool offset just in case it changed.
-        SaveSpoolOffset();
-
-        // Update the length factor.
-        UpdateLengthFactor();
-    }
-
-    // Let the system know that data has changed.
-    gDataUpdated = true;
-
-    // Send a response to the client.
-    gNetwork.send(response, "text/html");
-} // End SaveSpoolFormData().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SendDensityFormData()
-//
-// Called when the client opens the Filament Options form.  Sends current values
-// of all form data to the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void SendDensityFormData()
-{
-    String webPage;
-    DynamicJsonDocument doc(400);
-    bool locked = gWebLock.Lock(WEB_OWNER);
-    doc["LOCKED"] = locked;
-    doc["MAX_DENSITY"] = Filament::MAX_DENSITY;
-    doc["MIN_DENSITY"] = Filament::MIN_DENSITY;
-    Spool *pSpool = gSpoolMgr.GetSelectedSpool();
-    FilamentType type = eFtPla;
-    if (pSpool != NULL)
-    {
-        type = pSpool->GetType();
-    }
-    doc["FILEMANT_TYPE"] = type;
-    for (int i = 0; i < static_cast<int>(eFtCount); i++)
-    {
-        doc["DENSITY"][i] =
-            gFilament.GetDensity(static_cast<FilamentType>(i));
-    }
-
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-} // End SendDensityFormData().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// SaveDensityFormData()
-//
-// Called when the client wants to save any changes made to the filament options.
-// Updates the display options as requested by the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void SaveDensityFormData()
-{
-    uint16_t response = 200;    // Assume OK response.
-
-    StaticJsonDocument<300> JsonDoc;
-    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
-    if (error)
-    {
-        Serial.print("deserializeJson() failed with code ");
-        Serial.println(error.c_str());
-        response = 400; // BAD REQUEST response.
-    }
-    else
-    {
-        // Get the selected filament type.
-        FilamentType type =
-            static_cast<FilamentType>(JsonDoc["filamentTypeData"]);
-        float newDensity = JsonDoc["densityData"];
-
-        Spool *pSpool = gSpoolMgr.GetSelectedSpool();
-        if (pSpool && (pSpool->GetType() == type))
-        {
-            gWorkingFilamentDensity = newDensity;
-            gFilament.SetDensity(type, newDensity);
-
-            // Update the length factor.
-            UpdateLengthFactor();
-        }
-        else
-        {
-            // Set the new density.
-            gFilament.SetDensity(type, newDensity);
-        }
-    }
-
-    // Let the system know that data has changed.
-    gDataUpdated = true;
-
-    // Send a successful response to the client.
-    gNetwork.send(response, "text/html");
-} // End SaveDensityFormData().
-
-
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleDoSave()
-//
-// Called when the client requests a save operation.  Performs
-// the save and returns the success/failre results to the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleDoSave()
-{
-    bool result = SaveToNvs();
-    String webPage;
-    DynamicJsonDocument doc(100);
-    doc["SAVE_RESULT"] = result;
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-
-    if (result)
-    {
-        // Unlock our mutex.
-        gWebLock.Unlock();
-    }
-} // End HandleDoSave().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleDoRestore()
-//
-// Called when the client requests a restore operation.  Performs
-// the  restore and returns the success/failre results to the client.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleDoRestore()
-{
-    bool result = RestoreFromNvs();
-    String webPage;
-    DynamicJsonDocument doc(100);
-    doc["RESTORE_RESULT"] = result;
-    serializeJson(doc, webPage);
-    gNetwork.send(200, "text/html", webPage);
-
-    if (result)
-    {
-        // Unlock our mutex.
-        gWebLock.Unlock();
-        // Let the system know that data has changed.
-        gDataUpdated = true;
-    }
-} // End HandleDoRestore().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleDoRestart()
-//
-// Called when the client requests a restart operation.  Returns a successful
-// response to the client and initiates the restart.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleDoRestart()
-{
-    gNetwork.send(200, "text/html");
-    delay(500);
-    ESP.restart();
-} // End HandleDoRestart().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleDoReset()
-//
-// Called when the client requests a reset operation.  Returns a successful
-// response to the client and initiates the reset.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleDoReset()
-{
-    gNetwork.send(200, "text/html");
-    delay(500);
-    ResetNvs();
-} // End HandleDoReset().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// HandleDoResetNet()
-//
-// Called when the client requests a reset net operation.  Returns a successful
-// response to the client and initiates the reset.
-/////////////////////////////////////////////////////////////////////////////////
-static void HandleDoResetNet()
-{
-    gNetwork.send(200, "text/html");
-    delay(1000);
-    gNetwork.ResetCredentials();
-    delay(1000);
-    RestartSystem();
-} // End HandleDoResetNet().
-
-
-/////////////////////////////////////////////////////////////////////////////////
-// InitNetworkHandlers()
-//
-// Called at power-up to initialize the handling of client requests.  Sets up
-// a handler for each of the URLs that are expected to be received from the
-// network client.
-/////////////////////////////////////////////////////////////////////////////////
-void WebData::InitNetworkHandlers()
-{
-    // MAIN PAGE
-    gNetwork.on("/", HandleRoot);
-    gNetwork.on("/getMainPageData", HandleMainPageData);
-
-    // DISPLAY OPTIONS FORM
-    gNetwork.on("/getDisplayFormData", SendDisplayFormData);
-    gNetwork.on("/updateDisplayData", SaveDisplayFormData);
-
-    // SCALE OPTIONS FORM
-    gNetwork.on("/getScaleFormData", SendScaleFormData);
-    gNetwork.on("/updateScaleData", SaveScaleFormData);
-    gNetwork.on("/doTare",  HandleDoTare);
-    gNetwork.on("/doScaleCalibrate", HandleDoScaleCalibrate);
-
-    // SPOOL OPTIONW FORM
-    gNetwork.on("/getSpoolFormData", SendSpoolFormData);
-    gNetwork.on("/updateSpoolData", SaveSpoolFormData);
-
-    // FILAMENT (DENSITY) OPTIONS FORM
-    gNetwork.on("/getDensityFormData", SendDensityFormData);
-    gNetwork.on("/updateDensityData", SaveDensityFormData);
-
-    // SAVE / RESTORE / RESET OPTIONS FORM
-    gNetwork.on("/doSave", HandleDoSave);
-    gNetwork.on("/doRestore", HandleDoRestore);
-    gNetwork.on("/doRestart", HandleDoRestart);
-    gNetwork.on("/doReset", HandleDoReset);
-    gNetwork.on("/doResetNet", HandleDoResetNet);
-
-    // UTILITIES
-    gNetwork.on("/lockOptions", HandleLockOptions);
-    gNetwork.on("/unlockOptions", HandleUnlockOptions);
-    gNetwork.onNotFound(HandleNotFound);
-} // End InitNetworkHandlers().
-
+/////////////////////////////////////////////////////////////////////////////////
+// WebData.cpp
+//
+// Contains functions to handle web requests from the web client.
+//
+// History:
+// - jmcorbett 01-JUN-2021 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#include "JmcFilamentScale.h"   // For application related data.
+#include "SimpleLock.h"         // For options locking SimpleLock class.
+#include <ArduinoJson.h>        // For JSON handling.
+#include "WebPages.h"           // For the data of the main web page display.
+#include "WebData.h"            // Our own declarations.
+#include "MainScreen.h"         // For MainScreen class.
+#include "Spool.h"              // For MAX_NAME_SIZE.
+#include "NvsStore.h"           // For deferred NVS saves.
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Web options locking related globals.
+/////////////////////////////////////////////////////////////////////////////////
+SimpleLock gWebLock;            // Lock to only allow setup changes one source at
+                                // a time (web or local).
+static uint32_t gWebWdTime = 0; // Last web message receipt time (ms).
+static const uint32_t WEB_WD_TIMEOUT_MS = 10000;
+                                // Timeout if this amount of milliseconds pass
+                                // between web messages. (10 seconds)
+// Constants defining web lock ownership values.
+static const uint32_t LOCAL_OWNER = 1UL;
+static const uint32_t WEB_OWNER   = 2UL;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WebData::LockLocal()
+//
+// Attempt to acquire the local/network options lock for the local device.
+//
+// Returns:
+//      Returns 'true' if the lock was acquired successfully.  Returns 'false'
+//      otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool WebData::LockLocal()
+{
+    return gWebLock.Lock(LOCAL_OWNER);
+} // End LockLocal().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WebData::IsLocalOwner()
+//
+// Returns true if owner of the lock is LOCAL_OWNER.
+//
+// Returns:
+//      Returns 'true' if the lock is currently owned by LOCAL_OWNER.
+/////////////////////////////////////////////////////////////////////////////////
+bool WebData::IsLocalOwner()
+{
+    return gWebLock.Owner() == LOCAL_OWNER;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// WebData::Unlock()
+//
+// Releases the local/network options lock.
+/////////////////////////////////////////////////////////////////////////////////
+void WebData::Unlock()
+{
+    gWebLock.Unlock();
+} // End Unlock().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleWebTimeout()
+//
+// The web lock is used to insure that a web client and the local user cannot
+// attempt to modify any options at the same time.  When the web client has an
+// options page displayed, it takes ownership of the web lock.  This prevents the
+// local user from entering the options menu.  If the web client goes away while
+// owning the web lock, this could prevent the local user from ever being able
+// to enter the options menu.  To prevent this, each time an update messsage is
+// received from a web client, we remember the time at which it arrives.  The
+// main loop calls this function every iteration to verify that the client
+// connection is still alive.  If too much time has passed, then it is assumed
+// that the connection is lost, so if the web client was the owner of the lock,
+// it is unlocked.
+/////////////////////////////////////////////////////////////////////////////////
+void WebData::HandleWebTimeout()
+{
+    // If the web owned our options mutex and we haven't seen a message from
+    // it for a while, then unlock the mutex.
+    if ((gWebLock.Owner() == WEB_OWNER) &&
+        ((millis() - gWebWdTime) > WEB_WD_TIMEOUT_MS))
+    {
+        gWebLock.Unlock();
+    }
+} // End HandleWebTimeout().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Rgb565ToHexString()
+//
+// Converts an RGB565 color value to a hex string suitable for javascript use.
+//
+// Arguments:
+//   color - this is the RGB565 color value to be converted.
+//
+// Returns:
+//   Returns a pointer to the static buffer that contains the converted color
+//   hexadecimal string.
+//
+// Note: This function returns a pointer to a static buffer, and so is not
+// reentrant.
+/////////////////////////////////////////////////////////////////////////////////
+static char *Rgb565ToHexString(uint16_t color)
+{
+    static char buf[8];
+    uint8_t r, g, b;
+    r = ((color >> 11) << 3) | 7;
+    g = ((color >> 5)  << 2) | 3;
+    b = (color << 3) | 7;
+    sprintf(buf, "#%02x%02x%02x", r, g, b);
+    return buf;
+} // End Rgb565ToHexString().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HexStringToRgb565()
+//
+// Arguments:
+//   pColor - This is a pointer to the hex color string to be converted.  Note
+//            that it is assumed that this string is of the form of a javascript
+//            color (i.e. #hhhhhh).
+//
+// Returns:
+//   Returns the RGB565 value corresponding to the referenced color string.
+/////////////////////////////////////////////////////////////////////////////////
+static uint16_t HexStringToRgb565(const char *pColor)
+{
+    uint32_t val = strtol(pColor + 1, NULL, 16);
+    return static_cast<uint16_t>(MYRGB565((val >> 16) & 0xff, (val >> 8) & 0xff, val & 0xff));
+} // End HexStringToRgb565().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleNotFound()
+//
+// Handles receipt of unknown network messages by displaying an error message
+// on the network client.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleNotFound()
+{
+    // Setup the "not found" message along with the unknown URI and method.
+    String message = "File Not Found\n\n";
+    message += "URI: ";
+    message += gNetwork.uri();
+    message += "\nMethod: ";
+    message += (gNetwork.method() == HTTP_GET) ? "GET" : "POST";
+
+    // Collect any arguments to the request.
+    message += "\nArguments: ";
+    message += gNetwork.args();
+    message += "\n";
+    for (uint8_t i = 0; i < gNetwork.args(); i++)
+    {
+        message += " " + gNetwork.argName(i) + ": " + gNetwork.arg(i) + "\n";
+    }
+
+    // Send diagnostic to the monitor.
+    Serial.println("WEB PAGE NOT FOUND");
+    Serial.println(message);
+
+    // Send the data to the client.
+    gNetwork.send(404, "text/plain", message);
+} // End HandleNotFound().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleLockOptions()
+//
+// Called when the client requests that the options be locked.  Checks if option
+// settings are currently locked.  Replies to the request with a "LOCKED" status
+// of true if options were not previously locked, and gives the client exclusive
+// use of the setting/changing of the options.  Replies with a "LOCKED" status
+// of false if options were already locked, and denies the client use of
+// setting/changing of the options.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleLockOptions()
+{
+    String webPage;
+    DynamicJsonDocument doc(100);
+    bool locked = gWebLock.Lock(WEB_OWNER);
+    doc["LOCKED"] = locked;
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+} // End HandleLockOptions().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleUnlockOptions()
+//
+// Unlocks the setting/changing of options so that others may change them.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleUnlockOptions()
+{
+    gWebLock.Unlock();
+    gNetwork.send(200, "text/html");
+} // End HandleUnlockOptions().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleRoot()
+//
+// Called when the client connects to the server.  Sends the root page to the
+// client.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleRoot()
+{
+    Serial.println("--------------------------- GOT A HIT! ---------------------");
+    gNetwork.send(200, "text/html", gRootPage);
+} // End HandleRoot().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleMainPageData()
+//
+// Called when the client requests a refresh of the main page data.  Updates all
+// of the relevant fields of the main page based on current values.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleMainPageData()
+{
+    // Remember the current time for handling the web watchdog.
+    gWebWdTime = millis();
+
+    String webPage;
+    DynamicJsonDocument doc(1536);
+
+    // NET WEIGHT
+    doc["WEIGHT"]           = gCurrentWeight;
+    doc["WEIGHT_UNITS"]     = gLoadCell.GetUnitsString();
+    doc["WEIGHT_PRECISION"] = GetWeightDecimalPlaces();
+    doc["WEIGHT_STABLE"]    = gStability.IsStable();
+    doc["LOAD_CHANGES"]     = gStability.GetLoadChangeCount();
+
+    // TEMPERATURE
+    if (isnan(gCurrentTemperature))
+    {
+        doc["TEMPERATURE"]  = "-";
+    }
+    else
+    {
+        doc["TEMPERATURE"]  = gCurrentTemperature;
+    }
+    doc["TEMPERATURE_UNITS"]     = &gEnvSensor.GetTempScaleString()[1];
+    doc["TEMPERATURE_PRECISION"] = gTemperatureUnits == eTempScaleF ? 0 : 1;
+
+    // HUMIDITY
+    if (isnan(gCurrentHumidity))
+    {
+        doc["HUMIDITY"] = "-";
+    }
+    else
+    {
+        doc["HUMIDITY"] = gCurrentHumidity;
+    }
+
+    // UP TIME
+    doc["UPTIME"] = millis();
+
+    // IP ADDRESS
+    IPAddress ip = WiFi.localIP();
+    String ipString = String(ip[0]) + String(".") +
+                      String(ip[1]) + String(".") +
+                      String(ip[2]) + String(".") +
+                      String(ip[3]);
+    doc["IP_ADDRESS"] = ipString;
+
+    // WEB ID
+    doc["WEB_ID"] = String(rNetworkServerName) + ".local";
+
+    // SIGNAL STRENGTH
+    doc["SIGNAL_STRENGTH"] = WiFi.RSSI();
+
+    // If a spool is currently selected then send the corresponding fields.
+    Spool *pSelectedSpool = gSpoolMgr.GetSelectedSpool();
+    doc["SPOOL_SELECTED"] = (pSelectedSpool != NULL);
+    if (pSelectedSpool != NULL)
+    {
+        // SPOOL RELATED VALUES
+        char buf[Filament::TYPE_LSTRING_MAX_SIZE];
+        FilamentType type = pSelectedSpool->GetType();
+        doc["SPOOL_WEIGHT"]      = pSelectedSpool->GetSpoolWeight();
+        doc["FILEMANT_TYPE"]     = gFilament.GetTypeLString(type, buf);
+        doc["FILAMENT_DIAMETER"] = pSelectedSpool->GetDiameter();
+        doc["SPOOL_NAME"]        = pSelectedSpool->GetName();
+        doc["FILAMENT_DENSITY"]  = pSelectedSpool->GetDensity();
+
+        // LENGTH
+        doc["LENGTH"]           = gCurrentLength;
+        doc["LENGTH_UNITS"]     = gLengthMgr.GetUnitsString();
+        doc["LENGTH_PRECISION"] = gLengthMgr.GetPrecision();
+
+        // FILAMENT COLOR
+        doc["FILAMENT_COLOR"]   = Rgb565ToHexString(pSelectedSpool->GetColor());
+
+        // USAGE RATE AND TIME TO EMPTY - the time is -1 if there is no
+        // estimate.
+        doc["USE_RATE_VALID"]   = gConsumption.HasRate();
+        doc["USE_RATE"]         = gConsumption.GetGramsPerMin();
+        doc["USE_RATE_LENGTH"]  = gConsumption.GetLengthPerMin();
+        doc["TIME_TO_EMPTY"]    = gConsumption.GetSecondsToEmpty();
+
+        // FILAMENT USED FROM THE SPOOL - from the usage journal, valid only if
+        // the journal is.
+        float usedGrams = gJournal.GetUsage(
+            static_cast<uint8_t>(gSpoolMgr.GetSelectedSpoolIndex())).m_UsedGrams;
+        doc["SPOOL_USED_VALID"]  = gJournal.IsReady() &&
+            (gSpoolMgr.GetSelectedSpoolIndex() < UsageJournal::MAX_SPOOLS);
+        doc["SPOOL_USED"]        = usedGrams;
+        doc["SPOOL_USED_LENGTH"] = usedGrams * gConsumption.GetLengthPerGram();
+    }
+
+    // CHANNELS - only sent for a scale bank.
+    if (gLoadCellArray.GetNumChannels() > 1U)
+    {
+        JsonArray channels = doc.createNestedArray("CHANNELS");
+        for (uint8_t ch = 0U; ch < gLoadCellArray.GetNumChannels(); ch++)
+        {
+            JsonObject channel = channels.createNestedObject();
+            Spool *pSpool = gSpoolMgr.GetSpool(gLoadCellArray.GetSlot(ch));
+            channel["PRESENT"]    = gLoadCellArray.IsPresent(ch);
+            channel["RESPONDING"] = gLoadCellArray.IsResponding(ch);
+            channel["CALIBRATED"] = gLoadCellArray.GetCell(ch)->IsCalibrated();
+            channel["WEIGHT"]     = gLoadCellArray.GetWeight(ch);
+            channel["SLOT"]       = gLoadCellArray.GetSlot(ch);
+            channel["SPOOL_NAME"] = (pSpool != NULL) ? pSpool->GetName() : "-";
+        }
+    }
+
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+} // End HandleMainPageData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryPoints collects the samples sent by HandleGetHistory().  Every
+// m_Stride'th sample is sent, up to HISTORY_MAX_POINTS of them.
+/////////////////////////////////////////////////////////////////////////////////
+static const size_t HISTORY_MAX_POINTS = 240U;
+
+struct HistoryPoints
+{
+    JsonArray m_Times;                  // History seconds.
+    JsonArray m_Weights;                // Grams.
+    JsonArray m_Temperatures;           // Selected temperature scale.
+    JsonArray m_Humidities;             // Percent.
+    uint32_t  m_Stride;                 // Samples per point.
+    uint32_t  m_Skip;                   // Samples to skip before the next.
+    size_t    m_Count;                  // Points added.
+    int32_t   m_NextS;                  // Where a follow up request starts.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddHistoryValue()
+//
+// Adds a history value to an array, as null if it is missing.
+/////////////////////////////////////////////////////////////////////////////////
+static void AddHistoryValue(JsonArray &rArray, float value)
+{
+    if (isnan(value))
+    {
+        rArray.add();
+    }
+    else
+    {
+        rArray.add(value);
+    }
+} // End AddHistoryValue().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddHistoryPoint()
+//
+// HistoryVisitor that adds a sample to a HistoryPoints.  Stops the visit, noting
+// where to carry on, once the response is full.
+/////////////////////////////////////////////////////////////////////////////////
+static bool AddHistoryPoint(uint32_t timeS, const HistorySample &rSample, void *pArg)
+{
+    HistoryPoints *pPoints = static_cast<HistoryPoints *>(pArg);
+    if (pPoints->m_Skip > 0UL)
+    {
+        pPoints->m_Skip--;
+        return true;
+    }
+    if (pPoints->m_Count >= HISTORY_MAX_POINTS)
+    {
+        pPoints->m_NextS = static_cast<int32_t>(timeS);
+        return false;
+    }
+
+    float temperature = rSample.m_DegreesC;
+    if (gTemperatureUnits == eTempScaleF)
+    {
+        temperature = gEnvSensor.ConvertCtoF(temperature);
+    }
+    pPoints->m_Times.add(timeS);
+    AddHistoryValue(pPoints->m_Weights, rSample.m_Grams);
+    AddHistoryValue(pPoints->m_Temperatures, temperature);
+    AddHistoryValue(pPoints->m_Humidities, rSample.m_Humidity);
+    pPoints->m_Count++;
+    pPoints->m_Skip = pPoints->m_Stride - 1UL;
+    return true;
+} // End AddHistoryPoint().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetHistoryRange()
+//
+// Parses the time range and tier arguments of a history request.  Times are
+// history seconds (see History.h).  The arguments are all optional:
+//    - last - Seconds back from now to start at (default defaultLastS), or
+//    - from - History seconds to start at, and
+//    - to   - History seconds to end before (default now).
+//    - tier - 0 (seconds), 1 (minutes) or 2 (hours).  By default, the finest
+//             tier that reaches back far enough.
+//
+// Arguments:
+//    - defaultLastS - The range to use without 'last' or 'from'.
+//    - rFromS       - Set to the start of the range.
+//    - rToS         - Set to the end of the range.
+//    - rTier        - Set to the tier.
+//
+// Returns:
+//    Returns 'true' if the arguments are valid, or 'false' (after sending a
+//    BAD REQUEST response) otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+static bool GetHistoryRange(uint32_t defaultLastS, uint32_t &rFromS,
+                            uint32_t &rToS, size_t &rTier)
+{
+    rToS = gHistory.GetNow() + 1UL;
+    if (gNetwork.hasArg("to"))
+    {
+        rToS = static_cast<uint32_t>(gNetwork.arg("to").toInt());
+    }
+    if (gNetwork.hasArg("from"))
+    {
+        rFromS = static_cast<uint32_t>(gNetwork.arg("from").toInt());
+    }
+    else
+    {
+        uint32_t lastS = gNetwork.hasArg("last") ?
+                         static_cast<uint32_t>(gNetwork.arg("last").toInt()) :
+                         defaultLastS;
+        rFromS = (lastS < rToS) ? rToS - lastS : 0UL;
+    }
+    rTier = gNetwork.hasArg("tier") ?
+            static_cast<size_t>(gNetwork.arg("tier").toInt()) :
+            gHistory.PickTier(rFromS);
+    if ((rFromS >= rToS) || (rTier >= History::NUM_TIERS))
+    {
+        gNetwork.send(400, "text/html");
+        return false;
+    }
+    return true;
+} // End GetHistoryRange().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleGetHistory()
+//
+// Called when the client requests the weight and environment history for the
+// graph.  NOW in the response is the current history time.  The range is
+// given as described for GetHistoryRange(), by default the last hour.  Long
+// ranges are thinned to about HISTORY_MAX_POINTS points.  If there were still
+// more, NEXT is where to start a follow up request (otherwise -1).
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleGetHistory()
+{
+    uint32_t fromS = 0UL;
+    uint32_t toS   = 0UL;
+    size_t   tier  = 0U;
+    if (!GetHistoryRange(3600UL, fromS, toS, tier))
+    {
+        return;
+    }
+
+    // Thin the samples so that the whole range fits.
+    const HistoryTier &rTier = gHistory.GetTier(tier);
+    uint32_t samples = (toS - fromS + rTier.GetPeriod() - 1UL) / rTier.GetPeriod();
+    uint32_t stride  = (samples + HISTORY_MAX_POINTS - 1UL) / HISTORY_MAX_POINTS;
+
+    String webPage;
+    DynamicJsonDocument doc(4U * JSON_ARRAY_SIZE(HISTORY_MAX_POINTS) +
+                            JSON_OBJECT_SIZE(10) + 128U);
+    HistoryPoints points;
+    points.m_Times        = doc.createNestedArray("T");
+    points.m_Weights      = doc.createNestedArray("WEIGHT");
+    points.m_Temperatures = doc.createNestedArray("TEMPERATURE");
+    points.m_Humidities   = doc.createNestedArray("HUMIDITY");
+    points.m_Stride       = (stride > 0UL) ? stride : 1UL;
+    points.m_Skip         = 0UL;
+    points.m_Count        = 0U;
+    points.m_NextS        = -1L;
+    rTier.Visit(fromS, toS, AddHistoryPoint, &points);
+
+    doc["NOW"]               = gHistory.GetNow();
+    doc["TIER"]              = tier;
+    doc["PERIOD"]            = rTier.GetPeriod() * points.m_Stride;
+    doc["OLDEST"]            = rTier.GetOldestTime();
+    doc["NEXT"]              = points.m_NextS;
+    doc["TEMPERATURE_UNITS"] = &gEnvSensor.GetTempScaleString()[1];
+
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+} // End HandleGetHistory().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryExport buffers an export into chunks, so that the response is sent
+// as it is made rather than built up in the heap first.
+/////////////////////////////////////////////////////////////////////////////////
+static const size_t EXPORT_CHUNK_SIZE = 1024U;
+
+struct HistoryExport
+{
+    char     m_Buffer[EXPORT_CHUNK_SIZE];
+    size_t   m_Used;                    // Bytes in m_Buffer.
+    double   m_LengthPerGram;           // 0 if no spool is selected.
+    uint8_t  m_LengthPrecision;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ExportFlush()
+//
+// Sends the buffered bytes as a chunk.
+/////////////////////////////////////////////////////////////////////////////////
+static void ExportFlush(HistoryExport &rExport)
+{
+    if (rExport.m_Used > 0U)
+    {
+        gNetwork.sendContent(rExport.m_Buffer, rExport.m_Used);
+        rExport.m_Used = 0U;
+    }
+} // End ExportFlush().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ExportWrite()
+//
+// Adds bytes to the export, sending a chunk first if they won't fit.
+//
+// Arguments:
+//    - rExport - The export.
+//    - pData   - The bytes.
+//    - size    - How many.  At most EXPORT_CHUNK_SIZE.
+/////////////////////////////////////////////////////////////////////////////////
+static void ExportWrite(HistoryExport &rExport, const void *pData, size_t size)
+{
+    if (rExport.m_Used + size > sizeof(rExport.m_Buffer))
+    {
+        ExportFlush(rExport);
+    }
+    memcpy(&rExport.m_Buffer[rExport.m_Used], pData, size);
+    rExport.m_Used += size;
+} // End ExportWrite().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// FormatCsvValue()
+//
+// Formats a CSV field, leaving it empty if the value is missing.
+//
+// Arguments:
+//    - pBuf      - Where to write the field and its leading comma.
+//    - size      - Size of the buffer.
+//    - value     - The value.
+//    - precision - Decimal places.
+//
+// Returns:
+//    Returns the number of characters written.
+/////////////////////////////////////////////////////////////////////////////////
+static size_t FormatCsvValue(char *pBuf, size_t size, float value, int precision)
+{
+    int length = isnan(value) ? snprintf(pBuf, size, ",") :
+                                snprintf(pBuf, size, ",%.*f", precision, value);
+    return ((length > 0) && (static_cast<size_t>(length) < size)) ? length : 0U;
+} // End FormatCsvValue().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ExportCsvLine()
+//
+// HistoryVisitor that adds a sample to a CSV export.
+/////////////////////////////////////////////////////////////////////////////////
+static bool ExportCsvLine(uint32_t timeS, const HistorySample &rSample, void *pArg)
+{
+    HistoryExport *pExport = static_cast<HistoryExport *>(pArg);
+    float length = NAN;
+    if (pExport->m_LengthPerGram != 0.0d)
+    {
+        length = rSample.m_Grams * pExport->m_LengthPerGram;
+    }
+    float temperature = rSample.m_DegreesC;
+    if (gTemperatureUnits == eTempScaleF)
+    {
+        temperature = gEnvSensor.ConvertCtoF(temperature);
+    }
+
+    char line[96];
+    size_t used = snprintf(line, sizeof(line), "%lu", static_cast<unsigned long>(timeS));
+    used += FormatCsvValue(&line[used], sizeof(line) - used, rSample.m_Grams, 1);
+    used += FormatCsvValue(&line[used], sizeof(line) - used, length,
+                           pExport->m_LengthPrecision);
+    used += FormatCsvValue(&line[used], sizeof(line) - used, temperature, 1);
+    used += FormatCsvValue(&line[used], sizeof(line) - used, rSample.m_Humidity, 1);
+    used += snprintf(&line[used], sizeof(line) - used, "\r\n");
+    ExportWrite(*pExport, line, used);
+    return true;
+} // End ExportCsvLine().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ExportBlock()
+//
+// HistoryBlockVisitor that adds a block, as stored, to a binary export.  Only
+// the key frame and the deltas in use are sent.
+/////////////////////////////////////////////////////////////////////////////////
+static bool ExportBlock(const HistoryBlock &rBlock, void *pArg)
+{
+    HistoryExport *pExport = static_cast<HistoryExport *>(pArg);
+    ExportWrite(*pExport, &rBlock, HistoryBlock::KEY_SIZE +
+                (rBlock.m_Count - 1U) * sizeof(HistoryDelta));
+    return true;
+} // End ExportBlock().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HistoryExportHeader starts a binary export.  All values are little endian.
+/////////////////////////////////////////////////////////////////////////////////
+struct HistoryExportHeader
+{
+    char     m_Magic[4];                // "JMCH".
+    uint8_t  m_Version;                 // 1.
+    uint8_t  m_Tier;                    // Tier the blocks are from.
+    uint16_t m_KeySize;                 // Bytes in a block's key frame.
+    uint32_t m_PeriodS;                 // Seconds between samples.
+    uint32_t m_NowS;                    // Current history time.
+    float    m_LengthPerGram;           // Length units per gram, 0 if none.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleExportHistory()
+//
+// Called when the client asks to download the history.  The range is given as
+// described for GetHistoryRange(), by default the last 30 days, and 'format'
+// is 'csv' (the default) or 'bin'.  The response is sent with chunked transfer
+// encoding as the samples are read, through one EXPORT_CHUNK_SIZE buffer.
+//
+// The CSV has a header line and one line per sample: the time, weight (g),
+// length (selected units, empty if no spool is selected), temperature
+// (selected scale) and humidity (%).  Missing values are left empty.  The
+// length is worked out with the selected spool's filament.
+//
+// The binary export is a HistoryExportHeader followed by the tier's blocks
+// straight from memory: each is the KEY_SIZE byte key frame of HistoryBlock
+// followed by m_Count - 1 HistoryDeltas (see HistoryTier.h for decoding).
+// Whole blocks are sent, so the first and last may reach outside the range.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleExportHistory()
+{
+    uint32_t fromS = 0UL;
+    uint32_t toS   = 0UL;
+    size_t   tier  = 0U;
+    if (!GetHistoryRange(History::TIER_SPANS_S[History::NUM_TIERS - 1U],
+                         fromS, toS, tier))
+    {
+        return;
+    }
+    bool binary = gNetwork.arg("format") == "bin";
+    const HistoryTier &rTier = gHistory.GetTier(tier);
+
+    HistoryExport historyExport;
+    historyExport.m_Used            = 0U;
+    historyExport.m_LengthPerGram   = (gSpoolMgr.GetSelectedSpool() != NULL) ?
+                                      gConsumption.GetLengthPerGram() : 0.0d;
+    historyExport.m_LengthPrecision = gLengthMgr.GetPrecision();
+
+    gNetwork.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    gNetwork.sendHeader("Content-Disposition", binary ?
+                        "attachment; filename=history.bin" :
+                        "attachment; filename=history.csv");
+    gNetwork.send(200, binary ? "application/octet-stream" : "text/csv", "");
+    if (binary)
+    {
+        HistoryExportHeader header;
+        memcpy(header.m_Magic, "JMCH", sizeof(header.m_Magic));
+        header.m_Version       = 1U;
+        header.m_Tier          = static_cast<uint8_t>(tier);
+        header.m_KeySize       = HistoryBlock::KEY_SIZE;
+        header.m_PeriodS       = rTier.GetPeriod();
+        header.m_NowS          = gHistory.GetNow();
+        header.m_LengthPerGram = static_cast<float>(historyExport.m_LengthPerGram);
+        ExportWrite(historyExport, &header, sizeof(header));
+        rTier.VisitBlocks(fromS, toS, ExportBlock, &historyExport);
+    }
+    else
+    {
+        char line[96];
+        size_t used = snprintf(line, sizeof(line),
+                               "time_s,weight_g,length_%s,temperature_%s,humidity_pct\r\n",
+                               gLengthMgr.GetUnitsString(),
+                               &gEnvSensor.GetTempScaleString()[1]);
+        ExportWrite(historyExport, line, used);
+        rTier.Visit(fromS, toS, ExportCsvLine, &historyExport);
+    }
+    ExportFlush(historyExport);
+
+    // An empty chunk ends the response.
+    gNetwork.sendContent("");
+} // End HandleExportHistory().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SendDisplayFormData()
+//
+// Called when the client opens the Display Options form.  Sends current values
+// of all form data to the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void SendDisplayFormData()
+{
+    DynamicJsonDocument doc(256);
+    bool locked = gWebLock.Lock(WEB_OWNER);
+    doc["LOCKED"] = locked;
+    doc["WEIGHT_UNITS"]        = gLoadCell.GetUnits();
+    doc["LENGTH_UNITS"]        = gLengthMgr.GetSelected();
+    doc["TEMPERATURE_UNITS"]   = gEnvSensor.GetTempScale();
+    doc["BRIGHTNESS"]          = gTft.GetBacklightPercent();
+    doc["SCROLL_DELAY_S"]      = MainScreen::GetScrollDelayMs() / 1000;
+    doc["MAX_SCROLL_DELAY_S"]  = MainScreen::MAX_SCROLL_DELAY_SEC;
+    doc["SCROLL_DELAY_STEP_S"] = MainScreen::SCROLL_DELAY_STEP_SEC;
+
+    String webPage;
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+} // End SendDisplayFormData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveDisplayFormData()
+//
+// Called when the client wants to save any changes made to the display options.
+// Updates the display options as requested by the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void SaveDisplayFormData()
+{
+    uint16_t response = 200;    // Assume OK response.
+
+    StaticJsonDocument<300> JsonDoc;
+    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
+    if (error)
+    {
+        Serial.print("deserializeJson() failed with code ");
+        Serial.println(error.c_str());
+        response = 400; // BAD REQUEST response.
+    }
+    else
+    {
+        // Update our display parameters.
+        gScaleUnits = static_cast<WeightUnits>(JsonDoc["weightUnitsData"]);
+        SetLoadCellUnits(gScaleUnits);
+
+        gLengthUnits = static_cast<LengthUnits>(JsonDoc["lengthUnitsData"]);
+        UpdateLengthFactorEntry();
+
+        gTemperatureUnits = static_cast<TempScale>(JsonDoc["tempUnitsData"]);
+        gEnvSensor.SetTempScale(gTemperatureUnits);
+
+        gBacklightPercent = static_cast<uint32_t>(JsonDoc["brightnessData"]);
+        gTft.SetBacklightPercent(gBacklightPercent);
+
+        MainScreen::SetScrollDelayMs(static_cast<uint32_t>(JsonDoc["scrollDelayData"]) * 1000);
+    }
+
+    // Send a response to the client.
+    gNetwork.send(response, "text/html");
+
+    // Let the system know that data has changed.
+    gDataUpdated = true;
+
+    // Unlock our mutex.
+    gWebLock.Unlock();
+} // End SaveDisplayFormData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SendScaleFormData()
+//
+// Called when the client opens the Scale Options form.  Sends current values
+// of all form data to the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void SendScaleFormData()
+{
+    String webPage;
+    DynamicJsonDocument doc(512);
+
+    bool locked = gWebLock.Lock(WEB_OWNER);
+    doc["LOCKED"] = locked;
+
+    doc["WEIGHT_PRECISION"] = GetWeightDecimalPlaces();
+    doc["MAX_WEIGHT"]       = GetMaxScaleWeight();
+    doc["WEIGHT_UNITS"]     = gLoadCell.GetUnitsString();
+    doc["CALIBRATE_WEIGHT"] = gCalibrateWeight;
+    doc["AVG_MS"]           = gScaleAveragingMs;
+    doc["AVG_MS_MIN"]       = AVG_TIME_MIN_MS;
+    doc["AVG_MS_MAX"]       = AVG_TIME_MAX_MS;
+    doc["LOAD_CELL_GAIN"]   = gScaleGain;
+    doc["CHANNEL_B"]        = gScaleChannelB;
+    int32_t channelB;
+    if (gLoadCell.GetChannelB(channelB))
+    {
+        doc["CHANNEL_B_RAW"] = channelB;
+    }
+    doc["MEDIAN_SIZE"]      = gScaleMedianSize;
+    doc["LOW_PASS"]         = gScaleLowPass;
+    doc["STEP_DETECT"]      = gScaleStepDetect;
+    doc["CAL_FIT"]          = gScaleCalFit;
+    doc["CAL_POINTS"]       = gLoadCell.GetCalibrationPoints();
+    doc["TEMP_COMP"]        = gScaleTempComp;
+    const ZeroTrackConfig &zeroTrack = gLoadCell.GetZeroTrackConfig();
+    doc["ZERO_TRACK"]       = gScaleZeroTrack;
+    doc["CREEP_PERCENT"]    = zeroTrack.m_CreepFraction * 100.0f;
+    doc["CREEP_MINUTES"]    = zeroTrack.m_CreepTauS / 60.0f;
+
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+} // End SendScaleFormData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveScaleFormData()
+//
+// Called when the client wants to save any changes made to the scale options.
+// Updates the display options as requested by the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void SaveScaleFormData()
+{
+    uint16_t response = 200;    // Assume OK response.
+
+    StaticJsonDocument<512> JsonDoc;
+    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
+    if (error)
+    {
+        Serial.print("deserializeJson() failed with code ");
+        Serial.println(error.c_str());
+        response = 400; // BAD REQUEST response.
+    }
+    else
+    {
+        // Set the selected spool's data per the request.
+        gCalibrateWeight = static_cast<double>(JsonDoc["calWeightData"]);
+        gScaleAveragingMs = static_cast<uint32_t>(JsonDoc["avgMs"]);
+        gLoadCell.SetAverageTime(gScaleAveragingMs);
+        gScaleAveragingMs = gLoadCell.GetAverageTimeMs();
+        gScaleGain     = static_cast<uint8_t>(JsonDoc["scaleGain"]);
+        gScaleChannelB = static_cast<uint8_t>(JsonDoc["channelB"]);
+        SetLoadCellGain();
+        gScaleMedianSize = static_cast<uint8_t>(JsonDoc["medianSize"]);
+        gScaleLowPass    = static_cast<uint8_t>(JsonDoc["lowPass"]);
+        gScaleStepDetect = static_cast<uint8_t>(JsonDoc["stepDetect"]);
+        SetLoadCellFilters();
+        gScaleCalFit = static_cast<uint8_t>(JsonDoc["calFit"]);
+        if (!gLoadCell.SetCalibrationFit(static_cast<CalibrationFit>(gScaleCalFit)))
+        {
+            gScaleCalFit = gLoadCell.GetCalibrationFit();
+        }
+        gScaleTempComp = static_cast<uint8_t>(JsonDoc["tempComp"]) ? 1U : 0U;
+        gLoadCell.SetTempCompensation(gScaleTempComp != 0U);
+        ZeroTrackConfig zeroTrack = gLoadCell.GetZeroTrackConfig();
+        gScaleZeroTrack = static_cast<uint8_t>(JsonDoc["zeroTrack"]) ? 1U : 0U;
+        zeroTrack.m_ZeroTrack = gScaleZeroTrack;
+        zeroTrack.m_CreepFraction = static_cast<float>(JsonDoc["creepPercent"]) / 100.0f;
+        zeroTrack.m_CreepTauS = static_cast<float>(JsonDoc["creepMinutes"]) * 60.0f;
+        if (!gLoadCell.SetZeroTrackConfig(zeroTrack))
+        {
+            // Bad creep settings.  Still honor the zero tracking selection.
+            SetLoadCellZeroTrack();
+        }
+    }
+
+    // Send a response to the client.
+    gNetwork.send(response, "text/html");
+
+    // Let the system know that data has changed.
+    gDataUpdated = true;
+
+    // Unlock our mutex.
+    gWebLock.Unlock();
+} // End SaveScaleFormData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// AddSampleQuality()
+//
+// Adds the quality of the load cell's last averaged reading (tare or
+// calibration) to a JSON document.
+/////////////////////////////////////////////////////////////////////////////////
+static void AddSampleQuality(JsonDocument &rDoc)
+{
+    const SampleQuality &rQuality = gLoadCell.GetSampleQuality();
+    rDoc["SAMPLES_TAKEN"] = rQuality.m_Taken;
+    rDoc["SAMPLES_USED"]  = rQuality.m_Used;
+    rDoc["CI_COUNTS"]     = rQuality.m_CiCounts;
+    rDoc["CI_GRAMS"]      = rQuality.m_CiGrams;
+    rDoc["DURATION_MS"]   = rQuality.m_DurationMs;
+} // End AddSampleQuality().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoTare()
+//
+// Called when the client requests a Tare operation.  Performs the Tare operation
+// and returns the success/failre results and the quality of the readings to
+// the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoTare()
+{
+    bool result = gLoadCell.Tare();
+    if (result)
+    {
+        LogUsageEvent(eUeTare);
+    }
+    String webPage;
+    DynamicJsonDocument doc(256);
+    doc["TARE_RESULT"] = result;
+    AddSampleQuality(doc);
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+} // End HandleDoTare().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoScaleCalibrate()
+//
+// Called when the client requests a scale calibration operation.  Performs the
+// calibration and returns the success/failre results to the client.  If
+// 'addPoint' is set, the weight is added to the calibration table rather than
+// starting a new calibration.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoScaleCalibrate()
+{
+    uint16_t response = 200;    // Assume OK response.
+
+    StaticJsonDocument<300> JsonDoc;
+    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
+    if (error)
+    {
+        Serial.print("deserializeJson() failed with code ");
+        Serial.println(error.c_str());
+        response = 400; // BAD REQUEST response.
+        // Send a response to the client.
+        gNetwork.send(response, "text/html");
+
+    }
+    else
+    {
+        // Set the selected spool's data per the request.
+        gCalibrateWeight = static_cast<double>(JsonDoc["calWeightData"]);
+
+        // Perform the calibration operation.
+        bool addPoint = static_cast<bool>(JsonDoc["addPoint"]);
+        bool success = addPoint ?
+                       gLoadCell.AddCalibrationPoint(0, gCalibrateWeight) :
+                       gLoadCell.Calibrate(0, gCalibrateWeight);
+        if (!success)
+        {
+            Serial.print("Calibration failed");
+        }
+        else
+        {
+            LogUsageEvent(eUeCalibrate);
+        }
+        String webPage;
+        DynamicJsonDocument doc(256);
+        doc["CAL_RESULT"] = success;
+        doc["CAL_POINTS"] = gLoadCell.GetCalibrationPoints();
+        AddSampleQuality(doc);
+        serializeJson(doc, webPage);
+        gNetwork.send(response, "text/html", webPage);
+    }
+} // End HandleDoScaleCalibrate().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// GetRequestedChannel()
+//
+// Parses the body of a scale bank channel request.
+//
+// Arguments:
+//    - rDoc      - The document to parse the request into.
+//    - ppCell    - Set to the channel's LoadCell.
+//    - rChannel  - Set to the channel number.
+//
+// Returns:
+//    Returns 'true' if the request names a channel that is present, or 'false'
+//    (after sending a BAD REQUEST response) otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+static bool GetRequestedChannel(JsonDocument &rDoc, LoadCell **ppCell, uint8_t &rChannel)
+{
+    DeserializationError error = deserializeJson(rDoc, gNetwork.arg("plain"));
+    if (error)
+    {
+        Serial.print("deserializeJson() failed with code ");
+        Serial.println(error.c_str());
+    }
+    else
+    {
+        rChannel = static_cast<uint8_t>(rDoc["channelData"]);
+        if (gLoadCellArray.IsPresent(rChannel))
+        {
+            *ppCell = gLoadCellArray.GetCell(rChannel);
+            return true;
+        }
+    }
+    gNetwork.send(400, "text/html");
+    return false;
+} // End GetRequestedChannel().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoChannelTare()
+//
+// Called when the client requests a Tare of one channel of a scale bank.
+// Returns the success/failure result to the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoChannelTare()
+{
+    StaticJsonDocument<128> JsonDoc;
+    LoadCell *pCell = NULL;
+    uint8_t channel = 0U;
+    if (GetRequestedChannel(JsonDoc, &pCell, channel))
+    {
+        String webPage;
+        DynamicJsonDocument doc(64);
+        doc["TARE_RESULT"] = pCell->Tare();
+        serializeJson(doc, webPage);
+        gNetwork.send(200, "text/html", webPage);
+    }
+} // End HandleDoChannelTare().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoChannelCalibrate()
+//
+// Called when the client requests calibration of one channel of a scale bank
+// with the weight now on it.  Returns the success/failure result to the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoChannelCalibrate()
+{
+    StaticJsonDocument<128> JsonDoc;
+    LoadCell *pCell = NULL;
+    uint8_t channel = 0U;
+    if (GetRequestedChannel(JsonDoc, &pCell, channel))
+    {
+        bool success = pCell->Calibrate(0, static_cast<double>(JsonDoc["calWeightData"]));
+        String webPage;
+        DynamicJsonDocument doc(64);
+        doc["CAL_RESULT"] = success;
+        serializeJson(doc, webPage);
+        gNetwork.send(200, "text/html", webPage);
+        gDataUpdated = true;
+    }
+} // End HandleDoChannelCalibrate().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleUpdateChannelSlot()
+//
+// Called when the client maps a channel of a scale bank to a spool slot.
+// Channel 0 always weighs the selected spool, so its slot can't be changed.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleUpdateChannelSlot()
+{
+    StaticJsonDocument<128> JsonDoc;
+    LoadCell *pCell = NULL;
+    uint8_t channel = 0U;
+    if (GetRequestedChannel(JsonDoc, &pCell, channel))
+    {
+        uint32_t slot = static_cast<uint32_t>(JsonDoc["slotData"]);
+        bool success = (channel != 0U) && gLoadCellArray.SetSlot(channel, slot);
+        gNetwork.send(success ? 200 : 400, "text/html");
+        gDataUpdated = true;
+    }
+} // End HandleUpdateChannelSlot().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SendSpoolFormData()
+//
+// Called when the client opens the Spool Options form.  Sends current values
+// of all form data to the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void SendSpoolFormData()
+{
+    String webPage;
+    DynamicJsonDocument doc(1800);
+    bool locked = gWebLock.Lock(WEB_OWNER);
+    doc["LOCKED"] = locked;
+
+    Spool *pSpool = gSpoolMgr.GetSelectedSpool();
+    uint32_t startSpoolIndex = gSpoolMgr.GetSelectedSpoolIndex();
+    bool spoolIsSelected = true;
+    if (pSpool == NULL)
+    {
+        startSpoolIndex = 0;
+        spoolIsSelected = false;
+    }
+
+    doc["WEIGHT_PRECISION"] = GetWeightDecimalPlaces();
+    doc["MAX_WEIGHT"]       = GetMaxScaleWeight();
+    doc["WEIGHT_UNITS"]     = gLoadCell.GetUnitsString();
+    doc["START_SPOOL"]      = startSpoolIndex;
+    doc["SPOOL_SELECTED"]   = spoolIsSelected;
+    doc["MAX_NAME_LEN"]     = Spool::MAX_NAME_SIZE;
+    doc["MAX_DENSITY"]      = Filament::MAX_DENSITY;
+    doc["MIN_DENSITY"]      = Filament::MIN_DENSITY;
+
+    doc.createNestedArray("FILAMENT_TYPES");
+    doc.createNestedArray("SPOOL_NAMES");
+    doc.createNestedArray("SPOOL_WEIGHTS");
+    doc.createNestedArray("FILAMENT_DIAMETERS");
+    doc.createNestedArray("DENSITY");
+    doc.createNestedArray("COLORS");
+
+    for (size_t i = 0; i < NUMBER_SPOOLS; i++)
+    {
+        Spool *pS = gSpoolMgr.GetSpool(i);
+        doc["FILAMENT_TYPES"][i]     = pS->GetType();
+        doc["SPOOL_DENSITY"][i]      = pS->GetDensity();
+        doc["SPOOL_NAMES"][i]        = pS->GetName();
+        doc["SPOOL_WEIGHTS"][i]      = pS->GetSpoolWeight();
+        doc["FILAMENT_DIAMETERS"][i] = pS->GetDiameter();
+        doc["COLORS"][i]             = Rgb565ToHexString(pS->GetColor());
+    }
+
+    // Send our density table data.
+    for (size_t i = 0; i < static_cast<int>(eFtCount); i++)
+    {
+        doc["DENSITY"][i] =
+            gFilament.GetDensity(static_cast<FilamentType>(i));
+    }
+
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+} // End SendSpoolFormData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveSpoolFormData()
+//
+// Called when the client wants to save any changes made to the spool options.
+// Updates the display options as requested by the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void SaveSpoolFormData()
+{
+    uint16_t response = 200;    // Assume OK response.
+
+    StaticJsonDocument<300> JsonDoc;
+    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
+    if (error)
+    {
+        Serial.print("deserializeJson() failed with code ");
+        Serial.println(error.c_str());
+        response = 400; // BAD REQUEST response.
+    }
+    else
+    {
+        // Point to the selected spool.
+        uint32_t thisSpoolIndex = JsonDoc["spoolIndex"];
+        Spool *pSpool = gSpoolMgr.GetSpool(thisSpoolIndex);
+
+        uint32_t selectedSpoolIndex = gSpoolMgr.GetSelectedSpoolIndex();
+        bool thisSpoolSelected = JsonDoc["spoolSelected"];
+        if (thisSpoolSelected)
+        {
+            bool changed = (gSpoolMgr.GetSelectedSpool() == NULL) ||
+                           (thisSpoolIndex != selectedSpoolIndex);
+            gSpoolMgr.SelectSpool(thisSpoolIndex);
+            if (changed)
+            {
+                LogUsageEvent(eUeSelect);
+            }
+        }
+        else if (thisSpoolIndex == selectedSpoolIndex)
+        {
+            gSpoolMgr.DeselectSpool();
+        }
+
+        // Set the selected spool's data per the request.
+
+        // Before we save the (possibly) new spool name, we need to remove any
+        // trailing spaces from it.
+        strlcpy(gWorkingSpoolData.m_Name, (const char *)JsonDoc["spoolIdData"],
+                Spool::MAX_NAME_SIZE + 1);
+        size_t nameLength = strlen(gWorkingSpoolData.m_Name);
+        if (nameLength)
+        {
+            while (gWorkingSpoolData.m_Name[--nameLength] == ' ')
+            {}
+            gWorkingSpoolData.m_Name[++nameLength] = '\0';
+        }
+        pSpool->SetName(gWorkingSpoolData.m_Name);
+
+        float spoolWeight = JsonDoc["spoolWeightData"];
+        pSpool->SetSpoolWeight(spoolWeight);
+        gLoadCell.SetOffset(spoolWeight);
+        gWorkingSpoolData.m_SpoolWeight = spoolWeight;
+
+        FilamentType filamentType =
+            static_cast<FilamentType>(JsonDoc["filamentTypeData"]);
+        pSpool->SetType(filamentType);
+        gWorkingSpoolData.m_Type = filamentType;
+
+        float density = JsonDoc["spoolDensity"];
+        pSpool->SetDensity(density);
+        gWorkingSpoolData.m_Density = density;
+
+        float filamentDiameter = JsonDoc["filamentDiaData"];
+        pSpool->SetDiameter(filamentDiameter);
+        gWorkingSpoolData.m_Diameter = filamentDiameter;
+
+        char buf[8];
+        strlcpy(buf, (const char *)JsonDoc["colorData"], sizeof(buf));
+        pSpool->SetColor(HexStringToRgb565(buf));
+        gWorkingSpoolData.m_Color = pSpool->GetColor();
+
+        // Update the spool offset just in case it changed.
+        SaveSpoolOffset();
+
+        // Update the length factor.
+        UpdateLengthFactor();
+
+        // Save the spool once the edits stop.
+        NvsStore::RequestSave(millis());
+    }
+
+    // Let the system know that data has changed.
+    gDataUpdated = true;
+
+    // Send a response to the client.
+    gNetwork.send(response, "text/html");
+} // End SaveSpoolFormData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SendDensityFormData()
+//
+// Called when the client opens the Filament Options form.  Sends current values
+// of all form data to the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void SendDensityFormData()
+{
+    String webPage;
+    DynamicJsonDocument doc(400);
+    bool locked = gWebLock.Lock(WEB_OWNER);
+    doc["LOCKED"] = locked;
+    doc["MAX_DENSITY"] = Filament::MAX_DENSITY;
+    doc["MIN_DENSITY"] = Filament::MIN_DENSITY;
+    Spool *pSpool = gSpoolMgr.GetSelectedSpool();
+    FilamentType type = eFtPla;
+    if (pSpool != NULL)
+    {
+        type = pSpool->GetType();
+    }
+    doc["FILEMANT_TYPE"] = type;
+    for (int i = 0; i < static_cast<int>(eFtCount); i++)
+    {
+        doc["DENSITY"][i] =
+            gFilament.GetDensity(static_cast<FilamentType>(i));
+    }
+
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+} // End SendDensityFormData().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// SaveDensityFormData()
+//
+// Called when the client wants to save any changes made to the filament options.
+// Updates the display options as requested by the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void SaveDensityFormData()
+{
+    uint16_t response = 200;    // Assume OK response.
+
+    StaticJsonDocument<300> JsonDoc;
+    DeserializationError error = deserializeJson(JsonDoc, gNetwork.arg("plain"));
+    if (error)
+    {
+        Serial.print("deserializeJson() failed with code ");
+        Serial.println(error.c_str());
+        response = 400; // BAD REQUEST response.
+    }
+    else
+    {
+        // Get the selected filament type.
+        FilamentType type =
+            static_cast<FilamentType>(JsonDoc["filamentTypeData"]);
+        float newDensity = JsonDoc["densityData"];
+
+        Spool *pSpool = gSpoolMgr.GetSelectedSpool();
+        if (pSpool && (pSpool->GetType() == type))
+        {
+            gWorkingFilamentDensity = newDensity;
+            gFilament.SetDensity(type, newDensity);
+
+            // Update the length factor.
+            UpdateLengthFactor();
+        }
+        else
+        {
+            // Set the new density.
+            gFilament.SetDensity(type, newDensity);
+        }
+    }
+
+    // Let the system know that data has changed.
+    gDataUpdated = true;
+
+    // Send a successful response to the client.
+    gNetwork.send(response, "text/html");
+} // End SaveDensityFormData().
+
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoSave()
+//
+// Called when the client requests a save operation.  Performs
+// the save and returns the success/failre results to the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoSave()
+{
+    bool result = SaveToNvs();
+    String webPage;
+    DynamicJsonDocument doc(100);
+    doc["SAVE_RESULT"] = result;
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+
+    if (result)
+    {
+        // Unlock our mutex.
+        gWebLock.Unlock();
+    }
+} // End HandleDoSave().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoRestore()
+//
+// Called when the client requests a restore operation.  Performs
+// the  restore and returns the success/failre results to the client.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoRestore()
+{
+    bool result = RestoreFromNvs();
+    String webPage;
+    DynamicJsonDocument doc(100);
+    doc["RESTORE_RESULT"] = result;
+    serializeJson(doc, webPage);
+    gNetwork.send(200, "text/html", webPage);
+
+    if (result)
+    {
+        // Unlock our mutex.
+        gWebLock.Unlock();
+        // Let the system know that data has changed.
+        gDataUpdated = true;
+    }
+} // End HandleDoRestore().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoRestart()
+//
+// Called when the client requests a restart operation.  Returns a successful
+// response to the client and initiates the restart.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoRestart()
+{
+    gNetwork.send(200, "text/html");
+    delay(500);
+    ESP.restart();
+} // End HandleDoRestart().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoReset()
+//
+// Called when the client requests a reset operation.  Returns a successful
+// response to the client and initiates the reset.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoReset()
+{
+    gNetwork.send(200, "text/html");
+    delay(500);
+    ResetNvs();
+} // End HandleDoReset().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// HandleDoResetNet()
+//
+// Called when the client requests a reset net operation.  Returns a successful
+// response to the client and initiates the reset.
+/////////////////////////////////////////////////////////////////////////////////
+static void HandleDoResetNet()
+{
+    gNetwork.send(200, "text/html");
+    delay(1000);
+    gNetwork.ResetCredentials();
+    delay(1000);
+    RestartSystem();
+} // End HandleDoResetNet().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// InitNetworkHandlers()
+//
+// Called at power-up to initialize the handling of client requests.  Sets up
+// a handler for each of the URLs that are expected to be received from the
+// network client.
+/////////////////////////////////////////////////////////////////////////////////
+void WebData::InitNetworkHandlers()
+{
+    // MAIN PAGE
+    gNetwork.on("/", HandleRoot);
+    gNetwork.on("/getMainPageData", HandleMainPageData);
+    gNetwork.on("/getHistory", HandleGetHistory);
+    gNetwork.on("/exportHistory", HandleExportHistory);
+
+    // DISPLAY OPTIONS FORM
+    gNetwork.on("/getDisplayFormData", SendDisplayFormData);
+    gNetwork.on("/updateDisplayData", SaveDisplayFormData);
+
+    // SCALE OPTIONS FORM
+    gNetwork.on("/getScaleFormData", SendScaleFormData);
+    gNetwork.on("/updateScaleData", SaveScaleFormData);
+    gNetwork.on("/doTare",  HandleDoTare);
+    gNetwork.on("/doScaleCalibrate", HandleDoScaleCalibrate);
+
+    // Scale bank channels.
+    gNetwork.on("/doChannelTare", HandleDoChannelTare);
+    gNetwork.on("/doChannelCalibrate", HandleDoChannelCalibrate);
+    gNetwork.on("/updateChannelSlot", HandleUpdateChannelSlot);
+
+    // SPOOL OPTIONW FORM
+    gNetwork.on("/getSpoolFormData", SendSpoolFormData);
+    gNetwork.on("/updateSpoolData", SaveSpoolFormData);
+
+    // FILAMENT (DENSITY) OPTIONS FORM
+    gNetwork.on("/getDensityFormData", SendDensityFormData);
+    gNetwork.on("/updateDensityData", SaveDensityFormData);
+
+    // SAVE / RESTORE / RESET OPTIONS FORM
+    gNetwork.on("/doSave", HandleDoSave);
+    gNetwork.on("/doRestore", HandleDoRestore);
+    gNetwork.on("/doRestart", HandleDoRestart);
+    gNetwork.on("/doReset", HandleDoReset);
+    gNetwork.on("/doResetNet", HandleDoResetNet);
+
+    // UTILITIES
+    gNetwork.on("/lockOptions", HandleLockOptions);
+    gNetwork.on("/unlockOptions", HandleUnlockOptions);
+    gNetwork.onNotFound(HandleNotFound);
+} // End InitNetworkHandlers().
+
@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////////
+// ZeroTracker.cpp
+//
+// Contains methods defined by the ZeroTracker class.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "ZeroTracker.h"        // For ZeroTracker class.
+#include <cmath>                // For fabs(), isfinite().
+
+
+// Zero tracking on with a half gram band, no creep compensation.
+const ZeroTrackConfig ZeroTracker::DEFAULT_CONFIG = {1U, {0U, 0U, 0U}, 0.5f, 0.0f, 1800.0f};
+const double ZeroTracker::ZERO_RANGE_GRAMS   = 20.0d;
+const double ZeroTracker::MAX_BAND_GRAMS     = 5.0d;
+const double ZeroTracker::MAX_CREEP_FRACTION = 0.01d;
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Constructor.
+//
+// Starts with DEFAULT_CONFIG.
+/////////////////////////////////////////////////////////////////////////////////
+ZeroTracker::ZeroTracker() : m_Config(DEFAULT_CONFIG), m_HaveLast(false),
+    m_LastMs(0UL), m_LastGrams(0.0d), m_InBandMs(0UL), m_ZeroFraction(0.0d),
+    m_TrackedCounts(0L), m_CreepLoad(0.0d)
+{
+} // End constructor.
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Configure()
+//
+// Selects the settings.
+//
+// Arguments:
+//    - rConfig - The new settings.
+//
+// Returns:
+//    Returns 'true' if successful, or 'false' if a setting is out of range.
+/////////////////////////////////////////////////////////////////////////////////
+bool ZeroTracker::Configure(const ZeroTrackConfig &rConfig)
+{
+    if ((rConfig.m_ZeroTrack > 1U) ||
+        !std::isfinite(rConfig.m_BandGrams) || (rConfig.m_BandGrams <= 0.0f) ||
+        (rConfig.m_BandGrams > MAX_BAND_GRAMS) ||
+        !std::isfinite(rConfig.m_CreepFraction) ||
+        (fabs(rConfig.m_CreepFraction) > MAX_CREEP_FRACTION) ||
+        !std::isfinite(rConfig.m_CreepTauS) || (rConfig.m_CreepTauS < 1.0f))
+    {
+        return false;
+    }
+
+    m_Config = rConfig;
+    m_Config.m_Reserved[0] = m_Config.m_Reserved[1] = m_Config.m_Reserved[2] = 0U;
+    if (!m_Config.m_ZeroTrack)
+    {
+        m_InBandMs = 0UL;
+    }
+    return true;
+} // End Configure().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Forgets all history.  Called when the scale is tared.
+/////////////////////////////////////////////////////////////////////////////////
+void ZeroTracker::Reset()
+{
+    m_HaveLast      = false;
+    m_InBandMs      = 0UL;
+    m_ZeroFraction  = 0.0d;
+    m_TrackedCounts = 0L;
+    m_CreepLoad     = 0.0d;
+} // End Reset().
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// Update()
+//
+// Processes the latest reading.
+//
+// Arguments:
+//    - netCounts     - The reading less the tare reading.
+//    - gramsPerCount - The weight of one count.  Nothing is done if 0.
+//    - nowMs         - The time of the reading in milliseconds.
+//
+// Returns:
+//    Returns the number of counts that the tare reading should be moved by.
+/////////////////////////////////////////////////////////////////////////////////
+int32_t ZeroTracker::Update(double netCounts, double gramsPerCount, uint32_t nowMs)
+{
+    if (gramsPerCount <= 0.0d)
+    {
+        m_HaveLast = false;
+        return 0L;
+    }
+
+    // Time since the previous reading.  A long gap (e.g. while a menu was
+    // being used) counts as MAX_STEP_MS so that nothing jumps.
+    uint32_t dtMs = m_HaveLast ? nowMs - m_LastMs : 0UL;
+    if (dtMs > MAX_STEP_MS)
+    {
+        dtMs = MAX_STEP_MS;
+    }
+
+    // Creep: lag the load.  Compensate() scales it by the creep fraction.
+    double tauMs = m_Config.m_CreepTauS * 1000.0d;
+    m_CreepLoad += (netCounts - m_CreepLoad) * dtMs / (tauMs + dtMs);
+
+    // Zero tracking: wait for the reading to be steady near zero, then pull
+    // it the rest of the way by moving the tare.
+    int32_t tareMove = 0L;
+    double grams = Compensate(netCounts) * gramsPerCount;
+    bool steady = m_HaveLast &&
+                  (fabs(grams) <= m_Config.m_BandGrams) &&
+                  (fabs(grams - m_LastGrams) <= m_Config.m_BandGrams / 2.0d);
+    if (!m_Config.m_ZeroTrack || !steady)
+    {
+        m_InBandMs = 0UL;
+        m_ZeroFraction = 0.0d;
+    }
+    else if (m_InBandMs < ZERO_SETTLE_MS)
+    {
+        m_InBandMs += dtMs;
+    }
+    else
+    {
+        m_ZeroFraction += Compensate(netCounts) * dtMs / ZERO_TAU_MS;
+        tareMove = static_cast<int32_t>(m_ZeroFraction);
+
+        // Stay within range of the explicit tare.
+        int32_t range = static_cast<int32_t>(ZERO_RANGE_GRAMS / gramsPerCount);
+        int32_t tracked = m_TrackedCounts + tareMove;
+        if (tracked > range)
+        {
+            tareMove = range - m_TrackedCounts;
+        }
+        else if (tracked < -range)
+        {
+            tareMove = -range - m_TrackedCounts;
+        }
+        m_ZeroFraction -= static_cast<int32_t>(m_ZeroFraction);
+        m_TrackedCounts += tareMove;
+
+        // The tare has moved, so the lagged load has too.
+        m_CreepLoad -= tareMove;
+    }
+
+    m_HaveLast  = true;
+    m_LastMs    = nowMs;
+    m_LastGrams = grams;
+    return tareMove;
+} // End Update().
@@ -0,0 +1,153 @@
+/////////////////////////////////////////////////////////////////////////////////
+// ZeroTracker.h
+//
+// This class implements the ZeroTracker class.  It handles two slow load cell
+// errors between explicit tares, one reading at a time and without waiting:
+//
+//    - Zero tracking.  When the empty scale reads within m_BandGrams of zero
+//      and has stayed there (and steady) for ZERO_SETTLE_MS, the reading is
+//      pulled towards zero with a time constant of ZERO_TAU_MS by moving the
+//      tare.  The total movement since the last tare is limited to
+//      ZERO_RANGE_GRAMS, so a load added very slowly is not tracked away.
+//
+//    - Creep compensation.  Under a constant load the reading of a strain
+//      gauge cell slowly rises by a fraction of the load (m_CreepFraction)
+//      with a time constant of about m_CreepTauS seconds, then slowly returns
+//      once the load is removed.  The load is passed through a first order
+//      lag with that time constant and m_CreepFraction of the result is
+//      subtracted, which models both the creep and the recovery.
+//
+// The settings are kept in a ZeroTrackConfig structure that may be saved to
+// NVS as is.
+//
+// History:
+// - jmcorbett 15-OCT-2026 Original creation.
+//
+// Copyright (c) 2021, Joseph M. Corbett
+/////////////////////////////////////////////////////////////////////////////////
+#if !defined ZEROTRACKER_H
+#define ZEROTRACKER_H
+
+#include <cstdint>              // For uint8_t, ...
+
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ZeroTrackConfig structure
+/////////////////////////////////////////////////////////////////////////////////
+struct ZeroTrackConfig
+{
+    uint8_t m_ZeroTrack;                // Zero tracking on.
+    uint8_t m_Reserved[3];              // Explicit padding, always 0.
+    float   m_BandGrams;                // Track readings within this of zero.
+    float   m_CreepFraction;            // Creep at full creep, 0 for none.
+    float   m_CreepTauS;                // Creep time constant in seconds.
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////
+// ZeroTracker class
+/////////////////////////////////////////////////////////////////////////////////
+class ZeroTracker
+{
+public:
+    // Constructor.  Starts with DEFAULT_CONFIG.
+    ZeroTracker();
+
+
+    // Destructor.
+    virtual ~ZeroTracker() { }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Configure()
+    //
+    // Selects the settings.
+    //
+    // Arguments:
+    //    - rConfig - The new settings.
+    //
+    // Returns:
+    //    Returns 'true' if successful, or 'false' if a setting is out of range,
+    //    in which case the current settings are kept.
+    /////////////////////////////////////////////////////////////////////////////
+    bool Configure(const ZeroTrackConfig &rConfig);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Reset()
+    //
+    // Forgets all history.  Called when the scale is tared.
+    /////////////////////////////////////////////////////////////////////////////
+    void Reset();
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Update()
+    //
+    // Processes the latest reading.
+    //
+    // Arguments:
+    //    - netCounts     - The reading less the tare reading.
+    //    - gramsPerCount - The weight of one count.  Nothing is done if 0.
+    //    - nowMs         - The time of the reading in milliseconds.
+    //
+    // Returns:
+    //    Returns the number of counts that the tare reading should be moved
+    //    by for zero tracking (usually 0).  The reading is corrected by
+    //    Compensate().
+    /////////////////////////////////////////////////////////////////////////////
+    int32_t Update(double netCounts, double gramsPerCount, uint32_t nowMs);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Compensate()
+    //
+    // Returns the net reading less the creep predicted by the last Update().
+    /////////////////////////////////////////////////////////////////////////////
+    double Compensate(double netCounts) const
+        { return netCounts - m_Config.m_CreepFraction * m_CreepLoad; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Simple getters.
+    /////////////////////////////////////////////////////////////////////////////
+    const ZeroTrackConfig &GetConfig() const { return m_Config; }
+    int32_t GetTrackedCounts()         const { return m_TrackedCounts; }
+    bool    IsTracking()               const { return m_InBandMs >= ZERO_SETTLE_MS; }
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Public constants.
+    /////////////////////////////////////////////////////////////////////////////
+    static const ZeroTrackConfig DEFAULT_CONFIG;
+    static const uint32_t ZERO_SETTLE_MS  = 5000UL;
+    static const uint32_t ZERO_TAU_MS     = 20000UL;
+    static const uint32_t MAX_STEP_MS     = 1000UL; // Longer gaps are limited.
+    static const double   ZERO_RANGE_GRAMS;
+    static const double   MAX_BAND_GRAMS;
+    static const double   MAX_CREEP_FRACTION;
+
+private:
+    // Unimplemented methods.  We don't want users to try to use these.
+    ZeroTracker(ZeroTracker &rZt);
+    ZeroTracker &operator=(ZeroTracker &rZt);
+
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Instance data.
+    /////////////////////////////////////////////////////////////////////////////
+    ZeroTrackConfig m_Config;           // Settings.
+    bool     m_HaveLast;                // m_LastMs and m_LastGrams are valid.
+    uint32_t m_LastMs;                  // Time of the previous reading.
+    double   m_LastGrams;               // Previous reading.
+    uint32_t m_InBandMs;                // Time spent steady near zero.
+    double   m_ZeroFraction;            // Tare movement not yet applied.
+    int32_t  m_TrackedCounts;           // Tare movement since Reset().
+    double   m_CreepLoad;               // Lagged load, in counts.
+
+}; // End class ZeroTracker.
+
+
+
+#endif // ZEROTRACKER_H